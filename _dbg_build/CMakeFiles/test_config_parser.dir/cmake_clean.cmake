@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_config_parser.dir/tests/test_config_parser.cpp.o"
+  "CMakeFiles/test_config_parser.dir/tests/test_config_parser.cpp.o.d"
+  "bin/tests/test_config_parser"
+  "bin/tests/test_config_parser.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_config_parser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
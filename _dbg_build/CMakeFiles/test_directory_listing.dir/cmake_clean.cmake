@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_directory_listing.dir/tests/test_directory_listing.cpp.o"
+  "CMakeFiles/test_directory_listing.dir/tests/test_directory_listing.cpp.o.d"
+  "bin/tests/test_directory_listing"
+  "bin/tests/test_directory_listing.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_directory_listing.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
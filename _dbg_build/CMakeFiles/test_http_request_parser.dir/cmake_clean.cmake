@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_http_request_parser.dir/tests/test_http_request_parser.cpp.o"
+  "CMakeFiles/test_http_request_parser.dir/tests/test_http_request_parser.cpp.o.d"
+  "bin/tests/test_http_request_parser"
+  "bin/tests/test_http_request_parser.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_http_request_parser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_socket_manager.dir/tests/test_socket_manager.cpp.o"
+  "CMakeFiles/test_socket_manager.dir/tests/test_socket_manager.cpp.o.d"
+  "bin/tests/test_socket_manager"
+  "bin/tests/test_socket_manager.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_socket_manager.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
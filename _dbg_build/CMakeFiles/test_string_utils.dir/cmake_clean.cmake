@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_string_utils.dir/tests/test_string_utils.cpp.o"
+  "CMakeFiles/test_string_utils.dir/tests/test_string_utils.cpp.o.d"
+  "bin/tests/test_string_utils"
+  "bin/tests/test_string_utils.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_string_utils.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,68 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/cgi/CgiOutputParser.cpp" "CMakeFiles/webserv_core.dir/src/cgi/CgiOutputParser.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/cgi/CgiOutputParser.cpp.o.d"
+  "/root/repo/src/cgi/CgiProcess.cpp" "CMakeFiles/webserv_core.dir/src/cgi/CgiProcess.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/cgi/CgiProcess.cpp.o.d"
+  "/root/repo/src/cgi/FastCgiPool.cpp" "CMakeFiles/webserv_core.dir/src/cgi/FastCgiPool.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/cgi/FastCgiPool.cpp.o.d"
+  "/root/repo/src/cgi/FastCgiProtocol.cpp" "CMakeFiles/webserv_core.dir/src/cgi/FastCgiProtocol.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/cgi/FastCgiProtocol.cpp.o.d"
+  "/root/repo/src/config/Config.cpp" "CMakeFiles/webserv_core.dir/src/config/Config.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/config/Config.cpp.o.d"
+  "/root/repo/src/config/ConfigParser.cpp" "CMakeFiles/webserv_core.dir/src/config/ConfigParser.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/config/ConfigParser.cpp.o.d"
+  "/root/repo/src/config/ConfigSnapshot.cpp" "CMakeFiles/webserv_core.dir/src/config/ConfigSnapshot.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/config/ConfigSnapshot.cpp.o.d"
+  "/root/repo/src/core/Location.cpp" "CMakeFiles/webserv_core.dir/src/core/Location.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/core/Location.cpp.o.d"
+  "/root/repo/src/core/RouteTable.cpp" "CMakeFiles/webserv_core.dir/src/core/RouteTable.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/core/RouteTable.cpp.o.d"
+  "/root/repo/src/core/Server.cpp" "CMakeFiles/webserv_core.dir/src/core/Server.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/core/Server.cpp.o.d"
+  "/root/repo/src/core/VirtualHostIndex.cpp" "CMakeFiles/webserv_core.dir/src/core/VirtualHostIndex.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/core/VirtualHostIndex.cpp.o.d"
+  "/root/repo/src/core/Webserv.cpp" "CMakeFiles/webserv_core.dir/src/core/Webserv.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/core/Webserv.cpp.o.d"
+  "/root/repo/src/core/server_utils.cpp" "CMakeFiles/webserv_core.dir/src/core/server_utils.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/core/server_utils.cpp.o.d"
+  "/root/repo/src/http/AssetCache.cpp" "CMakeFiles/webserv_core.dir/src/http/AssetCache.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/AssetCache.cpp.o.d"
+  "/root/repo/src/http/ChunkedDecoder.cpp" "CMakeFiles/webserv_core.dir/src/http/ChunkedDecoder.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/ChunkedDecoder.cpp.o.d"
+  "/root/repo/src/http/ChunkedEncoder.cpp" "CMakeFiles/webserv_core.dir/src/http/ChunkedEncoder.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/ChunkedEncoder.cpp.o.d"
+  "/root/repo/src/http/Compression.cpp" "CMakeFiles/webserv_core.dir/src/http/Compression.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/Compression.cpp.o.d"
+  "/root/repo/src/http/DateCache.cpp" "CMakeFiles/webserv_core.dir/src/http/DateCache.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/DateCache.cpp.o.d"
+  "/root/repo/src/http/DirectoryListing.cpp" "CMakeFiles/webserv_core.dir/src/http/DirectoryListing.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/DirectoryListing.cpp.o.d"
+  "/root/repo/src/http/FileCache.cpp" "CMakeFiles/webserv_core.dir/src/http/FileCache.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/FileCache.cpp.o.d"
+  "/root/repo/src/http/HeaderFields.cpp" "CMakeFiles/webserv_core.dir/src/http/HeaderFields.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/HeaderFields.cpp.o.d"
+  "/root/repo/src/http/HttpMethod.cpp" "CMakeFiles/webserv_core.dir/src/http/HttpMethod.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/HttpMethod.cpp.o.d"
+  "/root/repo/src/http/HttpRequest.cpp" "CMakeFiles/webserv_core.dir/src/http/HttpRequest.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/HttpRequest.cpp.o.d"
+  "/root/repo/src/http/HttpRequestParser.cpp" "CMakeFiles/webserv_core.dir/src/http/HttpRequestParser.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/HttpRequestParser.cpp.o.d"
+  "/root/repo/src/http/HttpResponse.cpp" "CMakeFiles/webserv_core.dir/src/http/HttpResponse.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/HttpResponse.cpp.o.d"
+  "/root/repo/src/http/HttpResponseBuilder.cpp" "CMakeFiles/webserv_core.dir/src/http/HttpResponseBuilder.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/HttpResponseBuilder.cpp.o.d"
+  "/root/repo/src/http/HttpScanner.cpp" "CMakeFiles/webserv_core.dir/src/http/HttpScanner.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/HttpScanner.cpp.o.d"
+  "/root/repo/src/http/MultipartParser.cpp" "CMakeFiles/webserv_core.dir/src/http/MultipartParser.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/MultipartParser.cpp.o.d"
+  "/root/repo/src/http/UploadWriter.cpp" "CMakeFiles/webserv_core.dir/src/http/UploadWriter.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/http/UploadWriter.cpp.o.d"
+  "/root/repo/src/network/BufferPool.cpp" "CMakeFiles/webserv_core.dir/src/network/BufferPool.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/BufferPool.cpp.o.d"
+  "/root/repo/src/network/ByteBuffer.cpp" "CMakeFiles/webserv_core.dir/src/network/ByteBuffer.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/ByteBuffer.cpp.o.d"
+  "/root/repo/src/network/Connection.cpp" "CMakeFiles/webserv_core.dir/src/network/Connection.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/Connection.cpp.o.d"
+  "/root/repo/src/network/EpollManager.cpp" "CMakeFiles/webserv_core.dir/src/network/EpollManager.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/EpollManager.cpp.o.d"
+  "/root/repo/src/network/KqueueManager.cpp" "CMakeFiles/webserv_core.dir/src/network/KqueueManager.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/KqueueManager.cpp.o.d"
+  "/root/repo/src/network/PollFallbackManager.cpp" "CMakeFiles/webserv_core.dir/src/network/PollFallbackManager.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/PollFallbackManager.cpp.o.d"
+  "/root/repo/src/network/PollManager.cpp" "CMakeFiles/webserv_core.dir/src/network/PollManager.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/PollManager.cpp.o.d"
+  "/root/repo/src/network/SocketAddress.cpp" "CMakeFiles/webserv_core.dir/src/network/SocketAddress.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/SocketAddress.cpp.o.d"
+  "/root/repo/src/network/SocketManager.cpp" "CMakeFiles/webserv_core.dir/src/network/SocketManager.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/SocketManager.cpp.o.d"
+  "/root/repo/src/network/TimerWheel.cpp" "CMakeFiles/webserv_core.dir/src/network/TimerWheel.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/TimerWheel.cpp.o.d"
+  "/root/repo/src/network/TlsContext.cpp" "CMakeFiles/webserv_core.dir/src/network/TlsContext.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/TlsContext.cpp.o.d"
+  "/root/repo/src/network/UpstreamPool.cpp" "CMakeFiles/webserv_core.dir/src/network/UpstreamPool.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/UpstreamPool.cpp.o.d"
+  "/root/repo/src/network/UringManager.cpp" "CMakeFiles/webserv_core.dir/src/network/UringManager.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/network/UringManager.cpp.o.d"
+  "/root/repo/src/utils/Arena.cpp" "CMakeFiles/webserv_core.dir/src/utils/Arena.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/utils/Arena.cpp.o.d"
+  "/root/repo/src/utils/CpuAffinity.cpp" "CMakeFiles/webserv_core.dir/src/utils/CpuAffinity.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/utils/CpuAffinity.cpp.o.d"
+  "/root/repo/src/utils/InternedString.cpp" "CMakeFiles/webserv_core.dir/src/utils/InternedString.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/utils/InternedString.cpp.o.d"
+  "/root/repo/src/utils/Logger.cpp" "CMakeFiles/webserv_core.dir/src/utils/Logger.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/utils/Logger.cpp.o.d"
+  "/root/repo/src/utils/PrintInfo.cpp" "CMakeFiles/webserv_core.dir/src/utils/PrintInfo.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/utils/PrintInfo.cpp.o.d"
+  "/root/repo/src/utils/RequestTrace.cpp" "CMakeFiles/webserv_core.dir/src/utils/RequestTrace.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/utils/RequestTrace.cpp.o.d"
+  "/root/repo/src/utils/Stats.cpp" "CMakeFiles/webserv_core.dir/src/utils/Stats.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/utils/Stats.cpp.o.d"
+  "/root/repo/src/utils/StringUtils.cpp" "CMakeFiles/webserv_core.dir/src/utils/StringUtils.cpp.o" "gcc" "CMakeFiles/webserv_core.dir/src/utils/StringUtils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
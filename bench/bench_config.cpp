@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_config.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 03:56:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:44:24 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    bench_config.cpp
+ * @brief   Measures how long ConfigParser takes on large generated configurations.
+ *
+ * @details Generates a file shaped like the ones our tooling produces: many server
+ * blocks, each with a few names, timeouts and four locations. Parses a quarter,
+ * half and all of the blocks (default 2000, about 50000 lines) from memory, best
+ * of five runs each, so the times show whether parsing stays linear. Pass a
+ * server count as the first argument to change the size.
+ */
+
+#include "config/ConfigParser.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+static volatile std::size_t sink; // Keeps the measured work observable
+
+static std::string generate(long servers) {
+    std::string text = "worker_processes auto;\nmax_connections 65536;\n\n";
+    for (long i = 0; i < servers; ++i) {
+        const std::string id = std::to_string(i);
+        text += "server {\n"
+                "    listen 127.0.0.1:" + std::to_string(10000 + i % 50000) + ";\n"
+                "    server_name site" + id + ".example.com www.site" + id + ".example.com;\n"
+                "    client_max_body_size 8m;\n"
+                "    keepalive_timeout 65s;\n"
+                "    error_page 404 /errors/404.html;\n"
+                "    error_page 500 502 503 504 /errors/50x.html;\n"
+                "\n"
+                "    location / {\n"
+                "        root /srv/site" + id + "/public;\n"
+                "        index index.html;\n"
+                "        methods GET HEAD;\n"
+                "    }\n"
+                "    location /static {\n"
+                "        root /srv/site" + id + "/static;\n"
+                "        autoindex on;\n"
+                "    }\n"
+                "    location /upload {\n"
+                "        methods POST;\n"
+                "        upload_store /srv/site" + id + "/uploads;\n"
+                "    }\n"
+                "    location /cgi-bin { # dynamic pages\n"
+                "        root /srv/site" + id + "/cgi-bin;\n"
+                "        cgi_extension .py;\n"
+                "        cgi_interpreter /usr/bin/python3;\n"
+                "    }\n"
+                "}\n";
+    }
+    return text;
+}
+
+static double msPerParse(const std::string& text) {
+    double best = 1e18;
+    for (int round = 0; round < 5; ++round) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const Config config = ConfigParser::parse(text);
+        const std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        sink = config.getServers().size();
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    const long servers = argc > 1 ? std::atol(argv[1]) : 2000;
+    if (servers <= 0)
+        return 1;
+
+    std::cout << std::left << std::setw(10) << "servers" << std::right << std::setw(10)
+              << "lines" << std::setw(10) << "KiB" << std::setw(12) << "ms" << std::setw(14)
+              << "ns/line\n";
+    for (long part = 4; part >= 1; part /= 2) {
+        const std::string text  = generate(servers / part);
+        const std::size_t lines =
+            static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n'));
+        const double      ms    = msPerParse(text);
+        std::cout << std::left << std::setw(10) << servers / part << std::right << std::setw(10)
+                  << lines << std::setw(10) << text.size() / 1024 << std::fixed
+                  << std::setprecision(2) << std::setw(12) << ms << std::setprecision(1)
+                  << std::setw(13) << ms * 1e6 / static_cast<double>(lines) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_response.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 03:44:45 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 03:44:45 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    bench_response.cpp
+ * @brief   Measures building and serializing a typical response.
+ *
+ * @details Each iteration builds a 200 response with a 1 KiB body and the usual
+ * fields, then turns it into bytes three ways: as one contiguous string with
+ * serializeHead(), as the segments the connection sends with the fields on the
+ * heap, and the same with the fields in an Arena reset after every response, as
+ * a connection does. Pass an iteration count as the first argument to change the
+ * default of 200000.
+ */
+
+#include "http/HttpResponse.hpp"
+#include "utils/Arena.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+static volatile std::size_t sink; // Keeps the measured work observable
+
+static const std::string BODY(1024, 'x');
+
+static HttpResponse build(std::pmr::memory_resource* memory) {
+    HttpResponse response(200, memory);
+    response.setBody(BODY, "text/html");
+    response.setHeader("Cache-Control", "max-age=60");
+    response.setHeader("ETag", "\"5f3c-400\"");
+    response.setHeader("Last-Modified", "Fri, 30 May 2025 09:00:00 GMT");
+    response.addField("Connection: keep-alive\r\n");
+    return response;
+}
+
+template <typename Fn> static double nsPerResponse(long iterations, Fn fn) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (long n = 0; n < iterations; ++n)
+        fn();
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(iterations);
+}
+
+int main(int argc, char** argv) {
+    const long iterations = argc > 1 ? std::atol(argv[1]) : 200000;
+
+    const double joined = nsPerResponse(iterations, []() {
+        HttpResponse response = build(std::pmr::get_default_resource());
+        std::string  wire     = response.serializeHead();
+        wire += response.getBody();
+        sink = wire.size();
+    });
+    const double heap = nsPerResponse(iterations, []() {
+        HttpResponse           response = build(std::pmr::get_default_resource());
+        HttpResponse::Segments segments = response.takeSegments(false);
+        sink                            = segments.size();
+    });
+    Arena        arena;
+    const double arena_ns = nsPerResponse(iterations, [&arena]() {
+        {
+            HttpResponse           response = build(&arena);
+            HttpResponse::Segments segments = response.takeSegments(false);
+            sink                            = segments.size();
+        }
+        arena.reset();
+    });
+
+    std::cout << iterations << " responses, " << BODY.size() << " byte body\n\n"
+              << std::fixed << std::setprecision(1) << std::left << std::setw(16)
+              << "joined string" << std::right << std::setw(10) << joined << " ns/response\n"
+              << std::left << std::setw(16) << "segments, heap" << std::right << std::setw(10)
+              << heap << " ns/response\n"
+              << std::left << std::setw(16) << "segments, arena" << std::right << std::setw(10)
+              << arena_ns << " ns/response\n";
+    return 0;
+}
@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_routes.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:13:32 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:13:32 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    bench_routes.cpp
+ * @brief   Compares RouteTable lookups with a linear Location::matchesPath scan.
+ *
+ * @details Builds a server with the given number of location blocks (default 256)
+ * shaped like a typical API/asset layout, then resolves a fixed mix of request
+ * paths both ways.
+ */
+
+#include "core/Server.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static volatile std::size_t sink; // Keeps the measured work observable
+
+static const Location* linearFind(const Server& server, const std::string& path) {
+    const Location*              best      = NULL;
+    const std::vector<Location>& locations = server.getLocations();
+    for (std::size_t i = 0; i < locations.size(); ++i) {
+        if (locations[i].matchesPath(path) &&
+            (!best || locations[i].getPath().size() > best->getPath().size()))
+            best = &locations[i];
+    }
+    return best;
+}
+
+template <typename Fn> static double nsPerLookup(long lookups, Fn fn) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    fn();
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(lookups);
+}
+
+int main(int argc, char** argv) {
+    const int  count      = argc > 1 ? std::atoi(argv[1]) : 256;
+    const long iterations = 20000;
+
+    Server   server;
+    Location root;
+    root.setPath("/");
+    server.addLocation(root);
+    for (int i = 0; i < count; ++i) {
+        Location loc;
+        loc.setPath("/api/v" + std::to_string(i % 4) + "/service" + std::to_string(i));
+        server.addLocation(loc);
+    }
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < 16; ++i)
+        paths.push_back("/api/v" + std::to_string(i % 4) + "/service" +
+                        std::to_string(i * count / 16) + "/items/42");
+    paths.push_back("/static/js/app.js");
+    paths.push_back("/index.html");
+
+    const long lookups = iterations * static_cast<long>(paths.size());
+    const double linear = nsPerLookup(lookups, [&]() {
+        for (long n = 0; n < iterations; ++n)
+            for (std::size_t i = 0; i < paths.size(); ++i)
+                sink = reinterpret_cast<std::size_t>(linearFind(server, paths[i]));
+    });
+    const double trie = nsPerLookup(lookups, [&]() {
+        for (long n = 0; n < iterations; ++n)
+            for (std::size_t i = 0; i < paths.size(); ++i)
+                sink = reinterpret_cast<std::size_t>(server.findLocation(paths[i]));
+    });
+
+    std::cout << server.getLocations().size() << " locations, " << lookups << " lookups\n\n"
+              << std::fixed << std::setprecision(1) << std::left << std::setw(12) << "linear"
+              << std::right << std::setw(10) << linear << " ns/lookup\n"
+              << std::left << std::setw(12) << "route table" << std::right << std::setw(10)
+              << trie << " ns/lookup\n";
+    return 0;
+}
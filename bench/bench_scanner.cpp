@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_scanner.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:11:48 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:11:48 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    bench_scanner.cpp
+ * @brief   Compares the HttpScanner kernels on a realistic request head.
+ *
+ * @details The sample is a browser-style GET of roughly 800 bytes of headers. Each
+ * supported kernel is timed twice: once on the raw header-value scan and once
+ * through the full HttpRequestParser. Pass an iteration count as the first
+ * argument to change the default of 200000.
+ */
+
+#include "http/HttpRequest.hpp"
+#include "http/HttpRequestParser.hpp"
+#include "http/HttpScanner.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+static const std::string REQUEST =
+    "GET /assets/js/application-3f1c9a27.js?v=20250514&lang=en HTTP/1.1\r\n"
+    "Host: www.example.com\r\n"
+    "Connection: keep-alive\r\n"
+    "sec-ch-ua: \"Chromium\";v=\"124\", \"Google Chrome\";v=\"124\", \"Not-A.Brand\";v=\"99\"\r\n"
+    "sec-ch-ua-mobile: ?0\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) "
+    "Chrome/124.0.0.0 Safari/537.36\r\n"
+    "sec-ch-ua-platform: \"Linux\"\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,"
+    "image/apng,*/*;q=0.8\r\n"
+    "Sec-Fetch-Site: same-origin\r\n"
+    "Sec-Fetch-Mode: no-cors\r\n"
+    "Sec-Fetch-Dest: script\r\n"
+    "Referer: https://www.example.com/products/category/item?id=1234567&ref=homepage\r\n"
+    "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+    "Accept-Language: en-US,en;q=0.9,fi;q=0.8,sv;q=0.7\r\n"
+    "Cookie: session=8c1f02d8a3b94e55b6f0c2a1d9e87f31; theme=dark; consent=1; "
+    "_ga=GA1.1.1234567890.1715600000; _gid=GA1.1.987654321.1715600000\r\n"
+    "If-None-Match: \"5f3a9c2e-1b2d\"\r\n"
+    "If-Modified-Since: Tue, 13 May 2025 10:00:00 GMT\r\n"
+    "\r\n";
+
+static volatile std::size_t sink; // Keeps the measured work observable
+
+template <typename Fn> static double nsPerIteration(long iterations, Fn fn) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i)
+        fn();
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(iterations);
+}
+
+int main(int argc, char** argv) {
+    const long iterations = argc > 1 ? std::atol(argv[1]) : 200000;
+    const ScanKernel original = activeScanKernels().kind;
+    const ScanKernel kinds[]  = {ScanKernel::SCALAR, ScanKernel::SSE42, ScanKernel::AVX2,
+                                 ScanKernel::NEON};
+
+    std::cout << "Request head: " << REQUEST.size() << " bytes, " << iterations
+              << " iterations\n\n";
+    std::cout << std::left << std::setw(10) << "kernel" << std::right << std::setw(14)
+              << "scan ns/req" << std::setw(14) << "parse ns/req" << std::setw(12) << "MB/s"
+              << "\n";
+
+    for (ScanKernel kind : kinds) {
+        const HttpScanKernels* kernels = findScanKernels(kind);
+        if (!kernels)
+            continue;
+        selectScanKernel(kind);
+
+        // Walk the head value by value, the way the parser sees it
+        const double scan = nsPerIteration(iterations, [&]() {
+            const char* p = REQUEST.data();
+            std::size_t i = 0, total = 0;
+            while (i < REQUEST.size()) {
+                i = kernels->value(p, i, REQUEST.size());
+                total += i;
+                ++i;
+            }
+            sink = total;
+        });
+
+        HttpRequestParser parser;
+        HttpRequest       request;
+        const double      parse = nsPerIteration(iterations, [&]() {
+            parser.reset();
+            request.reset();
+            sink = static_cast<std::size_t>(parser.parse(REQUEST, request));
+        });
+
+        std::cout << std::left << std::setw(10) << kernels->name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(14) << scan << std::setw(14) << parse
+                  << std::setw(12) << static_cast<double>(REQUEST.size()) * 1000.0 / parse
+                  << "\n";
+    }
+    selectScanKernel(original);
+    return 0;
+}
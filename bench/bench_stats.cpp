@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_stats.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 03:39:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 03:39:13 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    bench_stats.cpp
+ * @brief   Measures what collecting statistics adds to serving a request.
+ *
+ * @details Drives one Connection over a socketpair through the whole keep-alive
+ * cycle: the client writes a request, the connection reads and parses it, queues
+ * a small response and flushes it, and the client reads it back. The same cycle
+ * runs with and without a WorkerStats block, in alternating rounds, and the best
+ * round of each is compared. The target is an overhead below 1%. Pass an
+ * iteration count as the first argument to change the default of 100000.
+ */
+
+#include "http/HttpResponse.hpp"
+#include "network/Connection.hpp"
+#include "utils/Stats.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static const std::string REQUEST = "GET /index.html HTTP/1.1\r\n"
+                                   "Host: www.example.com\r\n"
+                                   "User-Agent: bench_stats\r\n"
+                                   "Accept: */*\r\n"
+                                   "\r\n";
+
+static volatile std::size_t sink; // Keeps the measured work observable
+
+static double nsPerRequest(long iterations, WorkerStats* stats) {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0 || fcntl(fds[0], F_SETFL, O_NONBLOCK) != 0)
+        std::exit(1);
+    Server     server;
+    Connection conn(fds[0], &server, NULL, NULL, stats);
+    char       reply[4096];
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (long n = 0; n < iterations; ++n) {
+        if (write(fds[1], REQUEST.data(), REQUEST.size()) < 0)
+            std::exit(1);
+        conn.readFromSocket();
+        if (!conn.parseInput())
+            std::exit(1);
+        HttpResponse response(200);
+        response.setBody("<html><body>hello</body></html>", "text/html");
+        conn.queueResponse(response, false);
+        conn.finishRequest();
+        conn.writeToSocket();
+        sink = static_cast<std::size_t>(read(fds[1], reply, sizeof(reply)));
+    }
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    close(fds[0]);
+    close(fds[1]);
+    return elapsed.count() / static_cast<double>(iterations);
+}
+
+int main(int argc, char** argv) {
+    const long iterations = argc > 1 ? std::atol(argv[1]) : 100000;
+    const int  rounds     = 9;
+
+    WorkerStats stats;
+    double      bare    = 1e18;
+    double      counted = 1e18;
+    for (int round = 0; round < rounds; ++round) {
+        // Alternate which variant goes first, so neither always runs on a warmer cache
+        if (round % 2) {
+            counted = std::min(counted, nsPerRequest(iterations, &stats));
+            bare    = std::min(bare, nsPerRequest(iterations, NULL));
+        } else {
+            bare    = std::min(bare, nsPerRequest(iterations, NULL));
+            counted = std::min(counted, nsPerRequest(iterations, &stats));
+        }
+    }
+    assert(stats.total.getCount() == static_cast<std::uint64_t>(iterations) * rounds);
+
+    const double overhead = (counted - bare) / bare * 100.0;
+    std::cout << iterations << " requests per round, best of " << rounds << "\n\n"
+              << std::fixed << std::setprecision(1) << std::left << std::setw(12)
+              << "no stats" << std::right << std::setw(10) << bare << " ns/request\n"
+              << std::left << std::setw(12) << "stats" << std::right << std::setw(10)
+              << counted << " ns/request\n"
+              << std::setprecision(2) << "overhead " << overhead << "% (" << counted - bare
+              << " ns, target < 1%)\n";
+    return 0;
+}
@@ -0,0 +1,91 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_vhosts.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 03:44:45 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 03:44:45 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    bench_vhosts.cpp
+ * @brief   Compares VirtualHostIndex lookups with the linear findMatchingServer.
+ *
+ * @details Builds the given number of server blocks (default 64) spread over two
+ * ports, each with a couple of names, then resolves a fixed mix of Host headers
+ * both ways: names that hit the first, middle and last server, and one that falls
+ * back to the default server of its port.
+ */
+
+#include "core/VirtualHostIndex.hpp"
+#include "core/server_utils.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static volatile std::size_t sink; // Keeps the measured work observable
+
+template <typename Fn> static double nsPerLookup(long lookups, Fn fn) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    fn();
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(lookups);
+}
+
+static int portOf(int server) {
+    return server % 2 ? 8443 : 8080;
+}
+
+int main(int argc, char** argv) {
+    const int  count      = argc > 1 ? std::atoi(argv[1]) : 64;
+    const long iterations = 20000;
+
+    std::vector<Server> servers;
+    for (int i = 0; i < count; ++i) {
+        Server server;
+        server.setPort(portOf(i));
+        server.addServerName("site" + std::to_string(i) + ".example.com");
+        server.addServerName("www.site" + std::to_string(i) + ".example.com");
+        servers.push_back(server);
+    }
+    const VirtualHostIndex index(servers);
+
+    struct Probe {
+        int         port;
+        std::string host;
+    };
+    const std::vector<Probe> probes = {
+        {portOf(0), "site0.example.com"},
+        {portOf(count / 2), "site" + std::to_string(count / 2) + ".example.com"},
+        {portOf(count - 1), "www.site" + std::to_string(count - 1) + ".example.com"},
+        {8443, "unknown.example.org"},
+    };
+
+    const long lookups = iterations * static_cast<long>(probes.size());
+    const double linear = nsPerLookup(lookups, [&]() {
+        for (long n = 0; n < iterations; ++n)
+            for (std::size_t i = 0; i < probes.size(); ++i)
+                sink = reinterpret_cast<std::size_t>(
+                    &findMatchingServer(servers, probes[i].port, probes[i].host));
+    });
+    const double hashed = nsPerLookup(lookups, [&]() {
+        for (long n = 0; n < iterations; ++n)
+            for (std::size_t i = 0; i < probes.size(); ++i)
+                sink = reinterpret_cast<std::size_t>(index.find(probes[i].port, probes[i].host));
+    });
+
+    std::cout << servers.size() << " servers, " << index.size() << " names, " << lookups
+              << " lookups\n\n"
+              << std::fixed << std::setprecision(1) << std::left << std::setw(12) << "linear"
+              << std::right << std::setw(10) << linear << " ns/lookup\n"
+              << std::left << std::setw(12) << "vhost index" << std::right << std::setw(10)
+              << hashed << " ns/lookup\n";
+    return 0;
+}
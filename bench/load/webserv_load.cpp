@@ -0,0 +1,319 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   webserv_load.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 03:44:45 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 03:44:45 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    webserv_load.cpp
+ * @brief   Closed-loop HTTP/1.1 load generator used by scripts/run_load_test.sh.
+ *
+ * @details Opens the given number of keep-alive connections, spread over a few
+ * threads that each drive theirs with poll(). Every connection sends one GET,
+ * reads the whole response, records how long it took and sends the next one,
+ * until the duration is over. Responses must carry a Content-Length; a connection
+ * the server closes is reopened. Latencies go into the same log-linear histogram
+ * as the server statistics, so quantiles are within 12.5%.
+ *
+ * Prints requests per second and the p50, p90, p99 and p999 latencies. Exits
+ * with 1 if a request failed or if no request completed at all.
+ */
+
+#include "utils/Stats.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string host        = "127.0.0.1";
+    int         port        = 8080;
+    std::string path        = "/";
+    std::string host_header = "localhost";
+    int         connections = 64;
+    int         threads     = 4;
+    int         seconds     = 10;
+};
+
+/// Results of one thread; the histogram has a single writer like in the server.
+struct Totals {
+    LatencyHistogram latency;
+    std::uint64_t    requests = 0;
+    std::uint64_t    bytes    = 0;
+    std::uint64_t    errors   = 0;
+};
+
+struct Client {
+    int               fd = -1;
+    std::size_t       sent;     ///< Request bytes written so far.
+    std::string       input;    ///< Response bytes not consumed yet.
+    std::size_t       expected; ///< Length of the current response, 0 until its head is in.
+    bool              close;    ///< The server announced it closes after this response.
+    Clock::time_point started;  ///< When the current request started going out.
+};
+
+void usage() {
+    std::cerr << "usage: webserv_load [-h host] [-p port] [-H host_header] [-u path]\n"
+                 "                    [-c connections] [-t threads] [-d seconds]\n";
+    std::exit(2);
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (flag.size() != 2 || flag[0] != '-' || i + 1 >= argc)
+            usage();
+        const char* value = argv[++i];
+        switch (flag[1]) {
+            case 'h': options.host = value; break;
+            case 'p': options.port = std::atoi(value); break;
+            case 'H': options.host_header = value; break;
+            case 'u': options.path = value; break;
+            case 'c': options.connections = std::atoi(value); break;
+            case 't': options.threads = std::atoi(value); break;
+            case 'd': options.seconds = std::atoi(value); break;
+            default: usage();
+        }
+    }
+    if (options.port <= 0 || options.connections <= 0 || options.threads <= 0 ||
+        options.seconds <= 0)
+        usage();
+    if (options.threads > options.connections)
+        options.threads = options.connections;
+    return options;
+}
+
+// The connect completes in the background; the first request waits for POLLOUT
+bool openClient(Client& client, const sockaddr_in& address) {
+    client.fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (client.fd < 0)
+        return false;
+    const int one = 1;
+    setsockopt(client.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(client.fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 &&
+        errno != EINPROGRESS) {
+        close(client.fd);
+        client.fd = -1;
+        return false;
+    }
+    client.sent     = 0;
+    client.expected = 0;
+    client.close    = false;
+    client.input.clear();
+    return true;
+}
+
+void closeClient(Client& client) {
+    if (client.fd >= 0)
+        close(client.fd);
+    client.fd = -1;
+}
+
+// Case-insensitive search for a header field name at the start of a line
+std::size_t findField(const std::string& head, const char* name) {
+    const std::size_t length = std::strlen(name);
+    for (std::size_t at = head.find("\r\n"); at != std::string::npos;
+         at = head.find("\r\n", at + 2)) {
+        if (head.size() - (at + 2) >= length &&
+            strncasecmp(head.data() + at + 2, name, length) == 0)
+            return at + 2 + length;
+    }
+    return std::string::npos;
+}
+
+/**
+ * Parses the head of the buffered response. Returns false on a response the
+ * harness cannot frame; sets @c expected to the whole response length otherwise.
+ */
+bool parseHead(Client& client) {
+    const std::size_t end = client.input.find("\r\n\r\n");
+    if (end == std::string::npos)
+        return true;
+    const std::string head = client.input.substr(0, end + 2);
+    if (head.compare(0, 9, "HTTP/1.1 ") != 0 || head.compare(9, 1, "2") != 0)
+        return false;
+    const std::size_t length = findField(head, "Content-Length:");
+    if (length == std::string::npos)
+        return false;
+    client.expected = end + 4 + std::strtoul(head.c_str() + length, NULL, 10);
+    const std::size_t connection = findField(head, "Connection:");
+    client.close = connection != std::string::npos &&
+                   head.compare(connection, 6, " close") == 0;
+    return true;
+}
+
+void runThread(const Options& options, const sockaddr_in& address, int connections,
+               Clock::time_point deadline, Totals& totals) {
+    const std::string request = "GET " + options.path + " HTTP/1.1\r\nHost: " +
+                                options.host_header + "\r\nUser-Agent: webserv_load\r\n\r\n";
+    std::vector<Client> clients(static_cast<std::size_t>(connections));
+    std::vector<pollfd> fds(clients.size());
+    char                buf[65536];
+
+    for (Client& client : clients) {
+        if (!openClient(client, address))
+            ++totals.errors;
+    }
+    while (Clock::now() < deadline) {
+        for (std::size_t i = 0; i < clients.size(); ++i) {
+            if (clients[i].fd < 0 && !openClient(clients[i], address))
+                ++totals.errors;
+            fds[i].fd      = clients[i].fd;
+            fds[i].events  = clients[i].sent < request.size() ? POLLOUT : POLLIN;
+            fds[i].revents = 0;
+        }
+        if (poll(fds.data(), fds.size(), 100) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        for (std::size_t i = 0; i < clients.size(); ++i) {
+            Client& client = clients[i];
+            if (client.fd < 0 || !fds[i].revents)
+                continue;
+            if (client.sent < request.size()) {
+                if (client.sent == 0)
+                    client.started = Clock::now();
+                const ssize_t n = send(client.fd, request.data() + client.sent,
+                                       request.size() - client.sent, MSG_NOSIGNAL);
+                if (n < 0 && errno != EAGAIN) {
+                    ++totals.errors;
+                    closeClient(client);
+                } else if (n > 0) {
+                    client.sent += static_cast<std::size_t>(n);
+                }
+                continue;
+            }
+            const ssize_t n = recv(client.fd, buf, sizeof(buf), 0);
+            if (n <= 0) {
+                if (n < 0 && errno == EAGAIN)
+                    continue;
+                // A keep-alive connection closed between responses is not an error
+                if (!client.input.empty() || client.expected)
+                    ++totals.errors;
+                closeClient(client);
+                continue;
+            }
+            client.input.append(buf, static_cast<std::size_t>(n));
+            if (!client.expected && !parseHead(client)) {
+                ++totals.errors;
+                closeClient(client);
+                continue;
+            }
+            if (!client.expected || client.input.size() < client.expected)
+                continue;
+
+            const Clock::time_point now = Clock::now();
+            totals.latency.record(now - client.started);
+            totals.bytes += client.expected;
+            ++totals.requests;
+            if (client.close) {
+                closeClient(client);
+                continue;
+            }
+            client.input.erase(0, client.expected);
+            client.expected = 0;
+            client.sent     = 0;
+        }
+    }
+    for (Client& client : clients)
+        closeClient(client);
+}
+
+// Upper bound of the bucket holding the sample of rank q * count
+double quantileMs(const std::vector<std::uint64_t>& buckets, std::uint64_t count, double q) {
+    const double  target = q * static_cast<double>(count);
+    std::uint64_t seen   = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen && static_cast<double>(seen) >= target)
+            return static_cast<double>(LatencyHistogram::upperBound(i)) / 1000.0;
+    }
+    return 0.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const Options options = parseOptions(argc, argv);
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port   = htons(static_cast<std::uint16_t>(options.port));
+    if (inet_pton(AF_INET, options.host.c_str(), &address.sin_addr) != 1) {
+        std::cerr << "webserv_load: not an IPv4 address: " << options.host << "\n";
+        return 2;
+    }
+
+    std::vector<Totals>      totals(static_cast<std::size_t>(options.threads));
+    std::vector<std::thread> threads;
+    const Clock::time_point  start    = Clock::now();
+    const Clock::time_point  deadline = start + std::chrono::seconds(options.seconds);
+    for (int t = 0; t < options.threads; ++t) {
+        // Spread the remainder so every connection is opened exactly once
+        const int share = options.connections / options.threads +
+                          (t < options.connections % options.threads ? 1 : 0);
+        threads.push_back(std::thread(runThread, std::cref(options), std::cref(address), share,
+                                      deadline, std::ref(totals[static_cast<std::size_t>(t)])));
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    std::vector<std::uint64_t> buckets(LatencyHistogram::BUCKETS, 0);
+    std::uint64_t              requests = 0;
+    std::uint64_t              bytes    = 0;
+    std::uint64_t              errors   = 0;
+    for (const Totals& part : totals) {
+        for (std::size_t i = 0; i < buckets.size(); ++i)
+            buckets[i] += part.latency.getBucket(i);
+        requests += part.requests;
+        bytes += part.bytes;
+        errors += part.errors;
+    }
+
+    const double seconds = elapsed.count();
+    std::cout << options.connections << " connections on " << options.threads << " threads, GET "
+              << options.path << " for " << std::fixed << std::setprecision(1) << seconds
+              << " s\n\n"
+              << std::left << std::setw(12) << "requests" << std::right << std::setw(12)
+              << requests << "\n"
+              << std::left << std::setw(12) << "errors" << std::right << std::setw(12) << errors
+              << "\n"
+              << std::left << std::setw(12) << "req/s" << std::right << std::setw(12)
+              << static_cast<double>(requests) / seconds << "\n"
+              << std::left << std::setw(12) << "MiB/s" << std::right << std::setw(12)
+              << static_cast<double>(bytes) / seconds / (1024.0 * 1024.0) << "\n"
+              << std::setprecision(3);
+    static const struct {
+        double      q;
+        const char* label;
+    } QUANTILES[] = {{0.5, "p50"}, {0.9, "p90"}, {0.99, "p99"}, {0.999, "p999"}};
+    for (const auto& quantile : QUANTILES)
+        std::cout << std::left << std::setw(12) << quantile.label << std::right << std::setw(12)
+                  << quantileMs(buckets, requests, quantile.q) << " ms\n";
+    return errors || !requests ? 1 : 0;
+}
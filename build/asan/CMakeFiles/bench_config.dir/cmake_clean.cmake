@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_config.dir/bench/bench_config.cpp.o"
+  "CMakeFiles/bench_config.dir/bench/bench_config.cpp.o.d"
+  "bin/bench/bench_config"
+  "bin/bench/bench_config.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_config.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
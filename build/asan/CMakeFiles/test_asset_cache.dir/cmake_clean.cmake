@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_asset_cache.dir/tests/test_asset_cache.cpp.o"
+  "CMakeFiles/test_asset_cache.dir/tests/test_asset_cache.cpp.o.d"
+  "bin/tests/test_asset_cache"
+  "bin/tests/test_asset_cache.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_asset_cache.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
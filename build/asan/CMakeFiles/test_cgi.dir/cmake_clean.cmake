@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_cgi.dir/tests/test_cgi.cpp.o"
+  "CMakeFiles/test_cgi.dir/tests/test_cgi.cpp.o.d"
+  "bin/tests/test_cgi"
+  "bin/tests/test_cgi.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_cgi.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
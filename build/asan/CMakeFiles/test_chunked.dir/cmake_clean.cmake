@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_chunked.dir/tests/test_chunked.cpp.o"
+  "CMakeFiles/test_chunked.dir/tests/test_chunked.cpp.o.d"
+  "bin/tests/test_chunked"
+  "bin/tests/test_chunked.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_chunked.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_config.dir/tests/test_config.cpp.o"
+  "CMakeFiles/test_config.dir/tests/test_config.cpp.o.d"
+  "bin/tests/test_config"
+  "bin/tests/test_config.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_config.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
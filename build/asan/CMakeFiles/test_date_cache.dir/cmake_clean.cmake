@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_date_cache.dir/tests/test_date_cache.cpp.o"
+  "CMakeFiles/test_date_cache.dir/tests/test_date_cache.cpp.o.d"
+  "bin/tests/test_date_cache"
+  "bin/tests/test_date_cache.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_date_cache.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
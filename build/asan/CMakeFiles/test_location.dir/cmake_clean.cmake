@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_location.dir/tests/test_location.cpp.o"
+  "CMakeFiles/test_location.dir/tests/test_location.cpp.o.d"
+  "bin/tests/test_location"
+  "bin/tests/test_location.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_location.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_route_table.dir/tests/test_route_table.cpp.o"
+  "CMakeFiles/test_route_table.dir/tests/test_route_table.cpp.o.d"
+  "bin/tests/test_route_table"
+  "bin/tests/test_route_table.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_route_table.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_server.dir/tests/test_server.cpp.o"
+  "CMakeFiles/test_server.dir/tests/test_server.cpp.o.d"
+  "bin/tests/test_server"
+  "bin/tests/test_server.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
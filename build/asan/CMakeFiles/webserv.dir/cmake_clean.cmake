@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/webserv.dir/src/core/main.cpp.o"
+  "CMakeFiles/webserv.dir/src/core/main.cpp.o.d"
+  "bin/webserv"
+  "bin/webserv.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/webserv.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
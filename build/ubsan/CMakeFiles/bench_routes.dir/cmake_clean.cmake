@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_routes.dir/bench/bench_routes.cpp.o"
+  "CMakeFiles/bench_routes.dir/bench/bench_routes.cpp.o.d"
+  "bin/bench/bench_routes"
+  "bin/bench/bench_routes.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_routes.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_vhosts.dir/bench/bench_vhosts.cpp.o"
+  "CMakeFiles/bench_vhosts.dir/bench/bench_vhosts.cpp.o.d"
+  "bin/bench/bench_vhosts"
+  "bin/bench/bench_vhosts.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_vhosts.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_buffer_pool.dir/tests/test_buffer_pool.cpp.o"
+  "CMakeFiles/test_buffer_pool.dir/tests/test_buffer_pool.cpp.o.d"
+  "bin/tests/test_buffer_pool"
+  "bin/tests/test_buffer_pool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_buffer_pool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_compression.dir/tests/test_compression.cpp.o"
+  "CMakeFiles/test_compression.dir/tests/test_compression.cpp.o.d"
+  "bin/tests/test_compression"
+  "bin/tests/test_compression.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_compression.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_cpu_affinity.dir/tests/test_cpu_affinity.cpp.o"
+  "CMakeFiles/test_cpu_affinity.dir/tests/test_cpu_affinity.cpp.o.d"
+  "bin/tests/test_cpu_affinity"
+  "bin/tests/test_cpu_affinity.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_cpu_affinity.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_fastcgi.dir/tests/test_fastcgi.cpp.o"
+  "CMakeFiles/test_fastcgi.dir/tests/test_fastcgi.cpp.o.d"
+  "bin/tests/test_fastcgi"
+  "bin/tests/test_fastcgi.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_fastcgi.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
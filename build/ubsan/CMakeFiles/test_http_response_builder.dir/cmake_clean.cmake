@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_http_response_builder.dir/tests/test_http_response_builder.cpp.o"
+  "CMakeFiles/test_http_response_builder.dir/tests/test_http_response_builder.cpp.o.d"
+  "bin/tests/test_http_response_builder"
+  "bin/tests/test_http_response_builder.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_http_response_builder.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_http_scanner.dir/tests/test_http_scanner.cpp.o"
+  "CMakeFiles/test_http_scanner.dir/tests/test_http_scanner.cpp.o.d"
+  "bin/tests/test_http_scanner"
+  "bin/tests/test_http_scanner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_http_scanner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_logger.dir/tests/test_logger.cpp.o"
+  "CMakeFiles/test_logger.dir/tests/test_logger.cpp.o.d"
+  "bin/tests/test_logger"
+  "bin/tests/test_logger.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_logger.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_request_trace.dir/tests/test_request_trace.cpp.o"
+  "CMakeFiles/test_request_trace.dir/tests/test_request_trace.cpp.o.d"
+  "bin/tests/test_request_trace"
+  "bin/tests/test_request_trace.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_request_trace.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
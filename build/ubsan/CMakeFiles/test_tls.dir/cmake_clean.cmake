@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_tls.dir/tests/test_tls.cpp.o"
+  "CMakeFiles/test_tls.dir/tests/test_tls.cpp.o.d"
+  "bin/tests/test_tls"
+  "bin/tests/test_tls.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tls.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_upload.dir/tests/test_upload.cpp.o"
+  "CMakeFiles/test_upload.dir/tests/test_upload.cpp.o.d"
+  "bin/tests/test_upload"
+  "bin/tests/test_upload.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_upload.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_virtual_host_index.dir/tests/test_virtual_host_index.cpp.o"
+  "CMakeFiles/test_virtual_host_index.dir/tests/test_virtual_host_index.cpp.o.d"
+  "bin/tests/test_virtual_host_index"
+  "bin/tests/test_virtual_host_index.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_virtual_host_index.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
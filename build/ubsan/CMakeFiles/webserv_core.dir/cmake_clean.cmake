@@ -0,0 +1,109 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/webserv_core.dir/src/cgi/CgiOutputParser.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/cgi/CgiOutputParser.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/cgi/CgiProcess.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/cgi/CgiProcess.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/cgi/FastCgiPool.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/cgi/FastCgiPool.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/cgi/FastCgiProtocol.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/cgi/FastCgiProtocol.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/config/Config.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/config/Config.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/config/ConfigParser.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/config/ConfigParser.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/config/ConfigSnapshot.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/config/ConfigSnapshot.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/core/Location.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/core/Location.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/core/RouteTable.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/core/RouteTable.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/core/Server.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/core/Server.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/core/VirtualHostIndex.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/core/VirtualHostIndex.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/core/Webserv.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/core/Webserv.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/core/server_utils.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/core/server_utils.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/AssetCache.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/AssetCache.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/ChunkedDecoder.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/ChunkedDecoder.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/ChunkedEncoder.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/ChunkedEncoder.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/Compression.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/Compression.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/DateCache.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/DateCache.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/DirectoryListing.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/DirectoryListing.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/FileCache.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/FileCache.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/HeaderFields.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/HeaderFields.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/HttpMethod.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/HttpMethod.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/HttpRequest.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/HttpRequest.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/HttpRequestParser.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/HttpRequestParser.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/HttpResponse.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/HttpResponse.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/HttpResponseBuilder.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/HttpResponseBuilder.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/HttpScanner.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/HttpScanner.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/MultipartParser.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/MultipartParser.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/http/UploadWriter.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/http/UploadWriter.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/BufferPool.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/BufferPool.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/ByteBuffer.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/ByteBuffer.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/Connection.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/Connection.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/EpollManager.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/EpollManager.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/KqueueManager.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/KqueueManager.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/PollFallbackManager.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/PollFallbackManager.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/PollManager.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/PollManager.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/SocketAddress.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/SocketAddress.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/SocketManager.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/SocketManager.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/TimerWheel.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/TimerWheel.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/TlsContext.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/TlsContext.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/UpstreamPool.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/UpstreamPool.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/network/UringManager.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/network/UringManager.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/utils/Arena.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/utils/Arena.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/utils/CpuAffinity.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/utils/CpuAffinity.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/utils/InternedString.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/utils/InternedString.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/utils/Logger.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/utils/Logger.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/utils/PrintInfo.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/utils/PrintInfo.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/utils/RequestTrace.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/utils/RequestTrace.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/utils/Stats.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/utils/Stats.cpp.o.d"
+  "CMakeFiles/webserv_core.dir/src/utils/StringUtils.cpp.o"
+  "CMakeFiles/webserv_core.dir/src/utils/StringUtils.cpp.o.d"
+  "libwebserv_core.a"
+  "libwebserv_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/webserv_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/webserv_load.dir/bench/load/webserv_load.cpp.o"
+  "CMakeFiles/webserv_load.dir/bench/load/webserv_load.cpp.o.d"
+  "bin/bench/webserv_load"
+  "bin/bench/webserv_load.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/webserv_load.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/webserv_load_test"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/webserv_load_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,68 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/build/ubsan
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_arena "/root/repo/build/ubsan/bin/tests/test_arena")
+set_tests_properties(test_arena PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_asset_cache "/root/repo/build/ubsan/bin/tests/test_asset_cache")
+set_tests_properties(test_asset_cache PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_buffer_pool "/root/repo/build/ubsan/bin/tests/test_buffer_pool")
+set_tests_properties(test_buffer_pool PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_cgi "/root/repo/build/ubsan/bin/tests/test_cgi")
+set_tests_properties(test_cgi PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_chunked "/root/repo/build/ubsan/bin/tests/test_chunked")
+set_tests_properties(test_chunked PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_compression "/root/repo/build/ubsan/bin/tests/test_compression")
+set_tests_properties(test_compression PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_config "/root/repo/build/ubsan/bin/tests/test_config")
+set_tests_properties(test_config PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_config_parser "/root/repo/build/ubsan/bin/tests/test_config_parser")
+set_tests_properties(test_config_parser PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_connection "/root/repo/build/ubsan/bin/tests/test_connection")
+set_tests_properties(test_connection PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_cpu_affinity "/root/repo/build/ubsan/bin/tests/test_cpu_affinity")
+set_tests_properties(test_cpu_affinity PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_date_cache "/root/repo/build/ubsan/bin/tests/test_date_cache")
+set_tests_properties(test_date_cache PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_directory_listing "/root/repo/build/ubsan/bin/tests/test_directory_listing")
+set_tests_properties(test_directory_listing PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_fastcgi "/root/repo/build/ubsan/bin/tests/test_fastcgi")
+set_tests_properties(test_fastcgi PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_file_cache "/root/repo/build/ubsan/bin/tests/test_file_cache")
+set_tests_properties(test_file_cache PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_http_request_parser "/root/repo/build/ubsan/bin/tests/test_http_request_parser")
+set_tests_properties(test_http_request_parser PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_http_response_builder "/root/repo/build/ubsan/bin/tests/test_http_response_builder")
+set_tests_properties(test_http_response_builder PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_http_scanner "/root/repo/build/ubsan/bin/tests/test_http_scanner")
+set_tests_properties(test_http_scanner PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_location "/root/repo/build/ubsan/bin/tests/test_location")
+set_tests_properties(test_location PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_logger "/root/repo/build/ubsan/bin/tests/test_logger")
+set_tests_properties(test_logger PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_poll_manager "/root/repo/build/ubsan/bin/tests/test_poll_manager")
+set_tests_properties(test_poll_manager PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_request_trace "/root/repo/build/ubsan/bin/tests/test_request_trace")
+set_tests_properties(test_request_trace PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_route_table "/root/repo/build/ubsan/bin/tests/test_route_table")
+set_tests_properties(test_route_table PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_server "/root/repo/build/ubsan/bin/tests/test_server")
+set_tests_properties(test_server PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_socket_manager "/root/repo/build/ubsan/bin/tests/test_socket_manager")
+set_tests_properties(test_socket_manager PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_stats "/root/repo/build/ubsan/bin/tests/test_stats")
+set_tests_properties(test_stats PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_string_utils "/root/repo/build/ubsan/bin/tests/test_string_utils")
+set_tests_properties(test_string_utils PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_timer_wheel "/root/repo/build/ubsan/bin/tests/test_timer_wheel")
+set_tests_properties(test_timer_wheel PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_tls "/root/repo/build/ubsan/bin/tests/test_tls")
+set_tests_properties(test_tls PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_upload "/root/repo/build/ubsan/bin/tests/test_upload")
+set_tests_properties(test_upload PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_upstream_pool "/root/repo/build/ubsan/bin/tests/test_upstream_pool")
+set_tests_properties(test_upstream_pool PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_virtual_host_index "/root/repo/build/ubsan/bin/tests/test_virtual_host_index")
+set_tests_properties(test_virtual_host_index PROPERTIES  TIMEOUT "10" _BACKTRACE_TRIPLES "/root/repo/cmake/CTestSettings.cmake;14;add_test;/root/repo/CMakeLists.txt;156;register_test;/root/repo/CMakeLists.txt;0;")
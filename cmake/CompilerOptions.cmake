@@ -12,10 +12,10 @@ endif()
 # Detect the compiler and set options accordingly
 if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
     # General flags for GCC/Clang
-    set(COMMON_FLAGS "-Wall -Wextra -Werror")
+    set(COMMON_FLAGS -Wall -Wextra -Werror)
 
     # Debug-specific flags
-    set(CMAKE_CXX_FLAGS_DEBUG "-g3 -O0 -DDEBUG")
+    set(CMAKE_CXX_FLAGS_DEBUG "-g3 -O0 -DDEBUG -DWEBSERV_DEBUG")
 
     # Release-specific flags
     set(CMAKE_CXX_FLAGS_RELEASE "-O3")
@@ -23,10 +23,10 @@ if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
     # Additional common flags can be set here if needed
 elseif(CMAKE_CXX_COMPILER_ID MATCHES "MSVC")
     # Microsoft Visual C++
-    set(COMMON_FLAGS "/W4 /WX")
+    set(COMMON_FLAGS /W4 /WX)
 
     # Debug-specific flags
-    set(CMAKE_CXX_FLAGS_DEBUG "/Zi /Od /DDEBUG")
+    set(CMAKE_CXX_FLAGS_DEBUG "/Zi /Od /DDEBUG /DWEBSERV_DEBUG")
 
     # Release-specific flags
     set(CMAKE_CXX_FLAGS_RELEASE "/O2")
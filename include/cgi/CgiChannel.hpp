@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiChannel.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:11:35 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:11:35 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    CgiChannel.hpp
+ * @brief   Declares the CgiChannel interface, the byte streams of one CGI request.
+ *
+ * @details A CGI request reads its body from the server and writes a CGI response
+ * back (RFC 3875). How the bytes travel depends on the backend: the pipes of a
+ * forked CgiProcess, or the records of a FastCgiStream multiplexed on a pooled
+ * connection. The event loop relays both through this interface, with the same
+ * non-blocking conventions as socket I/O.
+ *
+ * @ingroup cgi
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <sys/types.h>
+
+/**
+ * @brief Request body in, CGI response out, without blocking.
+ *
+ * @ingroup cgi
+ */
+class CgiChannel {
+  public:
+    using Clock = std::chrono::steady_clock; ///< Clock used for timeouts.
+
+    virtual ~CgiChannel() = default;
+
+    /**
+     * @brief Sends request body bytes to the script.
+     *
+     * @return Bytes accepted, or -1 with `errno` (`EAGAIN` while the backend is busy).
+     */
+    virtual ssize_t writeInput(const char* data, std::size_t size) noexcept = 0;
+
+    /**
+     * @brief Receives response bytes from the script.
+     *
+     * @return Bytes read, 0 at end of output, or -1 with `errno` (`EAGAIN`: none yet).
+     */
+    virtual ssize_t readOutput(char* buf, std::size_t size) noexcept = 0;
+
+    /**
+     * @brief Ends the request body.
+     */
+    virtual void closeInput() noexcept = 0;
+
+    /**
+     * @brief Returns true until closeInput(), or until the script stopped reading.
+     */
+    virtual bool hasInput() const noexcept = 0;
+
+    /**
+     * @brief Stops the script; its output is no longer wanted.
+     */
+    virtual void terminate() noexcept = 0;
+
+    /**
+     * @brief Returns when the request was handed to the backend.
+     */
+    virtual Clock::time_point getStartTime() const noexcept = 0;
+};
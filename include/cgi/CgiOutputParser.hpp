@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiOutputParser.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:00:25 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:00:25 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    CgiOutputParser.hpp
+ * @brief   Declares the CgiOutputParser, which reads the header block of CGI output.
+ *
+ * @details A CGI script starts its output with header lines, ended by an empty
+ * line, then writes the body (RFC 3875, section 6). The parser is fed the output
+ * as it is read from the pipe and reports when the header block is complete;
+ * the body is then streamed to the client without going through the parser.
+ *
+ * @ingroup cgi
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Incremental parser for the header block of a CGI response.
+ *
+ * @details Lines may end with LF or CRLF. `Status` sets the response status and
+ * a `Location` without one answers 302. Fields the server frames itself
+ * (`Connection`, `Keep-Alive`, `Transfer-Encoding`, `Content-Length`) and the
+ * ones it always sends (`Date`, `Server`) are not kept as fields; a
+ * `Content-Length` is kept as getContentLength() instead.
+ *
+ * @ingroup cgi
+ */
+class CgiOutputParser {
+  public:
+    static constexpr std::size_t MAX_HEAD_SIZE = 8192; ///< Longest accepted header block.
+
+    using Field = std::pair<std::string, std::string>; ///< Name and value.
+
+    /**
+     * @brief Progress of feed().
+     */
+    enum class Result {
+        INCOMPLETE, ///< The header block has not ended yet.
+        COMPLETE,   ///< Header block parsed; the rest is body.
+        ERROR       ///< Malformed or oversized header block.
+    };
+
+    CgiOutputParser();
+
+    /**
+     * @brief Adds output read from the script.
+     *
+     * @details Once COMPLETE was returned, the parser must not be fed again.
+     *
+     * @param data Bytes in the order they were read.
+     */
+    Result feed(std::string_view data);
+
+    int                       getStatus() const noexcept; ///< 200 unless the script said otherwise.
+    const std::vector<Field>& getFields() const noexcept;
+    bool                      hasContentLength() const noexcept;
+    std::size_t               getContentLength() const noexcept;
+
+    /**
+     * @brief Moves out the body bytes that were read together with the header block.
+     */
+    std::string takeBody() noexcept;
+
+  private:
+    std::string        _buffer;         ///< Output up to the end of the header block.
+    std::size_t        _scanned;        ///< Bytes of _buffer known not to end the block.
+    int                _status;         ///< See getStatus().
+    std::vector<Field> _fields;         ///< Fields in the order the script sent them.
+    bool               _has_length;     ///< The script sent Content-Length.
+    std::size_t        _content_length; ///< Value of Content-Length.
+
+    bool parseHead(std::string_view head);
+    bool parseField(std::string_view line);
+};
@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiProcess.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:00:25 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:40:18 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    CgiProcess.hpp
+ * @brief   Declares the CgiProcess class, one running CGI script.
+ *
+ * @details A CGI script is a child process talking to the server through two
+ * non-blocking pipes: the request body goes to its stdin, the response comes
+ * from its stdout. The event loop registers both pipes with its PollManager next
+ * to the client sockets, so a slow script only delays its own client. Nothing
+ * here blocks: writes and reads return `EAGAIN` like socket I/O, and the exit
+ * status is collected with `waitpid(WNOHANG)`.
+ *
+ * @ingroup cgi
+ */
+
+#pragma once
+
+#include "cgi/CgiChannel.hpp"
+#include "core/Location.hpp"
+#include "core/Server.hpp"
+#include "http/HttpRequest.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <vector>
+
+/**
+ * @defgroup cgi CGI
+ * @brief Execution of CGI scripts on the event loop.
+ * @{
+ */
+
+/**
+ * @brief Child process running one CGI script, with its stdin and stdout pipes.
+ *
+ * @details The child gets its own process group, so terminate() also stops the
+ * programs a script started. Destroying a CgiProcess closes both pipes and kills
+ * a child that is still running; a child that has not exited yet by then is left
+ * to reap() by whoever keeps the object alive.
+ *
+ * @ingroup cgi
+ */
+class CgiProcess : public CgiChannel {
+  public:
+    /**
+     * @brief What to execute: argument vector and RFC 3875 meta-variables.
+     */
+    struct Command {
+        std::vector<std::string> argv;        ///< Interpreter and script, or the script.
+        std::vector<std::string> environment; ///< "NAME=value" entries.
+        std::string              directory;   ///< Working directory of the script.
+    };
+
+    CgiProcess() noexcept;
+    ~CgiProcess() override;
+    CgiProcess(const CgiProcess&)            = delete;
+    CgiProcess& operator=(const CgiProcess&) = delete;
+
+    /**
+     * @brief Builds the command line and environment for a request (RFC 3875, section 4.1).
+     *
+     * @details FastCGI backends receive the same environment as their parameters.
+     *
+     * @param request         Parsed request, still bound to its buffer.
+     * @param server          Virtual host answering the request.
+     * @param location        CGI location of the script.
+     * @param script_name     Normalized URI path of the script (`SCRIPT_NAME`).
+     * @param script_filename Filesystem path of the script (`SCRIPT_FILENAME`).
+     * @param path_info       URI path after the script (`PATH_INFO`), mapped under the
+     *                        location's root for `PATH_TRANSLATED`.
+     * @param remote_addr     Numeric address of the client (`REMOTE_ADDR`).
+     */
+    static Command makeCommand(const HttpRequest& request, const Server& server,
+                               const Location& location, std::string_view script_name,
+                               std::string_view script_filename, std::string_view path_info,
+                               std::string_view remote_addr);
+
+    /**
+     * @brief Creates the pipes and forks the child.
+     *
+     * @return False with `errno` set if the pipes or the child could not be created.
+     *         A failing `execve()` is reported later, as an exit without output.
+     */
+    bool start(const Command& command);
+
+    /**
+     * @brief Writes request body bytes to the child's stdin without blocking.
+     *
+     * @return Bytes written, or -1 with `errno` (`EAGAIN` when the pipe is full).
+     */
+    ssize_t writeInput(const char* data, std::size_t size) noexcept override;
+
+    /**
+     * @brief Reads response bytes from the child's stdout without blocking.
+     *
+     * @return Bytes read, 0 at end of output, or -1 with `errno` (`EAGAIN`: none yet).
+     */
+    ssize_t readOutput(char* buf, std::size_t size) noexcept override;
+
+    /**
+     * @brief Closes the child's stdin, which tells it the body is complete.
+     */
+    void closeInput() noexcept override;
+    bool hasInput() const noexcept override;
+
+    /**
+     * @brief Closes the child's stdout; the child gets `SIGPIPE` if it writes more.
+     */
+    void closeOutput() noexcept;
+
+    /**
+     * @brief Kills the child's process group with `SIGKILL`.
+     */
+    void terminate() noexcept override;
+
+    /**
+     * @brief Collects the child's exit status if it has exited.
+     *
+     * @return True once the child is gone (or was never started).
+     */
+    bool reap() noexcept;
+
+    int               getInputFd() const noexcept;  ///< Write end of stdin, -1 once closed.
+    int               getOutputFd() const noexcept; ///< Read end of stdout, -1 once closed.
+    pid_t             getPid() const noexcept;      ///< Child pid, -1 if not running.
+    Clock::time_point getStartTime() const noexcept override;
+
+  private:
+    pid_t             _pid;     ///< Child process, -1 once reaped.
+    int               _in_fd;   ///< Our end of the child's stdin.
+    int               _out_fd;  ///< Our end of the child's stdout.
+    Clock::time_point _started; ///< When start() forked the child.
+};
+
+/** @} */
@@ -0,0 +1,177 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiPool.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:11:35 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:11:35 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    FastCgiPool.hpp
+ * @brief   Declares the FastCgiPool and FastCgiStream classes.
+ *
+ * @details Locations with `fastcgi_pass` hand their CGI requests to a running
+ * FastCGI server (php-fpm and the like) instead of forking a script per request.
+ * Each event loop keeps a pool of persistent, non-blocking connections per
+ * backend address and drives them next to its client sockets. A connection asks
+ * the backend with `FCGI_GET_VALUES` whether it multiplexes; if it does, several
+ * requests share the connection, told apart by their request id. Otherwise each
+ * connection carries one request at a time and is reused for the next one
+ * (`FCGI_KEEP_CONN`). Requests beyond the pool's connections wait in order.
+ *
+ * @ingroup cgi
+ */
+
+#pragma once
+
+#include "cgi/CgiChannel.hpp"
+#include "cgi/FastCgiProtocol.hpp"
+#include "network/PollManager.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <sys/socket.h>
+#include <unordered_map>
+#include <vector>
+
+class FastCgiStream;
+
+/**
+ * @brief Persistent connections to FastCGI backends, owned by one event loop.
+ *
+ * @details The pool registers its sockets with the loop's PollManager; the loop
+ * passes their events to handleEvent() and pumps the woken streams afterwards.
+ * Nothing blocks: connects are asynchronous and backend addresses are numeric
+ * (`127.0.0.1:9000`, `localhost:9000`) or Unix sockets (`unix:/run/php-fpm.sock`).
+ *
+ * @ingroup cgi
+ */
+class FastCgiPool {
+  public:
+    static constexpr std::size_t MAX_CONNECTIONS = 8;  ///< Per backend and event loop.
+    static constexpr std::size_t MAX_STREAMS     = 32; ///< Requests per multiplexed connection.
+    static constexpr std::size_t SEND_BUFFER     = 65536;  ///< Queued bytes before writes wait.
+    static constexpr std::size_t OUTPUT_BUFFER   = 262144; ///< Unread stdout before reads pause.
+    static constexpr long        IDLE_TIMEOUT    = 30; ///< Seconds an unused connection is kept.
+
+    explicit FastCgiPool(PollManager& poller);
+    ~FastCgiPool();
+    FastCgiPool(const FastCgiPool&)            = delete;
+    FastCgiPool& operator=(const FastCgiPool&) = delete;
+
+    /**
+     * @brief Starts a request on the backend at @p address.
+     *
+     * @param address Backend, see the class description.
+     * @param owner   Reported by takeWoken() when the stream makes progress.
+     * @param params  "NAME=value" entries, see CgiProcess::makeCommand().
+     * @return The stream, or NULL with `errno` set if the address is invalid.
+     */
+    std::unique_ptr<FastCgiStream> open(const std::string& address, int owner,
+                                        std::vector<std::string> params);
+
+    /**
+     * @brief Handles an event if @p fd is one of the pool's connections.
+     *
+     * @return False if @p fd does not belong to the pool.
+     */
+    bool handleEvent(int fd, std::uint32_t events);
+
+    /**
+     * @brief Moves out the owners of streams that made progress since the last call.
+     *
+     * @return False if there were none.
+     */
+    bool takeWoken(std::vector<int>& owners);
+
+    /**
+     * @brief Closes connections that carried no request for IDLE_TIMEOUT seconds.
+     */
+    void closeIdle(CgiChannel::Clock::time_point now);
+
+    std::size_t getConnectionCount() const noexcept; ///< Open or connecting.
+
+  private:
+    friend class FastCgiStream;
+    struct Link; ///< One backend connection, defined with the implementation.
+
+    /// Parsed backend address and its connections.
+    struct Backend {
+        sockaddr_storage                   addr;    ///< Where to connect.
+        socklen_t                          length;  ///< Size of addr.
+        std::vector<std::unique_ptr<Link>> links;   ///< Open or connecting.
+        std::deque<FastCgiStream*>         waiting; ///< Streams without a link yet.
+    };
+
+    PollManager&                                              _poller;   ///< Loop's backend.
+    std::unordered_map<std::string, std::unique_ptr<Backend>> _backends; ///< By address.
+    std::vector<Link*>                                        _by_fd;    ///< Socket -> link.
+    std::vector<int>                                          _woken;    ///< See takeWoken().
+
+    Backend*    findBackend(const std::string& address);
+    void        schedule(Backend& backend, FastCgiStream& stream);
+    Link*       connectLink(Backend& backend);
+    void        attach(Link& link, FastCgiStream& stream);
+    void        detach(FastCgiStream& stream) noexcept;
+    void        flush(Link& link);
+    void        readLink(Link& link);
+    bool        handleRecord(Link& link, const FastCgiReader::Record& record);
+    void        endStream(Link& link, std::uint16_t id);
+    void        failLink(Link& link, int error);
+    void        closeLink(Link& link);
+    void        prune(Backend& backend);
+    void        updateInterest(Link& link);
+    void        resumeRead(Link& link);
+    void        wake(FastCgiStream& stream);
+    std::size_t queuedBytes(const Link& link) const noexcept;
+};
+
+/**
+ * @brief One request on a FastCGI backend, seen as a CgiChannel.
+ *
+ * @details Created by FastCgiPool::open(). Body bytes become `FCGI_STDIN`
+ * records and `FCGI_STDOUT` records are buffered until read. The pool reports
+ * progress on a stream by waking its owner, see FastCgiPool::takeWoken().
+ * Destroying a stream that has not ended aborts its request.
+ *
+ * @ingroup cgi
+ */
+class FastCgiStream : public CgiChannel {
+  public:
+    ~FastCgiStream() override;
+    FastCgiStream(const FastCgiStream&)            = delete;
+    FastCgiStream& operator=(const FastCgiStream&) = delete;
+
+    ssize_t           writeInput(const char* data, std::size_t size) noexcept override;
+    ssize_t           readOutput(char* buf, std::size_t size) noexcept override;
+    void              closeInput() noexcept override;
+    bool              hasInput() const noexcept override;
+    void              terminate() noexcept override; ///< Aborts the request.
+    Clock::time_point getStartTime() const noexcept override;
+
+    int getOwner() const noexcept; ///< Value given to FastCgiPool::open().
+
+  private:
+    friend class FastCgiPool;
+
+    FastCgiStream(FastCgiPool& pool, int owner, std::vector<std::string> params);
+
+    FastCgiPool&             _pool;        ///< Pool carrying the request.
+    FastCgiPool::Link*       _link;        ///< Connection carrying it, NULL while queued or done.
+    std::uint16_t            _id;          ///< Request id on _link.
+    int                      _owner;       ///< Woken when the stream makes progress.
+    std::vector<std::string> _params;      ///< Environment, sent once the stream has a link.
+    std::string              _output;      ///< Received stdout not read yet.
+    std::size_t              _output_read; ///< Bytes of _output already read.
+    bool                     _input_open;  ///< closeInput() not called yet.
+    bool                     _ended;       ///< END_REQUEST received.
+    int                      _error;       ///< errno of a failed request, 0 if none.
+    bool                     _want_write;  ///< writeInput() returned EAGAIN.
+    Clock::time_point        _started;     ///< When open() was called.
+};
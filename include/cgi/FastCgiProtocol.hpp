@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiProtocol.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:11:35 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:11:35 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    FastCgiProtocol.hpp
+ * @brief   Declares the FastCGI record encoders and the FastCgiReader.
+ *
+ * @details FastCGI 1.0 frames everything in records: an 8-byte header with the
+ * type, the request id and the content length, then at most 65535 content bytes
+ * and padding. Requests are multiplexed on one connection by their id. The
+ * helpers below append encoded records to an output string; the reader splits
+ * received bytes back into records without copying them.
+ *
+ * @ingroup cgi
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+constexpr std::uint8_t  FCGI_VERSION          = 1;
+constexpr std::size_t   FCGI_HEADER_SIZE      = 8;
+constexpr std::size_t   FCGI_MAX_CONTENT      = 65535;
+constexpr std::uint16_t FCGI_MANAGEMENT_ID    = 0; ///< Id of records about the connection.
+constexpr std::uint16_t FCGI_RESPONDER        = 1; ///< Role of a CGI-like request.
+constexpr std::uint8_t  FCGI_KEEP_CONN        = 1; ///< BEGIN_REQUEST flag.
+constexpr std::uint8_t  FCGI_REQUEST_COMPLETE = 0; ///< END_REQUEST protocol status.
+
+/**
+ * @brief FastCGI record types.
+ *
+ * @ingroup cgi
+ */
+enum class FastCgiType : std::uint8_t {
+    BEGIN_REQUEST     = 1,
+    ABORT_REQUEST     = 2,
+    END_REQUEST       = 3,
+    PARAMS            = 4,
+    STDIN             = 5,
+    STDOUT            = 6,
+    STDERR            = 7,
+    DATA              = 8,
+    GET_VALUES        = 9,
+    GET_VALUES_RESULT = 10,
+    UNKNOWN_TYPE      = 11
+};
+
+/**
+ * @brief Appends one stream record per 65535 bytes of @p content.
+ *
+ * @details An empty @p content appends the empty record that ends a stream.
+ */
+void appendFastCgiStream(std::string& out, FastCgiType type, std::uint16_t id,
+                         std::string_view content);
+
+/**
+ * @brief Appends the BEGIN_REQUEST record of a responder that keeps the connection.
+ */
+void appendFastCgiBegin(std::string& out, std::uint16_t id);
+
+/**
+ * @brief Appends the ABORT_REQUEST record of a request.
+ */
+void appendFastCgiAbort(std::string& out, std::uint16_t id);
+
+/**
+ * @brief Appends the PARAMS stream for "NAME=value" entries, with its end record.
+ */
+void appendFastCgiParams(std::string& out, std::uint16_t id,
+                         const std::vector<std::string>& environment);
+
+/**
+ * @brief Appends a GET_VALUES record asking for FCGI_MPXS_CONNS and FCGI_MAX_REQS.
+ */
+void appendFastCgiGetValues(std::string& out);
+
+/**
+ * @brief Reads the next name-value pair of a PARAMS or GET_VALUES_RESULT body.
+ *
+ * @param content Remaining pairs; advanced past the pair read.
+ * @return False at the end of @p content or if the pair is truncated.
+ */
+bool nextFastCgiPair(std::string_view& content, std::string_view& name, std::string_view& value);
+
+/**
+ * @brief Splits received bytes into FastCGI records.
+ *
+ * @ingroup cgi
+ */
+class FastCgiReader {
+  public:
+    /**
+     * @brief Record returned by next(); its content points into the reader.
+     */
+    struct Record {
+        FastCgiType      type;    ///< Record type; unknown values are passed through.
+        std::uint16_t    id;      ///< Request id, 0 for management records.
+        std::string_view content; ///< Valid until the next call to feed() or next().
+    };
+
+    /**
+     * @brief Progress of next().
+     */
+    enum class Result {
+        INCOMPLETE, ///< More bytes are needed for the next record.
+        RECORD,     ///< A record was returned.
+        ERROR       ///< Unsupported protocol version.
+    };
+
+    FastCgiReader();
+
+    /**
+     * @brief Adds bytes read from the backend.
+     */
+    void feed(std::string_view data);
+
+    /**
+     * @brief Returns the next complete record.
+     */
+    Result next(Record& record);
+
+  private:
+    std::string _buffer; ///< Received bytes.
+    std::size_t _offset; ///< Bytes of _buffer returned as records.
+};
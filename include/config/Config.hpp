@@ -23,8 +23,24 @@
 #pragma once
 
 #include "core/Server.hpp"
+#include "http/Compression.hpp"
+#include "network/PollManager.hpp"
+#include <cstdint>
 #include <vector>
 
+/**
+ * @brief How event loop threads are placed on CPUs (`worker_cpu_affinity`).
+ *
+ * @details Loops are numbered across workers: loop `i` of worker `w` is loop
+ * `w * worker_threads + i`, and takes the CPU at that index, wrapping around.
+ * @ingroup config
+ */
+enum class CpuAffinity : std::uint8_t {
+    OFF,  ///< The scheduler moves loops freely.
+    AUTO, ///< One CPU per loop, among those the process may run on.
+    LIST  ///< One CPU per loop, from Config::getWorkerCpus().
+};
+
 /**
  * @brief Top-level server configuration container.
  *
@@ -35,11 +51,25 @@
  */
 class Config {
   private:
-    std::vector<Server> _servers; ///< List of all parsed servers
+    std::vector<Server>   _servers;          ///< List of all parsed servers
+    size_t                _worker_processes; ///< Worker processes, 0 = one per CPU.
+    size_t                _worker_threads;   ///< Event loop threads per worker, 0 = one per CPU.
+    size_t                _asset_cache_size; ///< Bytes of small responses cached per event loop.
+    size_t                _max_connections;  ///< Clients per event loop, 0 = no limit.
+    unsigned              _compress_budget;  ///< Percent of a loop's time spent compressing.
+    size_t                _slow_request_ms;  ///< Requests logged when slower, 0 = off.
+    PollBackend           _event_backend;    ///< Readiness backend of every event loop.
+    CpuAffinity           _cpu_affinity;     ///< Placement of event loop threads.
+    std::vector<unsigned> _worker_cpus;      ///< CPUs of CpuAffinity::LIST, in loop order.
+    bool                  _numa_local;       ///< Loops allocate from their own NUMA node.
 
   public:
+    static constexpr size_t DEFAULT_ASSET_CACHE_SIZE = 8 << 20; ///< 8 MiB per event loop.
+    static constexpr size_t DEFAULT_MAX_CONNECTIONS  = 1024;    ///< Clients per event loop.
+    static constexpr unsigned DEFAULT_COMPRESS_BUDGET = CompressionBudget::DEFAULT_PERCENT; ///< %.
+
     // --- Constructor / Destructor ---
-    Config()                         = default;
+    Config();
     ~Config()                        = default;
     Config(const Config&)            = default;
     Config& operator=(const Config&) = default;
@@ -68,10 +98,133 @@ class Config {
      */
     void addServer(const Server& server);
 
+    /**
+     * @brief Adds a Server configuration, taking over its contents.
+     *
+     * @param server A fully initialized Server object.
+     */
+    void addServer(Server&& server);
+
+    /**
+     * @brief Appends a default Server and returns it, to be filled in place.
+     *
+     * @return The new server; valid until the next server is added.
+     */
+    Server& emplaceServer();
+
     /**
      * @brief Returns the list of configured servers.
      *
      * @return Read-only reference to internal server list.
      */
     const std::vector<Server>& getServers() const;
+
+    /**
+     * @brief Moves the servers out, leaving the other settings untouched.
+     *
+     * @return Every configured server; the config is left without any.
+     */
+    std::vector<Server> releaseServers() noexcept;
+
+    // --- Worker model ---
+
+    void setWorkerProcesses(size_t count);
+    void setWorkerThreads(size_t count);
+
+    /**
+     * @brief Returns the configured number of worker processes (default 1).
+     *
+     * @details Above one, a master process supervises the workers. 0 means one
+     * worker per online CPU.
+     */
+    size_t getWorkerProcesses() const noexcept;
+
+    /**
+     * @brief Returns the configured number of event loop threads per worker (default 1).
+     *
+     * @details 0 means one thread per online CPU.
+     */
+    size_t getWorkerThreads() const noexcept;
+
+    void setEventBackend(PollBackend backend);
+
+    /**
+     * @brief Returns the event backend every loop is created with (default AUTO).
+     *
+     * @details AUTO picks epoll or kqueue. PollBackend::IO_URING must be named
+     * explicitly and only starts when the build enabled `WEBSERV_IO_URING`.
+     */
+    PollBackend getEventBackend() const noexcept;
+
+    // --- CPU placement ---
+
+    void setCpuAffinity(CpuAffinity mode, std::vector<unsigned> cpus = {});
+    void setNumaLocal(bool enabled);
+
+    /**
+     * @brief Returns how event loop threads are pinned to CPUs (default OFF).
+     */
+    CpuAffinity getCpuAffinity() const noexcept;
+
+    /**
+     * @brief Returns the CPUs of CpuAffinity::LIST, one per loop, reused in turn.
+     */
+    const std::vector<unsigned>& getWorkerCpus() const noexcept;
+
+    /**
+     * @brief Returns true if each pinned loop prefers memory of its own NUMA node.
+     *
+     * @details Only a pinned loop stays on one node, so this needs an affinity.
+     */
+    bool isNumaLocal() const noexcept;
+
+    // --- Caching ---
+
+    void setAssetCacheSize(size_t bytes);
+
+    /**
+     * @brief Returns the memory cap of each event loop's small-response cache.
+     *
+     * @details Defaults to DEFAULT_ASSET_CACHE_SIZE; 0 disables the cache, so every
+     * file is sent with `sendfile()`.
+     */
+    size_t getAssetCacheSize() const noexcept;
+
+    // --- Limits ---
+
+    void setMaxConnections(size_t count);
+
+    /**
+     * @brief Returns how many clients each event loop serves at once.
+     *
+     * @details Defaults to DEFAULT_MAX_CONNECTIONS; 0 removes the limit. A loop at
+     * its limit stops accepting, so new clients wait in the listen backlog instead
+     * of exhausting the process's descriptors.
+     */
+    size_t getMaxConnections() const noexcept;
+
+    // --- Compression ---
+
+    void setCompressCpuBudget(unsigned percent);
+
+    /**
+     * @brief Returns the share of each event loop's time it may spend compressing.
+     *
+     * @details A percentage, DEFAULT_COMPRESS_BUDGET by default. Above it, responses
+     * that would be compressed on the fly go out uncompressed; 0 disables on-the-fly
+     * compression and leaves only precompressed files.
+     */
+    unsigned getCompressCpuBudget() const noexcept;
+
+    // --- Tracing ---
+
+    void setSlowRequestThreshold(size_t milliseconds);
+
+    /**
+     * @brief Returns the time above which a request is logged with its phases, in ms.
+     *
+     * @details 0, the default, turns request tracing off. The time runs from the
+     * first byte of the request head to the last byte of its response.
+     */
+    size_t getSlowRequestThreshold() const noexcept;
 };
@@ -0,0 +1,161 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ConfigParser.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: irychkov <irychkov@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/05/30 10:14:27 by irychkov          #+#    #+#             */
+/*   Updated: 2025/05/31 15:02:48 by irychkov         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    ConfigParser.hpp
+ * @brief   Declares the ConfigParser class, which reads configuration files.
+ *
+ * @details The file is memory-mapped and read in a single pass. Tokens are slices
+ * of the mapping, so words are never copied into temporary strings. Server and
+ * Location blocks are built in place; Location values are interned, so a value
+ * repeated across blocks is stored once. Parse time grows linearly with the file.
+ *
+ * The syntax follows nginx: a directive is a name and its arguments ended by `;`,
+ * or by a `{ ... }` block for `server` and `location`. `#` starts a comment. An
+ * argument containing spaces or special characters is quoted with `"` or `'`;
+ * quotes have no escape sequences.
+ *
+ * @code
+ * worker_processes auto;
+ * server {
+ *     listen 127.0.0.1:8080 default_server;
+ *     server_name example.com www.example.com;
+ *     location / {
+ *         root ./www;
+ *         index index.html;
+ *         methods GET POST;
+ *     }
+ * }
+ * @endcode
+ *
+ * @ingroup config
+ */
+
+#pragma once
+
+#include "config/Config.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Builds a Config from configuration text.
+ *
+ * @details Directives by context:
+ * - main: `worker_processes`, `worker_threads` (a count or `auto`),
+ *   `worker_cpu_affinity off|auto|cpu...` (numbers or ranges such as `4-7`),
+ *   `worker_numa_local on|off` (needs an affinity),
+ *   `event_backend` (`auto`, `epoll`, `kqueue`, `poll`, `io_uring`),
+ *   `asset_cache_size`, `max_connections`, `compress_cpu_budget` (percent of each
+ *   event loop's time), `slow_request_threshold off|time` (`ms` allowed), `server`.
+ * - server: `listen [host:]port [default_server] [ssl] [backlog=N] [busy_poll=usec]`,
+ *   `server_name`, `error_page code... uri`, `client_max_body_size`, `keepalive_timeout`,
+ *   `keepalive_requests`, `client_header_timeout`, `client_body_timeout`,
+ *   `send_timeout`, `ssl_certificate`, `ssl_certificate_key` (both required with
+ *   `ssl`), `ssl_session_cache` (sessions, 0 turns it off), `ssl_session_timeout`,
+ *   `ssl_session_tickets on|off`, `location`.
+ * - location: `methods`, `root`, `index`, `autoindex on|off`, `autoindex_page_size`
+ *   (entries per listing page, 0 for one page), `return [code] url`,
+ *   `upload_store`, `cgi_extension`, `cgi_interpreter`, `cgi_max_processes`,
+ *   `cgi_timeout`, `fastcgi_pass`, `proxy_pass [http://]address...`,
+ *   `proxy_balance round_robin|least_conn`, `proxy_timeout`, `stats on|off`,
+ *   `compress off|gzip|br...`, `compress_static on|off`, `compress_min_length`.
+ *
+ * Sizes take an optional `k`, `m` or `g` suffix, times an optional `s`, `m` or `h`
+ * suffix (seconds by default). Every value is validated while parsing, so a file
+ * that parses can be served; nothing is bound or opened.
+ *
+ * @ingroup config
+ */
+class ConfigParser {
+  public:
+    /**
+     * @brief Error in a configuration file, located by line and column.
+     */
+    class ParseError : public std::runtime_error {
+      public:
+        ParseError(const std::string& message, std::size_t line, std::size_t column);
+
+        std::size_t getLine() const noexcept;   ///< 1-based line, 0 if not in the text.
+        std::size_t getColumn() const noexcept; ///< 1-based column, 0 if not in the text.
+
+      private:
+        std::size_t _line;
+        std::size_t _column;
+    };
+
+    /**
+     * @brief Parses the configuration file at @p path.
+     *
+     * @throws ConfigParser::ParseError If the file cannot be read or is invalid; the
+     *         message starts with `path:line:column:`.
+     */
+    static Config parseFile(const std::string& path);
+
+    /**
+     * @brief Parses configuration text held in memory.
+     *
+     * @param text Configuration text; only read during the call.
+     * @param name Name used in error messages.
+     * @throws ConfigParser::ParseError If the text is invalid.
+     */
+    static Config parse(std::string_view text, const std::string& name = "<config>");
+
+  private:
+    /// Kinds of tokens; a WORD may have been quoted.
+    enum class TokenType { WORD, BLOCK_START, BLOCK_END, END_DIRECTIVE, END_OF_FILE };
+
+    struct Token {
+        TokenType        type;
+        std::string_view text; ///< Slice of the input; without quotes for a quoted word.
+    };
+
+    struct DirectiveInfo; ///< Entry of the directive table, defined with it.
+
+    std::string_view              _text; ///< Whole input.
+    const std::string&            _name; ///< File name for error messages.
+    std::size_t                   _pos;  ///< Next unread byte.
+    std::vector<std::string_view> _args; ///< Arguments of the directive being read.
+
+    ConfigParser(std::string_view text, const std::string& name);
+
+    static const DirectiveInfo* findDirective(std::string_view name);
+
+    Token next();
+
+    /**
+     * @brief Reads the next directive of a context and its arguments into _args.
+     *
+     * @param context Bit of the context being parsed.
+     * @return The directive, or NULL at the `}` closing the block (or at the end
+     *         of the file in the main context).
+     */
+    const DirectiveInfo* nextDirective(unsigned context);
+
+    void parseMain(Config& config);
+    void parseCpuAffinity(Config& config);
+    void parseServer(Server& server);
+    void parseLocation(Location& location);
+    void parseListen(Server& server);
+    void parseProxyPass(Location& location);
+
+    std::size_t      number(std::string_view word, std::size_t max) const;
+    std::size_t      size(std::string_view word) const;
+    std::size_t      seconds(std::string_view word) const;
+    std::size_t      milliseconds(std::string_view word) const;
+    bool             flag(std::string_view word) const;
+    std::string_view value(std::string_view word) const;
+
+    [[noreturn]] void fail(std::string_view at, const std::string& message) const;
+};
@@ -0,0 +1,146 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ConfigSnapshot.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:01:59 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:18:53 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    ConfigSnapshot.hpp
+ * @brief   Declares the ConfigSnapshot class.
+ *
+ * @details A ConfigSnapshot is the immutable, runtime view of a parsed Config. It is
+ * built once at startup and shared between the event loop and every connection via
+ * `std::shared_ptr<const ConfigSnapshot>`. Connections refer to their Server block by
+ * pointer into the snapshot instead of holding their own copy. The snapshot also
+ * owns the VirtualHostIndex used to resolve the `Host:` header of each request,
+ * and the TlsContext of each `ssl` server, so certificates are loaded once.
+ *
+ * @ingroup config
+ */
+
+#pragma once
+
+#include "config/Config.hpp"
+#include "core/Server.hpp"
+#include "core/VirtualHostIndex.hpp"
+#include "network/TlsContext.hpp"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Immutable, shareable set of Server blocks used at runtime.
+ *
+ * @details Addresses of the contained Server objects are stable for the lifetime of
+ * the snapshot, so `const Server*` handles can be stored per listener and per client.
+ *
+ * @ingroup config
+ */
+class ConfigSnapshot {
+  public:
+    /**
+     * @brief Builds a snapshot by copying the given servers once.
+     *
+     * @param servers          Server blocks, usually from Config::getServers().
+     * @param asset_cache_size Memory cap of each event loop's small-response cache.
+     * @param max_connections  Clients served at once by each event loop, 0 = no limit.
+     * @param compress_budget  Percent of each event loop's time spent compressing.
+     * @param slow_request_ms  Requests logged as slow above it, in ms; 0 = off.
+     *
+     * @throws TlsContext::TlsError If the certificate of an `ssl` server cannot be used.
+     */
+    explicit ConfigSnapshot(const std::vector<Server>& servers,
+                            std::size_t asset_cache_size = Config::DEFAULT_ASSET_CACHE_SIZE,
+                            std::size_t max_connections  = Config::DEFAULT_MAX_CONNECTIONS,
+                            unsigned    compress_budget  = Config::DEFAULT_COMPRESS_BUDGET,
+                            std::size_t slow_request_ms  = 0);
+
+    /**
+     * @brief Builds a snapshot by taking ownership of the given servers.
+     *
+     * @param servers          Server blocks to move into the snapshot.
+     * @param asset_cache_size Memory cap of each event loop's small-response cache.
+     * @param max_connections  Clients served at once by each event loop, 0 = no limit.
+     * @param compress_budget  Percent of each event loop's time spent compressing.
+     * @param slow_request_ms  Requests logged as slow above it, in ms; 0 = off.
+     *
+     * @throws TlsContext::TlsError If the certificate of an `ssl` server cannot be used.
+     */
+    explicit ConfigSnapshot(std::vector<Server>&& servers,
+                            std::size_t asset_cache_size = Config::DEFAULT_ASSET_CACHE_SIZE,
+                            std::size_t max_connections  = Config::DEFAULT_MAX_CONNECTIONS,
+                            unsigned    compress_budget  = Config::DEFAULT_COMPRESS_BUDGET,
+                            std::size_t slow_request_ms  = 0);
+
+    ~ConfigSnapshot()                                = default;
+    ConfigSnapshot(const ConfigSnapshot&)            = delete;
+    ConfigSnapshot& operator=(const ConfigSnapshot&) = delete;
+
+    /**
+     * @brief Creates a shared snapshot of a parsed configuration.
+     *
+     * @param config Parsed configuration.
+     * @return Shared read-only snapshot.
+     */
+    static std::shared_ptr<const ConfigSnapshot> create(const Config& config);
+
+    /**
+     * @brief Creates a shared snapshot that takes over the servers of @p config.
+     *
+     * @param config Parsed configuration; left without servers, other settings kept.
+     * @return Shared read-only snapshot.
+     */
+    static std::shared_ptr<const ConfigSnapshot> create(Config&& config);
+
+    /**
+     * @brief Returns every Server block of the snapshot.
+     */
+    const std::vector<Server>& getServers() const noexcept;
+
+    /**
+     * @brief Returns the virtual host index built over getServers().
+     */
+    const VirtualHostIndex& getHosts() const noexcept;
+
+    /**
+     * @brief Returns the byte budget of each event loop's AssetCache.
+     */
+    std::size_t getAssetCacheSize() const noexcept;
+
+    /**
+     * @brief Returns the client limit of each event loop, 0 if none.
+     */
+    std::size_t getMaxConnections() const noexcept;
+
+    /**
+     * @brief Returns the compression CPU budget of each event loop, in percent.
+     */
+    unsigned getCompressCpuBudget() const noexcept;
+
+    /**
+     * @brief Returns the slow request threshold, zero if requests are not traced.
+     */
+    std::chrono::milliseconds getSlowRequestThreshold() const noexcept;
+
+    /**
+     * @brief Returns the TLS context of a server of this snapshot, or NULL if it is plain.
+     */
+    const TlsContext* getTls(const Server& server) const noexcept;
+
+  private:
+    const std::vector<Server> _servers;          ///< Server blocks, immutable after construction.
+    const VirtualHostIndex    _hosts;            ///< Host header lookup into _servers.
+    const std::size_t         _asset_cache_size; ///< See Config::getAssetCacheSize().
+    const std::size_t         _max_connections;  ///< See Config::getMaxConnections().
+    const unsigned            _compress_budget;  ///< See Config::getCompressCpuBudget().
+    const std::size_t         _slow_request_ms;  ///< See Config::getSlowRequestThreshold().
+    std::vector<std::unique_ptr<const TlsContext>> _tls; ///< Per server, NULL if plain.
+
+    void loadTls();
+};
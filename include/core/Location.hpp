@@ -16,14 +16,29 @@
  *
  * @details Each Location object holds the configuration for a specific URL path
  * within a virtual server, including allowed methods, root, autoindex setting,
- * and CGI behavior.
+ * CGI behavior and the upstream servers it proxies to. Strings are interned and
+ * methods kept as a bitmask, so a location is about 100 bytes and copying one
+ * allocates nothing.
  * @ingroup core
  */
 
 #pragma once
 
-#include <set>
+#include "http/HttpMethod.hpp"
+#include "utils/InternedString.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+
+/**
+ * @brief How a `proxy_pass` location spreads requests over its upstream servers.
+ */
+enum class ProxyBalance : std::uint8_t {
+    ROUND_ROBIN, ///< Each server in turn.
+    LEAST_CONN   ///< The server with the fewest requests in flight on this event loop.
+};
 
 /**
  * @defgroup config Server Configuration
@@ -41,48 +56,94 @@
  */
 class Location {
   public:
+    static constexpr std::size_t DEFAULT_CGI_MAX_PROCESSES   = 16;  ///< Per location and loop.
+    static constexpr std::size_t DEFAULT_CGI_TIMEOUT         = 30;  ///< Seconds per CGI run.
+    static constexpr std::size_t DEFAULT_COMPRESS_MIN_LENGTH = 256; ///< Bytes; less gains nothing.
+    static constexpr std::size_t DEFAULT_PROXY_TIMEOUT       = 60;  ///< Seconds per request.
+    static constexpr std::size_t MAX_AUTOINDEX_PAGE_SIZE     = 65535; ///< Entries per page.
+
     Location();
     ~Location()                                = default;
     Location(const Location& other)            = default;
     Location& operator=(const Location& other) = default;
+    Location(Location&& other) noexcept            = default;
+    Location& operator=(Location&& other) noexcept = default;
 
     // --- Setters ---
 
-    void setPath(const std::string& path);
-    void addMethod(const std::string& method);
-    void setRoot(const std::string& root);
-    void setIndex(const std::string& index);
+    // Strings are interned, so a view is all they need: equal values share storage
+
+    void setPath(std::string_view path);
+    void addMethod(std::string_view method); ///< Unknown methods are ignored.
+    void addMethod(HttpMethod method) noexcept;
+    void setRoot(std::string_view root);
+    void setIndex(std::string_view index);
     void setAutoindex(bool enabled);
-    void setRedirect(const std::string& target, int code = 301);
-    void setUploadStore(const std::string& path);
-    void setCgiExtension(const std::string& ext);
+    void setAutoindexPageSize(std::size_t entries) noexcept; ///< 0: a single page.
+    void setRedirect(std::string_view target, int code = 301);
+    void setUploadStore(std::string_view path);
+    void setCgiExtension(std::string_view ext);
+    void setCgiInterpreter(std::string_view program);
+    void setCgiMaxProcesses(std::size_t count);
+    void setCgiTimeout(std::size_t seconds);
+    void setFastcgiPass(std::string_view address);
+    void setProxyPass(std::string_view upstreams); ///< Addresses separated by spaces.
+    void setProxyBalance(ProxyBalance balance) noexcept;
+    void setProxyTimeout(std::size_t seconds) noexcept;
+    void setStats(bool enabled);
+    void setCompression(unsigned codings) noexcept; ///< codingBit() mask; 0 turns it off.
+    void setCompressStatic(bool enabled) noexcept;
+    void setCompressMinLength(std::size_t bytes) noexcept;
 
     // --- Getters ---
 
     const std::string&           getPath() const;
-    const std::set<std::string>& getMethods() const;
+    std::uint16_t                getMethodMask() const noexcept; ///< 0: no method list.
     const std::string&           getRoot() const;
     const std::string&           getIndex() const;
     bool                         isAutoindexEnabled() const;
+    std::size_t                  getAutoindexPageSize() const noexcept; ///< 0: a single page.
     bool                         hasRedirect() const;
     const std::string&           getRedirect() const;
     int                          getReturnCode() const;
     const std::string&           getUploadStore() const;
     const std::string&           getCgiExtension() const;
+    const std::string&           getCgiInterpreter() const; ///< Empty: scripts run themselves.
+    std::size_t                  getCgiMaxProcesses() const noexcept; ///< 0 means no limit.
+    std::size_t                  getCgiTimeout() const noexcept;      ///< 0 means no limit.
+    const std::string&           getFastcgiPass() const; ///< Empty: scripts are forked.
+    const std::string&           getProxyPass() const;   ///< Upstream addresses, or empty.
+    ProxyBalance                 getProxyBalance() const noexcept;
+    std::size_t                  getProxyTimeout() const noexcept; ///< 0 means no limit.
+    bool isStatsEnabled() const noexcept; ///< GET answers with the server's metrics.
+    unsigned    getCompression() const noexcept;       ///< codingBit() mask of on-the-fly codings.
+    bool        isCompressStatic() const noexcept;     ///< Serves `.gz`/`.br` siblings of files.
+    std::size_t getCompressMinLength() const noexcept; ///< Shortest body compressed on the fly.
 
     // --- Logic helpers ---
 
     /**
      * @brief Verifies if the given HTTP method is allowed for this location.
      *
-     * @details Checks whether the method exists in the set of allowed methods
-     * configured for this location (e.g., "GET", "POST", "DELETE").
+     * @details Parses the name and tests it against the method mask. Methods the
+     * server does not know are never allowed.
      *
      * @param method The HTTP method string to check.
      * @return True if the method is allowed, false otherwise.
      */
     bool isMethodAllowed(const std::string& method) const;
 
+    /**
+     * @brief Verifies if a parsed HTTP method is allowed for this location.
+     *
+     * @details Tests the method's bit against the mask built by addMethod(), so the
+     * check is a single AND on the request path.
+     *
+     * @param method The method recognized by the request parser.
+     * @return True if the method is allowed, false otherwise.
+     */
+    bool isMethodAllowed(HttpMethod method) const noexcept;
+
     /**
      * @brief Checks if this location matches a given request URI.
      *
@@ -105,6 +166,18 @@ class Location {
      */
     std::string resolveAbsolutePath(const std::string& uri) const;
 
+    /**
+     * @brief Appends the filesystem path of a URI to @p out, without temporaries.
+     *
+     * @details Same rules as the overload above. Lets request handling build the
+     * path in its per-request arena.
+     *
+     * @param uri The full request URI.
+     * @param out Receives the path; left unchanged if the URI does not match.
+     * @return False if the URI does not match this location.
+     */
+    bool resolveAbsolutePath(std::string_view uri, std::pmr::string& out) const;
+
     /**
      * @brief Indicates whether file uploads are allowed for this location.
      *
@@ -116,9 +189,20 @@ class Location {
      * @brief Determines if the URI targets a CGI script.
      *
      * @param uri The requested URI.
-     * @return True if the URI ends with the configured CGI extension.
+     * @return True if a segment of the URI ends with the configured CGI extension.
+     */
+    bool isCgiRequest(std::string_view uri) const noexcept;
+
+    /**
+     * @brief Returns the length of the script's part of a URI.
+     *
+     * @details The script is the first segment ending with the CGI extension; the
+     * rest of the URI, from the '/' after it, is the script's `PATH_INFO`.
+     *
+     * @param uri The requested URI.
+     * @return Length of the script's path, or 0 if the URI names no script.
      */
-    bool isCgiRequest(const std::string& uri) const;
+    std::size_t cgiScriptLength(std::string_view uri) const noexcept;
 
     /**
      * @brief Returns the full path to the index file, if one is set.
@@ -128,15 +212,27 @@ class Location {
     std::string getEffectiveIndexPath() const;
 
   private:
-    std::string           _path;          ///< The URL path this location matches.
-    std::set<std::string> _methods;       ///< Set of allowed HTTP methods.
-    std::string           _root;          ///< Root directory for file serving.
-    std::string           _index;         ///< Default index file name.
-    bool                  _autoindex;     ///< Whether to enable directory listing.
-    std::string           _redirect;      ///< Redirection target URL.
-    int                   _return_code;   ///< HTTP status code for redirection.
-    std::string           _upload_store;  ///< Directory for uploaded files.
-    std::string           _cgi_extension; ///< CGI file extension (e.g., ".php").
+    InternedString _path;                ///< The URL path this location matches.
+    InternedString _root;                ///< Root directory for file serving.
+    InternedString _index;               ///< Default index file name.
+    InternedString _redirect;            ///< Redirection target URL.
+    InternedString _upload_store;        ///< Directory for uploaded files.
+    InternedString _cgi_extension;       ///< CGI file extension (e.g., ".php").
+    InternedString _cgi_interpreter;     ///< Program running the scripts, or empty.
+    InternedString _fastcgi_pass;        ///< FastCGI backend for the scripts, or empty.
+    InternedString _proxy_pass;          ///< Upstream servers, space-separated, or empty.
+    std::size_t    _compress_min_length; ///< Shortest body compressed on the fly.
+    std::uint32_t  _cgi_max_processes;   ///< Concurrent scripts per event loop.
+    std::uint32_t  _cgi_timeout;         ///< Seconds a script may run.
+    std::uint32_t  _proxy_timeout;       ///< Seconds an upstream may take to answer.
+    std::uint16_t  _return_code;         ///< HTTP status code for redirection.
+    std::uint16_t  _method_mask;         ///< httpMethodBit() of every allowed method.
+    std::uint16_t  _autoindex_page_size; ///< Listing entries per page, 0 for all.
+    bool           _autoindex;           ///< Whether to enable directory listing.
+    bool           _stats;               ///< Serves the metrics in Prometheus format.
+    std::uint8_t   _compression;         ///< codingBit() of the codings produced on the fly.
+    bool           _compress_static;     ///< Looks for precompressed siblings first.
+    ProxyBalance   _proxy_balance;       ///< Choice among the upstream servers.
 };
 
 /** @} */
@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RouteTable.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:13:32 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:13:32 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    RouteTable.hpp
+ * @brief   Declares the RouteTable longest-prefix index over Location paths.
+ *
+ * @details A server's locations are inserted into a compressed radix trie when the
+ * configuration is loaded. Resolving a request path is then a single walk from the
+ * root that remembers the deepest node carrying a location, instead of comparing
+ * the path against every location block.
+ *
+ * @ingroup core
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Radix trie mapping location path prefixes to location indices.
+ *
+ * @details Matching follows Location::matchesPath(): a location applies when its
+ * path is a byte prefix of the request path, and the longest such path wins. When
+ * two locations share a path, the one inserted first is kept. Nodes live in one
+ * vector and refer to each other by index, so copying a table is always safe.
+ *
+ * @ingroup core
+ */
+class RouteTable {
+  public:
+    static constexpr std::int32_t NO_ROUTE = -1; ///< Result of a lookup with no match.
+
+    RouteTable();
+    ~RouteTable()                            = default;
+    RouteTable(const RouteTable&)            = default;
+    RouteTable& operator=(const RouteTable&) = default;
+
+    /**
+     * @brief Registers a location path.
+     *
+     * @param path  Location path as written in the configuration (e.g. "/api").
+     * @param index Index of the location in its server's location list.
+     */
+    void insert(std::string_view path, std::size_t index);
+
+    /**
+     * @brief Finds the location with the longest path that prefixes @p path.
+     *
+     * @param path Request path, without the query string.
+     * @return Index passed to insert(), or NO_ROUTE.
+     */
+    std::int32_t find(std::string_view path) const noexcept;
+
+    /**
+     * @brief Removes every route.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of trie nodes, including the root.
+     */
+    std::size_t nodeCount() const noexcept;
+
+  private:
+    struct Node {
+        std::string                label;    ///< Bytes consumed on the edge into this node.
+        std::int32_t               location; ///< Location ending here, or NO_ROUTE.
+        std::vector<std::uint32_t> children; ///< Child nodes, each with a distinct first byte.
+    };
+
+    std::vector<Node> _nodes; ///< Node 0 is the root, with an empty label.
+
+    std::int32_t findChild(std::size_t node, char first) const noexcept;
+    std::uint32_t addNode(std::string_view label, std::int32_t location);
+};
@@ -17,7 +17,8 @@
  * @details This file defines the Server class, which models a single server block
  * as defined in the configuration file. It encapsulates configuration directives such as
  * listening port, host address, server name aliases, error pages, body size limits,
- * and associated Location blocks for routing.
+ * and associated Location blocks for routing. A server listening with `ssl` also
+ * names its certificate and how TLS sessions are resumed.
  *
  * The class provides setters used during configuration parsing, and getters used
  * at runtime for request routing, virtual host selection, and error handling.
@@ -28,8 +29,10 @@
 #pragma once
 
 #include "core/Location.hpp"
+#include "core/RouteTable.hpp"
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -47,8 +50,26 @@ class Server {
     std::map<int, std::string> _error_pages;          ///< HTTP error code to file path.
     size_t                     _client_max_body_size; ///< Max request body size in bytes.
     std::vector<Location>      _locations;            ///< Location blocks (routes).
+    RouteTable                 _routes;               ///< Prefix index over _locations.
+    size_t                     _keepalive_timeout;    ///< Idle seconds before closing, 0 = off.
+    size_t                     _keepalive_requests;   ///< Requests served per connection.
+    size_t                     _header_timeout;       ///< Seconds to receive a head, 0 = off.
+    size_t                     _body_timeout;         ///< Seconds between body reads, 0 = off.
+    size_t                     _send_timeout;         ///< Seconds between writes, 0 = off.
+    int                        _listen_backlog;       ///< Pending connections the kernel queues.
+    int                        _busy_poll;            ///< SO_BUSY_POLL microseconds, 0 = unset.
+    bool                       _default_server;       ///< Answers unknown names on its port.
+    bool                       _ssl;                  ///< Listener terminates TLS.
+    bool                       _ssl_session_tickets;  ///< Resumes sessions from tickets.
+    std::string                _ssl_certificate;      ///< PEM certificate chain file.
+    std::string                _ssl_certificate_key;  ///< PEM private key file.
+    size_t                     _ssl_session_cache;    ///< Sessions cached per process, 0 = off.
+    size_t                     _ssl_session_timeout;  ///< Seconds a session can be resumed.
 
   public:
+    static constexpr size_t DEFAULT_SSL_SESSION_CACHE   = 20480; ///< Sessions, as OpenSSL's.
+    static constexpr size_t DEFAULT_SSL_SESSION_TIMEOUT = 300;   ///< Seconds.
+
     // --- Constructor / Destructor ---
 
     Server();
@@ -56,15 +77,36 @@ class Server {
 
     Server(const Server& other)            = default;
     Server& operator=(const Server& other) = default;
+    Server(Server&& other) noexcept            = default;
+    Server& operator=(Server&& other) noexcept = default;
 
     // --- Setters ---
 
     void setPort(int port);
     void setHost(const std::string& host);
+    void setHost(std::string&& host);
     void addServerName(const std::string& name);
+    void addServerName(std::string&& name);
     void setErrorPage(int code, const std::string& path);
+    void setErrorPage(int code, std::string&& path);
     void setClientMaxBodySize(size_t size);
     void addLocation(const Location& location);
+    void addLocation(Location&& location);
+    Location& emplaceLocation(std::string_view path); ///< Valid until the next location is added.
+    void setKeepAliveTimeout(size_t seconds);
+    void setKeepAliveRequests(size_t count);
+    void setClientHeaderTimeout(size_t seconds);
+    void setClientBodyTimeout(size_t seconds);
+    void setSendTimeout(size_t seconds);
+    void setListenBacklog(int backlog);
+    void setBusyPoll(int microseconds);
+    void setDefaultServer(bool is_default);
+    void setSsl(bool enabled);
+    void setSslCertificate(const std::string& path);
+    void setSslCertificateKey(const std::string& path);
+    void setSslSessionCache(size_t sessions);
+    void setSslSessionTimeout(size_t seconds);
+    void setSslSessionTickets(bool enabled);
 
     // --- Getters ---
 
@@ -74,6 +116,20 @@ class Server {
     const std::map<int, std::string>& getErrorPages() const noexcept;
     size_t                            getClientMaxBodySize() const noexcept;
     const std::vector<Location>&      getLocations() const noexcept;
+    size_t                            getKeepAliveTimeout() const noexcept;
+    size_t                            getKeepAliveRequests() const noexcept;
+    size_t                            getClientHeaderTimeout() const noexcept;
+    size_t                            getClientBodyTimeout() const noexcept;
+    size_t                            getSendTimeout() const noexcept;
+    int                               getListenBacklog() const noexcept;
+    int                               getBusyPoll() const noexcept; ///< 0: the kernel default.
+    bool                              isDefaultServer() const noexcept;
+    bool                              isSsl() const noexcept;
+    const std::string&                getSslCertificate() const noexcept;
+    const std::string&                getSslCertificateKey() const noexcept;
+    size_t                            getSslSessionCache() const noexcept;
+    size_t                            getSslSessionTimeout() const noexcept;
+    bool                              isSslSessionTickets() const noexcept;
 
     /**
      * @brief Checks whether the given name matches one of this server's configured names.
@@ -86,4 +142,17 @@ class Server {
      * @return True if it matches any entry in _server_names.
      */
     bool hasServerName(const std::string& name) const;
+
+    /**
+     * @brief Selects the location block that serves a request path.
+     *
+     * @details Returns the location whose path is the longest prefix of @p path, as
+     * Location::matchesPath() defines it. Locations are indexed in a RouteTable as
+     * they are added, so the lookup costs one walk over @p path regardless of how
+     * many location blocks the server has.
+     *
+     * @param path Request path, without the query string.
+     * @return Matching location, or NULL if none applies.
+     */
+    const Location* findLocation(std::string_view path) const noexcept;
 };
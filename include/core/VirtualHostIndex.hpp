@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   VirtualHostIndex.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:15:39 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:15:39 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    VirtualHostIndex.hpp
+ * @brief   Declares the VirtualHostIndex used for name-based virtual hosting.
+ *
+ * @details The index is built once from the configured Server blocks. Resolving the
+ * `Host:` header of a request is then a hash probe per candidate name instead of a
+ * scan over every server and every server_name, and it never throws.
+ *
+ * @ingroup config
+ */
+
+#pragma once
+
+#include "core/Server.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Maps (port, Host header) pairs to the Server block that should answer.
+ *
+ * @details Supported server_name forms, checked in this order:
+ * - exact names such as `example.com`, compared ignoring ASCII case;
+ * - leading wildcards such as `*.example.com`, where the longest suffix wins;
+ * - `.example.com`, which is short for both `example.com` and `*.example.com`.
+ *
+ * When nothing matches, the port's default server answers. That is the first
+ * server flagged with Server::setDefaultServer(), or else the first server
+ * configured on the port. If a name repeats on one port, the first server keeps it.
+ *
+ * The index stores pointers into the vector it was built from. That vector must
+ * outlive the index and must not be resized.
+ *
+ * @ingroup config
+ */
+class VirtualHostIndex {
+  public:
+    VirtualHostIndex();
+
+    /**
+     * @brief Indexes every server_name of every server.
+     *
+     * @param servers Server blocks, typically owned by a ConfigSnapshot.
+     */
+    explicit VirtualHostIndex(const std::vector<Server>& servers);
+
+    ~VirtualHostIndex()                                  = default;
+    VirtualHostIndex(const VirtualHostIndex&)            = default;
+    VirtualHostIndex& operator=(const VirtualHostIndex&) = default;
+
+    /**
+     * @brief Selects the server for a request.
+     *
+     * @param port Port the connection was accepted on.
+     * @param host Host header without the port (e.g. "www.Example.com"); may be empty.
+     * @return Matching server, the port's default server, or NULL if no server
+     *         listens on @p port.
+     */
+    const Server* find(int port, std::string_view host) const noexcept;
+
+    /**
+     * @brief Returns the default server of a port, or NULL if none listens on it.
+     */
+    const Server* getDefault(int port) const noexcept;
+
+    /**
+     * @brief Returns the number of indexed names, wildcard suffixes included.
+     */
+    std::size_t size() const noexcept;
+
+  private:
+    struct Entry {
+        std::string   name;     ///< Lowercased name, or ".suffix" for a wildcard.
+        std::uint64_t hash;     ///< Hash of (port, wildcard, name).
+        int           port;     ///< Listening port of the server.
+        bool          wildcard; ///< True if @ref name is a wildcard suffix.
+        const Server* server;   ///< Server answering this name, NULL for an empty slot.
+    };
+
+    std::vector<Entry>                     _table;    ///< Open addressing, power-of-two size.
+    std::size_t                            _count;    ///< Occupied slots of _table.
+    std::unordered_map<int, const Server*> _defaults; ///< Default server per port.
+
+    static std::uint64_t hashKey(int port, bool wildcard, std::string_view name) noexcept;
+
+    void          insert(int port, bool wildcard, std::string_view name, const Server* server);
+    void          grow();
+    const Server* lookup(int port, bool wildcard, std::string_view name) const noexcept;
+};
@@ -0,0 +1,141 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Webserv.hpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/04/26 16:00:00 by nlouis            #+#    #+#             */
+/*   Updated: 2025/05/17 18:22:10 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Webserv.hpp
+ * @brief   Declares the Webserv class, which runs the configured worker model.
+ *
+ * @details Webserv turns a Config into running event loops. With the default
+ * settings it runs one SocketManager in the calling thread. With
+ * `worker_processes` or `worker_threads` above one, every worker gets its own
+ * SocketManager: its own poller, client table and `SO_REUSEPORT` listeners. Workers
+ * share nothing but the immutable ConfigSnapshot, and the kernel balances new
+ * connections between their listening sockets.
+ *
+ * `SIGHUP` reloads the configuration without dropping connections: it is rebuilt
+ * on the signal thread and handed to every loop, see SocketManager::reload().
+ *
+ * Each loop is built on its own thread, after `worker_cpu_affinity` pinned it and
+ * `worker_numa_local` set its memory policy, so the pages of its client table,
+ * buffer pool and caches are first touched on the node that will use them.
+ *
+ * @ingroup core
+ */
+
+#pragma once
+
+#include "config/Config.hpp"
+#include "config/ConfigSnapshot.hpp"
+#include "utils/Stats.hpp"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <sys/types.h>
+#include <vector>
+
+/**
+ * @brief Owns the process and thread layout of the server.
+ *
+ * @details
+ * - `worker_processes == 1`: the calling process is the only worker.
+ * - `worker_processes > 1`: the calling process becomes a master that forks the
+ *   workers, restarts any that crash, and on `SIGINT` / `SIGTERM` stops them all
+ *   before returning.
+ *
+ * Each worker process runs `worker_threads` event loops, each on its own thread.
+ * Its main thread waits for `SIGINT` / `SIGTERM` and then stops the loops. A
+ * count of 0 means one per online CPU.
+ *
+ * On `SIGHUP` the master reloads first, so restarted workers start with the new
+ * configuration, then forwards the signal to each worker, which reloads its own
+ * loops. A configuration that fails to load is logged and the current one stays.
+ * Worker counts, the event backend and CPU placement only change on restart.
+ *
+ * @ingroup core
+ */
+class Webserv {
+  public:
+    /// Produces a fresh configuration on `SIGHUP`; throws if it is invalid.
+    using ConfigLoader = std::function<Config()>;
+
+    /**
+     * @brief Prepares the worker model of a parsed configuration.
+     *
+     * @param config Parsed configuration; its servers are moved into the snapshot.
+     * @param loader Source of the configuration on reload, or empty to ignore `SIGHUP`.
+     */
+    explicit Webserv(Config config, ConfigLoader loader = ConfigLoader());
+    ~Webserv()                         = default;
+    Webserv(const Webserv&)            = delete;
+    Webserv& operator=(const Webserv&) = delete;
+
+    /**
+     * @brief Runs workers until the server is asked to stop.
+     *
+     * @return Process exit status: 0 after a clean shutdown, 1 if the workers
+     *         could not start.
+     */
+    int run();
+
+    /**
+     * @brief Returns the number of worker processes that run() starts.
+     */
+    std::size_t getWorkerProcesses() const noexcept;
+
+    /**
+     * @brief Returns the number of event loop threads per worker process.
+     */
+    std::size_t getWorkerThreads() const noexcept;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Supervision record of one worker process.
+     */
+    struct Worker {
+        pid_t             pid;     ///< Process id, or -1 once the slot is retired.
+        Clock::time_point started; ///< Spawn time, used to detect startup failures.
+    };
+
+    std::shared_ptr<const ConfigSnapshot> _config;    ///< Shared by every worker.
+    ConfigLoader                          _loader;    ///< Rebuilds the config on SIGHUP.
+    std::size_t                           _processes; ///< Resolved worker process count.
+    std::size_t                           _threads;   ///< Resolved threads per process.
+    PollBackend                           _backend;   ///< Event backend of every loop.
+    std::vector<unsigned>                 _cpus;      ///< CPU of each loop in turn, or none.
+    bool                                  _numa_local; ///< Pinned loops prefer their node.
+    std::shared_ptr<StatsRegistry>        _stats;     ///< One block per loop of every worker.
+    std::vector<Worker>                   _workers;   ///< Master only: one entry per slot.
+
+    static std::size_t           resolveCount(std::size_t configured) noexcept;
+    static std::vector<unsigned> resolveCpus(const Config& config);
+
+    /**
+     * @brief Pins the calling thread for event loop @p loop, numbered across workers.
+     *
+     * @details Failures are logged and leave the loop where the scheduler puts it.
+     */
+    void placeLoop(std::size_t loop) const;
+
+    /**
+     * @brief Loads and compiles the configuration again, on the calling thread.
+     *
+     * @return The new snapshot, or NULL if there is no loader or it failed.
+     */
+    std::shared_ptr<const ConfigSnapshot> loadSnapshot() const;
+
+    int   runMaster();
+    int   runWorker(std::size_t slot);
+    pid_t spawnWorker(std::size_t slot);
+    bool  reapWorkers(bool stopping);
+};
@@ -35,6 +35,9 @@
  * @param port The port on which the connection was accepted.
  * @param host_name The Host header value from the request (e.g. "localhost").
  * @return Reference to the selected Server.
+ *
+ * @note This is a linear scan meant for one-off lookups over a plain server list.
+ * The request path uses the VirtualHostIndex owned by the ConfigSnapshot instead.
  */
 const Server& findMatchingServer(const std::vector<Server>& servers, int port,
                                  const std::string& host_name);
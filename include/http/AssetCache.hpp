@@ -0,0 +1,196 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AssetCache.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:31:21 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:12:25 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    AssetCache.hpp
+ * @brief   Declares the AssetCache of fully serialized small responses.
+ *
+ * @details Small, hot files (favicons, index pages, configured error pages) are
+ * cheaper to keep in memory than to send with `sendfile()`. For those, AssetCache
+ * keeps the whole response: the status line and fixed header fields
+ * (`Content-Type`, `Content-Length`, `ETag`, `Last-Modified`) followed by the
+ * body, in a single buffer. A hit needs no formatting at all, and the connection
+ * sends the buffer with one gather write.
+ *
+ * A file may also have compressed variants, kept as separate entries with their
+ * own `Content-Encoding`, so the CPU cost of compressing is paid once per file.
+ *
+ * Each entry remembers the CachedFile it was read from. A FileCache lookup that
+ * returns a different CachedFile means the file was reopened after a change, so
+ * the entry is stale and is rebuilt.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include "http/Compression.hpp"
+#include "http/FileCache.hpp"
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class HttpResponse;
+
+/**
+ * @brief A serialized response: head without its final blank line, then the body.
+ *
+ * @details The head stops after the last cached header field, so the caller can
+ * append per-connection fields (`Connection`, `Keep-Alive`) and the blank line
+ * without copying the cached bytes.
+ *
+ * @ingroup http
+ */
+class CachedResponse {
+  public:
+    /**
+     * @brief Serializes @p response, which must have an in-memory body.
+     *
+     * @param response Response whose head and body are copied.
+     * @param source   File the body was read from, or NULL for a generated body.
+     */
+    CachedResponse(const HttpResponse& response, const std::shared_ptr<const CachedFile>& source);
+    ~CachedResponse()                                = default;
+    CachedResponse(const CachedResponse&)            = delete;
+    CachedResponse& operator=(const CachedResponse&) = delete;
+
+    int                getStatus() const noexcept;
+    const std::string& getData() const noexcept;       ///< Head fields, then body.
+    std::size_t        getHeadLength() const noexcept; ///< Bytes of getData() in the head.
+    std::string_view   getHead() const noexcept;
+    std::string_view   getBody() const noexcept;
+
+    /**
+     * @brief Returns true if the entry was built from @p file.
+     *
+     * @details Compares ownership, not addresses: the weak reference keeps the
+     * control block of the original file alive, so a new file opened at the same
+     * address can never be mistaken for it.
+     */
+    bool isBuiltFrom(const std::shared_ptr<const CachedFile>& file) const noexcept;
+
+  private:
+    int                             _status;      ///< HTTP status code.
+    std::string                     _data;        ///< Head fields followed by the body.
+    std::size_t                     _head_length; ///< Offset of the body in _data.
+    std::weak_ptr<const CachedFile> _source;      ///< File the body came from.
+};
+
+/**
+ * @brief LRU of serialized responses, bounded by the bytes it holds.
+ *
+ * @details Keyed by status, path and content coding, because the same file may
+ * be served as a page (200) and as an error page (404), and compressed or not.
+ * Generated bodies use an empty path.
+ * Like FileCache, an instance belongs to a single event loop.
+ *
+ * @ingroup http
+ */
+class AssetCache {
+  public:
+    static constexpr std::size_t DEFAULT_CAPACITY  = 8 << 20;  ///< Bytes held at most.
+    static constexpr std::size_t DEFAULT_MAX_ASSET = 64 << 10; ///< Largest body cached.
+
+    /**
+     * @brief Creates an empty cache.
+     *
+     * @param capacity  Memory cap in bytes for heads and bodies; 0 disables caching.
+     * @param max_asset Bodies larger than this are always sent from the file.
+     */
+    explicit AssetCache(std::size_t capacity  = DEFAULT_CAPACITY,
+                        std::size_t max_asset = DEFAULT_MAX_ASSET);
+    ~AssetCache()                            = default;
+    AssetCache(const AssetCache&)            = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    /**
+     * @brief Returns the cached response for @p status and @p path, if still current.
+     *
+     * @param status HTTP status the response is served with.
+     * @param path   Filesystem path of the body, or empty for a generated body.
+     * @param source File the path currently resolves to, or NULL for a generated body.
+     * @param coding Content coding of the cached body.
+     * @return The entry, or NULL on a miss. A stale entry is dropped.
+     */
+    std::shared_ptr<const CachedResponse> find(int status, std::string_view path,
+                                               const std::shared_ptr<const CachedFile>& source,
+                                               ContentCoding coding = ContentCoding::IDENTITY);
+
+    /**
+     * @brief Serializes and stores @p response, evicting old entries to make room.
+     *
+     * @param path     Key path, as passed to find().
+     * @param source   File the body was read from, or NULL.
+     * @param response Response with an in-memory body of at most getMaxAssetSize() bytes.
+     * @param coding   Content coding of the body, as passed to find().
+     * @return The new entry, or NULL if the response does not fit in the cache.
+     */
+    std::shared_ptr<const CachedResponse> insert(std::string_view                         path,
+                                                 const std::shared_ptr<const CachedFile>& source,
+                                                 const HttpResponse&                      response,
+                                                 ContentCoding coding = ContentCoding::IDENTITY);
+
+    /**
+     * @brief Returns true if a body of @p size bytes may be cached.
+     */
+    bool accepts(std::size_t size) const noexcept;
+
+    void        clear() noexcept;
+    std::size_t size() const noexcept;
+    std::size_t getMemoryUsage() const noexcept; ///< Bytes held by entries.
+    std::size_t getCapacity() const noexcept;
+    std::size_t getMaxAssetSize() const noexcept;
+    std::size_t getHits() const noexcept;
+    std::size_t getMisses() const noexcept;
+
+  private:
+    struct Entry {
+        std::string                           path;     ///< Owns the bytes _index keys view.
+        ContentCoding                         coding;   ///< Coding of the body.
+        std::shared_ptr<const CachedResponse> response; ///< Serialized response.
+    };
+
+    /// Views into Entry::path, so lookups never copy the caller's path.
+    struct Key {
+        int              status;
+        std::string_view path;
+        ContentCoding    coding;
+
+        bool operator==(const Key& other) const noexcept {
+            return status == other.status && coding == other.coding && path == other.path;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const noexcept {
+            return (std::hash<std::string_view>()(key.path) * 31 +
+                    static_cast<std::size_t>(key.status)) * 3 +
+                   static_cast<std::size_t>(key.coding);
+        }
+    };
+
+    using EntryList = std::list<Entry>;
+
+    std::size_t                                        _capacity;  ///< Memory cap in bytes.
+    std::size_t                                        _max_asset; ///< Largest cached body.
+    std::size_t                                        _memory;    ///< Bytes held now.
+    EntryList                                          _lru;       ///< Most recent first.
+    std::unordered_map<Key, EntryList::iterator, KeyHash> _index;  ///< Key -> list node.
+    std::size_t                                        _hits;      ///< See getHits().
+    std::size_t                                        _misses;    ///< See getMisses().
+
+    void erase(EntryList::iterator it) noexcept;
+};
@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ChunkedDecoder.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:24:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:24:13 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    ChunkedDecoder.hpp
+ * @brief   Declares the ChunkedDecoder class for chunked request bodies.
+ *
+ * @details Chunked transfer coding (RFC 9112, section 7.1) frames a body of unknown
+ * length as size-prefixed chunks, ended by a zero-size chunk and optional trailer
+ * fields. The decoder works in place: chunk data slides to the front of the bytes
+ * it is given, over the framing it replaces, so the decoded body needs no second
+ * buffer. The state survives between calls, so the framing may be split anywhere
+ * across reads.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Incremental, in-place decoder of the chunked transfer coding.
+ *
+ * @ingroup http
+ */
+class ChunkedDecoder {
+  public:
+    static constexpr std::size_t MAX_LINE     = 4096; ///< Longest chunk-size line.
+    static constexpr std::size_t MAX_TRAILERS = 8192; ///< Trailer section bytes, all ignored.
+
+    /**
+     * @brief Progress of decode().
+     */
+    enum class Result {
+        INCOMPLETE, ///< Every byte was used; the body continues.
+        DONE,       ///< The last chunk and the trailer section ended.
+        ERROR       ///< Malformed framing or an oversized line.
+    };
+
+    ChunkedDecoder() noexcept;
+
+    /**
+     * @brief Starts over for a new body.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Decodes received bytes in place.
+     *
+     * @param data     Received bytes; the chunk data found in them is moved to the front.
+     * @param size     In: bytes at @p data. Out: decoded bytes now at the front.
+     * @param consumed Out: received bytes used. Only DONE leaves bytes unused: those
+     *                 follow the body, e.g. a pipelined request.
+     */
+    Result decode(char* data, std::size_t& size, std::size_t& consumed) noexcept;
+
+  private:
+    /// Position in the framing.
+    enum class State {
+        SIZE,            ///< Hex digits of the chunk size.
+        EXTENSION,       ///< Chunk extensions, ignored, up to CR.
+        SIZE_LF,         ///< LF ending the chunk-size line.
+        DATA,            ///< Chunk data.
+        DATA_CR,         ///< CR after the chunk data.
+        DATA_LF,         ///< LF after the chunk data.
+        TRAILER,         ///< Start of a trailer line, or of the final CRLF.
+        TRAILER_LINE,    ///< Inside a trailer field.
+        TRAILER_LINE_LF, ///< LF ending a trailer field.
+        END_LF,          ///< LF ending the body.
+        DONE             ///< Body complete.
+    };
+
+    State       _state;     ///< Where the next byte belongs.
+    std::size_t _remaining; ///< Chunk size being read, then data bytes left in the chunk.
+    std::size_t _line;      ///< Bytes of the current size line or of the trailers.
+    bool        _digits;    ///< The size line has at least one digit.
+};
@@ -0,0 +1,65 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ChunkedEncoder.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:26:08 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:26:08 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    ChunkedEncoder.hpp
+ * @brief   Declares the ChunkedEncoder class for chunked response bodies.
+ *
+ * @details The encoder is the counterpart of ChunkedDecoder (RFC 9112, section 7.1).
+ * It never touches the body bytes: it only produces the framing that goes around
+ * them, so each piece of output can be queued as it is produced, next to its size
+ * line, and the response can start before its length is known.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @brief Incremental framer of a body in the chunked transfer coding.
+ *
+ * @details Every non-empty slice of body goes out as chunkHead(), the slice, then
+ * CHUNK_END; finish() closes the body.
+ *
+ * @ingroup http
+ */
+class ChunkedEncoder {
+  public:
+    /// Longest size line: every hex digit of a size_t, then CRLF.
+    static constexpr std::size_t      MAX_SIZE_LINE = 2 * sizeof(std::size_t) + 2;
+    static constexpr std::string_view CHUNK_END     = "\r\n";      ///< Follows chunk data.
+    static constexpr std::string_view LAST_CHUNK    = "0\r\n\r\n"; ///< No trailer fields.
+
+    ChunkedEncoder() noexcept;
+
+    /**
+     * @brief Returns the size line of a chunk of @p size data bytes.
+     *
+     * @details The view stays valid until the next call. A zero size would end the
+     * body, so it yields an empty line: the caller then sends nothing.
+     */
+    std::string_view chunkHead(std::size_t size) noexcept;
+
+    /**
+     * @brief Returns the last chunk the first time, then nothing.
+     */
+    std::string_view finish() noexcept;
+
+    bool isFinished() const noexcept; ///< finish() was called.
+
+  private:
+    char _line[MAX_SIZE_LINE]; ///< Last size line.
+    bool _finished;            ///< The last chunk was handed out.
+};
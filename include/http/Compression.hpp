@@ -0,0 +1,188 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Compression.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:12:25 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:12:25 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Compression.hpp
+ * @brief   Declares content-coding negotiation, the Compressor and its CPU budget.
+ *
+ * @details Responses are compressed three ways, cheapest first:
+ * - A static file with a precompressed sibling (`style.css.br`, `style.css.gz`)
+ *   is answered with the sibling, which costs nothing at run time.
+ * - A small file is compressed once and the result kept in the AssetCache next to
+ *   its identity version, so only the first request pays.
+ * - CGI output is compressed as it streams, one pipe read at a time.
+ *
+ * Only the last two use the CPU. Each event loop owns a CompressionBudget that
+ * caps the share of its time spent compressing; over budget, responses go out
+ * uncompressed rather than slowing every other client of the loop.
+ *
+ * gzip needs zlib (`WEBSERV_HAVE_ZLIB`), brotli the brotli encoder
+ * (`WEBSERV_HAVE_BROTLI`). Without them only precompressed siblings are served.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Content codings the server can produce (RFC 9110, section 8.4.1).
+ */
+enum class ContentCoding : std::uint8_t {
+    IDENTITY, ///< No coding.
+    GZIP,     ///< `gzip`, sibling suffix `.gz`.
+    BROTLI    ///< `br`, sibling suffix `.br`.
+};
+
+/// Bit of a coding in the masks used by Location and parseAcceptEncoding().
+constexpr unsigned codingBit(ContentCoding coding) noexcept {
+    return coding == ContentCoding::IDENTITY ? 0 : 1U << static_cast<unsigned>(coding);
+}
+
+std::string_view codingName(ContentCoding coding) noexcept;   ///< "gzip", "br" or "identity".
+std::string_view codingSuffix(ContentCoding coding) noexcept; ///< ".gz", ".br" or "".
+
+/**
+ * @brief Returns the complete `Content-Encoding` field line of a coding.
+ */
+std::string_view contentEncodingField(ContentCoding coding) noexcept;
+
+/**
+ * @brief Parses a coding name as written in the configuration (`gzip`, `br`).
+ *
+ * @return The coding, or IDENTITY if the name is unknown.
+ */
+ContentCoding parseCodingName(std::string_view name) noexcept;
+
+/**
+ * @brief Returns the codings an `Accept-Encoding` value allows, as a codingBit() mask.
+ *
+ * @details A coding with `q=0` is refused; `*` stands for every coding not named.
+ * An empty value accepts nothing, so the response stays identity.
+ */
+unsigned parseAcceptEncoding(std::string_view value) noexcept;
+
+/**
+ * @brief Picks the coding to use from a mask: brotli, then gzip, then identity.
+ */
+ContentCoding preferredCoding(unsigned mask) noexcept;
+
+/**
+ * @brief Returns the codings this build can compress with, as a codingBit() mask.
+ */
+unsigned availableCodings() noexcept;
+
+/**
+ * @brief Returns true for media types worth compressing (text, JSON, JS, XML, SVG).
+ *
+ * @param content_type `Content-Type` value; parameters are ignored.
+ */
+bool isCompressibleType(std::string_view content_type) noexcept;
+
+/**
+ * @brief Streaming encoder for one response body.
+ *
+ * @ingroup http
+ */
+class Compressor {
+  public:
+    static constexpr int STREAM_LEVEL = 4; ///< Per-request output: speed first.
+    static constexpr int CACHE_LEVEL  = 9; ///< Cached assets: compressed once, served often.
+
+    /**
+     * @brief Starts a body in @p coding.
+     *
+     * @param coding GZIP or BROTLI; must be in availableCodings().
+     * @param level  1 (fastest) to 9 (smallest); brotli maps it onto its own scale.
+     */
+    Compressor(ContentCoding coding, int level);
+    ~Compressor();
+    Compressor(const Compressor&)            = delete;
+    Compressor& operator=(const Compressor&) = delete;
+
+    /// False if the coding is not built in or the encoder could not be set up.
+    bool isValid() const noexcept;
+
+    /**
+     * @brief Compresses @p input and appends the output to @p out.
+     *
+     * @param flush Makes every byte given so far decodable, at some cost in ratio;
+     *              used for streamed bodies so the client is not kept waiting.
+     * @return False on an encoder error.
+     */
+    bool write(std::string_view input, std::string& out, bool flush = false);
+
+    /**
+     * @brief Ends the body and appends the last bytes to @p out.
+     */
+    bool finish(std::string& out);
+
+    /**
+     * @brief Compresses a whole body at once.
+     *
+     * @return False if the coding is not built in or the encoder failed.
+     */
+    static bool compress(ContentCoding coding, int level, std::string_view input,
+                         std::string& out);
+
+  private:
+    ContentCoding _coding;
+    void*         _state; ///< z_stream or BrotliEncoderState, NULL if invalid.
+
+    bool run(std::string_view input, std::string& out, int mode);
+};
+
+/**
+ * @brief Caps the share of an event loop's time spent compressing.
+ *
+ * @details A token bucket counted in nanoseconds of CPU: it fills at @c percent
+ * of wall-clock time, up to a small burst, and every compression is charged what
+ * it took. Compression starts only while the bucket is not empty, so a burst of
+ * requests cannot push a loop above its budget for long.
+ *
+ * @ingroup http
+ */
+class CompressionBudget {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr unsigned DEFAULT_PERCENT = 50;
+
+    explicit CompressionBudget(unsigned percent = DEFAULT_PERCENT);
+
+    /**
+     * @brief Changes the budget; 0 disables compression, 100 removes the cap.
+     */
+    void     setPercent(unsigned percent) noexcept;
+    unsigned getPercent() const noexcept;
+
+    /// True if a compression may start now.
+    bool allows(Clock::time_point now = Clock::now()) noexcept;
+
+    /// Charges the time since @p started, when a compression step began.
+    void charge(Clock::time_point started, Clock::time_point now = Clock::now()) noexcept;
+
+    std::uint64_t getRefused() const noexcept; ///< Compressions skipped for lack of budget.
+
+  private:
+    static constexpr std::int64_t BURST_NS = 20'000'000; ///< Most CPU banked: 20 ms.
+
+    unsigned          _percent;
+    std::int64_t      _tokens;  ///< Nanoseconds of CPU left; negative after an overrun.
+    Clock::time_point _refill;  ///< Last time tokens were added.
+    std::uint64_t     _refused; ///< See getRefused().
+};
@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   DateCache.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:45:44 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:45:44 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    DateCache.hpp
+ * @brief   Declares the DateCache, the `Date` field reformatted once per second.
+ *
+ * @details Every response carries a `Date` field (RFC 9110, section 6.6.1), but
+ * its text only changes once per second. Each event loop owns a DateCache and
+ * refreshes it once per iteration; responses borrow the current field line
+ * instead of calling `gmtime()` and formatting it themselves.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include <ctime>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Current `Date` field line of one event loop.
+ *
+ * @details The line is shared, not overwritten: responses still queued when the
+ * second changes keep the previous line alive and send it intact. Not
+ * thread-safe: each event loop owns one.
+ *
+ * @ingroup http
+ */
+class DateCache {
+  public:
+    /**
+     * @brief Formats the field for the current time.
+     */
+    DateCache();
+    ~DateCache()                           = default;
+    DateCache(const DateCache&)            = delete;
+    DateCache& operator=(const DateCache&) = delete;
+
+    /**
+     * @brief Reformats the field if @p now lies in another second.
+     *
+     * @return True if the field changed.
+     */
+    bool update(std::time_t now);
+
+    /**
+     * @brief Returns the field line, e.g. "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n".
+     */
+    const std::shared_ptr<const std::string>& getField() const noexcept;
+
+    std::time_t getTime() const noexcept; ///< Second the field was formatted for.
+
+  private:
+    std::time_t                        _time;  ///< See getTime().
+    std::shared_ptr<const std::string> _field; ///< See getField().
+};
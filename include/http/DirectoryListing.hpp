@@ -0,0 +1,205 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   DirectoryListing.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:48:46 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:48:46 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    DirectoryListing.hpp
+ * @brief   Declares the autoindex listing, its incremental scan and its cache.
+ *
+ * @details A directory listing costs a `readdir()` sweep plus a `stat()` per
+ * entry, which for tens of thousands of files is far too long to do in one go on
+ * an event loop. DirectoryScan therefore reads a bounded number of entries per
+ * step(), sorts them once, and renders the HTML rows in bounded steps too; the
+ * loop runs one step per iteration and keeps serving other clients in between.
+ *
+ * The rendered rows are kept in a DirectoryListing and cached per directory in a
+ * ListingCache. Like AssetCache entries, a listing remembers the CachedFile of
+ * its directory: the FileCache reopens a directory whose mtime changed, so a new
+ * file or a removed one makes the listing stale. Pages are slices of the rows,
+ * sent without copying them; only the page frame is formatted per request.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include "http/FileCache.hpp"
+#include <cstddef>
+#include <ctime>
+#include <dirent.h>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Rendered rows of one directory, sorted with subdirectories first.
+ *
+ * @details Immutable once built. Responses hold it through a `std::shared_ptr`
+ * while its rows are sent, so evicting it from the cache is always safe.
+ *
+ * @ingroup http
+ */
+class DirectoryListing {
+  public:
+    DirectoryListing(const DirectoryListing&)            = delete;
+    DirectoryListing& operator=(const DirectoryListing&) = delete;
+
+    std::size_t size() const noexcept;           ///< Entries listed.
+    std::size_t getMemoryUsage() const noexcept; ///< Bytes of rendered rows and offsets.
+
+    /**
+     * @brief Returns the HTML rows of entries [first, first + count), clamped.
+     */
+    std::string_view getRows(std::size_t first, std::size_t count) const noexcept;
+
+    /**
+     * @brief Returns true if the listing was read from @p directory.
+     *
+     * @details Compares ownership, like CachedResponse::isBuiltFrom().
+     */
+    bool isBuiltFrom(const std::shared_ptr<const CachedFile>& directory) const noexcept;
+
+    /**
+     * @brief Appends the start of a page: title, heading and parent link.
+     *
+     * @param uri Request path of the directory, ending with '/'.
+     */
+    static void renderHead(std::string& out, std::string_view uri);
+
+    /**
+     * @brief Appends the end of a page, with links to its neighbours if it has any.
+     *
+     * @param page  Page shown, from 1.
+     * @param pages Pages in the listing.
+     */
+    static void renderTail(std::string& out, std::size_t page, std::size_t pages);
+
+  private:
+    friend class DirectoryScan;
+
+    explicit DirectoryListing(const std::shared_ptr<const CachedFile>& source);
+
+    std::string                     _rows;    ///< One HTML table row per entry.
+    std::vector<std::size_t>        _offsets; ///< Start of each row, then the end.
+    std::weak_ptr<const CachedFile> _source;  ///< Directory the rows were read from.
+};
+
+/**
+ * @brief Builds a DirectoryListing a bounded amount of work at a time.
+ *
+ * @details Hidden entries (names starting with '.') are left out, as are entries
+ * that vanish or cannot be stat'ed while the directory is read.
+ *
+ * @ingroup http
+ */
+class DirectoryScan {
+  public:
+    static constexpr std::size_t STEP = 512; ///< Entries read or rendered per step().
+
+    /**
+     * @brief Opens @p path; a failure is reported by the first step().
+     *
+     * @param path   Filesystem path of the directory.
+     * @param source FileCache entry of the directory, remembered by the listing.
+     */
+    DirectoryScan(std::string path, std::shared_ptr<const CachedFile> source);
+    ~DirectoryScan();
+    DirectoryScan(const DirectoryScan&)            = delete;
+    DirectoryScan& operator=(const DirectoryScan&) = delete;
+
+    /**
+     * @brief Reads or renders up to STEP more entries.
+     *
+     * @return True once the scan is over: getListing() is then set, or getError().
+     */
+    bool step();
+
+    const std::string&                             getPath() const noexcept;
+    const std::shared_ptr<const DirectoryListing>& getListing() const noexcept;
+    int getError() const noexcept; ///< errno of a failed scan, 0 otherwise.
+
+  private:
+    struct Entry {
+        std::string name;
+        std::size_t size;
+        std::time_t mtime;
+        bool        directory;
+    };
+
+    std::string                             _path;     ///< Directory being read.
+    std::shared_ptr<DirectoryListing>       _building; ///< Filled by step().
+    std::shared_ptr<const DirectoryListing> _listing;  ///< Set once complete.
+    DIR*                                    _dir;      ///< Open while reading, then NULL.
+    std::vector<Entry>                      _entries;  ///< Read so far.
+    std::size_t                             _rendered; ///< Entries rendered so far.
+    int                                     _error;    ///< See getError().
+
+    bool read();
+    void render();
+};
+
+/**
+ * @brief LRU of directory listings keyed by filesystem path, bounded in bytes.
+ *
+ * @details Like the other caches, an instance belongs to a single event loop.
+ *
+ * @ingroup http
+ */
+class ListingCache {
+  public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 32 << 20; ///< Bytes held at most.
+
+    explicit ListingCache(std::size_t capacity = DEFAULT_CAPACITY);
+    ~ListingCache()                              = default;
+    ListingCache(const ListingCache&)            = delete;
+    ListingCache& operator=(const ListingCache&) = delete;
+
+    /**
+     * @brief Returns the listing of @p path if it was read from @p directory.
+     *
+     * @return The listing, or NULL on a miss. A stale entry is dropped.
+     */
+    std::shared_ptr<const DirectoryListing>
+    find(std::string_view path, const std::shared_ptr<const CachedFile>& directory);
+
+    /**
+     * @brief Stores @p listing, evicting old entries to make room.
+     *
+     * @return False if the listing alone is larger than the cache.
+     */
+    bool insert(std::string_view path, std::shared_ptr<const DirectoryListing> listing);
+
+    void        clear() noexcept;
+    std::size_t size() const noexcept;
+    std::size_t getMemoryUsage() const noexcept;
+    std::size_t getHits() const noexcept;
+    std::size_t getMisses() const noexcept;
+
+  private:
+    struct Entry {
+        std::string                             path;    ///< Owns the bytes _index keys view.
+        std::shared_ptr<const DirectoryListing> listing; ///< Rendered rows.
+    };
+
+    using EntryList = std::list<Entry>;
+
+    std::size_t                                               _capacity; ///< Bytes at most.
+    std::size_t                                               _memory;   ///< Bytes held now.
+    EntryList                                                 _lru;      ///< Most recent first.
+    std::unordered_map<std::string_view, EntryList::iterator> _index;    ///< Views Entry::path.
+    std::size_t                                               _hits;     ///< See getHits().
+    std::size_t                                               _misses;   ///< See getMisses().
+
+    void erase(EntryList::iterator it) noexcept;
+};
@@ -0,0 +1,166 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FileCache.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:24:10 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:36:08 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    FileCache.hpp
+ * @brief   Declares the FileCache of open file descriptors and stat results.
+ *
+ * @details Serving a static file normally costs `open()`, `fstat()` and `close()`
+ * per request. FileCache keeps recently used files open, together with their stat
+ * data, in an LRU keyed by resolved filesystem path. Entries are trusted for a short
+ * TTL. After that, a single `stat()` revalidates them, and the file is reopened
+ * only if it was replaced or modified. The file's `ETag` is formatted when it is
+ * opened, so validating a conditional request costs a comparison.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <sys/stat.h>
+#include <unordered_map>
+
+/**
+ * @brief An open file and the metadata it had when it was opened.
+ *
+ * @details Owns its descriptor. Responses hold a `std::shared_ptr` to the file
+ * while it is being sent, so evicting the cache entry never closes a descriptor
+ * that is still in use.
+ *
+ * @ingroup http
+ */
+class CachedFile {
+  public:
+    /**
+     * @brief Takes ownership of @p fd.
+     *
+     * @param fd Descriptor opened for reading, or -1 for a directory.
+     * @param st Result of `fstat()` on the file.
+     */
+    CachedFile(int fd, const struct stat& st) noexcept;
+    ~CachedFile();
+    CachedFile(const CachedFile&)            = delete;
+    CachedFile& operator=(const CachedFile&) = delete;
+
+    int         getFd() const noexcept;           ///< -1 for directories.
+    std::size_t getSize() const noexcept;         ///< Size in bytes.
+    std::time_t getModifiedTime() const noexcept; ///< Last modification, seconds.
+    bool        isDirectory() const noexcept;
+    bool        isRegular() const noexcept;
+
+    /**
+     * @brief Returns the strong entity tag of the file, quotes included.
+     *
+     * @details Hex modification time and size, as nginx does, e.g. `"6650d1f2-1a4"`.
+     */
+    std::string_view getETag() const noexcept;
+
+    /**
+     * @brief Returns true if @p st still describes the same, unmodified file.
+     */
+    bool isUnchanged(const struct stat& st) const noexcept;
+
+  private:
+    int             _fd;          ///< Open descriptor owned by this object.
+    dev_t           _dev;         ///< Device of the inode.
+    ino_t           _ino;         ///< Inode number.
+    mode_t          _mode;        ///< File type and permissions.
+    std::size_t     _size;        ///< Size in bytes.
+    struct timespec _mtime;       ///< Modification time.
+    char            _etag[40];    ///< See getETag(), not NUL-terminated.
+    std::uint8_t    _etag_length; ///< Bytes of _etag in use.
+};
+
+/**
+ * @brief LRU cache of open files keyed by filesystem path.
+ *
+ * @details Failed lookups (e.g. `ENOENT`) are cached for the same TTL, so
+ * repeated requests for a missing asset do not hit the filesystem either. The
+ * cache is not thread-safe: each event loop owns its own instance.
+ *
+ * @ingroup http
+ */
+class FileCache {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t DEFAULT_CAPACITY = 1024; ///< Entries kept open.
+    static constexpr std::chrono::milliseconds DEFAULT_TTL{1000}; ///< Trust period.
+
+    /**
+     * @brief Outcome of a lookup: a file, or the errno that prevented opening it.
+     */
+    struct Lookup {
+        std::shared_ptr<const CachedFile> file;  ///< Open file, or NULL on failure.
+        int                               error; ///< errno when @ref file is NULL, else 0.
+    };
+
+    /**
+     * @brief Creates an empty cache.
+     *
+     * @param capacity Maximum number of cached paths; 0 disables caching.
+     * @param ttl      How long an entry is used without being revalidated.
+     */
+    explicit FileCache(std::size_t               capacity = DEFAULT_CAPACITY,
+                       std::chrono::milliseconds ttl      = DEFAULT_TTL);
+    ~FileCache()                           = default;
+    FileCache(const FileCache&)            = delete;
+    FileCache& operator=(const FileCache&) = delete;
+
+    /**
+     * @brief Returns the open file at @p path, opening it if needed.
+     *
+     * @details Regular files are opened read-only. Directories are only stat'ed
+     * and come back with a descriptor of -1.
+     *
+     * @param path Filesystem path.
+     * @return The file, or the error set by `open()` / `fstat()`.
+     */
+    Lookup open(std::string_view path);
+
+    /**
+     * @brief Drops every entry; files still referenced elsewhere stay open.
+     */
+    void clear() noexcept;
+
+    std::size_t size() const noexcept;
+    std::size_t getCapacity() const noexcept;
+    std::size_t getHits() const noexcept;   ///< Lookups answered without `open()`.
+    std::size_t getMisses() const noexcept; ///< Lookups that had to open the file.
+
+  private:
+    struct Entry {
+        std::string       path;      ///< Key; _index holds a view of it.
+        Lookup            result;    ///< Cached outcome.
+        Clock::time_point validated; ///< Last time the outcome was confirmed.
+    };
+
+    using EntryList = std::list<Entry>;
+
+    std::size_t                                         _capacity; ///< Maximum entries.
+    std::chrono::milliseconds                           _ttl;      ///< Trust period.
+    EntryList                                           _lru;      ///< Most recent first.
+    std::unordered_map<std::string_view, EntryList::iterator> _index; ///< Views Entry::path.
+    std::size_t                                         _hits;     ///< See getHits().
+    std::size_t                                         _misses;   ///< See getMisses().
+
+    static Lookup load(const std::string& path);
+    bool          revalidate(Entry& entry) const;
+};
@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HeaderFields.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:45:44 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:36:08 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HeaderFields.hpp
+ * @brief   Declares the pre-encoded header fields shared by every response.
+ *
+ * @details Fields whose text never changes are stored once, complete with their
+ * CRLF, and handed to HttpResponse::addField() by reference. Building a response
+ * then copies and formats nothing for them. The table of `Content-Type` fields by
+ * file extension lives here too.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include <string_view>
+
+constexpr std::string_view FIELD_SERVER                = "Server: webserv\r\n";
+constexpr std::string_view FIELD_CONNECTION_CLOSE      = "Connection: close\r\n";
+constexpr std::string_view FIELD_CONNECTION_KEEP_ALIVE = "Connection: keep-alive\r\n";
+constexpr std::string_view FIELD_CONTENT_TYPE_HTML     = "Content-Type: text/html\r\n";
+constexpr std::string_view FIELD_VARY_ACCEPT_ENCODING  = "Vary: Accept-Encoding\r\n";
+constexpr std::string_view FIELD_ACCEPT_RANGES         = "Accept-Ranges: bytes\r\n";
+
+/**
+ * @brief Returns the pre-encoded `Content-Type` field for a file name.
+ *
+ * @param path File name or path; only its extension is looked at, ignoring case.
+ * @return Static field line, `application/octet-stream` for unknown extensions.
+ */
+std::string_view contentTypeField(std::string_view path) noexcept;
+
+/**
+ * @brief Returns the value of a pre-encoded field line.
+ *
+ * @param field Line of the form "Name: value\r\n".
+ * @return The value, without the name or the CRLF.
+ */
+std::string_view fieldValue(std::string_view field) noexcept;
@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HttpMethod.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:08:37 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:33:41 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HttpMethod.hpp
+ * @brief   Declares the HttpMethod enumeration and its helpers.
+ *
+ * @details Request methods are recognized once by the parser and carried around as
+ * a small enum, so later stages compare integers instead of strings.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @defgroup http HTTP Protocol
+ * @brief Request parsing and response generation.
+ * @{
+ */
+
+/**
+ * @brief HTTP request methods known to the server.
+ */
+enum class HttpMethod : std::uint8_t {
+    GET,
+    HEAD,
+    POST,
+    PUT,
+    DELETE,
+    OPTIONS,
+    PATCH,
+    UNKNOWN ///< Syntactically valid token that is not a known method.
+};
+
+/**
+ * @brief Maps a method token to its HttpMethod value.
+ *
+ * @param token Method as sent on the request line (case-sensitive).
+ * @return Matching method, or HttpMethod::UNKNOWN.
+ */
+HttpMethod parseHttpMethod(std::string_view token) noexcept;
+
+/**
+ * @brief Returns the canonical name of a method (e.g. "GET").
+ *
+ * @param method Method to name.
+ * @return Static string, "UNKNOWN" for HttpMethod::UNKNOWN.
+ */
+std::string_view httpMethodName(HttpMethod method) noexcept;
+
+/**
+ * @brief Returns the single-bit mask of a method, for method sets stored as bitmasks.
+ *
+ * @param method Method to encode; HttpMethod::UNKNOWN maps to 0.
+ * @return `1 << method`, or 0 for HttpMethod::UNKNOWN.
+ */
+constexpr std::uint16_t httpMethodBit(HttpMethod method) noexcept {
+    return method == HttpMethod::UNKNOWN
+               ? std::uint16_t{0}
+               : static_cast<std::uint16_t>(1U << static_cast<unsigned>(method));
+}
+
+/** @} */
@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HttpRequest.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/05/02 13:45:05 by nlouis            #+#    #+#             */
+/*   Updated: 2025/05/13 18:20:05 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HttpRequest.hpp
+ * @brief   Declares the HttpRequest class.
+ *
+ * @details An HttpRequest does not own any text. The request line and every header
+ * are stored as offset/length slices into the connection's input buffer and exposed
+ * as `std::string_view`s. Only what routing and framing need is materialized into
+ * scalar fields while parsing: the method, protocol version, Content-Length,
+ * chunked framing and keep-alive intent.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include "http/HttpMethod.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Position of a token relative to the first byte of the request.
+ *
+ * @details Offsets survive the input buffer being compacted or reallocated between
+ * two reads, unlike raw pointers.
+ *
+ * @ingroup http
+ */
+struct HttpSlice {
+    std::uint32_t offset = 0; ///< First byte of the token.
+    std::uint32_t length = 0; ///< Token length in bytes.
+};
+
+/**
+ * @brief A header field as two slices.
+ *
+ * @ingroup http
+ */
+struct HttpHeaderSlice {
+    HttpSlice name;  ///< Field name, case preserved.
+    HttpSlice value; ///< Field value, surrounding whitespace removed.
+};
+
+/**
+ * @brief Parsed view over an HTTP/1.x request head.
+ *
+ * @details Filled by HttpRequestParser. Accessors are valid once the parser reported
+ * a complete head and bind() was called with the current address of the request's
+ * first byte; they stay valid until that buffer is modified.
+ *
+ * @ingroup http
+ */
+class HttpRequest {
+  public:
+    static constexpr std::size_t MAX_HEADERS = 64; ///< Header fields accepted per request.
+
+    HttpRequest();
+    ~HttpRequest()                             = default;
+    HttpRequest(const HttpRequest&)            = default;
+    HttpRequest& operator=(const HttpRequest&) = default;
+
+    /**
+     * @brief Clears every field so the object can describe the next request.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Sets the address of the request's first byte in the input buffer.
+     *
+     * @param base Pointer to the first byte of the request.
+     */
+    void bind(const char* base) noexcept;
+
+    // --- Request line ---
+
+    HttpMethod       getMethod() const noexcept;
+    std::string_view getMethodName() const noexcept;
+    std::string_view getTarget() const noexcept; ///< Full request target, query included.
+    std::string_view getPath() const noexcept;   ///< Target up to the first '?'.
+    std::string_view getQuery() const noexcept;  ///< Text after the first '?', or empty.
+    int              getVersionMajor() const noexcept;
+    int              getVersionMinor() const noexcept;
+
+    // --- Materialized header data ---
+
+    std::string_view getHost() const noexcept; ///< Host header without the port.
+    bool             hasContentLength() const noexcept;
+    std::size_t      getContentLength() const noexcept;
+    bool             isChunked() const noexcept;
+    bool             isKeepAlive() const noexcept;
+
+    // --- Raw header access ---
+
+    std::size_t      getHeaderCount() const noexcept;
+    std::string_view getHeaderName(std::size_t index) const noexcept;
+    std::string_view getHeaderValue(std::size_t index) const noexcept;
+
+    /**
+     * @brief Returns the value of the first header with the given name.
+     *
+     * @param name Field name, compared case-insensitively.
+     * @return Field value, or an empty view if the header is absent.
+     */
+    std::string_view getHeader(std::string_view name) const noexcept;
+
+  private:
+    friend class HttpRequestParser;
+
+    const char*                              _base;           ///< First byte of the request.
+    HttpMethod                               _method;         ///< Recognized method.
+    HttpSlice                                _method_name;    ///< Method token.
+    HttpSlice                                _target;         ///< Request target.
+    HttpSlice                                _path;           ///< Path part of the target.
+    HttpSlice                                _query;          ///< Query part of the target.
+    int                                      _version_major;  ///< HTTP major version.
+    int                                      _version_minor;  ///< HTTP minor version.
+    HttpSlice                                _host;           ///< Host without port.
+    bool                                     _has_length;     ///< Content-Length was sent.
+    std::size_t                              _content_length; ///< Declared body size.
+    bool                                     _chunked;        ///< Chunked transfer coding.
+    bool                                     _keep_alive;     ///< Connection may persist.
+    std::array<HttpHeaderSlice, MAX_HEADERS> _headers;        ///< Header fields in order.
+    std::size_t                              _header_count;   ///< Used entries of _headers.
+
+    std::string_view view(HttpSlice slice) const noexcept;
+};
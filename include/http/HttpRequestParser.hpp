@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HttpRequestParser.hpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/05/02 13:45:05 by nlouis            #+#    #+#             */
+/*   Updated: 2025/05/13 18:20:05 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HttpRequestParser.hpp
+ * @brief   Declares the incremental HTTP/1.x request head parser.
+ *
+ * @details The parser is a resumable state machine. Each call to parse() continues
+ * from the exact byte where the previous call stopped, so a head arriving in many
+ * small reads is still scanned only once. It never copies or allocates: tokens are
+ * recorded as HttpSlice offsets into the caller's buffer.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include "http/HttpRequest.hpp"
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @brief Incremental, allocation-free parser for request heads.
+ *
+ * @details Usage: call parse() with the whole buffered request (starting at its first
+ * byte) every time new bytes arrive. The buffer may move between calls as long as the
+ * bytes already passed keep their offsets. After COMPLETE, consumed() is the head
+ * length and the body (if any) starts right after it.
+ *
+ * @ingroup http
+ */
+class HttpRequestParser {
+  public:
+    static constexpr std::size_t DEFAULT_MAX_HEAD = 8192; ///< Default head size limit.
+
+    /**
+     * @brief Parser progress reported by parse().
+     */
+    enum class Result {
+        INCOMPLETE, ///< More bytes are needed.
+        COMPLETE,   ///< The head is fully parsed.
+        ERROR       ///< Malformed or unacceptable request, see getErrorStatus().
+    };
+
+    /**
+     * @brief Creates a parser.
+     *
+     * @param max_head_size Largest accepted head in bytes, CRLFCRLF included.
+     */
+    explicit HttpRequestParser(std::size_t max_head_size = DEFAULT_MAX_HEAD);
+
+    /**
+     * @brief Resumes parsing over the buffered request bytes.
+     *
+     * @param data    Buffered bytes, starting at the first byte of the request.
+     * @param request Receives the parsed fields; bound to @p data on COMPLETE.
+     * @return Current parser progress.
+     */
+    Result parse(std::string_view data, HttpRequest& request);
+
+    /**
+     * @brief Prepares the parser for the next request on the same connection.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Returns the head length in bytes once parse() returned COMPLETE.
+     */
+    std::size_t consumed() const noexcept;
+
+    /**
+     * @brief Returns the HTTP status describing the last ERROR (400, 431, 501, 505).
+     */
+    int getErrorStatus() const noexcept;
+
+  private:
+    enum class State {
+        LEADING_EOL,
+        METHOD,
+        TARGET,
+        VERSION,
+        REQUEST_LINE_EOL,
+        HEADER_START,
+        HEADER_NAME,
+        HEADER_VALUE_START,
+        HEADER_VALUE,
+        HEADER_LINE_EOL,
+        HEADERS_END_EOL,
+        DONE
+    };
+
+    std::size_t _max_head_size; ///< Head size limit.
+    State       _state;         ///< Where parse() resumes.
+    std::size_t _pos;           ///< Offset of the next unread byte.
+    std::size_t _mark;          ///< Start offset of the token being scanned.
+    HttpSlice   _name;          ///< Name of the header whose value is being scanned.
+    int         _error_status;  ///< Status for Result::ERROR.
+
+    Result fail(int status) noexcept;
+    Result suspend(std::size_t pos, std::size_t available) noexcept;
+    int    consumeEol(std::string_view data, std::size_t& pos) const noexcept;
+    void   setTarget(HttpRequest& request, std::string_view data, std::size_t end) const noexcept;
+    bool   addHeader(HttpRequest& request, std::string_view data, std::size_t end) noexcept;
+    bool   finish(HttpRequest& request, std::string_view data) noexcept;
+};
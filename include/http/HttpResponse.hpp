@@ -0,0 +1,251 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HttpResponse.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/04/26 16:00:00 by nlouis            #+#    #+#             */
+/*   Updated: 2025/05/18 19:37:22 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HttpResponse.hpp
+ * @brief   Declares the HttpResponse class.
+ *
+ * @details An HttpResponse is the status line and header fields plus one body. The
+ * body is either an in-memory string or byte ranges of a CachedFile. A file body
+ * is never read into user space: the connection hands it to `sendfile()` once the
+ * serialized head has been written. A response may instead carry a CachedResponse
+ * from the AssetCache, whose head and body are already serialized.
+ *
+ * Nothing is concatenated on the way out: takeSegments() splits the response into
+ * the pieces the connection gathers into one `sendmsg()`. The status line and
+ * pre-encoded fields are static or shared text, only the per-response fields are
+ * formatted, and the body is moved, borrowed from the cache or sent from its file.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include "http/AssetCache.hpp"
+#include "http/FileCache.hpp"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Response being prepared for one request.
+ *
+ * @details `Content-Length` is derived from the body when the head is serialized
+ * and must not be set by hand, except for streamed bodies (see setStreamed()).
+ * Header names are compared ignoring ASCII case. Header fields live in the
+ * memory resource given at construction, usually the connection's per-request
+ * Arena; the body is a plain string because it outlives the response in the
+ * connection's output queue.
+ *
+ * @ingroup http
+ */
+class HttpResponse {
+  public:
+    HttpResponse();
+    explicit HttpResponse(int status,
+                          std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+    ~HttpResponse()                                  = default;
+    HttpResponse(const HttpResponse&)                = default;
+    HttpResponse& operator=(const HttpResponse&)     = default;
+    HttpResponse(HttpResponse&&) noexcept            = default;
+    HttpResponse& operator=(HttpResponse&&) noexcept = default;
+
+    // --- Status and headers ---
+
+    void setStatus(int status) noexcept;
+    int  getStatus() const noexcept;
+
+    /**
+     * @brief Sets a header field, replacing any field with the same name.
+     */
+    void setHeader(std::string_view name, std::string_view value);
+
+    /**
+     * @brief Returns the value of a header field, or NULL if it is not set.
+     */
+    const std::pmr::string* getHeader(std::string_view name) const noexcept;
+
+    /**
+     * @brief Returns the value of a field set with setHeader() or addField(), or
+     * held in the head of a cached response.
+     *
+     * @return The value, or an empty view if the field is not set.
+     */
+    std::string_view getField(std::string_view name) const noexcept;
+
+    /**
+     * @brief Removes a header field if present.
+     */
+    void removeHeader(std::string_view name) noexcept;
+
+    // --- Body ---
+
+    /**
+     * @brief Uses an in-memory body and drops any file body.
+     *
+     * @param body         Body bytes.
+     * @param content_type Value for `Content-Type`; left untouched if empty.
+     */
+    void setBody(std::string body, std::string_view content_type = "");
+
+    /**
+     * @brief Sends @p length bytes of @p file starting at @p offset as the body.
+     */
+    void setFile(std::shared_ptr<const CachedFile> file, off_t offset, std::size_t length);
+
+    /// Part of a `multipart/byteranges` body: its header block, then a range of the file.
+    struct FilePart {
+        std::string head;   ///< Boundary line and part fields, ending with the blank line.
+        off_t       offset; ///< First file byte.
+        std::size_t length; ///< File bytes.
+    };
+
+    /**
+     * @brief Sends every part of @p parts in turn, then @p tail, as the body.
+     *
+     * @details Each file range goes out with `sendfile()` like a single one; only
+     * the short part heads and the closing boundary in @p tail are in memory.
+     */
+    void setFileParts(std::shared_ptr<const CachedFile> file, std::vector<FilePart> parts,
+                      std::string tail);
+
+    /**
+     * @brief Sends @p head, @p shared and @p tail as the body, without copying @p shared.
+     *
+     * @details For large generated bodies kept by a cache, e.g. directory listings:
+     * only the per-request text around them is formatted.
+     *
+     * @param owner Keeps @p shared alive until it is sent.
+     */
+    void setSharedBody(std::string head, std::string_view shared,
+                       std::shared_ptr<const void> owner, std::string tail);
+
+    bool                                     hasFile() const noexcept;
+    const std::string&                       getBody() const noexcept;
+    std::string&&                            takeBody() noexcept;
+    const std::shared_ptr<const CachedFile>& getFile() const noexcept;
+    off_t                                    getFileOffset() const noexcept;
+
+    /**
+     * @brief Answers with a preserialized response and drops any other body.
+     *
+     * @details Takes the status and header fields from @p cached, dropping the ones
+     * set so far, including those from addField(). Header fields set afterwards are
+     * written after the cached ones, so they must not repeat them.
+     */
+    void setCached(std::shared_ptr<const CachedResponse> cached);
+
+    const std::shared_ptr<const CachedResponse>& getCached() const noexcept;
+
+    /**
+     * @brief Marks the body as sent by the caller after the head, e.g. CGI output.
+     *
+     * @details The head then carries no derived `Content-Length`; the caller frames
+     * the body with a `Content-Length` or `Transfer-Encoding` field of its own, or
+     * by closing the connection.
+     */
+    void setStreamed() noexcept;
+
+    /**
+     * @brief Returns the length of the body, in memory, on file or cached.
+     */
+    std::size_t getContentLength() const noexcept;
+
+    /**
+     * @brief Serializes the status line and header fields, ending with CRLFCRLF.
+     *
+     * @details Appends `Content-Length` except for 1xx, 204 and 304 responses,
+     * which never carry one.
+     */
+    std::string serializeHead() const;
+
+    /**
+     * @brief Serializes the fields set with setHeader() and the blank line.
+     *
+     * @details This is the only part of the head formatted per response. It holds
+     * `Content-Length` unless the response is cached, whose head already has one.
+     */
+    std::string serializeFields() const;
+
+    /**
+     * @brief Returns the standard reason phrase of a status code.
+     *
+     * @return Reason phrase, or "Unknown" for unregistered codes.
+     */
+    static std::string_view reasonPhrase(int status) noexcept;
+
+    // --- Vectored output ---
+
+    /**
+     * @brief Adds a pre-encoded header field that is sent without being copied.
+     *
+     * @details Such fields go out right after the status line and are invisible to
+     * getHeader(), so the same field must not also be set with setHeader().
+     *
+     * @param field Complete field line with its CRLF, e.g. "Connection: close\r\n".
+     * @param owner Keeps @p field alive; NULL when it has static storage.
+     */
+    void addField(std::string_view field, std::shared_ptr<const void> owner = NULL);
+
+    /**
+     * @brief Piece of the serialized response, in send order.
+     *
+     * @details Exactly one of @c file, @c bytes and @c text holds the data.
+     */
+    struct Segment {
+        std::shared_ptr<const CachedFile> file;   ///< File range to send, or NULL.
+        off_t                             offset; ///< First file byte.
+        std::size_t                       length; ///< File bytes.
+        std::string_view                  bytes;  ///< Borrowed bytes, static or kept by owner.
+        std::shared_ptr<const void>       owner;  ///< Keeps @c bytes alive, or NULL.
+        std::string                       text;   ///< Bytes owned by the segment.
+    };
+
+    using Segments = std::pmr::vector<Segment>; ///< Allocated like the header fields.
+
+    /**
+     * @brief Moves the response into the segments the connection sends.
+     *
+     * @details The head is the static status line (or the cached head), the fields
+     * added with addField(), then one formatted block with the remaining fields and
+     * the blank line. Empty pieces are omitted. The in-memory body is moved out, so
+     * the response must not be sent twice.
+     *
+     * @param head_only True for HEAD requests: the body is left out.
+     */
+    Segments takeSegments(bool head_only);
+
+  private:
+    using Header = std::pair<std::pmr::string, std::pmr::string>; ///< Name and value.
+
+    /// Field given to addField().
+    struct Fragment {
+        std::string_view            bytes; ///< Field line including CRLF.
+        std::shared_ptr<const void> owner; ///< Keeps bytes alive, or NULL.
+    };
+
+    int                                   _status;      ///< HTTP status code.
+    std::pmr::vector<Fragment>            _fragments;   ///< Pre-encoded fields in send order.
+    std::pmr::vector<Header>              _headers;     ///< Fields in send order.
+    std::string                           _body;        ///< In-memory body.
+    std::shared_ptr<const CachedFile>     _file;        ///< File body, or NULL.
+    off_t                                 _file_offset; ///< First file byte sent.
+    std::size_t                           _file_length; ///< File bytes sent.
+    std::vector<Segment>                  _pieces;      ///< Body sent in pieces, or empty.
+    std::shared_ptr<const CachedResponse> _cached;      ///< Preserialized, or NULL.
+    bool                                  _streamed;    ///< Body follows separately.
+};
@@ -0,0 +1,297 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HttpResponseBuilder.hpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/04/26 16:00:00 by nlouis            #+#    #+#             */
+/*   Updated: 2025/06/03 17:12:09 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HttpResponseBuilder.hpp
+ * @brief   Declares the HttpResponseBuilder, which turns requests into responses.
+ *
+ * @details The builder routes a parsed request to its Location and applies
+ * redirects and method restrictions. For GET and HEAD it serves static files from
+ * the location root: the file comes from the FileCache and is attached to the
+ * response as a file body, so its bytes are sent with `sendfile()` and are never
+ * copied into user space. Error responses use the server's configured error pages
+ * when they exist. Small files and error pages are served from an optional
+ * AssetCache instead, as fully serialized responses.
+ *
+ * Locations with `compress_static` answer clients that accept it with a
+ * precompressed sibling of the file (`.br`, then `.gz`). Locations with `compress`
+ * also serve small compressible files from compressed AssetCache entries, made the
+ * first time they are asked for while the loop's CompressionBudget allows it.
+ * Larger files without a sibling are sent as they are.
+ *
+ * A file response is validated by the ETag its CachedFile formatted when it was
+ * opened, and by its modification time: `If-None-Match` and `If-Modified-Since`
+ * get a 304 without a body. GET requests with `Range` on the identity coding get
+ * a 206 whose ranges are sent with `sendfile()` from their offsets, as one body or
+ * as the parts of a `multipart/byteranges` body.
+ *
+ * Directories without an index file are listed when `autoindex` is on, a page of
+ * `autoindex_page_size` entries at a time (`?page=N`). The event loop reads the
+ * directories over several iterations with a DirectoryScan and keeps the result
+ * in its ListingCache; buildListing() then serves pages from the cached rows,
+ * compressed per request where the location compresses.
+ * CGI requests and uploads are
+ * resolved here but run by the event loop, which owns the script processes and
+ * streams request bodies.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include "core/Server.hpp"
+#include "http/AssetCache.hpp"
+#include "http/Compression.hpp"
+#include "http/DirectoryListing.hpp"
+#include "http/FileCache.hpp"
+#include "http/HttpRequest.hpp"
+#include "http/HttpResponse.hpp"
+#include "http/RequestRoute.hpp"
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Builds the HttpResponse for a request against one Server block.
+ *
+ * @details Connection management headers (`Connection`, `Keep-Alive`) are left to
+ * the caller, which knows the connection's state. HEAD responses are built like
+ * GET responses; the caller drops the body when sending them.
+ *
+ * @ingroup http
+ */
+class HttpResponseBuilder {
+  public:
+    static constexpr std::size_t MAX_RANGES = 16; ///< More ranges in one request are ignored.
+
+    /// One range of a `Range` request, resolved against the size of the file.
+    struct ByteRange {
+        std::size_t first;  ///< First byte.
+        std::size_t length; ///< Bytes, at least one.
+    };
+
+    /**
+     * @brief Creates a builder serving files through @p files.
+     *
+     * @param files  Open-file cache owned by the same event loop.
+     * @param assets Serialized small responses of the same event loop, or NULL to
+     *               always send files with `sendfile()`.
+     * @param budget Compression budget of the same event loop, or NULL for no cap.
+     */
+    explicit HttpResponseBuilder(FileCache& files, AssetCache* assets = NULL,
+                                 CompressionBudget* budget = NULL);
+    ~HttpResponseBuilder()                                     = default;
+    HttpResponseBuilder(const HttpResponseBuilder&)            = delete;
+    HttpResponseBuilder& operator=(const HttpResponseBuilder&) = delete;
+
+    /**
+     * @brief Normalizes the request path and matches it to a location of @p server.
+     *
+     * @details Done once per request: the resolve probes and build() all take the
+     * result, so none of them normalizes or looks up the path again.
+     *
+     * @param request Parsed request head.
+     * @param server  Virtual host selected for the request.
+     * @param route   Receives the path and its location.
+     * @return False if the path cannot be normalized; build() answers it with 400.
+     */
+    static bool route(const HttpRequest& request, const Server& server, RequestRoute& route);
+
+    /**
+     * @brief Answers a complete request.
+     *
+     * @param request Parsed request, bound to its buffer.
+     * @param route   The request's route(), on the virtual host selected for it.
+     * @param memory  Per-request memory for the response's header fields and all
+     *                temporary paths, usually the connection's Arena.
+     * @return Response ready to be serialized.
+     */
+    HttpResponse build(const HttpRequest& request, const RequestRoute& route,
+                       std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    /**
+     * @brief Routes a complete request, then answers it.
+     */
+    HttpResponse build(const HttpRequest& request, const Server& server,
+                       std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    /**
+     * @brief Finds the CGI script a request runs, if it runs one.
+     *
+     * @details The request must pass the same routing as build(): a location
+     * without redirect that allows the method and maps the path to a CGI script.
+     * build() answers requests for scripts that do not resolve with 404. Scripts
+     * of a `fastcgi_pass` location live with the backend, which checks them itself.
+     *
+     * @param request     Parsed request head.
+     * @param route       The request's route().
+     * @param script_name Receives the script's part of the path, viewing @p route.
+     * @param filename    Receives the script's path on disk.
+     * @param path_info   Receives the rest of the path after the script, viewing @p route.
+     * @return The script's location, or NULL if the request is not for a script
+     *         that exists as a regular file (or is passed to FastCGI).
+     */
+    const Location* resolveCgi(const HttpRequest& request, const RequestRoute& route,
+                               std::string_view& script_name, std::pmr::string& filename,
+                               std::string_view& path_info);
+
+    /**
+     * @brief Finds the upload store a request writes to, if it writes to one.
+     *
+     * @details The request must pass the same routing as build(): a POST to a
+     * location without redirect that allows it and has an `upload_store`. Requests
+     * for CGI scripts go to the script instead.
+     *
+     * @param request Parsed request head.
+     * @param route   The request's route().
+     * @return The upload location, or NULL if the request is not an upload.
+     */
+    const Location* resolveUpload(const HttpRequest& request, const RequestRoute& route);
+
+    /**
+     * @brief Finds the stats location a request reads, if it reads one.
+     *
+     * @details The request must pass the same routing as build(): a GET or HEAD
+     * to a location without redirect that allows it and has `stats` on. The event
+     * loop answers it, since only the loop can reach the counters.
+     *
+     * @param request Parsed request.
+     * @param route   The request's route().
+     * @return The stats location, or NULL if the request is not for one.
+     */
+    const Location* resolveStats(const HttpRequest& request, const RequestRoute& route);
+
+    /**
+     * @brief Finds the `proxy_pass` location a request is forwarded from, if any.
+     *
+     * @details The request must pass the same routing as build(): a location
+     * without redirect that allows its method and has upstream servers. Proxied
+     * locations take every such request, before CGI and uploads.
+     *
+     * @param request Parsed request head.
+     * @param route   The request's route().
+     * @return The proxied location, or NULL if the request is served locally.
+     */
+    const Location* resolveProxy(const HttpRequest& request, const RequestRoute& route);
+
+    /**
+     * @brief Finds the directory a request lists, if it lists one.
+     *
+     * @details The request must pass the same routing as build(): a GET or HEAD
+     * for a path ending with '/', in a location with `autoindex` on, naming a
+     * directory without an index file. The event loop must take such requests
+     * before build(), which answers them with a 500, and scan the directory step
+     * by step, see DirectoryScan.
+     *
+     * @param request   Parsed request.
+     * @param route     The request's route().
+     * @param directory Receives the directory's path on disk.
+     * @return The location, or NULL if the request is not for a listing.
+     */
+    const Location* resolveAutoindex(const HttpRequest& request, const RequestRoute& route,
+                                     std::pmr::string& directory);
+
+    /**
+     * @brief Builds the page of @p listing that a request asks for.
+     *
+     * @details The page is chosen with the `page` query parameter, from 1. The
+     * rows are sent from @p listing without being copied, unless the location
+     * compresses and the page is long enough: the page is then compressed for
+     * the request, as CGI output is, while the compression budget allows it.
+     *
+     * @param request  Request resolved by resolveAutoindex().
+     * @param location Location of the directory.
+     * @param path     Normalized URI path of the directory.
+     * @param listing  Complete listing of the directory.
+     * @param server   Virtual host, for the 404 of a page past the end.
+     * @param memory   Per-request memory, as for build().
+     * @return The page, or a 404 if there is no such page.
+     */
+    HttpResponse buildListing(const HttpRequest& request, const Location& location,
+                              std::string_view                               path,
+                              const std::shared_ptr<const DirectoryListing>& listing,
+                              const Server&                                  server,
+                              std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    /**
+     * @brief Builds the 201 response to a completed upload.
+     *
+     * @param directory_uri URI path of the upload directory, ending with '/'.
+     * @param files         Names of the stored files; a single one is the Location.
+     * @param memory        Per-request memory, as for build().
+     * @return Response whose text/plain body lists the URI of every stored file.
+     */
+    HttpResponse buildCreated(std::string_view directory_uri, const std::vector<std::string>& files,
+                              std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    /**
+     * @brief Builds an error response, using the server's error page if one is set.
+     *
+     * @param status HTTP status code (4xx or 5xx).
+     * @param server Server whose `error_page` entries apply.
+     * @param memory Per-request memory, as for build().
+     * @return Response with an HTML body.
+     */
+    HttpResponse buildError(int status, const Server& server,
+                            std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    /**
+     * @brief Returns the media type for a file name, based on its extension.
+     *
+     * @return MIME type, or "application/octet-stream" when the extension is unknown.
+     */
+    static std::string_view mimeType(std::string_view path) noexcept;
+
+    /**
+     * @brief Parses a `Range` field value against a file of @p size bytes.
+     *
+     * @details Only the `bytes` unit is known. Ranges keep the request's order and
+     * their ends are clamped to the file. A malformed value, more than MAX_RANGES
+     * ranges, or ranges adding up to more than the file are ignored, as RFC 9110
+     * allows, and the whole file is sent instead.
+     *
+     * @param value  Value of the `Range` field.
+     * @param size   Size of the file.
+     * @param ranges Receives the satisfiable ranges.
+     * @return 206 if @p ranges holds any, 416 if none is satisfiable, 200 if the
+     *         field is ignored.
+     */
+    static int parseRange(std::string_view value, std::size_t size,
+                          std::pmr::vector<ByteRange>& ranges);
+
+  private:
+    FileCache&         _files;  ///< Shared with every request of this event loop.
+    AssetCache*        _assets; ///< Small-response cache, may be NULL.
+    CompressionBudget* _budget; ///< Caps compression of cached variants, may be NULL.
+
+    HttpResponse serveStatic(const HttpRequest& request, const Server& server,
+                             const Location& location, std::string_view path,
+                             std::pmr::memory_resource* memory);
+    HttpResponse serveFile(const HttpRequest&                       request,
+                           const std::shared_ptr<const CachedFile>& file, std::string_view path,
+                           const Location& location, unsigned accepted, const Server& server,
+                           std::pmr::memory_resource* memory);
+    void         applyRange(std::string_view value, const std::shared_ptr<const CachedFile>& file,
+                            std::string_view type_field, bool varies, const Server& server,
+                            HttpResponse& response, std::pmr::memory_resource* memory);
+    HttpResponse fileResponse(int status, const std::shared_ptr<const CachedFile>& file,
+                              std::string_view path, std::string_view type_field,
+                              ContentCoding coding, std::pmr::memory_resource* memory);
+    bool         compressedResponse(const std::shared_ptr<const CachedFile>& file,
+                                    std::string_view path, std::string_view type_field,
+                                    ContentCoding coding, HttpResponse& response);
+    HttpResponse buildRedirect(int status, std::string_view target,
+                               std::pmr::memory_resource* memory) const;
+    HttpResponse buildMethodNotAllowed(const Location& location, const Server& server,
+                                       std::pmr::memory_resource* memory);
+};
@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HttpScanner.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:11:48 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:11:48 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HttpScanner.hpp
+ * @brief   Declares the delimiter scanning kernels used by HttpRequestParser.
+ *
+ * @details The parser spends most of its time in three inner loops: skipping token
+ * characters up to ':' or SP, skipping a request target up to SP, and skipping a
+ * header value up to CR/LF. Each loop has a scalar implementation and, depending
+ * on the target, SSE4.2, AVX2 or NEON versions that examine 16 or 32 bytes per
+ * step. The fastest kernel supported by the running CPU is selected once at
+ * startup; every kernel returns exactly the same positions.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Identifies a scanning kernel implementation.
+ *
+ * @ingroup http
+ */
+enum class ScanKernel {
+    SCALAR, ///< Portable byte-at-a-time loops.
+    SSE42,  ///< x86 SSE4.2 (PCMPESTRI ranges) with SSSE3 token classification.
+    AVX2,   ///< x86 AVX2, 32 bytes per step.
+    NEON    ///< ARM Advanced SIMD, 16 bytes per step.
+};
+
+/**
+ * @brief Signature shared by all scanning functions.
+ *
+ * @details Returns the first index in [begin, end) whose byte stops the scan, or
+ * @p end if every byte was accepted.
+ */
+using ScanFunction = std::size_t (*)(const char* data, std::size_t begin,
+                                     std::size_t end) noexcept;
+
+/**
+ * @brief A complete set of scanning functions for one instruction set.
+ *
+ * @ingroup http
+ */
+struct HttpScanKernels {
+    ScanKernel   kind;   ///< Implementation identifier.
+    const char*  name;   ///< Human readable name, e.g. "avx2".
+    ScanFunction token;  ///< Stops at the first byte that is not an RFC 9110 tchar.
+    ScanFunction target; ///< Stops at SP, a control character or DEL.
+    ScanFunction value;  ///< Stops at a control character other than HTAB, or DEL.
+};
+
+/**
+ * @brief Returns true if the kernel is compiled in and supported by this CPU.
+ */
+bool isScanKernelSupported(ScanKernel kind) noexcept;
+
+/**
+ * @brief Returns the kernel set of a given kind.
+ *
+ * @param kind Requested implementation.
+ * @return Pointer to the kernels, or nullptr if unsupported.
+ */
+const HttpScanKernels* findScanKernels(ScanKernel kind) noexcept;
+
+/**
+ * @brief Returns the kernel set currently used by the parser.
+ */
+const HttpScanKernels& activeScanKernels() noexcept;
+
+/**
+ * @brief Forces a specific kernel, e.g. for benchmarks and tests.
+ *
+ * @param kind Requested implementation.
+ * @return False (and no change) if the kernel is unsupported.
+ */
+bool selectScanKernel(ScanKernel kind) noexcept;
+
+/**
+ * @brief Skips RFC 9110 token characters using the active kernel.
+ */
+inline std::size_t scanToken(const char* data, std::size_t begin, std::size_t end) noexcept {
+    return activeScanKernels().token(data, begin, end);
+}
+
+/**
+ * @brief Skips request-target characters using the active kernel.
+ */
+inline std::size_t scanTarget(const char* data, std::size_t begin, std::size_t end) noexcept {
+    return activeScanKernels().target(data, begin, end);
+}
+
+/**
+ * @brief Skips header field value characters using the active kernel.
+ */
+inline std::size_t scanValue(const char* data, std::size_t begin, std::size_t end) noexcept {
+    return activeScanKernels().value(data, begin, end);
+}
@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MultipartParser.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:24:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:24:13 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    MultipartParser.hpp
+ * @brief   Declares the MultipartParser class for multipart/form-data bodies.
+ *
+ * @details A multipart body (RFC 2046, section 5.1; RFC 7578) is a sequence of
+ * parts separated by a boundary line, each with its own header block. The parser
+ * works on the unconsumed bytes of a streamed body and never copies part data:
+ * it hands out slices of its input, and holds back only the few bytes at the end
+ * that could be the start of a delimiter. The caller keeps whatever was not
+ * consumed and passes it again, followed by newer bytes.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Incremental splitter of a multipart/form-data body into its parts.
+ *
+ * @ingroup http
+ */
+class MultipartParser {
+  public:
+    static constexpr std::size_t MAX_BOUNDARY = 70;   ///< Longest boundary (RFC 2046).
+    static constexpr std::size_t MAX_HEADERS  = 8192; ///< Longest header block of a part.
+
+    /**
+     * @brief Event returned by next().
+     */
+    enum class Result {
+        NEED_MORE, ///< More bytes are needed; pass the unconsumed ones again with them.
+        PART,      ///< A part starts; see getFilename().
+        DATA,      ///< Data bytes of the current part.
+        PART_END,  ///< The current part is complete.
+        DONE,      ///< The closing delimiter was read; what follows is ignored.
+        ERROR      ///< Malformed delimiter or part header block.
+    };
+
+    /**
+     * @brief Creates a parser for parts separated by @p boundary.
+     */
+    explicit MultipartParser(std::string_view boundary);
+
+    /**
+     * @brief Extracts the boundary of a `multipart/form-data` Content-Type value.
+     *
+     * @return False if the media type is another one or the boundary is missing.
+     */
+    static bool findBoundary(std::string_view content_type, std::string& boundary);
+
+    /**
+     * @brief Reads the next event from the start of @p input.
+     *
+     * @param input    Body bytes not consumed yet.
+     * @param consumed Receives how many bytes of @p input were used.
+     * @param data     Receives the part bytes of a DATA event, a slice of @p input.
+     */
+    Result next(std::string_view input, std::size_t& consumed, std::string_view& data);
+
+    /**
+     * @brief Returns the file name of the current part, empty for a plain form field.
+     *
+     * @details Taken from the `filename` parameter of its Content-Disposition, unquoted
+     * but otherwise as sent: callers must not trust it as a path.
+     */
+    const std::string& getFilename() const noexcept;
+
+  private:
+    /// Position in the body.
+    enum class State {
+        START,     ///< The body may open with the delimiter, without a CRLF before it.
+        PREAMBLE,  ///< Text before the first delimiter, ignored.
+        DELIMITED, ///< After a delimiter: "--" ends the body, CRLF starts a part.
+        HEADERS,   ///< Header block of a part.
+        BODY,      ///< Data of a part, up to the next delimiter.
+        EPILOGUE   ///< After the closing delimiter.
+    };
+
+    std::string _delimiter; ///< CRLF, "--" and the boundary.
+    State       _state;     ///< Where the input continues.
+    std::string _filename;  ///< Of the current part.
+
+    void        parseHeaders(std::string_view block);
+    std::size_t safeLength(std::string_view input) const noexcept;
+};
@@ -0,0 +1,51 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RequestRoute.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 06:11:26 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 06:11:26 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    RequestRoute.hpp
+ * @brief   Declares RequestRoute, the location a request was matched to.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include "core/Location.hpp"
+#include "core/Server.hpp"
+#include <string>
+
+/**
+ * @brief Where a request goes: its normalized path and the location it matches.
+ *
+ * @details Filled once per request by HttpResponseBuilder::route(), then handed
+ * to every resolve probe and to build(), so the path is normalized and the
+ * location table walked only once. A Connection keeps one for its current
+ * request; the path keeps its capacity from one request to the next.
+ *
+ * @ingroup http
+ */
+struct RequestRoute {
+    const Server*   server;     ///< Virtual host routed on, NULL until routed.
+    const Location* location;   ///< Longest matching location, or NULL.
+    std::string     path;       ///< Normalized URI path.
+    bool            normalized; ///< False if the path could not be normalized.
+
+    RequestRoute() noexcept : server(NULL), location(NULL), normalized(false) {}
+
+    /// Forgets the route; the next request is routed again.
+    void reset() noexcept {
+        server     = NULL;
+        location   = NULL;
+        normalized = false;
+        path.clear();
+    }
+};
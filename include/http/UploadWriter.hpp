@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UploadWriter.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:24:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:24:13 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    UploadWriter.hpp
+ * @brief   Declares the UploadWriter class, which stores request bodies in an upload store.
+ *
+ * @details Uploads are written as their bytes arrive, so memory does not grow with
+ * the body. A multipart/form-data body is split into its parts and every part that
+ * carries a file name becomes a file; any other body becomes one file. Each file is
+ * written under a temporary name and renamed into place once complete, so readers
+ * of the store never see a partial upload.
+ *
+ * @ingroup http
+ */
+
+#pragma once
+
+#include "http/MultipartParser.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Streams one request body into files of an upload directory.
+ *
+ * @ingroup http
+ */
+class UploadWriter {
+  public:
+    /**
+     * @param directory Upload store of the location; it must exist.
+     */
+    explicit UploadWriter(std::string directory);
+    ~UploadWriter(); ///< Removes the file being written, if any.
+    UploadWriter(const UploadWriter&)            = delete;
+    UploadWriter& operator=(const UploadWriter&) = delete;
+
+    /**
+     * @brief Prepares for a body of the given Content-Type.
+     *
+     * @param content_type Content-Type of the request; multipart bodies are split.
+     * @param name         File name for other bodies, or empty for a generated one.
+     * @return False with getStatus() set if the body cannot be stored.
+     */
+    bool start(std::string_view content_type, std::string_view name);
+
+    /**
+     * @brief Writes body bytes.
+     *
+     * @details A multipart body may leave a few bytes unconsumed, of a delimiter that
+     * is not complete yet; they must be passed again with the bytes that follow.
+     *
+     * @return Bytes consumed. getStatus() is set if writing failed.
+     */
+    std::size_t write(std::string_view data);
+
+    /**
+     * @brief Completes the uploads once the whole body was written.
+     *
+     * @return False with getStatus() set if a file could not be completed or the
+     *         multipart body is truncated or holds no file.
+     */
+    bool finish();
+
+    /**
+     * @brief Returns the HTTP status of a failed upload, 0 if none failed.
+     */
+    int getStatus() const noexcept;
+
+    /**
+     * @brief Returns the names of the stored files, in body order.
+     */
+    const std::vector<std::string>& getFiles() const noexcept;
+
+    /**
+     * @brief Returns true if @p name can be stored as a file of the directory.
+     *
+     * @details Rejects empty names, `.` and `..`, separators and control characters.
+     */
+    static bool isValidName(std::string_view name) noexcept;
+
+  private:
+    std::string                      _directory; ///< Where the files go.
+    std::unique_ptr<MultipartParser> _multipart; ///< Splits a multipart body, or NULL.
+    bool                             _done;      ///< The closing delimiter was read.
+    int                              _fd;        ///< File being written, or -1.
+    std::string                      _temp;      ///< Its temporary path.
+    std::string                      _name;      ///< Its final name, empty to derive one.
+    std::vector<std::string>         _files;     ///< Stored names.
+    int                              _status;    ///< HTTP status of a failure, or 0.
+
+    bool openFile(std::string_view name);
+    bool writeFile(std::string_view data);
+    bool commitFile();
+    void discardFile() noexcept;
+    void fail(int error) noexcept;
+};
@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BufferPool.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:39:56 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 06:07:09 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    BufferPool.hpp
+ * @brief   Declares the BufferPool of fixed-size chunks lent to busy connections.
+ *
+ * @details Most keep-alive connections are idle most of the time. Instead of each
+ * one owning a socket buffer and a request arena, connections borrow fixed-size
+ * chunks from their event loop's BufferPool while a request is in flight and
+ * give them back as soon as they are idle again. Memory then scales with the
+ * number of busy connections, not with the number of open ones.
+ *
+ * @ingroup network
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @brief Free list of equally sized chunks, exposed as a memory resource.
+ *
+ * @details Requests up to getChunkSize() bytes are served from the free list and
+ * always take a whole chunk; larger ones (a big request body, a grown arena) go
+ * to the upstream resource and do not count as pool traffic. Freed chunks are
+ * kept for reuse up to a limit, beyond which they are returned upstream, so a
+ * burst does not pin its peak memory forever. Not thread-safe: each event loop
+ * owns one pool, and copies its counters into its WorkerStats for the stats
+ * endpoint.
+ *
+ * @ingroup network
+ */
+class BufferPool : public std::pmr::memory_resource {
+  public:
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 16384; ///< One socket read.
+    static constexpr std::size_t DEFAULT_MAX_IDLE   = 1024;  ///< Free chunks kept (16 MiB).
+
+    /**
+     * @brief Creates an empty pool; chunks are allocated on demand.
+     *
+     * @param chunk_size Size of every chunk.
+     * @param max_idle   Free chunks kept for reuse before returning them upstream.
+     * @param upstream   Source of chunks and of oversized allocations.
+     */
+    explicit BufferPool(std::size_t                chunk_size = DEFAULT_CHUNK_SIZE,
+                        std::size_t                max_idle   = DEFAULT_MAX_IDLE,
+                        std::pmr::memory_resource* upstream   = std::pmr::new_delete_resource());
+    ~BufferPool() override;
+    BufferPool(const BufferPool&)            = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    std::size_t getChunkSize() const noexcept;
+    std::size_t getInUse() const noexcept;     ///< Chunks currently lent out.
+    std::size_t getHighWater() const noexcept; ///< Most chunks ever lent out at once.
+    std::size_t getIdle() const noexcept;      ///< Free chunks ready for reuse.
+    std::size_t getHits() const noexcept;      ///< Chunk requests served from the free list.
+    std::size_t getMisses() const noexcept;    ///< Chunk requests that allocated upstream.
+
+    /**
+     * @brief Returns every free chunk to the upstream resource.
+     */
+    void trim() noexcept;
+
+  private:
+    /// A free chunk stores the link to the next one in its first bytes.
+    struct FreeChunk {
+        FreeChunk* next;
+    };
+
+    std::size_t                _chunk_size; ///< Size of every chunk.
+    std::size_t                _max_idle;   ///< Free list length limit.
+    std::pmr::memory_resource* _upstream;   ///< Where chunks come from.
+    FreeChunk*                 _free;       ///< Head of the free list.
+    std::size_t                _idle;       ///< Length of the free list.
+    std::size_t                _in_use;     ///< See getInUse().
+    std::size_t                _high_water; ///< See getHighWater().
+    std::size_t                _hits;       ///< See getHits().
+    std::size_t                _misses;     ///< See getMisses().
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void  do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    bool  isPooled(std::size_t bytes, std::size_t alignment) const noexcept;
+};
@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ByteBuffer.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:04:14 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:24:13 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    ByteBuffer.hpp
+ * @brief   Declares the ByteBuffer class used for per-connection socket input.
+ *
+ * @details ByteBuffer is a growable ring-style byte buffer. Bytes are appended at the
+ * tail and consumed from the head; consumed space is reclaimed lazily by sliding the
+ * unread bytes back to the front when the tail runs out of room. Unlike a wrapping
+ * ring, the readable region is always contiguous, which lets the HTTP parser scan it
+ * in place without stitching two halves together. Storage comes from a
+ * `std::pmr::memory_resource`, normally the event loop's BufferPool, and can be
+ * handed back with release() while the connection is idle.
+ *
+ * @ingroup network
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+
+/**
+ * @brief Contiguous, growable FIFO byte buffer.
+ *
+ * @ingroup network
+ */
+class ByteBuffer {
+  public:
+    /**
+     * @brief Creates an empty buffer; no storage is allocated until prepare().
+     *
+     * @param memory Source of the storage.
+     */
+    explicit ByteBuffer(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+    ~ByteBuffer();
+    ByteBuffer(const ByteBuffer&)            = delete;
+    ByteBuffer& operator=(const ByteBuffer&) = delete;
+
+    /**
+     * @brief Returns a pointer where at least @p min_free bytes can be written.
+     *
+     * @details Compacts the buffer or doubles its capacity when needed. Pointers
+     * previously returned by data() are invalidated by this call.
+     *
+     * @param min_free Minimum number of writable bytes required.
+     * @return Pointer to the first writable byte.
+     */
+    char* prepare(std::size_t min_free);
+
+    /**
+     * @brief Marks @p count bytes written after prepare() as readable.
+     */
+    void commit(std::size_t count) noexcept;
+
+    /**
+     * @brief Discards @p count bytes from the front of the readable region.
+     */
+    void consume(std::size_t count) noexcept;
+
+    /**
+     * @brief Removes @p count readable bytes starting @p offset bytes from the front.
+     *
+     * @details The bytes after the range slide down, so this costs a copy of them.
+     */
+    void erase(std::size_t offset, std::size_t count) noexcept;
+
+    /**
+     * @brief Drops all buffered bytes but keeps the allocated storage.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Returns the storage to its memory resource if no bytes are buffered.
+     *
+     * @return True if the buffer holds no storage afterwards.
+     */
+    bool release() noexcept;
+
+    /**
+     * @brief Returns a pointer to the first readable byte.
+     */
+    const char* data() const noexcept;
+    char*       data() noexcept; ///< Readable bytes, for decoding them in place.
+
+    /**
+     * @brief Returns the number of readable bytes.
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * @brief Returns true if no bytes are buffered.
+     */
+    bool empty() const noexcept;
+
+    /**
+     * @brief Returns the number of bytes that can be written without reallocating.
+     */
+    std::size_t writableSize() const noexcept;
+
+    /**
+     * @brief Returns the total allocated capacity in bytes.
+     */
+    std::size_t capacity() const noexcept;
+
+    /**
+     * @brief Returns the readable region as a string_view.
+     */
+    std::string_view view() const noexcept;
+
+  private:
+    std::pmr::memory_resource* _memory;   ///< Source of _storage.
+    char*                      _storage;  ///< Backing storage, or NULL.
+    std::size_t                _capacity; ///< Size of _storage in bytes.
+    std::size_t                _head;     ///< Offset of the first readable byte.
+    std::size_t                _tail;     ///< Offset one past the last readable byte.
+};
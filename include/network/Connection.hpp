@@ -0,0 +1,491 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Connection.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: irychkov <irychkov@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/05/03 13:51:47 by irychkov          #+#    #+#             */
+/*   Updated: 2025/05/12 17:41:30 by irychkov         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Connection.hpp
+ * @brief   Declares the Connection class, the per-client state machine.
+ *
+ * @details A Connection owns everything the event loop needs to serve one client
+ * socket without blocking: an input ByteBuffer that grows until a full request is
+ * available, an output queue flushed whenever the socket is writable, and an
+ * explicit state describing what the connection waits for next. The output queue
+ * holds in-memory chunks and file ranges; file ranges go from the page cache to the
+ * socket with `sendfile()`.
+ *
+ * On a TLS listener the connection owns a TlsSession: its handshake runs inside
+ * readFromSocket() and writeToSocket() before any request byte is read. Output
+ * goes through OpenSSL, unless the kernel took the encryption over (kTLS), in
+ * which case gather writes and `sendfile()` are used exactly as in plain HTTP.
+ *
+ * With a slow request threshold, each request carries a RequestTrace from its first
+ * byte until its last response byte is sent; slower ones are logged as warnings
+ * with their phases. The USDT probes of utils/Probes.hpp fire at the same points.
+ *
+ * @ingroup network
+ */
+
+#pragma once
+
+#include "core/Server.hpp"
+#include "core/VirtualHostIndex.hpp"
+#include "http/ChunkedDecoder.hpp"
+#include "http/FileCache.hpp"
+#include "http/HttpRequest.hpp"
+#include "http/HttpRequestParser.hpp"
+#include "http/HttpResponse.hpp"
+#include "http/RequestRoute.hpp"
+#include "network/BufferPool.hpp"
+#include "network/ByteBuffer.hpp"
+#include "network/TlsContext.hpp"
+#include "utils/Arena.hpp"
+#include "utils/RequestTrace.hpp"
+#include "utils/Stats.hpp"
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <sys/uio.h>
+
+/**
+ * @brief Lifecycle states of a client connection.
+ *
+ * @ingroup network
+ */
+enum class ConnectionState {
+    READING_HEADERS, ///< Waiting for the end of the request head.
+    READING_BODY,    ///< Head parsed, waiting for body bytes.
+    WRITING,         ///< Responses are queued and being flushed (parsing may continue).
+    CLOSING          ///< Nothing left to do, the socket must be closed.
+};
+
+/**
+ * @brief Outcome of a non-blocking socket operation.
+ *
+ * @ingroup network
+ */
+enum class IoStatus {
+    OK,     ///< Progress made, socket drained (read) or queue flushed (write).
+    AGAIN,  ///< Socket is not writable yet, data remains queued.
+    CLOSED, ///< Peer closed the connection.
+    ERROR   ///< Unrecoverable socket error.
+};
+
+/**
+ * @brief Non-blocking state machine for a single client socket.
+ *
+ * @details The SocketManager feeds readiness events into readFromSocket() and
+ * writeToSocket(). parseInput() runs the incremental HttpRequestParser over the input
+ * buffer, resuming where the previous read stopped, so slow clients sending a request
+ * in many small pieces cost O(request size) in total. The parsed HttpRequest points
+ * into the input buffer and is valid until finishRequest().
+ *
+ * Connections are persistent by default (HTTP/1.1 keep-alive). Several pipelined
+ * requests may sit in the input buffer at once; parseInput() keeps returning the
+ * next one while responses for earlier ones are still queued, so answers go out in
+ * request order.
+ *
+ * @ingroup network
+ */
+class Connection {
+  public:
+    static constexpr std::size_t READ_CHUNK      = 16384;   ///< Bytes requested per recv().
+    static constexpr std::size_t READ_MIN_FREE   = 4096;    ///< Free space worth another recv().
+    static constexpr std::size_t MAX_HEADER_SIZE = 8192;    ///< Longest accepted request head.
+    static constexpr std::size_t MAX_PIPELINE    = 32;      ///< Responses queued before pausing.
+    static constexpr std::size_t SENDFILE_CHUNK  = 1 << 20; ///< Largest single sendfile() call.
+    static constexpr std::size_t MAX_IOVECS      = 16;      ///< Buffers gathered per sendmsg().
+    static constexpr std::size_t STREAM_BUFFER   = 65536;   ///< Streamed body bytes buffered.
+    static constexpr std::size_t TLS_RECORD      = 16384;   ///< Largest TLS record payload.
+
+    using Clock = std::chrono::steady_clock; ///< Clock used for idle tracking.
+
+    /**
+     * @brief Wraps an accepted, non-blocking client socket.
+     *
+     * @param fd     Client socket (not owned: the SocketManager closes it).
+     * @param server Default server of the listening socket the client connected to.
+     * @param hosts  Virtual hosts used to pick the server of each request from its
+     *               `Host:` header, or NULL to always use @p server.
+     * @param pool   Event loop pool lending the input buffer and request arena,
+     *               or NULL to allocate them from the heap.
+     * @param stats  Counters of the event loop, or NULL to count nothing.
+     */
+    Connection(int fd, const Server* server, const VirtualHostIndex* hosts = NULL,
+               BufferPool* pool = NULL, WorkerStats* stats = NULL);
+    ~Connection()                            = default;
+    Connection(const Connection&)            = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    /**
+     * @brief Reads everything currently available on the socket.
+     *
+     * @details Loops on `recv()` until `EAGAIN`, as required by edge-triggered
+     * backends. Reading stops early at STREAM_BUFFER bytes while the head is not
+     * parsed yet, since its body may be streamed, and while a streamed body waits;
+     * takeReadStopped() then tells the caller to re-arm the socket.
+     *
+     * @return IoStatus::OK, IoStatus::CLOSED or IoStatus::ERROR.
+     */
+    IoStatus readFromSocket();
+
+    /**
+     * @brief Serves the connection over TLS; called right after it is accepted.
+     *
+     * @throws TlsContext::TlsError If the session cannot be created.
+     */
+    void startTls(const TlsContext& context);
+
+    bool isTls() const noexcept; ///< The connection has a TLS session.
+
+    /**
+     * @brief Sends a TLS close_notify, if the handshake completed; nothing otherwise.
+     */
+    void shutdownTls() noexcept;
+
+    /**
+     * @brief Sends as much queued output as the socket accepts.
+     *
+     * @return IoStatus::OK when the queue is empty, IoStatus::AGAIN when the socket
+     * is full, or IoStatus::ERROR.
+     */
+    IoStatus writeToSocket();
+
+    /**
+     * @brief Advances the request state machine over newly buffered input.
+     *
+     * @return True when a complete request (head and body) is available.
+     */
+    bool parseInput();
+
+    /**
+     * @brief Returns true once per request, the first time its head is available.
+     *
+     * @details Lets the event loop route a request as soon as its head is parsed,
+     * before the body has arrived; see streamBody().
+     */
+    bool claimHead() noexcept;
+
+    /**
+     * @brief Hands the body of the current request out as it arrives.
+     *
+     * @details Drops the head from the input buffer, which invalidates the slices of
+     * getRequest(): whatever is needed from them must be copied first. bodyData()
+     * then returns the body bytes received so far and consumeBody() drops them.
+     * Reading pauses while STREAM_BUFFER bytes wait, so memory does not grow with
+     * the body. Chunked bodies come out decoded. finishRequest() ends the request
+     * once isBodyComplete(). A client that sent `Expect: 100-continue` is told to
+     * go on here.
+     *
+     * @pre claimHead() returned true for the current request.
+     */
+    void streamBody();
+
+    bool             isStreamingBody() const noexcept;
+    std::string_view bodyData() const noexcept; ///< Received body bytes not consumed yet.
+    void             consumeBody(std::size_t count) noexcept;
+    std::size_t      getBodyRemaining() const noexcept; ///< Known body bytes not consumed yet.
+    bool             isBodyComplete() const noexcept;   ///< The whole body was consumed.
+    bool             isInputPaused() const noexcept;    ///< Streamed body waits, reading stops.
+    bool             takeReadStopped() noexcept;        ///< The last read left bytes unread.
+
+    /**
+     * @brief Returns the parsed current request.
+     *
+     * @pre parseInput() returned true.
+     */
+    const HttpRequest& getRequest() const noexcept;
+
+    /**
+     * @brief Returns the head (request line and headers) of the current request.
+     *
+     * @pre parseInput() returned true.
+     */
+    std::string_view requestHead() const;
+
+    /**
+     * @brief Returns the body of the current request.
+     *
+     * @pre parseInput() returned true.
+     */
+    std::string_view requestBody() const;
+
+    /**
+     * @brief Queues response bytes and switches to the WRITING state.
+     *
+     * @param data Serialized response (or a part of it).
+     */
+    void queueOutput(std::string data);
+
+    /**
+     * @brief Queues a range of a shared buffer without copying it.
+     *
+     * @details Used for cached responses: the connection keeps @p buffer alive until
+     * the range is sent. Consecutive in-memory chunks go out in one gather write.
+     *
+     * @param buffer Immutable bytes, shared with other connections.
+     * @param offset First byte of the range.
+     * @param length Number of bytes to send.
+     */
+    void queueShared(std::shared_ptr<const std::string> buffer, std::size_t offset,
+                     std::size_t length);
+
+    /**
+     * @brief Queues bytes that are sent without being copied.
+     *
+     * @param bytes Bytes to send; they must stay valid until sent.
+     * @param owner Keeps @p bytes alive until then; NULL for static storage.
+     */
+    void queueBorrowed(std::string_view bytes, std::shared_ptr<const void> owner = NULL);
+
+    /**
+     * @brief Queues every segment of a response; see HttpResponse::takeSegments().
+     *
+     * @details With stats, the response is counted by status, and its first and last
+     * bytes leaving the socket are timed from the start of the current request.
+     *
+     * @param response  Response to send; its in-memory body is moved out.
+     * @param head_only True for HEAD requests: the body is left out.
+     */
+    void queueResponse(HttpResponse& response, bool head_only);
+
+    /**
+     * @brief Queues a byte range of a file, sent without copying it into user space.
+     *
+     * @details The connection keeps @p file alive until the range is sent. If the
+     * file turns out to be shorter than announced, writeToSocket() reports
+     * IoStatus::ERROR: the promised Content-Length can no longer be honored.
+     *
+     * @param file   Open regular file.
+     * @param offset First byte to send.
+     * @param length Number of bytes to send.
+     */
+    void queueFile(std::shared_ptr<const CachedFile> file, off_t offset, std::size_t length);
+
+    /**
+     * @brief Drops the current request from the input buffer.
+     */
+    void finishRequest();
+
+    /**
+     * @brief Marks the connection for closing once the output queue is flushed.
+     */
+    void closeAfterWrite() noexcept;
+
+    /**
+     * @brief Returns true if response bytes, or handshake bytes, wait to be sent.
+     */
+    bool hasPendingOutput() const noexcept;
+
+    /**
+     * @brief Returns true if the connection must be closed after the pending output.
+     */
+    bool shouldClose() const noexcept;
+
+    /**
+     * @brief Returns the HTTP status of a protocol error detected while parsing, or 0.
+     */
+    int getErrorStatus() const noexcept;
+
+    /**
+     * @brief Returns the pending protocol error status and clears it.
+     *
+     * @details Used by the event loop to answer the error exactly once. The
+     * connection stays marked for closing.
+     */
+    int takeErrorStatus() noexcept;
+
+    /**
+     * @brief Returns true if the current request allows the connection to persist.
+     *
+     * @details HTTP/1.1 defaults to keep-alive unless `Connection: close` is sent;
+     * HTTP/1.0 requires an explicit `Connection: keep-alive`.
+     *
+     * @pre parseInput() returned true.
+     */
+    bool wantsKeepAlive() const noexcept;
+
+    /**
+     * @brief Returns true if enough responses are queued to stop parsing for now.
+     */
+    bool isPipelineFull() const noexcept;
+
+    /**
+     * @brief Returns the number of requests answered on this connection so far.
+     */
+    std::size_t getRequestCount() const noexcept;
+
+    /**
+     * @brief Returns the time of the last socket activity.
+     */
+    Clock::time_point getLastActivity() const noexcept;
+
+    /**
+     * @brief Returns when the first byte of the next request head arrived.
+     *
+     * @details Before any byte of it arrived, the time the wait for it began: the
+     * connection's creation, or the end of the previous request.
+     */
+    Clock::time_point getHeadStart() const noexcept;
+
+    bool hasBufferedInput() const noexcept; ///< Received bytes are not consumed yet.
+
+    int getFd() const noexcept;
+
+    /**
+     * @brief Returns the per-request memory of this connection.
+     *
+     * @details The event loop rewinds it before building each response, so it must
+     * only hold objects that die with the response: header fields and temporary
+     * paths. Queued output never lives in it.
+     */
+    Arena& getArena() noexcept;
+
+    /**
+     * @brief Returns the route of the current request.
+     *
+     * @details Empty (no server) until the event loop routes the request, and
+     * emptied again by finishRequest(). A head being parsed keeps the connection
+     * on its configuration, so the route stays valid for the whole request.
+     */
+    RequestRoute& getRoute() noexcept;
+
+    /**
+     * @brief Hands the input buffer and arena storage back while nothing is in flight.
+     *
+     * @details An idle keep-alive connection then holds no buffer memory at all; the
+     * next read borrows it again.
+     *
+     * @return True if the connection was idle and its memory was released.
+     */
+    bool releaseIdleMemory() noexcept;
+
+    /**
+     * @brief Returns the server answering the current request.
+     *
+     * @details Set to the virtual host selected by the last parsed request head;
+     * the listening socket's default server before the first one is parsed.
+     */
+    const Server*   getServer() const noexcept;
+    ConnectionState getState() const noexcept;
+
+    /**
+     * @brief Moves the connection onto another configuration between two requests.
+     *
+     * @details The next request head picks its virtual host from @p hosts. Nothing
+     * changes while a request head is parsed or its body streams, so the request in
+     * flight finishes with the servers it started with.
+     *
+     * @param server Default server of the listening socket in the new configuration.
+     * @param hosts  Virtual hosts of the new configuration, or NULL.
+     * @return False if a request is in flight and the connection kept its servers.
+     */
+    bool rebind(const Server* server, const VirtualHostIndex* hosts) noexcept;
+    void            setState(ConnectionState state) noexcept;
+
+    /**
+     * @brief Traces the phases of each request and logs those slower than @p threshold.
+     *
+     * @details Called after construction and whenever the configuration changes.
+     * Zero turns tracing off and frees its state: the clock is then read no more
+     * often than without it. Slow requests are also counted in WorkerStats.
+     */
+    void traceSlowRequests(Clock::duration threshold);
+
+    /**
+     * @brief Marks the current request routed: its location matched, its handler starts.
+     */
+    void markRouted() noexcept;
+
+  private:
+    /**
+     * @brief One entry of the output queue: owned bytes, borrowed bytes, or a file range.
+     */
+    struct OutputChunk {
+        std::string                       data;      ///< Owned bytes, if bytes and file are NULL.
+        const char*                       bytes;     ///< Borrowed bytes, or NULL.
+        std::shared_ptr<const void>       owner;     ///< Keeps borrowed bytes alive, or NULL.
+        std::shared_ptr<const CachedFile> file;      ///< File to send from, or NULL.
+        off_t                             offset;    ///< Next byte to send.
+        std::size_t                       remaining; ///< Bytes still to send.
+    };
+
+    /**
+     * @brief A queued response being timed, located by its offsets in the output stream.
+     */
+    struct Timing {
+        Clock::time_point start;   ///< First byte of its request head.
+        std::uint64_t     begin;   ///< Stream offset of its first byte.
+        std::uint64_t     end;     ///< Stream offset just past its last byte.
+        std::uint16_t     status;  ///< Response status.
+        bool              started; ///< Its first byte was sent.
+        bool              traced;  ///< Its RequestTrace is in Tracing::queued.
+    };
+
+    /**
+     * @brief Phase marks of the requests in flight, allocated while tracing is on.
+     */
+    struct Tracing {
+        Clock::duration          threshold; ///< Requests taking longer are logged.
+        RequestTrace             reading;   ///< Request being read and parsed.
+        RequestTrace             answering; ///< Finished reading, response not queued yet.
+        std::deque<RequestTrace> queued;    ///< Of traced Timing entries, in queue order.
+    };
+
+    int                     _fd;             ///< Client socket.
+    const Server*           _listen_server;  ///< Default server of the listening socket.
+    const VirtualHostIndex* _hosts;          ///< Name-based virtual hosts, may be NULL.
+    const Server*           _server;         ///< Server answering the current request.
+    ConnectionState         _state;          ///< Current state machine position.
+    ByteBuffer              _input;          ///< Bytes received but not yet consumed.
+    HttpRequestParser       _parser;         ///< Resumable parser for the current head.
+    HttpRequest             _request;        ///< Slices of the current request.
+    std::size_t             _head_length;    ///< Request head size including CRLFCRLF.
+    std::size_t             _body_length;    ///< Body bytes not consumed, decoded if chunked.
+    bool                    _chunked;        ///< Body uses the chunked transfer coding.
+    bool                    _body_done;      ///< The last chunk was decoded.
+    std::size_t             _body_received;  ///< Decoded chunked bytes, for the size limit.
+    ChunkedDecoder          _dechunk;        ///< Framing state of a chunked body.
+    bool                    _head_claimed;   ///< claimHead() reported the current head.
+    bool                    _streaming;      ///< Body is handed out, see streamBody().
+    bool                    _read_stopped;   ///< The last read stopped before EAGAIN.
+    std::deque<OutputChunk> _output;         ///< Queued response chunks.
+    bool                    _close_after;    ///< Close once the output queue drains.
+    int                     _error_status;   ///< Protocol error status, 0 if none.
+    std::size_t             _requests;       ///< Requests completed on this connection.
+    Clock::time_point       _last_activity;  ///< Last successful read or write.
+    Clock::time_point       _head_start;     ///< See getHeadStart().
+    Arena                   _arena;          ///< Per-request allocations.
+    RequestRoute            _route;          ///< See getRoute().
+    WorkerStats*            _stats;          ///< Counters of the event loop, may be NULL.
+    std::uint64_t           _queued;         ///< Bytes ever queued for output.
+    std::uint64_t           _sent;           ///< Bytes ever sent.
+    Timing                  _timings[MAX_PIPELINE]; ///< Responses being timed, a ring.
+    std::size_t             _timing_first;   ///< Oldest entry of _timings.
+    std::size_t             _timing_count;   ///< Entries in use.
+    std::unique_ptr<TlsSession> _tls;        ///< TLS session, or NULL for plain HTTP.
+    std::unique_ptr<Tracing>    _tracing;    ///< Request phases, or NULL if not traced.
+
+    void     decodeChunks() noexcept;
+    void     fail(int status) noexcept;
+    IoStatus sendFileChunk(OutputChunk& chunk);
+    IoStatus sendMemoryChunks();
+    IoStatus continueHandshake();
+    ssize_t  receive(char* buffer, std::size_t size);
+    ssize_t  sendBytes(const void* buffer, std::size_t size);
+    ssize_t  sendTlsRecord(const struct iovec* iov, std::size_t count);
+    bool     hasTlsPending() const noexcept;
+    void     countSent(std::size_t bytes, Clock::time_point now) noexcept;
+    void     mark(TracePhase phase) noexcept;
+    void     finishTrace(Clock::time_point now) noexcept;
+};
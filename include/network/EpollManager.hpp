@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   EpollManager.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:00:35 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:00:35 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    EpollManager.hpp
+ * @brief   Declares the edge-triggered epoll event backend.
+ *
+ * @details Only compiled on Linux. Descriptors are registered with `EPOLLET`, so the
+ * kernel reports each readiness transition once and the caller drains the socket.
+ *
+ * @ingroup network
+ */
+
+#pragma once
+
+#if defined(__linux__)
+
+#include "network/PollManager.hpp"
+#include <sys/epoll.h>
+#include <vector>
+
+/**
+ * @brief Linux epoll(7) implementation of PollManager.
+ *
+ * @ingroup network
+ */
+class EpollManager : public PollManager {
+  public:
+    /**
+     * @brief Creates the epoll instance.
+     *
+     * @throws PollManager::PollError If `epoll_create1()` fails.
+     */
+    EpollManager();
+
+    /**
+     * @brief Closes the epoll instance.
+     */
+    ~EpollManager() override;
+
+    void        add(int fd, std::uint32_t interest) override;
+    void        modify(int fd, std::uint32_t interest) override;
+    void        remove(int fd) noexcept override;
+    int         wait(std::vector<IoEvent>& ready, int timeout_ms) override;
+    const char* name() const noexcept override;
+
+  private:
+    int                      _epoll_fd; ///< Descriptor returned by epoll_create1().
+    std::vector<epoll_event> _events;   ///< Kernel output buffer, grows with load.
+    std::size_t              _watched;  ///< Number of registered descriptors.
+
+    void control(int op, int fd, std::uint32_t interest);
+};
+
+#endif
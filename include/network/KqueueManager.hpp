@@ -0,0 +1,68 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   KqueueManager.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:00:35 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:00:35 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    KqueueManager.hpp
+ * @brief   Declares the kqueue event backend.
+ *
+ * @details Only compiled on BSD and macOS. Filters are registered with `EV_CLEAR`,
+ * which gives the same edge-triggered semantics as the epoll backend.
+ *
+ * @ingroup network
+ */
+
+#pragma once
+
+#if defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) ||                   \
+    defined(__NetBSD__) || defined(__DragonFly__)
+
+#define WEBSERV_HAVE_KQUEUE 1
+
+#include "network/PollManager.hpp"
+#include <sys/event.h>
+#include <vector>
+
+/**
+ * @brief BSD kqueue(2) implementation of PollManager.
+ *
+ * @ingroup network
+ */
+class KqueueManager : public PollManager {
+  public:
+    /**
+     * @brief Creates the kqueue instance.
+     *
+     * @throws PollManager::PollError If `kqueue()` fails.
+     */
+    KqueueManager();
+
+    /**
+     * @brief Closes the kqueue instance.
+     */
+    ~KqueueManager() override;
+
+    void        add(int fd, std::uint32_t interest) override;
+    void        modify(int fd, std::uint32_t interest) override;
+    void        remove(int fd) noexcept override;
+    int         wait(std::vector<IoEvent>& ready, int timeout_ms) override;
+    const char* name() const noexcept override;
+
+  private:
+    int                        _kqueue_fd; ///< Descriptor returned by kqueue().
+    std::vector<struct kevent> _events;    ///< Kernel output buffer.
+    std::vector<std::uint32_t> _interest;  ///< Current interest, indexed by fd.
+    std::size_t                _watched;   ///< Number of registered descriptors.
+
+    void apply(int fd, std::uint32_t previous, std::uint32_t interest);
+};
+
+#endif
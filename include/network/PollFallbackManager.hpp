@@ -0,0 +1,54 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PollFallbackManager.hpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:00:35 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:00:35 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    PollFallbackManager.hpp
+ * @brief   Declares the portable poll() event backend.
+ *
+ * @details Used when neither epoll nor kqueue is available, or when explicitly
+ * requested. The kernel still scans every registered descriptor, but only ready
+ * descriptors are handed back to the event loop.
+ *
+ * @ingroup network
+ */
+
+#pragma once
+
+#include "network/PollManager.hpp"
+#include <poll.h>
+#include <vector>
+
+/**
+ * @brief Level-triggered poll(2) implementation of PollManager.
+ *
+ * @details Keeps a dense `pollfd` array plus an fd-indexed slot table, so
+ * registration and removal are O(1) (removal swaps the last entry into the hole).
+ *
+ * @ingroup network
+ */
+class PollFallbackManager : public PollManager {
+  public:
+    PollFallbackManager()           = default;
+    ~PollFallbackManager() override = default;
+
+    void        add(int fd, std::uint32_t interest) override;
+    void        modify(int fd, std::uint32_t interest) override;
+    void        remove(int fd) noexcept override;
+    int         wait(std::vector<IoEvent>& ready, int timeout_ms) override;
+    const char* name() const noexcept override;
+
+  private:
+    static constexpr int NO_SLOT = -1; ///< Marks an fd that is not registered.
+
+    std::vector<pollfd> _fds;  ///< Dense array passed to poll().
+    std::vector<int>    _slot; ///< Index into _fds for each fd, or NO_SLOT.
+};
@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PollManager.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: irychkov <irychkov@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/05/03 13:51:47 by irychkov          #+#    #+#             */
+/*   Updated: 2025/05/10 11:12:40 by irychkov         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    PollManager.hpp
+ * @brief   Declares the PollManager event backend interface.
+ *
+ * @details PollManager abstracts the readiness notification mechanism used by the
+ * SocketManager event loop. Concrete backends wrap `epoll` (Linux), `kqueue`
+ * (BSD/macOS), `io_uring` (Linux, when built with `WEBSERV_IO_URING`) or plain
+ * `poll()` as a portable fallback. The loop registers interest
+ * per file descriptor and receives back only the descriptors that are ready, so the
+ * cost of one iteration is proportional to the number of ready sockets rather than
+ * to the number of open connections.
+ *
+ * @ingroup network
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A single readiness notification returned by PollManager::wait().
+ *
+ * @ingroup network
+ */
+struct IoEvent {
+    int           fd;     ///< File descriptor that became ready.
+    std::uint32_t events; ///< Bitmask of PollManager::EVENT_* flags.
+};
+
+/**
+ * @brief Selects which event backend PollManager::create() instantiates.
+ *
+ * @ingroup network
+ */
+enum class PollBackend {
+    AUTO,     ///< Best backend available on this platform.
+    EPOLL,    ///< Edge-triggered epoll (Linux only).
+    KQUEUE,   ///< EV_CLEAR kqueue (BSD/macOS only).
+    POLL,     ///< Level-triggered poll(), available everywhere.
+    IO_URING  ///< Multishot poll on an io_uring (Linux, opt-in at build time).
+};
+
+/**
+ * @brief Abstract readiness notification backend.
+ *
+ * @details Interest is expressed as a bitmask of EVENT_READ / EVENT_WRITE. The
+ * epoll and kqueue backends are edge-triggered: callers must drain a descriptor
+ * (read, write or accept until `EAGAIN`) before waiting on it again. The poll()
+ * backend is level-triggered, which is compatible with the same draining logic.
+ *
+ * @ingroup network
+ */
+class PollManager {
+  public:
+    static constexpr std::uint32_t EVENT_READ  = 1U << 0; ///< Descriptor is readable.
+    static constexpr std::uint32_t EVENT_WRITE = 1U << 1; ///< Descriptor is writable.
+    static constexpr std::uint32_t EVENT_ERROR = 1U << 2; ///< Error condition reported.
+    static constexpr std::uint32_t EVENT_HUP   = 1U << 3; ///< Peer hung up.
+
+    PollManager()                              = default;
+    virtual ~PollManager()                     = default;
+    PollManager(const PollManager&)            = delete;
+    PollManager& operator=(const PollManager&) = delete;
+
+    /**
+     * @brief Starts monitoring a file descriptor.
+     *
+     * @param fd       Descriptor to register.
+     * @param interest Bitmask of EVENT_READ / EVENT_WRITE.
+     * @throws PollManager::PollError If the kernel rejects the registration.
+     */
+    virtual void add(int fd, std::uint32_t interest) = 0;
+
+    /**
+     * @brief Replaces the interest set of an already registered descriptor.
+     *
+     * @param fd       Registered descriptor.
+     * @param interest New bitmask of EVENT_READ / EVENT_WRITE.
+     * @throws PollManager::PollError If the kernel rejects the change.
+     */
+    virtual void modify(int fd, std::uint32_t interest) = 0;
+
+    /**
+     * @brief Stops monitoring a file descriptor.
+     *
+     * @details Must be called before the descriptor is closed. Unknown descriptors
+     * are ignored.
+     *
+     * @param fd Descriptor to unregister.
+     */
+    virtual void remove(int fd) noexcept = 0;
+
+    /**
+     * @brief Blocks until at least one descriptor is ready or the timeout expires.
+     *
+     * @param ready      Output vector, cleared and filled with ready descriptors.
+     * @param timeout_ms Maximum wait in milliseconds, or -1 to wait indefinitely.
+     * @return Number of events stored in @p ready (0 on timeout or signal).
+     * @throws PollManager::PollError On unrecoverable backend failure.
+     */
+    virtual int wait(std::vector<IoEvent>& ready, int timeout_ms) = 0;
+
+    /**
+     * @brief Returns a short human readable backend name (e.g. "epoll").
+     */
+    virtual const char* name() const noexcept = 0;
+
+    /**
+     * @brief Instantiates an event backend.
+     *
+     * @param backend Requested backend, or PollBackend::AUTO for the best available.
+     * @return Owning pointer to the backend.
+     * @throws PollManager::PollError If the backend is unavailable or fails to initialize.
+     */
+    static std::unique_ptr<PollManager> create(PollBackend backend = PollBackend::AUTO);
+
+    /**
+     * @brief Custom exception class for event backend errors.
+     */
+    class PollError : public std::exception {
+      private:
+        std::string _msg;
+
+      public:
+        explicit PollError(const std::string& msg);
+        const char* what() const throw() override;
+    };
+};
@@ -0,0 +1,37 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SocketAddress.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:25:50 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:25:50 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    SocketAddress.hpp
+ * @brief   Declares the parser of backend addresses used by FastCGI and the proxy.
+ *
+ * @ingroup network
+ */
+
+#pragma once
+
+#include <string_view>
+#include <sys/socket.h>
+
+/**
+ * @brief Parses a backend address without touching the network.
+ *
+ * @details Accepts `host:port` with a numeric IPv4 host or `localhost`, and
+ * `unix:/path` for a Unix socket. Host names are refused: resolving them would
+ * block the event loop.
+ *
+ * @param address Address as written in the configuration.
+ * @param addr    Receives the socket address.
+ * @param length  Receives the size of @p addr in use.
+ * @return False if the address is malformed.
+ */
+bool parseSocketAddress(std::string_view address, sockaddr_storage& addr, socklen_t& length);
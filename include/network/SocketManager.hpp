@@ -6,7 +6,7 @@
 /*   By: irychkov <irychkov@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/05/03 13:51:47 by irychkov          #+#    #+#             */
-/*   Updated: 2025/05/03 15:24:06 by irychkov         ###   ########.fr       */
+/*   Updated: 2025/05/10 11:12:40 by irychkov         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,22 +15,56 @@
  * @brief   Declares the SocketManager class responsible for managing server sockets.
  *
  * @details The SocketManager sets up listening sockets, handles incoming client connections,
- * and manages client I/O using non-blocking `poll()`. It supports multiple server blocks
- * listening on different ports and performs proper cleanup on shutdown.
- * 
+ * and manages client I/O through a pluggable PollManager event backend (epoll, kqueue or
+ * poll()). It supports multiple server blocks listening on different ports and performs
+ * proper cleanup on shutdown. Each client has one deadline in a TimerWheel, for whatever
+ * it waits on: its head, its body, its next request, its script or the drain of its
+ * output. The earliest deadline bounds the wait for events, so idle loops sleep.
+ *
+ * A new configuration handed to reload() is applied between two loop iterations.
+ * Listeners whose address is still configured are kept, and clients move to the
+ * new configuration between two requests, so a reload drops no connection.
+ *
+ * A loop built on a thread pinned to one CPU marks its `SO_REUSEPORT` listeners
+ * with `SO_INCOMING_CPU`. Linux 6.2 and later then hand it the connections whose
+ * packets that CPU received, so the NIC queue, the softirq and the loop share
+ * one core. `listen ... busy_poll=N` sets `SO_BUSY_POLL` on a listener, which
+ * accepted sockets inherit.
+ *
  * @ingroup network
  */
 
 #pragma once
 
+#include "cgi/CgiOutputParser.hpp"
+#include "cgi/CgiProcess.hpp"
+#include "cgi/FastCgiPool.hpp"
+#include "config/ConfigSnapshot.hpp"
+#include "core/Server.hpp"
+#include "http/AssetCache.hpp"
+#include "http/ChunkedEncoder.hpp"
+#include "http/Compression.hpp"
+#include "http/DateCache.hpp"
+#include "http/DirectoryListing.hpp"
+#include "http/FileCache.hpp"
+#include "http/HttpResponseBuilder.hpp"
+#include "http/UploadWriter.hpp"
+#include "network/BufferPool.hpp"
+#include "network/Connection.hpp"
+#include "network/PollManager.hpp"
+#include "network/TimerWheel.hpp"
+#include "network/UpstreamPool.hpp"
+#include "utils/Stats.hpp"
+#include <arpa/inet.h>
+#include <atomic>
+#include <fcntl.h>
 #include <iostream>
-#include <vector>
-#include <map>
-#include <poll.h>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <unistd.h>
-#include <fcntl.h>
-#include <arpa/inet.h>
-#include "core/Server.hpp"
+#include <unordered_map>
+#include <vector>
 
 /**
  * @defgroup network Networking
@@ -43,71 +77,547 @@
  *
  * @details The SocketManager is responsible for initializing listening sockets based on
  * configured Server objects, accepting new client connections, and processing I/O events
- * via the `poll()` syscall in a non-blocking manner. It maps file descriptors to their
+ * reported by the PollManager backend in a non-blocking manner. Each loop iteration only
+ * visits the descriptors the backend reports as ready. It maps file descriptors to their
  * corresponding server configurations and handles each client request accordingly.
  *
  * @ingroup network
  */
 class SocketManager {
 
-	public:
-		SocketManager( void ) = delete;
-		/**
-		 * @brief Constructs a SocketManager with the given server configurations.
-		 *
-		 * @param servers A vector of Server objects representing the server configurations.
-		 */
-		SocketManager( const std::vector<Server>& servers );
-		/**
-		 * @brief Destructor that closes all open file descriptors.
-		 */
-		~SocketManager( void );
-		SocketManager( const SocketManager& other ) = default;
-		SocketManager& operator=( const SocketManager& other ) = default;
-
-		/**
-		 * @brief Starts the server loop, handling I/O using poll().
-		 *
-		 * @details Accepts new clients and handles data from existing ones.
-		 * Will exit cleanly on signal (e.g. SIGINT).
-		 */
-		void run();
-		/**
-		 * @brief Custom exception class for socket-related errors.
-		 *
-		 * @details Inherits from std::exception and provides a custom error message.
-		 */
-		class SocketError : public std::exception
-		{
-			private:
-				std::string _msg;
-			public:
-				explicit SocketError(const std::string& msg);
-				virtual const char* what() const throw();
-		};
-
-	private:
-		std::vector<pollfd> _poll_fds;		///< Monitored file descriptors for poll().
-		std::map<int, Server> _listen_map;	///< Maps listening socket fds to their corresponding server configurations.
-		std::map<int, Server> _client_map;	///< Maps client fds to their corresponding server configurations.
-
-		/**
-		 * @brief Initializes all listening sockets for the provided servers.
-		 *
-		 * @param servers A vector of server configurations.
-		 */
-		void setupSockets( const std::vector<Server>& servers );
-		/**
-		 * @brief Accepts a new client connection and adds it to the poll list.
-		 *
-		 * @param listen_fd File descriptor of the listening socket.
-		 */
-		void handleNewConnection( int listen_fd );
-		/**
-		 * @brief Reads from a client socket, generates a response, and sends it.
-		 *
-		 * @param client_fd File descriptor of the connected client.
-		 * @param index Index of the fd in the `_poll_fds` vector.
-		 */
-		void handleClientData( int client_fd, size_t index );
+  public:
+    SocketManager(void) = delete;
+    /**
+     * @brief Constructs a SocketManager serving the given configuration snapshot.
+     *
+     * @param config     Immutable configuration shared with every connection.
+     * @param backend    Event backend to use (defaults to the best one for the platform).
+     * @param reuse_port Bind listeners with `SO_REUSEPORT`, so that several workers can
+     *                   each own a listening socket on the same address and the kernel
+     *                   balances new connections between them.
+     * @param stats      Counters of every loop of the server, or NULL for a registry
+     *                   of this loop alone. `stats` locations render all of them.
+     * @param stats_slot Block of @p stats this loop writes.
+     * @throws SocketManager::SocketError If a listener cannot be set up.
+     */
+    SocketManager(std::shared_ptr<const ConfigSnapshot> config,
+                  PollBackend backend = PollBackend::AUTO, bool reuse_port = false,
+                  std::shared_ptr<StatsRegistry> stats = NULL, std::size_t stats_slot = 0);
+    /**
+     * @brief Destructor that closes all open file descriptors.
+     */
+    ~SocketManager(void);
+    SocketManager(const SocketManager& other)            = delete;
+    SocketManager& operator=(const SocketManager& other) = delete;
+
+    /**
+     * @brief Starts the server loop, dispatching events reported by the backend.
+     *
+     * @details Accepts new clients and handles data from existing ones until stop()
+     * is called. Signals are handled by the caller (see Webserv).
+     */
+    void run();
+
+    /**
+     * @brief Makes run() return at the end of its current iteration.
+     *
+     * @details Safe to call from another thread or from a signal handler: it only
+     * sets an atomic flag and writes one byte to the loop's wake-up pipe.
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Makes the loop switch to @p config at the end of its current iteration.
+     *
+     * @details Safe to call from another thread. Requests in flight finish with the
+     * configuration they started with; each client takes the new one for its next
+     * request. Listeners are diffed by address: kept ones continue to accept, the
+     * others are closed or opened. A listener that fails to open is logged and
+     * skipped. The backend and the asset cache size are not changed.
+     *
+     * @param config Snapshot to serve from now on.
+     */
+    void reload(std::shared_ptr<const ConfigSnapshot> config);
+
+    /**
+     * @brief Returns the configuration new requests are served with.
+     *
+     * @details Only call it from the loop's own thread.
+     */
+    const std::shared_ptr<const ConfigSnapshot>& getConfig() const noexcept;
+
+    /**
+     * @brief Returns the counters this loop writes.
+     */
+    const WorkerStats& getStats() const noexcept;
+
+    /**
+     * @brief Custom exception class for socket-related errors.
+     *
+     * @details Inherits from std::exception and provides a custom error message.
+     */
+    class SocketError : public std::exception {
+      private:
+        std::string _msg;
+
+      public:
+        explicit SocketError(const std::string& msg);
+        virtual const char* what() const throw();
+    };
+
+  private:
+    /**
+     * @brief Lifecycle of an entry in the fd-indexed client table.
+     */
+    enum class SlotState {
+        FREE,   ///< No client uses this fd.
+        OPEN,   ///< Connected client, events are dispatched.
+        CLOSING ///< Tombstone: closed this iteration, fd released at the end of it.
+    };
+
+    /**
+     * @brief CGI script answering the current request of a client.
+     */
+    struct CgiRun {
+        std::unique_ptr<CgiProcess>     process;         ///< Child and its pipes, or NULL.
+        std::unique_ptr<FastCgiStream>  stream;          ///< Request on a FastCGI backend, or NULL.
+        std::unique_ptr<UpstreamStream> proxy;           ///< Request forwarded upstream, or NULL.
+        CgiChannel*                     channel;         ///< Whichever of the three is set.
+        CgiOutputParser                 parser;          ///< Header block of its output.
+        ChunkedEncoder                  encoder;         ///< Frames the body when chunked.
+        const Location*                 location;        ///< Counts against this location's limit.
+        bool                            keep_alive;      ///< Connection kept after the response.
+        bool                            head_only;       ///< HEAD request: the body is not sent.
+        bool                            chunked_ok;      ///< Client understands chunked coding.
+        bool                            head_sent;       ///< Response head is queued.
+        bool                            chunked;         ///< Body goes out with chunked coding.
+        bool                            has_length;      ///< Body length announced by the script.
+        bool                            no_body;         ///< Body is dropped (HEAD, 204, 304).
+        std::size_t                     body_left;       ///< Announced bytes not sent yet.
+        unsigned                        accepted_codings; ///< From the request's Accept-Encoding.
+        std::unique_ptr<Compressor>     compressor;      ///< Encodes the body, or NULL.
+        std::uint32_t                   input_interest;  ///< Registered interest of stdin's pipe.
+        std::uint32_t                   output_interest; ///< Registered interest of stdout's pipe.
+    };
+
+    /**
+     * @brief Request body being stored in an upload directory.
+     */
+    struct UploadRun {
+        UploadWriter writer;     ///< Files being written.
+        std::string  base_uri;   ///< URI path of the upload directory, ending with '/'.
+        bool         keep_alive; ///< Connection persists after the response.
+
+        explicit UploadRun(const std::string& directory) : writer(directory), keep_alive(false) {}
+    };
+
+    /**
+     * @brief Autoindex request waiting for its directory to be listed.
+     */
+    struct ListingRun {
+        const DirectoryScan* scan;       ///< Scan the request waits on.
+        const Location*      location;   ///< Location of the directory.
+        std::string          path;       ///< Normalized URI path of the directory.
+        bool                 keep_alive; ///< Connection persists after the response.
+        bool                 head_only;  ///< HEAD request: the body is not sent.
+    };
+
+    /**
+     * @brief Directory being listed step by step, and the clients waiting for it.
+     */
+    struct PendingScan {
+        std::unique_ptr<DirectoryScan> scan;    ///< Advanced once per loop iteration.
+        std::vector<int>               clients; ///< Fds of the waiting clients.
+    };
+
+    /**
+     * @brief Entry of the client table, indexed by file descriptor.
+     */
+    struct ClientSlot {
+        SlotState                   state       = SlotState::FREE; ///< Lifecycle state.
+        std::unique_ptr<Connection> conn;                          ///< Client state machine.
+        std::uint32_t               interest    = 0;     ///< Registered PollManager interest.
+        bool                        read_closed = false; ///< Peer shut down its side.
+        std::unique_ptr<CgiRun>     cgi;                 ///< Script answering, or NULL.
+        std::unique_ptr<UploadRun>  upload;              ///< Upload being stored, or NULL.
+        std::unique_ptr<ListingRun> listing;             ///< Listing waited for, or NULL.
+        const ConfigSnapshot*       config = NULL;       ///< Snapshot its Connection points into.
+    };
+
+    /// Replaced snapshot that clients still point into.
+    struct RetiredConfig {
+        std::shared_ptr<const ConfigSnapshot> config;  ///< Kept alive for those clients.
+        std::size_t                           clients; ///< Clients still on it.
+    };
+
+    /// Finished script that has not exited yet, reaped by the periodic sweep.
+    struct ExitingCgi {
+        std::unique_ptr<CgiProcess>   process; ///< Child, pipes already closed.
+        Connection::Clock::time_point since;   ///< When its output ended.
+    };
+
+    std::shared_ptr<const ConfigSnapshot> _config;     ///< Runtime configuration.
+    std::unique_ptr<PollManager>          _poller;     ///< Readiness notification backend.
+    FastCgiPool                           _fastcgi;    ///< Backend connections; outlives _clients.
+    UpstreamPool                          _upstreams;  ///< Proxy connections; outlives _clients.
+    std::vector<IoEvent>                  _ready;      ///< Events returned by the last wait().
+    std::vector<const Server*>            _listeners;  ///< Listener fd -> server, or nullptr.
+    std::vector<int>                      _listen_fds; ///< Open listening sockets.
+    std::vector<std::string>              _endpoints;  ///< "host:port" of each _listen_fds entry.
+    BufferPool                            _buffers;    ///< Chunks lent to busy connections.
+    std::vector<ClientSlot>               _clients;    ///< Client table indexed by fd.
+    std::vector<int>                      _closing;    ///< Tombstoned fds awaiting release.
+    std::size_t                           _active;     ///< Number of OPEN client slots.
+    bool                                  _accepting;  ///< Listeners have read interest.
+    bool                                  _out_of_fds; ///< Paused by EMFILE or ENFILE.
+    Connection::Clock::time_point         _fd_retry;   ///< When _out_of_fds listeners retry.
+    TimerWheel                            _timers;     ///< Client deadlines, keyed by fd.
+    std::vector<std::size_t>              _expired;    ///< Scratch list of expired fds.
+    Connection::Clock::time_point         _last_sweep; ///< Last sweep of exiting scripts.
+    bool                                  _reuse_port; ///< Listeners use SO_REUSEPORT.
+    int                                   _incoming_cpu; ///< Pinned CPU of the loop, or -1.
+    std::atomic<bool>                     _stopping;   ///< Set by stop().
+    int                                   _wake_fds[2]; ///< Self-pipe waking wait().
+    FileCache                             _files;      ///< Open static files of this loop.
+    AssetCache                            _assets;     ///< Serialized small responses.
+    ListingCache                          _listings;   ///< Rendered autoindex listings.
+    std::vector<PendingScan>              _scans;      ///< Directories being listed.
+    DateCache                             _date;       ///< Date field of this loop.
+    CompressionBudget                     _compression; ///< CPU share spent compressing.
+    HttpResponseBuilder                   _builder;    ///< Routes requests to responses.
+    std::vector<int>                      _pipe_owner; ///< CGI pipe fd -> client fd, or -1.
+    std::unordered_map<const Location*, std::size_t> _cgi_running; ///< Scripts per location.
+    std::vector<ExitingCgi>                          _exiting;     ///< Scripts left to reap.
+    std::vector<int>                                 _woken;       ///< Owners of woken streams.
+    std::shared_ptr<StatsRegistry>                   _registry;    ///< Counters of every loop.
+    WorkerStats*                                     _stats;       ///< This loop's block of them.
+    std::size_t                                      _config_clients; ///< Clients on _config.
+    std::vector<RetiredConfig>                       _retired; ///< Older snapshots still in use.
+    std::mutex                                       _reload_mutex;   ///< Guards _pending.
+    std::shared_ptr<const ConfigSnapshot>            _pending;        ///< Set by reload().
+    std::atomic<bool>                                _reload_pending; ///< _pending is set.
+
+    /**
+     * @brief Initializes all listening sockets for the servers of the snapshot.
+     */
+    void setupSockets();
+    /**
+     * @brief Opens, binds and registers the listening socket of one server.
+     *
+     * @throws SocketManager::SocketError If the socket cannot be set up.
+     */
+    void openListener(const Server& server);
+    void setListenerOptions(int fd, const Server& server);
+    /**
+     * @brief Switches to the snapshot passed to reload() and diffs the listeners.
+     */
+    void applyReload();
+    /**
+     * @brief Moves a client onto the current snapshot if no request is in flight.
+     *
+     * @details A client whose port is no longer configured stays on its snapshot
+     * until it closes.
+     */
+    void rebindClient(ClientSlot& client);
+    /**
+     * @brief Drops a client's hold on its snapshot; a retired one dies with its last client.
+     */
+    void leaveConfig(const ConfigSnapshot* config) noexcept;
+    /**
+     * @brief Creates the non-blocking self-pipe used by stop() and registers it.
+     */
+    void setupWakePipe();
+    /**
+     * @brief Empties the self-pipe after stop() or reload() woke the loop.
+     */
+    void drainWakePipe() noexcept;
+    /**
+     * @brief Closes the listening sockets and the self-pipe.
+     */
+    void closeListeners() noexcept;
+    /**
+     * @brief Returns the server bound to a listening fd, or nullptr for other fds.
+     *
+     * @param fd File descriptor reported by the backend.
+     */
+    const Server* findListener(int fd) const;
+    /**
+     * @brief Accepts pending client connections and registers them with the backend.
+     *
+     * @details Accepts up to a fixed batch per event, so a burst of new clients cannot
+     * starve the ones being served; a listener with clients left is re-armed, as
+     * edge-triggered backends would not report it again. At `max_connections`, or
+     * when the process runs out of descriptors, the listeners are paused instead.
+     *
+     * @param listen_fd File descriptor of the listening socket.
+     */
+    void handleNewConnection(int listen_fd);
+    /**
+     * @brief Drops read interest on every listener; new clients wait in the backlog.
+     */
+    void pauseAccepting();
+    /**
+     * @brief Restores read interest on the listeners once a client can be accepted.
+     *
+     * @details Listeners paused for lack of descriptors wait until a client is
+     * released or a second has passed; a listener reported again at once would spin.
+     */
+    void resumeAccepting();
+    /**
+     * @brief Drives the Connection of a client on a readiness event.
+     *
+     * @details Drains the socket into the connection's input buffer, answers the
+     * request once it is complete and flushes queued output. Never blocks: a client
+     * that cannot take the whole response yet gets EVENT_WRITE interest instead.
+     *
+     * @param client Table entry of the client.
+     * @param events Bitmask of PollManager::EVENT_* flags.
+     */
+    void handleClientEvent(ClientSlot& client, uint32_t events);
+    /**
+     * @brief Answers every complete request buffered on a connection, in order.
+     *
+     * @details Supports HTTP/1.1 pipelining: several requests received in one read
+     * are answered one after another, until the pipeline limit is reached. The rest
+     * is picked up again once the output queue drains.
+     *
+     * A request routed to a CGI script is started as soon as its head is parsed;
+     * later requests wait until the script has answered.
+     *
+     * @param client Table entry of the client.
+     */
+    void processInput(ClientSlot& client);
+    /**
+     * @brief Registers the interest a client needs: reads unless its streamed body
+     * is waiting, writes while output is queued.
+     *
+     * @param client Table entry of the client.
+     */
+    void updateInterest(ClientSlot& client);
+    /**
+     * @brief Flushes queued output and updates write interest accordingly.
+     *
+     * @param client Table entry of the client.
+     */
+    void flushClient(ClientSlot& client);
+    /**
+     * @brief Generates the response for a complete request.
+     *
+     * @param conn Connection holding the request.
+     */
+    void handleRequest(Connection& conn);
+    /**
+     * @brief Queues an error response and marks the connection for closing.
+     *
+     * @param conn   Connection that failed.
+     * @param status HTTP status code.
+     */
+    void sendError(Connection& conn, int status);
+    /**
+     * @brief Adds connection headers and queues a response on the connection.
+     *
+     * @param conn       Connection to answer on.
+     * @param response   Response to send; its in-memory body is moved out.
+     * @param keep_alive Whether the connection persists after this response.
+     * @param head_only  Send the head only (HEAD request).
+     */
+    void sendResponse(Connection& conn, HttpResponse& response, bool keep_alive, bool head_only);
+    /**
+     * @brief Adds the `Server`, `Date` and connection management fields.
+     */
+    void addCommonFields(const Connection& conn, HttpResponse& response, bool keep_alive);
+    /**
+     * @brief Builds the Prometheus text of every loop's counters.
+     */
+    HttpResponse buildStats(std::pmr::memory_resource* memory);
+    /**
+     * @brief Forwards the current request upstream, if its location has `proxy_pass`.
+     *
+     * @details Called once the head is parsed, before startCgi(). The request is
+     * relayed like a CGI request: its body streams to the upstream, and the
+     * response comes back through the CGI output path.
+     *
+     * @param client Table entry of the client.
+     * @return False if the request is not proxied.
+     */
+    bool startProxy(ClientSlot& client);
+    /**
+     * @brief Starts relaying a request to the channel of @p run and its response back.
+     */
+    void beginCgiRun(ClientSlot& client, std::unique_ptr<CgiRun> run, const Location& location);
+    /**
+     * @brief Starts the CGI script answering the current request, if the request has one.
+     *
+     * @details Called once the head is parsed. The body streams into the script's
+     * stdin as it arrives. Requests over the location's process limit get 503.
+     * Locations with `fastcgi_pass` send the request to the backend pool instead
+     * of forking.
+     *
+     * @param client Table entry of the client.
+     * @return False if the request is not for a CGI script.
+     */
+    bool startCgi(ClientSlot& client);
+    /**
+     * @brief Forks the script of a local CGI request and registers its pipes.
+     *
+     * @return False if the script could not be started; the error is logged.
+     */
+    bool startCgiProcess(CgiRun& run, const Connection& conn, const CgiProcess::Command& command,
+                         const std::pmr::string& filename);
+    /**
+     * @brief Starts storing the current request's body, if it is an upload.
+     *
+     * @details Called once the head is parsed, after startCgi(). The path below the
+     * location names the file; a POST to the location itself stores a multipart
+     * body's files, or any other body under a generated name.
+     *
+     * @param client Table entry of the client.
+     * @return False if the request is not for an upload store.
+     */
+    bool startUpload(ClientSlot& client);
+    /**
+     * @brief Writes buffered body bytes to the upload; answers once the body ended.
+     */
+    void pumpUpload(ClientSlot& client);
+    /**
+     * @brief Answers the current request with a directory listing, if it asks for one.
+     *
+     * @details Called once the request is complete. A cached listing is answered
+     * at once; otherwise the client waits for a DirectoryScan of the directory,
+     * shared with every client asking for the same one, and reads nothing else.
+     *
+     * @param client Table entry of the client.
+     * @return False if the request is not for an autoindex listing.
+     */
+    bool startListing(ClientSlot& client);
+    /**
+     * @brief Advances every directory scan by one step; answers the clients of finished ones.
+     *
+     * @details A step reads or renders at most DirectoryScan::STEP entries, so a
+     * huge directory delays the loop's other clients by one step per iteration.
+     */
+    void pumpListings();
+    /**
+     * @brief Answers a waiting client with the listing, or the error, of its scan.
+     */
+    void finishListing(ClientSlot& client, const DirectoryScan& scan);
+    /**
+     * @brief Returns the route of the connection's request, routing it on first use.
+     */
+    const RequestRoute& routeOf(Connection& conn);
+    /**
+     * @brief Logs the request line and status of an answered request.
+     */
+    void logRequest(const Connection& conn, int status) const;
+    /**
+     * @brief Drives a client's CGI script when one of its pipes is ready.
+     *
+     * @param fd     Pipe reported by the backend.
+     * @param events Bitmask of PollManager::EVENT_* flags.
+     */
+    void handlePipeEvent(int fd, uint32_t events);
+    /**
+     * @brief Drives the clients whose FastCGI or upstream streams made progress.
+     */
+    void pumpBackends();
+    /**
+     * @brief Writes buffered body bytes to the script; closes its stdin at the end.
+     */
+    void pumpCgiInput(ClientSlot& client);
+    /**
+     * @brief Reads script output into the client's queue until the queue is full.
+     */
+    void pumpCgiOutput(ClientSlot& client);
+    /**
+     * @brief Queues the response head built from the script's header block.
+     */
+    void sendCgiHead(ClientSlot& client);
+    /**
+     * @brief Queues body bytes of the script with the framing chosen for them.
+     *
+     * @details When the body is compressed, each piece is flushed through the
+     * encoder so the client sees output as soon as the script writes it.
+     */
+    void sendCgiBody(CgiRun& run, Connection& conn, std::string data);
+    /**
+     * @brief Queues bytes of the response body, in chunks if the body is chunked.
+     */
+    void queueCgiBody(CgiRun& run, Connection& conn, std::string data);
+    /**
+     * @brief Ends the response of a script and releases it.
+     *
+     * @param client       Table entry of the client.
+     * @param error_status 0 when the output ended normally, else 502 or 504. Once
+     *                     the head is sent an error can only close the connection.
+     */
+    void finishCgi(ClientSlot& client, int error_status);
+    /**
+     * @brief Unregisters and closes the pipes of a script and forgets it.
+     *
+     * @details A FastCGI request that has not ended is aborted.
+     */
+    void releaseCgi(ClientSlot& client);
+    /**
+     * @brief Closes the script's stdin, which ends its request body.
+     */
+    void closeCgiInput(CgiRun& run);
+    /**
+     * @brief Changes the registered interest of a CGI pipe if it differs.
+     */
+    void setPipeInterest(int fd, std::uint32_t& current, std::uint32_t interest);
+    /**
+     * @brief Returns the table entry of an open client, or nullptr.
+     *
+     * @param fd File descriptor reported by the backend.
+     */
+    ClientSlot* findClient(int fd);
+    /**
+     * @brief Unregisters a client from the backend and tombstones its slot.
+     *
+     * @details The descriptor stays open until reapClosed() runs at the end of the
+     * loop iteration, so the kernel cannot hand the same fd number to a new client
+     * while stale events for the old one are still queued in the ready list.
+     *
+     * @param client_fd File descriptor of the connected client.
+     */
+    void closeClient(int client_fd);
+    /**
+     * @brief Sets the deadline of a client from what it waits on.
+     *
+     * @details A script gets its location's `cgi_timeout` from its start, and a
+     * proxied request its `proxy_timeout`. Otherwise
+     * queued output gets `send_timeout` and a body `client_body_timeout`, both from
+     * the last transfer; a head gets `client_header_timeout` from its first byte,
+     * and an idle persistent connection `keepalive_timeout`. 0 disables a timeout.
+     */
+    void armTimer(ClientSlot& client);
+    /**
+     * @brief Computes the deadline armTimer() sets.
+     *
+     * @return False if the client waits without a time limit.
+     */
+    bool findDeadline(const ClientSlot& client, TimerWheel::Clock::time_point& deadline) const;
+    /**
+     * @brief Acts on the clients whose deadline passed.
+     *
+     * @details A head or body that did not arrive in time gets 408, a script 504;
+     * idle and stalled connections are closed.
+     */
+    void expireTimers();
+    /**
+     * @brief Reaps finished scripts and closes idle FastCGI and upstream connections.
+     *
+     * @details Runs at most once per second, while there is anything to do.
+     */
+    void sweepBackends();
+    /**
+     * @brief Closes every tombstoned descriptor and frees its slot.
+     */
+    void reapClosed();
+    /**
+     * @brief Copies the BufferPool figures into this loop's WorkerStats.
+     */
+    void publishBufferStats() noexcept;
 };
+
+/** @} */
@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TimerWheel.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:33:51 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:33:51 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    TimerWheel.hpp
+ * @brief   Declares the TimerWheel, the per-loop store of connection deadlines.
+ *
+ * @details A hierarchical timing wheel (Varghese and Lauck): time is cut into
+ * ticks, and each of the LEVELS wheels has SLOTS slots, each slot covering
+ * SLOTS times more ticks than a slot of the level below. A timer goes into the
+ * lowest level whose range reaches its deadline, and is moved one level down
+ * ("cascaded") when the wheel below wraps around to it. Scheduling and cancelling
+ * are O(1); expiring visits only the slots that fire or cascade, however many
+ * timers are pending, and skips the empty ticks between them.
+ *
+ * Timers are identified by a small integer key, a file descriptor for clients,
+ * and linked through indices into a table indexed by key. They therefore
+ * survive the growth of the owner's own tables, which would move intrusive nodes.
+ *
+ * @ingroup network
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Deadlines keyed by small integers, with O(1) schedule and cancel.
+ *
+ * @ingroup network
+ */
+class TimerWheel {
+  public:
+    using Clock = std::chrono::steady_clock; ///< Same clock as Connection.
+
+    static constexpr std::size_t LEVELS    = 4;               ///< Wheels, finest first.
+    static constexpr unsigned    SLOT_BITS = 6;               ///< log2 of SLOTS.
+    static constexpr std::size_t SLOTS     = 1u << SLOT_BITS; ///< Slots per wheel.
+
+    /**
+     * @param tick  Resolution: timers fire at the first tick boundary after their
+     *              deadline. With the default, the range is over 19 days.
+     * @param start Origin of the first tick.
+     */
+    explicit TimerWheel(Clock::duration   tick  = std::chrono::milliseconds(100),
+                        Clock::time_point start = Clock::now());
+    ~TimerWheel()                            = default;
+    TimerWheel(const TimerWheel&)            = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief Sets the deadline of @p key, replacing the one it had.
+     *
+     * @details A deadline in the past fires on the next expire(); one beyond the
+     * range of the wheel fires at the end of the range.
+     */
+    void schedule(std::size_t key, Clock::time_point deadline);
+
+    /**
+     * @brief Removes the deadline of @p key, if it has one.
+     */
+    void cancel(std::size_t key) noexcept;
+
+    bool isScheduled(std::size_t key) const noexcept;
+
+    /**
+     * @brief Collects the keys whose deadline passed at @p now, and unschedules them.
+     *
+     * @param now     Current time.
+     * @param expired Receives the keys, appended tick by tick.
+     */
+    void expire(Clock::time_point now, std::vector<std::size_t>& expired);
+
+    /**
+     * @brief Returns how long the event loop may sleep before expire() has work.
+     *
+     * @details The result may be earlier than the next deadline when a cascade is
+     * due first; it is never later.
+     *
+     * @return Milliseconds, rounded up, or -1 if no timer is scheduled.
+     */
+    int nextTimeout(Clock::time_point now) const noexcept;
+
+    std::size_t size() const noexcept; ///< Scheduled timers.
+
+  private:
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1); ///< End of a list.
+
+    /// Link of one key into a slot list.
+    struct Node {
+        std::uint64_t expiry = 0;    ///< Tick at which the timer fires.
+        std::size_t   prev   = NONE; ///< Previous key in the slot, or NONE.
+        std::size_t   next   = NONE; ///< Next key in the slot, or NONE.
+        std::size_t   slot   = NONE; ///< Slot holding the key, NONE if unscheduled.
+    };
+
+    Clock::duration          _tick;                  ///< Length of a tick.
+    Clock::time_point        _start;                 ///< Time of tick 0.
+    std::uint64_t            _current;               ///< Next tick to process.
+    std::vector<Node>        _nodes;                 ///< Indexed by key.
+    std::size_t              _heads[LEVELS * SLOTS]; ///< First key of each slot, or NONE.
+    std::size_t              _counts[LEVELS];        ///< Timers on each level.
+    std::size_t              _size;                  ///< Timers on all levels.
+    std::vector<std::size_t> _cascade;               ///< Scratch list of a cascading slot.
+
+    void          link(std::size_t key, std::uint64_t expiry) noexcept;
+    void          unlink(std::size_t key) noexcept;
+    void          cascade(std::size_t level);
+    std::uint64_t nextTick() const noexcept;
+};
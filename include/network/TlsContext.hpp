@@ -0,0 +1,152 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TlsContext.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 05:02:58 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:02:58 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    TlsContext.hpp
+ * @brief   Declares the TLS context of a server and the TLS session of a client.
+ *
+ * @details A TlsContext holds the certificate, key and session settings of one
+ * `listen ... ssl` server. It is built with the ConfigSnapshot, before workers are
+ * forked, so every worker and event loop shares its session ticket keys: a client
+ * resumes its session whichever loop accepts its next connection. The session
+ * cache itself lives in each process.
+ *
+ * A TlsSession wraps one non-blocking client socket. Its calls behave like the
+ * system calls they replace: they return -1 with `errno` set to `EAGAIN` when the
+ * socket is not ready, and wantsWrite() tells which readiness is awaited, so the
+ * Connection state machine drives a handshake like any other read or write.
+ *
+ * When the kernel supports it, the symmetric encryption is handed to kernel TLS
+ * once the handshake completes. Writes may then bypass OpenSSL entirely, so
+ * `sendmsg()` and `sendfile()` keep static files zero-copy over HTTPS.
+ *
+ * Needs OpenSSL (`WEBSERV_HAVE_OPENSSL`); without it, building a TlsContext throws.
+ *
+ * @ingroup network
+ */
+
+#pragma once
+
+#include "core/Server.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <sys/types.h>
+
+struct ssl_ctx_st;
+struct ssl_st;
+
+/**
+ * @brief Certificate and session settings shared by the connections of a server.
+ *
+ * @ingroup network
+ */
+class TlsContext {
+  public:
+    /**
+     * @brief Certificate, key or library failure.
+     */
+    class TlsError : public std::runtime_error {
+      public:
+        explicit TlsError(const std::string& msg);
+    };
+
+    /**
+     * @brief Loads the certificate chain and key of @p server.
+     *
+     * @throws TlsContext::TlsError If they cannot be loaded, do not match, or the
+     *         server was built without OpenSSL.
+     */
+    explicit TlsContext(const Server& server);
+    ~TlsContext();
+    TlsContext(const TlsContext&)            = delete;
+    TlsContext& operator=(const TlsContext&) = delete;
+
+    /**
+     * @brief Returns true if the server was built with TLS support.
+     */
+    static bool isAvailable() noexcept;
+
+  private:
+    friend class TlsSession;
+
+    ssl_ctx_st* _ctx; ///< OpenSSL context, owned.
+};
+
+/**
+ * @brief Server side of the TLS connection of one client.
+ *
+ * @ingroup network
+ */
+class TlsSession {
+  public:
+    /**
+     * @brief Attaches a new session of @p context to the socket @p fd.
+     *
+     * @throws TlsContext::TlsError If OpenSSL cannot allocate the session.
+     */
+    TlsSession(const TlsContext& context, int fd);
+    ~TlsSession();
+    TlsSession(const TlsSession&)            = delete;
+    TlsSession& operator=(const TlsSession&) = delete;
+
+    /**
+     * @brief Advances the handshake.
+     *
+     * @return 1 once it completed, else -1 with `errno` set to `EAGAIN` while it
+     *         waits on the socket, or to `ECONNRESET` if it failed.
+     */
+    int handshake();
+
+    /**
+     * @brief Decrypts up to @p size bytes, like `recv()`.
+     *
+     * @return Bytes read, 0 once the peer closed, or -1 with `errno` set.
+     */
+    ssize_t read(void* buffer, std::size_t size);
+
+    /**
+     * @brief Encrypts and sends up to @p size bytes, like `send()`.
+     *
+     * @details After `EAGAIN`, the next call must pass the same bytes again, though
+     * possibly from another address.
+     *
+     * @return Bytes sent, or -1 with `errno` set.
+     */
+    ssize_t write(const void* buffer, std::size_t size);
+
+    /**
+     * @brief Sends a close_notify alert, without waiting for the peer's.
+     */
+    void shutdown() noexcept;
+
+    bool isEstablished() const noexcept; ///< The handshake completed.
+    bool wantsWrite() const noexcept;    ///< The last `EAGAIN` waits for the socket to drain.
+    bool isResumed() const noexcept;     ///< The handshake resumed an earlier session.
+    bool hasPending() const noexcept;    ///< Decrypted bytes wait inside OpenSSL.
+
+    /**
+     * @brief Returns true if the kernel encrypts what is written to the socket.
+     *
+     * @details Plain `sendmsg()` and `sendfile()` on the socket are then valid
+     * ways to send application data.
+     */
+    bool isKernelSend() const noexcept;
+
+  private:
+    ssl_st* _ssl;         ///< OpenSSL session, owned.
+    bool    _established; ///< See isEstablished().
+    bool    _want_write;  ///< See wantsWrite().
+    bool    _kernel_send; ///< See isKernelSend().
+
+    int fail(int result);
+};
@@ -0,0 +1,239 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamPool.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:25:50 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:25:50 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    UpstreamPool.hpp
+ * @brief   Declares the UpstreamPool and UpstreamStream classes of `proxy_pass`.
+ *
+ * @details Locations with `proxy_pass` forward their requests to HTTP/1.1 app
+ * servers. Each event loop keeps the connections it opened to them and reuses
+ * a connection for the next request once a response ended cleanly, which saves
+ * a connect (and the upstream's accept) per request.
+ *
+ * A request goes to one of the location's servers, chosen round-robin or by the
+ * fewest requests in flight on this loop. Failures are counted per server
+ * (passive health checks): after MAX_FAILS in a row, the server gets no request
+ * for FAIL_TIMEOUT seconds. A request that fails before its response started, while
+ * the whole of it is still buffered, is retried on another server; a kept-alive
+ * connection the upstream closed in the meantime is not counted as a failure.
+ *
+ * The upstream response is handed to the event loop as CGI output: a `Status`
+ * line, its end-to-end header fields and the body with the upstream's framing
+ * removed. The loop then relays it exactly like the output of a CGI script.
+ *
+ * @ingroup network
+ */
+
+#pragma once
+
+#include "cgi/CgiChannel.hpp"
+#include "core/Location.hpp"
+#include "http/ChunkedDecoder.hpp"
+#include "http/ChunkedEncoder.hpp"
+#include "http/HttpRequest.hpp"
+#include "network/PollManager.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <unordered_map>
+#include <vector>
+
+class UpstreamStream;
+
+/**
+ * @brief Kept-alive connections to upstream HTTP servers, owned by one event loop.
+ *
+ * @details Used like FastCgiPool: the loop passes socket events to
+ * handleEvent() and pumps the streams reported by takeWoken() afterwards.
+ *
+ * @ingroup network
+ */
+class UpstreamPool {
+  public:
+    static constexpr std::size_t MAX_IDLE      = 32;     ///< Idle connections kept per server.
+    static constexpr std::size_t MAX_FAILS     = 3;      ///< Failures in a row before a pause.
+    static constexpr long        FAIL_TIMEOUT  = 10;     ///< Seconds a failing server is skipped.
+    static constexpr long        IDLE_TIMEOUT  = 30;     ///< Seconds an idle connection is kept.
+    static constexpr std::size_t SEND_BUFFER   = 65536;  ///< Queued bytes before writes wait.
+    static constexpr std::size_t OUTPUT_BUFFER = 262144; ///< Unread output before reads pause.
+
+    explicit UpstreamPool(PollManager& poller);
+    ~UpstreamPool();
+    UpstreamPool(const UpstreamPool&)            = delete;
+    UpstreamPool& operator=(const UpstreamPool&) = delete;
+
+    /**
+     * @brief Starts a request on one of the servers of @p upstreams.
+     *
+     * @param upstreams Location::getProxyPass(): addresses separated by spaces.
+     * @param balance   How the server is chosen.
+     * @param owner     Reported by takeWoken() when the stream makes progress.
+     * @param head      Request head from makeRequestHead().
+     * @param chunked   The body is written chunked, see makeRequestHead().
+     * @param head_only HEAD request: the response has no body whatever it says.
+     * @return The stream, or NULL with `errno` set if an address is invalid.
+     */
+    std::unique_ptr<UpstreamStream> open(const std::string& upstreams, ProxyBalance balance,
+                                         int owner, std::string head, bool chunked,
+                                         bool head_only);
+
+    /**
+     * @brief Handles an event if @p fd is one of the pool's connections.
+     *
+     * @return False if @p fd does not belong to the pool.
+     */
+    bool handleEvent(int fd, std::uint32_t events);
+
+    /**
+     * @brief Moves out the owners of streams that made progress since the last call.
+     *
+     * @return False if there were none.
+     */
+    bool takeWoken(std::vector<int>& owners);
+
+    /**
+     * @brief Closes connections left idle for IDLE_TIMEOUT seconds.
+     */
+    void closeIdle(CgiChannel::Clock::time_point now);
+
+    std::size_t getConnectionCount() const noexcept; ///< Open or connecting.
+    std::size_t getIdleCount() const noexcept;       ///< Kept for the next request.
+
+    /**
+     * @brief Builds the head of the request forwarded to an upstream.
+     *
+     * @details The request line keeps the client's target. Hop-by-hop fields are
+     * dropped; `X-Forwarded-For` and `X-Forwarded-Proto` are added. A body of
+     * known length keeps its `Content-Length`, a chunked one is sent chunked.
+     *
+     * @param request      Client request.
+     * @param client_addr  Address of the client, or empty if unknown.
+     * @param default_host `Host` sent when the client sent none (HTTP/1.0).
+     * @param chunked      Receives true if the body must be written chunked.
+     * @return Head ending with the blank line.
+     */
+    static std::string makeRequestHead(const HttpRequest& request, std::string_view client_addr,
+                                       std::string_view default_host, bool& chunked);
+
+  private:
+    friend class UpstreamStream;
+    struct Link; ///< One upstream connection, defined with the implementation.
+
+    /// One upstream server and its connections.
+    struct Peer {
+        std::string                        address; ///< As configured, for logs.
+        sockaddr_storage                   addr;    ///< Where to connect.
+        socklen_t                          length;  ///< Size of addr.
+        std::vector<std::unique_ptr<Link>> links;   ///< Open or connecting.
+        std::size_t                        active;  ///< Requests in flight.
+        std::size_t                        fails;   ///< Failures since the last success.
+        CgiChannel::Clock::time_point      down_until; ///< Skipped before this time.
+    };
+
+    /// Servers of one `proxy_pass` value.
+    struct Group {
+        std::vector<Peer> peers;
+        std::size_t       next; ///< Round-robin position.
+    };
+
+    PollManager&                                            _poller; ///< Loop's backend.
+    std::unordered_map<std::string, std::unique_ptr<Group>> _groups; ///< By proxy_pass value.
+    std::vector<Link*>                                      _by_fd;  ///< Socket -> link.
+    std::vector<int>                                        _woken;  ///< See takeWoken().
+
+    Group* findGroup(const std::string& upstreams);
+    Peer*  pick(Group& group, ProxyBalance balance, CgiChannel::Clock::time_point now);
+    void   schedule(UpstreamStream& stream);
+    void   attach(Link& link, UpstreamStream& stream);
+    Link*  idleLink(Peer& peer);
+    Link*  connectLink(Peer& peer);
+    void   release(Link& link, bool reusable);
+    void   closeLink(Link& link);
+    void   prune(Peer& peer);
+    void   updateInterest(Link& link);
+    void   recordFailure(Peer& peer);
+    void   wake(UpstreamStream& stream);
+};
+
+/**
+ * @brief One proxied request, seen as a CgiChannel.
+ *
+ * @details Created by UpstreamPool::open(). Body bytes are framed as announced
+ * in the head and queued for the upstream; the response comes back as CGI
+ * output, see the file description. Destroying a stream that has not ended
+ * closes its connection.
+ *
+ * @ingroup network
+ */
+class UpstreamStream : public CgiChannel {
+  public:
+    ~UpstreamStream() override;
+    UpstreamStream(const UpstreamStream&)            = delete;
+    UpstreamStream& operator=(const UpstreamStream&) = delete;
+
+    ssize_t           writeInput(const char* data, std::size_t size) noexcept override;
+    ssize_t           readOutput(char* buf, std::size_t size) noexcept override;
+    void              closeInput() noexcept override;
+    bool              hasInput() const noexcept override;
+    void              terminate() noexcept override; ///< Closes the connection.
+    Clock::time_point getStartTime() const noexcept override;
+
+    int getOwner() const noexcept; ///< Value given to UpstreamPool::open().
+
+  private:
+    friend class UpstreamPool;
+
+    /// How the upstream delimits the response body.
+    enum class Framing : std::uint8_t { NONE, LENGTH, CHUNKED, CLOSE };
+
+    UpstreamStream(UpstreamPool& pool, UpstreamPool::Group& group, ProxyBalance balance,
+                   int owner, std::string head, bool chunked, bool head_only);
+
+    UpstreamPool&        _pool;        ///< Pool carrying the request.
+    UpstreamPool::Group& _group;       ///< Servers it may go to.
+    UpstreamPool::Peer*  _peer;        ///< Server chosen, NULL before and after.
+    UpstreamPool::Link*  _link;        ///< Connection carrying it, NULL before and after.
+    ProxyBalance         _balance;     ///< See UpstreamPool::open().
+    int                  _owner;       ///< Woken when the stream makes progress.
+    std::string          _out;         ///< Request bytes, from the start while replayable.
+    std::size_t          _sent;        ///< Bytes of _out already sent.
+    std::string          _in;          ///< Response head received so far.
+    std::string          _output;      ///< CGI output not read yet.
+    std::size_t          _output_read; ///< Bytes of _output already read.
+    ChunkedEncoder       _encoder;     ///< Frames the request body when chunked.
+    ChunkedDecoder       _decoder;     ///< Response body framing when CHUNKED.
+    std::size_t          _body_left;   ///< Response bytes still expected when LENGTH.
+    std::size_t          _attempts;    ///< Fresh connections that failed.
+    Framing              _framing;     ///< Set once the response head is parsed.
+    bool                 _chunked;     ///< Request body framed in chunks.
+    bool                 _head_only;   ///< HEAD request.
+    bool                 _replayable;  ///< _out still holds the whole request: may retry.
+    bool                 _responded;   ///< Response head parsed.
+    bool                 _reusable;    ///< The upstream keeps the connection open.
+    bool                 _input_open;  ///< closeInput() not called yet.
+    bool                 _ended;       ///< Response complete.
+    bool                 _want_write;  ///< writeInput() returned EAGAIN.
+    int                  _error;       ///< errno of a failed request, 0 if none.
+    Clock::time_point    _started;     ///< When open() was called.
+
+    void        onEvent(std::uint32_t events);
+    void        flush();
+    void        receive();
+    bool        parseHead();
+    bool        parseBody(char* data, std::size_t size);
+    void        finish();
+    void        fail(int error);
+    std::size_t queuedBytes() const noexcept;
+};
@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UringManager.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 03:29:26 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 03:29:26 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    UringManager.hpp
+ * @brief   Declares the io_uring event backend.
+ *
+ * @details Only compiled on Linux when the build enables it (`WEBSERV_IO_URING`).
+ * Each descriptor is watched by one multishot poll request on the ring. Adding,
+ * changing and removing interest only queue submission entries; they reach the
+ * kernel together with the wait of the next loop iteration, in one
+ * `io_uring_enter()`, where epoll needs one `epoll_ctl()` per change.
+ *
+ * Like epoll with `EPOLLET`, a multishot poll completes once per wake-up of the
+ * descriptor, so callers drain descriptors exactly as for the epoll backend, and
+ * re-arming with modify() reports data that is already waiting.
+ *
+ * The ring is driven with the raw system calls; liburing is not needed.
+ *
+ * @ingroup network
+ */
+
+#pragma once
+
+#if defined(__linux__) && defined(WEBSERV_HAVE_IO_URING)
+
+#include "network/PollManager.hpp"
+#include <cstddef>
+#include <linux/io_uring.h>
+#include <vector>
+
+/**
+ * @brief Linux io_uring(7) implementation of PollManager.
+ *
+ * @ingroup network
+ */
+class UringManager : public PollManager {
+  public:
+    /**
+     * @brief Creates the ring and maps its queues.
+     *
+     * @throws PollManager::PollError If the kernel has no io_uring, forbids it, or
+     *         lacks multishot poll or timed waits (Linux 5.13 and later have them).
+     */
+    UringManager();
+
+    /**
+     * @brief Unmaps the queues and closes the ring.
+     */
+    ~UringManager() override;
+
+    void        add(int fd, std::uint32_t interest) override;
+    void        modify(int fd, std::uint32_t interest) override;
+    void        remove(int fd) noexcept override;
+    int         wait(std::vector<IoEvent>& ready, int timeout_ms) override;
+    const char* name() const noexcept override;
+
+  private:
+    /// Poll request currently watching one descriptor.
+    struct Watch {
+        std::uint32_t interest   = 0;     ///< EVENT_* bits asked for.
+        std::uint32_t generation = 0;     ///< Tags completions of the current request.
+        bool          registered = false; ///< The descriptor is watched.
+    };
+
+    int                 _ring_fd;    ///< Descriptor returned by io_uring_setup().
+    void*               _sq_ring;    ///< Mapped submission ring.
+    std::size_t         _sq_size;    ///< Its mapped length.
+    void*               _cq_ring;    ///< Mapped completion ring, may alias _sq_ring.
+    std::size_t         _cq_size;    ///< Its mapped length.
+    io_uring_sqe*       _sqes;       ///< Mapped submission entries.
+    std::size_t         _sqes_size;  ///< Their mapped length.
+    unsigned*           _sq_head;    ///< Consumed by the kernel.
+    unsigned*           _sq_tail;    ///< Produced by this backend.
+    unsigned*           _sq_array;   ///< Ring slot -> entry index.
+    unsigned            _sq_mask;    ///< Ring size - 1.
+    unsigned            _sq_entries; ///< Ring size.
+    unsigned*           _cq_head;    ///< Consumed by this backend.
+    unsigned*           _cq_tail;    ///< Produced by the kernel.
+    unsigned            _cq_mask;    ///< Ring size - 1.
+    io_uring_cqe*       _cqes;       ///< Completion entries.
+    unsigned            _sq_local;   ///< Tail including entries not published yet.
+    std::vector<Watch>  _watches;    ///< Indexed by fd.
+    std::size_t         _watched;    ///< Number of registered descriptors.
+    std::vector<int>    _reported;   ///< fd -> index in the ready list + 1, this wait.
+
+    io_uring_sqe* nextEntry() noexcept;
+    void          queuePoll(int fd);
+    void          queueCancel(int fd) noexcept;
+    int           enter(unsigned wait_for, int timeout_ms) noexcept;
+    void          reap(std::vector<IoEvent>& ready);
+    void          unmap() noexcept;
+};
+
+#endif
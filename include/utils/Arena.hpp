@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Arena.hpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:35:47 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:39:56 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Arena.hpp
+ * @brief   Declares the Arena bump allocator used for per-request memory.
+ *
+ * @details Everything a request allocates while its response is built (header
+ * fields, normalized paths, resolved filenames) has the same lifetime: it dies
+ * when the next request on the connection starts. An Arena hands out that memory
+ * by bumping a pointer through a block, frees nothing individually, and rewinds
+ * in O(1) when the request is done. It is a `std::pmr::memory_resource`, so
+ * `std::pmr` containers allocate from it directly.
+ *
+ * @ingroup utils
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @brief Monotonic memory resource that is rewound per request.
+ *
+ * @details The first block is allocated lazily and survives reset(), so a
+ * keep-alive connection serving ordinary requests reaches a steady state without
+ * any call to `operator new`. Blocks added by an unusually large request are
+ * freed on reset(), which bounds the memory a connection keeps between requests
+ * to one block. Not thread-safe: an Arena belongs to one connection.
+ *
+ * @ingroup utils
+ */
+class Arena : public std::pmr::memory_resource {
+  public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 4096; ///< Bytes per regular block.
+
+    /**
+     * @brief Creates an empty arena; no memory is allocated until first use.
+     *
+     * @param block_size Size of regular blocks. Larger requests get a block of their own.
+     * @param upstream   Source of the blocks, e.g. a BufferPool.
+     */
+    explicit Arena(std::size_t                block_size = DEFAULT_BLOCK_SIZE,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept;
+    ~Arena() override;
+    Arena(const Arena&)            = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Makes all memory reusable, keeping only the first block.
+     *
+     * @warning Invalidates every object allocated from the arena.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Returns every block to the system, e.g. when a connection goes idle.
+     */
+    void release() noexcept;
+
+    std::size_t getUsed() const noexcept;       ///< Bytes handed out since the last reset.
+    std::size_t getReserved() const noexcept;   ///< Bytes held in blocks.
+    std::size_t getBlockCount() const noexcept; ///< Blocks currently held.
+
+  private:
+    /// Header at the start of every block; blocks form a singly linked list.
+    struct Block {
+        Block*      next; ///< Next block, or NULL.
+        std::size_t size; ///< Total size including this header.
+    };
+
+    std::size_t                _block_size; ///< Size of regular blocks.
+    std::pmr::memory_resource* _upstream;   ///< Source of the blocks.
+    Block*                     _first;      ///< Kept across reset().
+    Block*                     _current;    ///< Block the cursor points into.
+    std::size_t                _cursor;     ///< Offset of the next free byte in _current.
+    std::size_t                _used;       ///< See getUsed().
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void  do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    void freeAfter(Block* block) noexcept;
+    void freeBlock(Block* block) noexcept;
+};
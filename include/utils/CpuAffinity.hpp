@@ -0,0 +1,56 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CpuAffinity.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 05:09:56 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:09:56 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    CpuAffinity.hpp
+ * @brief   Declares helpers placing event loop threads on CPUs and NUMA nodes.
+ *
+ * @details A loop pinned to one CPU keeps its caches warm, and memory it first
+ * touches lands on that CPU's node. These wrap the Linux calls directly, without
+ * libnuma; elsewhere they fail with `ENOSYS` and the loops run unpinned.
+ *
+ * @ingroup utils
+ */
+
+#pragma once
+
+#include <vector>
+
+/**
+ * @brief Returns the CPUs the calling process may run on, in ascending order.
+ *
+ * @details Honors `taskset` and cpusets. Falls back to every online CPU when the
+ * mask cannot be read.
+ */
+std::vector<unsigned> allowedCpus();
+
+/**
+ * @brief Restricts the calling thread to @p cpu.
+ *
+ * @return False with `errno` set, e.g. `EINVAL` for a CPU outside the process mask.
+ */
+bool pinThreadToCpu(unsigned cpu) noexcept;
+
+/**
+ * @brief Returns the only CPU the calling thread may run on, or -1 if it may run on several.
+ */
+int pinnedCpu() noexcept;
+
+/**
+ * @brief Makes the calling thread allocate from the NUMA node it runs on.
+ *
+ * @details The node is preferred, not required: allocations spill to other nodes
+ * once it is full. Meant for pinned threads, whose node does not change.
+ *
+ * @return The node, or -1 with `errno` set.
+ */
+int preferLocalNode() noexcept;
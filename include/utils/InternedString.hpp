@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   InternedString.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:00:07 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:00:07 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    InternedString.hpp
+ * @brief   Declares InternedString, a pointer-sized handle to a shared string.
+ *
+ * @details Configuration values repeat a lot: thousands of locations share the
+ * same few paths, roots and extensions. Interning keeps one copy of each distinct
+ * value in a process-wide pool and stores a pointer to it, so a value costs 8
+ * bytes instead of a 32-byte `std::string` plus its heap block, and copying a
+ * Location copies no characters.
+ *
+ * The pool only grows: a value stays interned after the last configuration using
+ * it is reloaded away. That is bounded by the distinct strings ever configured.
+ * Interning takes a mutex; reading a handle never does.
+ *
+ * @ingroup utils
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Immutable string stored once per distinct value.
+ *
+ * @details Equal values get the same handle, so comparing two handles compares
+ * pointers. The default handle is the empty string.
+ *
+ * @ingroup utils
+ */
+class InternedString {
+  public:
+    InternedString();
+    explicit InternedString(std::string_view value);
+    explicit InternedString(std::string&& value);
+
+    InternedString& operator=(std::string_view value);
+    InternedString& operator=(std::string&& value);
+
+    const std::string& str() const noexcept { return *_value; }
+    operator const std::string&() const noexcept { return *_value; }
+    bool empty() const noexcept { return _value->empty(); }
+
+    bool operator==(const InternedString& other) const noexcept { return _value == other._value; }
+    bool operator!=(const InternedString& other) const noexcept { return _value != other._value; }
+
+    /// Number of distinct values interned so far, for tests and statistics.
+    static std::size_t poolSize();
+
+  private:
+    const std::string* _value; ///< Pooled copy; never freed, never moved.
+};
@@ -0,0 +1,166 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Logger.hpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/04/26 16:00:00 by nlouis            #+#    #+#             */
+/*   Updated: 2025/05/28 11:32:47 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Logger.hpp
+ * @brief   Declares the asynchronous, leveled Logger and its LOG_* macros.
+ *
+ * @details Event loops never write to the terminal themselves. A log call formats
+ * one fixed-size record into a ring owned by the calling thread and returns; a
+ * background thread drains every ring and writes the text in batches, INFO and
+ * DEBUG to standard output, WARN and ERROR to standard error. A full ring drops
+ * the record and counts it, so logging never blocks a request.
+ *
+ * Levels below `WEBSERV_LOG_LEVEL` are removed at compile time: the LOG_* macros
+ * expand to a discarded `if constexpr` branch, so their arguments are not even
+ * evaluated. The default keeps DEBUG in `-DWEBSERV_DEBUG` builds only.
+ *
+ * @ingroup utils
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Severity of a log record, in increasing order.
+ *
+ * @ingroup utils
+ */
+enum class LogLevel : std::uint8_t {
+    Debug = 0, ///< Per-request tracing, compiled out of release builds.
+    Info  = 1, ///< Startup, shutdown and access records.
+    Warn  = 2, ///< Recoverable trouble, e.g. a failed CGI script.
+    Error = 3  ///< Failures that stop a worker or lose a client.
+};
+
+#ifndef WEBSERV_LOG_LEVEL
+#ifdef WEBSERV_DEBUG
+#define WEBSERV_LOG_LEVEL 0
+#else
+#define WEBSERV_LOG_LEVEL 1
+#endif
+#endif
+
+/// True if @p level is compiled in; the +1 spares `>= 0`, which -Wtype-limits rejects.
+constexpr bool isLogLevelEnabled(LogLevel level) noexcept {
+    return static_cast<unsigned>(level) + 1 > WEBSERV_LOG_LEVEL;
+}
+
+/// Logs printf-style at @p level, or compiles to nothing below WEBSERV_LOG_LEVEL.
+#define WEBSERV_LOG(level, ...)                                                           \
+    do {                                                                                  \
+        if constexpr (isLogLevelEnabled(level))                                           \
+            Logger::log(level, __VA_ARGS__);                                              \
+    } while (0)
+
+#define LOG_DEBUG(...) WEBSERV_LOG(LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...)  WEBSERV_LOG(LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...)  WEBSERV_LOG(LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) WEBSERV_LOG(LogLevel::Error, __VA_ARGS__)
+
+/**
+ * @brief Process-wide asynchronous logger.
+ *
+ * @details Each thread gets its own single-producer / single-consumer ring the
+ * first time it logs; the ring outlives the thread and is reused by nobody else.
+ * The writer thread starts with the first record and again in a forked child,
+ * which inherits no threads: records queued before `fork()` are written once, by
+ * the parent. Records from different threads are not ordered with each other.
+ *
+ * @ingroup utils
+ */
+class Logger {
+  public:
+    static constexpr std::size_t RECORD_SIZE  = 256;  ///< Bytes per record, text included.
+    static constexpr std::size_t RING_RECORDS = 1024; ///< Records per thread, a power of 2.
+
+    /**
+     * @brief Queues one record for the writer thread.
+     *
+     * @details Text longer than a record is truncated. Never blocks on I/O; when
+     * the calling thread's ring is full the record is dropped.
+     *
+     * @param level  Severity; the LOG_* macros filter it at compile time first.
+     * @param format printf-style format.
+     */
+    static void log(LogLevel level, const char* format, ...) noexcept
+        __attribute__((format(printf, 2, 3)));
+
+    /**
+     * @brief Writes every queued record now, from the calling thread.
+     *
+     * @details For shutdown paths that end with `_exit()`, and for tests.
+     */
+    static void flush() noexcept;
+
+    /**
+     * @brief Returns how many records were dropped because a ring was full.
+     */
+    static std::uint64_t getDropped() noexcept;
+
+    ~Logger();
+    Logger(const Logger&)            = delete;
+    Logger& operator=(const Logger&) = delete;
+
+  private:
+    /// One formatted record, written whole by its producer.
+    struct Record {
+        std::int64_t  time_ms; ///< Wall clock, milliseconds since the epoch.
+        LogLevel      level;   ///< Severity.
+        std::uint16_t length;  ///< Bytes used in text.
+        char          text[RECORD_SIZE - 16]; ///< Message, not NUL-terminated.
+    };
+
+    /// Records of one thread; the writer thread is the only consumer.
+    struct Ring {
+        alignas(64) std::atomic<std::size_t> head{0}; ///< Next record to write out.
+        alignas(64) std::atomic<std::size_t> tail{0}; ///< Next record to fill.
+        pthread_t owner;                              ///< Producing thread.
+        Record    records[RING_RECORDS];              ///< Slots, indexed modulo size.
+    };
+
+    std::mutex                         _rings_mutex; ///< Guards _rings and the writer start.
+    std::vector<std::unique_ptr<Ring>> _rings;       ///< Every ring ever handed out.
+    std::mutex                         _drain_mutex; ///< One consumer at a time.
+    std::vector<Ring*>                 _draining;    ///< Rings visited by the current drain.
+    std::string                        _out;         ///< Batch for standard output.
+    std::string                        _err;         ///< Batch for standard error.
+    std::int64_t                       _stamp_second; ///< Second formatted in _stamp.
+    char                               _stamp[24];    ///< "YYYY-MM-DD HH:MM:SS".
+    std::atomic<std::uint64_t>         _dropped;      ///< Records lost to full rings.
+    std::uint64_t                      _reported;     ///< Drops already announced.
+    std::atomic<bool>                  _running;      ///< The writer thread exists.
+    std::atomic<bool>                  _stopping;     ///< Asks the writer thread to exit.
+    pthread_t                          _writer;       ///< Writer thread, if _running.
+
+    Logger();
+
+    static Logger& instance() noexcept;
+    static void*   writerMain(void* self);
+    static void    beforeFork() noexcept;
+    static void    afterForkParent() noexcept;
+    static void    afterForkChild() noexcept;
+
+    Ring* ring() noexcept;
+    void  startWriter() noexcept;
+    bool  drainLocked() noexcept;
+    void  append(const Record& record);
+    void  writeAll(int fd, std::string& batch) noexcept;
+};
@@ -0,0 +1,54 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Probes.hpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 05:18:53 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:18:53 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Probes.hpp
+ * @brief   Defines the USDT probes marking the phases of a request.
+ *
+ * @details Built with `WEBSERV_HAVE_SDT` (`<sys/sdt.h>` from SystemTap), each probe
+ * is a single `nop` plus an ELF note naming it and locating its arguments. Nothing
+ * else runs until a tracer attaches and patches the `nop`:
+ *
+ *     bpftrace -e 'usdt:./webserv:webserv:request_done { @us[arg1] = hist(arg2 / 1000); }'
+ *
+ * Without it the probes compile to nothing and their arguments are not evaluated,
+ * so arguments must not have side effects. Probes of the provider `webserv`, each
+ * with the client socket first:
+ *
+ * | Probe             | Further arguments              | Fired when                   |
+ * |-------------------|--------------------------------|------------------------------|
+ * | `accept`          |                                | a client is accepted         |
+ * | `request_start`   |                                | a request head begins        |
+ * | `request_parsed`  | target, target length          | the head is parsed           |
+ * | `request_server`  | port                           | the virtual host is chosen   |
+ * | `request_routed`  |                                | the location handler starts  |
+ * | `response_queued` | status                         | the response head is queued  |
+ * | `response_start`  |                                | its first byte is sent       |
+ * | `request_done`    | status, nanoseconds since head | its last byte is sent        |
+ *
+ * The last three fire for timed responses, which are all of them in the server.
+ *
+ * @ingroup utils
+ */
+
+#pragma once
+
+#if defined(WEBSERV_HAVE_SDT)
+# include <sys/sdt.h>
+# define WEBSERV_PROBE1(name, a)       DTRACE_PROBE1(webserv, name, a)
+# define WEBSERV_PROBE2(name, a, b)    DTRACE_PROBE2(webserv, name, a, b)
+# define WEBSERV_PROBE3(name, a, b, c) DTRACE_PROBE3(webserv, name, a, b, c)
+#else
+# define WEBSERV_PROBE1(name, a)       ((void)0)
+# define WEBSERV_PROBE2(name, a, b)    ((void)0)
+# define WEBSERV_PROBE3(name, a, b, c) ((void)0)
+#endif
@@ -0,0 +1,107 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RequestTrace.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 05:18:53 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:18:53 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    RequestTrace.hpp
+ * @brief   Declares RequestTrace, the phase timestamps of one request.
+ *
+ * @details Connections fill a trace only while `slow_request_threshold` is set;
+ * otherwise no clock is read. A request slower than the threshold is logged with
+ * the time spent between consecutive phases, which tells a slow client from a
+ * slow handler or a full socket.
+ *
+ * @ingroup utils
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Points in the life of a request, in the order they happen.
+ *
+ * @ingroup utils
+ */
+enum class TracePhase : std::uint8_t {
+    ACCEPTED,    ///< The connection was accepted; first request only.
+    HEAD_START,  ///< First byte of the request head arrived.
+    HEAD_PARSED, ///< The request head was parsed.
+    SERVER,      ///< The virtual host was selected.
+    ROUTED,      ///< The location was matched; its handler starts.
+    RESPONDED,   ///< The handler queued the response head.
+    FIRST_SENT,  ///< The first response byte was written.
+    DONE         ///< The last response byte was written.
+};
+
+/**
+ * @brief Timestamps of the phases one request went through, with its request line.
+ *
+ * @ingroup utils
+ */
+class RequestTrace {
+  public:
+    using Clock = std::chrono::steady_clock; ///< Clock of every mark.
+
+    static constexpr std::size_t PHASES      = 8;  ///< Values of TracePhase.
+    static constexpr std::size_t METHOD_SIZE = 8;  ///< Method bytes kept.
+    static constexpr std::size_t TARGET_SIZE = 64; ///< Request target bytes kept.
+
+    RequestTrace() noexcept;
+
+    void reset() noexcept; ///< Forgets every mark and the request line.
+
+    /**
+     * @brief Records when @p phase happened, replacing an earlier mark of it.
+     */
+    void mark(TracePhase phase, Clock::time_point when) noexcept;
+    bool has(TracePhase phase) const noexcept;
+    bool empty() const noexcept; ///< No phase is marked.
+
+    /**
+     * @brief Keeps the request line, truncated, for the log once the request is done.
+     */
+    void describe(std::string_view method, std::string_view target) noexcept;
+    void setStatus(int status) noexcept;
+
+    /**
+     * @brief Returns the time from the first byte of the head to the last byte sent.
+     *
+     * @details Time before the head, such as an idle keep-alive wait, does not count.
+     * Zero until both are marked.
+     */
+    Clock::duration elapsed() const noexcept;
+
+    /**
+     * @brief Writes the request line, elapsed() and the time between phases.
+     *
+     * @details For example `GET /a 200 in 12.480 ms: read parsed +0.011 server +0.001
+     * routed +0.002 responded +0.153 sent +0.020 done +12.293`, in milliseconds. Phases
+     * that were not marked are skipped.
+     *
+     * @return Length of the text, truncated to fit @p size with its NUL.
+     */
+    std::size_t format(char* out, std::size_t size) const noexcept;
+
+    static const char* phaseName(TracePhase phase) noexcept;
+
+  private:
+    Clock::time_point _marks[PHASES];       ///< Indexed by TracePhase.
+    std::uint16_t     _marked;              ///< One bit per marked phase.
+    std::uint16_t     _status;              ///< Response status, 0 if unknown.
+    std::uint8_t      _method_length;       ///< Bytes used in _method.
+    std::uint8_t      _target_length;       ///< Bytes used in _target.
+    char              _method[METHOD_SIZE]; ///< Request method, truncated.
+    char              _target[TARGET_SIZE]; ///< Request target, truncated.
+};
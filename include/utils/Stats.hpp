@@ -0,0 +1,183 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Stats.hpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 03:39:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 06:05:52 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Stats.hpp
+ * @brief   Declares the per-loop statistics and their Prometheus rendering.
+ *
+ * @details Every event loop owns one WorkerStats block and is its only writer, so
+ * an update is a relaxed load and store, with no locked instruction. Blocks are
+ * cache-line aligned, so loops never share a line. A StatsRegistry puts all blocks
+ * of the server in one shared anonymous mapping created before the workers fork,
+ * so whichever loop answers a stats request sums the counters of every process.
+ *
+ * Latencies go into log-linear histograms in the style of HdrHistogram: values
+ * below 16 µs are exact, larger ones fall into one of 8 buckets per power of two,
+ * which bounds the error of a reported quantile to 12.5%.
+ *
+ * @ingroup utils
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Monotonic counter with a single writer and any number of readers.
+ *
+ * @ingroup utils
+ */
+class StatCounter {
+  public:
+    StatCounter() noexcept : _value(0) {}
+
+    void add(std::uint64_t n = 1) noexcept {
+        _value.store(_value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    std::uint64_t get() const noexcept { return _value.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<std::uint64_t> _value;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "counters live in memory shared between processes");
+};
+
+/**
+ * @brief Level or copied total with a single writer and any number of readers.
+ *
+ * @ingroup utils
+ */
+class StatGauge {
+  public:
+    StatGauge() noexcept : _value(0) {}
+
+    void set(std::uint64_t value) noexcept { _value.store(value, std::memory_order_relaxed); }
+    std::uint64_t get() const noexcept { return _value.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<std::uint64_t> _value;
+};
+
+/**
+ * @brief Log-linear latency histogram in microseconds, single writer.
+ *
+ * @ingroup utils
+ */
+class LatencyHistogram {
+  public:
+    static constexpr std::size_t BUCKETS = 16 + 32 * 8; ///< Up to 2^36 µs, about 19 hours.
+
+    /// Adds one sample; values past the last bucket are counted in it.
+    void record(std::uint64_t micros) noexcept;
+
+    /// Adds a steady-clock duration, rounded down to microseconds.
+    void record(std::chrono::steady_clock::duration elapsed) noexcept;
+
+    std::uint64_t getCount() const noexcept;
+    std::uint64_t getSum() const noexcept; ///< Sum of all samples in µs.
+    std::uint64_t getBucket(std::size_t index) const noexcept;
+
+    /// Returns the bucket a value falls into.
+    static std::size_t bucketOf(std::uint64_t micros) noexcept;
+
+    /// Returns the largest value of a bucket.
+    static std::uint64_t upperBound(std::size_t index) noexcept;
+
+  private:
+    std::array<StatCounter, BUCKETS> _buckets;
+    StatCounter                      _count;
+    StatCounter                      _sum;
+};
+
+/**
+ * @brief Counters of one event loop.
+ *
+ * @details Responses are counted by status class when queued. Connections still
+ * open are `accepted - closed`. Time to first byte and request time run from
+ * the first byte of the request head to the first and last byte of its response
+ * leaving through the socket; a script's body streamed after its head is not
+ * included in the request time. The buffer pool figures are copied from the
+ * loop's BufferPool once per iteration.
+ *
+ * @ingroup utils
+ */
+struct alignas(64) WorkerStats {
+    StatCounter      accepted;     ///< Connections accepted.
+    StatCounter      closed;       ///< Connections closed.
+    StatCounter      responses[6]; ///< By status class: [2] is 2xx; [0] is anything else.
+    StatCounter      bytes_in;     ///< Bytes received from clients.
+    StatCounter      bytes_out;    ///< Bytes sent to clients.
+    StatCounter      parse_errors; ///< Requests rejected while being read.
+    StatCounter      tls_handshakes;  ///< TLS handshakes completed.
+    StatCounter      tls_resumed;     ///< Of those, resumed sessions.
+    StatCounter      tls_kernel_send; ///< Of those, encrypted by the kernel (kTLS).
+    StatCounter      slow_requests;   ///< Over `slow_request_threshold`, see RequestTrace.
+    StatGauge        buffers_in_use;     ///< BufferPool::getInUse() of the loop.
+    StatGauge        buffers_high_water; ///< BufferPool::getHighWater() of the loop.
+    StatGauge        buffer_hits;        ///< BufferPool::getHits() of the loop.
+    StatGauge        buffer_misses;      ///< BufferPool::getMisses() of the loop.
+    LatencyHistogram first_byte;   ///< Time to first byte.
+    LatencyHistogram total;        ///< Time until the whole response was sent.
+
+    void countResponse(int status) noexcept {
+        responses[status >= 100 && status < 600 ? status / 100 : 0].add();
+    }
+};
+
+/**
+ * @brief Fixed set of WorkerStats blocks, shared by every worker process.
+ *
+ * @details Created once, before `fork()`: each process writes its own slots, and
+ * reads all of them when rendering. A restarted worker keeps counting in the slot
+ * of the worker it replaces.
+ *
+ * @ingroup utils
+ */
+class StatsRegistry {
+  public:
+    /**
+     * @brief Maps @p workers zeroed blocks shared with child processes.
+     *
+     * @throws std::bad_alloc If the mapping cannot be created.
+     */
+    static std::shared_ptr<StatsRegistry> create(std::size_t workers);
+
+    ~StatsRegistry();
+    StatsRegistry(const StatsRegistry&)            = delete;
+    StatsRegistry& operator=(const StatsRegistry&) = delete;
+
+    std::size_t  getWorkerCount() const noexcept;
+    WorkerStats& getWorker(std::size_t index) noexcept;
+
+    /**
+     * @brief Appends the sum of every block to @p out in the Prometheus text format.
+     *
+     * @details Counters are reported as counters, open connections as a gauge and
+     * latencies as summaries with the 0.5, 0.9, 0.99 and 0.999 quantiles, in seconds.
+     * Buffer pools are not summed: each loop reports its own, labelled `worker`.
+     */
+    void renderPrometheus(std::string& out) const;
+
+  private:
+    WorkerStats* _workers; ///< Blocks in the shared mapping.
+    std::size_t  _count;   ///< Number of blocks.
+    std::size_t  _size;    ///< Length of the mapping.
+
+    StatsRegistry(WorkerStats* workers, std::size_t count, std::size_t size) noexcept;
+};
@@ -0,0 +1,125 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   StringUtils.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/05/02 13:45:05 by nlouis            #+#    #+#             */
+/*   Updated: 2025/05/12 16:03:44 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    StringUtils.hpp
+ * @brief   Declares small string helpers shared across modules.
+ *
+ * @details Allocation-free helpers operating on `std::string_view`, mostly used for
+ * case-insensitive HTTP token handling.
+ *
+ * @ingroup utils
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <ctime>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Returns the ASCII lowercase version of a character.
+ */
+constexpr char toLowerAscii(char c) noexcept {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief Compares two strings ignoring ASCII case.
+ *
+ * @param a First string.
+ * @param b Second string.
+ * @return True if both strings are equal ignoring case.
+ */
+bool iequals(std::string_view a, std::string_view b) noexcept;
+
+/**
+ * @brief Removes leading and trailing spaces and tabs.
+ *
+ * @param s Input string view.
+ * @return Sub-view of @p s without surrounding whitespace.
+ */
+std::string_view trim(std::string_view s) noexcept;
+
+/**
+ * @brief Returns an ASCII lowercase copy of a string.
+ *
+ * @param s Input string.
+ * @return Lowercased copy.
+ */
+std::string toLower(std::string_view s);
+
+/**
+ * @brief Parses an unsigned decimal number without allocating.
+ *
+ * @param s   Digits only, no sign or whitespace.
+ * @param out Receives the parsed value on success.
+ * @return False on empty input, non-digit characters or overflow.
+ */
+bool parseSize(std::string_view s, std::size_t& out) noexcept;
+
+/**
+ * @brief Percent-decodes a request path and removes dot segments.
+ *
+ * @details Applies RFC 3986 `remove_dot_segments` after decoding and collapses
+ * repeated slashes. A trailing slash is preserved, since it distinguishes a
+ * directory request. An escape that decodes to '/' or NUL is rejected, so a
+ * single decoded segment can never name another directory.
+ *
+ * @param path Path component of the request target; must start with '/'.
+ * @param out  Receives the normalized path on success.
+ * @return False on malformed escapes, forbidden bytes, or a path climbing above "/".
+ */
+bool normalizeUriPath(std::string_view path, std::string& out);
+
+/**
+ * @brief Same as above, building the result with @p out's allocator.
+ */
+bool normalizeUriPath(std::string_view path, std::pmr::string& out);
+
+/**
+ * @brief Appends @p name percent-encoded as a single URI path segment.
+ *
+ * @details Only RFC 3986 unreserved characters are kept as they are, so names
+ * holding '/', '%' or any other byte come back intact once decoded.
+ */
+void appendPathSegment(std::string& out, std::string_view name);
+
+/**
+ * @brief Appends @p text with `&`, `<`, `>`, `"` and `'` escaped for HTML.
+ */
+void appendEscapedHtml(std::string& out, std::string_view text);
+
+/**
+ * @brief Formats a timestamp as an RFC 9110 IMF-fixdate.
+ *
+ * @details Produces e.g. "Sun, 06 Nov 1994 08:49:37 GMT" without consulting the
+ * locale, as HTTP requires English day and month names.
+ *
+ * @param time Seconds since the Epoch.
+ * @return Formatted date, always 29 characters.
+ */
+std::string formatHttpDate(std::time_t time);
+
+/**
+ * @brief Parses an RFC 9110 IMF-fixdate, as written by formatHttpDate().
+ *
+ * @details The obsolete RFC 850 and asctime formats are refused; a conditional
+ * request using them is simply answered in full.
+ *
+ * @param s   Field value, e.g. "Sun, 06 Nov 1994 08:49:37 GMT".
+ * @param out Receives the seconds since the Epoch on success.
+ * @return False if @p s is not a valid IMF-fixdate.
+ */
+bool parseHttpDate(std::string_view s, std::time_t& out) noexcept;
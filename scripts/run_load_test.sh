@@ -0,0 +1,69 @@
+#!/bin/bash
+# Starts ./bin/webserv, drives it with many concurrent keep-alive clients and
+# prints requests/sec and p50/p90/p99/p999 latency.
+#
+# Usage: ./scripts/run_load_test.sh [webserv_load options]
+#   e.g. ./scripts/run_load_test.sh -c 256 -t 8 -d 30 -u /index.html
+#
+# Environment:
+#   WEBSERV       server binary            (default ./bin/webserv)
+#   WEBSERV_LOAD  load generator binary    (default ./bin/bench/webserv_load)
+#   HOST, PORT    where the server listens (default 127.0.0.1:8080)
+#   EXTERNAL=1    load a server that is already running instead of starting one
+set -euo pipefail
+
+# Colors
+GREEN="\033[0;32m"
+RED="\033[0;31m"
+CYAN="\033[0;36m"
+RESET="\033[0m"
+
+WEBSERV="${WEBSERV:-./bin/webserv}"
+WEBSERV_LOAD="${WEBSERV_LOAD:-./bin/bench/webserv_load}"
+HOST="${HOST:-127.0.0.1}"
+PORT="${PORT:-8080}"
+EXTERNAL="${EXTERNAL:-0}"
+
+if [ ! -x "$WEBSERV_LOAD" ]; then
+    echo -e "${RED}❌ Error: $WEBSERV_LOAD not found. Build it with 'make load' or the webserv_load CMake target.${RESET}"
+    exit 1
+fi
+
+server_pid=""
+function stop_server() {
+    if [ -n "$server_pid" ]; then
+        kill "$server_pid" 2>/dev/null || true
+        wait "$server_pid" 2>/dev/null || true
+    fi
+}
+trap stop_server EXIT
+
+if [ "$EXTERNAL" != "1" ]; then
+    if [ ! -x "$WEBSERV" ]; then
+        echo -e "${RED}❌ Error: $WEBSERV not found or not executable.${RESET}"
+        exit 1
+    fi
+    echo -e "${CYAN}🚀 Starting $WEBSERV${RESET}"
+    "$WEBSERV" >/dev/null 2>&1 &
+    server_pid=$!
+fi
+
+# Wait up to 5 seconds for the listening socket
+for _ in $(seq 50); do
+    if (exec 3<>"/dev/tcp/$HOST/$PORT") 2>/dev/null; then
+        break
+    fi
+    if [ -n "$server_pid" ] && ! kill -0 "$server_pid" 2>/dev/null; then
+        echo -e "${RED}❌ Error: the server exited before listening on $HOST:$PORT.${RESET}"
+        exit 1
+    fi
+    sleep 0.1
+done
+
+echo -e "${CYAN}📈 Loading http://$HOST:$PORT${RESET}"
+if "$WEBSERV_LOAD" -h "$HOST" -p "$PORT" "$@"; then
+    echo -e "${GREEN}✅ Load test finished without errors.${RESET}"
+else
+    echo -e "${RED}❌ Load test reported errors.${RESET}"
+    exit 1
+fi
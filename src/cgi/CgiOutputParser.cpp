@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiOutputParser.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:00:25 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:00:25 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    CgiOutputParser.cpp
+ * @brief   Implements the CgiOutputParser.
+ *
+ * @ingroup cgi
+ */
+
+#include "cgi/CgiOutputParser.hpp"
+#include "utils/StringUtils.hpp"
+
+namespace {
+
+// Fields the server frames or sends on its own
+constexpr std::string_view DROPPED_FIELDS[] = {"Connection", "Keep-Alive", "Transfer-Encoding",
+                                               "Date", "Server"};
+
+bool isTokenChar(char c) noexcept {
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+        return true;
+    return std::string_view("!#$%&'*+-.^_`|~").find(c) != std::string_view::npos;
+}
+
+} // namespace
+
+CgiOutputParser::CgiOutputParser()
+    : _scanned(0), _status(200), _has_length(false), _content_length(0) {
+}
+
+CgiOutputParser::Result CgiOutputParser::feed(std::string_view data) {
+    _buffer.append(data.data(), data.size());
+
+    // The block ends with an empty line: LF LF, or LF CR LF
+    std::size_t end = std::string::npos;
+    std::size_t skip = 0;
+    for (std::size_t i = _scanned; i < _buffer.size(); ++i) {
+        if (_buffer[i] != '\n')
+            continue;
+        if (i + 1 < _buffer.size() && _buffer[i + 1] == '\n') {
+            end  = i + 1;
+            skip = 1;
+            break;
+        }
+        if (i + 2 < _buffer.size() && _buffer[i + 1] == '\r' && _buffer[i + 2] == '\n') {
+            end  = i + 1;
+            skip = 2;
+            break;
+        }
+    }
+    if (end == std::string::npos) {
+        if (_buffer.size() > MAX_HEAD_SIZE)
+            return Result::ERROR;
+        _scanned = _buffer.size() > 2 ? _buffer.size() - 2 : 0;
+        return Result::INCOMPLETE;
+    }
+    if (end > MAX_HEAD_SIZE || !parseHead(std::string_view(_buffer).substr(0, end)))
+        return Result::ERROR;
+    _buffer.erase(0, end + skip);
+    return Result::COMPLETE;
+}
+
+bool CgiOutputParser::parseHead(std::string_view head) {
+    bool has_status = false;
+    bool redirect   = false;
+    while (!head.empty()) {
+        const std::size_t eol  = head.find('\n');
+        std::string_view  line = head.substr(0, eol);
+        head.remove_prefix(eol == std::string_view::npos ? head.size() : eol + 1);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
+        const std::size_t colon = line.find(':');
+        if (colon == std::string_view::npos || colon == 0)
+            return false;
+        const std::string_view name  = line.substr(0, colon);
+        const std::string_view value = trim(line.substr(colon + 1));
+        if (iequals(name, "Status")) {
+            // "Status: 404 Not Found": three digits, then an optional reason phrase
+            std::size_t status = 0;
+            if (value.size() < 3 || (value.size() > 3 && value[3] != ' ') ||
+                !parseSize(value.substr(0, 3), status) || status < 100)
+                return false;
+            _status    = static_cast<int>(status);
+            has_status = true;
+            continue;
+        }
+        if (!parseField(line))
+            return false;
+        redirect = redirect || iequals(name, "Location");
+    }
+    if (redirect && !has_status)
+        _status = 302;
+    return true;
+}
+
+bool CgiOutputParser::parseField(std::string_view line) {
+    const std::size_t      colon = line.find(':');
+    const std::string_view name  = line.substr(0, colon);
+    const std::string_view value = trim(line.substr(colon + 1));
+    for (char c : name) {
+        if (!isTokenChar(c))
+            return false;
+    }
+    if (iequals(name, "Content-Length")) {
+        if (!parseSize(value, _content_length))
+            return false;
+        _has_length = true;
+        return true;
+    }
+    for (std::string_view dropped : DROPPED_FIELDS) {
+        if (iequals(name, dropped))
+            return true;
+    }
+    _fields.emplace_back(std::string(name), std::string(value));
+    return true;
+}
+
+int CgiOutputParser::getStatus() const noexcept {
+    return _status;
+}
+
+const std::vector<CgiOutputParser::Field>& CgiOutputParser::getFields() const noexcept {
+    return _fields;
+}
+
+bool CgiOutputParser::hasContentLength() const noexcept {
+    return _has_length;
+}
+
+std::size_t CgiOutputParser::getContentLength() const noexcept {
+    return _content_length;
+}
+
+std::string CgiOutputParser::takeBody() noexcept {
+    return std::move(_buffer);
+}
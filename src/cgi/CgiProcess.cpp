@@ -0,0 +1,285 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiProcess.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:00:25 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:44:24 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    CgiProcess.cpp
+ * @brief   Implements the CgiProcess class.
+ *
+ * @ingroup cgi
+ */
+
+#include "cgi/CgiProcess.hpp"
+#include "utils/StringUtils.hpp"
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr long MAX_INHERITED_FD = 65536; ///< Bound of the close() loop without close_range().
+
+// Pipe whose ends are closed on exec; the caller picks the non-blocking end
+bool makePipe(int fds[2]) noexcept {
+#if defined(__linux__)
+    return pipe2(fds, O_CLOEXEC) == 0;
+#else
+    if (pipe(fds) < 0)
+        return false;
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return true;
+#endif
+}
+
+void closeFd(int& fd) noexcept {
+    if (fd >= 0)
+        close(fd);
+    fd = -1;
+}
+
+// Child side: client sockets and cached files must not leak into the script
+void closeInheritedFds() noexcept {
+#if defined(__linux__) && defined(SYS_close_range)
+    if (syscall(SYS_close_range, 3U, ~0U, 0U) == 0)
+        return;
+#endif
+    long max = sysconf(_SC_OPEN_MAX);
+    if (max < 0 || max > MAX_INHERITED_FD)
+        max = MAX_INHERITED_FD;
+    for (int fd = 3; fd < max; ++fd)
+        close(fd);
+}
+
+// "User-Agent" -> "HTTP_USER_AGENT=" (RFC 3875, section 4.1.18)
+std::string protocolVariable(std::string_view name) {
+    std::string variable = "HTTP_";
+    variable.reserve(variable.size() + name.size() + 1);
+    for (char c : name)
+        variable += c == '-' ? '_' : static_cast<char>(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+    variable += '=';
+    return variable;
+}
+
+std::string variable(std::string_view name, std::string_view value) {
+    std::string entry(name);
+    entry += '=';
+    entry.append(value.data(), value.size());
+    return entry;
+}
+
+} // namespace
+
+CgiProcess::CgiProcess() noexcept : _pid(-1), _in_fd(-1), _out_fd(-1) {
+}
+
+CgiProcess::~CgiProcess() {
+    closeInput();
+    closeOutput();
+    if (!reap()) {
+        terminate();
+        reap();
+    }
+}
+
+CgiProcess::Command CgiProcess::makeCommand(const HttpRequest& request, const Server& server,
+                                            const Location& location,
+                                            std::string_view script_name,
+                                            std::string_view script_filename,
+                                            std::string_view path_info,
+                                            std::string_view remote_addr) {
+    Command command;
+
+    // The script runs in its own directory, so its path must not be relative
+    std::string filename(script_filename);
+    if (filename.empty() || filename[0] != '/') {
+        char cwd[4096];
+        if (getcwd(cwd, sizeof(cwd)))
+            filename = std::string(cwd) + "/" + filename;
+    }
+    command.directory = filename.substr(0, filename.rfind('/') + 1);
+    if (!location.getCgiInterpreter().empty())
+        command.argv.push_back(location.getCgiInterpreter());
+    command.argv.push_back(filename);
+
+    std::vector<std::string>& env = command.environment;
+    env.reserve(16 + request.getHeaderCount());
+    env.push_back("GATEWAY_INTERFACE=CGI/1.1");
+    env.push_back("SERVER_SOFTWARE=webserv");
+    env.push_back("SERVER_PROTOCOL=HTTP/" + std::to_string(request.getVersionMajor()) + "." +
+                  std::to_string(request.getVersionMinor()));
+    const std::string_view host = request.getHost();
+    env.push_back(
+        variable("SERVER_NAME", host.empty() ? std::string_view(server.getHost()) : host));
+    env.push_back("SERVER_PORT=" + std::to_string(server.getPort()));
+    env.push_back(variable("REQUEST_METHOD", request.getMethodName()));
+    env.push_back(variable("REQUEST_URI", request.getTarget()));
+    env.push_back(variable("QUERY_STRING", request.getQuery()));
+    env.push_back(variable("SCRIPT_NAME", script_name));
+    env.push_back(variable("SCRIPT_FILENAME", filename));
+    env.push_back(variable("PATH_INFO", path_info));
+    if (!path_info.empty()) {
+        // PATH_INFO is a URI path too: it maps under the root like any other
+        std::string translated = location.getRoot();
+        if (!translated.empty() && translated.back() == '/')
+            translated.pop_back();
+        translated.append(path_info.data(), path_info.size());
+        env.push_back(variable("PATH_TRANSLATED", translated));
+    }
+    env.push_back(variable("REMOTE_ADDR", remote_addr));
+    env.push_back("REDIRECT_STATUS=200"); // php-cgi refuses to run without it
+    env.push_back("PATH=/usr/local/bin:/usr/bin:/bin");
+    if (request.hasContentLength())
+        env.push_back("CONTENT_LENGTH=" + std::to_string(request.getContentLength()));
+
+    for (std::size_t i = 0; i < request.getHeaderCount(); ++i) {
+        const std::string_view name = request.getHeaderName(i);
+        if (iequals(name, "Content-Type")) {
+            env.push_back(variable("CONTENT_TYPE", request.getHeaderValue(i)));
+            continue;
+        }
+        // Framing is the server's business; HTTP_PROXY would hijack the script's proxy
+        if (iequals(name, "Content-Length") || iequals(name, "Proxy"))
+            continue;
+        std::string entry = protocolVariable(name);
+        const std::string_view value = request.getHeaderValue(i);
+        entry.append(value.data(), value.size());
+        env.push_back(std::move(entry));
+    }
+    return command;
+}
+
+bool CgiProcess::start(const Command& command) {
+    // Everything the child touches is prepared first: only async-signal-safe calls after fork()
+    std::vector<char*> argv;
+    for (const std::string& arg : command.argv)
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(NULL);
+    std::vector<char*> envp;
+    for (const std::string& entry : command.environment)
+        envp.push_back(const_cast<char*>(entry.c_str()));
+    envp.push_back(NULL);
+
+    int in[2];
+    int out[2];
+    if (!makePipe(in))
+        return false;
+    if (!makePipe(out)) {
+        const int saved = errno;
+        close(in[0]);
+        close(in[1]);
+        errno = saved;
+        return false;
+    }
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        const int saved = errno;
+        close(in[0]);
+        close(in[1]);
+        close(out[0]);
+        close(out[1]);
+        errno = saved;
+        return false;
+    }
+    if (pid == 0) {
+        setpgid(0, 0);
+        if (dup2(in[0], STDIN_FILENO) < 0 || dup2(out[1], STDOUT_FILENO) < 0)
+            _exit(127);
+        closeInheritedFds();
+
+        // Undo what the server set up for itself: blocked stop signals, ignored SIGPIPE
+        sigset_t none;
+        sigemptyset(&none);
+        sigprocmask(SIG_SETMASK, &none, NULL);
+        signal(SIGPIPE, SIG_DFL);
+
+        if (!command.directory.empty() && chdir(command.directory.c_str()) < 0)
+            _exit(127);
+        execve(argv[0], argv.data(), envp.data());
+        _exit(127);
+    }
+
+    setpgid(pid, pid); // Also from the parent, so terminate() works right away
+    close(in[0]);
+    close(out[1]);
+    fcntl(in[1], F_SETFL, O_NONBLOCK);
+    fcntl(out[0], F_SETFL, O_NONBLOCK);
+    _pid     = pid;
+    _in_fd   = in[1];
+    _out_fd  = out[0];
+    _started = Clock::now();
+    return true;
+}
+
+ssize_t CgiProcess::writeInput(const char* data, std::size_t size) noexcept {
+    ssize_t written;
+    do {
+        written = write(_in_fd, data, size);
+    } while (written < 0 && errno == EINTR);
+    return written;
+}
+
+ssize_t CgiProcess::readOutput(char* buf, std::size_t size) noexcept {
+    ssize_t got;
+    do {
+        got = read(_out_fd, buf, size);
+    } while (got < 0 && errno == EINTR);
+    return got;
+}
+
+void CgiProcess::closeInput() noexcept {
+    closeFd(_in_fd);
+}
+
+bool CgiProcess::hasInput() const noexcept {
+    return _in_fd >= 0;
+}
+
+void CgiProcess::closeOutput() noexcept {
+    closeFd(_out_fd);
+}
+
+void CgiProcess::terminate() noexcept {
+    if (_pid > 0)
+        kill(-_pid, SIGKILL);
+}
+
+bool CgiProcess::reap() noexcept {
+    if (_pid <= 0)
+        return true;
+    int         status = 0;
+    const pid_t done   = waitpid(_pid, &status, WNOHANG);
+    if (done == _pid || (done < 0 && errno == ECHILD)) {
+        _pid = -1;
+        return true;
+    }
+    return false;
+}
+
+int CgiProcess::getInputFd() const noexcept {
+    return _in_fd;
+}
+
+int CgiProcess::getOutputFd() const noexcept {
+    return _out_fd;
+}
+
+pid_t CgiProcess::getPid() const noexcept {
+    return _pid;
+}
+
+CgiProcess::Clock::time_point CgiProcess::getStartTime() const noexcept {
+    return _started;
+}
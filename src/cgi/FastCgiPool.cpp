@@ -0,0 +1,568 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiPool.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:11:35 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:25:50 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    FastCgiPool.cpp
+ * @brief   Implements the FastCgiPool and FastCgiStream classes.
+ *
+ * @details Links (backend connections) are never destroyed while a caller may
+ * still hold them: failing or closing one only closes its socket, and the dead
+ * links are pruned at the pool's entry points.
+ *
+ * @ingroup cgi
+ */
+
+#include "cgi/FastCgiPool.hpp"
+#include "network/SocketAddress.hpp"
+#include "utils/Logger.hpp"
+#include "utils/StringUtils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t READ_CHUNK = 16384; ///< Bytes requested per recv() from a backend.
+
+} // namespace
+
+/// One backend connection and the requests it carries.
+struct FastCgiPool::Link {
+    /// Request id in use; the stream is NULL once it was aborted.
+    struct Slot {
+        FastCgiStream* stream = NULL; ///< Request owner, or NULL.
+        bool           busy   = false; ///< Id taken until END_REQUEST.
+    };
+
+    Backend*                      backend;    ///< Address the link connects to.
+    int                           fd;         ///< Socket, -1 once closed.
+    bool                          connected;  ///< Non-blocking connect() finished.
+    std::string                   out;        ///< Encoded records not sent yet.
+    std::size_t                   sent;       ///< Bytes of out already sent.
+    FastCgiReader                 reader;     ///< Records received.
+    std::vector<Slot>             slots;      ///< Indexed by request id - 1.
+    std::size_t                   busy;       ///< Slots in use.
+    std::size_t                   capacity;   ///< Concurrent requests allowed.
+    bool                          paused;     ///< A stream's unread output is full.
+    std::uint32_t                 interest;   ///< Registered PollManager interest.
+    CgiChannel::Clock::time_point idle_since; ///< When busy last dropped to 0.
+};
+
+// --- FastCgiPool ---
+
+constexpr std::size_t FastCgiPool::MAX_CONNECTIONS;
+constexpr std::size_t FastCgiPool::MAX_STREAMS;
+constexpr std::size_t FastCgiPool::SEND_BUFFER;
+constexpr std::size_t FastCgiPool::OUTPUT_BUFFER;
+
+FastCgiPool::FastCgiPool(PollManager& poller) : _poller(poller) {
+}
+
+FastCgiPool::~FastCgiPool() {
+    // Streams that outlive the pool must not call back into it
+    for (auto& entry : _backends) {
+        for (std::unique_ptr<Link>& link : entry.second->links) {
+            for (Link::Slot& slot : link->slots) {
+                if (slot.stream)
+                    slot.stream->_error = ECANCELED;
+            }
+            if (link->fd >= 0)
+                closeLink(*link);
+        }
+        for (FastCgiStream* stream : entry.second->waiting)
+            stream->_error = ECANCELED;
+    }
+}
+
+std::unique_ptr<FastCgiStream> FastCgiPool::open(const std::string& address, int owner,
+                                                 std::vector<std::string> params) {
+    Backend* backend = findBackend(address);
+    if (!backend) {
+        errno = EINVAL;
+        return NULL;
+    }
+    prune(*backend);
+    std::unique_ptr<FastCgiStream> stream(new FastCgiStream(*this, owner, std::move(params)));
+    schedule(*backend, *stream);
+    return stream;
+}
+
+bool FastCgiPool::handleEvent(int fd, std::uint32_t events) {
+    const std::size_t slot = static_cast<std::size_t>(fd);
+    if (fd < 0 || slot >= _by_fd.size() || !_by_fd[slot])
+        return false;
+    Link&    link    = *_by_fd[slot];
+    Backend& backend = *link.backend;
+
+    if (!link.connected) {
+        int       error  = 0;
+        socklen_t length = sizeof(error);
+        if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) < 0)
+            error = errno;
+        if (error) {
+            failLink(link, error);
+        } else if (events & (PollManager::EVENT_WRITE | PollManager::EVENT_HUP |
+                             PollManager::EVENT_ERROR)) {
+            link.connected = true;
+        }
+    }
+    if (link.fd >= 0 && link.connected &&
+        (events & (PollManager::EVENT_READ | PollManager::EVENT_HUP | PollManager::EVENT_ERROR)))
+        readLink(link);
+    if (link.fd >= 0)
+        flush(link);
+    prune(backend);
+    return true;
+}
+
+bool FastCgiPool::takeWoken(std::vector<int>& owners) {
+    owners.clear();
+    owners.swap(_woken);
+    return !owners.empty();
+}
+
+void FastCgiPool::closeIdle(CgiChannel::Clock::time_point now) {
+    for (auto& entry : _backends) {
+        for (std::unique_ptr<Link>& link : entry.second->links) {
+            if (link->fd >= 0 && link->connected && link->busy == 0 &&
+                now - link->idle_since >= std::chrono::seconds(IDLE_TIMEOUT))
+                closeLink(*link);
+        }
+        prune(*entry.second);
+    }
+}
+
+std::size_t FastCgiPool::getConnectionCount() const noexcept {
+    std::size_t count = 0;
+    for (const auto& entry : _backends) {
+        for (const std::unique_ptr<Link>& link : entry.second->links)
+            count += link->fd >= 0;
+    }
+    return count;
+}
+
+FastCgiPool::Backend* FastCgiPool::findBackend(const std::string& address) {
+    auto found = _backends.find(address);
+    if (found != _backends.end())
+        return found->second.get();
+    std::unique_ptr<Backend> backend(new Backend());
+    if (!parseSocketAddress(address, backend->addr, backend->length))
+        return NULL;
+    Backend* raw = backend.get();
+    _backends.emplace(address, std::move(backend));
+    return raw;
+}
+
+// A link with room, else a new link, else the queue
+void FastCgiPool::schedule(Backend& backend, FastCgiStream& stream) {
+    for (std::unique_ptr<Link>& link : backend.links) {
+        if (link->fd >= 0 && link->busy < link->capacity) {
+            attach(*link, stream);
+            return;
+        }
+    }
+    std::size_t open = 0;
+    for (const std::unique_ptr<Link>& link : backend.links)
+        open += link->fd >= 0;
+    if (open < MAX_CONNECTIONS) {
+        if (Link* link = connectLink(backend)) {
+            attach(*link, stream);
+            return;
+        }
+        if (open == 0) {
+            LOG_ERROR("FastCGI: connect() failed: %s", strerror(errno));
+            stream._error = errno;
+            wake(stream);
+            return;
+        }
+    }
+    backend.waiting.push_back(&stream);
+}
+
+FastCgiPool::Link* FastCgiPool::connectLink(Backend& backend) {
+    const int fd = socket(backend.addr.ss_family, SOCK_STREAM, 0);
+    if (fd < 0)
+        return NULL;
+    if (fcntl(fd, F_SETFL, O_NONBLOCK) < 0 || fcntl(fd, F_SETFD, FD_CLOEXEC) < 0 ||
+        (connect(fd, reinterpret_cast<const sockaddr*>(&backend.addr), backend.length) < 0 &&
+         errno != EINPROGRESS)) {
+        const int saved = errno;
+        close(fd);
+        errno = saved;
+        return NULL;
+    }
+
+    std::unique_ptr<Link> link(new Link());
+    link->backend   = &backend;
+    link->fd        = fd;
+    link->connected = false; // Confirmed by the first write event, even for local sockets
+    link->sent      = 0;
+    link->slots.resize(MAX_STREAMS);
+    link->busy       = 0;
+    link->capacity   = 1; // Until the backend says it multiplexes
+    link->paused     = false;
+    link->interest   = PollManager::EVENT_WRITE;
+    link->idle_since = CgiChannel::Clock::now();
+    appendFastCgiGetValues(link->out);
+    try {
+        _poller.add(fd, link->interest);
+    } catch (const PollManager::PollError& e) {
+        LOG_ERROR("%s", e.what());
+        close(fd);
+        errno = EIO;
+        return NULL;
+    }
+    const std::size_t slot = static_cast<std::size_t>(fd);
+    if (slot >= _by_fd.size())
+        _by_fd.resize(slot + 1, NULL);
+    _by_fd[slot] = link.get();
+    backend.links.push_back(std::move(link));
+    return backend.links.back().get();
+}
+
+// Queue BEGIN_REQUEST and PARAMS; the body follows as the stream is written
+void FastCgiPool::attach(Link& link, FastCgiStream& stream) {
+    std::size_t index = 0;
+    while (link.slots[index].busy)
+        ++index;
+    link.slots[index].stream = &stream;
+    link.slots[index].busy   = true;
+    ++link.busy;
+    stream._link = &link;
+    stream._id   = static_cast<std::uint16_t>(index + 1);
+
+    appendFastCgiBegin(link.out, stream._id);
+    appendFastCgiParams(link.out, stream._id, stream._params);
+    std::vector<std::string>().swap(stream._params);
+    if (!stream._input_open)
+        appendFastCgiStream(link.out, FastCgiType::STDIN, stream._id, std::string_view());
+    wake(stream); // Body bytes can be written now
+    flush(link);
+}
+
+void FastCgiPool::detach(FastCgiStream& stream) noexcept {
+    if (!stream._link) {
+        for (auto& entry : _backends) {
+            std::deque<FastCgiStream*>& waiting = entry.second->waiting;
+            waiting.erase(std::remove(waiting.begin(), waiting.end(), &stream), waiting.end());
+        }
+        return;
+    }
+    Link& link   = *stream._link;
+    stream._link = NULL;
+    if (link.busy == 1) {
+        closeLink(link); // Stops the script outright, and no other request is affected
+        Backend& backend = *link.backend;
+        if (!backend.waiting.empty()) {
+            FastCgiStream* next = backend.waiting.front();
+            backend.waiting.pop_front();
+            schedule(backend, *next);
+        }
+        return;
+    }
+    // The id stays taken until the backend confirms with END_REQUEST
+    link.slots[stream._id - 1].stream = NULL;
+    appendFastCgiAbort(link.out, stream._id);
+    flush(link);
+}
+
+void FastCgiPool::flush(Link& link) {
+    if (link.fd < 0 || !link.connected) {
+        updateInterest(link);
+        return;
+    }
+    while (link.sent < link.out.size()) {
+        const ssize_t n =
+            send(link.fd, link.out.data() + link.sent, link.out.size() - link.sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (n < 0) {
+            failLink(link, errno);
+            return;
+        }
+        link.sent += static_cast<std::size_t>(n);
+    }
+    if (link.sent == link.out.size()) {
+        link.out.clear();
+        link.sent = 0;
+    } else if (link.sent >= SEND_BUFFER) {
+        link.out.erase(0, link.sent);
+        link.sent = 0;
+    }
+    if (queuedBytes(link) < SEND_BUFFER) {
+        for (Link::Slot& slot : link.slots) {
+            if (slot.stream && slot.stream->_want_write) {
+                slot.stream->_want_write = false;
+                wake(*slot.stream);
+            }
+        }
+    }
+    updateInterest(link);
+}
+
+void FastCgiPool::readLink(Link& link) {
+    char buf[READ_CHUNK];
+    while (link.fd >= 0 && !link.paused) {
+        const ssize_t n = recv(link.fd, buf, sizeof(buf), 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (n <= 0) {
+            // An idle link closed by the backend is just dropped
+            if (n == 0 && link.busy == 0)
+                closeLink(link);
+            else
+                failLink(link, n == 0 ? ECONNRESET : errno);
+            return;
+        }
+        link.reader.feed(std::string_view(buf, static_cast<std::size_t>(n)));
+        FastCgiReader::Record  record;
+        FastCgiReader::Result  result;
+        while ((result = link.reader.next(record)) == FastCgiReader::Result::RECORD) {
+            if (!handleRecord(link, record))
+                return;
+        }
+        if (result == FastCgiReader::Result::ERROR) {
+            failLink(link, EPROTO);
+            return;
+        }
+    }
+    updateInterest(link);
+}
+
+bool FastCgiPool::handleRecord(Link& link, const FastCgiReader::Record& record) {
+    if (record.type == FastCgiType::GET_VALUES_RESULT) {
+        std::string_view content = record.content;
+        std::string_view name;
+        std::string_view value;
+        bool             multiplexed = false;
+        std::size_t      max_reqs    = MAX_STREAMS;
+        while (nextFastCgiPair(content, name, value)) {
+            std::size_t count = 0;
+            if (name == "FCGI_MPXS_CONNS")
+                multiplexed = value == "1";
+            else if (name == "FCGI_MAX_REQS" && parseSize(value, count) && count > 0)
+                max_reqs = count;
+        }
+        link.capacity = multiplexed ? std::min(max_reqs, MAX_STREAMS) : 1;
+        while (link.fd >= 0 && link.busy < link.capacity && !link.backend->waiting.empty()) {
+            FastCgiStream* next = link.backend->waiting.front();
+            link.backend->waiting.pop_front();
+            attach(link, *next);
+        }
+        return link.fd >= 0;
+    }
+    if (record.id == FCGI_MANAGEMENT_ID || record.id > link.slots.size() ||
+        !link.slots[record.id - 1u].busy)
+        return true; // UNKNOWN_TYPE, or a record for no request of ours
+    FastCgiStream* stream = link.slots[record.id - 1u].stream;
+
+    if (record.type == FastCgiType::STDOUT && stream) {
+        stream->_output.append(record.content.data(), record.content.size());
+        if (stream->_output.size() - stream->_output_read >= OUTPUT_BUFFER)
+            link.paused = true; // Its client is slow; the other requests wait as well
+        wake(*stream);
+    } else if (record.type == FastCgiType::STDERR && !record.content.empty()) {
+        std::string_view message = record.content;
+        while (!message.empty() && (message.back() == '\n' || message.back() == '\r'))
+            message.remove_suffix(1);
+        LOG_WARN("FastCGI: %.*s", static_cast<int>(message.size()), message.data());
+    } else if (record.type == FastCgiType::END_REQUEST) {
+        const std::uint8_t status =
+            record.content.size() > 4 ? static_cast<std::uint8_t>(record.content[4]) : 0;
+        if (status != FCGI_REQUEST_COMPLETE) {
+            link.capacity = 1; // FCGI_CANT_MPX_CONN, FCGI_OVERLOADED or FCGI_UNKNOWN_ROLE
+            if (stream)
+                stream->_error = EBUSY;
+        }
+        endStream(link, record.id);
+    }
+    return link.fd >= 0;
+}
+
+// Free the request id and give the link to the next waiting request
+void FastCgiPool::endStream(Link& link, std::uint16_t id) {
+    Link::Slot& slot = link.slots[id - 1u];
+    if (FastCgiStream* stream = slot.stream) {
+        stream->_ended = true;
+        stream->_link  = NULL;
+        wake(*stream);
+    }
+    slot.stream = NULL;
+    slot.busy   = false;
+    if (--link.busy == 0)
+        link.idle_since = CgiChannel::Clock::now();
+    resumeRead(link); // The ended stream may be the one that paused it; a full one pauses again
+    while (link.fd >= 0 && link.busy < link.capacity && !link.backend->waiting.empty()) {
+        FastCgiStream* next = link.backend->waiting.front();
+        link.backend->waiting.pop_front();
+        attach(link, *next);
+    }
+}
+
+void FastCgiPool::failLink(Link& link, int error) {
+    LOG_ERROR("FastCGI: backend connection failed: %s", strerror(error));
+    for (Link::Slot& slot : link.slots) {
+        if (slot.stream) {
+            slot.stream->_error = error;
+            wake(*slot.stream);
+        }
+    }
+    closeLink(link);
+
+    // Queued requests get a fresh connection, or the failure if none can be made
+    Backend&                   backend = *link.backend;
+    std::deque<FastCgiStream*> waiting;
+    waiting.swap(backend.waiting);
+    for (FastCgiStream* stream : waiting)
+        schedule(backend, *stream);
+}
+
+void FastCgiPool::closeLink(Link& link) {
+    for (Link::Slot& slot : link.slots) {
+        if (slot.stream)
+            slot.stream->_link = NULL;
+        slot = Link::Slot();
+    }
+    link.busy = 0;
+    _poller.remove(link.fd);
+    close(link.fd);
+    _by_fd[static_cast<std::size_t>(link.fd)] = NULL;
+    link.fd = -1;
+}
+
+void FastCgiPool::prune(Backend& backend) {
+    backend.links.erase(std::remove_if(backend.links.begin(), backend.links.end(),
+                                       [](const std::unique_ptr<Link>& link) {
+                                           return link->fd < 0;
+                                       }),
+                        backend.links.end());
+}
+
+// Connecting: wait for writability; then read unless paused, write while records wait
+void FastCgiPool::updateInterest(Link& link) {
+    if (link.fd < 0)
+        return;
+    std::uint32_t interest = PollManager::EVENT_WRITE;
+    if (link.connected) {
+        interest = link.paused ? 0 : PollManager::EVENT_READ;
+        if (queuedBytes(link) > 0)
+            interest |= PollManager::EVENT_WRITE;
+    }
+    if (interest != link.interest) {
+        _poller.modify(link.fd, interest);
+        link.interest = interest;
+    }
+}
+
+void FastCgiPool::resumeRead(Link& link) {
+    if (!link.paused)
+        return;
+    link.paused = false;
+    updateInterest(link); // Re-arming reports the bytes left in the socket
+}
+
+void FastCgiPool::wake(FastCgiStream& stream) {
+    _woken.push_back(stream._owner);
+}
+
+std::size_t FastCgiPool::queuedBytes(const Link& link) const noexcept {
+    return link.out.size() - link.sent;
+}
+
+// --- FastCgiStream ---
+
+FastCgiStream::FastCgiStream(FastCgiPool& pool, int owner, std::vector<std::string> params)
+    : _pool(pool), _link(NULL), _id(0), _owner(owner), _params(std::move(params)),
+      _output_read(0), _input_open(true), _ended(false), _error(0), _want_write(false),
+      _started(Clock::now()) {
+}
+
+FastCgiStream::~FastCgiStream() {
+    if (!_ended && !_error)
+        _pool.detach(*this);
+}
+
+ssize_t FastCgiStream::writeInput(const char* data, std::size_t size) noexcept {
+    if (_error || _ended || !_input_open) {
+        errno = EPIPE; // The backend answered without reading the whole body
+        return -1;
+    }
+    const std::size_t queued = _link ? _pool.queuedBytes(*_link) : FastCgiPool::SEND_BUFFER;
+    if (queued >= FastCgiPool::SEND_BUFFER) {
+        _want_write = true;
+        errno       = EAGAIN;
+        return -1;
+    }
+    const std::size_t accepted = std::min(size, FastCgiPool::SEND_BUFFER - queued);
+    appendFastCgiStream(_link->out, FastCgiType::STDIN, _id, std::string_view(data, accepted));
+    _pool.flush(*_link);
+    return static_cast<ssize_t>(accepted);
+}
+
+ssize_t FastCgiStream::readOutput(char* buf, std::size_t size) noexcept {
+    const std::size_t unread = _output.size() - _output_read;
+    if (unread > 0) {
+        const std::size_t n = std::min(size, unread);
+        std::memcpy(buf, _output.data() + _output_read, n);
+        _output_read += n;
+        if (_output_read == _output.size()) {
+            _output.clear();
+            _output_read = 0;
+        }
+        if (_link && unread - n < FastCgiPool::OUTPUT_BUFFER)
+            _pool.resumeRead(*_link);
+        return static_cast<ssize_t>(n);
+    }
+    if (_error) {
+        errno = _error;
+        return -1;
+    }
+    if (_ended)
+        return 0;
+    errno = EAGAIN;
+    return -1;
+}
+
+void FastCgiStream::closeInput() noexcept {
+    if (!_input_open)
+        return;
+    _input_open = false;
+    if (_link && !_error && !_ended) {
+        appendFastCgiStream(_link->out, FastCgiType::STDIN, _id, std::string_view());
+        _pool.flush(*_link);
+    }
+}
+
+bool FastCgiStream::hasInput() const noexcept {
+    return _input_open && !_error && !_ended;
+}
+
+void FastCgiStream::terminate() noexcept {
+    if (_ended || _error)
+        return;
+    _pool.detach(*this);
+    _error = ECANCELED;
+}
+
+CgiChannel::Clock::time_point FastCgiStream::getStartTime() const noexcept {
+    return _started;
+}
+
+int FastCgiStream::getOwner() const noexcept {
+    return _owner;
+}
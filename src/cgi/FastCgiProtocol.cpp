@@ -0,0 +1,172 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiProtocol.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:11:35 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:11:35 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    FastCgiProtocol.cpp
+ * @brief   Implements the FastCGI record encoders and the FastCgiReader.
+ *
+ * @ingroup cgi
+ */
+
+#include "cgi/FastCgiProtocol.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr char PADDING[8] = {};
+
+void appendHeader(std::string& out, FastCgiType type, std::uint16_t id, std::size_t length,
+                  std::size_t padding) {
+    const char header[FCGI_HEADER_SIZE] = {
+        static_cast<char>(FCGI_VERSION),     static_cast<char>(type),
+        static_cast<char>(id >> 8),          static_cast<char>(id & 0xFF),
+        static_cast<char>(length >> 8),      static_cast<char>(length & 0xFF),
+        static_cast<char>(padding),          0};
+    out.append(header, sizeof(header));
+}
+
+// Content padded to a multiple of 8 bytes, as the specification recommends
+void appendRecord(std::string& out, FastCgiType type, std::uint16_t id, std::string_view content) {
+    const std::size_t padding = (8 - content.size() % 8) % 8;
+    appendHeader(out, type, id, content.size(), padding);
+    out.append(content.data(), content.size());
+    out.append(PADDING, padding);
+}
+
+void appendLength(std::string& out, std::size_t length) {
+    if (length < 128) {
+        out += static_cast<char>(length);
+        return;
+    }
+    out += static_cast<char>(((length >> 24) & 0x7F) | 0x80);
+    out += static_cast<char>((length >> 16) & 0xFF);
+    out += static_cast<char>((length >> 8) & 0xFF);
+    out += static_cast<char>(length & 0xFF);
+}
+
+void appendPair(std::string& out, std::string_view name, std::string_view value) {
+    appendLength(out, name.size());
+    appendLength(out, value.size());
+    out.append(name.data(), name.size());
+    out.append(value.data(), value.size());
+}
+
+bool readLength(std::string_view& content, std::size_t& length) {
+    if (content.empty())
+        return false;
+    const unsigned char first = static_cast<unsigned char>(content[0]);
+    if (first < 128) {
+        length = first;
+        content.remove_prefix(1);
+        return true;
+    }
+    if (content.size() < 4)
+        return false;
+    length = (static_cast<std::size_t>(first & 0x7F) << 24) |
+             (static_cast<std::size_t>(static_cast<unsigned char>(content[1])) << 16) |
+             (static_cast<std::size_t>(static_cast<unsigned char>(content[2])) << 8) |
+             static_cast<std::size_t>(static_cast<unsigned char>(content[3]));
+    content.remove_prefix(4);
+    return true;
+}
+
+} // namespace
+
+void appendFastCgiStream(std::string& out, FastCgiType type, std::uint16_t id,
+                         std::string_view content) {
+    if (content.empty()) {
+        appendRecord(out, type, id, content);
+        return;
+    }
+    while (!content.empty()) {
+        const std::size_t length = std::min(content.size(), FCGI_MAX_CONTENT);
+        appendRecord(out, type, id, content.substr(0, length));
+        content.remove_prefix(length);
+    }
+}
+
+void appendFastCgiBegin(std::string& out, std::uint16_t id) {
+    const char body[8] = {0, static_cast<char>(FCGI_RESPONDER), static_cast<char>(FCGI_KEEP_CONN)};
+    appendRecord(out, FastCgiType::BEGIN_REQUEST, id, std::string_view(body, sizeof(body)));
+}
+
+void appendFastCgiAbort(std::string& out, std::uint16_t id) {
+    appendRecord(out, FastCgiType::ABORT_REQUEST, id, std::string_view());
+}
+
+void appendFastCgiParams(std::string& out, std::uint16_t id,
+                         const std::vector<std::string>& environment) {
+    std::string pairs;
+    for (const std::string& entry : environment) {
+        const std::size_t equals = entry.find('=');
+        if (equals == std::string::npos)
+            continue;
+        appendPair(pairs, std::string_view(entry).substr(0, equals),
+                   std::string_view(entry).substr(equals + 1));
+    }
+    if (!pairs.empty())
+        appendFastCgiStream(out, FastCgiType::PARAMS, id, pairs);
+    appendFastCgiStream(out, FastCgiType::PARAMS, id, std::string_view());
+}
+
+void appendFastCgiGetValues(std::string& out) {
+    std::string pairs;
+    appendPair(pairs, "FCGI_MPXS_CONNS", "");
+    appendPair(pairs, "FCGI_MAX_REQS", "");
+    appendRecord(out, FastCgiType::GET_VALUES, FCGI_MANAGEMENT_ID, pairs);
+}
+
+bool nextFastCgiPair(std::string_view& content, std::string_view& name, std::string_view& value) {
+    std::string_view rest = content;
+    std::size_t      name_length;
+    std::size_t      value_length;
+    if (!readLength(rest, name_length) || !readLength(rest, value_length) ||
+        rest.size() < name_length + value_length)
+        return false;
+    name    = rest.substr(0, name_length);
+    value   = rest.substr(name_length, value_length);
+    content = rest.substr(name_length + value_length);
+    return true;
+}
+
+// --- FastCgiReader ---
+
+FastCgiReader::FastCgiReader() : _offset(0) {
+}
+
+void FastCgiReader::feed(std::string_view data) {
+    // Drop returned records first, so the buffer only holds the unread tail
+    if (_offset > 0) {
+        _buffer.erase(0, _offset);
+        _offset = 0;
+    }
+    _buffer.append(data.data(), data.size());
+}
+
+FastCgiReader::Result FastCgiReader::next(Record& record) {
+    const std::string_view rest = std::string_view(_buffer).substr(_offset);
+    if (rest.size() < FCGI_HEADER_SIZE)
+        return Result::INCOMPLETE;
+    const unsigned char* header = reinterpret_cast<const unsigned char*>(rest.data());
+    if (header[0] != FCGI_VERSION)
+        return Result::ERROR;
+    const std::size_t length  = (static_cast<std::size_t>(header[4]) << 8) | header[5];
+    const std::size_t padding = header[6];
+    if (rest.size() < FCGI_HEADER_SIZE + length + padding)
+        return Result::INCOMPLETE;
+
+    record.type    = static_cast<FastCgiType>(header[1]);
+    record.id      = static_cast<std::uint16_t>((header[2] << 8) | header[3]);
+    record.content = rest.substr(FCGI_HEADER_SIZE, length);
+    _offset += FCGI_HEADER_SIZE + length + padding;
+    return Result::RECORD;
+}
@@ -20,6 +20,19 @@
  */
 
 #include "config/Config.hpp"
+#include <utility>
+
+// --- Constructor ---
+
+/**
+ * @brief Constructs an empty configuration served by a single event loop.
+ */
+Config::Config()
+    : _worker_processes(1), _worker_threads(1), _asset_cache_size(DEFAULT_ASSET_CACHE_SIZE),
+      _max_connections(DEFAULT_MAX_CONNECTIONS), _compress_budget(DEFAULT_COMPRESS_BUDGET),
+      _slow_request_ms(0), _event_backend(PollBackend::AUTO), _cpu_affinity(CpuAffinity::OFF),
+      _numa_local(false) {
+}
 
 // --- Public API ---
 
@@ -32,6 +45,24 @@ void Config::addServer(const Server& server) {
     _servers.push_back(server);
 }
 
+/**
+ * @brief Adds a server configuration without copying it.
+ *
+ * @param server A fully constructed Server instance, left empty.
+ */
+void Config::addServer(Server&& server) {
+    _servers.push_back(std::move(server));
+}
+
+/**
+ * @brief Adds a default server to be configured in place.
+ *
+ * @return The new server, at the back of the list.
+ */
+Server& Config::emplaceServer() {
+    return _servers.emplace_back();
+}
+
 /**
  * @brief Retrieves the list of configured servers.
  *
@@ -40,3 +71,107 @@ void Config::addServer(const Server& server) {
 const std::vector<Server>& Config::getServers() const {
     return _servers;
 }
+
+/**
+ * @brief Hands the server list over, e.g. to a ConfigSnapshot, without copying it.
+ *
+ * @return The former server list.
+ */
+std::vector<Server> Config::releaseServers() noexcept {
+    return std::move(_servers);
+}
+
+// --- Worker model ---
+
+void Config::setWorkerProcesses(size_t count) {
+    _worker_processes = count;
+}
+
+void Config::setWorkerThreads(size_t count) {
+    _worker_threads = count;
+}
+
+size_t Config::getWorkerProcesses() const noexcept {
+    return _worker_processes;
+}
+
+size_t Config::getWorkerThreads() const noexcept {
+    return _worker_threads;
+}
+
+void Config::setEventBackend(PollBackend backend) {
+    _event_backend = backend;
+}
+
+PollBackend Config::getEventBackend() const noexcept {
+    return _event_backend;
+}
+
+// --- CPU placement ---
+
+void Config::setCpuAffinity(CpuAffinity mode, std::vector<unsigned> cpus) {
+    _cpu_affinity = mode;
+    _worker_cpus  = std::move(cpus);
+}
+
+void Config::setNumaLocal(bool enabled) {
+    _numa_local = enabled;
+}
+
+CpuAffinity Config::getCpuAffinity() const noexcept {
+    return _cpu_affinity;
+}
+
+const std::vector<unsigned>& Config::getWorkerCpus() const noexcept {
+    return _worker_cpus;
+}
+
+bool Config::isNumaLocal() const noexcept {
+    return _numa_local;
+}
+
+// --- Caching ---
+
+constexpr size_t Config::DEFAULT_ASSET_CACHE_SIZE;
+
+void Config::setAssetCacheSize(size_t bytes) {
+    _asset_cache_size = bytes;
+}
+
+size_t Config::getAssetCacheSize() const noexcept {
+    return _asset_cache_size;
+}
+
+// --- Limits ---
+
+constexpr size_t Config::DEFAULT_MAX_CONNECTIONS;
+
+void Config::setMaxConnections(size_t count) {
+    _max_connections = count;
+}
+
+size_t Config::getMaxConnections() const noexcept {
+    return _max_connections;
+}
+
+// --- Compression ---
+
+constexpr unsigned Config::DEFAULT_COMPRESS_BUDGET;
+
+void Config::setCompressCpuBudget(unsigned percent) {
+    _compress_budget = percent;
+}
+
+unsigned Config::getCompressCpuBudget() const noexcept {
+    return _compress_budget;
+}
+
+// --- Tracing ---
+
+void Config::setSlowRequestThreshold(size_t milliseconds) {
+    _slow_request_ms = milliseconds;
+}
+
+size_t Config::getSlowRequestThreshold() const noexcept {
+    return _slow_request_ms;
+}
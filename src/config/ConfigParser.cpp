@@ -0,0 +1,723 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ConfigParser.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: irychkov <irychkov@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/05/30 10:14:27 by irychkov          #+#    #+#             */
+/*   Updated: 2025/05/31 15:02:48 by irychkov         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    ConfigParser.cpp
+ * @brief   Implements the single-pass configuration parser.
+ *
+ * @ingroup config
+ */
+
+#include "config/ConfigParser.hpp"
+#include "http/HttpMethod.hpp"
+#include "network/SocketAddress.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace {
+
+/// Read-only mapping of a whole file, unmapped when it goes out of scope.
+class MappedFile {
+  public:
+    MappedFile() noexcept : _data(NULL), _size(0) {}
+    ~MappedFile() {
+        if (_data)
+            munmap(_data, _size);
+    }
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Returns false with errno set; an empty file maps to an empty view
+    bool open(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+            const int error = S_ISDIR(st.st_mode) ? EISDIR : errno;
+            close(fd);
+            errno = error;
+            return false;
+        }
+        _size = static_cast<std::size_t>(st.st_size);
+        if (_size) {
+            void* data = mmap(NULL, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                const int error = errno;
+                close(fd);
+                errno = error;
+                return false;
+            }
+            _data = data;
+            madvise(_data, _size, MADV_SEQUENTIAL); // Read once, front to back
+        }
+        close(fd);
+        return true;
+    }
+
+    std::string_view view() const noexcept {
+        return _data ? std::string_view(static_cast<const char*>(_data), _size)
+                     : std::string_view();
+    }
+
+  private:
+    void*       _data;
+    std::size_t _size;
+};
+
+enum class Directive : std::uint8_t {
+    ASSET_CACHE_SIZE,
+    AUTOINDEX,
+    AUTOINDEX_PAGE_SIZE,
+    CGI_EXTENSION,
+    CGI_INTERPRETER,
+    CGI_MAX_PROCESSES,
+    CGI_TIMEOUT,
+    CLIENT_BODY_TIMEOUT,
+    CLIENT_HEADER_TIMEOUT,
+    CLIENT_MAX_BODY_SIZE,
+    COMPRESS,
+    COMPRESS_CPU_BUDGET,
+    COMPRESS_MIN_LENGTH,
+    COMPRESS_STATIC,
+    ERROR_PAGE,
+    EVENT_BACKEND,
+    FASTCGI_PASS,
+    INDEX,
+    KEEPALIVE_REQUESTS,
+    KEEPALIVE_TIMEOUT,
+    LISTEN,
+    LOCATION,
+    MAX_CONNECTIONS,
+    METHODS,
+    PROXY_BALANCE,
+    PROXY_PASS,
+    PROXY_TIMEOUT,
+    RETURN,
+    ROOT,
+    SEND_TIMEOUT,
+    SERVER,
+    SERVER_NAME,
+    SLOW_REQUEST_THRESHOLD,
+    SSL_CERTIFICATE,
+    SSL_CERTIFICATE_KEY,
+    SSL_SESSION_CACHE,
+    SSL_SESSION_TICKETS,
+    SSL_SESSION_TIMEOUT,
+    STATS,
+    UPLOAD_STORE,
+    WORKER_CPU_AFFINITY,
+    WORKER_NUMA_LOCAL,
+    WORKER_PROCESSES,
+    WORKER_THREADS
+};
+
+// Context bits
+constexpr unsigned IN_MAIN     = 1;
+constexpr unsigned IN_SERVER   = 2;
+constexpr unsigned IN_LOCATION = 4;
+
+constexpr std::uint8_t MANY = 0xff; ///< No upper limit on the argument count.
+
+constexpr std::size_t MAX_SECONDS   = 365 * 24 * 3600; ///< Longest time value accepted.
+constexpr std::size_t MAX_WORKERS   = 1024;            ///< Highest process or thread count.
+constexpr std::size_t MAX_CPU       = 1023;            ///< Highest CPU number (CPU_SETSIZE).
+constexpr std::size_t MAX_BUSY_POLL = 1000000;         ///< Microseconds of busy polling.
+
+bool isSpace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+bool isDelimiter(char c) noexcept {
+    return isSpace(c) || c == ';' || c == '{' || c == '}';
+}
+
+std::string quote(std::string_view word) {
+    std::string text;
+    text.reserve(word.size() + 2);
+    text += '"';
+    text.append(word.data(), word.size());
+    text += '"';
+    return text;
+}
+
+} // namespace
+
+/// Name, contexts and argument count of a directive.
+struct ConfigParser::DirectiveInfo {
+    std::string_view name;
+    Directive        id;
+    unsigned         contexts; ///< IN_* bits where the directive may appear.
+    std::uint8_t     min_args;
+    std::uint8_t     max_args; ///< MANY for no limit.
+    bool             block;    ///< Followed by `{ ... }` instead of `;`.
+};
+
+namespace {
+
+template <typename Entry, std::size_t N> constexpr bool isSorted(const Entry (&table)[N]) {
+    for (std::size_t i = 1; i < N; ++i) {
+        if (!(table[i - 1].name < table[i].name))
+            return false;
+    }
+    return true;
+}
+
+const char* contextName(unsigned context) noexcept {
+    return context == IN_MAIN ? "the main context" : context == IN_SERVER ? "server" : "location";
+}
+
+} // namespace
+
+// --- ParseError ---
+
+ConfigParser::ParseError::ParseError(const std::string& message, std::size_t line,
+                                     std::size_t column)
+    : std::runtime_error(message), _line(line), _column(column) {
+}
+
+std::size_t ConfigParser::ParseError::getLine() const noexcept {
+    return _line;
+}
+
+std::size_t ConfigParser::ParseError::getColumn() const noexcept {
+    return _column;
+}
+
+// --- Entry points ---
+
+ConfigParser::ConfigParser(std::string_view text, const std::string& name)
+    : _text(text), _name(name), _pos(0) {
+    _args.reserve(8);
+}
+
+Config ConfigParser::parseFile(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path))
+        throw ParseError(path + ": " + strerror(errno), 0, 0);
+    return parse(file.view(), path);
+}
+
+Config ConfigParser::parse(std::string_view text, const std::string& name) {
+    ConfigParser parser(text, name);
+    Config       config;
+    parser.parseMain(config);
+    return config;
+}
+
+// --- Directives ---
+
+const ConfigParser::DirectiveInfo* ConfigParser::findDirective(std::string_view name) {
+    // Sorted by name for the binary search
+    static constexpr DirectiveInfo TABLE[] = {
+        {"asset_cache_size", Directive::ASSET_CACHE_SIZE, IN_MAIN, 1, 1, false},
+        {"autoindex", Directive::AUTOINDEX, IN_LOCATION, 1, 1, false},
+        {"autoindex_page_size", Directive::AUTOINDEX_PAGE_SIZE, IN_LOCATION, 1, 1, false},
+        {"cgi_extension", Directive::CGI_EXTENSION, IN_LOCATION, 1, 1, false},
+        {"cgi_interpreter", Directive::CGI_INTERPRETER, IN_LOCATION, 1, 1, false},
+        {"cgi_max_processes", Directive::CGI_MAX_PROCESSES, IN_LOCATION, 1, 1, false},
+        {"cgi_timeout", Directive::CGI_TIMEOUT, IN_LOCATION, 1, 1, false},
+        {"client_body_timeout", Directive::CLIENT_BODY_TIMEOUT, IN_SERVER, 1, 1, false},
+        {"client_header_timeout", Directive::CLIENT_HEADER_TIMEOUT, IN_SERVER, 1, 1, false},
+        {"client_max_body_size", Directive::CLIENT_MAX_BODY_SIZE, IN_SERVER, 1, 1, false},
+        {"compress", Directive::COMPRESS, IN_LOCATION, 1, 2, false},
+        {"compress_cpu_budget", Directive::COMPRESS_CPU_BUDGET, IN_MAIN, 1, 1, false},
+        {"compress_min_length", Directive::COMPRESS_MIN_LENGTH, IN_LOCATION, 1, 1, false},
+        {"compress_static", Directive::COMPRESS_STATIC, IN_LOCATION, 1, 1, false},
+        {"error_page", Directive::ERROR_PAGE, IN_SERVER, 2, MANY, false},
+        {"event_backend", Directive::EVENT_BACKEND, IN_MAIN, 1, 1, false},
+        {"fastcgi_pass", Directive::FASTCGI_PASS, IN_LOCATION, 1, 1, false},
+        {"index", Directive::INDEX, IN_LOCATION, 1, 1, false},
+        {"keepalive_requests", Directive::KEEPALIVE_REQUESTS, IN_SERVER, 1, 1, false},
+        {"keepalive_timeout", Directive::KEEPALIVE_TIMEOUT, IN_SERVER, 1, 1, false},
+        {"listen", Directive::LISTEN, IN_SERVER, 1, 5, false},
+        {"location", Directive::LOCATION, IN_SERVER, 1, 1, true},
+        {"max_connections", Directive::MAX_CONNECTIONS, IN_MAIN, 1, 1, false},
+        {"methods", Directive::METHODS, IN_LOCATION, 1, MANY, false},
+        {"proxy_balance", Directive::PROXY_BALANCE, IN_LOCATION, 1, 1, false},
+        {"proxy_pass", Directive::PROXY_PASS, IN_LOCATION, 1, MANY, false},
+        {"proxy_timeout", Directive::PROXY_TIMEOUT, IN_LOCATION, 1, 1, false},
+        {"return", Directive::RETURN, IN_LOCATION, 1, 2, false},
+        {"root", Directive::ROOT, IN_LOCATION, 1, 1, false},
+        {"send_timeout", Directive::SEND_TIMEOUT, IN_SERVER, 1, 1, false},
+        {"server", Directive::SERVER, IN_MAIN, 0, 0, true},
+        {"server_name", Directive::SERVER_NAME, IN_SERVER, 1, MANY, false},
+        {"slow_request_threshold", Directive::SLOW_REQUEST_THRESHOLD, IN_MAIN, 1, 1, false},
+        {"ssl_certificate", Directive::SSL_CERTIFICATE, IN_SERVER, 1, 1, false},
+        {"ssl_certificate_key", Directive::SSL_CERTIFICATE_KEY, IN_SERVER, 1, 1, false},
+        {"ssl_session_cache", Directive::SSL_SESSION_CACHE, IN_SERVER, 1, 1, false},
+        {"ssl_session_tickets", Directive::SSL_SESSION_TICKETS, IN_SERVER, 1, 1, false},
+        {"ssl_session_timeout", Directive::SSL_SESSION_TIMEOUT, IN_SERVER, 1, 1, false},
+        {"stats", Directive::STATS, IN_LOCATION, 1, 1, false},
+        {"upload_store", Directive::UPLOAD_STORE, IN_LOCATION, 1, 1, false},
+        {"worker_cpu_affinity", Directive::WORKER_CPU_AFFINITY, IN_MAIN, 1, MANY, false},
+        {"worker_numa_local", Directive::WORKER_NUMA_LOCAL, IN_MAIN, 1, 1, false},
+        {"worker_processes", Directive::WORKER_PROCESSES, IN_MAIN, 1, 1, false},
+        {"worker_threads", Directive::WORKER_THREADS, IN_MAIN, 1, 1, false},
+    };
+    static_assert(isSorted(TABLE), "directives must be sorted by name");
+
+    const DirectiveInfo* const end  = TABLE + sizeof(TABLE) / sizeof(TABLE[0]);
+    const DirectiveInfo*       info = std::lower_bound(
+        TABLE, end, name,
+        [](const DirectiveInfo& entry, std::string_view key) { return entry.name < key; });
+    return info != end && info->name == name ? info : NULL;
+}
+
+// --- Tokenizer ---
+
+ConfigParser::Token ConfigParser::next() {
+    const char* const data = _text.data();
+    const std::size_t size = _text.size();
+    while (_pos < size) {
+        if (data[_pos] == '#') {
+            const void* eol = std::memchr(data + _pos, '\n', size - _pos);
+            _pos            = eol ? static_cast<std::size_t>(static_cast<const char*>(eol) - data)
+                                  : size;
+        } else if (isSpace(data[_pos])) {
+            ++_pos;
+        } else {
+            break;
+        }
+    }
+    if (_pos >= size)
+        return Token{TokenType::END_OF_FILE, _text.substr(size)};
+
+    const std::size_t start = _pos;
+    switch (data[start]) {
+        case '{': ++_pos; return Token{TokenType::BLOCK_START, _text.substr(start, 1)};
+        case '}': ++_pos; return Token{TokenType::BLOCK_END, _text.substr(start, 1)};
+        case ';': ++_pos; return Token{TokenType::END_DIRECTIVE, _text.substr(start, 1)};
+        case '"':
+        case '\'': {
+            const void* close = std::memchr(data + start + 1, data[start], size - start - 1);
+            if (!close)
+                fail(_text.substr(start, 1), "unterminated quoted string");
+            _pos = static_cast<std::size_t>(static_cast<const char*>(close) - data) + 1;
+            return Token{TokenType::WORD, _text.substr(start + 1, _pos - start - 2)};
+        }
+        default: break;
+    }
+    while (_pos < size && !isDelimiter(data[_pos]))
+        ++_pos;
+    return Token{TokenType::WORD, _text.substr(start, _pos - start)};
+}
+
+const ConfigParser::DirectiveInfo* ConfigParser::nextDirective(unsigned context) {
+    const Token name = next();
+    if (name.type == TokenType::END_OF_FILE) {
+        if (context == IN_MAIN)
+            return NULL;
+        fail(name.text, "unexpected end of file, expecting \"}\"");
+    }
+    if (name.type == TokenType::BLOCK_END) {
+        if (context != IN_MAIN)
+            return NULL;
+        fail(name.text, "unexpected \"}\"");
+    }
+    if (name.type != TokenType::WORD)
+        fail(name.text, "unexpected " + quote(name.text));
+
+    const DirectiveInfo* info = findDirective(name.text);
+    if (!info)
+        fail(name.text, "unknown directive " + quote(name.text));
+    if (!(info->contexts & context))
+        fail(name.text, quote(name.text) + " is not allowed in " + contextName(context));
+
+    _args.clear();
+    Token token = next();
+    while (token.type == TokenType::WORD) {
+        _args.push_back(token.text);
+        token = next();
+    }
+    if (token.type != TokenType::END_DIRECTIVE && token.type != TokenType::BLOCK_START)
+        fail(name.text, "directive " + quote(name.text) + " is not terminated by \";\"");
+    if (info->block != (token.type == TokenType::BLOCK_START))
+        fail(token.text, info->block ? "directive " + quote(name.text) + " has no block"
+                                     : "directive " + quote(name.text) + " takes no block");
+    if (_args.size() < info->min_args || (info->max_args != MANY && _args.size() > info->max_args))
+        fail(name.text, "invalid number of arguments in " + quote(name.text));
+    return info;
+}
+
+// --- Blocks ---
+
+void ConfigParser::parseMain(Config& config) {
+    bool             has_server = false;
+    std::string_view numa_local;
+    while (const DirectiveInfo* info = nextDirective(IN_MAIN)) {
+        const std::string_view arg = _args.empty() ? std::string_view() : _args[0];
+        switch (info->id) {
+            case Directive::SERVER:
+                parseServer(config.emplaceServer());
+                has_server = true;
+                break;
+            case Directive::WORKER_PROCESSES:
+                config.setWorkerProcesses(arg == "auto" ? 0 : number(arg, MAX_WORKERS));
+                break;
+            case Directive::WORKER_THREADS:
+                config.setWorkerThreads(arg == "auto" ? 0 : number(arg, MAX_WORKERS));
+                break;
+            case Directive::EVENT_BACKEND:
+                if (arg == "auto")
+                    config.setEventBackend(PollBackend::AUTO);
+                else if (arg == "epoll")
+                    config.setEventBackend(PollBackend::EPOLL);
+                else if (arg == "kqueue")
+                    config.setEventBackend(PollBackend::KQUEUE);
+                else if (arg == "poll")
+                    config.setEventBackend(PollBackend::POLL);
+                else if (arg == "io_uring")
+                    config.setEventBackend(PollBackend::IO_URING);
+                else
+                    fail(arg, "unknown event backend " + quote(arg));
+                break;
+            case Directive::ASSET_CACHE_SIZE: config.setAssetCacheSize(size(arg)); break;
+            case Directive::MAX_CONNECTIONS:
+                config.setMaxConnections(number(arg, static_cast<std::size_t>(-1)));
+                break;
+            case Directive::COMPRESS_CPU_BUDGET:
+                config.setCompressCpuBudget(static_cast<unsigned>(number(arg, 100)));
+                break;
+            case Directive::SLOW_REQUEST_THRESHOLD:
+                config.setSlowRequestThreshold(arg == "off" ? 0 : milliseconds(arg));
+                break;
+            case Directive::WORKER_CPU_AFFINITY: parseCpuAffinity(config); break;
+            case Directive::WORKER_NUMA_LOCAL:
+                config.setNumaLocal(flag(arg));
+                numa_local = arg;
+                break;
+            default: break; // Rejected by nextDirective()
+        }
+    }
+    if (!has_server)
+        fail(_text.substr(_text.size()), "no \"server\" block");
+    // An unpinned loop changes node whenever the scheduler moves it
+    if (config.isNumaLocal() && config.getCpuAffinity() == CpuAffinity::OFF)
+        fail(numa_local, "\"worker_numa_local\" needs \"worker_cpu_affinity\"");
+}
+
+// off | auto | cpu...; a cpu is a number or an inclusive range such as 4-7
+void ConfigParser::parseCpuAffinity(Config& config) {
+    if (_args.size() == 1 && (_args[0] == "off" || _args[0] == "auto")) {
+        config.setCpuAffinity(_args[0] == "off" ? CpuAffinity::OFF : CpuAffinity::AUTO);
+        return;
+    }
+    std::vector<unsigned> cpus;
+    for (std::size_t i = 0; i < _args.size(); ++i) {
+        const std::string_view arg   = _args[i];
+        const std::size_t      dash  = arg.find('-');
+        const std::size_t      first = number(arg.substr(0, dash), MAX_CPU);
+        const std::size_t      last =
+            dash == std::string_view::npos ? first : number(arg.substr(dash + 1), MAX_CPU);
+        if (last < first)
+            fail(arg, "invalid CPU range " + quote(arg));
+        for (std::size_t cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(static_cast<unsigned>(cpu));
+    }
+    config.setCpuAffinity(CpuAffinity::LIST, std::move(cpus));
+}
+
+void ConfigParser::parseServer(Server& server) {
+    bool             has_listen = false;
+    std::string_view listen;
+    while (const DirectiveInfo* info = nextDirective(IN_SERVER)) {
+        const std::string_view arg = _args[0];
+        switch (info->id) {
+            case Directive::LISTEN:
+                if (has_listen)
+                    fail(arg, "duplicate \"listen\"; use one server block per address");
+                parseListen(server);
+                has_listen = true;
+                listen     = arg;
+                break;
+            case Directive::SERVER_NAME:
+                for (std::size_t i = 0; i < _args.size(); ++i)
+                    server.addServerName(std::string(value(_args[i])));
+                break;
+            case Directive::ERROR_PAGE: {
+                const std::string_view uri = _args.back();
+                if (uri.empty() || uri[0] != '/')
+                    fail(uri, "error page " + quote(uri) + " must be a path starting with \"/\"");
+                for (std::size_t i = 0; i + 1 < _args.size(); ++i) {
+                    const std::size_t code = number(_args[i], 599);
+                    if (code < 300)
+                        fail(_args[i], "error code must be between 300 and 599");
+                    server.setErrorPage(static_cast<int>(code), std::string(uri));
+                }
+                break;
+            }
+            case Directive::CLIENT_MAX_BODY_SIZE: server.setClientMaxBodySize(size(arg)); break;
+            case Directive::KEEPALIVE_TIMEOUT: server.setKeepAliveTimeout(seconds(arg)); break;
+            case Directive::KEEPALIVE_REQUESTS:
+                server.setKeepAliveRequests(number(arg, static_cast<std::size_t>(-1)));
+                break;
+            case Directive::CLIENT_HEADER_TIMEOUT:
+                server.setClientHeaderTimeout(seconds(arg));
+                break;
+            case Directive::CLIENT_BODY_TIMEOUT: server.setClientBodyTimeout(seconds(arg)); break;
+            case Directive::SEND_TIMEOUT: server.setSendTimeout(seconds(arg)); break;
+            case Directive::SSL_CERTIFICATE:
+                server.setSslCertificate(std::string(value(arg)));
+                break;
+            case Directive::SSL_CERTIFICATE_KEY:
+                server.setSslCertificateKey(std::string(value(arg)));
+                break;
+            case Directive::SSL_SESSION_CACHE:
+                server.setSslSessionCache(number(arg, static_cast<std::size_t>(INT32_MAX)));
+                break;
+            case Directive::SSL_SESSION_TIMEOUT: server.setSslSessionTimeout(seconds(arg)); break;
+            case Directive::SSL_SESSION_TICKETS: server.setSslSessionTickets(flag(arg)); break;
+            case Directive::LOCATION: {
+                if (arg.empty() || arg[0] != '/')
+                    fail(arg, "location path " + quote(arg) + " must start with \"/\"");
+                const Location* existing = server.findLocation(arg);
+                if (existing && existing->getPath() == arg)
+                    fail(arg, "duplicate location " + quote(arg));
+                parseLocation(server.emplaceLocation(arg));
+                break;
+            }
+            default: break;
+        }
+    }
+    // Certificates are loaded with the snapshot; only their presence is checked here
+    if (server.isSsl() &&
+        (server.getSslCertificate().empty() || server.getSslCertificateKey().empty()))
+        fail(listen, "\"ssl\" needs \"ssl_certificate\" and \"ssl_certificate_key\"");
+}
+
+// [host:]port [default_server] [ssl] [backlog=N] [busy_poll=usec]; "*" or no host: any address
+void ConfigParser::parseListen(Server& server) {
+    const std::string_view address = _args[0];
+    const std::size_t      colon   = address.rfind(':');
+    const bool             bare    = colon == std::string_view::npos;
+    std::string_view       host    = bare ? "*" : address.substr(0, colon);
+    const std::string_view port    = bare ? address : address.substr(colon + 1);
+    if (host == "*")
+        host = "0.0.0.0";
+    if (host != "localhost") {
+        char      text[INET_ADDRSTRLEN];
+        in_addr   parsed;
+        if (host.size() >= sizeof(text))
+            fail(host, "invalid IPv4 address " + quote(host));
+        std::memcpy(text, host.data(), host.size());
+        text[host.size()] = '\0';
+        if (inet_pton(AF_INET, text, &parsed) != 1)
+            fail(host, "invalid IPv4 address " + quote(host));
+    }
+    const std::size_t number_port = number(port, 65535);
+    if (number_port == 0)
+        fail(port, "port must be between 1 and 65535");
+    server.setHost(std::string(host));
+    server.setPort(static_cast<int>(number_port));
+
+    for (std::size_t i = 1; i < _args.size(); ++i) {
+        const std::string_view option = _args[i];
+        if (option == "default_server")
+            server.setDefaultServer(true);
+        else if (option == "ssl")
+            server.setSsl(true);
+        else if (option.compare(0, 8, "backlog=") == 0)
+            server.setListenBacklog(static_cast<int>(number(option.substr(8), 65535)));
+        else if (option.compare(0, 10, "busy_poll=") == 0)
+            server.setBusyPoll(static_cast<int>(number(option.substr(10), MAX_BUSY_POLL)));
+        else
+            fail(option, "invalid listen option " + quote(option));
+    }
+}
+
+void ConfigParser::parseLocation(Location& location) {
+    while (const DirectiveInfo* info = nextDirective(IN_LOCATION)) {
+        const std::string_view arg = _args[0];
+        switch (info->id) {
+            case Directive::METHODS:
+                for (std::size_t i = 0; i < _args.size(); ++i) {
+                    const HttpMethod method = parseHttpMethod(_args[i]);
+                    if (method == HttpMethod::UNKNOWN)
+                        fail(_args[i], "unknown method " + quote(_args[i]));
+                    location.addMethod(method);
+                }
+                break;
+            case Directive::ROOT: location.setRoot(value(arg)); break;
+            case Directive::INDEX: location.setIndex(value(arg)); break;
+            case Directive::AUTOINDEX: location.setAutoindex(flag(arg)); break;
+            case Directive::AUTOINDEX_PAGE_SIZE:
+                location.setAutoindexPageSize(number(arg, Location::MAX_AUTOINDEX_PAGE_SIZE));
+                break;
+            case Directive::RETURN: {
+                // nginx semantics: a bare URL is a temporary redirect
+                if (_args.size() == 1) {
+                    location.setRedirect(value(arg), 302);
+                    break;
+                }
+                const std::size_t code = number(arg, 308);
+                if (code != 301 && code != 302 && code != 303 && code != 307 && code != 308)
+                    fail(arg, "redirect code must be 301, 302, 303, 307 or 308");
+                location.setRedirect(value(_args[1]), static_cast<int>(code));
+                break;
+            }
+            case Directive::UPLOAD_STORE: location.setUploadStore(value(arg)); break;
+            case Directive::CGI_EXTENSION:
+                if (arg.size() < 2 || arg[0] != '.')
+                    fail(arg, "CGI extension " + quote(arg) + " must start with \".\"");
+                location.setCgiExtension(arg);
+                break;
+            case Directive::CGI_INTERPRETER: location.setCgiInterpreter(value(arg)); break;
+            case Directive::CGI_MAX_PROCESSES:
+                location.setCgiMaxProcesses(number(arg, static_cast<std::size_t>(-1)));
+                break;
+            case Directive::CGI_TIMEOUT: location.setCgiTimeout(seconds(arg)); break;
+            case Directive::FASTCGI_PASS: location.setFastcgiPass(value(arg)); break;
+            case Directive::PROXY_PASS: parseProxyPass(location); break;
+            case Directive::PROXY_BALANCE:
+                if (arg == "round_robin")
+                    location.setProxyBalance(ProxyBalance::ROUND_ROBIN);
+                else if (arg == "least_conn")
+                    location.setProxyBalance(ProxyBalance::LEAST_CONN);
+                else
+                    fail(arg, "proxy_balance must be round_robin or least_conn");
+                break;
+            case Directive::PROXY_TIMEOUT: location.setProxyTimeout(seconds(arg)); break;
+            case Directive::STATS: location.setStats(flag(arg)); break;
+            case Directive::COMPRESS: {
+                if (arg == "off" && _args.size() == 1) {
+                    location.setCompression(0);
+                    break;
+                }
+                unsigned codings = 0;
+                for (std::size_t i = 0; i < _args.size(); ++i) {
+                    const ContentCoding coding = parseCodingName(_args[i]);
+                    if (coding == ContentCoding::IDENTITY)
+                        fail(_args[i], "unknown content coding " + quote(_args[i]));
+                    codings |= codingBit(coding);
+                }
+                location.setCompression(codings);
+                break;
+            }
+            case Directive::COMPRESS_STATIC: location.setCompressStatic(flag(arg)); break;
+            case Directive::COMPRESS_MIN_LENGTH: location.setCompressMinLength(size(arg)); break;
+            default: break;
+        }
+    }
+}
+
+// [http://]address...; upstreams are reached without a resolver, like fastcgi_pass
+void ConfigParser::parseProxyPass(Location& location) {
+    std::string upstreams;
+    for (std::size_t i = 0; i < _args.size(); ++i) {
+        std::string_view address = _args[i];
+        if (address.compare(0, 8, "https://") == 0)
+            fail(address, "proxy_pass does not support https");
+        if (address.compare(0, 7, "http://") == 0)
+            address.remove_prefix(7);
+        if (!address.empty() && address.back() == '/')
+            address.remove_suffix(1);
+        sockaddr_storage addr;
+        socklen_t        length;
+        if (!parseSocketAddress(address, addr, length))
+            fail(_args[i], "invalid upstream address " + quote(_args[i]));
+        upstreams.append(upstreams.empty() ? "" : " ").append(address);
+    }
+    location.setProxyPass(upstreams);
+}
+
+// --- Values ---
+
+std::size_t ConfigParser::number(std::string_view word, std::size_t max) const {
+    if (word.empty())
+        fail(word, "expected a number");
+    std::size_t result = 0;
+    for (char c : word) {
+        if (c < '0' || c > '9')
+            fail(word, "invalid number " + quote(word));
+        const std::size_t digit = static_cast<std::size_t>(c - '0');
+        if (result > (max - digit) / 10)
+            fail(word, "value " + quote(word) + " is out of range");
+        result = result * 10 + digit;
+    }
+    return result;
+}
+
+// Bytes, or k / m / g for binary kilo-, mega- and gigabytes
+std::size_t ConfigParser::size(std::string_view word) const {
+    unsigned shift = 0;
+    if (!word.empty()) {
+        switch (word.back()) {
+            case 'k': case 'K': shift = 10; break;
+            case 'm': case 'M': shift = 20; break;
+            case 'g': case 'G': shift = 30; break;
+            default: break;
+        }
+    }
+    const std::size_t max = static_cast<std::size_t>(-1) >> shift;
+    return number(shift ? word.substr(0, word.size() - 1) : word, max) << shift;
+}
+
+std::size_t ConfigParser::seconds(std::string_view word) const {
+    std::size_t unit = 1;
+    if (!word.empty()) {
+        switch (word.back()) {
+            case 's': unit = 1; break;
+            case 'm': unit = 60; break;
+            case 'h': unit = 3600; break;
+            default: break;
+        }
+    }
+    const bool suffixed = !word.empty() && (word.back() < '0' || word.back() > '9');
+    return number(suffixed ? word.substr(0, word.size() - 1) : word, MAX_SECONDS / unit) * unit;
+}
+
+// A time with an `ms` suffix, or any time seconds() accepts
+std::size_t ConfigParser::milliseconds(std::string_view word) const {
+    if (word.size() > 2 && word.compare(word.size() - 2, 2, "ms") == 0)
+        return number(word.substr(0, word.size() - 2), MAX_SECONDS * 1000);
+    return seconds(word) * 1000;
+}
+
+bool ConfigParser::flag(std::string_view word) const {
+    if (word == "on")
+        return true;
+    if (word != "off")
+        fail(word, "expected \"on\" or \"off\", not " + quote(word));
+    return false;
+}
+
+std::string_view ConfigParser::value(std::string_view word) const {
+    if (word.empty())
+        fail(word, "empty value");
+    return word;
+}
+
+// --- Errors ---
+
+// Only errors pay for locating the position: the tokenizer never counts lines
+void ConfigParser::fail(std::string_view at, const std::string& message) const {
+    const char* const begin = _text.data();
+    std::size_t       offset = _text.size();
+    if (begin && at.data() >= begin && at.data() <= begin + _text.size())
+        offset = static_cast<std::size_t>(at.data() - begin);
+    const std::size_t line =
+        1 + static_cast<std::size_t>(std::count(begin, begin + offset, '\n'));
+    const std::size_t line_start = _text.rfind('\n', offset ? offset - 1 : 0);
+    const std::size_t column =
+        offset - (line_start == std::string_view::npos || offset == 0 ? 0 : line_start + 1) + 1;
+    throw ParseError(_name + ":" + std::to_string(line) + ":" + std::to_string(column) + ": " +
+                         message,
+                     line, column);
+}
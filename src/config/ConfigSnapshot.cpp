@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ConfigSnapshot.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:01:59 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:18:53 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    ConfigSnapshot.cpp
+ * @brief   Implements the ConfigSnapshot class.
+ *
+ * @ingroup config
+ */
+
+#include "config/ConfigSnapshot.hpp"
+#include <utility>
+
+ConfigSnapshot::ConfigSnapshot(const std::vector<Server>& servers, std::size_t asset_cache_size,
+                               std::size_t max_connections, unsigned compress_budget,
+                               std::size_t slow_request_ms)
+    : _servers(servers), _hosts(_servers), _asset_cache_size(asset_cache_size),
+      _max_connections(max_connections), _compress_budget(compress_budget),
+      _slow_request_ms(slow_request_ms) {
+    loadTls();
+}
+
+ConfigSnapshot::ConfigSnapshot(std::vector<Server>&& servers, std::size_t asset_cache_size,
+                               std::size_t max_connections, unsigned compress_budget,
+                               std::size_t slow_request_ms)
+    : _servers(std::move(servers)), _hosts(_servers), _asset_cache_size(asset_cache_size),
+      _max_connections(max_connections), _compress_budget(compress_budget),
+      _slow_request_ms(slow_request_ms) {
+    loadTls();
+}
+
+std::shared_ptr<const ConfigSnapshot> ConfigSnapshot::create(const Config& config) {
+    return std::make_shared<const ConfigSnapshot>(
+        config.getServers(), config.getAssetCacheSize(), config.getMaxConnections(),
+        config.getCompressCpuBudget(), config.getSlowRequestThreshold());
+}
+
+std::shared_ptr<const ConfigSnapshot> ConfigSnapshot::create(Config&& config) {
+    return std::make_shared<const ConfigSnapshot>(
+        config.releaseServers(), config.getAssetCacheSize(), config.getMaxConnections(),
+        config.getCompressCpuBudget(), config.getSlowRequestThreshold());
+}
+
+const std::vector<Server>& ConfigSnapshot::getServers() const noexcept {
+    return _servers;
+}
+
+const VirtualHostIndex& ConfigSnapshot::getHosts() const noexcept {
+    return _hosts;
+}
+
+std::size_t ConfigSnapshot::getAssetCacheSize() const noexcept {
+    return _asset_cache_size;
+}
+
+std::size_t ConfigSnapshot::getMaxConnections() const noexcept {
+    return _max_connections;
+}
+
+unsigned ConfigSnapshot::getCompressCpuBudget() const noexcept {
+    return _compress_budget;
+}
+
+std::chrono::milliseconds ConfigSnapshot::getSlowRequestThreshold() const noexcept {
+    return std::chrono::milliseconds(_slow_request_ms);
+}
+
+const TlsContext* ConfigSnapshot::getTls(const Server& server) const noexcept {
+    const std::size_t index = static_cast<std::size_t>(&server - _servers.data());
+    return index < _tls.size() ? _tls[index].get() : NULL;
+}
+
+// Certificates load here, before workers fork, so they share the session ticket keys
+void ConfigSnapshot::loadTls() {
+    _tls.resize(_servers.size());
+    for (std::size_t i = 0; i < _servers.size(); ++i) {
+        if (_servers[i].isSsl())
+            _tls[i].reset(new TlsContext(_servers[i]));
+    }
+}
@@ -20,32 +20,45 @@
  */
 
 #include "core/Location.hpp"
+#include <algorithm>
+#include <cstdint>
 
 // --- Constructor ---
 
 /**
  * @brief Constructs a Location with default values.
  *
- * @details Initializes autoindex to false and return code to 0.
+ * @details Initializes autoindex to false (on a single page), return code to 0 and
+ * allows no method.
+ * CGI scripts and upstreams get the default limits; compression is off.
  */
-Location::Location() : _autoindex(false), _return_code(0) {
+Location::Location()
+    : _compress_min_length(DEFAULT_COMPRESS_MIN_LENGTH),
+      _cgi_max_processes(DEFAULT_CGI_MAX_PROCESSES), _cgi_timeout(DEFAULT_CGI_TIMEOUT),
+      _proxy_timeout(DEFAULT_PROXY_TIMEOUT), _return_code(0), _method_mask(0),
+      _autoindex_page_size(0), _autoindex(false), _stats(false), _compression(0),
+      _compress_static(false), _proxy_balance(ProxyBalance::ROUND_ROBIN) {
 }
 
 // --- Setters ---
 
-void Location::setPath(const std::string& path) {
+void Location::setPath(std::string_view path) {
     _path = path;
 }
 
-void Location::addMethod(const std::string& method) {
-    _methods.insert(method);
+void Location::addMethod(std::string_view method) {
+    addMethod(parseHttpMethod(method));
 }
 
-void Location::setRoot(const std::string& root) {
+void Location::addMethod(HttpMethod method) noexcept {
+    _method_mask = static_cast<std::uint16_t>(_method_mask | httpMethodBit(method));
+}
+
+void Location::setRoot(std::string_view root) {
     _root = root;
 }
 
-void Location::setIndex(const std::string& index) {
+void Location::setIndex(std::string_view index) {
     _index = index;
 }
 
@@ -53,47 +66,100 @@ void Location::setAutoindex(bool enabled) {
     _autoindex = enabled;
 }
 
-void Location::setRedirect(const std::string& target, int code) {
+void Location::setAutoindexPageSize(std::size_t entries) noexcept {
+    _autoindex_page_size = static_cast<std::uint16_t>(std::min(entries, MAX_AUTOINDEX_PAGE_SIZE));
+}
+
+void Location::setRedirect(std::string_view target, int code) {
     _redirect    = target;
-    _return_code = code;
+    _return_code = static_cast<std::uint16_t>(code);
 }
 
-void Location::setUploadStore(const std::string& path) {
+void Location::setUploadStore(std::string_view path) {
     _upload_store = path;
 }
 
-void Location::setCgiExtension(const std::string& ext) {
+void Location::setCgiExtension(std::string_view ext) {
     _cgi_extension = ext;
 }
 
+void Location::setCgiInterpreter(std::string_view program) {
+    _cgi_interpreter = program;
+}
+
+// Counts and times are stored in 32 bits; larger values mean no practical limit anyway
+void Location::setCgiMaxProcesses(std::size_t count) {
+    _cgi_max_processes = static_cast<std::uint32_t>(std::min<std::size_t>(count, UINT32_MAX));
+}
+
+void Location::setCgiTimeout(std::size_t seconds) {
+    _cgi_timeout = static_cast<std::uint32_t>(std::min<std::size_t>(seconds, UINT32_MAX));
+}
+
+void Location::setFastcgiPass(std::string_view address) {
+    _fastcgi_pass = address;
+}
+
+void Location::setProxyPass(std::string_view upstreams) {
+    _proxy_pass = upstreams;
+}
+
+void Location::setProxyBalance(ProxyBalance balance) noexcept {
+    _proxy_balance = balance;
+}
+
+void Location::setProxyTimeout(std::size_t seconds) noexcept {
+    _proxy_timeout = static_cast<std::uint32_t>(std::min<std::size_t>(seconds, UINT32_MAX));
+}
+
+void Location::setStats(bool enabled) {
+    _stats = enabled;
+}
+
+void Location::setCompression(unsigned codings) noexcept {
+    _compression = static_cast<std::uint8_t>(codings);
+}
+
+void Location::setCompressStatic(bool enabled) noexcept {
+    _compress_static = enabled;
+}
+
+void Location::setCompressMinLength(std::size_t bytes) noexcept {
+    _compress_min_length = bytes;
+}
+
 // --- Getters ---
 
 const std::string& Location::getPath() const {
-    return _path;
+    return _path.str();
 }
 
-const std::set<std::string>& Location::getMethods() const {
-    return _methods;
+std::uint16_t Location::getMethodMask() const noexcept {
+    return _method_mask;
 }
 
 const std::string& Location::getRoot() const {
-    return _root;
+    return _root.str();
 }
 
 const std::string& Location::getIndex() const {
-    return _index;
+    return _index.str();
 }
 
 bool Location::isAutoindexEnabled() const {
     return _autoindex;
 }
 
+std::size_t Location::getAutoindexPageSize() const noexcept {
+    return _autoindex_page_size;
+}
+
 bool Location::hasRedirect() const {
     return !_redirect.empty();
 }
 
 const std::string& Location::getRedirect() const {
-    return _redirect;
+    return _redirect.str();
 }
 
 int Location::getReturnCode() const {
@@ -101,11 +167,55 @@ int Location::getReturnCode() const {
 }
 
 const std::string& Location::getUploadStore() const {
-    return _upload_store;
+    return _upload_store.str();
 }
 
 const std::string& Location::getCgiExtension() const {
-    return _cgi_extension;
+    return _cgi_extension.str();
+}
+
+const std::string& Location::getCgiInterpreter() const {
+    return _cgi_interpreter.str();
+}
+
+std::size_t Location::getCgiMaxProcesses() const noexcept {
+    return _cgi_max_processes;
+}
+
+std::size_t Location::getCgiTimeout() const noexcept {
+    return _cgi_timeout;
+}
+
+const std::string& Location::getFastcgiPass() const {
+    return _fastcgi_pass.str();
+}
+
+const std::string& Location::getProxyPass() const {
+    return _proxy_pass.str();
+}
+
+ProxyBalance Location::getProxyBalance() const noexcept {
+    return _proxy_balance;
+}
+
+std::size_t Location::getProxyTimeout() const noexcept {
+    return _proxy_timeout;
+}
+
+bool Location::isStatsEnabled() const noexcept {
+    return _stats;
+}
+
+unsigned Location::getCompression() const noexcept {
+    return _compression;
+}
+
+bool Location::isCompressStatic() const noexcept {
+    return _compress_static;
+}
+
+std::size_t Location::getCompressMinLength() const noexcept {
+    return _compress_min_length;
 }
 
 // --- Logic Helpers ---
@@ -113,14 +223,24 @@ const std::string& Location::getCgiExtension() const {
 /**
  * @brief Verifies if the given HTTP method is allowed for this location.
  *
- * @details Checks whether the method exists in the set of allowed methods
- * configured for this location (e.g., "GET", "POST", "DELETE").
+ * @details Parses the name and tests it against the method mask; unknown methods
+ * have no bit and are never allowed.
  *
  * @param method The HTTP method string to check.
  * @return True if the method is allowed, false otherwise.
  */
 bool Location::isMethodAllowed(const std::string& method) const {
-    return _methods.count(method) > 0;
+    return isMethodAllowed(parseHttpMethod(method));
+}
+
+/**
+ * @brief Verifies if a parsed HTTP method is allowed for this location.
+ *
+ * @param method The method recognized by the request parser.
+ * @return True if the method's bit is set in the precomputed mask.
+ */
+bool Location::isMethodAllowed(HttpMethod method) const noexcept {
+    return (_method_mask & httpMethodBit(method)) != 0;
 }
 
 /**
@@ -133,13 +253,14 @@ bool Location::isMethodAllowed(const std::string& method) const {
  * @return True if the location path is a prefix of the URI.
  */
 bool Location::matchesPath(const std::string& uri) const {
-    return uri.rfind(_path, 0) == 0; // _path is a prefix of uri
+    return uri.rfind(_path.str(), 0) == 0; // _path is a prefix of uri
 }
 
 /**
  * @brief Resolves a request URI into a full filesystem path.
  *
- * @details Joins the root directory and the URI suffix after the location path.
+ * @details Joins the root directory and the URI suffix after the location path,
+ * inserting a '/' when the location path consumed it (e.g. location "/").
  * Returns an empty string if the URI does not match this location.
  *
  * @param uri The full request URI.
@@ -148,7 +269,26 @@ bool Location::matchesPath(const std::string& uri) const {
 std::string Location::resolveAbsolutePath(const std::string& uri) const {
     if (!matchesPath(uri))
         return "";
-    return _root + uri.substr(_path.length());
+    // Keep exactly one separator when "/" or "/dir/" locations strip the slash
+    const std::string& root   = _root;
+    const std::string  suffix = uri.substr(_path.str().length());
+    if (!suffix.empty() && suffix[0] != '/' && !root.empty() && root.back() != '/')
+        return root + "/" + suffix;
+    return root + suffix;
+}
+
+bool Location::resolveAbsolutePath(std::string_view uri, std::pmr::string& out) const {
+    const std::string& path = _path;
+    const std::string& root = _root;
+    if (uri.substr(0, path.size()) != path)
+        return false;
+    const std::string_view suffix = uri.substr(path.size());
+    out.reserve(out.size() + root.size() + suffix.size() + 1);
+    out.append(root);
+    if (!suffix.empty() && suffix[0] != '/' && !root.empty() && root.back() != '/')
+        out += '/';
+    out.append(suffix.data(), suffix.size());
+    return true;
 }
 
 /**
@@ -164,12 +304,29 @@ bool Location::isUploadEnabled() const {
  * @brief Determines if the URI targets a CGI script.
  *
  * @param uri The requested URI.
- * @return True if the URI ends with the configured CGI extension.
+ * @return True if a segment of the URI ends with the configured CGI extension.
+ */
+bool Location::isCgiRequest(std::string_view uri) const noexcept {
+    return cgiScriptLength(uri) != 0;
+}
+
+/**
+ * @brief Returns the length of the script's part of a URI.
+ *
+ * @param uri The requested URI.
+ * @return Length up to the end of the first segment ending with the CGI
+ *         extension, or 0 if there is none.
  */
-bool Location::isCgiRequest(const std::string& uri) const {
-    return !_cgi_extension.empty() && uri.size() >= _cgi_extension.size() &&
-           uri.compare(uri.size() - _cgi_extension.size(), _cgi_extension.size(), _cgi_extension) ==
-               0;
+std::size_t Location::cgiScriptLength(std::string_view uri) const noexcept {
+    const std::string& ext = _cgi_extension;
+    if (ext.empty())
+        return 0;
+    for (std::size_t at = uri.find(ext); at != std::string_view::npos; at = uri.find(ext, at + 1)) {
+        const std::size_t end = at + ext.size();
+        if (end == uri.size() || uri[end] == '/')
+            return end;
+    }
+    return 0;
 }
 
 /**
@@ -178,5 +335,5 @@ bool Location::isCgiRequest(const std::string& uri) const {
  * @return The absolute path to the index file or an empty string.
  */
 std::string Location::getEffectiveIndexPath() const {
-    return _index.empty() ? "" : _root + "/" + _index;
+    return _index.empty() ? "" : _root.str() + "/" + _index.str();
 }
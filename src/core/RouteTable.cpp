@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RouteTable.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:13:32 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:13:32 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    RouteTable.cpp
+ * @brief   Implements the RouteTable radix trie.
+ *
+ * @details Insertion splits an edge where a new path diverges from it; lookup only
+ * ever compares each byte of the request path once.
+ *
+ * @ingroup core
+ */
+
+#include "core/RouteTable.hpp"
+
+RouteTable::RouteTable() {
+    clear();
+}
+
+void RouteTable::clear() {
+    _nodes.clear();
+    addNode("", NO_ROUTE);
+}
+
+std::size_t RouteTable::nodeCount() const noexcept {
+    return _nodes.size();
+}
+
+std::uint32_t RouteTable::addNode(std::string_view label, std::int32_t location) {
+    Node node;
+    node.label    = std::string(label);
+    node.location = location;
+    _nodes.push_back(node);
+    return static_cast<std::uint32_t>(_nodes.size() - 1);
+}
+
+std::int32_t RouteTable::findChild(std::size_t node, char first) const noexcept {
+    const std::vector<std::uint32_t>& children = _nodes[node].children;
+    for (std::size_t i = 0; i < children.size(); ++i) {
+        if (_nodes[children[i]].label[0] == first)
+            return static_cast<std::int32_t>(children[i]);
+    }
+    return NO_ROUTE;
+}
+
+void RouteTable::insert(std::string_view path, std::size_t index) {
+    std::size_t node = 0;
+    std::size_t pos  = 0;
+
+    while (pos < path.size()) {
+        const std::string_view rest  = path.substr(pos);
+        const std::int32_t     found = findChild(node, rest[0]);
+        if (found == NO_ROUTE) {
+            const std::uint32_t leaf = addNode(rest, static_cast<std::int32_t>(index));
+            _nodes[node].children.push_back(leaf);
+            return;
+        }
+
+        const std::size_t child = static_cast<std::size_t>(found);
+        const std::string& label = _nodes[child].label;
+        std::size_t        common = 0;
+        while (common < label.size() && common < rest.size() && label[common] == rest[common])
+            ++common;
+
+        if (common < label.size()) {
+            // The new path diverges inside this edge: split it at the divergence
+            const std::uint32_t mid = addNode(rest.substr(0, common), NO_ROUTE);
+            _nodes[child].label.erase(0, common);
+            _nodes[mid].children.push_back(static_cast<std::uint32_t>(child));
+            std::vector<std::uint32_t>& siblings = _nodes[node].children;
+            for (std::size_t i = 0; i < siblings.size(); ++i) {
+                if (siblings[i] == child)
+                    siblings[i] = mid;
+            }
+            node = mid;
+        } else {
+            node = child;
+        }
+        pos += common;
+    }
+    if (_nodes[node].location == NO_ROUTE)
+        _nodes[node].location = static_cast<std::int32_t>(index);
+}
+
+std::int32_t RouteTable::find(std::string_view path) const noexcept {
+    std::int32_t best = _nodes[0].location;
+    std::size_t  node = 0;
+    std::size_t  pos  = 0;
+
+    while (pos < path.size()) {
+        const std::int32_t found = findChild(node, path[pos]);
+        if (found == NO_ROUTE)
+            break;
+        const std::string& label = _nodes[static_cast<std::size_t>(found)].label;
+        if (path.compare(pos, label.size(), label) != 0)
+            break;
+        pos += label.size();
+        node = static_cast<std::size_t>(found);
+        if (_nodes[node].location != NO_ROUTE)
+            best = _nodes[node].location;
+    }
+    return best;
+}
@@ -24,13 +24,26 @@
 
 #include "core/Server.hpp"
 #include <algorithm>
+#include <utility>
 
 // --- Constructor ---
 
 Server::Server()
     : _port(80),                     // Default HTTP port
       _host("0.0.0.0"),              // Default bind address
-      _client_max_body_size(1048576) // 1 MB
+      _client_max_body_size(1048576), // 1 MB
+      _keepalive_timeout(60),         // Seconds a persistent connection may stay idle
+      _keepalive_requests(100),       // Requests served before the connection is closed
+      _header_timeout(60),            // Seconds from the first byte of a head to its end
+      _body_timeout(60),              // Seconds a body may stall between two reads
+      _send_timeout(60),              // Seconds a response may stall between two writes
+      _listen_backlog(511),           // Capped by the kernel's somaxconn
+      _busy_poll(0),                  // Sockets sleep until the interrupt wakes them
+      _default_server(false),         // The first server of a port is the default otherwise
+      _ssl(false),                    // Plain HTTP unless the listener says "ssl"
+      _ssl_session_tickets(true),     // Resumption without server-side state
+      _ssl_session_cache(DEFAULT_SSL_SESSION_CACHE),
+      _ssl_session_timeout(DEFAULT_SSL_SESSION_TIMEOUT)
 {
 }
 
@@ -44,22 +57,104 @@ void Server::setHost(const std::string& host) {
     _host = host;
 }
 
+void Server::setHost(std::string&& host) {
+    _host = std::move(host);
+}
+
 void Server::addServerName(const std::string& name) {
     _server_names.push_back(name);
 }
 
+void Server::addServerName(std::string&& name) {
+    _server_names.push_back(std::move(name));
+}
+
 void Server::setErrorPage(int code, const std::string& path) {
     _error_pages[code] = path;
 }
 
+void Server::setErrorPage(int code, std::string&& path) {
+    _error_pages[code] = std::move(path);
+}
+
 void Server::setClientMaxBodySize(size_t size) {
     _client_max_body_size = size;
 }
 
 void Server::addLocation(const Location& location) {
+    _routes.insert(location.getPath(), _locations.size());
     _locations.push_back(location);
 }
 
+void Server::addLocation(Location&& location) {
+    _routes.insert(location.getPath(), _locations.size());
+    _locations.push_back(std::move(location));
+}
+
+// Builds the block in place; the parser fills it in after the path is known
+Location& Server::emplaceLocation(std::string_view path) {
+    Location& location = _locations.emplace_back();
+    location.setPath(path);
+    _routes.insert(location.getPath(), _locations.size() - 1);
+    return location;
+}
+
+void Server::setKeepAliveTimeout(size_t seconds) {
+    _keepalive_timeout = seconds;
+}
+
+void Server::setKeepAliveRequests(size_t count) {
+    _keepalive_requests = count;
+}
+
+void Server::setClientHeaderTimeout(size_t seconds) {
+    _header_timeout = seconds;
+}
+
+void Server::setClientBodyTimeout(size_t seconds) {
+    _body_timeout = seconds;
+}
+
+void Server::setSendTimeout(size_t seconds) {
+    _send_timeout = seconds;
+}
+
+void Server::setListenBacklog(int backlog) {
+    _listen_backlog = backlog;
+}
+
+void Server::setBusyPoll(int microseconds) {
+    _busy_poll = microseconds;
+}
+
+void Server::setDefaultServer(bool is_default) {
+    _default_server = is_default;
+}
+
+void Server::setSsl(bool enabled) {
+    _ssl = enabled;
+}
+
+void Server::setSslCertificate(const std::string& path) {
+    _ssl_certificate = path;
+}
+
+void Server::setSslCertificateKey(const std::string& path) {
+    _ssl_certificate_key = path;
+}
+
+void Server::setSslSessionCache(size_t sessions) {
+    _ssl_session_cache = sessions;
+}
+
+void Server::setSslSessionTimeout(size_t seconds) {
+    _ssl_session_timeout = seconds;
+}
+
+void Server::setSslSessionTickets(bool enabled) {
+    _ssl_session_tickets = enabled;
+}
+
 // --- Getters ---
 
 int Server::getPort() const noexcept {
@@ -86,10 +181,73 @@ const std::vector<Location>& Server::getLocations() const noexcept {
     return _locations;
 }
 
+size_t Server::getKeepAliveTimeout() const noexcept {
+    return _keepalive_timeout;
+}
+
+size_t Server::getKeepAliveRequests() const noexcept {
+    return _keepalive_requests;
+}
+
+size_t Server::getClientHeaderTimeout() const noexcept {
+    return _header_timeout;
+}
+
+size_t Server::getClientBodyTimeout() const noexcept {
+    return _body_timeout;
+}
+
+size_t Server::getSendTimeout() const noexcept {
+    return _send_timeout;
+}
+
+int Server::getListenBacklog() const noexcept {
+    return _listen_backlog;
+}
+
+int Server::getBusyPoll() const noexcept {
+    return _busy_poll;
+}
+
+bool Server::isDefaultServer() const noexcept {
+    return _default_server;
+}
+
+bool Server::isSsl() const noexcept {
+    return _ssl;
+}
+
+const std::string& Server::getSslCertificate() const noexcept {
+    return _ssl_certificate;
+}
+
+const std::string& Server::getSslCertificateKey() const noexcept {
+    return _ssl_certificate_key;
+}
+
+size_t Server::getSslSessionCache() const noexcept {
+    return _ssl_session_cache;
+}
+
+size_t Server::getSslSessionTimeout() const noexcept {
+    return _ssl_session_timeout;
+}
+
+bool Server::isSslSessionTickets() const noexcept {
+    return _ssl_session_tickets;
+}
+
 bool Server::hasServerName(const std::string& name) const {
     for (const std::string& server_name : _server_names) {
         if (server_name == name)
             return true;
     }
     return false;
-}
\ No newline at end of file
+}
+
+const Location* Server::findLocation(std::string_view path) const noexcept {
+    const std::int32_t index = _routes.find(path);
+    if (index == RouteTable::NO_ROUTE)
+        return NULL;
+    return &_locations[static_cast<size_t>(index)];
+}
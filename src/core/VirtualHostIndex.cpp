@@ -0,0 +1,153 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   VirtualHostIndex.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:15:39 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:15:39 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    VirtualHostIndex.cpp
+ * @brief   Implements the VirtualHostIndex hash table.
+ *
+ * @details Names are lowercased at build time. Hashing lowercases each byte as it
+ * goes, so a lookup never has to copy the Host header.
+ *
+ * @ingroup config
+ */
+
+#include "core/VirtualHostIndex.hpp"
+#include "utils/StringUtils.hpp"
+
+namespace {
+
+constexpr std::size_t MAX_HOST_LENGTH = 255; // RFC 1035 limit on a full domain name
+
+} // namespace
+
+VirtualHostIndex::VirtualHostIndex() : _count(0) {
+}
+
+VirtualHostIndex::VirtualHostIndex(const std::vector<Server>& servers) : _count(0) {
+    for (const Server& server : servers) {
+        const int port = server.getPort();
+        std::unordered_map<int, const Server*>::iterator it = _defaults.find(port);
+        if (it == _defaults.end())
+            _defaults[port] = &server;
+        else if (server.isDefaultServer() && !it->second->isDefaultServer())
+            it->second = &server;
+
+        for (const std::string& configured : server.getServerNames()) {
+            std::string_view name = configured;
+            if (name.size() > 2 && name.compare(0, 2, "*.") == 0) {
+                insert(port, true, name.substr(1), &server);
+            } else if (name.size() > 1 && name[0] == '.') {
+                insert(port, false, name.substr(1), &server);
+                insert(port, true, name, &server);
+            } else if (!name.empty()) {
+                insert(port, false, name, &server);
+            }
+        }
+    }
+}
+
+std::uint64_t VirtualHostIndex::hashKey(int port, bool wildcard, std::string_view name) noexcept {
+    // FNV-1a over the port, the wildcard flag and the lowercased name
+    std::uint64_t hash = 1469598103934665603ULL;
+    const auto    mix  = [&hash](unsigned char byte) {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    };
+    const std::uint32_t key = static_cast<std::uint32_t>(port);
+    for (int shift = 0; shift < 32; shift += 8)
+        mix(static_cast<unsigned char>(key >> shift));
+    mix(wildcard ? 1 : 0);
+    for (char c : name)
+        mix(static_cast<unsigned char>(toLowerAscii(c)));
+    return hash;
+}
+
+void VirtualHostIndex::insert(int port, bool wildcard, std::string_view name,
+                              const Server* server) {
+    if (lookup(port, wildcard, name))
+        return; // First server keeps a duplicate name
+    if ((_count + 1) * 2 > _table.size())
+        grow();
+
+    const std::uint64_t hash = hashKey(port, wildcard, name);
+    const std::size_t   mask = _table.size() - 1;
+    std::size_t         slot = static_cast<std::size_t>(hash) & mask;
+    while (_table[slot].server)
+        slot = (slot + 1) & mask;
+
+    Entry& entry   = _table[slot];
+    entry.name     = toLower(name);
+    entry.hash     = hash;
+    entry.port     = port;
+    entry.wildcard = wildcard;
+    entry.server   = server;
+    ++_count;
+}
+
+void VirtualHostIndex::grow() {
+    std::vector<Entry> old;
+    old.swap(_table);
+    _table.resize(old.empty() ? 16 : old.size() * 2);
+    const std::size_t mask = _table.size() - 1;
+
+    for (Entry& entry : old) {
+        if (!entry.server)
+            continue;
+        std::size_t slot = static_cast<std::size_t>(entry.hash) & mask;
+        while (_table[slot].server)
+            slot = (slot + 1) & mask;
+        _table[slot] = std::move(entry);
+    }
+}
+
+const Server* VirtualHostIndex::lookup(int port, bool wildcard,
+                                       std::string_view name) const noexcept {
+    if (_table.empty())
+        return NULL;
+    const std::uint64_t hash = hashKey(port, wildcard, name);
+    const std::size_t   mask = _table.size() - 1;
+
+    for (std::size_t slot = static_cast<std::size_t>(hash) & mask; _table[slot].server;
+         slot = (slot + 1) & mask) {
+        const Entry& entry = _table[slot];
+        if (entry.hash == hash && entry.port == port && entry.wildcard == wildcard &&
+            iequals(entry.name, name))
+            return entry.server;
+    }
+    return NULL;
+}
+
+const Server* VirtualHostIndex::find(int port, std::string_view host) const noexcept {
+    if (!host.empty() && host.back() == '.')
+        host.remove_suffix(1); // "example.com." is the same absolute name
+    if (host.empty() || host.size() > MAX_HOST_LENGTH)
+        return getDefault(port);
+
+    if (const Server* server = lookup(port, false, host))
+        return server;
+    // "*.example.com" is stored as ".example.com"; try the longest suffix first
+    for (std::size_t dot = host.find('.'); dot != std::string_view::npos;
+         dot             = host.find('.', dot + 1)) {
+        if (const Server* server = lookup(port, true, host.substr(dot)))
+            return server;
+    }
+    return getDefault(port);
+}
+
+const Server* VirtualHostIndex::getDefault(int port) const noexcept {
+    std::unordered_map<int, const Server*>::const_iterator it = _defaults.find(port);
+    return it == _defaults.end() ? NULL : it->second;
+}
+
+std::size_t VirtualHostIndex::size() const noexcept {
+    return _count;
+}
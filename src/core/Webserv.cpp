@@ -0,0 +1,302 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Webserv.cpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/04/26 16:00:00 by nlouis            #+#    #+#             */
+/*   Updated: 2025/05/17 18:22:10 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Webserv.cpp
+ * @brief   Implements the master / worker process and thread model.
+ *
+ * @details Signals are never handled asynchronously inside the event loops: worker
+ * threads run with SIGINT and SIGTERM blocked, and a dedicated thread collects them
+ * with `sigwait()`, then calls SocketManager::stop() on every loop, or
+ * SocketManager::reload() on `SIGHUP`.
+ *
+ * @ingroup core
+ */
+
+#include "core/Webserv.hpp"
+#include "network/SocketManager.hpp"
+#include "utils/CpuAffinity.hpp"
+#include "utils/Logger.hpp"
+#include <csignal>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <pthread.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+const std::chrono::seconds STARTUP_GRACE(1); // Workers dying faster are not restarted
+
+sigset_t controlSignals() {
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGINT);
+    sigaddset(&set, SIGTERM);
+    sigaddset(&set, SIGHUP); // Reload, handled on the same thread
+    return set;
+}
+
+} // namespace
+
+// The config moves into the snapshot only once every setting is read from it
+Webserv::Webserv(Config config, ConfigLoader loader)
+    : _config(), _loader(std::move(loader)),
+      _processes(resolveCount(config.getWorkerProcesses())),
+      _threads(resolveCount(config.getWorkerThreads())), _backend(config.getEventBackend()),
+      _cpus(resolveCpus(config)), _numa_local(config.isNumaLocal()),
+      _stats(StatsRegistry::create(_processes * _threads)) {
+    _config = ConfigSnapshot::create(std::move(config));
+}
+
+std::size_t Webserv::resolveCount(std::size_t configured) noexcept {
+    if (configured > 0)
+        return configured;
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? static_cast<std::size_t>(cpus) : 1;
+}
+
+// Resolved once, in the master: restarted workers keep the CPUs of their slot
+std::vector<unsigned> Webserv::resolveCpus(const Config& config) {
+    switch (config.getCpuAffinity()) {
+        case CpuAffinity::AUTO: return allowedCpus();
+        case CpuAffinity::LIST: return config.getWorkerCpus();
+        default: return std::vector<unsigned>();
+    }
+}
+
+std::size_t Webserv::getWorkerProcesses() const noexcept {
+    return _processes;
+}
+
+std::size_t Webserv::getWorkerThreads() const noexcept {
+    return _threads;
+}
+
+// Parsing and compiling happen here, never on an event loop
+std::shared_ptr<const ConfigSnapshot> Webserv::loadSnapshot() const {
+    if (!_loader) {
+        LOG_WARN("SIGHUP ignored: no configuration source to reload from");
+        return NULL;
+    }
+    try {
+        return ConfigSnapshot::create(_loader());
+    } catch (const std::exception& e) {
+        LOG_ERROR("Reload failed, keeping the current configuration: %s", e.what());
+        return NULL;
+    }
+}
+
+int Webserv::run() {
+    if (_processes == 1)
+        return runWorker(0);
+    return runMaster();
+}
+
+// --- Worker ---
+
+void Webserv::placeLoop(std::size_t loop) const {
+    if (_cpus.empty())
+        return;
+    const unsigned cpu = _cpus[loop % _cpus.size()];
+    if (!pinThreadToCpu(cpu)) {
+        LOG_WARN("Event loop %zu: cannot pin to CPU %u: %s", loop, cpu, strerror(errno));
+        return;
+    }
+    if (!_numa_local) {
+        LOG_INFO("Event loop %zu on CPU %u", loop, cpu);
+        return;
+    }
+    const int node = preferLocalNode();
+    if (node < 0)
+        LOG_WARN("Event loop %zu on CPU %u, memory policy unchanged: %s", loop, cpu,
+                 strerror(errno));
+    else
+        LOG_INFO("Event loop %zu on CPU %u, memory of node %d", loop, cpu, node);
+}
+
+// Every event loop is built and run on its own thread; this one only waits for signals
+int Webserv::runWorker(std::size_t slot) {
+    const sigset_t control_set = controlSignals();
+    pthread_sigmask(SIG_BLOCK, &control_set, NULL); // Inherited by the loop threads below
+
+    const bool                                  reuse_port = _processes * _threads > 1;
+    std::vector<std::unique_ptr<SocketManager>> loops(_threads);
+    std::vector<std::promise<void>>             built(_threads);
+    std::vector<std::future<void>>              ready;
+    std::promise<bool>                          start;
+    const std::shared_future<bool>              started = start.get_future().share();
+    for (std::size_t i = 0; i < _threads; ++i)
+        ready.push_back(built[i].get_future());
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < _threads; ++i) {
+        const std::size_t index = slot * _threads + i;
+        threads.push_back(std::thread([this, index, reuse_port, started, &loops, &built, i]() {
+            try {
+                placeLoop(index);
+                loops[i].reset(new SocketManager(_config, _backend, reuse_port, _stats, index));
+                built[i].set_value();
+            } catch (...) {
+                built[i].set_exception(std::current_exception());
+                return;
+            }
+            if (!started.get())
+                return; // Another loop failed to start
+            try {
+                loops[i]->run();
+            } catch (const std::exception& e) {
+                LOG_ERROR("Event loop failed: %s", e.what());
+                kill(getpid(), SIGTERM); // Take the whole worker down with it
+            }
+        }));
+    }
+
+    bool ok = true;
+    for (std::size_t i = 0; i < ready.size(); ++i) {
+        try {
+            ready[i].get();
+        } catch (const std::exception& e) {
+            LOG_ERROR("Worker %d failed to start: %s", static_cast<int>(getpid()), e.what());
+            ok = false;
+        }
+    }
+    start.set_value(ok);
+    if (!ok) {
+        for (std::size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+        return 1;
+    }
+
+    int signum = 0;
+    while (sigwait(&control_set, &signum) == 0 && signum == SIGHUP) {
+        std::shared_ptr<const ConfigSnapshot> config = loadSnapshot();
+        if (!config)
+            continue;
+        _config = config;
+        for (std::size_t i = 0; i < loops.size(); ++i)
+            loops[i]->reload(config);
+    }
+    for (std::size_t i = 0; i < loops.size(); ++i)
+        loops[i]->stop();
+    for (std::size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+    return 0;
+}
+
+// --- Master ---
+
+int Webserv::runMaster() {
+    sigset_t master_set = controlSignals();
+    sigaddset(&master_set, SIGCHLD);
+    sigset_t original;
+    sigprocmask(SIG_BLOCK, &master_set, &original);
+
+    LOG_INFO("Master %d: starting %zu workers with %zu event loop(s) each",
+             static_cast<int>(getpid()), _processes, _threads);
+    _workers.assign(_processes, Worker());
+    for (std::size_t slot = 0; slot < _processes; ++slot) {
+        _workers[slot].pid = spawnWorker(slot);
+        _workers[slot].started = Clock::now();
+    }
+
+    bool stopping = false;
+    while (true) {
+        int signum = 0;
+        sigwait(&master_set, &signum);
+        if (signum == SIGCHLD) {
+            if (!reapWorkers(stopping))
+                break; // No worker left
+            continue;
+        }
+        if (signum == SIGHUP) {
+            if (stopping)
+                continue;
+            // Checked here first: workers are only told to reload a configuration that loads
+            std::shared_ptr<const ConfigSnapshot> config = loadSnapshot();
+            if (!config)
+                continue;
+            _config = config;
+            LOG_INFO("Master %d: reloading workers", static_cast<int>(getpid()));
+            for (std::size_t slot = 0; slot < _workers.size(); ++slot) {
+                if (_workers[slot].pid > 0)
+                    kill(_workers[slot].pid, SIGHUP);
+            }
+            continue;
+        }
+        if (!stopping) {
+            LOG_INFO("Master %d: stopping workers", static_cast<int>(getpid()));
+            stopping = true;
+            for (std::size_t slot = 0; slot < _workers.size(); ++slot) {
+                if (_workers[slot].pid > 0)
+                    kill(_workers[slot].pid, SIGTERM);
+            }
+        }
+    }
+    sigprocmask(SIG_SETMASK, &original, NULL);
+    return stopping ? 0 : 1;
+}
+
+pid_t Webserv::spawnWorker(std::size_t slot) {
+    std::cout.flush();
+    const pid_t pid = fork();
+    if (pid < 0) {
+        LOG_ERROR("fork() failed: %s", strerror(errno));
+        return -1;
+    }
+    if (pid == 0) {
+        // The worker waits on SIGINT / SIGTERM itself; SIGCHLD is the master's business
+        sigset_t child_set;
+        sigemptyset(&child_set);
+        sigaddset(&child_set, SIGCHLD);
+        sigprocmask(SIG_UNBLOCK, &child_set, NULL);
+        _workers.clear();
+        const int status = runWorker(slot);
+        std::cout.flush();
+        Logger::flush(); // _exit() skips the Logger's destructor
+        _exit(status);
+    }
+    LOG_INFO("Master %d: worker %zu has pid %d", static_cast<int>(getpid()), slot,
+             static_cast<int>(pid));
+    return pid;
+}
+
+// Collect exited workers and restart crashed ones; returns false once none is alive
+bool Webserv::reapWorkers(bool stopping) {
+    int   status = 0;
+    pid_t pid;
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+        for (std::size_t slot = 0; slot < _workers.size(); ++slot) {
+            Worker& worker = _workers[slot];
+            if (worker.pid != pid)
+                continue;
+            worker.pid = -1;
+            if (stopping)
+                break;
+            if (Clock::now() - worker.started < STARTUP_GRACE) {
+                LOG_ERROR("Master: worker %zu exited during startup, not restarting", slot);
+                break;
+            }
+            LOG_ERROR("Master: worker %zu died (status %d), restarting", slot, status);
+            worker.pid     = spawnWorker(slot);
+            worker.started = Clock::now();
+            break;
+        }
+    }
+    for (std::size_t slot = 0; slot < _workers.size(); ++slot) {
+        if (_workers[slot].pid > 0)
+            return true;
+    }
+    return false;
+}
@@ -10,69 +10,76 @@
 /*                                                                            */
 /* ************************************************************************** */
 
+#include <chrono>
+#include <cstring>
 #include <iostream>
-#include "network/SocketManager.hpp"
+#include "config/ConfigParser.hpp"
+#include "core/Webserv.hpp"
 #include "utils/PrintInfo.hpp"
 
+#define DEFAULT_CONFIG "./configs/default.conf"
+
+// Parses the file and reports what it holds; nothing is bound or started
+static int	check_config(const std::string& config_file)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	try {
+		const Config config = ConfigParser::parseFile(config_file);
+		const std::chrono::duration<double, std::milli> elapsed =
+			std::chrono::steady_clock::now() - start;
+
+		const std::vector<Server>& servers = config.getServers();
+		size_t locations = 0;
+		for (size_t i = 0; i < servers.size(); ++i)
+			locations += servers[i].getLocations().size();
+		std::cout << config_file << ": syntax is ok, " << servers.size() << " servers, "
+				  << locations << " locations, parsed in " << elapsed.count() << " ms"
+				  << std::endl;
+		return (0);
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return (1);
+	}
+}
+
 int	main(int ac, char** av)
 {
-	std::string config_file;
+	std::string config_file = DEFAULT_CONFIG;
 
-	if (ac == 1)
-		config_file = "./configs/default.conf";
-	else if (ac == 2)
+	if (ac >= 2 && std::strcmp(av[1], "--check-config") == 0)
+	{
+		if (ac > 3)
+		{
+			print_usage();
+			return (1);
+		}
+		return (check_config(ac == 3 ? av[2] : config_file));
+	}
+	if (ac == 2)
 		config_file = av[1];
-	else
+	else if (ac > 2)
 	{
 		print_usage();
 		return(0);
 	}
 
 	try {
-		// Manually define a server. We remove it as soon as we have a parser.
-		// This is just a test to see if the server can be created and run.
-		Server server;
-		server.setHost("127.0.0.1");
-		server.setPort(8080);
-		server.addServerName("example.com");
-		server.setClientMaxBodySize(1000000);
-		server.setErrorPage(404, "/errors/404.html");
-
-		// Define a location block
-		Location loc;
-		loc.setPath("/");
-		loc.setRoot("/var/www/html");
-		loc.setAutoindex(false);
-		loc.setIndex("index.html");
-		loc.addMethod("GET");
-		loc.addMethod("POST");
-
-		// Add location to server
-		server.addLocation(loc);
-
-		// Optional: another location
-		Location uploadLoc;
-		uploadLoc.setPath("/uploads");
-		uploadLoc.setRoot("/var/www/uploads");
-		uploadLoc.setAutoindex(true);
-		uploadLoc.addMethod("POST");
-		uploadLoc.setUploadStore("/var/www/uploads");
-
-		server.addLocation(uploadLoc);
-
-		Config config;
-		config.addServer(server);
+		Config config = ConfigParser::parseFile(config_file);
 
 		// Print the configuration
 		print_config(config);
 
-		std::vector<Server> all_servers = config.getServers();
-		SocketManager manager(all_servers);
-		manager.run();
+		// Workers share one immutable snapshot; SIGHUP parses the file again and swaps it in
+		Webserv webserv(std::move(config),
+						[config_file]() { return ConfigParser::parseFile(config_file); });
+		return (webserv.run());
+	} catch (const ConfigParser::ParseError& e) {
+		std::cerr << e.what() << std::endl;
+		return (1);
 	} catch (const std::exception& e) {
 		std::cerr << "Unexpected error: " << e.what() << std::endl;
 		return (1);
 	}
 
 	return (0);
-}
\ No newline at end of file
+}
@@ -0,0 +1,154 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AssetCache.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:31:21 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:12:25 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    AssetCache.cpp
+ * @brief   Implements CachedResponse and the AssetCache LRU.
+ *
+ * @ingroup http
+ */
+
+#include "http/AssetCache.hpp"
+#include "http/HttpResponse.hpp"
+#include <iterator>
+
+// --- CachedResponse ---
+
+CachedResponse::CachedResponse(const HttpResponse&                      response,
+                               const std::shared_ptr<const CachedFile>& source)
+    : _status(response.getStatus()), _data(response.serializeHead()), _head_length(0),
+      _source(source) {
+    _data.resize(_data.size() - 2); // The blank line is written after per-connection fields
+    _head_length = _data.size();
+    _data += response.getBody();
+}
+
+int CachedResponse::getStatus() const noexcept {
+    return _status;
+}
+
+const std::string& CachedResponse::getData() const noexcept {
+    return _data;
+}
+
+std::size_t CachedResponse::getHeadLength() const noexcept {
+    return _head_length;
+}
+
+std::string_view CachedResponse::getHead() const noexcept {
+    return std::string_view(_data).substr(0, _head_length);
+}
+
+std::string_view CachedResponse::getBody() const noexcept {
+    return std::string_view(_data).substr(_head_length);
+}
+
+bool CachedResponse::isBuiltFrom(const std::shared_ptr<const CachedFile>& file) const noexcept {
+    return !_source.owner_before(file) && !file.owner_before(_source);
+}
+
+// --- AssetCache ---
+
+constexpr std::size_t AssetCache::DEFAULT_CAPACITY;
+constexpr std::size_t AssetCache::DEFAULT_MAX_ASSET;
+
+AssetCache::AssetCache(std::size_t capacity, std::size_t max_asset)
+    : _capacity(capacity), _max_asset(max_asset), _memory(0), _hits(0), _misses(0) {
+}
+
+std::shared_ptr<const CachedResponse>
+AssetCache::find(int status, std::string_view path,
+                 const std::shared_ptr<const CachedFile>& source, ContentCoding coding) {
+    const Key                                                   key = {status, path, coding};
+    std::unordered_map<Key, EntryList::iterator, KeyHash>::iterator it  = _index.find(key);
+    if (it == _index.end()) {
+        ++_misses;
+        return NULL;
+    }
+    EntryList::iterator entry = it->second;
+    if (!entry->response->isBuiltFrom(source)) {
+        erase(entry); // The file was reopened after a change
+        ++_misses;
+        return NULL;
+    }
+    _lru.splice(_lru.begin(), _lru, entry); // Mark as most recently used
+    ++_hits;
+    return entry->response;
+}
+
+std::shared_ptr<const CachedResponse>
+AssetCache::insert(std::string_view path, const std::shared_ptr<const CachedFile>& source,
+                   const HttpResponse& response, ContentCoding coding) {
+    if (!accepts(response.getBody().size()))
+        return NULL;
+    std::shared_ptr<const CachedResponse> cached =
+        std::make_shared<const CachedResponse>(response, source);
+    const std::size_t bytes = cached->getData().size();
+    if (bytes > _capacity)
+        return NULL;
+
+    const Key key = {cached->getStatus(), path, coding};
+    std::unordered_map<Key, EntryList::iterator, KeyHash>::iterator it = _index.find(key);
+    if (it != _index.end())
+        erase(it->second);
+    while (_memory + bytes > _capacity)
+        erase(std::prev(_lru.end()));
+
+    Entry entry;
+    entry.path     = std::string(path);
+    entry.coding   = coding;
+    entry.response = cached;
+    _lru.push_front(std::move(entry));
+    _index[Key{cached->getStatus(), _lru.front().path, coding}] = _lru.begin();
+    _memory += bytes;
+    return cached;
+}
+
+bool AssetCache::accepts(std::size_t size) const noexcept {
+    return _capacity > 0 && size <= _max_asset;
+}
+
+void AssetCache::erase(EntryList::iterator it) noexcept {
+    _index.erase(Key{it->response->getStatus(), it->path, it->coding});
+    _memory -= it->response->getData().size();
+    _lru.erase(it);
+}
+
+void AssetCache::clear() noexcept {
+    _index.clear();
+    _lru.clear();
+    _memory = 0;
+}
+
+std::size_t AssetCache::size() const noexcept {
+    return _lru.size();
+}
+
+std::size_t AssetCache::getMemoryUsage() const noexcept {
+    return _memory;
+}
+
+std::size_t AssetCache::getCapacity() const noexcept {
+    return _capacity;
+}
+
+std::size_t AssetCache::getMaxAssetSize() const noexcept {
+    return _max_asset;
+}
+
+std::size_t AssetCache::getHits() const noexcept {
+    return _hits;
+}
+
+std::size_t AssetCache::getMisses() const noexcept {
+    return _misses;
+}
@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ChunkedDecoder.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:24:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:24:13 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    ChunkedDecoder.cpp
+ * @brief   Implements the ChunkedDecoder class.
+ *
+ * @ingroup http
+ */
+
+#include "http/ChunkedDecoder.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+int hexValue(char c) noexcept {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+} // namespace
+
+ChunkedDecoder::ChunkedDecoder() noexcept {
+    reset();
+}
+
+void ChunkedDecoder::reset() noexcept {
+    _state     = State::SIZE;
+    _remaining = 0;
+    _line      = 0;
+    _digits    = false;
+}
+
+// Framing is checked strictly (CRLF only), so no other parser can frame the body differently
+ChunkedDecoder::Result ChunkedDecoder::decode(char* data, std::size_t& size,
+                                              std::size_t& consumed) noexcept {
+    std::size_t in     = 0;
+    std::size_t out    = 0;
+    Result      result = _state == State::DONE ? Result::DONE : Result::INCOMPLETE;
+
+    while (in < size && result == Result::INCOMPLETE) {
+        if (_state == State::DATA) {
+            const std::size_t count = std::min(_remaining, size - in);
+            if (out != in)
+                std::memmove(data + out, data + in, count);
+            in += count;
+            out += count;
+            _remaining -= count;
+            if (_remaining == 0)
+                _state = State::DATA_CR;
+            continue;
+        }
+
+        const char c = data[in++];
+        switch (_state) {
+        case State::SIZE:
+            if (hexValue(c) >= 0) {
+                if (_remaining > (SIZE_MAX >> 4))
+                    result = Result::ERROR; // Larger than any body we could accept
+                _remaining = (_remaining << 4) | static_cast<std::size_t>(hexValue(c));
+                _digits    = true;
+            } else if (_digits && (c == ';' || c == ' ' || c == '\t')) {
+                _state = State::EXTENSION;
+            } else if (_digits && c == '\r') {
+                _state = State::SIZE_LF;
+            } else {
+                result = Result::ERROR;
+            }
+            break;
+        case State::EXTENSION:
+            if (c == '\r')
+                _state = State::SIZE_LF;
+            else if (c == '\n')
+                result = Result::ERROR;
+            break;
+        case State::SIZE_LF:
+            if (c != '\n')
+                result = Result::ERROR;
+            _state = _remaining ? State::DATA : State::TRAILER;
+            _line  = 0;
+            break;
+        case State::DATA_CR:
+            if (c != '\r')
+                result = Result::ERROR;
+            _state = State::DATA_LF;
+            break;
+        case State::DATA_LF:
+            if (c != '\n')
+                result = Result::ERROR;
+            _state  = State::SIZE;
+            _digits = false;
+            _line   = 0;
+            break;
+        case State::TRAILER:
+            _state = c == '\r' ? State::END_LF : State::TRAILER_LINE;
+            if (c == '\n')
+                result = Result::ERROR;
+            break;
+        case State::TRAILER_LINE:
+            if (c == '\r')
+                _state = State::TRAILER_LINE_LF;
+            else if (c == '\n')
+                result = Result::ERROR;
+            break;
+        case State::TRAILER_LINE_LF:
+            if (c != '\n')
+                result = Result::ERROR;
+            _state = State::TRAILER;
+            break;
+        case State::END_LF:
+            _state = State::DONE;
+            result = c == '\n' ? Result::DONE : Result::ERROR;
+            break;
+        case State::DATA:
+        case State::DONE:
+            result = Result::ERROR;
+            break;
+        }
+        const bool in_trailers = _state == State::TRAILER || _state == State::TRAILER_LINE ||
+                                 _state == State::TRAILER_LINE_LF || _state == State::END_LF;
+        if (++_line > (in_trailers ? MAX_TRAILERS : MAX_LINE) && result == Result::INCOMPLETE)
+            result = Result::ERROR;
+    }
+    size     = out;
+    consumed = in;
+    return result;
+}
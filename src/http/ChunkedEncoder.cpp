@@ -0,0 +1,47 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ChunkedEncoder.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:26:08 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:26:08 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    ChunkedEncoder.cpp
+ * @brief   Implements the ChunkedEncoder class.
+ *
+ * @ingroup http
+ */
+
+#include "http/ChunkedEncoder.hpp"
+
+ChunkedEncoder::ChunkedEncoder() noexcept : _line(), _finished(false) {
+}
+
+// Written backwards from the CRLF, without the formatting machinery of snprintf()
+std::string_view ChunkedEncoder::chunkHead(std::size_t size) noexcept {
+    static const char HEX[] = "0123456789abcdef";
+    if (size == 0 || _finished)
+        return std::string_view();
+    std::size_t pos = MAX_SIZE_LINE;
+    _line[--pos]    = '\n';
+    _line[--pos]    = '\r';
+    for (; size; size >>= 4)
+        _line[--pos] = HEX[size & 0x0F];
+    return std::string_view(_line + pos, MAX_SIZE_LINE - pos);
+}
+
+std::string_view ChunkedEncoder::finish() noexcept {
+    if (_finished)
+        return std::string_view();
+    _finished = true;
+    return LAST_CHUNK;
+}
+
+bool ChunkedEncoder::isFinished() const noexcept {
+    return _finished;
+}
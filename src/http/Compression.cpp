@@ -0,0 +1,304 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Compression.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:12:25 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:12:25 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Compression.cpp
+ * @brief   Implements content-coding negotiation over zlib and the brotli encoder.
+ *
+ * @ingroup http
+ */
+
+#include "http/Compression.hpp"
+#include "utils/StringUtils.hpp"
+#include <algorithm>
+
+#ifdef WEBSERV_HAVE_ZLIB
+# include <zlib.h>
+#endif
+#ifdef WEBSERV_HAVE_BROTLI
+# include <brotli/encode.h>
+#endif
+
+namespace {
+
+constexpr std::size_t OUTPUT_STEP = 16 << 10; ///< Growth of the output per encoder call.
+
+enum Mode { PROCESS, FLUSH, FINISH };
+
+// q=0, 0.0, 0.00 or 0.000 refuse a coding; anything else accepts it
+bool isZeroQuality(std::string_view params) noexcept {
+    while (!params.empty()) {
+        const std::size_t semicolon = params.find(';');
+        std::string_view  param     = trim(params.substr(0, semicolon));
+        params = semicolon == std::string_view::npos ? std::string_view()
+                                                     : params.substr(semicolon + 1);
+        if (param.size() < 2 || toLowerAscii(param[0]) != 'q' || param[1] != '=')
+            continue;
+        param.remove_prefix(2);
+        return !param.empty() && param[0] == '0' &&
+               param.find_first_not_of("0.", 1) == std::string_view::npos;
+    }
+    return false;
+}
+
+} // namespace
+
+// --- Negotiation ---
+
+std::string_view codingName(ContentCoding coding) noexcept {
+    switch (coding) {
+        case ContentCoding::GZIP: return "gzip";
+        case ContentCoding::BROTLI: return "br";
+        default: return "identity";
+    }
+}
+
+std::string_view codingSuffix(ContentCoding coding) noexcept {
+    switch (coding) {
+        case ContentCoding::GZIP: return ".gz";
+        case ContentCoding::BROTLI: return ".br";
+        default: return "";
+    }
+}
+
+std::string_view contentEncodingField(ContentCoding coding) noexcept {
+    switch (coding) {
+        case ContentCoding::GZIP: return "Content-Encoding: gzip\r\n";
+        case ContentCoding::BROTLI: return "Content-Encoding: br\r\n";
+        default: return "";
+    }
+}
+
+ContentCoding parseCodingName(std::string_view name) noexcept {
+    if (name == "gzip")
+        return ContentCoding::GZIP;
+    if (name == "br")
+        return ContentCoding::BROTLI;
+    return ContentCoding::IDENTITY;
+}
+
+unsigned parseAcceptEncoding(std::string_view value) noexcept {
+    unsigned accepted = 0;
+    unsigned named    = 0;
+    bool     any      = false;
+    while (!value.empty()) {
+        const std::size_t      comma   = value.find(',');
+        const std::string_view element = value.substr(0, comma);
+        value = comma == std::string_view::npos ? std::string_view() : value.substr(comma + 1);
+
+        const std::size_t      semicolon = element.find(';');
+        const std::string_view name      = trim(element.substr(0, semicolon));
+        const bool             refused   = semicolon != std::string_view::npos &&
+                                           isZeroQuality(element.substr(semicolon + 1));
+        unsigned bit = 0;
+        if (iequals(name, "gzip") || iequals(name, "x-gzip"))
+            bit = codingBit(ContentCoding::GZIP);
+        else if (iequals(name, "br"))
+            bit = codingBit(ContentCoding::BROTLI);
+        else if (name == "*")
+            any = !refused;
+        named |= bit;
+        if (!refused)
+            accepted |= bit;
+    }
+    if (any)
+        accepted |= ~named & (codingBit(ContentCoding::GZIP) | codingBit(ContentCoding::BROTLI));
+    return accepted;
+}
+
+ContentCoding preferredCoding(unsigned mask) noexcept {
+    if (mask & codingBit(ContentCoding::BROTLI))
+        return ContentCoding::BROTLI;
+    if (mask & codingBit(ContentCoding::GZIP))
+        return ContentCoding::GZIP;
+    return ContentCoding::IDENTITY;
+}
+
+unsigned availableCodings() noexcept {
+    unsigned mask = 0;
+#ifdef WEBSERV_HAVE_ZLIB
+    mask |= codingBit(ContentCoding::GZIP);
+#endif
+#ifdef WEBSERV_HAVE_BROTLI
+    mask |= codingBit(ContentCoding::BROTLI);
+#endif
+    return mask;
+}
+
+// The usual text types; images, audio, video and archives are compressed already
+bool isCompressibleType(std::string_view content_type) noexcept {
+    const std::string_view type = trim(content_type.substr(0, content_type.find(';')));
+    static const std::string_view PREFIXES[] = {"text/"};
+    static const std::string_view TYPES[]    = {
+        "application/javascript", "application/json",   "application/xml",
+        "application/xhtml+xml",  "application/rss+xml", "application/atom+xml",
+        "application/wasm",       "image/svg+xml",       "application/manifest+json"};
+    for (std::string_view prefix : PREFIXES) {
+        if (type.size() > prefix.size() && iequals(type.substr(0, prefix.size()), prefix))
+            return true;
+    }
+    for (std::string_view known : TYPES) {
+        if (iequals(type, known))
+            return true;
+    }
+    return false;
+}
+
+// --- Compressor ---
+
+Compressor::Compressor(ContentCoding coding, int level) : _coding(coding), _state(NULL) {
+    level = std::clamp(level, 1, 9);
+#ifdef WEBSERV_HAVE_ZLIB
+    if (coding == ContentCoding::GZIP) {
+        z_stream* stream = new z_stream();
+        // 15 bits of window, plus 16 for the gzip wrapper instead of zlib's
+        if (deflateInit2(stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK)
+            _state = stream;
+        else
+            delete stream;
+    }
+#endif
+#ifdef WEBSERV_HAVE_BROTLI
+    if (coding == ContentCoding::BROTLI) {
+        BrotliEncoderState* state = BrotliEncoderCreateInstance(NULL, NULL, NULL);
+        if (state) {
+            // Quality 0-11; 9 is already much slower than gzip, 10 and 11 are for offline use
+            BrotliEncoderSetParameter(state, BROTLI_PARAM_QUALITY,
+                                      static_cast<std::uint32_t>(level));
+            _state = state;
+        }
+    }
+#endif
+}
+
+Compressor::~Compressor() {
+    if (!_state)
+        return;
+#ifdef WEBSERV_HAVE_ZLIB
+    if (_coding == ContentCoding::GZIP) {
+        deflateEnd(static_cast<z_stream*>(_state));
+        delete static_cast<z_stream*>(_state);
+    }
+#endif
+#ifdef WEBSERV_HAVE_BROTLI
+    if (_coding == ContentCoding::BROTLI)
+        BrotliEncoderDestroyInstance(static_cast<BrotliEncoderState*>(_state));
+#endif
+}
+
+bool Compressor::isValid() const noexcept {
+    return _state != NULL;
+}
+
+bool Compressor::write(std::string_view input, std::string& out, bool flush) {
+    return run(input, out, flush ? FLUSH : PROCESS);
+}
+
+bool Compressor::finish(std::string& out) {
+    return run(std::string_view(), out, FINISH);
+}
+
+bool Compressor::compress(ContentCoding coding, int level, std::string_view input,
+                          std::string& out) {
+    Compressor compressor(coding, level);
+    return compressor.isValid() && compressor.run(input, out, FINISH);
+}
+
+// Grows the output in steps and lets the encoder fill it until it has nothing left
+bool Compressor::run(std::string_view input, std::string& out, int mode) {
+    if (!_state)
+        return false;
+#ifdef WEBSERV_HAVE_ZLIB
+    if (_coding == ContentCoding::GZIP) {
+        z_stream* stream = static_cast<z_stream*>(_state);
+        const int flush  = mode == FINISH ? Z_FINISH : mode == FLUSH ? Z_SYNC_FLUSH : Z_NO_FLUSH;
+        stream->next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream->avail_in = static_cast<uInt>(input.size());
+        int result;
+        do {
+            const std::size_t used = out.size();
+            out.resize(used + std::max(OUTPUT_STEP, input.size() / 2));
+            stream->next_out  = reinterpret_cast<Bytef*>(&out[used]);
+            stream->avail_out = static_cast<uInt>(out.size() - used);
+            result            = deflate(stream, flush);
+            out.resize(out.size() - stream->avail_out);
+            if (result == Z_STREAM_ERROR)
+                return false;
+        } while (stream->avail_out == 0 || (flush == Z_FINISH && result != Z_STREAM_END));
+        return true;
+    }
+#endif
+#ifdef WEBSERV_HAVE_BROTLI
+    if (_coding == ContentCoding::BROTLI) {
+        BrotliEncoderState*          state     = static_cast<BrotliEncoderState*>(_state);
+        const BrotliEncoderOperation operation = mode == FINISH  ? BROTLI_OPERATION_FINISH
+                                                 : mode == FLUSH ? BROTLI_OPERATION_FLUSH
+                                                                 : BROTLI_OPERATION_PROCESS;
+        std::size_t         available = input.size();
+        const std::uint8_t* next      = reinterpret_cast<const std::uint8_t*>(input.data());
+        do {
+            // The encoder keeps its own output buffer, taken below without a copy inside
+            std::size_t out_available = 0;
+            if (!BrotliEncoderCompressStream(state, operation, &available, &next, &out_available,
+                                             NULL, NULL))
+                return false;
+            std::size_t         size   = 0;
+            const std::uint8_t* output = BrotliEncoderTakeOutput(state, &size);
+            out.append(reinterpret_cast<const char*>(output), size);
+        } while (available > 0 || BrotliEncoderHasMoreOutput(state) ||
+                 (operation == BROTLI_OPERATION_FINISH && !BrotliEncoderIsFinished(state)));
+        return true;
+    }
+#endif
+    (void)input;
+    (void)out;
+    (void)mode;
+    return false;
+}
+
+// --- CompressionBudget ---
+
+CompressionBudget::CompressionBudget(unsigned percent)
+    : _percent(std::min(percent, 100U)), _tokens(BURST_NS), _refill(Clock::now()), _refused(0) {
+}
+
+void CompressionBudget::setPercent(unsigned percent) noexcept {
+    _percent = std::min(percent, 100U);
+}
+
+unsigned CompressionBudget::getPercent() const noexcept {
+    return _percent;
+}
+
+bool CompressionBudget::allows(Clock::time_point now) noexcept {
+    if (_percent >= 100)
+        return true; // A loop cannot spend more than all of its time
+    const std::int64_t elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - _refill).count();
+    if (elapsed > 0) {
+        _tokens = std::min(BURST_NS, _tokens + elapsed * _percent / 100);
+        _refill = now;
+    }
+    if (_percent > 0 && _tokens > 0)
+        return true;
+    ++_refused;
+    return false;
+}
+
+void CompressionBudget::charge(Clock::time_point started, Clock::time_point now) noexcept {
+    if (_percent < 100)
+        _tokens -= std::chrono::duration_cast<std::chrono::nanoseconds>(now - started).count();
+}
+
+std::uint64_t CompressionBudget::getRefused() const noexcept {
+    return _refused;
+}
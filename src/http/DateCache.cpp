@@ -0,0 +1,41 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   DateCache.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:45:44 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:45:44 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    DateCache.cpp
+ * @brief   Implements the DateCache.
+ *
+ * @ingroup http
+ */
+
+#include "http/DateCache.hpp"
+#include "utils/StringUtils.hpp"
+
+DateCache::DateCache() : _time(-1) {
+    update(std::time(NULL));
+}
+
+bool DateCache::update(std::time_t now) {
+    if (now == _time)
+        return false;
+    _time  = now;
+    _field = std::make_shared<const std::string>("Date: " + formatHttpDate(now) + "\r\n");
+    return true;
+}
+
+const std::shared_ptr<const std::string>& DateCache::getField() const noexcept {
+    return _field;
+}
+
+std::time_t DateCache::getTime() const noexcept {
+    return _time;
+}
@@ -0,0 +1,268 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   DirectoryListing.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:48:46 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:48:46 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    DirectoryListing.cpp
+ * @brief   Implements DirectoryListing, DirectoryScan and the ListingCache LRU.
+ *
+ * @ingroup http
+ */
+
+#include "http/DirectoryListing.hpp"
+#include "utils/StringUtils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <iterator>
+#include <sys/stat.h>
+
+namespace {
+
+#if defined(__APPLE__)
+std::time_t modificationTime(const struct stat& st) {
+    return st.st_mtimespec.tv_sec;
+}
+#else
+std::time_t modificationTime(const struct stat& st) {
+    return st.st_mtim.tv_sec;
+}
+#endif
+
+// nginx's autoindex date format, e.g. "06-Nov-1994 08:49", without the locale
+void appendListingDate(std::string& out, std::time_t time) {
+    static const char MONTHS[][4] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                     "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    struct tm         tm;
+    if (!gmtime_r(&time, &tm))
+        tm = {};
+    char buf[48];
+    std::snprintf(buf, sizeof(buf), "%02d-%.3s-%04d %02d:%02d", tm.tm_mday, MONTHS[tm.tm_mon % 12],
+                  tm.tm_year + 1900, tm.tm_hour, tm.tm_min);
+    out += buf;
+}
+
+} // namespace
+
+// --- DirectoryListing ---
+
+DirectoryListing::DirectoryListing(const std::shared_ptr<const CachedFile>& source)
+    : _offsets(1, 0), _source(source) {
+}
+
+std::size_t DirectoryListing::size() const noexcept {
+    return _offsets.size() - 1;
+}
+
+std::size_t DirectoryListing::getMemoryUsage() const noexcept {
+    return _rows.capacity() + _offsets.capacity() * sizeof(std::size_t);
+}
+
+std::string_view DirectoryListing::getRows(std::size_t first, std::size_t count) const noexcept {
+    first                  = std::min(first, size());
+    const std::size_t last = first + std::min(count, size() - first);
+    return std::string_view(_rows).substr(_offsets[first], _offsets[last] - _offsets[first]);
+}
+
+bool DirectoryListing::isBuiltFrom(const std::shared_ptr<const CachedFile>& directory) const
+    noexcept {
+    return !_source.owner_before(directory) && !directory.owner_before(_source);
+}
+
+void DirectoryListing::renderHead(std::string& out, std::string_view uri) {
+    out += "<html>\r\n<head><title>Index of ";
+    appendEscapedHtml(out, uri);
+    out += "</title></head>\r\n<body>\r\n<h1>Index of ";
+    appendEscapedHtml(out, uri);
+    out += "</h1>\r\n<table>\r\n";
+    if (uri != "/")
+        out += "<tr><td><a href=\"../\">../</a></td><td></td><td></td></tr>\r\n";
+}
+
+void DirectoryListing::renderTail(std::string& out, std::size_t page, std::size_t pages) {
+    out += "</table>\r\n";
+    if (pages > 1) {
+        out += "<p>Page " + std::to_string(page) + " of " + std::to_string(pages);
+        if (page > 1)
+            out += " <a href=\"?page=" + std::to_string(page - 1) + "\">previous</a>";
+        if (page < pages)
+            out += " <a href=\"?page=" + std::to_string(page + 1) + "\">next</a>";
+        out += "</p>\r\n";
+    }
+    out += "</body>\r\n</html>\r\n";
+}
+
+// --- DirectoryScan ---
+
+constexpr std::size_t DirectoryScan::STEP;
+
+DirectoryScan::DirectoryScan(std::string path, std::shared_ptr<const CachedFile> source)
+    : _path(std::move(path)), _building(new DirectoryListing(source)),
+      _dir(opendir(_path.c_str())), _rendered(0), _error(_dir ? 0 : errno) {
+}
+
+DirectoryScan::~DirectoryScan() {
+    if (_dir)
+        closedir(_dir);
+}
+
+bool DirectoryScan::step() {
+    if (_listing || _error)
+        return true;
+    if (_dir) {
+        if (read())
+            return false;
+        if (_error)
+            return true;
+        // Subdirectories first, each group in byte order, as nginx does
+        std::sort(_entries.begin(), _entries.end(), [](const Entry& a, const Entry& b) {
+            return a.directory != b.directory ? a.directory : a.name < b.name;
+        });
+        _building->_offsets.reserve(_entries.size() + 1);
+        return false;
+    }
+    render();
+    if (_rendered < _entries.size())
+        return false;
+    _entries.clear();
+    _entries.shrink_to_fit();
+    _building->_rows.shrink_to_fit(); // Cached for as long as the directory is unchanged
+    _listing = std::move(_building);
+    return true;
+}
+
+// True while entries remain; the directory is closed once it is read or failed
+bool DirectoryScan::read() {
+    const int fd = dirfd(_dir);
+    for (std::size_t n = 0; n < STEP; ++n) {
+        errno               = 0;
+        const dirent* entry = readdir(_dir);
+        if (!entry) {
+            _error = errno;
+            closedir(_dir);
+            _dir = NULL;
+            return false;
+        }
+        if (entry->d_name[0] == '.')
+            continue; // Hidden, and "." and ".."
+        struct stat st;
+        if (fstatat(fd, entry->d_name, &st, 0) != 0)
+            continue; // Removed meanwhile, or a dangling link
+        _entries.push_back(Entry{entry->d_name, static_cast<std::size_t>(st.st_size),
+                                 modificationTime(st), S_ISDIR(st.st_mode) != 0});
+    }
+    return true;
+}
+
+void DirectoryScan::render() {
+    std::string&      rows = _building->_rows;
+    const std::size_t end  = std::min(_entries.size(), _rendered + STEP);
+    for (; _rendered < end; ++_rendered) {
+        const Entry& entry = _entries[_rendered];
+        rows += "<tr><td><a href=\"";
+        appendPathSegment(rows, entry.name);
+        if (entry.directory)
+            rows += '/';
+        rows += "\">";
+        appendEscapedHtml(rows, entry.name);
+        if (entry.directory)
+            rows += '/';
+        rows += "</a></td><td>";
+        appendListingDate(rows, entry.mtime);
+        rows += "</td><td>";
+        rows += entry.directory ? "-" : std::to_string(entry.size);
+        rows += "</td></tr>\r\n";
+        _building->_offsets.push_back(rows.size());
+    }
+}
+
+const std::string& DirectoryScan::getPath() const noexcept {
+    return _path;
+}
+
+const std::shared_ptr<const DirectoryListing>& DirectoryScan::getListing() const noexcept {
+    return _listing;
+}
+
+int DirectoryScan::getError() const noexcept {
+    return _error;
+}
+
+// --- ListingCache ---
+
+constexpr std::size_t ListingCache::DEFAULT_CAPACITY;
+
+ListingCache::ListingCache(std::size_t capacity)
+    : _capacity(capacity), _memory(0), _hits(0), _misses(0) {
+}
+
+std::shared_ptr<const DirectoryListing>
+ListingCache::find(std::string_view path, const std::shared_ptr<const CachedFile>& directory) {
+    std::unordered_map<std::string_view, EntryList::iterator>::iterator it = _index.find(path);
+    if (it == _index.end()) {
+        ++_misses;
+        return NULL;
+    }
+    EntryList::iterator entry = it->second;
+    if (!entry->listing->isBuiltFrom(directory)) {
+        erase(entry); // The directory changed since it was read
+        ++_misses;
+        return NULL;
+    }
+    _lru.splice(_lru.begin(), _lru, entry);
+    ++_hits;
+    return entry->listing;
+}
+
+bool ListingCache::insert(std::string_view path, std::shared_ptr<const DirectoryListing> listing) {
+    const std::size_t bytes = listing->getMemoryUsage() + path.size();
+    if (bytes > _capacity)
+        return false;
+    std::unordered_map<std::string_view, EntryList::iterator>::iterator it = _index.find(path);
+    if (it != _index.end())
+        erase(it->second);
+    while (_memory + bytes > _capacity)
+        erase(std::prev(_lru.end()));
+
+    _lru.push_front(Entry{std::string(path), std::move(listing)});
+    _index[_lru.front().path] = _lru.begin();
+    _memory += bytes;
+    return true;
+}
+
+void ListingCache::erase(EntryList::iterator it) noexcept {
+    _index.erase(it->path);
+    _memory -= it->listing->getMemoryUsage() + it->path.size();
+    _lru.erase(it);
+}
+
+void ListingCache::clear() noexcept {
+    _index.clear();
+    _lru.clear();
+    _memory = 0;
+}
+
+std::size_t ListingCache::size() const noexcept {
+    return _lru.size();
+}
+
+std::size_t ListingCache::getMemoryUsage() const noexcept {
+    return _memory;
+}
+
+std::size_t ListingCache::getHits() const noexcept {
+    return _hits;
+}
+
+std::size_t ListingCache::getMisses() const noexcept {
+    return _misses;
+}
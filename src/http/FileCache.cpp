@@ -0,0 +1,186 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FileCache.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:24:10 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:36:08 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    FileCache.cpp
+ * @brief   Implements CachedFile and the FileCache LRU.
+ *
+ * @ingroup http
+ */
+
+#include "http/FileCache.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utility>
+
+namespace {
+
+#if defined(__APPLE__)
+const struct timespec& modificationTime(const struct stat& st) {
+    return st.st_mtimespec;
+}
+#else
+const struct timespec& modificationTime(const struct stat& st) {
+    return st.st_mtim;
+}
+#endif
+
+} // namespace
+
+// --- CachedFile ---
+
+CachedFile::CachedFile(int fd, const struct stat& st) noexcept
+    : _fd(fd), _dev(st.st_dev), _ino(st.st_ino), _mode(st.st_mode),
+      _size(static_cast<std::size_t>(st.st_size)), _mtime(modificationTime(st)) {
+    const int length = std::snprintf(_etag, sizeof(_etag), "\"%llx-%zx\"",
+                                     static_cast<unsigned long long>(_mtime.tv_sec), _size);
+    _etag_length     = static_cast<std::uint8_t>(length > 0 ? length : 0);
+}
+
+CachedFile::~CachedFile() {
+    if (_fd >= 0)
+        close(_fd);
+}
+
+int CachedFile::getFd() const noexcept {
+    return _fd;
+}
+
+std::size_t CachedFile::getSize() const noexcept {
+    return _size;
+}
+
+std::time_t CachedFile::getModifiedTime() const noexcept {
+    return _mtime.tv_sec;
+}
+
+bool CachedFile::isDirectory() const noexcept {
+    return S_ISDIR(_mode);
+}
+
+bool CachedFile::isRegular() const noexcept {
+    return S_ISREG(_mode);
+}
+
+std::string_view CachedFile::getETag() const noexcept {
+    return std::string_view(_etag, _etag_length);
+}
+
+bool CachedFile::isUnchanged(const struct stat& st) const noexcept {
+    const struct timespec& mtime = modificationTime(st);
+    return st.st_dev == _dev && st.st_ino == _ino && st.st_mode == _mode &&
+           static_cast<std::size_t>(st.st_size) == _size && mtime.tv_sec == _mtime.tv_sec &&
+           mtime.tv_nsec == _mtime.tv_nsec;
+}
+
+// --- FileCache ---
+
+constexpr std::size_t               FileCache::DEFAULT_CAPACITY;
+constexpr std::chrono::milliseconds FileCache::DEFAULT_TTL;
+
+FileCache::FileCache(std::size_t capacity, std::chrono::milliseconds ttl)
+    : _capacity(capacity), _ttl(ttl), _hits(0), _misses(0) {
+}
+
+FileCache::Lookup FileCache::load(const std::string& path) {
+    Lookup result;
+    result.error = 0;
+
+    // O_NONBLOCK keeps a FIFO planted under the root from stalling the event loop
+    const int fd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        result.error = errno;
+        return result;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        result.error = errno;
+        close(fd);
+        return result;
+    }
+    if (S_ISDIR(st.st_mode)) {
+        close(fd); // Directories are listed or redirected, never sent
+        result.file = std::make_shared<const CachedFile>(-1, st);
+    } else {
+        result.file = std::make_shared<const CachedFile>(fd, st);
+    }
+    return result;
+}
+
+// Confirms a stale entry with one stat(); false when the file must be reopened
+bool FileCache::revalidate(Entry& entry) const {
+    struct stat st;
+    const bool  found = stat(entry.path.c_str(), &st) == 0;
+    if (entry.result.file)
+        return found && entry.result.file->isUnchanged(st);
+    return !found && errno == entry.result.error;
+}
+
+FileCache::Lookup FileCache::open(std::string_view path) {
+    if (_capacity == 0) {
+        ++_misses;
+        return load(std::string(path));
+    }
+
+    const Clock::time_point now = Clock::now();
+    std::unordered_map<std::string_view, EntryList::iterator>::iterator it = _index.find(path);
+    if (it != _index.end()) {
+        Entry& entry = *it->second;
+        if (now - entry.validated < _ttl || revalidate(entry)) {
+            entry.validated = now;
+            _lru.splice(_lru.begin(), _lru, it->second); // Mark as most recently used
+            ++_hits;
+            return entry.result;
+        }
+        entry.result    = load(entry.path);
+        entry.validated = now;
+        _lru.splice(_lru.begin(), _lru, it->second);
+        ++_misses;
+        return entry.result;
+    }
+
+    ++_misses;
+    if (_lru.size() >= _capacity) {
+        _index.erase(_lru.back().path);
+        _lru.pop_back();
+    }
+    Entry entry;
+    entry.path      = std::string(path);
+    entry.result    = load(entry.path);
+    entry.validated = now;
+    _lru.push_front(std::move(entry));
+    _index[_lru.front().path] = _lru.begin(); // The view is stable: list nodes never move
+    return _lru.front().result;
+}
+
+void FileCache::clear() noexcept {
+    _index.clear();
+    _lru.clear();
+}
+
+std::size_t FileCache::size() const noexcept {
+    return _lru.size();
+}
+
+std::size_t FileCache::getCapacity() const noexcept {
+    return _capacity;
+}
+
+std::size_t FileCache::getHits() const noexcept {
+    return _hits;
+}
+
+std::size_t FileCache::getMisses() const noexcept {
+    return _misses;
+}
@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HeaderFields.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:45:44 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:45:44 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HeaderFields.cpp
+ * @brief   Implements the Content-Type table of pre-encoded fields.
+ *
+ * @ingroup http
+ */
+
+#include "http/HeaderFields.hpp"
+#include "utils/StringUtils.hpp"
+
+namespace {
+
+struct MimeField {
+    std::string_view extension;
+    std::string_view field;
+};
+
+constexpr std::string_view FIELD_OCTET_STREAM = "Content-Type: application/octet-stream\r\n";
+
+constexpr MimeField MIME_FIELDS[] = {
+    {"html", "Content-Type: text/html\r\n"},
+    {"htm", "Content-Type: text/html\r\n"},
+    {"css", "Content-Type: text/css\r\n"},
+    {"js", "Content-Type: text/javascript\r\n"},
+    {"mjs", "Content-Type: text/javascript\r\n"},
+    {"json", "Content-Type: application/json\r\n"},
+    {"txt", "Content-Type: text/plain\r\n"},
+    {"xml", "Content-Type: application/xml\r\n"},
+    {"csv", "Content-Type: text/csv\r\n"},
+    {"md", "Content-Type: text/markdown\r\n"},
+    {"png", "Content-Type: image/png\r\n"},
+    {"jpg", "Content-Type: image/jpeg\r\n"},
+    {"jpeg", "Content-Type: image/jpeg\r\n"},
+    {"gif", "Content-Type: image/gif\r\n"},
+    {"svg", "Content-Type: image/svg+xml\r\n"},
+    {"ico", "Content-Type: image/x-icon\r\n"},
+    {"webp", "Content-Type: image/webp\r\n"},
+    {"avif", "Content-Type: image/avif\r\n"},
+    {"woff", "Content-Type: font/woff\r\n"},
+    {"woff2", "Content-Type: font/woff2\r\n"},
+    {"ttf", "Content-Type: font/ttf\r\n"},
+    {"otf", "Content-Type: font/otf\r\n"},
+    {"pdf", "Content-Type: application/pdf\r\n"},
+    {"wasm", "Content-Type: application/wasm\r\n"},
+    {"mp3", "Content-Type: audio/mpeg\r\n"},
+    {"wav", "Content-Type: audio/wav\r\n"},
+    {"mp4", "Content-Type: video/mp4\r\n"},
+    {"webm", "Content-Type: video/webm\r\n"},
+    {"zip", "Content-Type: application/zip\r\n"},
+    {"gz", "Content-Type: application/gzip\r\n"},
+    {"tar", "Content-Type: application/x-tar\r\n"},
+};
+
+} // namespace
+
+std::string_view contentTypeField(std::string_view path) noexcept {
+    const std::size_t dot   = path.rfind('.');
+    const std::size_t slash = path.rfind('/');
+    if (dot == std::string_view::npos || (slash != std::string_view::npos && dot < slash))
+        return FIELD_OCTET_STREAM;
+    const std::string_view extension = path.substr(dot + 1);
+    for (const MimeField& entry : MIME_FIELDS) {
+        if (iequals(entry.extension, extension))
+            return entry.field;
+    }
+    return FIELD_OCTET_STREAM;
+}
+
+std::string_view fieldValue(std::string_view field) noexcept {
+    const std::size_t colon = field.find(':');
+    if (colon == std::string_view::npos)
+        return std::string_view();
+    std::string_view value = field.substr(colon + 1);
+    if (value.size() >= 2 && value.substr(value.size() - 2) == "\r\n")
+        value.remove_suffix(2);
+    return trim(value);
+}
@@ -0,0 +1,75 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HttpMethod.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:08:37 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:08:37 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HttpMethod.cpp
+ * @brief   Implements the HttpMethod helpers.
+ *
+ * @ingroup http
+ */
+
+#include "http/HttpMethod.hpp"
+
+// Dispatch on length first so each request costs at most one or two compares
+HttpMethod parseHttpMethod(std::string_view token) noexcept {
+    switch (token.size()) {
+    case 3:
+        if (token == "GET")
+            return HttpMethod::GET;
+        if (token == "PUT")
+            return HttpMethod::PUT;
+        break;
+    case 4:
+        if (token == "POST")
+            return HttpMethod::POST;
+        if (token == "HEAD")
+            return HttpMethod::HEAD;
+        break;
+    case 5:
+        if (token == "PATCH")
+            return HttpMethod::PATCH;
+        break;
+    case 6:
+        if (token == "DELETE")
+            return HttpMethod::DELETE;
+        break;
+    case 7:
+        if (token == "OPTIONS")
+            return HttpMethod::OPTIONS;
+        break;
+    default:
+        break;
+    }
+    return HttpMethod::UNKNOWN;
+}
+
+std::string_view httpMethodName(HttpMethod method) noexcept {
+    switch (method) {
+    case HttpMethod::GET:
+        return "GET";
+    case HttpMethod::HEAD:
+        return "HEAD";
+    case HttpMethod::POST:
+        return "POST";
+    case HttpMethod::PUT:
+        return "PUT";
+    case HttpMethod::DELETE:
+        return "DELETE";
+    case HttpMethod::OPTIONS:
+        return "OPTIONS";
+    case HttpMethod::PATCH:
+        return "PATCH";
+    case HttpMethod::UNKNOWN:
+        break;
+    }
+    return "UNKNOWN";
+}
@@ -0,0 +1,126 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HttpRequest.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/05/02 13:45:05 by nlouis            #+#    #+#             */
+/*   Updated: 2025/05/13 18:20:05 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HttpRequest.cpp
+ * @brief   Implements the HttpRequest accessors.
+ *
+ * @ingroup http
+ */
+
+#include "http/HttpRequest.hpp"
+#include "utils/StringUtils.hpp"
+
+HttpRequest::HttpRequest() {
+    reset();
+}
+
+void HttpRequest::reset() noexcept {
+    _base           = nullptr;
+    _method         = HttpMethod::UNKNOWN;
+    _method_name    = HttpSlice();
+    _target         = HttpSlice();
+    _path           = HttpSlice();
+    _query          = HttpSlice();
+    _version_major  = 0;
+    _version_minor  = 0;
+    _host           = HttpSlice();
+    _has_length     = false;
+    _content_length = 0;
+    _chunked        = false;
+    _keep_alive     = false;
+    _header_count   = 0;
+}
+
+void HttpRequest::bind(const char* base) noexcept {
+    _base = base;
+}
+
+std::string_view HttpRequest::view(HttpSlice slice) const noexcept {
+    if (!_base || slice.length == 0)
+        return std::string_view();
+    return std::string_view(_base + slice.offset, slice.length);
+}
+
+// --- Request line ---
+
+HttpMethod HttpRequest::getMethod() const noexcept {
+    return _method;
+}
+
+std::string_view HttpRequest::getMethodName() const noexcept {
+    return view(_method_name);
+}
+
+std::string_view HttpRequest::getTarget() const noexcept {
+    return view(_target);
+}
+
+std::string_view HttpRequest::getPath() const noexcept {
+    return view(_path);
+}
+
+std::string_view HttpRequest::getQuery() const noexcept {
+    return view(_query);
+}
+
+int HttpRequest::getVersionMajor() const noexcept {
+    return _version_major;
+}
+
+int HttpRequest::getVersionMinor() const noexcept {
+    return _version_minor;
+}
+
+// --- Materialized header data ---
+
+std::string_view HttpRequest::getHost() const noexcept {
+    return view(_host);
+}
+
+bool HttpRequest::hasContentLength() const noexcept {
+    return _has_length;
+}
+
+std::size_t HttpRequest::getContentLength() const noexcept {
+    return _content_length;
+}
+
+bool HttpRequest::isChunked() const noexcept {
+    return _chunked;
+}
+
+bool HttpRequest::isKeepAlive() const noexcept {
+    return _keep_alive;
+}
+
+// --- Raw header access ---
+
+std::size_t HttpRequest::getHeaderCount() const noexcept {
+    return _header_count;
+}
+
+std::string_view HttpRequest::getHeaderName(std::size_t index) const noexcept {
+    return index < _header_count ? view(_headers[index].name) : std::string_view();
+}
+
+std::string_view HttpRequest::getHeaderValue(std::size_t index) const noexcept {
+    return index < _header_count ? view(_headers[index].value) : std::string_view();
+}
+
+std::string_view HttpRequest::getHeader(std::string_view name) const noexcept {
+    for (std::size_t i = 0; i < _header_count; ++i) {
+        if (_headers[i].name.length == name.size() && iequals(view(_headers[i].name), name))
+            return view(_headers[i].value);
+    }
+    return std::string_view();
+}
@@ -0,0 +1,341 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HttpRequestParser.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/05/02 13:45:05 by nlouis            #+#    #+#             */
+/*   Updated: 2025/05/13 18:20:05 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HttpRequestParser.cpp
+ * @brief   Implements the incremental HTTP/1.x request head parser.
+ *
+ * @details Follows the RFC 9112 grammar for the request line and header fields.
+ * Bare LF line endings are tolerated, obsolete line folding is rejected. The inner
+ * loops over method, target, header names and header values go through the
+ * HttpScanner kernels, which examine up to 32 bytes per step.
+ *
+ * @ingroup http
+ */
+
+#include "http/HttpRequestParser.hpp"
+#include "http/HttpScanner.hpp"
+#include "utils/StringUtils.hpp"
+#include <cstring>
+
+namespace {
+
+HttpSlice makeSlice(std::size_t begin, std::size_t end) noexcept {
+    HttpSlice slice;
+    slice.offset = static_cast<std::uint32_t>(begin);
+    slice.length = static_cast<std::uint32_t>(end - begin);
+    return slice;
+}
+
+std::string_view sliceOf(std::string_view data, HttpSlice slice) noexcept {
+    return data.substr(slice.offset, slice.length);
+}
+
+} // namespace
+
+HttpRequestParser::HttpRequestParser(std::size_t max_head_size) : _max_head_size(max_head_size) {
+    reset();
+}
+
+void HttpRequestParser::reset() noexcept {
+    _state        = State::LEADING_EOL;
+    _pos          = 0;
+    _mark         = 0;
+    _name         = HttpSlice();
+    _error_status = 0;
+}
+
+std::size_t HttpRequestParser::consumed() const noexcept {
+    return _state == State::DONE ? _pos : 0;
+}
+
+int HttpRequestParser::getErrorStatus() const noexcept {
+    return _error_status;
+}
+
+HttpRequestParser::Result HttpRequestParser::fail(int status) noexcept {
+    _error_status = status;
+    return Result::ERROR;
+}
+
+// Remember where to resume; a head that cannot end within the limit is refused
+HttpRequestParser::Result HttpRequestParser::suspend(std::size_t pos,
+                                                     std::size_t available) noexcept {
+    _pos = pos;
+    if (available >= _max_head_size)
+        return fail(431);
+    return Result::INCOMPLETE;
+}
+
+// 1: line ending consumed, 0: need more bytes, -1: not a line ending
+int HttpRequestParser::consumeEol(std::string_view data, std::size_t& pos) const noexcept {
+    if (data[pos] == '\n') {
+        pos += 1;
+        return 1;
+    }
+    if (data[pos] != '\r')
+        return -1;
+    if (pos + 1 >= data.size())
+        return 0;
+    if (data[pos + 1] != '\n')
+        return -1;
+    pos += 2;
+    return 1;
+}
+
+void HttpRequestParser::setTarget(HttpRequest& request, std::string_view data,
+                                  std::size_t end) const noexcept {
+    request._target            = makeSlice(_mark, end);
+    const std::size_t question = data.substr(_mark, end - _mark).find('?');
+    if (question == std::string_view::npos) {
+        request._path  = request._target;
+        request._query = HttpSlice();
+    } else {
+        request._path  = makeSlice(_mark, _mark + question);
+        request._query = makeSlice(_mark + question + 1, end);
+    }
+}
+
+bool HttpRequestParser::addHeader(HttpRequest& request, std::string_view data,
+                                  std::size_t end) noexcept {
+    if (request._header_count == HttpRequest::MAX_HEADERS)
+        return false;
+    std::size_t value_end = end;
+    while (value_end > _mark && (data[value_end - 1] == ' ' || data[value_end - 1] == '\t'))
+        --value_end;
+    HttpHeaderSlice& header = request._headers[request._header_count++];
+    header.name             = _name;
+    header.value            = makeSlice(_mark, value_end);
+    return true;
+}
+
+HttpRequestParser::Result HttpRequestParser::parse(std::string_view data, HttpRequest& request) {
+    if (_state == State::DONE)
+        return Result::COMPLETE;
+    if (_error_status != 0)
+        return Result::ERROR;
+
+    const char*       p     = data.data();
+    const std::size_t limit = data.size() < _max_head_size ? data.size() : _max_head_size;
+    std::size_t       i     = _pos;
+
+    while (i < limit) {
+        switch (_state) {
+        case State::LEADING_EOL:
+            // RFC 9112 2.2: ignore empty lines received before the request line
+            if (p[i] == '\r' || p[i] == '\n') {
+                ++i;
+                break;
+            }
+            _mark  = i;
+            _state = State::METHOD;
+            break;
+
+        case State::METHOD:
+            i = scanToken(p, i, limit);
+            if (i == limit)
+                return suspend(i, data.size());
+            if (p[i] != ' ' || i == _mark)
+                return fail(400);
+            request._method_name = makeSlice(_mark, i);
+            request._method      = parseHttpMethod(data.substr(_mark, i - _mark));
+            _mark                = ++i;
+            _state               = State::TARGET;
+            break;
+
+        case State::TARGET:
+            i = scanTarget(p, i, limit);
+            if (i == limit)
+                return suspend(i, data.size());
+            if (p[i] != ' ' || i == _mark)
+                return fail(400);
+            setTarget(request, data, i);
+            _mark  = ++i;
+            _state = State::VERSION;
+            break;
+
+        case State::VERSION: {
+            // "HTTP/" DIGIT "." DIGIT, checked in one go once all 8 bytes are here
+            if (limit - i < 8)
+                return suspend(i, data.size());
+            const char* v = p + i;
+            if (std::memcmp(v, "HTTP/", 5) != 0 || v[5] < '0' || v[5] > '9' || v[6] != '.' ||
+                v[7] < '0' || v[7] > '9')
+                return fail(400);
+            request._version_major = v[5] - '0';
+            request._version_minor = v[7] - '0';
+            if (request._version_major != 1)
+                return fail(505);
+            i += 8;
+            _state = State::REQUEST_LINE_EOL;
+            break;
+        }
+
+        case State::REQUEST_LINE_EOL:
+        case State::HEADER_LINE_EOL:
+        case State::HEADERS_END_EOL: {
+            const int eol = consumeEol(data.substr(0, limit), i);
+            if (eol == 0)
+                return suspend(i, data.size());
+            if (eol < 0)
+                return fail(400);
+            if (_state == State::HEADERS_END_EOL) {
+                _pos   = i;
+                _state = State::DONE;
+                if (!finish(request, data))
+                    return Result::ERROR;
+                request.bind(p);
+                return Result::COMPLETE;
+            }
+            _state = State::HEADER_START;
+            break;
+        }
+
+        case State::HEADER_START:
+            if (p[i] == '\r' || p[i] == '\n') {
+                _state = State::HEADERS_END_EOL;
+                break;
+            }
+            if (p[i] == ' ' || p[i] == '\t')
+                return fail(400); // Obsolete line folding (RFC 9112 5.2)
+            _mark  = i;
+            _state = State::HEADER_NAME;
+            break;
+
+        case State::HEADER_NAME:
+            i = scanToken(p, i, limit);
+            if (i == limit)
+                return suspend(i, data.size());
+            if (p[i] != ':' || i == _mark)
+                return fail(400); // Includes whitespace before the colon
+            _name  = makeSlice(_mark, i);
+            _state = State::HEADER_VALUE_START;
+            ++i;
+            break;
+
+        case State::HEADER_VALUE_START:
+            while (i < limit && (p[i] == ' ' || p[i] == '\t'))
+                ++i;
+            if (i == limit)
+                return suspend(i, data.size());
+            _mark  = i;
+            _state = State::HEADER_VALUE;
+            break;
+
+        case State::HEADER_VALUE:
+            i = scanValue(p, i, limit);
+            if (i == limit)
+                return suspend(i, data.size());
+            if (p[i] != '\r' && p[i] != '\n')
+                return fail(400);
+            if (!addHeader(request, data, i))
+                return fail(431);
+            _state = State::HEADER_LINE_EOL;
+            break;
+
+        case State::DONE:
+            return Result::COMPLETE;
+        }
+    }
+    return suspend(i, data.size());
+}
+
+// Materialize the few header fields framing and routing depend on
+bool HttpRequestParser::finish(HttpRequest& request, std::string_view data) noexcept {
+    bool has_host = false;
+    bool close    = false;
+    bool persist  = false;
+
+    for (std::size_t h = 0; h < request._header_count; ++h) {
+        const HttpHeaderSlice& header = request._headers[h];
+        const std::string_view name   = sliceOf(data, header.name);
+        const std::string_view value  = sliceOf(data, header.value);
+
+        switch (name.size()) {
+        case 4:
+            if (iequals(name, "Host")) {
+                if (has_host) {
+                    fail(400);
+                    return false;
+                }
+                has_host = true;
+                // Strip the port, keeping bracketed IPv6 literals intact
+                std::size_t host_end = value.size();
+                if (!value.empty() && value[0] == '[') {
+                    const std::size_t bracket = value.find(']');
+                    host_end = bracket == std::string_view::npos ? value.size() : bracket + 1;
+                } else if (value.rfind(':') != std::string_view::npos) {
+                    host_end = value.rfind(':');
+                }
+                request._host = makeSlice(header.value.offset, header.value.offset + host_end);
+            }
+            break;
+        case 10:
+            if (iequals(name, "Connection")) {
+                std::string_view list = value;
+                while (!list.empty()) {
+                    const std::size_t      comma = list.find(',');
+                    const std::string_view token = trim(list.substr(0, comma));
+                    if (iequals(token, "close"))
+                        close = true;
+                    else if (iequals(token, "keep-alive"))
+                        persist = true;
+                    if (comma == std::string_view::npos)
+                        break;
+                    list.remove_prefix(comma + 1);
+                }
+            }
+            break;
+        case 14:
+            if (iequals(name, "Content-Length")) {
+                std::size_t length = 0;
+                if (!parseSize(value, length) ||
+                    (request._has_length && length != request._content_length)) {
+                    fail(400);
+                    return false;
+                }
+                request._has_length     = true;
+                request._content_length = length;
+            }
+            break;
+        case 17:
+            if (iequals(name, "Transfer-Encoding")) {
+                // HTTP/1.0 has no transfer codings: its framing is faulty (RFC 9112 6.1)
+                if (request._version_minor == 0) {
+                    fail(400);
+                    return false;
+                }
+                // No other coding is decoded, so nothing but a lone chunked is accepted
+                if (request._chunked || !iequals(trim(value), "chunked")) {
+                    fail(501);
+                    return false;
+                }
+                request._chunked = true;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Both framings at once is a request smuggling vector (RFC 9112 6.3)
+    if (request._chunked && request._has_length) {
+        fail(400);
+        return false;
+    }
+    if (request._version_minor >= 1 && !has_host) {
+        fail(400);
+        return false;
+    }
+    request._keep_alive = request._version_minor >= 1 ? !close : (persist && !close);
+    return true;
+}
@@ -0,0 +1,353 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HttpResponse.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/04/26 16:00:00 by nlouis            #+#    #+#             */
+/*   Updated: 2025/05/18 19:37:22 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HttpResponse.cpp
+ * @brief   Implements the HttpResponse class.
+ *
+ * @ingroup http
+ */
+
+#include "http/HttpResponse.hpp"
+#include "http/HeaderFields.hpp"
+#include "utils/StringUtils.hpp"
+#include <algorithm>
+
+namespace {
+
+struct StatusLine {
+    int              status;
+    std::string_view line; ///< "HTTP/1.1 <status> <reason>" and CRLF, sent as is.
+};
+
+constexpr std::size_t STATUS_PREFIX = sizeof("HTTP/1.1 200 ") - 1; ///< Start of the reason.
+
+// Pre-encoded status lines with the RFC 9110 reason phrases of the statuses this server emits
+constexpr StatusLine STATUS_LINES[] = {
+    {100, "HTTP/1.1 100 Continue\r\n"},
+    {200, "HTTP/1.1 200 OK\r\n"},
+    {201, "HTTP/1.1 201 Created\r\n"},
+    {204, "HTTP/1.1 204 No Content\r\n"},
+    {206, "HTTP/1.1 206 Partial Content\r\n"},
+    {301, "HTTP/1.1 301 Moved Permanently\r\n"},
+    {302, "HTTP/1.1 302 Found\r\n"},
+    {303, "HTTP/1.1 303 See Other\r\n"},
+    {304, "HTTP/1.1 304 Not Modified\r\n"},
+    {307, "HTTP/1.1 307 Temporary Redirect\r\n"},
+    {308, "HTTP/1.1 308 Permanent Redirect\r\n"},
+    {400, "HTTP/1.1 400 Bad Request\r\n"},
+    {403, "HTTP/1.1 403 Forbidden\r\n"},
+    {404, "HTTP/1.1 404 Not Found\r\n"},
+    {405, "HTTP/1.1 405 Method Not Allowed\r\n"},
+    {408, "HTTP/1.1 408 Request Timeout\r\n"},
+    {409, "HTTP/1.1 409 Conflict\r\n"},
+    {411, "HTTP/1.1 411 Length Required\r\n"},
+    {412, "HTTP/1.1 412 Precondition Failed\r\n"},
+    {413, "HTTP/1.1 413 Content Too Large\r\n"},
+    {414, "HTTP/1.1 414 URI Too Long\r\n"},
+    {416, "HTTP/1.1 416 Range Not Satisfiable\r\n"},
+    {431, "HTTP/1.1 431 Request Header Fields Too Large\r\n"},
+    {500, "HTTP/1.1 500 Internal Server Error\r\n"},
+    {501, "HTTP/1.1 501 Not Implemented\r\n"},
+    {502, "HTTP/1.1 502 Bad Gateway\r\n"},
+    {503, "HTTP/1.1 503 Service Unavailable\r\n"},
+    {504, "HTTP/1.1 504 Gateway Timeout\r\n"},
+    {505, "HTTP/1.1 505 HTTP Version Not Supported\r\n"},
+    {507, "HTTP/1.1 507 Insufficient Storage\r\n"},
+};
+
+std::string_view findStatusLine(int status) noexcept {
+    for (const StatusLine& entry : STATUS_LINES) {
+        if (entry.status == status)
+            return entry.line;
+    }
+    return std::string_view();
+}
+
+// Cached heads hold "Name: value" lines after the status line, without the blank line
+std::string_view findCachedField(std::string_view head, std::string_view name) noexcept {
+    std::size_t line = head.find("\r\n");
+    while (line != std::string_view::npos) {
+        line += 2;
+        const std::size_t end = head.find("\r\n", line);
+        if (end == std::string_view::npos)
+            break;
+        const std::string_view field = head.substr(line, end - line + 2);
+        if (field.size() > name.size() && field[name.size()] == ':' &&
+            iequals(field.substr(0, name.size()), name))
+            return fieldValue(field);
+        line = end;
+    }
+    return std::string_view();
+}
+
+HttpResponse::Segment fileSegment(const std::shared_ptr<const CachedFile>& file, off_t offset,
+                                  std::size_t length) {
+    HttpResponse::Segment segment = {};
+    segment.file                  = file;
+    segment.offset                = offset;
+    segment.length                = length;
+    return segment;
+}
+
+HttpResponse::Segment borrowedSegment(std::string_view bytes, std::shared_ptr<const void> owner) {
+    HttpResponse::Segment segment = {};
+    segment.bytes                 = bytes;
+    segment.owner                 = std::move(owner);
+    return segment;
+}
+
+HttpResponse::Segment textSegment(std::string text) {
+    HttpResponse::Segment segment = {};
+    segment.text                  = std::move(text);
+    return segment;
+}
+
+} // namespace
+
+HttpResponse::HttpResponse() : HttpResponse(200) {
+}
+
+HttpResponse::HttpResponse(int status, std::pmr::memory_resource* memory)
+    : _status(status), _fragments(memory), _headers(memory), _file_offset(0), _file_length(0),
+      _streamed(false) {
+}
+
+// --- Status and headers ---
+
+void HttpResponse::setStatus(int status) noexcept {
+    _status = status;
+}
+
+int HttpResponse::getStatus() const noexcept {
+    return _status;
+}
+
+void HttpResponse::setHeader(std::string_view name, std::string_view value) {
+    for (Header& header : _headers) {
+        if (iequals(header.first, name)) {
+            header.second.assign(value.data(), value.size());
+            return;
+        }
+    }
+    _headers.emplace_back(name, value); // uses-allocator construction: both in the arena
+}
+
+const std::pmr::string* HttpResponse::getHeader(std::string_view name) const noexcept {
+    for (const Header& header : _headers) {
+        if (iequals(header.first, name))
+            return &header.second;
+    }
+    return NULL;
+}
+
+std::string_view HttpResponse::getField(std::string_view name) const noexcept {
+    if (const std::pmr::string* value = getHeader(name))
+        return *value;
+    for (const Fragment& fragment : _fragments) {
+        if (fragment.bytes.size() > name.size() && fragment.bytes[name.size()] == ':' &&
+            iequals(fragment.bytes.substr(0, name.size()), name))
+            return fieldValue(fragment.bytes);
+    }
+    if (_cached)
+        return findCachedField(_cached->getHead(), name);
+    return std::string_view();
+}
+
+void HttpResponse::removeHeader(std::string_view name) noexcept {
+    for (std::size_t i = 0; i < _headers.size(); ++i) {
+        if (iequals(_headers[i].first, name)) {
+            _headers.erase(_headers.begin() + static_cast<std::ptrdiff_t>(i));
+            return;
+        }
+    }
+}
+
+// --- Body ---
+
+void HttpResponse::setBody(std::string body, std::string_view content_type) {
+    _body = std::move(body);
+    _file.reset();
+    _pieces.clear();
+    _cached.reset();
+    _file_offset = 0;
+    _file_length = 0;
+    if (!content_type.empty())
+        setHeader("Content-Type", content_type);
+}
+
+void HttpResponse::setFile(std::shared_ptr<const CachedFile> file, off_t offset,
+                           std::size_t length) {
+    _body.clear();
+    _pieces.clear();
+    _cached.reset();
+    _file        = std::move(file);
+    _file_offset = offset;
+    _file_length = length;
+}
+
+void HttpResponse::setFileParts(std::shared_ptr<const CachedFile> file,
+                                std::vector<FilePart> parts, std::string tail) {
+    setFile(std::move(file), 0, 0);
+    _pieces.reserve(parts.size() * 2 + 1);
+    for (FilePart& part : parts) {
+        _pieces.push_back(textSegment(std::move(part.head)));
+        _pieces.push_back(fileSegment(_file, part.offset, part.length));
+    }
+    _pieces.push_back(textSegment(std::move(tail)));
+}
+
+void HttpResponse::setSharedBody(std::string head, std::string_view shared,
+                                 std::shared_ptr<const void> owner, std::string tail) {
+    setBody(std::string());
+    _pieces.reserve(3);
+    _pieces.push_back(textSegment(std::move(head)));
+    _pieces.push_back(borrowedSegment(shared, std::move(owner)));
+    _pieces.push_back(textSegment(std::move(tail)));
+}
+
+bool HttpResponse::hasFile() const noexcept {
+    return _file != NULL;
+}
+
+const std::string& HttpResponse::getBody() const noexcept {
+    return _body;
+}
+
+std::string&& HttpResponse::takeBody() noexcept {
+    return std::move(_body);
+}
+
+const std::shared_ptr<const CachedFile>& HttpResponse::getFile() const noexcept {
+    return _file;
+}
+
+off_t HttpResponse::getFileOffset() const noexcept {
+    return _file_offset;
+}
+
+void HttpResponse::setCached(std::shared_ptr<const CachedResponse> cached) {
+    _status = cached->getStatus();
+    _fragments.clear(); // Already part of the cached head
+    _headers.clear();
+    _body.clear();
+    _file.reset();
+    _pieces.clear();
+    _file_offset = 0;
+    _file_length = 0;
+    _cached      = std::move(cached);
+}
+
+const std::shared_ptr<const CachedResponse>& HttpResponse::getCached() const noexcept {
+    return _cached;
+}
+
+void HttpResponse::setStreamed() noexcept {
+    _streamed = true;
+}
+
+std::size_t HttpResponse::getContentLength() const noexcept {
+    if (_cached)
+        return _cached->getBody().size();
+    if (!_pieces.empty()) {
+        std::size_t length = 0;
+        for (const Segment& piece : _pieces)
+            length += piece.file ? piece.length : piece.bytes.size() + piece.text.size();
+        return length;
+    }
+    return _file ? _file_length : _body.size();
+}
+
+std::string HttpResponse::serializeHead() const {
+    std::string head;
+    if (_cached) {
+        head = _cached->getHead();
+    } else {
+        const std::string_view line = findStatusLine(_status);
+        head.reserve(128 + _headers.size() * 48);
+        if (line.empty())
+            head += "HTTP/1.1 " + std::to_string(_status) + " Unknown\r\n";
+        else
+            head += line;
+    }
+    for (const Fragment& fragment : _fragments)
+        head += fragment.bytes;
+    head += serializeFields();
+    return head;
+}
+
+std::string HttpResponse::serializeFields() const {
+    std::string fields;
+    fields.reserve(32 + _headers.size() * 48);
+    for (const Header& header : _headers) {
+        fields += header.first;
+        fields += ": ";
+        fields += header.second;
+        fields += "\r\n";
+    }
+    if (!_cached && !_streamed && _status >= 200 && _status != 204 && _status != 304) {
+        fields += "Content-Length: ";
+        fields += std::to_string(getContentLength());
+        fields += "\r\n";
+    }
+    fields += "\r\n";
+    return fields;
+}
+
+std::string_view HttpResponse::reasonPhrase(int status) noexcept {
+    const std::string_view line = findStatusLine(status);
+    if (line.empty())
+        return "Unknown";
+    return line.substr(STATUS_PREFIX, line.size() - STATUS_PREFIX - 2);
+}
+
+// --- Vectored output ---
+
+void HttpResponse::addField(std::string_view field, std::shared_ptr<const void> owner) {
+    _fragments.push_back(Fragment{field, std::move(owner)});
+}
+
+HttpResponse::Segments HttpResponse::takeSegments(bool head_only) {
+    Segments segments(_headers.get_allocator());
+    segments.reserve(_fragments.size() + 3 + std::max<std::size_t>(_pieces.size(), 1));
+
+    if (_cached) {
+        segments.push_back(borrowedSegment(_cached->getHead(), _cached));
+    } else {
+        const std::string_view line = findStatusLine(_status);
+        if (line.empty())
+            segments.push_back(textSegment("HTTP/1.1 " + std::to_string(_status) + " Unknown\r\n"));
+        else
+            segments.push_back(borrowedSegment(line, NULL));
+    }
+    for (Fragment& fragment : _fragments)
+        segments.push_back(borrowedSegment(fragment.bytes, std::move(fragment.owner)));
+    segments.push_back(textSegment(serializeFields()));
+
+    if (head_only)
+        return segments;
+    if (_cached) {
+        if (!_cached->getBody().empty())
+            segments.push_back(borrowedSegment(_cached->getBody(), _cached));
+    } else if (!_pieces.empty()) {
+        for (Segment& piece : _pieces) {
+            if (piece.file ? piece.length > 0 : !piece.bytes.empty() || !piece.text.empty())
+                segments.push_back(std::move(piece));
+        }
+    } else if (_file) {
+        if (_file_length > 0)
+            segments.push_back(fileSegment(_file, _file_offset, _file_length));
+    } else if (!_body.empty()) {
+        segments.push_back(textSegment(std::move(_body)));
+    }
+    return segments;
+}
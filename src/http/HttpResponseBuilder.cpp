@@ -0,0 +1,692 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HttpResponseBuilder.cpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/04/26 16:00:00 by nlouis            #+#    #+#             */
+/*   Updated: 2025/06/03 17:12:09 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HttpResponseBuilder.cpp
+ * @brief   Implements request routing and static file responses.
+ *
+ * @details Request paths are percent-decoded and stripped of dot segments before
+ * they are joined to a location root, so a request can never escape the root.
+ *
+ * @ingroup http
+ */
+
+#include "http/HttpResponseBuilder.hpp"
+#include "http/HeaderFields.hpp"
+#include "utils/StringUtils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <unistd.h>
+
+namespace {
+
+constexpr HttpMethod KNOWN_METHODS[] = {HttpMethod::GET,    HttpMethod::HEAD,
+                                        HttpMethod::POST,   HttpMethod::PUT,
+                                        HttpMethod::DELETE, HttpMethod::OPTIONS,
+                                        HttpMethod::PATCH};
+
+// Locations without an explicit method list accept everything they can serve
+bool allowsMethod(const Location& location, HttpMethod method) noexcept {
+    if (location.getMethodMask() == 0)
+        return true;
+    if (method == HttpMethod::HEAD)
+        return location.isMethodAllowed(HttpMethod::GET) || location.isMethodAllowed(method);
+    return location.isMethodAllowed(method);
+}
+
+std::string defaultErrorBody(int status) {
+    std::string title = std::to_string(status);
+    title += ' ';
+    title += HttpResponse::reasonPhrase(status);
+
+    std::string body = "<html>\r\n<head><title>";
+    body += title;
+    body += "</title></head>\r\n<body>\r\n<h1>";
+    body += title;
+    body += "</h1>\r\n</body>\r\n</html>\r\n";
+    return body;
+}
+
+std::pmr::string joinPath(const std::pmr::string& directory, std::string_view name) {
+    std::pmr::string path(directory, directory.get_allocator());
+    if (path.empty() || path.back() != '/')
+        path += '/';
+    path += name;
+    return path;
+}
+
+// The file's own ETag, with the coding appended inside the quotes for compressed variants
+void setValidators(HttpResponse& response, const CachedFile& file,
+                   ContentCoding coding = ContentCoding::IDENTITY) {
+    if (coding == ContentCoding::IDENTITY) {
+        response.setHeader("ETag", file.getETag());
+    } else {
+        std::string etag(file.getETag().substr(0, file.getETag().size() - 1));
+        etag += '-';
+        etag += codingName(coding);
+        etag += '"';
+        response.setHeader("ETag", etag);
+    }
+    response.setHeader("Last-Modified", formatHttpDate(file.getModifiedTime()));
+}
+
+// Looks for @p etag, which is strong, in an entity-tag list; `strong` refuses W/ tags
+bool matchesETag(std::string_view list, std::string_view etag, bool strong) noexcept {
+    if (trim(list) == "*")
+        return true;
+    std::size_t i = 0;
+    while (i < list.size()) {
+        if (list[i] == ' ' || list[i] == '\t' || list[i] == ',') {
+            ++i;
+            continue;
+        }
+        const bool weak = list.compare(i, 2, "W/") == 0;
+        if (weak)
+            i += 2;
+        const std::size_t close = i < list.size() && list[i] == '"' ? list.find('"', i + 1)
+                                                                    : std::string_view::npos;
+        if (close == std::string_view::npos)
+            return false; // Malformed: the condition does not hold
+        if (list.substr(i, close + 1 - i) == etag && !(strong && weak))
+            return true;
+        i = close + 1;
+    }
+    return false;
+}
+
+// RFC 9110, section 13.2.2: If-None-Match decides when present, else If-Modified-Since
+bool isNotModified(const HttpRequest& request, const HttpResponse& response) {
+    const std::string_view tags = request.getHeader("If-None-Match");
+    if (!tags.empty())
+        return matchesETag(tags, response.getField("ETag"), false);
+    const std::string_view since = request.getHeader("If-Modified-Since");
+    std::time_t            since_time;
+    std::time_t            modified;
+    return !since.empty() && parseHttpDate(since, since_time) &&
+           parseHttpDate(response.getField("Last-Modified"), modified) && modified <= since_time;
+}
+
+// If-Range holds for the current strong ETag or the exact Last-Modified date only
+bool ifRangeHolds(const HttpRequest& request, const HttpResponse& response) {
+    const std::string_view condition = trim(request.getHeader("If-Range"));
+    if (condition.empty())
+        return true;
+    if (condition.front() == '"')
+        return condition == response.getField("ETag");
+    std::time_t date;
+    std::time_t modified;
+    return parseHttpDate(condition, date) &&
+           parseHttpDate(response.getField("Last-Modified"), modified) && date == modified;
+}
+
+// Keeps the validators and Vary of the response it replaces (RFC 9110, section 15.4.5)
+HttpResponse notModified(const HttpResponse& full, bool varies,
+                         std::pmr::memory_resource* memory) {
+    HttpResponse response(304, memory);
+    response.setHeader("ETag", full.getField("ETag"));
+    response.setHeader("Last-Modified", full.getField("Last-Modified"));
+    if (varies)
+        response.addField(FIELD_VARY_ACCEPT_ENCODING);
+    return response;
+}
+
+// Value of the `page` query parameter; 1 when it is absent or malformed
+std::size_t requestedPage(std::string_view query) noexcept {
+    while (!query.empty()) {
+        const std::size_t      amp   = query.find('&');
+        const std::string_view param = query.substr(0, amp);
+        std::size_t            page;
+        if (param.compare(0, 5, "page=") == 0 && parseSize(param.substr(5), page) && page > 0)
+            return page;
+        query = amp == std::string_view::npos ? std::string_view() : query.substr(amp + 1);
+    }
+    return 1;
+}
+
+std::string contentRange(std::size_t first, std::size_t length, std::size_t size) {
+    char buf[80];
+    std::snprintf(buf, sizeof(buf), "bytes %zu-%zu/%zu", first, first + length - 1, size);
+    return std::string(buf);
+}
+
+// Reads a small file completely; false if it shrank since it was stat'ed
+bool readFile(const CachedFile& file, std::string& out) {
+    out.resize(file.getSize());
+    std::size_t done = 0;
+    while (done < out.size()) {
+        const ssize_t got =
+            pread(file.getFd(), &out[done], out.size() - done, static_cast<off_t>(done));
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0)
+            return false;
+        done += static_cast<std::size_t>(got);
+    }
+    return true;
+}
+
+} // namespace
+
+HttpResponseBuilder::HttpResponseBuilder(FileCache& files, AssetCache* assets,
+                                         CompressionBudget* budget)
+    : _files(files), _assets(assets), _budget(budget) {
+}
+
+std::string_view HttpResponseBuilder::mimeType(std::string_view path) noexcept {
+    return fieldValue(contentTypeField(path));
+}
+
+int HttpResponseBuilder::parseRange(std::string_view value, std::size_t size,
+                                    std::pmr::vector<ByteRange>& ranges) {
+    constexpr std::string_view UNIT = "bytes=";
+    ranges.clear();
+    if (value.size() < UNIT.size() || !iequals(value.substr(0, UNIT.size()), UNIT))
+        return 200;
+    value.remove_prefix(UNIT.size());
+
+    std::size_t specs = 0;
+    std::size_t total = 0;
+    while (!value.empty()) {
+        const std::size_t      comma = value.find(',');
+        const std::string_view spec  = trim(value.substr(0, comma));
+        value = comma == std::string_view::npos ? std::string_view() : value.substr(comma + 1);
+        if (spec.empty())
+            continue; // Lists may hold empty elements
+        const std::size_t dash = spec.find('-');
+        if (++specs > MAX_RANGES || dash == std::string_view::npos)
+            return 200;
+
+        std::size_t first;
+        std::size_t last;
+        if (dash == 0) { // "-N": the last N bytes
+            if (!parseSize(spec.substr(1), last))
+                return 200;
+            if (last == 0 || size == 0)
+                continue;
+            first = last < size ? size - last : 0;
+            last  = size - 1;
+        } else {
+            const bool open = dash + 1 == spec.size(); // "N-": up to the end
+            if (!parseSize(spec.substr(0, dash), first) ||
+                (!open && (!parseSize(spec.substr(dash + 1), last) || last < first)))
+                return 200;
+            if (first >= size)
+                continue;
+            if (open || last >= size)
+                last = size - 1;
+        }
+        total += last - first + 1;
+        if (total > size)
+            return 200; // Overlapping ranges would cost more than the whole file
+        ranges.push_back(ByteRange{first, last - first + 1});
+    }
+    if (specs == 0)
+        return 200;
+    return ranges.empty() ? 416 : 206;
+}
+
+bool HttpResponseBuilder::route(const HttpRequest& request, const Server& server,
+                                RequestRoute& route) {
+    route.server     = &server;
+    route.path.clear();
+    route.normalized = normalizeUriPath(request.getPath(), route.path);
+    route.location   = route.normalized ? server.findLocation(route.path) : NULL;
+    return route.normalized;
+}
+
+HttpResponse HttpResponseBuilder::build(const HttpRequest& request, const Server& server,
+                                        std::pmr::memory_resource* memory) {
+    RequestRoute routed;
+    route(request, server, routed);
+    return build(request, routed, memory);
+}
+
+HttpResponse HttpResponseBuilder::build(const HttpRequest& request, const RequestRoute& route,
+                                        std::pmr::memory_resource* memory) {
+    const Server& server = *route.server;
+    if (!route.normalized)
+        return buildError(400, server, memory);
+
+    const Location*        location = route.location;
+    const std::string_view path     = route.path;
+    if (!location)
+        return buildError(404, server, memory);
+    if (location->hasRedirect())
+        return buildRedirect(location->getReturnCode(), location->getRedirect(), memory);
+    if (!allowsMethod(*location, request.getMethod()))
+        return buildMethodNotAllowed(*location, server, memory);
+    if (location->isCgiRequest(path))
+        return buildError(404, server, memory); // resolveCgi() found no script to run
+
+    if (request.getMethod() == HttpMethod::GET || request.getMethod() == HttpMethod::HEAD)
+        return serveStatic(request, server, *location, path, memory);
+    return buildError(501, server, memory); // Uploads, DELETE and CGI are handled elsewhere
+}
+
+const Location* HttpResponseBuilder::resolveCgi(const HttpRequest&  request,
+                                                const RequestRoute& route,
+                                                std::string_view&   script_name,
+                                                std::pmr::string&   filename,
+                                                std::string_view&   path_info) {
+    const Location*   location = route.location;
+    const std::size_t length   = location ? location->cgiScriptLength(route.path) : 0;
+    if (!location || location->hasRedirect() || length == 0 ||
+        !allowsMethod(*location, request.getMethod()))
+        return NULL;
+    script_name = std::string_view(route.path).substr(0, length);
+    path_info   = std::string_view(route.path).substr(length);
+    if (location->getRoot().empty() || !location->resolveAbsolutePath(script_name, filename))
+        return NULL;
+    if (!location->getFastcgiPass().empty())
+        return location;
+    const FileCache::Lookup lookup = _files.open(filename);
+    if (!lookup.file || !lookup.file->isRegular())
+        return NULL;
+    return location;
+}
+
+const Location* HttpResponseBuilder::resolveUpload(const HttpRequest&  request,
+                                                   const RequestRoute& route) {
+    const Location* location = route.location;
+    if (request.getMethod() != HttpMethod::POST || !location || location->hasRedirect() ||
+        !location->isUploadEnabled() || location->isCgiRequest(route.path) ||
+        !allowsMethod(*location, request.getMethod()))
+        return NULL;
+    return location;
+}
+
+const Location* HttpResponseBuilder::resolveStats(const HttpRequest&  request,
+                                                  const RequestRoute& route) {
+    const HttpMethod method   = request.getMethod();
+    const Location*  location = route.location;
+    if ((method != HttpMethod::GET && method != HttpMethod::HEAD) || !location ||
+        location->hasRedirect() || !location->isStatsEnabled() || !allowsMethod(*location, method))
+        return NULL;
+    return location;
+}
+
+const Location* HttpResponseBuilder::resolveProxy(const HttpRequest&  request,
+                                                  const RequestRoute& route) {
+    const Location* location = route.location;
+    if (!location || location->hasRedirect() || location->getProxyPass().empty() ||
+        !allowsMethod(*location, request.getMethod()))
+        return NULL;
+    return location;
+}
+
+const Location* HttpResponseBuilder::resolveAutoindex(const HttpRequest&  request,
+                                                      const RequestRoute& route,
+                                                      std::pmr::string&   directory) {
+    const HttpMethod method   = request.getMethod();
+    const Location*  location = route.location;
+    if ((method != HttpMethod::GET && method != HttpMethod::HEAD) || !location ||
+        route.path.back() != '/' || location->hasRedirect() || !location->isAutoindexEnabled() ||
+        !allowsMethod(*location, method) || location->getRoot().empty() ||
+        !location->resolveAbsolutePath(route.path, directory))
+        return NULL;
+    const FileCache::Lookup lookup = _files.open(directory);
+    if (!lookup.file || !lookup.file->isDirectory())
+        return NULL;
+    if (!location->getIndex().empty()) {
+        const FileCache::Lookup index = _files.open(joinPath(directory, location->getIndex()));
+        if (index.file ? index.file->isRegular() : index.error != ENOENT)
+            return NULL; // build() serves the index, or its error
+    }
+    return location;
+}
+
+HttpResponse
+HttpResponseBuilder::buildListing(const HttpRequest& request, const Location& location,
+                                  std::string_view                               path,
+                                  const std::shared_ptr<const DirectoryListing>& listing,
+                                  const Server& server, std::pmr::memory_resource* memory) {
+    const std::size_t per_page = location.getAutoindexPageSize();
+    const std::size_t pages =
+        per_page ? std::max<std::size_t>(1, (listing->size() + per_page - 1) / per_page) : 1;
+    const std::size_t page = requestedPage(request.getQuery());
+    if (page > pages)
+        return buildError(404, server, memory);
+
+    std::string head;
+    std::string tail;
+    DirectoryListing::renderHead(head, path);
+    DirectoryListing::renderTail(tail, page, pages);
+    const std::string_view rows = per_page ? listing->getRows((page - 1) * per_page, per_page)
+                                           : listing->getRows(0, listing->size());
+    HttpResponse response(200, memory);
+    response.addField(FIELD_CONTENT_TYPE_HTML);
+    if (location.getCompression())
+        response.addField(FIELD_VARY_ACCEPT_ENCODING);
+
+    // Pages are compressed per request like CGI output, within the same budget
+    const unsigned wanted = location.getCompression() & availableCodings() &
+                            parseAcceptEncoding(request.getHeader("Accept-Encoding"));
+    const std::size_t length = head.size() + rows.size() + tail.size();
+    if (wanted && length >= location.getCompressMinLength() && (!_budget || _budget->allows())) {
+        const ContentCoding                        coding  = preferredCoding(wanted);
+        const CompressionBudget::Clock::time_point started = CompressionBudget::Clock::now();
+        Compressor                                 compressor(coding, Compressor::STREAM_LEVEL);
+        std::string                                compressed;
+        const bool ok = compressor.isValid() && compressor.write(head, compressed) &&
+                        compressor.write(rows, compressed) && compressor.write(tail, compressed) &&
+                        compressor.finish(compressed);
+        if (_budget)
+            _budget->charge(started);
+        if (ok && compressed.size() < length) {
+            response.addField(contentEncodingField(coding));
+            response.setBody(std::move(compressed));
+            return response;
+        }
+    }
+    response.setSharedBody(std::move(head), rows, listing, std::move(tail));
+    return response;
+}
+
+HttpResponse HttpResponseBuilder::buildCreated(std::string_view                directory_uri,
+                                               const std::vector<std::string>& files,
+                                               std::pmr::memory_resource*      memory) {
+    HttpResponse response(201, memory);
+    std::string  body;
+    for (const std::string& file : files) {
+        std::string uri(directory_uri);
+        appendPathSegment(uri, file); // Stored names may hold any byte but '/'
+        if (files.size() == 1)
+            response.setHeader("Location", uri);
+        body += uri;
+        body += "\r\n";
+    }
+    response.setBody(std::move(body), "text/plain");
+    return response;
+}
+
+HttpResponse HttpResponseBuilder::serveStatic(const HttpRequest& request, const Server& server,
+                                              const Location& location, std::string_view path,
+                                              std::pmr::memory_resource* memory) {
+    std::pmr::string filename(memory);
+    if (location.getRoot().empty() || !location.resolveAbsolutePath(path, filename))
+        return buildError(404, server, memory);
+
+    // Only locations that may compress look at what the client accepts
+    const unsigned accepted = location.getCompression() || location.isCompressStatic()
+                                  ? parseAcceptEncoding(request.getHeader("Accept-Encoding"))
+                                  : 0;
+    const FileCache::Lookup lookup = _files.open(filename);
+    if (!lookup.file) {
+        if (lookup.error == EACCES)
+            return buildError(403, server, memory);
+        if (lookup.error == ENOENT || lookup.error == ENOTDIR || lookup.error == ENAMETOOLONG)
+            return buildError(404, server, memory);
+        return buildError(500, server, memory);
+    }
+    if (!lookup.file->isDirectory())
+        return serveFile(request, lookup.file, filename, location, accepted, server, memory);
+
+    // Directory: make relative links work first, then try the index file
+    if (path.back() != '/') {
+        std::pmr::string target(path, memory);
+        target += '/';
+        if (!request.getQuery().empty()) {
+            target += '?';
+            target += request.getQuery();
+        }
+        return buildRedirect(301, target, memory);
+    }
+    if (!location.getIndex().empty()) {
+        const std::pmr::string  index = joinPath(filename, location.getIndex());
+        const FileCache::Lookup found = _files.open(index);
+        if (found.file && found.file->isRegular())
+            return serveFile(request, found.file, index, location, accepted, server, memory);
+        if (!found.file && found.error != ENOENT)
+            return buildError(found.error == EACCES ? 403 : 500, server, memory);
+    }
+    if (!location.isAutoindexEnabled())
+        return buildError(403, server, memory);
+
+    // resolveAutoindex() sends listings to the event loop; reaching here is a routing bug
+    return buildError(500, server, memory);
+}
+
+HttpResponse HttpResponseBuilder::serveFile(const HttpRequest&                       request,
+                                            const std::shared_ptr<const CachedFile>& file,
+                                            std::string_view path, const Location& location,
+                                            unsigned accepted, const Server& server,
+                                            std::pmr::memory_resource* memory) {
+    if (!file->isRegular())
+        return buildError(403, server, memory); // FIFOs, devices and sockets are never served
+
+    const std::string_view type_field = contentTypeField(path);
+    const bool             varies = location.getCompression() || location.isCompressStatic();
+    HttpResponse           response(200, memory);
+
+    // A precompressed sibling costs nothing; brotli first, as it is the smaller one
+    bool found = false;
+    if (location.isCompressStatic()) {
+        for (ContentCoding coding : {ContentCoding::BROTLI, ContentCoding::GZIP}) {
+            if (!(accepted & codingBit(coding)))
+                continue;
+            std::pmr::string sibling(path, memory);
+            sibling += codingSuffix(coding);
+            const FileCache::Lookup lookup = _files.open(sibling);
+            if (lookup.file && lookup.file->isRegular()) {
+                response = fileResponse(200, lookup.file, sibling, type_field, coding, memory);
+                found    = true;
+                break;
+            }
+        }
+    }
+
+    // Otherwise small text files are compressed once and kept in the asset cache
+    const unsigned wanted = location.getCompression() & accepted & availableCodings();
+    if (!found && wanted && _assets && _assets->accepts(file->getSize()) &&
+        file->getSize() >= location.getCompressMinLength() &&
+        isCompressibleType(fieldValue(type_field)))
+        found = compressedResponse(file, path, type_field, preferredCoding(wanted), response);
+
+    if (!found)
+        response = fileResponse(200, file, path, type_field, ContentCoding::IDENTITY, memory);
+    if (varies)
+        response.addField(FIELD_VARY_ACCEPT_ENCODING); // After the cached head, if any
+
+    // Conditions are checked against the variant chosen, whose validators are now set
+    if (isNotModified(request, response))
+        return notModified(response, varies, memory);
+
+    // Ranges are served from the file itself, so only without a content coding
+    const std::string_view range = request.getHeader("Range");
+    if (!range.empty() && request.getMethod() == HttpMethod::GET &&
+        response.getField("Content-Encoding").empty() && ifRangeHolds(request, response))
+        applyRange(range, file, type_field, varies, server, response, memory);
+    return response;
+}
+
+void HttpResponseBuilder::applyRange(std::string_view                         value,
+                                     const std::shared_ptr<const CachedFile>& file,
+                                     std::string_view type_field, bool varies,
+                                     const Server& server, HttpResponse& response,
+                                     std::pmr::memory_resource* memory) {
+    std::pmr::vector<ByteRange> ranges(memory);
+    const int                   status = parseRange(value, file->getSize(), ranges);
+    if (status == 200)
+        return;
+    if (status == 416) {
+        response = buildError(416, server, memory);
+        response.setHeader("Content-Range", "bytes */" + std::to_string(file->getSize()));
+        return;
+    }
+
+    HttpResponse partial(206, memory);
+    if (varies)
+        partial.addField(FIELD_VARY_ACCEPT_ENCODING);
+    setValidators(partial, *file);
+    if (ranges.size() == 1) {
+        partial.addField(type_field);
+        partial.setHeader("Content-Range",
+                          contentRange(ranges[0].first, ranges[0].length, file->getSize()));
+        partial.setFile(file, static_cast<off_t>(ranges[0].first), ranges[0].length);
+        response = std::move(partial);
+        return;
+    }
+
+    // Boundaries only need to be absent from the parts; a counter is what nginx uses too
+    static std::atomic<unsigned long long> boundaries(0);
+    char                                   boundary[24];
+    std::snprintf(boundary, sizeof(boundary), "%020llu", ++boundaries);
+    partial.setHeader("Content-Type", std::string("multipart/byteranges; boundary=") + boundary);
+
+    std::vector<HttpResponse::FilePart> parts;
+    parts.reserve(ranges.size());
+    for (const ByteRange& range : ranges) {
+        std::string head = "\r\n--";
+        head += boundary;
+        head += "\r\n";
+        head += type_field;
+        head += "Content-Range: ";
+        head += contentRange(range.first, range.length, file->getSize());
+        head += "\r\n\r\n";
+        parts.push_back(
+            HttpResponse::FilePart{std::move(head), static_cast<off_t>(range.first), range.length});
+    }
+    partial.setFileParts(file, std::move(parts), std::string("\r\n--") + boundary + "--\r\n");
+    response = std::move(partial);
+}
+
+// Small files are answered from the asset cache, larger ones with sendfile()
+HttpResponse HttpResponseBuilder::fileResponse(int status,
+                                               const std::shared_ptr<const CachedFile>& file,
+                                               std::string_view path, std::string_view type_field,
+                                               ContentCoding              coding,
+                                               std::pmr::memory_resource* memory) {
+    HttpResponse response(status, memory);
+    const bool   cacheable = _assets && _assets->accepts(file->getSize());
+    if (cacheable) {
+        if (std::shared_ptr<const CachedResponse> cached =
+                _assets->find(status, path, file, coding)) {
+            response.setCached(std::move(cached));
+            return response;
+        }
+    }
+
+    response.addField(type_field);
+    if (coding != ContentCoding::IDENTITY)
+        response.addField(contentEncodingField(coding));
+    if (status == 200) {
+        setValidators(response, *file);
+        if (coding == ContentCoding::IDENTITY)
+            response.addField(FIELD_ACCEPT_RANGES);
+    }
+    std::string body;
+    if (cacheable && readFile(*file, body)) {
+        response.setBody(std::move(body));
+        if (std::shared_ptr<const CachedResponse> cached =
+                _assets->insert(path, file, response, coding))
+            response.setCached(std::move(cached));
+        return response;
+    }
+    response.setFile(file, 0, file->getSize());
+    return response;
+}
+
+// False when the variant is neither cached nor affordable now; the caller then sends identity
+bool HttpResponseBuilder::compressedResponse(const std::shared_ptr<const CachedFile>& file,
+                                             std::string_view path, std::string_view type_field,
+                                             ContentCoding coding, HttpResponse& response) {
+    if (std::shared_ptr<const CachedResponse> cached = _assets->find(200, path, file, coding)) {
+        response.setCached(std::move(cached));
+        return true;
+    }
+    if (_budget && !_budget->allows())
+        return false;
+    std::string body;
+    if (!readFile(*file, body))
+        return false;
+
+    std::string                                   compressed;
+    const CompressionBudget::Clock::time_point started = CompressionBudget::Clock::now();
+    const bool ok = Compressor::compress(coding, Compressor::CACHE_LEVEL, body, compressed);
+    if (_budget)
+        _budget->charge(started);
+
+    // A body that does not shrink is kept as it is under the coding's key, so the
+    // work is not repeated for every request
+    const bool shrank = ok && compressed.size() < body.size();
+    response.addField(type_field);
+    if (shrank)
+        response.addField(contentEncodingField(coding));
+    setValidators(response, *file, shrank ? coding : ContentCoding::IDENTITY);
+    response.setBody(shrank ? std::move(compressed) : std::move(body));
+    if (std::shared_ptr<const CachedResponse> cached =
+            _assets->insert(path, file, response, coding))
+        response.setCached(std::move(cached));
+    return true;
+}
+
+HttpResponse HttpResponseBuilder::buildError(int status, const Server& server,
+                                             std::pmr::memory_resource* memory) {
+    HttpResponse response(status, memory);
+
+    // error_page entries are request paths, resolved through the server's locations
+    const std::map<int, std::string>&          pages = server.getErrorPages();
+    std::map<int, std::string>::const_iterator page  = pages.find(status);
+    if (page != pages.end()) {
+        const Location*  location = server.findLocation(page->second);
+        std::pmr::string filename(memory);
+        if (location && !location->getRoot().empty() &&
+            location->resolveAbsolutePath(page->second, filename)) {
+            const FileCache::Lookup lookup = _files.open(filename);
+            if (lookup.file && lookup.file->isRegular())
+                return fileResponse(status, lookup.file, filename, contentTypeField(filename),
+                                    ContentCoding::IDENTITY, memory);
+        }
+    }
+
+    // Built-in pages are generated once per status when the asset cache is enabled
+    if (_assets) {
+        if (std::shared_ptr<const CachedResponse> cached = _assets->find(status, "", NULL)) {
+            response.setCached(std::move(cached));
+            return response;
+        }
+    }
+    response.setBody(defaultErrorBody(status));
+    response.addField(FIELD_CONTENT_TYPE_HTML);
+    if (_assets) {
+        if (std::shared_ptr<const CachedResponse> cached = _assets->insert("", NULL, response))
+            response.setCached(std::move(cached));
+    }
+    return response;
+}
+
+HttpResponse HttpResponseBuilder::buildRedirect(int status, std::string_view target,
+                                                std::pmr::memory_resource* memory) const {
+    HttpResponse response(status, memory);
+    response.setHeader("Location", target);
+    response.setBody(defaultErrorBody(status));
+    response.addField(FIELD_CONTENT_TYPE_HTML);
+    return response;
+}
+
+HttpResponse HttpResponseBuilder::buildMethodNotAllowed(const Location& location,
+                                                        const Server&              server,
+                                                        std::pmr::memory_resource* memory) {
+    std::pmr::string allow(memory);
+    for (HttpMethod method : KNOWN_METHODS) {
+        if (!allowsMethod(location, method))
+            continue;
+        if (!allow.empty())
+            allow += ", ";
+        allow += httpMethodName(method);
+    }
+    HttpResponse response = buildError(405, server, memory);
+    response.setHeader("Allow", allow);
+    return response;
+}
@@ -0,0 +1,374 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HttpScanner.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:11:48 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:44:24 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    HttpScanner.cpp
+ * @brief   Implements the scalar and SIMD delimiter scanning kernels.
+ *
+ * @details Vector kernels process full 16/32-byte blocks and hand the remaining tail
+ * to the scalar loop, so they never read past @p end. Token classification uses
+ * the nibble-lookup technique: a byte is a tchar iff
+ * `LO[byte & 0x0f] & HI[byte >> 4]` is non-zero, with both 16-entry tables derived
+ * at compile time from the scalar lookup table.
+ *
+ * @ingroup http
+ */
+
+#include "http/HttpScanner.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define WEBSERV_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__)
+#define WEBSERV_SCAN_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// --- Character classes ---
+
+// RFC 9110 tchar: "!#$%&'*+-.^_`|~", DIGIT and ALPHA
+constexpr std::array<bool, 256> makeTcharTable() {
+    std::array<bool, 256> table{};
+    for (int c = '0'; c <= '9'; ++c)
+        table[static_cast<std::size_t>(c)] = true;
+    for (int c = 'a'; c <= 'z'; ++c)
+        table[static_cast<std::size_t>(c)] = true;
+    for (int c = 'A'; c <= 'Z'; ++c)
+        table[static_cast<std::size_t>(c)] = true;
+    for (char c : std::string_view("!#$%&'*+-.^_`|~"))
+        table[static_cast<unsigned char>(c)] = true;
+    return table;
+}
+
+constexpr std::array<bool, 256> TCHAR = makeTcharTable();
+
+struct NibbleTables {
+    std::array<std::uint8_t, 16> lo; ///< Class bits allowed for each low nibble.
+    std::array<std::uint8_t, 16> hi; ///< Class bit of each high nibble, 0 if none allowed.
+};
+
+// Group high nibbles by their set of allowed low nibbles; tchar needs 6 of 8 classes
+constexpr NibbleTables makeTokenNibbles() {
+    NibbleTables                  tables{};
+    std::array<std::uint16_t, 8> classes{};
+    std::size_t                   count = 0;
+
+    for (std::size_t h = 0; h < 16; ++h) {
+        std::uint16_t allowed = 0;
+        for (std::size_t l = 0; l < 16; ++l) {
+            if (TCHAR[h * 16 + l])
+                allowed = static_cast<std::uint16_t>(allowed | (1U << l));
+        }
+        if (allowed == 0)
+            continue;
+        std::size_t c = 0;
+        while (c < count && classes[c] != allowed)
+            ++c;
+        if (c == count)
+            classes[count++] = allowed; // Fails constant evaluation past 8 classes
+        tables.hi[h] = static_cast<std::uint8_t>(1U << c);
+    }
+    for (std::size_t l = 0; l < 16; ++l) {
+        for (std::size_t c = 0; c < count; ++c) {
+            if (classes[c] & (1U << l))
+                tables.lo[l] = static_cast<std::uint8_t>(tables.lo[l] | (1U << c));
+        }
+    }
+    return tables;
+}
+
+constexpr NibbleTables TOKEN_NIBBLES = makeTokenNibbles();
+
+// --- Scalar kernels ---
+
+std::size_t scalarToken(const char* p, std::size_t i, std::size_t end) noexcept {
+    while (i < end && TCHAR[static_cast<unsigned char>(p[i])])
+        ++i;
+    return i;
+}
+
+std::size_t scalarTarget(const char* p, std::size_t i, std::size_t end) noexcept {
+    while (i < end) {
+        const unsigned char c = static_cast<unsigned char>(p[i]);
+        if (c <= 0x20 || c == 0x7f)
+            break;
+        ++i;
+    }
+    return i;
+}
+
+std::size_t scalarValue(const char* p, std::size_t i, std::size_t end) noexcept {
+    while (i < end) {
+        const unsigned char c = static_cast<unsigned char>(p[i]);
+        if ((c < 0x20 && c != '\t') || c == 0x7f)
+            break;
+        ++i;
+    }
+    return i;
+}
+
+constexpr HttpScanKernels SCALAR_KERNELS = {ScanKernel::SCALAR, "scalar", scalarToken,
+                                            scalarTarget, scalarValue};
+
+// --- x86 kernels ---
+
+#if defined(WEBSERV_SCAN_X86)
+
+__attribute__((target("sse4.2"))) std::size_t sse42Token(const char* p, std::size_t i,
+                                                         std::size_t end) noexcept {
+    const __m128i lo_table =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(TOKEN_NIBBLES.lo.data()));
+    const __m128i hi_table =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(TOKEN_NIBBLES.hi.data()));
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i zero   = _mm_setzero_si128();
+
+    for (; i + 16 <= end; i += 16) {
+        const __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const __m128i lo = _mm_shuffle_epi8(lo_table, _mm_and_si128(v, nibble));
+        const __m128i hi =
+            _mm_shuffle_epi8(hi_table, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        const __m128i  bad  = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), zero);
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(bad));
+        if (mask)
+            return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+    return scalarToken(p, i, end);
+}
+
+// PCMPESTRI range mode: index of the first byte inside any of the given ranges
+__attribute__((target("sse4.2"))) std::size_t sse42Ranges(const char* p, std::size_t i,
+                                                          std::size_t end, const char* ranges,
+                                                          int ranges_len) noexcept {
+    const __m128i set = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ranges));
+    for (; i + 16 <= end; i += 16) {
+        const __m128i v   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const int     idx = _mm_cmpestri(set, ranges_len, v, 16,
+                                         _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES |
+                                             _SIDD_LEAST_SIGNIFICANT);
+        if (idx != 16)
+            return i + static_cast<std::size_t>(idx);
+    }
+    return i;
+}
+
+alignas(16) const char TARGET_RANGES[16] = {'\x00', '\x20', '\x7f', '\x7f'};
+alignas(16) const char VALUE_RANGES[16]  = {'\x00', '\x08', '\x0a', '\x1f', '\x7f', '\x7f'};
+
+std::size_t sse42Target(const char* p, std::size_t i, std::size_t end) noexcept {
+    i = sse42Ranges(p, i, end, TARGET_RANGES, 4);
+    return i + 16 <= end ? i : scalarTarget(p, i, end);
+}
+
+std::size_t sse42Value(const char* p, std::size_t i, std::size_t end) noexcept {
+    i = sse42Ranges(p, i, end, VALUE_RANGES, 6);
+    return i + 16 <= end ? i : scalarValue(p, i, end);
+}
+
+__attribute__((target("avx2"))) std::size_t avx2Token(const char* p, std::size_t i,
+                                                     std::size_t end) noexcept {
+    const __m256i lo_table = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(TOKEN_NIBBLES.lo.data())));
+    const __m256i hi_table = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(TOKEN_NIBBLES.hi.data())));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i zero   = _mm256_setzero_si256();
+
+    for (; i + 32 <= end; i += 32) {
+        const __m256i v  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i lo = _mm256_shuffle_epi8(lo_table, _mm256_and_si256(v, nibble));
+        const __m256i hi =
+            _mm256_shuffle_epi8(hi_table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        const __m256i  bad  = _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), zero);
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(bad));
+        if (mask)
+            return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+    return scalarToken(p, i, end);
+}
+
+__attribute__((target("avx2"))) std::size_t avx2Target(const char* p, std::size_t i,
+                                                      std::size_t end) noexcept {
+    const __m256i space = _mm256_set1_epi8(0x20);
+    const __m256i del   = _mm256_set1_epi8(0x7f);
+
+    for (; i + 32 <= end; i += 32) {
+        const __m256i  v    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i  ctl  = _mm256_cmpeq_epi8(_mm256_min_epu8(v, space), v); // v <= 0x20
+        const __m256i  stop = _mm256_or_si256(ctl, _mm256_cmpeq_epi8(v, del));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(stop));
+        if (mask)
+            return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+    return scalarTarget(p, i, end);
+}
+
+__attribute__((target("avx2"))) std::size_t avx2Value(const char* p, std::size_t i,
+                                                     std::size_t end) noexcept {
+    const __m256i us  = _mm256_set1_epi8(0x1f);
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i del = _mm256_set1_epi8(0x7f);
+
+    for (; i + 32 <= end; i += 32) {
+        const __m256i  v    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i  ctl  = _mm256_cmpeq_epi8(_mm256_min_epu8(v, us), v); // v < 0x20
+        const __m256i  stop = _mm256_or_si256(_mm256_andnot_si256(_mm256_cmpeq_epi8(v, tab), ctl),
+                                              _mm256_cmpeq_epi8(v, del));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(stop));
+        if (mask)
+            return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+    return scalarValue(p, i, end);
+}
+
+constexpr HttpScanKernels SSE42_KERNELS = {ScanKernel::SSE42, "sse4.2", sse42Token, sse42Target,
+                                           sse42Value};
+constexpr HttpScanKernels AVX2_KERNELS  = {ScanKernel::AVX2, "avx2", avx2Token, avx2Target,
+                                           avx2Value};
+
+#endif
+
+// --- ARM kernels ---
+
+#if defined(WEBSERV_SCAN_NEON)
+
+// Index of the first non-zero byte of a 0x00/0xff comparison result, or 16
+inline std::size_t firstSet(uint8x16_t cmp) noexcept {
+    const uint64_t bits =
+        vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0);
+    return bits ? static_cast<std::size_t>(__builtin_ctzll(bits)) / 4 : 16;
+}
+
+std::size_t neonToken(const char* p, std::size_t i, std::size_t end) noexcept {
+    const uint8x16_t lo_table = vld1q_u8(TOKEN_NIBBLES.lo.data());
+    const uint8x16_t hi_table = vld1q_u8(TOKEN_NIBBLES.hi.data());
+    const uint8x16_t nibble   = vdupq_n_u8(0x0f);
+
+    for (; i + 16 <= end; i += 16) {
+        const uint8x16_t  v   = vld1q_u8(reinterpret_cast<const uint8_t*>(p + i));
+        const uint8x16_t  lo  = vqtbl1q_u8(lo_table, vandq_u8(v, nibble));
+        const uint8x16_t  hi  = vqtbl1q_u8(hi_table, vshrq_n_u8(v, 4));
+        const uint8x16_t  bad = vceqq_u8(vandq_u8(lo, hi), vdupq_n_u8(0));
+        const std::size_t idx = firstSet(bad);
+        if (idx != 16)
+            return i + idx;
+    }
+    return scalarToken(p, i, end);
+}
+
+std::size_t neonTarget(const char* p, std::size_t i, std::size_t end) noexcept {
+    const uint8x16_t space = vdupq_n_u8(0x20);
+    const uint8x16_t del   = vdupq_n_u8(0x7f);
+
+    for (; i + 16 <= end; i += 16) {
+        const uint8x16_t  v    = vld1q_u8(reinterpret_cast<const uint8_t*>(p + i));
+        const uint8x16_t  stop = vorrq_u8(vcleq_u8(v, space), vceqq_u8(v, del));
+        const std::size_t idx  = firstSet(stop);
+        if (idx != 16)
+            return i + idx;
+    }
+    return scalarTarget(p, i, end);
+}
+
+std::size_t neonValue(const char* p, std::size_t i, std::size_t end) noexcept {
+    const uint8x16_t space = vdupq_n_u8(0x20);
+    const uint8x16_t tab   = vdupq_n_u8('\t');
+    const uint8x16_t del   = vdupq_n_u8(0x7f);
+
+    for (; i + 16 <= end; i += 16) {
+        const uint8x16_t  v   = vld1q_u8(reinterpret_cast<const uint8_t*>(p + i));
+        const uint8x16_t  ctl = vbicq_u8(vcltq_u8(v, space), vceqq_u8(v, tab));
+        const std::size_t idx = firstSet(vorrq_u8(ctl, vceqq_u8(v, del)));
+        if (idx != 16)
+            return i + idx;
+    }
+    return scalarValue(p, i, end);
+}
+
+constexpr HttpScanKernels NEON_KERNELS = {ScanKernel::NEON, "neon", neonToken, neonTarget,
+                                          neonValue};
+
+#endif
+
+// --- Runtime selection ---
+
+const HttpScanKernels* detectBestKernels() noexcept {
+#if defined(WEBSERV_SCAN_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return &AVX2_KERNELS;
+    if (__builtin_cpu_supports("sse4.2"))
+        return &SSE42_KERNELS;
+#elif defined(WEBSERV_SCAN_NEON)
+    return &NEON_KERNELS;
+#endif
+    return &SCALAR_KERNELS;
+}
+
+std::atomic<const HttpScanKernels*>& activeSlot() noexcept {
+    static std::atomic<const HttpScanKernels*> active(detectBestKernels());
+    return active;
+}
+
+} // namespace
+
+bool isScanKernelSupported(ScanKernel kind) noexcept {
+    return findScanKernels(kind) != nullptr;
+}
+
+const HttpScanKernels* findScanKernels(ScanKernel kind) noexcept {
+    switch (kind) {
+    case ScanKernel::SCALAR:
+        return &SCALAR_KERNELS;
+    case ScanKernel::SSE42:
+#if defined(WEBSERV_SCAN_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse4.2"))
+            return &SSE42_KERNELS;
+#endif
+        return nullptr;
+    case ScanKernel::AVX2:
+#if defined(WEBSERV_SCAN_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return &AVX2_KERNELS;
+#endif
+        return nullptr;
+    case ScanKernel::NEON:
+#if defined(WEBSERV_SCAN_NEON)
+        return &NEON_KERNELS;
+#else
+        return nullptr;
+#endif
+    }
+    return nullptr;
+}
+
+const HttpScanKernels& activeScanKernels() noexcept {
+    return *activeSlot().load(std::memory_order_relaxed);
+}
+
+bool selectScanKernel(ScanKernel kind) noexcept {
+    const HttpScanKernels* kernels = findScanKernels(kind);
+    if (!kernels)
+        return false;
+    activeSlot().store(kernels, std::memory_order_relaxed);
+    return true;
+}
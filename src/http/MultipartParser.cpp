@@ -0,0 +1,196 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MultipartParser.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:24:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:24:13 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    MultipartParser.cpp
+ * @brief   Implements the MultipartParser class.
+ *
+ * @ingroup http
+ */
+
+#include "http/MultipartParser.hpp"
+#include "utils/StringUtils.hpp"
+#include <algorithm>
+
+namespace {
+
+std::string_view trimSpaces(std::string_view text) noexcept {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+        text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+        text.remove_suffix(1);
+    return text;
+}
+
+// Value of a `; name=value` parameter of a header value, unquoted (RFC 9110, section 5.6.6)
+bool findParameter(std::string_view header, std::string_view name, std::string& value) {
+    std::size_t pos = header.find(';');
+    while (pos != std::string_view::npos) {
+        ++pos;
+        const std::size_t equals = header.find('=', pos);
+        if (equals == std::string_view::npos)
+            return false;
+        const std::string_view key = trimSpaces(header.substr(pos, equals - pos));
+        std::string            text;
+        pos = equals + 1;
+        while (pos < header.size() && (header[pos] == ' ' || header[pos] == '\t'))
+            ++pos;
+        if (pos < header.size() && header[pos] == '"') {
+            for (++pos; pos < header.size() && header[pos] != '"'; ++pos) {
+                if (header[pos] == '\\' && pos + 1 < header.size())
+                    ++pos;
+                text += header[pos];
+            }
+            pos = header.find(';', pos);
+        } else {
+            const std::size_t end = header.find(';', pos);
+            text = std::string(trimSpaces(header.substr(pos, end - pos)));
+            pos  = end;
+        }
+        if (iequals(key, name)) {
+            value.swap(text);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+MultipartParser::MultipartParser(std::string_view boundary)
+    : _delimiter("\r\n--"), _state(State::START) {
+    _delimiter.append(boundary.data(), boundary.size());
+}
+
+bool MultipartParser::findBoundary(std::string_view content_type, std::string& boundary) {
+    const std::string_view media = trimSpaces(content_type.substr(0, content_type.find(';')));
+    if (!iequals(media, "multipart/form-data"))
+        return false;
+    return findParameter(content_type, "boundary", boundary) && !boundary.empty() &&
+           boundary.size() <= MAX_BOUNDARY;
+}
+
+MultipartParser::Result MultipartParser::next(std::string_view input, std::size_t& consumed,
+                                              std::string_view& data) {
+    consumed = 0;
+    while (true) {
+        const std::string_view rest = input.substr(consumed);
+        switch (_state) {
+        case State::START: {
+            // The first delimiter may open the body without the CRLF before it
+            const std::string_view dash_boundary = std::string_view(_delimiter).substr(2);
+            const std::size_t      length        = std::min(rest.size(), dash_boundary.size());
+            if (rest.substr(0, length) != dash_boundary.substr(0, length)) {
+                _state = State::PREAMBLE;
+                break;
+            }
+            if (length < dash_boundary.size())
+                return Result::NEED_MORE;
+            consumed += length;
+            _state = State::DELIMITED;
+            break;
+        }
+        case State::PREAMBLE: {
+            const std::size_t found = rest.find(_delimiter);
+            if (found == std::string_view::npos) {
+                consumed += safeLength(rest);
+                return Result::NEED_MORE;
+            }
+            consumed += found + _delimiter.size();
+            _state = State::DELIMITED;
+            break;
+        }
+        case State::DELIMITED: {
+            std::size_t padding = 0; // Transport padding may follow the boundary
+            while (padding < rest.size() && (rest[padding] == ' ' || rest[padding] == '\t'))
+                ++padding;
+            consumed += padding;
+            const std::string_view mark = rest.substr(padding, 2);
+            if (mark.size() < 2)
+                return Result::NEED_MORE;
+            consumed += 2;
+            if (mark == "--") {
+                _state = State::EPILOGUE;
+                return Result::DONE;
+            }
+            if (mark != "\r\n")
+                return Result::ERROR;
+            _state = State::HEADERS;
+            break;
+        }
+        case State::HEADERS: {
+            if (rest.size() < 2)
+                return Result::NEED_MORE;
+            std::size_t block = 0; // A part may have no header at all
+            if (rest.compare(0, 2, "\r\n") != 0) {
+                const std::size_t end = rest.find("\r\n\r\n");
+                if (end == std::string_view::npos)
+                    return rest.size() > MAX_HEADERS ? Result::ERROR : Result::NEED_MORE;
+                block = end + 2;
+            }
+            if (block > MAX_HEADERS)
+                return Result::ERROR;
+            parseHeaders(rest.substr(0, block));
+            consumed += block + 2;
+            _state = State::BODY;
+            return Result::PART;
+        }
+        case State::BODY: {
+            const std::size_t found = rest.find(_delimiter);
+            if (found == 0) {
+                consumed += _delimiter.size();
+                _state = State::DELIMITED;
+                return Result::PART_END;
+            }
+            const std::size_t length = found != std::string_view::npos ? found : safeLength(rest);
+            if (length == 0)
+                return Result::NEED_MORE;
+            data = rest.substr(0, length);
+            consumed += length;
+            return Result::DATA;
+        }
+        case State::EPILOGUE:
+            consumed = input.size();
+            return Result::DONE;
+        }
+    }
+}
+
+const std::string& MultipartParser::getFilename() const noexcept {
+    return _filename;
+}
+
+// Only Content-Disposition matters: it names the form field and the uploaded file
+void MultipartParser::parseHeaders(std::string_view block) {
+    _filename.clear();
+    while (!block.empty()) {
+        const std::size_t      end   = block.find("\r\n");
+        const std::string_view line  = block.substr(0, end);
+        const std::size_t      colon = line.find(':');
+        if (colon != std::string_view::npos &&
+            iequals(trimSpaces(line.substr(0, colon)), "Content-Disposition"))
+            findParameter(line.substr(colon + 1), "filename", _filename);
+        block.remove_prefix(end == std::string_view::npos ? block.size() : end + 2);
+    }
+}
+
+// Bytes that cannot be the start of a delimiter, which may be completed by later input
+std::size_t MultipartParser::safeLength(std::string_view input) const noexcept {
+    const std::size_t from =
+        input.size() >= _delimiter.size() ? input.size() - _delimiter.size() + 1 : 0;
+    for (std::size_t pos = from; pos < input.size(); ++pos) {
+        if (input[pos] == '\r' &&
+            std::string_view(_delimiter).substr(0, input.size() - pos) == input.substr(pos))
+            return pos;
+    }
+    return input.size();
+}
@@ -0,0 +1,205 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UploadWriter.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:24:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 03:32:33 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    UploadWriter.cpp
+ * @brief   Implements the UploadWriter class.
+ *
+ * @details Writes to regular files do not block on the network, only on the disk,
+ * so they are done directly from the event loop like the reads of FileCache.
+ *
+ * @ingroup http
+ */
+
+#include "http/UploadWriter.hpp"
+#include "utils/Logger.hpp"
+#include "utils/StringUtils.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utility>
+
+namespace {
+
+constexpr char TEMP_PREFIX[] = ".upload-"; ///< Hidden while written; generated names drop the dot.
+
+} // namespace
+
+UploadWriter::UploadWriter(std::string directory)
+    : _directory(std::move(directory)), _done(false), _fd(-1), _status(0) {
+    if (_directory.empty() || _directory.back() != '/')
+        _directory += '/';
+}
+
+UploadWriter::~UploadWriter() {
+    discardFile();
+}
+
+bool UploadWriter::start(std::string_view content_type, std::string_view name) {
+    std::string boundary;
+    if (MultipartParser::findBoundary(content_type, boundary)) {
+        _multipart.reset(new MultipartParser(boundary));
+        return true;
+    }
+    if (iequals(content_type.substr(0, 19), "multipart/form-data")) {
+        _status = 400; // Without a boundary its parts cannot be told apart
+        return false;
+    }
+    if (!name.empty() && !isValidName(name)) {
+        _status = 400;
+        return false;
+    }
+    return openFile(name);
+}
+
+std::size_t UploadWriter::write(std::string_view data) {
+    if (_status)
+        return 0;
+    if (!_multipart)
+        return writeFile(data) ? data.size() : 0;
+
+    std::size_t total = 0;
+    while (total < data.size() && !_status) {
+        std::size_t                   used = 0;
+        std::string_view              bytes;
+        const MultipartParser::Result result = _multipart->next(data.substr(total), used, bytes);
+        total += used;
+        switch (result) {
+        case MultipartParser::Result::NEED_MORE:
+            return total;
+        case MultipartParser::Result::PART:
+            // Plain form fields are not stored; a file part names its file
+            if (!_multipart->getFilename().empty()) {
+                std::string_view filename = _multipart->getFilename();
+                const std::size_t slash  = filename.find_last_of("/\\");
+                if (slash != std::string_view::npos)
+                    filename.remove_prefix(slash + 1); // Browsers may send a client path
+                if (!isValidName(filename))
+                    _status = 400;
+                else
+                    openFile(filename);
+            }
+            break;
+        case MultipartParser::Result::DATA:
+            if (_fd >= 0)
+                writeFile(bytes);
+            break;
+        case MultipartParser::Result::PART_END:
+            if (_fd >= 0)
+                commitFile();
+            break;
+        case MultipartParser::Result::DONE:
+            _done = true;
+            break;
+        case MultipartParser::Result::ERROR:
+            _status = 400;
+            break;
+        }
+    }
+    return total;
+}
+
+bool UploadWriter::finish() {
+    if (_status)
+        return false;
+    if (_multipart) {
+        if (!_done || _files.empty()) {
+            _status = 400; // Truncated, or a form without any file
+            return false;
+        }
+        return true;
+    }
+    return commitFile();
+}
+
+int UploadWriter::getStatus() const noexcept {
+    return _status;
+}
+
+const std::vector<std::string>& UploadWriter::getFiles() const noexcept {
+    return _files;
+}
+
+bool UploadWriter::isValidName(std::string_view name) noexcept {
+    if (name.empty() || name == "." || name == "..")
+        return false;
+    for (char c : name) {
+        const unsigned char byte = static_cast<unsigned char>(c);
+        if (byte < 0x20 || byte == 0x7F || c == '/' || c == '\\')
+            return false;
+    }
+    return true;
+}
+
+bool UploadWriter::openFile(std::string_view name) {
+    std::string temp = _directory + TEMP_PREFIX + "XXXXXX";
+    const int   fd   = mkstemp(&temp[0]);
+    if (fd < 0 || fcntl(fd, F_SETFD, FD_CLOEXEC) < 0) {
+        fail(errno);
+        if (fd >= 0) {
+            close(fd);
+            unlink(temp.c_str());
+        }
+        return false;
+    }
+    _fd   = fd;
+    _temp = temp;
+    _name = std::string(name);
+    return true;
+}
+
+bool UploadWriter::writeFile(std::string_view data) {
+    while (!data.empty()) {
+        const ssize_t written = ::write(_fd, data.data(), data.size());
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written < 0) {
+            fail(errno);
+            discardFile();
+            return false;
+        }
+        data.remove_prefix(static_cast<std::size_t>(written));
+    }
+    return true;
+}
+
+// Publish the file under its final name; an existing file of that name is replaced
+bool UploadWriter::commitFile() {
+    const std::string name =
+        _name.empty() ? _temp.substr(_directory.size() + 1) : _name; // Generated: drop the dot
+    const int fd = _fd;
+    _fd          = -1;
+    if (close(fd) < 0 || rename(_temp.c_str(), (_directory + name).c_str()) < 0) {
+        fail(errno);
+        unlink(_temp.c_str());
+        return false;
+    }
+    _files.push_back(name);
+    return true;
+}
+
+void UploadWriter::discardFile() noexcept {
+    if (_fd < 0)
+        return;
+    close(_fd);
+    unlink(_temp.c_str());
+    _fd = -1;
+}
+
+// A full disk is the client's to know about; anything else is the server's problem
+void UploadWriter::fail(int error) noexcept {
+    LOG_ERROR("Upload: %s: %s", _directory.c_str(), strerror(error));
+    _status = error == ENOSPC || error == EDQUOT ? 507 : 500;
+}
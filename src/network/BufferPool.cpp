@@ -0,0 +1,117 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BufferPool.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:39:56 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:39:56 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    BufferPool.cpp
+ * @brief   Implements the BufferPool free list.
+ *
+ * @ingroup network
+ */
+
+#include "network/BufferPool.hpp"
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+
+constexpr std::size_t CHUNK_ALIGNMENT = alignof(std::max_align_t);
+
+} // namespace
+
+constexpr std::size_t BufferPool::DEFAULT_CHUNK_SIZE;
+constexpr std::size_t BufferPool::DEFAULT_MAX_IDLE;
+
+BufferPool::BufferPool(std::size_t chunk_size, std::size_t max_idle,
+                       std::pmr::memory_resource* upstream)
+    : _chunk_size(std::max(chunk_size, sizeof(FreeChunk))), _max_idle(max_idle),
+      _upstream(upstream), _free(NULL), _idle(0), _in_use(0), _high_water(0), _hits(0),
+      _misses(0) {
+}
+
+BufferPool::~BufferPool() {
+    trim();
+}
+
+bool BufferPool::isPooled(std::size_t bytes, std::size_t alignment) const noexcept {
+    return bytes <= _chunk_size && alignment <= CHUNK_ALIGNMENT;
+}
+
+void* BufferPool::do_allocate(std::size_t bytes, std::size_t alignment) {
+    if (!isPooled(bytes, alignment))
+        return _upstream->allocate(bytes, alignment);
+
+    void* chunk;
+    if (_free) {
+        chunk = _free;
+        _free = _free->next;
+        --_idle;
+        ++_hits;
+    } else {
+        chunk = _upstream->allocate(_chunk_size, CHUNK_ALIGNMENT);
+        ++_misses;
+    }
+    _high_water = std::max(_high_water, ++_in_use);
+    return chunk;
+}
+
+void BufferPool::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    if (!isPooled(bytes, alignment)) {
+        _upstream->deallocate(p, bytes, alignment);
+        return;
+    }
+    --_in_use;
+    if (_idle >= _max_idle) {
+        _upstream->deallocate(p, _chunk_size, CHUNK_ALIGNMENT);
+        return;
+    }
+    FreeChunk* chunk = static_cast<FreeChunk*>(p);
+    chunk->next      = _free;
+    _free            = chunk;
+    ++_idle;
+}
+
+bool BufferPool::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void BufferPool::trim() noexcept {
+    while (_free) {
+        FreeChunk* next = _free->next;
+        _upstream->deallocate(_free, _chunk_size, CHUNK_ALIGNMENT);
+        _free = next;
+    }
+    _idle = 0;
+}
+
+std::size_t BufferPool::getChunkSize() const noexcept {
+    return _chunk_size;
+}
+
+std::size_t BufferPool::getInUse() const noexcept {
+    return _in_use;
+}
+
+std::size_t BufferPool::getHighWater() const noexcept {
+    return _high_water;
+}
+
+std::size_t BufferPool::getIdle() const noexcept {
+    return _idle;
+}
+
+std::size_t BufferPool::getHits() const noexcept {
+    return _hits;
+}
+
+std::size_t BufferPool::getMisses() const noexcept {
+    return _misses;
+}
@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ByteBuffer.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:04:14 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:24:13 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    ByteBuffer.cpp
+ * @brief   Implements the ByteBuffer class.
+ *
+ * @ingroup network
+ */
+
+#include "network/ByteBuffer.hpp"
+#include <cstring>
+
+namespace {
+
+constexpr std::size_t MIN_CAPACITY = 4096; ///< First allocation, one page.
+
+} // namespace
+
+ByteBuffer::ByteBuffer(std::pmr::memory_resource* memory)
+    : _memory(memory), _storage(NULL), _capacity(0), _head(0), _tail(0) {
+}
+
+ByteBuffer::~ByteBuffer() {
+    if (_storage)
+        _memory->deallocate(_storage, _capacity, 1);
+}
+
+char* ByteBuffer::prepare(std::size_t min_free) {
+    if (_capacity - _tail >= min_free)
+        return _storage + _tail;
+
+    const std::size_t used = _tail - _head;
+
+    // Enough room overall: slide the unread bytes to the front
+    if (_storage && _capacity - used >= min_free) {
+        std::memmove(_storage, _storage + _head, used);
+        _head = 0;
+        _tail = used;
+        return _storage + _tail;
+    }
+
+    // Otherwise grow geometrically so appends stay amortized O(1)
+    std::size_t new_capacity = _capacity ? _capacity : MIN_CAPACITY;
+    while (new_capacity - used < min_free)
+        new_capacity *= 2;
+    char* grown = static_cast<char*>(_memory->allocate(new_capacity, 1));
+    if (_storage) {
+        if (used)
+            std::memcpy(grown, _storage + _head, used);
+        _memory->deallocate(_storage, _capacity, 1);
+    }
+    _storage  = grown;
+    _capacity = new_capacity;
+    _head     = 0;
+    _tail     = used;
+    return _storage + _tail;
+}
+
+void ByteBuffer::commit(std::size_t count) noexcept {
+    _tail += count;
+}
+
+void ByteBuffer::consume(std::size_t count) noexcept {
+    _head += count;
+    if (_head >= _tail)
+        _head = _tail = 0; // Rewind for free when fully drained
+}
+
+void ByteBuffer::erase(std::size_t offset, std::size_t count) noexcept {
+    if (count == 0)
+        return;
+    char* const from = _storage + _head + offset;
+    std::memmove(from, from + count, size() - offset - count);
+    _tail -= count;
+}
+
+void ByteBuffer::clear() noexcept {
+    _head = _tail = 0;
+}
+
+bool ByteBuffer::release() noexcept {
+    if (_head != _tail)
+        return false;
+    if (_storage)
+        _memory->deallocate(_storage, _capacity, 1);
+    _storage  = NULL;
+    _capacity = 0;
+    _head = _tail = 0;
+    return true;
+}
+
+const char* ByteBuffer::data() const noexcept {
+    return _storage + _head;
+}
+
+char* ByteBuffer::data() noexcept {
+    return _storage + _head;
+}
+
+std::size_t ByteBuffer::size() const noexcept {
+    return _tail - _head;
+}
+
+bool ByteBuffer::empty() const noexcept {
+    return _tail == _head;
+}
+
+std::size_t ByteBuffer::writableSize() const noexcept {
+    return _capacity - _tail;
+}
+
+std::size_t ByteBuffer::capacity() const noexcept {
+    return _capacity;
+}
+
+std::string_view ByteBuffer::view() const noexcept {
+    return std::string_view(data(), size());
+}
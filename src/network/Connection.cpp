@@ -0,0 +1,695 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Connection.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: irychkov <irychkov@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/05/03 13:51:20 by irychkov          #+#    #+#             */
+/*   Updated: 2025/05/12 17:41:30 by irychkov         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Connection.cpp
+ * @brief   Implements the per-client Connection state machine.
+ *
+ * @ingroup network
+ */
+
+#include "network/Connection.hpp"
+#include "utils/Logger.hpp"
+#include "utils/Probes.hpp"
+#include "utils/StringUtils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // macOS: SIGPIPE is ignored process-wide instead
+#endif
+
+namespace {
+
+// Connections without a pool fall back to the heap
+std::pmr::memory_resource* memoryOf(BufferPool* pool) noexcept {
+    if (pool)
+        return pool;
+    return std::pmr::new_delete_resource();
+}
+
+} // namespace
+
+Connection::Connection(int fd, const Server* server, const VirtualHostIndex* hosts,
+                       BufferPool* pool, WorkerStats* stats)
+    : _fd(fd), _listen_server(server), _hosts(hosts), _server(server),
+      _state(ConnectionState::READING_HEADERS),
+      _input(memoryOf(pool)), _parser(MAX_HEADER_SIZE), _head_length(0), _body_length(0),
+      _chunked(false), _body_done(false), _body_received(0), _head_claimed(false),
+      _streaming(false), _read_stopped(false), _close_after(false), _error_status(0),
+      _requests(0), _last_activity(Clock::now()), _head_start(_last_activity),
+      _arena(pool ? pool->getChunkSize() : Arena::DEFAULT_BLOCK_SIZE, memoryOf(pool)), _route(),
+      _stats(stats), _queued(0), _sent(0), _timings(), _timing_first(0), _timing_count(0) {
+}
+
+// --- TLS ---
+
+void Connection::startTls(const TlsContext& context) {
+    _tls.reset(new TlsSession(context, _fd));
+}
+
+bool Connection::isTls() const noexcept {
+    return _tls != NULL;
+}
+
+void Connection::shutdownTls() noexcept {
+    if (_tls)
+        _tls->shutdown();
+}
+
+// OK while the handshake waits on the socket; hasPendingOutput() asks for writability
+IoStatus Connection::continueHandshake() {
+    if (_tls->handshake() != 1)
+        return errno == EAGAIN ? IoStatus::OK : IoStatus::ERROR;
+    _last_activity = Clock::now();
+    if (_stats) {
+        _stats->tls_handshakes.add();
+        if (_tls->isResumed())
+            _stats->tls_resumed.add();
+        if (_tls->isKernelSend())
+            _stats->tls_kernel_send.add();
+    }
+    return IoStatus::OK;
+}
+
+// Bytes OpenSSL decrypted but not handed out yet; the socket no longer reports them
+bool Connection::hasTlsPending() const noexcept {
+    return _tls && _tls->hasPending();
+}
+
+ssize_t Connection::receive(char* buffer, std::size_t size) {
+    if (_tls)
+        return _tls->read(buffer, size);
+    return recv(_fd, buffer, size, 0);
+}
+
+ssize_t Connection::sendBytes(const void* buffer, std::size_t size) {
+    if (_tls)
+        return _tls->write(buffer, size);
+    return send(_fd, buffer, size, MSG_NOSIGNAL);
+}
+
+// OpenSSL has no gather write: small chunks are packed into one record instead of one each
+ssize_t Connection::sendTlsRecord(const struct iovec* iov, std::size_t count) {
+    if (count == 1 || iov[0].iov_len >= TLS_RECORD)
+        return _tls->write(iov[0].iov_base, iov[0].iov_len);
+    char        record[TLS_RECORD];
+    std::size_t used = 0;
+    for (std::size_t i = 0; i < count && used < sizeof(record); ++i) {
+        const std::size_t take = std::min(iov[i].iov_len, sizeof(record) - used);
+        std::memcpy(record + used, iov[i].iov_base, take);
+        used += take;
+    }
+    // A retry after EAGAIN packs the same queue again, so OpenSSL gets the same bytes
+    return _tls->write(record, used);
+}
+
+// --- Socket I/O ---
+
+IoStatus Connection::readFromSocket() {
+    const std::size_t limit = MAX_HEADER_SIZE + _server->getClientMaxBodySize() + READ_CHUNK;
+
+    if (_tls && !_tls->isEstablished()) {
+        const IoStatus status = continueHandshake();
+        if (status != IoStatus::OK || !_tls->isEstablished())
+            return status;
+    }
+    while (true) {
+        // Resumed once the body consumer caught up, or the head says the body is not streamed.
+        // A record OpenSSL started decrypting is read whole, as no event will announce the rest
+        if ((_streaming || _head_length == 0) && _input.size() >= STREAM_BUFFER &&
+            !hasTlsPending()) {
+            _read_stopped = true;
+            return IoStatus::OK;
+        }
+        // Top up a partly filled buffer instead of doubling it, so it stays one pool chunk
+        char*   dst   = _input.prepare(_input.capacity() ? READ_MIN_FREE : READ_CHUNK);
+        ssize_t bytes = receive(dst, _input.writableSize());
+        if (bytes > 0) {
+            _last_activity = Clock::now();
+            if (_input.empty() && _head_length == 0 && !_streaming) {
+                _head_start = _last_activity; // A new request begins
+                WEBSERV_PROBE1(request_start, _fd);
+                if (_tracing)
+                    _tracing->reading.mark(TracePhase::HEAD_START, _head_start);
+            }
+            _input.commit(static_cast<std::size_t>(bytes));
+            if (_stats)
+                _stats->bytes_in.add(static_cast<std::uint64_t>(bytes));
+            if (_chunked && !_body_done) {
+                decodeChunks(); // Keeps the buffer at head, decoded body, partial chunk line
+                if (_error_status)
+                    return IoStatus::OK;
+            }
+            if (_input.size() > limit) {
+                // The client sends more than any acceptable request; stop buffering
+                fail(413);
+                return IoStatus::OK;
+            }
+            continue;
+        }
+        if (bytes == 0)
+            return IoStatus::CLOSED;
+        if (errno == EINTR)
+            continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            _read_stopped = false;
+            return IoStatus::OK;
+        }
+        return IoStatus::ERROR;
+    }
+}
+
+IoStatus Connection::writeToSocket() {
+    if (_tls && !_tls->isEstablished()) {
+        const IoStatus status = continueHandshake();
+        if (status != IoStatus::OK)
+            return status;
+        if (!_tls->isEstablished())
+            return _tls->wantsWrite() ? IoStatus::AGAIN : IoStatus::OK;
+    }
+    while (!_output.empty()) {
+        const IoStatus status =
+            _output.front().file ? sendFileChunk(_output.front()) : sendMemoryChunks();
+        if (status != IoStatus::OK)
+            return status;
+    }
+    if (_close_after)
+        _state = ConnectionState::CLOSING;
+    else
+        _state = _head_length || _streaming ? ConnectionState::READING_BODY
+                                            : ConnectionState::READING_HEADERS;
+    return IoStatus::OK;
+}
+
+// Gather the in-memory chunks at the front of the queue into one sendmsg()
+IoStatus Connection::sendMemoryChunks() {
+    struct iovec iov[MAX_IOVECS];
+    std::size_t  count = 0;
+    for (std::deque<OutputChunk>::iterator it = _output.begin();
+         it != _output.end() && !it->file && count < MAX_IOVECS; ++it, ++count) {
+        const char* bytes   = it->bytes ? it->bytes : it->data.data();
+        iov[count].iov_base = const_cast<char*>(bytes) + it->offset;
+        iov[count].iov_len  = it->remaining;
+    }
+
+    struct msghdr msg = {};
+    msg.msg_iov       = iov;
+    msg.msg_iovlen    = static_cast<decltype(msg.msg_iovlen)>(count);
+    ssize_t sent;
+    do {
+        // With kTLS the kernel encrypts, so the gather write stays as it is
+        sent = _tls && !_tls->isKernelSend() ? sendTlsRecord(iov, count)
+                                             : sendmsg(_fd, &msg, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    if (sent < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return IoStatus::AGAIN;
+        return IoStatus::ERROR;
+    }
+    _last_activity = Clock::now();
+    countSent(static_cast<std::size_t>(sent), _last_activity);
+
+    std::size_t left = static_cast<std::size_t>(sent);
+    while (left > 0) {
+        OutputChunk& chunk = _output.front();
+        if (left < chunk.remaining) {
+            chunk.offset += static_cast<off_t>(left);
+            chunk.remaining -= left;
+            break;
+        }
+        left -= chunk.remaining;
+        _output.pop_front();
+    }
+    return IoStatus::OK;
+}
+
+// Send a file range until it is done or the socket is full
+IoStatus Connection::sendFileChunk(OutputChunk& chunk) {
+    while (chunk.remaining > 0) {
+        const std::size_t want = std::min(chunk.remaining, SENDFILE_CHUNK);
+        ssize_t           sent;
+#if defined(__linux__)
+        // Page cache to socket buffer, no copy through user space; kTLS encrypts on the way
+        if (!_tls || _tls->isKernelSend())
+            sent = sendfile(_fd, chunk.file->getFd(), &chunk.offset, want);
+        else
+#endif
+        {
+            // One bounce through a stack buffer: no sendfile(), or TLS in user space
+            char          buf[READ_CHUNK];
+            const ssize_t got =
+                pread(chunk.file->getFd(), buf, std::min(want, sizeof(buf)), chunk.offset);
+            if (got < 0 && errno == EINTR)
+                continue;
+            if (got <= 0)
+                return IoStatus::ERROR;
+            sent = sendBytes(buf, static_cast<std::size_t>(got));
+            if (sent > 0)
+                chunk.offset += sent;
+        }
+        if (sent < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return IoStatus::AGAIN;
+            return IoStatus::ERROR;
+        }
+        if (sent == 0)
+            return IoStatus::ERROR; // File shrank since it was stat'ed
+        chunk.remaining -= static_cast<std::size_t>(sent);
+        _last_activity = Clock::now();
+        countSent(static_cast<std::size_t>(sent), _last_activity);
+    }
+    _output.pop_front();
+    return IoStatus::OK;
+}
+
+// Responses are timed in queue order; each send can start one and complete several
+void Connection::countSent(std::size_t bytes, Clock::time_point now) noexcept {
+    _sent += bytes;
+    if (_stats)
+        _stats->bytes_out.add(bytes);
+    while (_timing_count) {
+        Timing& timing = _timings[_timing_first];
+        if (!timing.started && _sent > timing.begin) {
+            WEBSERV_PROBE1(response_start, _fd);
+            if (_stats)
+                _stats->first_byte.record(now - timing.start);
+            if (timing.traced)
+                _tracing->queued.front().mark(TracePhase::FIRST_SENT, now);
+            timing.started = true;
+        }
+        if (_sent < timing.end)
+            break;
+        WEBSERV_PROBE3(request_done, _fd, timing.status,
+                       std::chrono::nanoseconds(now - timing.start).count());
+        if (_stats)
+            _stats->total.record(now - timing.start);
+        if (timing.traced)
+            finishTrace(now);
+        _timing_first = (_timing_first + 1) % MAX_PIPELINE;
+        --_timing_count;
+    }
+}
+
+// --- Tracing ---
+
+void Connection::traceSlowRequests(Clock::duration threshold) {
+    if (threshold <= Clock::duration::zero()) {
+        _tracing.reset();
+        for (Timing& timing : _timings)
+            timing.traced = false;
+        return;
+    }
+    if (!_tracing) {
+        _tracing.reset(new Tracing());
+        // Until the first byte arrives, the head start is still the creation time
+        if (_requests == 0 && _input.empty())
+            _tracing->reading.mark(TracePhase::ACCEPTED, _head_start);
+    }
+    _tracing->threshold = threshold;
+}
+
+void Connection::markRouted() noexcept {
+    WEBSERV_PROBE1(request_routed, _fd);
+    mark(TracePhase::ROUTED);
+}
+
+void Connection::mark(TracePhase phase) noexcept {
+    if (_tracing)
+        _tracing->reading.mark(phase, Clock::now());
+}
+
+// The oldest traced response is sent: log its phases if it took too long
+void Connection::finishTrace(Clock::time_point now) noexcept {
+    RequestTrace& trace = _tracing->queued.front();
+    trace.mark(TracePhase::DONE, now);
+    if (trace.elapsed() >= _tracing->threshold) {
+        if (_stats)
+            _stats->slow_requests.add();
+        char line[Logger::RECORD_SIZE];
+        trace.format(line, sizeof(line));
+        LOG_WARN("Slow request on fd %d: %s", _fd, line);
+    }
+    _tracing->queued.pop_front();
+}
+
+// --- Request framing ---
+
+bool Connection::parseInput() {
+    // Once the connection is going to close, pipelined leftovers are ignored
+    if (_close_after || _state == ConnectionState::CLOSING || _streaming)
+        return false;
+
+    // A head length of zero means the next request's head has not been parsed yet;
+    // this also holds while earlier responses are still being written (pipelining)
+    if (_head_length == 0) {
+        HttpRequestParser::Result result = _parser.parse(_input.view(), _request);
+        if (result == HttpRequestParser::Result::INCOMPLETE)
+            return false;
+        if (result == HttpRequestParser::Result::ERROR) {
+            fail(_parser.getErrorStatus());
+            return false;
+        }
+        // Limits below come from the virtual host named by the request
+        _request.bind(_input.data());
+        WEBSERV_PROBE3(request_parsed, _fd, _request.getTarget().data(),
+                       _request.getTarget().size());
+        if (_tracing) {
+            mark(TracePhase::HEAD_PARSED);
+            _tracing->reading.describe(_request.getMethodName(), _request.getTarget());
+        }
+        _server = _listen_server;
+        if (_hosts) {
+            if (const Server* vhost = _hosts->find(_listen_server->getPort(), _request.getHost()))
+                _server = vhost;
+        }
+        WEBSERV_PROBE2(request_server, _fd, _server->getPort());
+        mark(TracePhase::SERVER);
+        // Known lengths are checked before any body byte is read; chunked ones as they arrive
+        if (_request.getContentLength() > _server->getClientMaxBodySize()) {
+            fail(413);
+            return false;
+        }
+        _head_length = _parser.consumed();
+        _chunked     = _request.isChunked();
+        _body_length = _chunked ? 0 : _request.getContentLength();
+        if (_state != ConnectionState::WRITING)
+            _state = ConnectionState::READING_BODY;
+    }
+    if (_chunked) {
+        decodeChunks();
+        if (!_body_done)
+            return false;
+    } else if (_input.size() < _head_length + _body_length) {
+        return false;
+    }
+
+    // The buffer may have moved while the body was read; re-anchor the slices
+    _request.bind(_input.data());
+    return true;
+}
+
+std::string_view Connection::requestHead() const {
+    return _input.view().substr(0, _head_length);
+}
+
+std::string_view Connection::requestBody() const {
+    return _input.view().substr(_head_length, _body_length);
+}
+
+bool Connection::claimHead() noexcept {
+    if (_head_length == 0 || _head_claimed)
+        return false;
+    _head_claimed = true;
+    return true;
+}
+
+void Connection::streamBody() {
+    // The client holds the body back until told to go on (RFC 9110, section 10.1.1)
+    const bool has_body = _chunked ? !_body_done : _input.size() < _head_length + _body_length;
+    const bool http11   = _request.getVersionMajor() > 1 ||
+                          (_request.getVersionMajor() == 1 && _request.getVersionMinor() >= 1);
+    if (has_body && http11 && iequals(_request.getHeader("Expect"), "100-continue"))
+        queueBorrowed("HTTP/1.1 100 Continue\r\n\r\n");
+    _input.consume(_head_length);
+    _head_length = 0;
+    _streaming   = true;
+}
+
+bool Connection::isStreamingBody() const noexcept {
+    return _streaming;
+}
+
+std::string_view Connection::bodyData() const noexcept {
+    return _input.view().substr(0, _body_length);
+}
+
+void Connection::consumeBody(std::size_t count) noexcept {
+    _input.consume(count);
+    _body_length -= count;
+}
+
+std::size_t Connection::getBodyRemaining() const noexcept {
+    return _body_length;
+}
+
+bool Connection::isBodyComplete() const noexcept {
+    return _body_length == 0 && (!_chunked || _body_done);
+}
+
+bool Connection::isInputPaused() const noexcept {
+    return _streaming && _input.size() >= STREAM_BUFFER;
+}
+
+bool Connection::takeReadStopped() noexcept {
+    const bool stopped = _read_stopped;
+    _read_stopped      = false;
+    return stopped;
+}
+
+void Connection::finishRequest() {
+    _input.consume(_head_length + _body_length);
+    _parser.reset();
+    _request.reset();
+    _head_length   = 0;
+    _body_length   = 0;
+    _chunked       = false;
+    _body_done     = false;
+    _body_received = 0;
+    _head_claimed  = false;
+    _streaming     = false;
+    _dechunk.reset();
+    _route.reset();
+    _head_start = _last_activity; // Pipelined bytes arrived by then at the latest
+    ++_requests;
+    if (_tracing) {
+        // Its response may be queued later, e.g. by a script; the next request starts now
+        _tracing->answering = _tracing->reading;
+        _tracing->reading.reset();
+        _tracing->reading.mark(TracePhase::HEAD_START, _head_start);
+    }
+    if (_state == ConnectionState::READING_BODY)
+        _state = ConnectionState::READING_HEADERS;
+}
+
+// Chunk data slides over the framing, so the decoded body stays contiguous behind the head
+void Connection::decodeChunks() noexcept {
+    const std::size_t start = _head_length + _body_length;
+    std::size_t       size  = _input.size() - start;
+    if (_body_done || size == 0)
+        return;
+    std::size_t                  consumed = 0;
+    const ChunkedDecoder::Result result   = _dechunk.decode(_input.data() + start, size, consumed);
+    _input.erase(start + size, consumed - size);
+    _body_length += size;
+    _body_received += size;
+    if (result == ChunkedDecoder::Result::ERROR)
+        fail(400);
+    else if (_body_received > _server->getClientMaxBodySize())
+        fail(413);
+    else if (result == ChunkedDecoder::Result::DONE)
+        _body_done = true;
+}
+
+void Connection::fail(int status) noexcept {
+    if (_stats)
+        _stats->parse_errors.add();
+    _error_status = status;
+    _close_after  = true;
+}
+
+// --- Output queue ---
+
+void Connection::queueOutput(std::string data) {
+    if (!data.empty()) {
+        OutputChunk chunk;
+        chunk.bytes     = NULL;
+        chunk.data      = std::move(data);
+        chunk.offset    = 0;
+        chunk.remaining = chunk.data.size();
+        _queued += chunk.remaining;
+        _output.push_back(std::move(chunk));
+    }
+    _state = ConnectionState::WRITING;
+}
+
+void Connection::queueShared(std::shared_ptr<const std::string> buffer, std::size_t offset,
+                             std::size_t length) {
+    const std::string_view bytes = std::string_view(*buffer).substr(offset, length);
+    queueBorrowed(bytes, std::move(buffer));
+}
+
+void Connection::queueBorrowed(std::string_view bytes, std::shared_ptr<const void> owner) {
+    if (!bytes.empty()) {
+        OutputChunk chunk;
+        chunk.owner     = std::move(owner);
+        chunk.bytes     = bytes.data();
+        chunk.offset    = 0;
+        chunk.remaining = bytes.size();
+        _queued += chunk.remaining;
+        _output.push_back(std::move(chunk));
+    }
+    _state = ConnectionState::WRITING;
+}
+
+void Connection::queueFile(std::shared_ptr<const CachedFile> file, off_t offset,
+                           std::size_t length) {
+    if (length > 0) {
+        OutputChunk chunk;
+        chunk.bytes     = NULL;
+        chunk.file      = std::move(file);
+        chunk.offset    = offset;
+        chunk.remaining = length;
+        _queued += length;
+        _output.push_back(std::move(chunk));
+    }
+    _state = ConnectionState::WRITING;
+}
+
+void Connection::queueResponse(HttpResponse& response, bool head_only) {
+    const std::uint64_t    begin    = _queued;
+    HttpResponse::Segments segments = response.takeSegments(head_only);
+    for (HttpResponse::Segment& segment : segments) {
+        if (segment.file)
+            queueFile(std::move(segment.file), segment.offset, segment.length);
+        else if (!segment.bytes.empty())
+            queueBorrowed(segment.bytes, std::move(segment.owner));
+        else
+            queueOutput(std::move(segment.text));
+    }
+    const int status = response.getStatus();
+    WEBSERV_PROBE2(response_queued, _fd, status);
+    if (_stats)
+        _stats->countResponse(status);
+    if (!_stats && !_tracing)
+        return;
+    // A response queued before its request was finished belongs to the one being read
+    RequestTrace* trace = NULL;
+    if (_tracing)
+        trace = _tracing->answering.empty() ? &_tracing->reading : &_tracing->answering;
+    if (_queued > begin && _timing_count < MAX_PIPELINE) {
+        _timings[(_timing_first + _timing_count) % MAX_PIPELINE] = Timing{
+            _head_start, begin, _queued, static_cast<std::uint16_t>(status), false, trace != NULL};
+        ++_timing_count;
+        if (trace) {
+            trace->mark(TracePhase::RESPONDED, Clock::now());
+            trace->setStatus(status);
+            _tracing->queued.push_back(*trace);
+        }
+    }
+    if (trace)
+        trace->reset();
+}
+
+void Connection::closeAfterWrite() noexcept {
+    _close_after = true;
+}
+
+bool Connection::hasPendingOutput() const noexcept {
+    return !_output.empty() || (_tls && !_tls->isEstablished() && _tls->wantsWrite());
+}
+
+bool Connection::shouldClose() const noexcept {
+    return _close_after;
+}
+
+int Connection::getErrorStatus() const noexcept {
+    return _error_status;
+}
+
+int Connection::takeErrorStatus() noexcept {
+    const int status = _error_status;
+    _error_status    = 0;
+    return status;
+}
+
+bool Connection::wantsKeepAlive() const noexcept {
+    return _request.isKeepAlive();
+}
+
+const HttpRequest& Connection::getRequest() const noexcept {
+    return _request;
+}
+
+bool Connection::isPipelineFull() const noexcept {
+    return _output.size() >= MAX_PIPELINE;
+}
+
+std::size_t Connection::getRequestCount() const noexcept {
+    return _requests;
+}
+
+Connection::Clock::time_point Connection::getLastActivity() const noexcept {
+    return _last_activity;
+}
+
+Connection::Clock::time_point Connection::getHeadStart() const noexcept {
+    return _head_start;
+}
+
+bool Connection::hasBufferedInput() const noexcept {
+    return !_input.empty();
+}
+
+// --- Accessors ---
+
+Arena& Connection::getArena() noexcept {
+    return _arena;
+}
+
+RequestRoute& Connection::getRoute() noexcept {
+    return _route;
+}
+
+bool Connection::releaseIdleMemory() noexcept {
+    if (_head_length != 0 || _streaming || !_output.empty() || !_input.release())
+        return false;
+    _arena.release();
+    return true;
+}
+
+int Connection::getFd() const noexcept {
+    return _fd;
+}
+
+const Server* Connection::getServer() const noexcept {
+    return _server;
+}
+
+// Only between requests: _server must stay valid until the current one is answered
+bool Connection::rebind(const Server* server, const VirtualHostIndex* hosts) noexcept {
+    if (_head_length != 0 || _streaming)
+        return false;
+    _listen_server = server;
+    _hosts         = hosts;
+    _server        = server;
+    return true;
+}
+
+ConnectionState Connection::getState() const noexcept {
+    return _state;
+}
+
+void Connection::setState(ConnectionState state) noexcept {
+    _state = state;
+}
@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   EpollManager.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:00:35 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:00:35 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    EpollManager.cpp
+ * @brief   Implements the edge-triggered epoll event backend.
+ *
+ * @ingroup network
+ */
+
+#include "network/EpollManager.hpp"
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t MIN_EVENTS = 64; ///< Initial size of the kernel output buffer.
+
+std::uint32_t toEpoll(std::uint32_t interest) {
+    std::uint32_t mask = EPOLLET | EPOLLRDHUP;
+    if (interest & PollManager::EVENT_READ)
+        mask |= EPOLLIN;
+    if (interest & PollManager::EVENT_WRITE)
+        mask |= EPOLLOUT;
+    return mask;
+}
+
+std::uint32_t fromEpoll(std::uint32_t mask) {
+    std::uint32_t events = 0;
+    if (mask & EPOLLIN)
+        events |= PollManager::EVENT_READ;
+    if (mask & EPOLLOUT)
+        events |= PollManager::EVENT_WRITE;
+    if (mask & EPOLLERR)
+        events |= PollManager::EVENT_ERROR;
+    if (mask & (EPOLLHUP | EPOLLRDHUP))
+        events |= PollManager::EVENT_HUP;
+    return events;
+}
+
+} // namespace
+
+EpollManager::EpollManager() : _epoll_fd(epoll_create1(EPOLL_CLOEXEC)), _watched(0) {
+    if (_epoll_fd < 0)
+        throw PollError("epoll_create1() failed: " + std::string(strerror(errno)));
+    _events.resize(MIN_EVENTS);
+}
+
+EpollManager::~EpollManager() {
+    close(_epoll_fd);
+}
+
+void EpollManager::control(int op, int fd, std::uint32_t interest) {
+    epoll_event ev{};
+    ev.events  = toEpoll(interest);
+    ev.data.fd = fd;
+    if (epoll_ctl(_epoll_fd, op, fd, &ev) < 0)
+        throw PollError("epoll_ctl() failed on fd " + std::to_string(fd) + ": " +
+                        strerror(errno));
+}
+
+void EpollManager::add(int fd, std::uint32_t interest) {
+    control(EPOLL_CTL_ADD, fd, interest);
+    ++_watched;
+}
+
+void EpollManager::modify(int fd, std::uint32_t interest) {
+    control(EPOLL_CTL_MOD, fd, interest);
+}
+
+void EpollManager::remove(int fd) noexcept {
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr) == 0 && _watched > 0)
+        --_watched;
+}
+
+int EpollManager::wait(std::vector<IoEvent>& ready, int timeout_ms) {
+    ready.clear();
+    // Let the output buffer follow the number of watched descriptors so a busy
+    // loop can collect every ready socket in a single syscall.
+    if (_events.size() < _watched)
+        _events.resize(_watched);
+
+    int n = epoll_wait(_epoll_fd, _events.data(), static_cast<int>(_events.size()), timeout_ms);
+    if (n < 0) {
+        if (errno == EINTR)
+            return 0;
+        throw PollError("epoll_wait() failed: " + std::string(strerror(errno)));
+    }
+    for (int i = 0; i < n; ++i) {
+        const epoll_event& ev = _events[static_cast<std::size_t>(i)];
+        ready.push_back(IoEvent{ev.data.fd, fromEpoll(ev.events)});
+    }
+    return n;
+}
+
+const char* EpollManager::name() const noexcept {
+    return "epoll";
+}
+
+#endif
@@ -0,0 +1,131 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   KqueueManager.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:00:35 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:00:35 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    KqueueManager.cpp
+ * @brief   Implements the kqueue event backend.
+ *
+ * @ingroup network
+ */
+
+#include "network/KqueueManager.hpp"
+
+#if defined(WEBSERV_HAVE_KQUEUE)
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t MIN_EVENTS = 64; ///< Initial size of the kernel output buffer.
+
+} // namespace
+
+KqueueManager::KqueueManager() : _kqueue_fd(kqueue()), _watched(0) {
+    if (_kqueue_fd < 0)
+        throw PollError("kqueue() failed: " + std::string(strerror(errno)));
+    _events.resize(MIN_EVENTS);
+}
+
+KqueueManager::~KqueueManager() {
+    close(_kqueue_fd);
+}
+
+// Translate an interest transition into EV_ADD / EV_DELETE changes, one per filter
+void KqueueManager::apply(int fd, std::uint32_t previous, std::uint32_t interest) {
+    struct kevent changes[2];
+    int           count = 0;
+    const std::uintptr_t ident = static_cast<std::uintptr_t>(fd);
+
+    if ((interest ^ previous) & EVENT_READ) {
+        EV_SET(&changes[count++], ident, EVFILT_READ,
+               (interest & EVENT_READ) ? (EV_ADD | EV_CLEAR) : EV_DELETE, 0, 0, nullptr);
+    }
+    if ((interest ^ previous) & EVENT_WRITE) {
+        EV_SET(&changes[count++], ident, EVFILT_WRITE,
+               (interest & EVENT_WRITE) ? (EV_ADD | EV_CLEAR) : EV_DELETE, 0, 0, nullptr);
+    }
+    if (count > 0 && kevent(_kqueue_fd, changes, count, nullptr, 0, nullptr) < 0)
+        throw PollError("kevent() failed on fd " + std::to_string(fd) + ": " + strerror(errno));
+}
+
+void KqueueManager::add(int fd, std::uint32_t interest) {
+    const std::size_t slot = static_cast<std::size_t>(fd);
+    if (slot >= _interest.size())
+        _interest.resize(slot + 1, 0);
+    apply(fd, 0, interest);
+    _interest[slot] = interest;
+    ++_watched;
+}
+
+void KqueueManager::modify(int fd, std::uint32_t interest) {
+    const std::size_t slot = static_cast<std::size_t>(fd);
+    if (slot >= _interest.size())
+        throw PollError("kevent(): fd " + std::to_string(fd) + " is not registered");
+    apply(fd, _interest[slot], interest);
+    _interest[slot] = interest;
+}
+
+void KqueueManager::remove(int fd) noexcept {
+    const std::size_t slot = static_cast<std::size_t>(fd);
+    if (slot >= _interest.size())
+        return;
+    try {
+        apply(fd, _interest[slot], 0);
+    } catch (const PollError&) {
+        // The filter may already be gone if the peer closed first; nothing to undo.
+    }
+    _interest[slot] = 0;
+    if (_watched > 0)
+        --_watched;
+}
+
+int KqueueManager::wait(std::vector<IoEvent>& ready, int timeout_ms) {
+    ready.clear();
+    if (_events.size() < _watched)
+        _events.resize(_watched);
+
+    timespec  ts{};
+    timespec* tsp = nullptr;
+    if (timeout_ms >= 0) {
+        ts.tv_sec  = timeout_ms / 1000;
+        ts.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000L;
+        tsp        = &ts;
+    }
+    int n = kevent(_kqueue_fd, nullptr, 0, _events.data(), static_cast<int>(_events.size()), tsp);
+    if (n < 0) {
+        if (errno == EINTR)
+            return 0;
+        throw PollError("kevent() wait failed: " + std::string(strerror(errno)));
+    }
+    for (int i = 0; i < n; ++i) {
+        const struct kevent& ev     = _events[static_cast<std::size_t>(i)];
+        std::uint32_t        events = 0;
+        if (ev.filter == EVFILT_READ)
+            events |= EVENT_READ;
+        else if (ev.filter == EVFILT_WRITE)
+            events |= EVENT_WRITE;
+        if (ev.flags & EV_EOF)
+            events |= EVENT_HUP;
+        if (ev.flags & EV_ERROR)
+            events |= EVENT_ERROR;
+        ready.push_back(IoEvent{static_cast<int>(ev.ident), events});
+    }
+    return static_cast<int>(ready.size());
+}
+
+const char* KqueueManager::name() const noexcept {
+    return "kqueue";
+}
+
+#endif
@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PollFallbackManager.cpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:00:35 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:00:35 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    PollFallbackManager.cpp
+ * @brief   Implements the portable poll() event backend.
+ *
+ * @ingroup network
+ */
+
+#include "network/PollFallbackManager.hpp"
+#include <cerrno>
+#include <cstring>
+
+namespace {
+
+short toPoll(std::uint32_t interest) {
+    short mask = 0;
+    if (interest & PollManager::EVENT_READ)
+        mask = static_cast<short>(mask | POLLIN);
+    if (interest & PollManager::EVENT_WRITE)
+        mask = static_cast<short>(mask | POLLOUT);
+    return mask;
+}
+
+std::uint32_t fromPoll(short mask) {
+    std::uint32_t events = 0;
+    if (mask & POLLIN)
+        events |= PollManager::EVENT_READ;
+    if (mask & POLLOUT)
+        events |= PollManager::EVENT_WRITE;
+    if (mask & (POLLERR | POLLNVAL))
+        events |= PollManager::EVENT_ERROR;
+    if (mask & POLLHUP)
+        events |= PollManager::EVENT_HUP;
+    return events;
+}
+
+} // namespace
+
+void PollFallbackManager::add(int fd, std::uint32_t interest) {
+    if (fd < 0)
+        throw PollError("poll: invalid fd " + std::to_string(fd));
+    const std::size_t key = static_cast<std::size_t>(fd);
+    if (key >= _slot.size())
+        _slot.resize(key + 1, NO_SLOT);
+    if (_slot[key] != NO_SLOT)
+        throw PollError("poll: fd " + std::to_string(fd) + " is already registered");
+    _slot[key] = static_cast<int>(_fds.size());
+    _fds.push_back(pollfd{fd, toPoll(interest), 0});
+}
+
+void PollFallbackManager::modify(int fd, std::uint32_t interest) {
+    const std::size_t key = static_cast<std::size_t>(fd);
+    if (fd < 0 || key >= _slot.size() || _slot[key] == NO_SLOT)
+        throw PollError("poll: fd " + std::to_string(fd) + " is not registered");
+    _fds[static_cast<std::size_t>(_slot[key])].events = toPoll(interest);
+}
+
+void PollFallbackManager::remove(int fd) noexcept {
+    const std::size_t key = static_cast<std::size_t>(fd);
+    if (fd < 0 || key >= _slot.size() || _slot[key] == NO_SLOT)
+        return;
+
+    // Swap-and-pop keeps the array dense without shifting every later entry
+    const std::size_t hole = static_cast<std::size_t>(_slot[key]);
+    const pollfd      last = _fds.back();
+    _fds[hole]             = last;
+    _slot[static_cast<std::size_t>(last.fd)] = static_cast<int>(hole);
+    _fds.pop_back();
+    _slot[key] = NO_SLOT;
+}
+
+int PollFallbackManager::wait(std::vector<IoEvent>& ready, int timeout_ms) {
+    ready.clear();
+    int n = poll(_fds.data(), static_cast<nfds_t>(_fds.size()), timeout_ms);
+    if (n < 0) {
+        if (errno == EINTR)
+            return 0;
+        throw PollError("poll() failed: " + std::string(strerror(errno)));
+    }
+    for (std::size_t i = 0; i < _fds.size() && ready.size() < static_cast<std::size_t>(n); ++i) {
+        if (_fds[i].revents != 0)
+            ready.push_back(IoEvent{_fds[i].fd, fromPoll(_fds[i].revents)});
+    }
+    return static_cast<int>(ready.size());
+}
+
+const char* PollFallbackManager::name() const noexcept {
+    return "poll";
+}
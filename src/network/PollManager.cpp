@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PollManager.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: irychkov <irychkov@student.hive.fi>        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/05/03 13:51:20 by irychkov          #+#    #+#             */
+/*   Updated: 2025/05/10 11:12:40 by irychkov         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    PollManager.cpp
+ * @brief   Implements the PollManager factory and error type.
+ *
+ * @details Picks the concrete backend at runtime among those compiled for the
+ * current platform: epoll on Linux, kqueue on BSD/macOS, poll() everywhere.
+ * io_uring is never picked automatically; it must be asked for by name.
+ *
+ * @ingroup network
+ */
+
+#include "network/PollManager.hpp"
+#include "network/EpollManager.hpp"
+#include "network/KqueueManager.hpp"
+#include "network/PollFallbackManager.hpp"
+#include "network/UringManager.hpp"
+
+PollManager::PollError::PollError(const std::string& msg) : _msg(msg) {
+}
+
+const char* PollManager::PollError::what() const throw() {
+    return _msg.c_str();
+}
+
+std::unique_ptr<PollManager> PollManager::create(PollBackend backend) {
+    switch (backend) {
+    case PollBackend::AUTO:
+#if defined(__linux__)
+        return std::make_unique<EpollManager>();
+#elif defined(WEBSERV_HAVE_KQUEUE)
+        return std::make_unique<KqueueManager>();
+#else
+        return std::make_unique<PollFallbackManager>();
+#endif
+    case PollBackend::EPOLL:
+#if defined(__linux__)
+        return std::make_unique<EpollManager>();
+#else
+        throw PollError("epoll backend is not available on this platform");
+#endif
+    case PollBackend::KQUEUE:
+#if defined(WEBSERV_HAVE_KQUEUE)
+        return std::make_unique<KqueueManager>();
+#else
+        throw PollError("kqueue backend is not available on this platform");
+#endif
+    case PollBackend::POLL:
+        return std::make_unique<PollFallbackManager>();
+    case PollBackend::IO_URING:
+#if defined(__linux__) && defined(WEBSERV_HAVE_IO_URING)
+        return std::make_unique<UringManager>();
+#else
+        throw PollError("io_uring backend was not compiled in (WEBSERV_IO_URING)");
+#endif
+    }
+    throw PollError("unknown event backend");
+}
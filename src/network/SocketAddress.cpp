@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SocketAddress.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:25:50 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:25:50 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    SocketAddress.cpp
+ * @brief   Implements parseSocketAddress().
+ *
+ * @ingroup network
+ */
+
+#include "network/SocketAddress.hpp"
+#include "utils/StringUtils.hpp"
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <string>
+#include <sys/un.h>
+
+bool parseSocketAddress(std::string_view address, sockaddr_storage& addr, socklen_t& length) {
+    std::memset(&addr, 0, sizeof(addr));
+    if (address.compare(0, 5, "unix:") == 0) {
+        sockaddr_un&           un   = reinterpret_cast<sockaddr_un&>(addr);
+        const std::string_view path = address.substr(5);
+        if (path.empty() || path.size() >= sizeof(un.sun_path))
+            return false;
+        un.sun_family = AF_UNIX;
+        std::memcpy(un.sun_path, path.data(), path.size());
+        length = static_cast<socklen_t>(sizeof(sockaddr_un));
+        return true;
+    }
+    const std::size_t colon = address.rfind(':');
+    std::size_t       port  = 0;
+    if (colon == std::string_view::npos || !parseSize(address.substr(colon + 1), port) ||
+        port == 0 || port > 65535)
+        return false;
+    std::string host(address.substr(0, colon));
+    if (host == "localhost")
+        host = "127.0.0.1";
+    sockaddr_in& in = reinterpret_cast<sockaddr_in&>(addr);
+    in.sin_family   = AF_INET;
+    in.sin_port     = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, host.c_str(), &in.sin_addr) != 1)
+        return false; // Names would need a blocking resolver
+    length = static_cast<socklen_t>(sizeof(sockaddr_in));
+    return true;
+}
@@ -6,159 +6,1460 @@
 /*   By: irychkov <irychkov@student.hive.fi>        +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/05/03 13:51:20 by irychkov          #+#    #+#             */
-/*   Updated: 2025/05/03 15:04:35 by irychkov         ###   ########.fr       */
+/*   Updated: 2025/05/10 11:12:40 by irychkov         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "network/SocketManager.hpp"
-#include <sstream> // For stringstream, we will remove it later
+#include "http/HeaderFields.hpp"
+#include "utils/CpuAffinity.hpp"
+#include "utils/Logger.hpp"
+#include "utils/Probes.hpp"
+#include "utils/StringUtils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <ctime>
+#include <csignal>
+#include <cstring>
+#include <iterator>
+#include <set>
+#include <utility>
 
-// Signal handler for exiting the server
-static volatile sig_atomic_t running = 1;
+namespace {
 
-static void signalHandler(int signum) {
-	if (signum == SIGINT)
-		running = 0;
+constexpr std::size_t CGI_READ_CHUNK = 16384; ///< Bytes requested per read() from a script.
+constexpr long        CGI_EXIT_GRACE = 5;     ///< Seconds a finished script may take to exit.
+constexpr int         ACCEPT_BATCH   = 64;    ///< Clients accepted per listener event.
+
+constexpr std::chrono::seconds FD_RETRY(1); ///< Wait of listeners out of descriptors.
+
+// Responses that never carry a body, whatever the script writes after its head
+bool hasNoBody(int status, bool head_only) noexcept {
+    return head_only || status < 200 || status == 204 || status == 304;
+}
+
+// Only complete text pages the script did not encode itself, and only within the budget
+ContentCoding cgiCoding(const Location& location, unsigned accepted, const CgiOutputParser& parser,
+                        CompressionBudget& budget) {
+    const unsigned wanted = location.getCompression() & accepted & availableCodings();
+    if (!wanted || parser.getStatus() != 200)
+        return ContentCoding::IDENTITY;
+    if (parser.hasContentLength() && parser.getContentLength() < location.getCompressMinLength())
+        return ContentCoding::IDENTITY;
+    bool compressible = false;
+    for (const CgiOutputParser::Field& field : parser.getFields()) {
+        if (iequals(field.first, "Content-Encoding"))
+            return ContentCoding::IDENTITY;
+        if (iequals(field.first, "Content-Type"))
+            compressible = isCompressibleType(field.second);
+    }
+    if (!compressible || !budget.allows())
+        return ContentCoding::IDENTITY;
+    return preferredCoding(wanted);
+}
+
+// Non-blocking and close-on-exec from the start, in one system call where available
+int acceptClient(int listen_fd) noexcept {
+#if defined(__linux__)
+    return accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+    const int fd = accept(listen_fd, NULL, NULL);
+    if (fd >= 0 && (fcntl(fd, F_SETFL, O_NONBLOCK) < 0 || fcntl(fd, F_SETFD, FD_CLOEXEC) < 0)) {
+        close(fd);
+        errno = ECONNABORTED; // Lost like a client that went away before being accepted
+        return -1;
+    }
+    return fd;
+#endif
+}
+
+// Persist unless the client opted out or this server's limits are reached
+bool keepsAlive(const Connection& conn) {
+    const Server& server = *conn.getServer();
+    return conn.wantsKeepAlive() && server.getKeepAliveTimeout() > 0 &&
+           conn.getRequestCount() + 1 < server.getKeepAliveRequests();
+}
+
+// Numeric address of a client, for X-Forwarded-For and REMOTE_ADDR
+std::string peerAddress(int fd) {
+    sockaddr_storage addr;
+    socklen_t        length = sizeof(addr);
+    char             text[INET6_ADDRSTRLEN];
+    if (getpeername(fd, reinterpret_cast<sockaddr*>(&addr), &length) < 0)
+        return std::string();
+    const void* raw = NULL;
+    if (addr.ss_family == AF_INET)
+        raw = &reinterpret_cast<const sockaddr_in&>(addr).sin_addr;
+    else if (addr.ss_family == AF_INET6)
+        raw = &reinterpret_cast<const sockaddr_in6&>(addr).sin6_addr;
+    if (!raw || !inet_ntop(addr.ss_family, raw, text, sizeof(text)))
+        return std::string();
+    return text;
 }
 
+// Servers sharing one address are virtual hosts behind a single listener
+std::string endpointOf(const Server& server) {
+    return server.getHost() + ":" + std::to_string(server.getPort());
+}
+
+} // namespace
+
 // Constructor: sets up sockets for each server defined in the config
-SocketManager::SocketManager(const std::vector<Server>& servers) {
-	signal(SIGINT, signalHandler);
-	setupSockets(servers);
+SocketManager::SocketManager(std::shared_ptr<const ConfigSnapshot> config, PollBackend backend,
+                             bool reuse_port, std::shared_ptr<StatsRegistry> stats,
+                             std::size_t stats_slot)
+    : _config(std::move(config)), _poller(PollManager::create(backend)),
+      _fastcgi(*_poller), _upstreams(*_poller), _active(0), _accepting(true),
+      _out_of_fds(false), _fd_retry(), _last_sweep(Connection::Clock::now()),
+      _reuse_port(reuse_port), _incoming_cpu(pinnedCpu()), _stopping(false),
+      _wake_fds{-1, -1}, _assets(_config->getAssetCacheSize()),
+      _compression(_config->getCompressCpuBudget()), _builder(_files, &_assets, &_compression),
+      _registry(stats ? std::move(stats) : StatsRegistry::create(1)),
+      _stats(&_registry->getWorker(stats_slot)), _config_clients(0), _reload_pending(false) {
+    // A restarted worker inherits the slot; its predecessor's clients are gone
+    _stats->closed.add(_stats->accepted.get() - _stats->closed.get());
+    signal(SIGPIPE, SIG_IGN); // A client vanishing mid-send must not kill the server
+    try {
+        setupWakePipe();
+        setupSockets();
+    } catch (...) {
+        closeListeners();
+        throw;
+    }
+    LOG_INFO("Event backend: %s", _poller->name());
 }
 
 // Destructor: closes all open file descriptors
 SocketManager::~SocketManager() {
-	for (size_t i = 0; i < _poll_fds.size(); ++i)
-		close(_poll_fds[i].fd);
+    for (size_t fd = 0; fd < _clients.size(); ++fd) {
+        if (_clients[fd].state != SlotState::FREE)
+            close(static_cast<int>(fd));
+    }
+    closeListeners();
+}
+
+// Close listening sockets and the wake-up pipe (also used when construction fails)
+void SocketManager::closeListeners() noexcept {
+    for (size_t i = 0; i < _listen_fds.size(); ++i)
+        close(_listen_fds[i]);
+    _listen_fds.clear();
+    for (int& fd : _wake_fds) {
+        if (fd >= 0)
+            close(fd);
+        fd = -1;
+    }
+}
+
+// The read end is polled like a listener; stop() writes one byte to it
+void SocketManager::setupWakePipe() {
+    if (pipe(_wake_fds) < 0)
+        throw SocketError("pipe() failed: " + std::string(strerror(errno)));
+    for (int fd : _wake_fds) {
+        if (fcntl(fd, F_SETFL, O_NONBLOCK) < 0 || fcntl(fd, F_SETFD, FD_CLOEXEC) < 0)
+            throw SocketError("fcntl() failed: " + std::string(strerror(errno)));
+    }
+    try {
+        _poller->add(_wake_fds[0], PollManager::EVENT_READ);
+    } catch (const PollManager::PollError& e) {
+        throw SocketError(e.what());
+    }
+}
+
+void SocketManager::stop() noexcept {
+    _stopping.store(true);
+    if (_wake_fds[1] >= 0) {
+        const char byte = 1;
+        ssize_t    ret  = write(_wake_fds[1], &byte, 1); // EAGAIN: a wake-up is already pending
+        (void)ret;
+    }
+}
+
+// Parsed off the loop; the loop only swaps pointers when it picks the snapshot up
+void SocketManager::reload(std::shared_ptr<const ConfigSnapshot> config) {
+    {
+        std::lock_guard<std::mutex> lock(_reload_mutex);
+        _pending = std::move(config);
+    }
+    _reload_pending.store(true);
+    if (_wake_fds[1] >= 0) {
+        const char byte = 1;
+        ssize_t    ret  = write(_wake_fds[1], &byte, 1);
+        (void)ret;
+    }
+}
+
+const std::shared_ptr<const ConfigSnapshot>& SocketManager::getConfig() const noexcept {
+    return _config;
+}
+
+const WorkerStats& SocketManager::getStats() const noexcept {
+    return *_stats;
 }
 
 // Custom exception for socket errors
 SocketManager::SocketError::SocketError(const std::string& msg) {
-	_msg = msg;
+    _msg = msg;
 }
 
 const char* SocketManager::SocketError::what() const throw() {
-	return (_msg.c_str());
+    return (_msg.c_str());
 }
 
-// Set up sockets for each server (host:port)
-void SocketManager::setupSockets(const std::vector<Server>& servers) {
-	for (size_t i = 0; i < servers.size(); ++i) {
-		int fd = socket(AF_INET, SOCK_STREAM, 0); // Create a TCP socket
-		if (fd < 0)
-			throw SocketError("socket() failed: " + std::string(strerror(errno)));
+// Set up one socket per distinct host:port; servers sharing one are virtual hosts
+void SocketManager::setupSockets() {
+    const std::vector<Server>& servers = _config->getServers();
+    std::set<std::string>      endpoints;
+    for (size_t i = 0; i < servers.size(); ++i) {
+        if (endpoints.insert(endpointOf(servers[i])).second)
+            openListener(servers[i]);
+    }
+}
+
+// Tuning only: a kernel or a capability missing costs latency, not service
+void SocketManager::setListenerOptions(int fd, const Server& server) {
+#if defined(SO_INCOMING_CPU)
+    // Among the SO_REUSEPORT group, prefer this loop for connections its CPU received
+    if (_reuse_port && _incoming_cpu >= 0 &&
+        setsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &_incoming_cpu, sizeof(_incoming_cpu)) < 0)
+        LOG_WARN("setsockopt(SO_INCOMING_CPU) failed: %s", strerror(errno));
+#endif
+    const int busy_poll = server.getBusyPoll();
+    if (busy_poll > 0) {
+#if defined(SO_BUSY_POLL)
+        // Raising it above net.core.busy_read needs CAP_NET_ADMIN
+        if (setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &busy_poll, sizeof(busy_poll)) < 0)
+            LOG_WARN("setsockopt(SO_BUSY_POLL) on %s failed: %s", endpointOf(server).c_str(),
+                     strerror(errno));
+#else
+        LOG_WARN("busy_poll is not supported on this platform");
+#endif
+    }
+}
 
-		int opt = 1; // To tell the OS: "I want to reuse this port immediately, even if it's in TIME_WAIT
-		if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
-			close(fd);
-			throw SocketError("setsockopt() failed: " + std::string(strerror(errno)));
-		}
+void SocketManager::openListener(const Server& server) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0); // Create a TCP socket
+    if (fd < 0)
+        throw SocketError("socket() failed: " + std::string(strerror(errno)));
 
-		if (fcntl(fd, F_SETFL, O_NONBLOCK) < 0) { // Make socket non-blocking
-			close(fd);
-			throw SocketError("fcntl() failed: " + std::string(strerror(errno)));
-		}
+    // To tell the OS: "I want to reuse this port immediately, even if it's in TIME_WAIT"
+    int opt = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
+        close(fd);
+        throw SocketError("setsockopt() failed: " + std::string(strerror(errno)));
+    }
+    if (_reuse_port) {
+#ifdef SO_REUSEPORT
+        // Every worker binds its own socket; the kernel spreads new connections
+        if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+            close(fd);
+            throw SocketError("setsockopt(SO_REUSEPORT) failed: " +
+                              std::string(strerror(errno)));
+        }
+#else
+        close(fd);
+        throw SocketError("SO_REUSEPORT is not supported on this platform");
+#endif
+    }
+    setListenerOptions(fd, server);
 
-		sockaddr_in addr;
-		addr.sin_family = AF_INET;
-		addr.sin_port = htons(servers[i].getPort()); // Convert port to network byte order
+    if (fcntl(fd, F_SETFL, O_NONBLOCK) < 0) { // Make socket non-blocking
+        close(fd);
+        throw SocketError("fcntl() failed: " + std::string(strerror(errno)));
+    }
 
-		// Convert hostname to IP address
-		if (servers[i].getHost() == "localhost")
-			addr.sin_addr.s_addr = inet_addr("127.0.0.1");
-		else
-			addr.sin_addr.s_addr = inet_addr(servers[i].getHost().c_str());
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port   = htons(static_cast<uint16_t>(server.getPort())); // Network byte order
 
-		if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0) { // Bind socket to IP:port
-			close(fd);
-			throw SocketError("bind() failed on " + servers[i].getHost() + ":" + std::to_string(servers[i].getPort()) + ": " + strerror(errno));
-		}
+    // Convert hostname to IP address
+    if (server.getHost() == "localhost")
+        addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    else
+        addr.sin_addr.s_addr = inet_addr(server.getHost().c_str());
 
-		if (listen(fd, SOMAXCONN) < 0) { // Start listening for incoming connections
-			close(fd);
-			throw SocketError("listen() failed: " + std::string(strerror(errno)));
-		}
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) { // Bind to IP:port
+        close(fd);
+        throw SocketError("bind() failed on " + endpointOf(server) + ": " + strerror(errno));
+    }
 
-		// Register fd in poll list
-		_poll_fds.push_back((pollfd){ fd, POLLIN, 0 });
-		_listen_map[fd] = servers[i]; // Map fd to its corresponding server
+    // Start listening; the kernel caps the backlog at its somaxconn
+    if (listen(fd, server.getListenBacklog()) < 0) {
+        close(fd);
+        throw SocketError("listen() failed: " + std::string(strerror(errno)));
+    }
 
-		std::cout << "Listening on " << servers[i].getHost() << ":" << servers[i].getPort() << std::endl;
-	}
+    // Register fd with the event backend; a paused loop adds it paused
+    try {
+        _poller->add(fd, _accepting ? PollManager::EVENT_READ : 0);
+    } catch (const PollManager::PollError& e) {
+        close(fd);
+        throw SocketError(e.what());
+    }
+    // Map fd to the port's default server; the snapshot owns the Server object
+    const size_t slot = static_cast<size_t>(fd);
+    if (slot >= _listeners.size())
+        _listeners.resize(slot + 1, NULL);
+    _listeners[slot] = _config->getHosts().getDefault(server.getPort());
+    _listen_fds.push_back(fd);
+    _endpoints.push_back(endpointOf(server));
+
+    LOG_INFO("Listening on %s:%d%s", server.getHost().c_str(), server.getPort(),
+             server.isSsl() ? " (ssl)" : "");
 }
 
-// Main server loop using poll
+// --- Reload ---
+
+// Runs between iterations: no event of this round refers to a listener closed here
+void SocketManager::applyReload() {
+    std::shared_ptr<const ConfigSnapshot> config;
+    {
+        std::lock_guard<std::mutex> lock(_reload_mutex);
+        config.swap(_pending);
+        _reload_pending.store(false);
+    }
+    if (!config || config == _config)
+        return;
+    if (_config_clients)
+        _retired.push_back(RetiredConfig{_config, _config_clients});
+    _config         = std::move(config);
+    _config_clients = 0;
+    _compression.setPercent(_config->getCompressCpuBudget());
+
+    // First server of each address still configured
+    const std::vector<Server>&                    servers = _config->getServers();
+    std::unordered_map<std::string, const Server*> wanted;
+    for (size_t i = 0; i < servers.size(); ++i)
+        wanted.emplace(endpointOf(servers[i]), &servers[i]);
+
+    // Kept listeners point at the new default servers; the others are closed
+    for (size_t i = 0; i < _listen_fds.size();) {
+        const int fd = _listen_fds[i];
+        std::unordered_map<std::string, const Server*>::iterator it = wanted.find(_endpoints[i]);
+        if (it != wanted.end()) {
+            _listeners[static_cast<size_t>(fd)] =
+                _config->getHosts().getDefault(it->second->getPort());
+            wanted.erase(it);
+            ++i;
+            continue;
+        }
+        LOG_INFO("Stopped listening on %s", _endpoints[i].c_str());
+        _poller->remove(fd);
+        close(fd);
+        _listeners[static_cast<size_t>(fd)] = NULL;
+        _listen_fds.erase(_listen_fds.begin() + static_cast<std::ptrdiff_t>(i));
+        _endpoints.erase(_endpoints.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    for (size_t i = 0; i < servers.size(); ++i) {
+        if (!wanted.erase(endpointOf(servers[i])))
+            continue; // Already listening, or opened for an earlier server
+        try {
+            openListener(servers[i]);
+        } catch (const SocketError& e) {
+            LOG_ERROR("Reload: %s", e.what()); // The rest of the configuration still applies
+        }
+    }
+    LOG_INFO("Configuration reloaded, %zu listener(s)", _listen_fds.size());
+}
+
+void SocketManager::rebindClient(ClientSlot& client) {
+    Connection&   conn   = *client.conn;
+    const Server* server = _config->getHosts().getDefault(conn.getServer()->getPort());
+    if (!server || !conn.rebind(server, &_config->getHosts()))
+        return;
+    conn.traceSlowRequests(_config->getSlowRequestThreshold());
+    leaveConfig(client.config);
+    client.config = _config.get();
+    ++_config_clients;
+}
+
+void SocketManager::leaveConfig(const ConfigSnapshot* config) noexcept {
+    if (config == _config.get()) {
+        --_config_clients;
+        return;
+    }
+    for (size_t i = 0; i < _retired.size(); ++i) {
+        if (_retired[i].config.get() != config)
+            continue;
+        if (--_retired[i].clients == 0) {
+            _retired[i] = std::move(_retired.back());
+            _retired.pop_back();
+        }
+        return;
+    }
+}
+
+// Main server loop: only ready descriptors are visited
 void SocketManager::run() {
-	while (running) {
-		int n = poll(&_poll_fds[0], _poll_fds.size(), -1); // Block until at least one fd is ready
-		if (n < 0) {
-			if (errno == EINTR)
-				continue;
-			throw SocketError("poll() failed: " + std::string(strerror(errno)));
-		}
-
-
-		for (size_t i = 0; i < _poll_fds.size(); ++i) {
-			if (_poll_fds[i].revents & POLLIN) { // Ready to read (incoming data or connection)
-				if (_listen_map.count(_poll_fds[i].fd))
-					handleNewConnection(_poll_fds[i].fd); // Accept a new client
-				else
-					handleClientData(_poll_fds[i].fd, i); // Handle data from existing client
-			}
-		}
-	}
-	std::cout << std::endl;
-	std::cout << "Shutting down server" << std::endl;
-}
-
-// Accept new client and add to poll list
+    while (!_stopping.load()) {
+        // Sleep until the next client deadline; exiting scripts and backends need a sweep
+        int timeout = _timers.nextTimeout(TimerWheel::Clock::now());
+        // Paused listeners are retried too, in case descriptors ran out
+        if ((!_exiting.empty() || _fastcgi.getConnectionCount() ||
+             _upstreams.getConnectionCount() || !_accepting) &&
+            (timeout < 0 || timeout > 1000))
+            timeout = 1000;
+        if (!_scans.empty())
+            timeout = 0; // Directory scans advance once per iteration
+        _poller->wait(_ready, timeout);
+        _date.update(std::time(NULL)); // One clock read per iteration, one format per second
+        expireTimers();
+
+        for (size_t i = 0; i < _ready.size(); ++i) {
+            const IoEvent& ev = _ready[i];
+            if (ev.fd == _wake_fds[0])
+                drainWakePipe();
+            else if (findListener(ev.fd))
+                handleNewConnection(ev.fd); // Accept new clients
+            else if (ClientSlot* client = findClient(ev.fd))
+                handleClientEvent(*client, ev.events); // Drive the client state machine
+            else if (!_fastcgi.handleEvent(ev.fd, ev.events) &&
+                     !_upstreams.handleEvent(ev.fd, ev.events))
+                handlePipeEvent(ev.fd, ev.events); // CGI script of a client
+        }
+        sweepBackends();
+        pumpBackends(); // Streams woken by backend events, timeouts or closed clients
+        pumpListings();
+        if (_reload_pending.load())
+            applyReload();
+        reapClosed(); // Release fds closed during this iteration
+        if (!_accepting)
+            resumeAccepting();
+        publishBufferStats();
+    }
+    LOG_INFO("Shutting down server");
+}
+
+void SocketManager::pauseAccepting() {
+    if (!_accepting)
+        return;
+    for (int fd : _listen_fds)
+        _poller->modify(fd, 0);
+    _accepting = false;
+}
+
+void SocketManager::resumeAccepting() {
+    const std::size_t limit = _config->getMaxConnections();
+    if (_accepting || (limit && _active >= limit))
+        return;
+    if (_out_of_fds && Connection::Clock::now() < _fd_retry)
+        return;
+    _out_of_fds = false;
+    for (int fd : _listen_fds)
+        _poller->modify(fd, PollManager::EVENT_READ); // Reports clients already queued
+    _accepting = true;
+}
+
+// Consume stop() and reload() notifications; the loop does the rest
+void SocketManager::drainWakePipe() noexcept {
+    char buf[64];
+    while (read(_wake_fds[0], buf, sizeof(buf)) > 0) {
+    }
+}
+
+// Accept a bounded batch of clients; the rest of a burst waits for the next iteration
 void SocketManager::handleNewConnection(int listen_fd) {
-	int client_fd = accept(listen_fd, NULL, NULL);
-	if (client_fd < 0)
-		return;
-
-	if (fcntl(client_fd, F_SETFL, O_NONBLOCK) < 0) {
-		close(client_fd);
-		return;
-	}
-
-	_poll_fds.push_back((pollfd){ client_fd, POLLIN, 0 });
-	std::cout << std::endl;
-	std::cout << "Accepted client on fd: " << client_fd << std::endl;
-
-	// Store which server this client is connected to based on listen_fd
-	_client_map[client_fd] = _listen_map[listen_fd];
-}
-
-// Read data from client, send fixed response, then close
-void SocketManager::handleClientData(int client_fd, size_t index) {
-	char buffer[1024];
-	int bytes = recv(client_fd, buffer, sizeof(buffer) - 1, 0);
-	if (bytes <= 0) {
-		close(client_fd);
-		_poll_fds.erase(_poll_fds.begin() + index);
-		_client_map.erase(client_fd);
-		return;
-	}
-	buffer[bytes] = '\0';
-	std::cout << std::endl;
-	std::cout << "Received request: " << buffer << std::endl;
-
-	std::cout << std::endl;
-	// Respond with simple HTML and explicit connection close
-	std::string body = "<h1>Success</h1><p>OK</p>";
-	std::stringstream response;
-	response << "HTTP/1.1 200 OK\r\n";
-	response << "Content-Type: text/html\r\n";
-	response << "Content-Length: " << body.length() << "\r\n";
-	response << "Connection: close\r\n";
-	response << "\r\n";
-	response << body;
-
-	std::string full_response = response.str();
-	send(client_fd, full_response.c_str(), full_response.size(), 0);
-	close(client_fd);
-	_poll_fds.erase(_poll_fds.begin() + index);
-	_client_map.erase(client_fd);
+    const std::size_t limit = _config->getMaxConnections();
+    for (int accepted = 0; accepted < ACCEPT_BATCH; ++accepted) {
+        if (limit && _active >= limit) {
+            pauseAccepting(); // Resumed once clients close
+            return;
+        }
+        int client_fd = acceptClient(listen_fd);
+        if (client_fd < 0 && (errno == ECONNABORTED || errno == EINTR))
+            continue;
+        if (client_fd < 0) {
+            if (errno == EMFILE || errno == ENFILE) {
+                // Level-triggered backends would report the listener forever; logged once
+                LOG_ERROR("accept() failed: %s; pausing listeners", strerror(errno));
+                pauseAccepting();
+                _out_of_fds = true;
+                _fd_retry   = Connection::Clock::now() + FD_RETRY;
+            }
+            return; // EAGAIN: backlog drained
+        }
+
+        // Store which server this client is connected to based on listen_fd
+        const Server*               server = findListener(listen_fd);
+        std::unique_ptr<Connection> conn(
+            new Connection(client_fd, server, &_config->getHosts(), &_buffers, _stats));
+        try {
+            // The handshake runs from the first read, like any other request bytes
+            if (const TlsContext* tls = _config->getTls(*server))
+                conn->startTls(*tls);
+            conn->traceSlowRequests(_config->getSlowRequestThreshold());
+            _poller->add(client_fd, PollManager::EVENT_READ);
+        } catch (const std::exception& e) {
+            LOG_ERROR("%s", e.what());
+            close(client_fd);
+            continue;
+        }
+        LOG_DEBUG("Accepted client on fd: %d", client_fd);
+        WEBSERV_PROBE1(accept, client_fd);
+
+        const size_t slot = static_cast<size_t>(client_fd);
+        if (slot >= _clients.size())
+            _clients.resize(slot + 1);
+        _clients[slot].state       = SlotState::OPEN;
+        _clients[slot].conn        = std::move(conn);
+        _clients[slot].interest    = PollManager::EVENT_READ;
+        _clients[slot].read_closed = false;
+        _clients[slot].config      = _config.get();
+        ++_config_clients;
+        ++_active;
+        _stats->accepted.add();
+        armTimer(_clients[slot]);
+    }
+    // Batch spent: edge-triggered backends report the clients left only when re-armed
+    _poller->modify(listen_fd, PollManager::EVENT_READ);
+}
+
+// Read whatever arrived, answer complete requests, flush pending output
+void SocketManager::handleClientEvent(ClientSlot& client, uint32_t events) {
+    Connection& conn      = *client.conn;
+    const int   client_fd = conn.getFd();
+
+    if (events & (PollManager::EVENT_READ | PollManager::EVENT_HUP | PollManager::EVENT_ERROR)) {
+        IoStatus status = conn.readFromSocket();
+        if (status == IoStatus::ERROR) {
+            closeClient(client_fd);
+            return;
+        }
+        processInput(client);
+
+        if (status == IoStatus::CLOSED && client.upload) {
+            closeClient(client_fd); // The body was cut short: its file is discarded
+            return;
+        }
+        if (status == IoStatus::CLOSED && client.cgi) {
+            // A script still answers: let it finish unless its body was cut short
+            if (conn.isStreamingBody()) {
+                closeClient(client_fd);
+                return;
+            }
+            client.cgi->keep_alive = false;
+            client.read_closed     = true;
+        } else if (status == IoStatus::CLOSED && client.listing) {
+            client.listing->keep_alive = false; // Answered, then closed
+            client.read_closed         = true;
+        } else if (status == IoStatus::CLOSED) {
+            // Peer shut down its side: finish sending whatever is queued, then close
+            conn.closeAfterWrite();
+            if (!conn.hasPendingOutput()) {
+                closeClient(client_fd);
+                return;
+            }
+        }
+    }
+    flushClient(client);
+}
+
+// Answer every complete request in the input buffer, in order (HTTP pipelining)
+void SocketManager::processInput(ClientSlot& client) {
+    Connection& conn = *client.conn;
+    if (client.cgi) {
+        pumpCgiInput(client); // Later requests wait for the script's response
+        return;
+    }
+    if (client.listing)
+        return; // Later requests wait for the listing
+    if (client.upload) {
+        pumpUpload(client);
+        if (client.upload)
+            return;
+    }
+    while (!conn.isPipelineFull()) {
+        if (client.config != _config.get())
+            rebindClient(client); // Requests are answered with the newest configuration
+        const bool complete = conn.parseInput();
+        if (conn.claimHead()) {
+            if (startProxy(client) || startCgi(client))
+                return;
+            if (startUpload(client)) {
+                if (client.upload)
+                    return;
+                continue; // Stored already: pipelined requests may follow
+            }
+        }
+        if (!complete)
+            break;
+        if (startListing(client)) {
+            if (client.listing)
+                return;
+            continue;
+        }
+        handleRequest(conn);
+    }
+
+    if (int status = conn.takeErrorStatus())
+        sendError(conn, status);
+}
+
+// Read while the streamed body has room, write while output is queued
+void SocketManager::updateInterest(ClientSlot& client) {
+    Connection& conn     = *client.conn;
+    uint32_t    interest = 0;
+    if (!client.read_closed && !conn.isInputPaused())
+        interest |= PollManager::EVENT_READ;
+    if (conn.hasPendingOutput())
+        interest |= PollManager::EVENT_WRITE;
+    // A read that stopped at a full buffer left bytes that edge-triggered backends won't report
+    const bool rearm = (interest & PollManager::EVENT_READ) && conn.takeReadStopped();
+    if (interest != client.interest || rearm) {
+        _poller->modify(conn.getFd(), interest); // Re-arming also reports data already waiting
+        client.interest = interest;
+    }
+}
+
+// Send queued output and keep write interest only while the socket is full
+void SocketManager::flushClient(ClientSlot& client) {
+    Connection& conn = *client.conn;
+    const int   fd   = conn.getFd();
+
+    while (conn.hasPendingOutput()) {
+        IoStatus status = conn.writeToSocket();
+        if (status == IoStatus::ERROR) {
+            closeClient(fd);
+            return;
+        }
+        if (status == IoStatus::AGAIN)
+            break;
+        // Queue drained: read more script output, or answer pipelined requests
+        if (client.cgi)
+            pumpCgiOutput(client);
+        if (!client.cgi)
+            processInput(client);
+        if (!findClient(fd))
+            return;
+    }
+
+    if (!conn.hasPendingOutput()) {
+        if (conn.shouldClose() && !client.cgi && !client.listing) {
+            closeClient(fd); // Nothing left to send, e.g. after a script failed mid-response
+            return;
+        }
+        conn.releaseIdleMemory(); // Idle until the next request: lend the buffers to others
+    }
+    updateInterest(client);
+    if (conn.getState() == ConnectionState::CLOSING)
+        closeClient(fd);
+    else
+        armTimer(client);
+}
+
+// Answer a complete request: route it, then serve the file or the error
+void SocketManager::handleRequest(Connection& conn) {
+    LOG_DEBUG("Received request: %.*s", static_cast<int>(conn.requestHead().size()),
+              conn.requestHead().data());
+    conn.markRouted();
+
+    const HttpRequest& request    = conn.getRequest();
+    const bool         keep_alive = keepsAlive(conn);
+    const bool         head_only  = request.getMethod() == HttpMethod::HEAD;
+
+    // The previous response is gone, so its arena memory can be reused
+    Arena& arena = conn.getArena();
+    arena.reset();
+    const RequestRoute& route    = routeOf(conn);
+    HttpResponse        response = _builder.resolveStats(request, route)
+                                       ? buildStats(&arena)
+                                       : _builder.build(request, route, &arena);
+    logRequest(conn, response.getStatus());
+    conn.finishRequest();
+    sendResponse(conn, response, keep_alive, head_only);
+}
+
+// Normalize the path and match its location once; every handler reads the result
+const RequestRoute& SocketManager::routeOf(Connection& conn) {
+    RequestRoute& route = conn.getRoute();
+    if (!route.server)
+        HttpResponseBuilder::route(conn.getRequest(), *conn.getServer(), route);
+    return route;
+}
+
+void SocketManager::logRequest(const Connection& conn, int status) const {
+    const HttpRequest& request = conn.getRequest();
+    LOG_INFO("%.*s %.*s %d", static_cast<int>(request.getMethodName().size()),
+             request.getMethodName().data(), static_cast<int>(request.getTarget().size()),
+             request.getTarget().data(), status);
+}
+
+// Answer a framing error detected by the connection, then close
+void SocketManager::sendError(Connection& conn, int status) {
+    Arena& arena = conn.getArena();
+    arena.reset();
+    HttpResponse response = _builder.buildError(status, *conn.getServer(), &arena);
+    sendResponse(conn, response, false, false);
+}
+
+// Add the common fields and queue the response as gathered segments
+void SocketManager::sendResponse(Connection& conn, HttpResponse& response, bool keep_alive,
+                                 bool head_only) {
+    addCommonFields(conn, response, keep_alive);
+    conn.queueResponse(response, head_only);
+    if (!keep_alive)
+        conn.closeAfterWrite();
+}
+
+// Server, Date and connection management fields, shared with CGI responses
+void SocketManager::addCommonFields(const Connection& conn, HttpResponse& response,
+                                    bool keep_alive) {
+    const std::shared_ptr<const std::string>& date = _date.getField();
+    response.addField(FIELD_SERVER);
+    response.addField(*date, date);
+    if (keep_alive) {
+        response.addField(FIELD_CONNECTION_KEEP_ALIVE);
+        response.setHeader("Keep-Alive", "timeout=" + std::to_string(
+                                             conn.getServer()->getKeepAliveTimeout()));
+    } else {
+        response.addField(FIELD_CONNECTION_CLOSE);
+    }
+}
+
+// Metrics of every worker, summed at the time of the request
+HttpResponse SocketManager::buildStats(std::pmr::memory_resource* memory) {
+    HttpResponse response(200, memory);
+    std::string  body;
+    _registry->renderPrometheus(body);
+    response.setHeader("Cache-Control", "no-store");
+    response.setBody(std::move(body), "text/plain; version=0.0.4");
+    return response;
+}
+
+// --- Uploads ---
+
+// Route the request once its head is parsed; the body streams to the upload store
+bool SocketManager::startUpload(ClientSlot& client) {
+    Connection&        conn    = *client.conn;
+    const HttpRequest& request = conn.getRequest();
+    const std::string& path    = routeOf(conn).path;
+    const Location*    location = _builder.resolveUpload(request, routeOf(conn));
+    if (!location)
+        return false;
+
+    LOG_DEBUG("Received request: %.*s", static_cast<int>(conn.requestHead().size()),
+              conn.requestHead().data());
+    conn.markRouted();
+
+    // The path below the location names the file; the store has no subdirectories
+    std::string_view name(path);
+    name.remove_prefix(std::min(location->getPath().size(), name.size()));
+    if (!name.empty() && name.front() == '/')
+        name.remove_prefix(1);
+    std::unique_ptr<UploadRun> run(new UploadRun(location->getUploadStore()));
+    run->base_uri   = std::string(path.data(), path.size() - name.size());
+    run->keep_alive = keepsAlive(conn);
+    if (run->base_uri.empty() || run->base_uri.back() != '/')
+        run->base_uri += '/';
+
+    // The body is not read when it cannot be stored, so the connection closes
+    int status = name.find('/') != std::string_view::npos ? 409 : 0;
+    if (!status && !run->writer.start(request.getHeader("Content-Type"), name))
+        status = run->writer.getStatus();
+    if (status) {
+        conn.finishRequest();
+        sendError(conn, status);
+        return true;
+    }
+    client.upload = std::move(run);
+    conn.streamBody(); // Invalidates the request slices: nothing below may use them
+    pumpUpload(client);
+    return true;
+}
+
+// Store buffered body bytes; disk writes are done here, they do not wait on the network
+void SocketManager::pumpUpload(ClientSlot& client) {
+    Connection& conn = *client.conn;
+    UploadRun&  run  = *client.upload;
+    while (!run.writer.getStatus()) {
+        const std::string_view data = conn.bodyData();
+        const std::size_t      used = data.empty() ? 0 : run.writer.write(data);
+        if (used == 0)
+            break; // Drained, or a multipart delimiter waits for its end
+        conn.consumeBody(used);
+    }
+    int status = conn.takeErrorStatus();
+    if (!status)
+        status = run.writer.getStatus();
+    if (!status && !conn.isBodyComplete())
+        return;
+    if (!status && !run.writer.finish())
+        status = run.writer.getStatus();
+    if (status) {
+        client.upload.reset();
+        conn.finishRequest();
+        sendError(conn, status);
+        return;
+    }
+    Arena& arena = conn.getArena();
+    arena.reset();
+    HttpResponse response = _builder.buildCreated(run.base_uri, run.writer.getFiles(), &arena);
+    const bool   keep_alive = run.keep_alive;
+    client.upload.reset();
+    conn.finishRequest();
+    sendResponse(conn, response, keep_alive, false);
+}
+
+// --- Directory listings ---
+
+// Serve a cached listing at once; a directory that is not cached is scanned in steps
+bool SocketManager::startListing(ClientSlot& client) {
+    Connection&        conn    = *client.conn;
+    const HttpRequest& request = conn.getRequest();
+    const RequestRoute& route   = routeOf(conn);
+    const std::string&  path    = route.path;
+    Arena&              arena   = conn.getArena();
+    arena.reset();
+    std::pmr::string directory(&arena);
+    const Location*  location = _builder.resolveAutoindex(request, route, directory);
+    if (!location)
+        return false;
+
+    LOG_DEBUG("Received request: %.*s", static_cast<int>(conn.requestHead().size()),
+              conn.requestHead().data());
+    conn.markRouted();
+    const bool keep_alive = keepsAlive(conn);
+    const bool head_only  = request.getMethod() == HttpMethod::HEAD;
+    const FileCache::Lookup                       lookup  = _files.open(directory);
+    const std::shared_ptr<const DirectoryListing> listing = _listings.find(directory, lookup.file);
+    if (listing) {
+        HttpResponse response = _builder.buildListing(request, *location, path, listing,
+                                                      *conn.getServer(), &arena);
+        logRequest(conn, response.getStatus());
+        conn.finishRequest();
+        sendResponse(conn, response, keep_alive, head_only);
+        return true;
+    }
+
+    // Clients asking for a directory already being read wait for the same scan
+    std::vector<PendingScan>::iterator it = _scans.begin();
+    while (it != _scans.end() && std::string_view(it->scan->getPath()) != directory)
+        ++it;
+    if (it == _scans.end()) {
+        _scans.push_back(PendingScan());
+        it = std::prev(_scans.end());
+        it->scan.reset(new DirectoryScan(std::string(directory), lookup.file));
+    }
+    it->clients.push_back(conn.getFd());
+    client.listing.reset(new ListingRun{it->scan.get(), location, std::string(path), keep_alive,
+                                        head_only});
+    return true;
+}
+
+// One step per scan and iteration; finished listings are cached, then answered
+void SocketManager::pumpListings() {
+    for (std::size_t i = 0; i < _scans.size();) {
+        if (!_scans[i].scan->step()) {
+            ++i;
+            continue;
+        }
+        // Answering may start new scans, so the finished one leaves the list first
+        PendingScan done = std::move(_scans[i]);
+        _scans[i]        = std::move(_scans.back());
+        _scans.pop_back();
+        if (done.scan->getListing())
+            _listings.insert(done.scan->getPath(), done.scan->getListing());
+        for (int fd : done.clients) {
+            ClientSlot* client = findClient(fd);
+            // The fd may have closed meanwhile, and been reused by another client
+            if (!client || !client->listing || client->listing->scan != done.scan.get())
+                continue;
+            finishListing(*client, *done.scan);
+            if (!findClient(fd))
+                continue;
+            processInput(*client); // Pipelined requests may be waiting
+            flushClient(*client);
+        }
+    }
+}
+
+void SocketManager::finishListing(ClientSlot& client, const DirectoryScan& scan) {
+    Connection&                       conn   = *client.conn;
+    const Server&                     server = *conn.getServer();
+    const std::unique_ptr<ListingRun> run    = std::move(client.listing);
+    int                               status = 0;
+    if (!scan.getListing())
+        status = scan.getError() == EACCES                                 ? 403
+                 : scan.getError() == ENOENT || scan.getError() == ENOTDIR ? 404 // Removed
+                                                                           : 500;
+    Arena& arena = conn.getArena();
+    arena.reset();
+    HttpResponse response = status ? _builder.buildError(status, server, &arena)
+                                   : _builder.buildListing(conn.getRequest(), *run->location,
+                                                           run->path, scan.getListing(), server,
+                                                           &arena);
+    logRequest(conn, response.getStatus());
+    conn.finishRequest();
+    sendResponse(conn, response, run->keep_alive, run->head_only);
+}
+
+// --- CGI ---
+
+// Route the request once its head is parsed; the body streams to the script
+bool SocketManager::startCgi(ClientSlot& client) {
+    Connection&        conn    = *client.conn;
+    const HttpRequest& request = conn.getRequest();
+    const Server&      server  = *conn.getServer();
+    Arena&             arena   = conn.getArena();
+    arena.reset();
+    std::string_view script_name;
+    std::string_view path_info;
+    std::pmr::string filename(&arena);
+    const Location*  location =
+        _builder.resolveCgi(request, routeOf(conn), script_name, filename, path_info);
+    if (!location)
+        return false;
+
+    LOG_DEBUG("Received request: %.*s", static_cast<int>(conn.requestHead().size()),
+              conn.requestHead().data());
+    conn.markRouted();
+
+    // The body is not read when the script cannot run, so the connection closes
+    const std::size_t running = _cgi_running[location];
+    if (location->getCgiMaxProcesses() && running >= location->getCgiMaxProcesses()) {
+        conn.finishRequest();
+        sendError(conn, 503);
+        return true;
+    }
+    CgiProcess::Command command = CgiProcess::makeCommand(
+        request, server, *location, script_name, filename, path_info, peerAddress(conn.getFd()));
+    std::unique_ptr<CgiRun> run(new CgiRun());
+    if (!location->getFastcgiPass().empty()) {
+        run->stream = _fastcgi.open(location->getFastcgiPass(), conn.getFd(),
+                                    std::move(command.environment));
+        if (!run->stream) {
+            LOG_ERROR("FastCGI: invalid backend address %s", location->getFastcgiPass().c_str());
+            conn.finishRequest();
+            sendError(conn, 500);
+            return true;
+        }
+        run->channel = run->stream.get();
+    } else if (!startCgiProcess(*run, conn, command, filename)) {
+        conn.finishRequest();
+        sendError(conn, 500);
+        return true;
+    }
+    beginCgiRun(client, std::move(run), *location);
+    return true;
+}
+
+// The request's own framing and the client's address are read before the body streams
+bool SocketManager::startProxy(ClientSlot& client) {
+    Connection&        conn    = *client.conn;
+    const HttpRequest& request = conn.getRequest();
+    const Server&      server  = *conn.getServer();
+    const Location*    location = _builder.resolveProxy(request, routeOf(conn));
+    if (!location)
+        return false;
+
+    LOG_DEBUG("Received request: %.*s", static_cast<int>(conn.requestHead().size()),
+              conn.requestHead().data());
+    conn.markRouted();
+
+    const std::string host =
+        server.getServerNames().empty() ? endpointOf(server) : server.getServerNames()[0];
+    bool        chunked = false;
+    std::string head =
+        UpstreamPool::makeRequestHead(request, peerAddress(conn.getFd()), host, chunked);
+    std::unique_ptr<CgiRun> run(new CgiRun());
+    run->proxy = _upstreams.open(location->getProxyPass(), location->getProxyBalance(),
+                                 conn.getFd(), std::move(head), chunked,
+                                 request.getMethod() == HttpMethod::HEAD);
+    if (!run->proxy) {
+        LOG_ERROR("Proxy: invalid upstream address %s", location->getProxyPass().c_str());
+        conn.finishRequest();
+        sendError(conn, 500);
+        return true;
+    }
+    run->channel = run->proxy.get();
+    beginCgiRun(client, std::move(run), *location);
+    return true;
+}
+
+void SocketManager::beginCgiRun(ClientSlot& client, std::unique_ptr<CgiRun> run,
+                                const Location& location) {
+    Connection&        conn    = *client.conn;
+    const HttpRequest& request = conn.getRequest();
+    run->location   = &location;
+    run->keep_alive = keepsAlive(conn);
+    run->head_only  = request.getMethod() == HttpMethod::HEAD;
+    run->chunked_ok = request.getVersionMajor() > 1 ||
+                      (request.getVersionMajor() == 1 && request.getVersionMinor() >= 1);
+    run->head_sent  = false;
+    run->chunked    = false;
+    run->has_length = false;
+    run->no_body    = false;
+    run->body_left  = 0;
+    run->accepted_codings =
+        location.getCompression() ? parseAcceptEncoding(request.getHeader("Accept-Encoding")) : 0;
+    client.cgi = std::move(run);
+    ++_cgi_running[&location];
+
+    conn.streamBody(); // Invalidates the request slices: nothing below may use them
+    pumpCgiInput(client);
+}
+
+// Fork the script and register its pipes; stdin gets write interest only once it is full
+bool SocketManager::startCgiProcess(CgiRun& run, const Connection& conn,
+                                    const CgiProcess::Command& command,
+                                    const std::pmr::string& filename) {
+    std::unique_ptr<CgiProcess> process(new CgiProcess());
+    if (!process->start(command)) {
+        LOG_WARN("CGI: cannot start %s: %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+    try {
+        _poller->add(process->getOutputFd(), PollManager::EVENT_READ);
+        try {
+            _poller->add(process->getInputFd(), 0);
+        } catch (const PollManager::PollError&) {
+            _poller->remove(process->getOutputFd());
+            throw;
+        }
+    } catch (const PollManager::PollError& e) {
+        LOG_ERROR("%s", e.what());
+        return false;
+    }
+    run.input_interest  = 0;
+    run.output_interest = PollManager::EVENT_READ;
+    for (int fd : {process->getInputFd(), process->getOutputFd()}) {
+        const size_t slot = static_cast<size_t>(fd);
+        if (slot >= _pipe_owner.size())
+            _pipe_owner.resize(slot + 1, -1);
+        _pipe_owner[slot] = conn.getFd();
+    }
+    run.channel = process.get();
+    run.process = std::move(process);
+    return true;
+}
+
+// O(1) dispatch from a pipe to the client whose script owns it
+void SocketManager::handlePipeEvent(int fd, uint32_t events) {
+    const size_t slot = static_cast<size_t>(fd);
+    if (fd < 0 || slot >= _pipe_owner.size())
+        return;
+    const int   client_fd = _pipe_owner[slot];
+    ClientSlot* client    = findClient(client_fd);
+    if (!client || !client->cgi || !client->cgi->process)
+        return; // Stale event for a pipe closed earlier in this iteration
+    CgiRun& run = *client->cgi;
+
+    if (fd == run.process->getInputFd()) {
+        if (events & (PollManager::EVENT_HUP | PollManager::EVENT_ERROR))
+            closeCgiInput(run); // The script exited or closed its stdin
+        pumpCgiInput(*client);
+    } else if (fd == run.process->getOutputFd()) {
+        pumpCgiOutput(*client);
+    } else {
+        return;
+    }
+    if (!client->cgi)
+        processInput(*client); // Script done: pipelined requests may be waiting
+    if (findClient(client_fd))
+        flushClient(*client);
+}
+
+// Progress on one stream can wake others, e.g. by freeing room on a shared connection
+void SocketManager::pumpBackends() {
+    while (_fastcgi.takeWoken(_woken) || _upstreams.takeWoken(_woken)) {
+        for (int fd : _woken) {
+            ClientSlot* client = findClient(fd);
+            if (!client || !client->cgi || client->cgi->process)
+                continue; // Closed, or already finished through an earlier wake-up
+            pumpCgiInput(*client);
+            if (client->cgi)
+                pumpCgiOutput(*client);
+            if (!client->cgi)
+                processInput(*client);
+            if (findClient(fd))
+                flushClient(*client);
+        }
+    }
+}
+
+// Feed buffered body bytes to the script; what it refuses to read is dropped
+void SocketManager::pumpCgiInput(ClientSlot& client) {
+    Connection& conn = *client.conn;
+    CgiRun&     run  = *client.cgi;
+    if (conn.isStreamingBody() && conn.getErrorStatus()) {
+        // Malformed or oversized chunked body: the script must not take it as complete
+        run.channel->terminate();
+        finishCgi(client, conn.takeErrorStatus());
+        return;
+    }
+    while (conn.isStreamingBody()) {
+        const std::string_view data = conn.bodyData();
+        if (data.empty())
+            break;
+        if (!run.channel->hasInput()) {
+            conn.consumeBody(data.size());
+            continue;
+        }
+        const ssize_t written = run.channel->writeInput(data.data(), data.size());
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (run.process) // A backend stream wakes its owner once it has room
+                setPipeInterest(run.process->getInputFd(), run.input_interest,
+                                PollManager::EVENT_WRITE);
+            return;
+        }
+        if (written < 0) {
+            closeCgiInput(run); // EPIPE: the script does not want the rest
+            continue;
+        }
+        conn.consumeBody(static_cast<std::size_t>(written));
+    }
+    if (run.process && run.process->getInputFd() >= 0)
+        setPipeInterest(run.process->getInputFd(), run.input_interest, 0);
+    if (conn.isStreamingBody() && conn.isBodyComplete()) {
+        conn.finishRequest();
+        closeCgiInput(run);
+    }
+}
+
+// Relay output until the client's queue is full; the queue drain resumes it
+void SocketManager::pumpCgiOutput(ClientSlot& client) {
+    Connection& conn = *client.conn;
+    CgiRun&     run  = *client.cgi;
+    while (!conn.isPipelineFull()) {
+        std::string   data(CGI_READ_CHUNK, '\0');
+        const ssize_t got = run.channel->readOutput(&data[0], data.size());
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (got <= 0) {
+            finishCgi(client, got == 0 ? 0 : 502);
+            return;
+        }
+        data.resize(static_cast<std::size_t>(got));
+        if (!run.head_sent) {
+            const CgiOutputParser::Result result = run.parser.feed(data);
+            if (result == CgiOutputParser::Result::INCOMPLETE)
+                continue;
+            if (result == CgiOutputParser::Result::ERROR) {
+                LOG_WARN("CGI: malformed header block");
+                finishCgi(client, 502);
+                return;
+            }
+            sendCgiHead(client);
+            data = run.parser.takeBody();
+        }
+        sendCgiBody(run, conn, std::move(data));
+    }
+    // Level-triggered backends would report the pipe again and again while the queue is full
+    if (run.process)
+        setPipeInterest(run.process->getOutputFd(), run.output_interest,
+                        conn.isPipelineFull() ? 0 : PollManager::EVENT_READ);
+}
+
+// Frame the body with the script's length, chunked coding, or the end of the connection
+void SocketManager::sendCgiHead(ClientSlot& client) {
+    Connection&            conn   = *client.conn;
+    CgiRun&                run    = *client.cgi;
+    const CgiOutputParser& parser = run.parser;
+    Arena&                 arena  = conn.getArena();
+    arena.reset();
+
+    HttpResponse response(parser.getStatus(), &arena);
+    response.setStreamed();
+    run.head_sent  = true;
+    run.no_body    = hasNoBody(parser.getStatus(), run.head_only);
+    run.has_length = parser.hasContentLength();
+    run.body_left  = parser.getContentLength();
+    run.chunked    = !run.no_body && !run.has_length && run.chunked_ok;
+    const ContentCoding coding =
+        run.no_body ? ContentCoding::IDENTITY
+                    : cgiCoding(*run.location, run.accepted_codings, parser, _compression);
+    if (coding != ContentCoding::IDENTITY) {
+        // The encoded length is unknown; body_left still counts the script's bytes
+        run.compressor.reset(new Compressor(coding, Compressor::STREAM_LEVEL));
+        run.chunked = run.chunked_ok;
+        response.addField(contentEncodingField(coding));
+    }
+    if (run.location->getCompression())
+        response.addField(FIELD_VARY_ACCEPT_ENCODING);
+    if (run.has_length && !run.compressor)
+        response.setHeader("Content-Length", std::to_string(run.body_left));
+    else if (run.chunked)
+        response.setHeader("Transfer-Encoding", "chunked");
+    else if (!run.no_body)
+        run.keep_alive = false;
+
+    // One owned block, so repeated fields such as Set-Cookie all go out
+    std::shared_ptr<std::string> fields = std::make_shared<std::string>();
+    for (const CgiOutputParser::Field& field : parser.getFields()) {
+        *fields += field.first;
+        *fields += ": ";
+        *fields += field.second;
+        *fields += "\r\n";
+    }
+    if (!fields->empty())
+        response.addField(*fields, fields);
+    addCommonFields(conn, response, run.keep_alive);
+    conn.queueResponse(response, true);
+}
+
+void SocketManager::sendCgiBody(CgiRun& run, Connection& conn, std::string data) {
+    if (run.no_body)
+        return;
+    if (run.has_length) {
+        if (data.size() > run.body_left)
+            data.resize(run.body_left); // Bytes past the announced length would desync the client
+        run.body_left -= data.size();
+    }
+    if (data.empty())
+        return;
+    if (run.compressor) {
+        std::string                                encoded;
+        const CompressionBudget::Clock::time_point started = CompressionBudget::Clock::now();
+        const bool ok = run.compressor->write(data, encoded, true);
+        _compression.charge(started);
+        if (!ok) {
+            LOG_ERROR("CGI: cannot compress output");
+            run.compressor.reset(); // Nothing more is sent, and no last chunk: the client
+            run.chunked    = false; // sees a truncated body when the connection closes
+            run.no_body    = true;
+            run.keep_alive = false;
+            return;
+        }
+        data.swap(encoded);
+    }
+    queueCgiBody(run, conn, std::move(data));
+}
+
+void SocketManager::queueCgiBody(CgiRun& run, Connection& conn, std::string data) {
+    if (data.empty())
+        return;
+    if (run.chunked) {
+        conn.queueOutput(std::string(run.encoder.chunkHead(data.size())));
+        conn.queueOutput(std::move(data));
+        conn.queueBorrowed(ChunkedEncoder::CHUNK_END);
+        return;
+    }
+    conn.queueOutput(std::move(data));
+}
+
+void SocketManager::finishCgi(ClientSlot& client, int error_status) {
+    Connection& conn  = *client.conn;
+    CgiRun&     run   = *client.cgi;
+    bool        close = !run.keep_alive || conn.isStreamingBody();
+    if (!run.head_sent) {
+        // Without a complete header block there is nothing to relay
+        if (!error_status)
+            LOG_WARN("CGI: script exited without a header block");
+        const int status = error_status ? error_status : 502;
+        releaseCgi(client);
+        sendError(conn, status);
+        return;
+    }
+    if (!error_status && run.compressor) {
+        std::string last;
+        if (run.compressor->finish(last))
+            queueCgiBody(run, conn, std::move(last));
+        else
+            error_status = 502;
+    }
+    if (error_status)
+        close = true; // The client already has the head: only closing can signal the failure
+    else if (run.chunked)
+        conn.queueBorrowed(run.encoder.finish());
+    else if (!run.no_body && (!run.has_length || run.body_left > 0))
+        close = true; // Close-delimited, or the script sent less than it announced
+    releaseCgi(client);
+    if (close)
+        conn.closeAfterWrite();
+}
+
+// Pipes go first; a script that has not exited yet is reaped by the sweep
+void SocketManager::releaseCgi(ClientSlot& client) {
+    CgiRun& run = *client.cgi;
+    closeCgiInput(run);
+    --_cgi_running[run.location];
+    if (run.process) {
+        const int out = run.process->getOutputFd();
+        if (out >= 0) {
+            _poller->remove(out);
+            _pipe_owner[static_cast<size_t>(out)] = -1;
+            run.process->closeOutput();
+        }
+        if (!run.process->reap())
+            _exiting.push_back(ExitingCgi{std::move(run.process), Connection::Clock::now()});
+    }
+    client.cgi.reset(); // Destroying a FastCGI stream that has not ended aborts it
+}
+
+void SocketManager::closeCgiInput(CgiRun& run) {
+    if (!run.channel->hasInput())
+        return;
+    if (run.process) {
+        const int in = run.process->getInputFd();
+        _poller->remove(in);
+        _pipe_owner[static_cast<size_t>(in)] = -1;
+    }
+    run.channel->closeInput();
+}
+
+void SocketManager::setPipeInterest(int fd, std::uint32_t& current, std::uint32_t interest) {
+    if (fd < 0 || interest == current)
+        return;
+    _poller->modify(fd, interest);
+    current = interest;
+}
+
+// O(1) lookup of a listening socket
+const Server* SocketManager::findListener(int fd) const {
+    const size_t slot = static_cast<size_t>(fd);
+    if (fd < 0 || slot >= _listeners.size())
+        return NULL;
+    return _listeners[slot];
+}
+
+// O(1) lookup of an open client; tombstoned and free slots are ignored
+SocketManager::ClientSlot* SocketManager::findClient(int fd) {
+    const size_t slot = static_cast<size_t>(fd);
+    if (fd < 0 || slot >= _clients.size() || _clients[slot].state != SlotState::OPEN)
+        return NULL;
+    return &_clients[slot];
+}
+
+// Unregister from the backend and tombstone the slot; the fd is closed in reapClosed()
+void SocketManager::closeClient(int client_fd) {
+    ClientSlot* client = findClient(client_fd);
+    if (!client)
+        return;
+    if (client->cgi) {
+        client->cgi->channel->terminate(); // Nobody is left to read its answer
+        releaseCgi(*client);
+    }
+    client->upload.reset(); // An unfinished file is removed
+    client->listing.reset();
+    client->conn->shutdownTls();
+    _timers.cancel(static_cast<size_t>(client_fd));
+    _poller->remove(client_fd);
+    client->state = SlotState::CLOSING;
+    _closing.push_back(client_fd);
+    --_active;
+    _stats->closed.add();
+}
+
+// --- Timeouts ---
+
+void SocketManager::armTimer(ClientSlot& client) {
+    const size_t                  fd = static_cast<size_t>(client.conn->getFd());
+    TimerWheel::Clock::time_point deadline;
+    if (findDeadline(client, deadline))
+        _timers.schedule(fd, deadline);
+    else
+        _timers.cancel(fd);
+}
+
+// One deadline per client, for the first thing it waits on
+bool SocketManager::findDeadline(const ClientSlot&              client,
+                                 TimerWheel::Clock::time_point& deadline) const {
+    const Connection& conn   = *client.conn;
+    const Server&     server = *conn.getServer();
+    size_t            limit;
+    if (client.listing)
+        return false; // Bounded by the scan, which always ends
+    if (client.cgi) {
+        limit    = client.cgi->proxy ? client.cgi->location->getProxyTimeout()
+                                     : client.cgi->location->getCgiTimeout();
+        deadline = client.cgi->channel->getStartTime();
+    } else if (conn.hasPendingOutput()) {
+        limit    = server.getSendTimeout();
+        deadline = conn.getLastActivity();
+    } else if (client.upload || conn.getState() == ConnectionState::READING_BODY) {
+        limit    = server.getClientBodyTimeout();
+        deadline = conn.getLastActivity();
+    } else if (conn.hasBufferedInput() || conn.getRequestCount() == 0) {
+        limit    = server.getClientHeaderTimeout();
+        deadline = conn.getHeadStart();
+    } else {
+        limit    = server.getKeepAliveTimeout();
+        deadline = conn.getLastActivity();
+    }
+    deadline += std::chrono::seconds(static_cast<long>(limit));
+    return limit > 0;
+}
+
+// An expired timer may be stale: activity since it was set moves the deadline on
+void SocketManager::expireTimers() {
+    const TimerWheel::Clock::time_point now = TimerWheel::Clock::now();
+    _expired.clear();
+    _timers.expire(now, _expired);
+    for (size_t fd : _expired) {
+        ClientSlot*                   client = findClient(static_cast<int>(fd));
+        TimerWheel::Clock::time_point deadline;
+        if (!client || !findDeadline(*client, deadline))
+            continue;
+        if (deadline > now) {
+            _timers.schedule(fd, deadline);
+            continue;
+        }
+        Connection& conn = *client->conn;
+        if (client->cgi && client->cgi->proxy) {
+            LOG_WARN("Proxy: upstream timed out after %zus",
+                     client->cgi->location->getProxyTimeout());
+            client->cgi->channel->terminate();
+            finishCgi(*client, 504);
+        } else if (client->cgi) {
+            LOG_WARN("CGI: script timed out after %zus", client->cgi->location->getCgiTimeout());
+            client->cgi->channel->terminate();
+            finishCgi(*client, 504);
+        } else if (conn.hasPendingOutput() ||
+                   (!client->upload && conn.getState() != ConnectionState::READING_BODY &&
+                    !conn.hasBufferedInput())) {
+            closeClient(static_cast<int>(fd)); // Stalled reader, or idle between requests
+            continue;
+        } else {
+            client->upload.reset();
+            if (conn.isStreamingBody())
+                conn.finishRequest();
+            sendError(conn, 408);
+        }
+        flushClient(*client);
+    }
+}
+
+// Reap scripts that finished and close idle backend connections, once per second
+void SocketManager::sweepBackends() {
+    const Connection::Clock::time_point now = Connection::Clock::now();
+    if (now - _last_sweep < std::chrono::seconds(1))
+        return;
+    _last_sweep = now;
+
+    _fastcgi.closeIdle(now);
+    _upstreams.closeIdle(now);
+
+    // Finished scripts get a grace period to exit, then their process group is killed
+    for (size_t i = 0; i < _exiting.size();) {
+        ExitingCgi& script = _exiting[i];
+        if (script.process->reap()) {
+            _exiting[i] = std::move(_exiting.back());
+            _exiting.pop_back();
+            continue;
+        }
+        if (now - script.since >= std::chrono::seconds(CGI_EXIT_GRACE))
+            script.process->terminate();
+        ++i;
+    }
+}
+
+// End of iteration: no queued event can refer to these fds any more
+void SocketManager::reapClosed() {
+    for (size_t i = 0; i < _closing.size(); ++i) {
+        ClientSlot& client = _clients[static_cast<size_t>(_closing[i])];
+        close(_closing[i]);
+        client.state = SlotState::FREE;
+        client.conn.reset();
+        leaveConfig(client.config);
+        client.config = NULL;
+    }
+    if (!_closing.empty())
+        _out_of_fds = false; // A descriptor is free for the next client
+    _closing.clear();
+}
+
+void SocketManager::publishBufferStats() noexcept {
+    _stats->buffers_in_use.set(_buffers.getInUse());
+    _stats->buffers_high_water.set(_buffers.getHighWater());
+    _stats->buffer_hits.set(_buffers.getHits());
+    _stats->buffer_misses.set(_buffers.getMisses());
 }
@@ -0,0 +1,172 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TimerWheel.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:33:51 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:33:51 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    TimerWheel.cpp
+ * @brief   Implements the TimerWheel class.
+ *
+ * @ingroup network
+ */
+
+#include "network/TimerWheel.hpp"
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+constexpr std::uint64_t SLOT_MASK  = TimerWheel::SLOTS - 1;
+constexpr unsigned      RANGE_BITS = TimerWheel::SLOT_BITS * TimerWheel::LEVELS;
+constexpr std::uint64_t MAX_DELTA  = (std::uint64_t(1) << RANGE_BITS) - 1; ///< Ticks ahead.
+
+} // namespace
+
+TimerWheel::TimerWheel(Clock::duration tick, Clock::time_point start)
+    : _tick(tick), _start(start), _current(0), _size(0) {
+    std::fill(_heads, _heads + LEVELS * SLOTS, NONE);
+    std::fill(_counts, _counts + LEVELS, 0);
+}
+
+void TimerWheel::schedule(std::size_t key, Clock::time_point deadline) {
+    if (key >= _nodes.size())
+        _nodes.resize(key + 1);
+    unlink(key);
+    // Rounded up, so a timer never fires before its deadline
+    std::uint64_t expiry = 0;
+    if (deadline > _start)
+        expiry = static_cast<std::uint64_t>((deadline - _start + _tick - Clock::duration(1)) /
+                                            _tick);
+    expiry = std::max(expiry, _current);
+    link(key, std::min(expiry, _current + MAX_DELTA));
+}
+
+void TimerWheel::cancel(std::size_t key) noexcept {
+    if (key < _nodes.size())
+        unlink(key);
+}
+
+bool TimerWheel::isScheduled(std::size_t key) const noexcept {
+    return key < _nodes.size() && _nodes[key].slot != NONE;
+}
+
+void TimerWheel::expire(Clock::time_point now, std::vector<std::size_t>& expired) {
+    if (now < _start)
+        return;
+    const std::uint64_t target = static_cast<std::uint64_t>((now - _start) / _tick);
+    if (_size == 0) {
+        _current = std::max(_current, target + 1); // Nothing to walk through: skip the idle time
+        return;
+    }
+    for (; _size; ++_current) {
+        // Ticks where no slot fires and no timer cascades are skipped
+        const std::uint64_t next = nextTick();
+        if (next > target)
+            break;
+        _current = next;
+        // Entering a new round of a wheel brings the matching slot of the wheel above down
+        for (std::size_t level = 1; level < LEVELS; ++level) {
+            if (_current & ((std::uint64_t(1) << (SLOT_BITS * level)) - 1))
+                break;
+            cascade(level);
+        }
+        std::size_t& head = _heads[_current & SLOT_MASK];
+        while (head != NONE) {
+            const std::size_t key = head;
+            unlink(key);
+            expired.push_back(key);
+        }
+    }
+    _current = std::max(_current, target + 1);
+}
+
+int TimerWheel::nextTimeout(Clock::time_point now) const noexcept {
+    const std::uint64_t tick = nextTick();
+    if (tick == UINT64_MAX)
+        return -1;
+    const Clock::time_point when = _start + _tick * static_cast<Clock::rep>(tick);
+    if (when <= now)
+        return 0;
+    const std::chrono::milliseconds wait =
+        std::chrono::ceil<std::chrono::milliseconds>(when - now);
+    return static_cast<int>(std::min<std::chrono::milliseconds::rep>(wait.count(), INT_MAX));
+}
+
+std::size_t TimerWheel::size() const noexcept {
+    return _size;
+}
+
+// The lowest level whose range reaches the expiry; a slot there covers 64^level ticks
+void TimerWheel::link(std::size_t key, std::uint64_t expiry) noexcept {
+    const std::uint64_t delta = expiry - _current;
+    std::size_t         level = 0;
+    while (level + 1 < LEVELS && delta >> (SLOT_BITS * (level + 1)))
+        ++level;
+    const std::size_t slot = level * SLOTS + ((expiry >> (SLOT_BITS * level)) & SLOT_MASK);
+    Node&             node = _nodes[key];
+    node.expiry            = expiry;
+    node.slot              = slot;
+    node.prev              = NONE;
+    node.next              = _heads[slot];
+    if (node.next != NONE)
+        _nodes[node.next].prev = key;
+    _heads[slot] = key;
+    ++_counts[level];
+    ++_size;
+}
+
+void TimerWheel::unlink(std::size_t key) noexcept {
+    Node& node = _nodes[key];
+    if (node.slot == NONE)
+        return;
+    if (node.prev != NONE)
+        _nodes[node.prev].next = node.next;
+    else
+        _heads[node.slot] = node.next;
+    if (node.next != NONE)
+        _nodes[node.next].prev = node.prev;
+    --_counts[node.slot / SLOTS];
+    --_size;
+    node.prev = NONE;
+    node.next = NONE;
+    node.slot = NONE;
+}
+
+// Every timer of the slot now lies within reach of a finer wheel
+void TimerWheel::cascade(std::size_t level) {
+    const std::size_t slot = level * SLOTS + ((_current >> (SLOT_BITS * level)) & SLOT_MASK);
+    _cascade.clear();
+    for (std::size_t key = _heads[slot]; key != NONE; key = _nodes[key].next)
+        _cascade.push_back(key);
+    for (std::size_t key : _cascade) {
+        const std::uint64_t expiry = _nodes[key].expiry;
+        unlink(key);
+        link(key, expiry);
+    }
+}
+
+// First tick that fires a slot or cascades a non-empty one; a round end bounds wrapped slots
+std::uint64_t TimerWheel::nextTick() const noexcept {
+    if (_size == 0)
+        return UINT64_MAX;
+    for (std::size_t level = 0; level < LEVELS; ++level) {
+        const unsigned      shift = SLOT_BITS * static_cast<unsigned>(level);
+        const std::uint64_t span  = std::uint64_t(1) << shift;
+        const std::uint64_t end   = ((_current >> (shift + SLOT_BITS)) + 1) << (shift + SLOT_BITS);
+        const std::uint64_t first = (_current + span - 1) >> shift << shift;
+        for (std::uint64_t tick = first; tick < end; tick += span) {
+            if (_heads[level * SLOTS + ((tick >> shift) & SLOT_MASK)] != NONE)
+                return tick;
+        }
+        if (_counts[level])
+            return end;
+    }
+    return UINT64_MAX;
+}
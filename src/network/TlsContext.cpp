@@ -0,0 +1,266 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TlsContext.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 05:02:58 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:02:58 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    TlsContext.cpp
+ * @brief   Implements TlsContext and TlsSession over OpenSSL.
+ *
+ * @ingroup network
+ */
+
+#include "network/TlsContext.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+
+#ifdef WEBSERV_HAVE_OPENSSL
+# include <openssl/bio.h>
+# include <openssl/err.h>
+# include <openssl/ssl.h>
+#endif
+
+TlsContext::TlsError::TlsError(const std::string& msg) : std::runtime_error(msg) {
+}
+
+#ifdef WEBSERV_HAVE_OPENSSL
+
+namespace {
+
+// The oldest queued OpenSSL error, which names the cause rather than its consequences
+std::string lastError(const std::string& what) {
+    const unsigned long code = ERR_peek_error();
+    ERR_clear_error();
+    if (!code)
+        return what;
+    char reason[256];
+    ERR_error_string_n(code, reason, sizeof(reason));
+    return what + ": " + reason;
+}
+
+} // namespace
+
+// --- TlsContext ---
+
+TlsContext::TlsContext(const Server& server) : _ctx(SSL_CTX_new(TLS_server_method())) {
+    if (!_ctx)
+        throw TlsError(lastError("TLS: cannot create a context"));
+    SSL_CTX_set_min_proto_version(_ctx, TLS1_2_VERSION);
+    SSL_CTX_set_options(_ctx, SSL_OP_NO_RENEGOTIATION | SSL_OP_CIPHER_SERVER_PREFERENCE);
+# ifdef SSL_OP_IGNORE_UNEXPECTED_EOF
+    SSL_CTX_set_options(_ctx, SSL_OP_IGNORE_UNEXPECTED_EOF); // Most clients just close
+# endif
+# ifdef SSL_OP_ENABLE_KTLS
+    SSL_CTX_set_options(_ctx, SSL_OP_ENABLE_KTLS); // Used if the kernel and the cipher allow
+# endif
+    // Writes resume from wherever the queue holds the bytes; idle sessions free their buffers
+    SSL_CTX_set_mode(_ctx, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER |
+                               SSL_MODE_RELEASE_BUFFERS);
+
+    const std::string& certificate = server.getSslCertificate();
+    const std::string& key         = server.getSslCertificateKey();
+    if (SSL_CTX_use_certificate_chain_file(_ctx, certificate.c_str()) != 1) {
+        SSL_CTX_free(_ctx);
+        throw TlsError(lastError("TLS: cannot load certificate \"" + certificate + "\""));
+    }
+    if (SSL_CTX_use_PrivateKey_file(_ctx, key.c_str(), SSL_FILETYPE_PEM) != 1 ||
+        SSL_CTX_check_private_key(_ctx) != 1) {
+        SSL_CTX_free(_ctx);
+        throw TlsError(lastError("TLS: cannot use key \"" + key + "\""));
+    }
+
+    // Resumption skips the key exchange and the certificate: one round trip, little CPU
+    static const unsigned char SESSION_CONTEXT[] = "webserv";
+    SSL_CTX_set_session_id_context(_ctx, SESSION_CONTEXT, sizeof(SESSION_CONTEXT) - 1);
+    SSL_CTX_set_timeout(_ctx, static_cast<long>(std::min<std::size_t>(
+                                  server.getSslSessionTimeout(), LONG_MAX)));
+    if (server.getSslSessionCache() > 0) {
+        SSL_CTX_set_session_cache_mode(_ctx, SSL_SESS_CACHE_SERVER);
+        SSL_CTX_sess_set_cache_size(_ctx, static_cast<long>(server.getSslSessionCache()));
+    } else {
+        SSL_CTX_set_session_cache_mode(_ctx, SSL_SESS_CACHE_OFF);
+    }
+    if (!server.isSslSessionTickets()) {
+        SSL_CTX_set_options(_ctx, SSL_OP_NO_TICKET);
+        if (server.getSslSessionCache() == 0)
+            SSL_CTX_set_num_tickets(_ctx, 0); // TLS 1.3 would send tickets nobody can use
+    }
+}
+
+TlsContext::~TlsContext() {
+    SSL_CTX_free(_ctx);
+}
+
+bool TlsContext::isAvailable() noexcept {
+    return true;
+}
+
+// --- TlsSession ---
+
+TlsSession::TlsSession(const TlsContext& context, int fd)
+    : _ssl(SSL_new(context._ctx)), _established(false), _want_write(false),
+      _kernel_send(false) {
+    if (!_ssl)
+        throw TlsContext::TlsError(lastError("TLS: cannot create a session"));
+    if (SSL_set_fd(_ssl, fd) != 1) {
+        SSL_free(_ssl);
+        throw TlsContext::TlsError(lastError("TLS: cannot attach the socket"));
+    }
+    SSL_set_accept_state(_ssl);
+}
+
+TlsSession::~TlsSession() {
+    SSL_free(_ssl);
+}
+
+int TlsSession::handshake() {
+    if (_established)
+        return 1;
+    ERR_clear_error();
+    const int result = SSL_do_handshake(_ssl);
+    if (result != 1) {
+        if (fail(result) == 0)
+            errno = ECONNRESET; // Closed in the middle of it
+        return -1;
+    }
+    _established = true;
+    _want_write  = false;
+# ifdef BIO_get_ktls_send
+    _kernel_send = BIO_get_ktls_send(SSL_get_wbio(_ssl)) > 0;
+# endif
+    return 1;
+}
+
+ssize_t TlsSession::read(void* buffer, std::size_t size) {
+    ERR_clear_error();
+    const int result =
+        SSL_read(_ssl, buffer, static_cast<int>(std::min<std::size_t>(size, INT_MAX)));
+    if (result > 0)
+        return result;
+    return fail(result);
+}
+
+ssize_t TlsSession::write(const void* buffer, std::size_t size) {
+    if (size == 0)
+        return 0;
+    ERR_clear_error();
+    const int result =
+        SSL_write(_ssl, buffer, static_cast<int>(std::min<std::size_t>(size, INT_MAX)));
+    if (result > 0)
+        return result;
+    if (fail(result) == 0)
+        errno = EPIPE; // The peer sent close_notify
+    return -1;
+}
+
+void TlsSession::shutdown() noexcept {
+    if (!_established)
+        return;
+    ERR_clear_error();
+    SSL_shutdown(_ssl); // One attempt: the socket is closed next either way
+    ERR_clear_error();
+}
+
+// Translates an OpenSSL failure into the errno of the system call it stands for
+int TlsSession::fail(int result) {
+    switch (SSL_get_error(_ssl, result)) {
+        case SSL_ERROR_WANT_READ:
+            _want_write = false;
+            errno       = EAGAIN;
+            return -1;
+        case SSL_ERROR_WANT_WRITE:
+            _want_write = true;
+            errno       = EAGAIN;
+            return -1;
+        case SSL_ERROR_ZERO_RETURN: return 0;
+        case SSL_ERROR_SYSCALL:
+            if (errno == 0 || errno == EAGAIN)
+                errno = ECONNRESET;
+            break;
+        default: errno = ECONNRESET; break; // Protocol error: nothing sensible to recover
+    }
+    ERR_clear_error();
+    return -1;
+}
+
+bool TlsSession::isResumed() const noexcept {
+    return SSL_session_reused(_ssl) == 1;
+}
+
+bool TlsSession::hasPending() const noexcept {
+    return SSL_pending(_ssl) > 0;
+}
+
+#else
+
+TlsContext::TlsContext(const Server& server) : _ctx(NULL) {
+    throw TlsError("TLS: built without OpenSSL, cannot serve \"" + server.getSslCertificate() +
+                   "\"");
+}
+
+TlsContext::~TlsContext() {
+}
+
+bool TlsContext::isAvailable() noexcept {
+    return false;
+}
+
+TlsSession::TlsSession(const TlsContext&, int)
+    : _ssl(NULL), _established(false), _want_write(false), _kernel_send(false) {
+    throw TlsContext::TlsError("TLS: built without OpenSSL");
+}
+
+TlsSession::~TlsSession() {
+}
+
+int TlsSession::handshake() {
+    errno = ENOTSUP;
+    return -1;
+}
+
+ssize_t TlsSession::read(void*, std::size_t) {
+    errno = ENOTSUP;
+    return -1;
+}
+
+ssize_t TlsSession::write(const void*, std::size_t) {
+    errno = ENOTSUP;
+    return -1;
+}
+
+void TlsSession::shutdown() noexcept {
+}
+
+int TlsSession::fail(int) {
+    return -1;
+}
+
+bool TlsSession::isResumed() const noexcept {
+    return false;
+}
+
+bool TlsSession::hasPending() const noexcept {
+    return false;
+}
+
+#endif
+
+bool TlsSession::isEstablished() const noexcept {
+    return _established;
+}
+
+bool TlsSession::wantsWrite() const noexcept {
+    return _want_write;
+}
+
+bool TlsSession::isKernelSend() const noexcept {
+    return _kernel_send;
+}
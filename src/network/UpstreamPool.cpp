@@ -0,0 +1,786 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamPool.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:25:50 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:25:50 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    UpstreamPool.cpp
+ * @brief   Implements the UpstreamPool and UpstreamStream classes.
+ *
+ * @details As in FastCgiPool, links (upstream connections) are never destroyed
+ * while a caller may still hold them: closing one only closes its socket, and the
+ * dead links are pruned at the pool's entry points.
+ *
+ * @ingroup network
+ */
+
+#include "network/UpstreamPool.hpp"
+#include "cgi/CgiOutputParser.hpp"
+#include "network/SocketAddress.hpp"
+#include "utils/Logger.hpp"
+#include "utils/StringUtils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t READ_CHUNK = 16384; ///< Bytes requested per recv() from an upstream.
+
+/// Fields that describe one connection, not the message (RFC 9110, section 7.6.1).
+constexpr std::string_view HOP_BY_HOP[] = {"Connection", "Keep-Alive",        "Proxy-Connection",
+                                           "TE",         "Trailer",           "Transfer-Encoding",
+                                           "Upgrade",    "Proxy-Authorization"};
+
+bool isHopByHop(std::string_view name) noexcept {
+    for (std::string_view field : HOP_BY_HOP) {
+        if (iequals(name, field))
+            return true;
+    }
+    return false;
+}
+
+// "close, X-Private" names more fields to drop, and options such as close
+bool listsToken(std::string_view list, std::string_view token) noexcept {
+    while (!list.empty()) {
+        const std::size_t comma = list.find(',');
+        if (iequals(trim(list.substr(0, comma)), token))
+            return true;
+        list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+    }
+    return false;
+}
+
+} // namespace
+
+/// One upstream connection; it carries one request at a time.
+struct UpstreamPool::Link {
+    Peer*                         peer;       ///< Server the link connects to.
+    int                           fd;         ///< Socket, -1 once closed.
+    bool                          connected;  ///< Non-blocking connect() finished.
+    bool                          reused;     ///< Taken from the idle links for this request.
+    std::uint32_t                 interest;   ///< Registered PollManager interest.
+    CgiChannel::Clock::time_point idle_since; ///< When the last request ended.
+    UpstreamStream*               stream;     ///< Request carried, NULL while idle.
+};
+
+// --- UpstreamPool ---
+
+constexpr std::size_t UpstreamPool::MAX_IDLE;
+constexpr std::size_t UpstreamPool::MAX_FAILS;
+constexpr std::size_t UpstreamPool::SEND_BUFFER;
+constexpr std::size_t UpstreamPool::OUTPUT_BUFFER;
+
+UpstreamPool::UpstreamPool(PollManager& poller) : _poller(poller) {
+}
+
+UpstreamPool::~UpstreamPool() {
+    // Streams that outlive the pool must not call back into it
+    for (auto& entry : _groups) {
+        for (Peer& peer : entry.second->peers) {
+            for (std::unique_ptr<Link>& link : peer.links) {
+                if (UpstreamStream* stream = link->stream) {
+                    stream->_error = ECANCELED;
+                    stream->_link  = NULL;
+                    stream->_peer  = NULL;
+                }
+                if (link->fd >= 0)
+                    closeLink(*link);
+            }
+        }
+    }
+}
+
+std::unique_ptr<UpstreamStream> UpstreamPool::open(const std::string& upstreams,
+                                                   ProxyBalance balance, int owner,
+                                                   std::string head, bool chunked,
+                                                   bool head_only) {
+    Group* group = findGroup(upstreams);
+    if (!group) {
+        errno = EINVAL;
+        return NULL;
+    }
+    for (Peer& peer : group->peers)
+        prune(peer);
+    std::unique_ptr<UpstreamStream> stream(
+        new UpstreamStream(*this, *group, balance, owner, std::move(head), chunked, head_only));
+    schedule(*stream);
+    return stream;
+}
+
+bool UpstreamPool::handleEvent(int fd, std::uint32_t events) {
+    const std::size_t slot = static_cast<std::size_t>(fd);
+    if (fd < 0 || slot >= _by_fd.size() || !_by_fd[slot])
+        return false;
+    Link& link = *_by_fd[slot];
+    Peer& peer = *link.peer;
+
+    if (!link.stream) {
+        // Idle: the upstream closed the connection, or sent bytes nobody asked for
+        char          byte;
+        const ssize_t n = recv(fd, &byte, 1, MSG_PEEK);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+            return true;
+        closeLink(link);
+        prune(peer);
+        return true;
+    }
+    UpstreamStream& stream = *link.stream;
+    if (!link.connected) {
+        int       error  = 0;
+        socklen_t length = sizeof(error);
+        if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) < 0)
+            error = errno;
+        if (error) {
+            stream.fail(error);
+            prune(peer);
+            return true;
+        }
+        if (events & (PollManager::EVENT_WRITE | PollManager::EVENT_HUP |
+                      PollManager::EVENT_ERROR))
+            link.connected = true;
+    }
+    stream.onEvent(events);
+    prune(peer);
+    return true;
+}
+
+bool UpstreamPool::takeWoken(std::vector<int>& owners) {
+    owners.clear();
+    owners.swap(_woken);
+    return !owners.empty();
+}
+
+void UpstreamPool::closeIdle(CgiChannel::Clock::time_point now) {
+    for (auto& entry : _groups) {
+        for (Peer& peer : entry.second->peers) {
+            for (std::unique_ptr<Link>& link : peer.links) {
+                if (link->fd >= 0 && !link->stream &&
+                    now - link->idle_since >= std::chrono::seconds(IDLE_TIMEOUT))
+                    closeLink(*link);
+            }
+            prune(peer);
+        }
+    }
+}
+
+std::size_t UpstreamPool::getConnectionCount() const noexcept {
+    std::size_t count = 0;
+    for (const auto& entry : _groups) {
+        for (const Peer& peer : entry.second->peers) {
+            for (const std::unique_ptr<Link>& link : peer.links)
+                count += link->fd >= 0;
+        }
+    }
+    return count;
+}
+
+std::size_t UpstreamPool::getIdleCount() const noexcept {
+    std::size_t count = 0;
+    for (const auto& entry : _groups) {
+        for (const Peer& peer : entry.second->peers) {
+            for (const std::unique_ptr<Link>& link : peer.links)
+                count += link->fd >= 0 && !link->stream;
+        }
+    }
+    return count;
+}
+
+// The client's head minus what belongs to its connection, plus the forwarding fields
+std::string UpstreamPool::makeRequestHead(const HttpRequest& request,
+                                          std::string_view   client_addr,
+                                          std::string_view default_host, bool& chunked) {
+    const std::string_view connection = request.getHeader("Connection");
+    std::string            head;
+    std::string            forwarded;
+    bool                   has_host = false;
+    head.reserve(512);
+    head.append(request.getMethodName()).append(" ");
+    head.append(request.getTarget()).append(" HTTP/1.1\r\n");
+    for (std::size_t i = 0; i < request.getHeaderCount(); ++i) {
+        const std::string_view name  = request.getHeaderName(i);
+        const std::string_view value = request.getHeaderValue(i);
+        if (isHopByHop(name) || listsToken(connection, name) ||
+            iequals(name, "Content-Length") || iequals(name, "Expect") ||
+            iequals(name, "X-Forwarded-Proto"))
+            continue; // Framing is redone below; 100-continue was answered already
+        if (iequals(name, "X-Forwarded-For")) {
+            forwarded.append(forwarded.empty() ? "" : ", ").append(value);
+            continue;
+        }
+        has_host = has_host || iequals(name, "Host");
+        head.append(name).append(": ").append(value).append("\r\n");
+    }
+    if (!has_host && !default_host.empty())
+        head.append("Host: ").append(default_host).append("\r\n");
+    if (!client_addr.empty())
+        forwarded.append(forwarded.empty() ? "" : ", ").append(client_addr);
+    if (!forwarded.empty())
+        head.append("X-Forwarded-For: ").append(forwarded).append("\r\n");
+    head.append("X-Forwarded-Proto: http\r\n");
+
+    chunked = false;
+    if (request.hasContentLength()) {
+        head.append("Content-Length: ").append(std::to_string(request.getContentLength()));
+        head.append("\r\n");
+    } else if (request.isChunked()) {
+        head.append("Transfer-Encoding: chunked\r\n");
+        chunked = true;
+    }
+    head.append("\r\n");
+    return head;
+}
+
+UpstreamPool::Group* UpstreamPool::findGroup(const std::string& upstreams) {
+    auto found = _groups.find(upstreams);
+    if (found != _groups.end())
+        return found->second.get();
+    std::unique_ptr<Group> group(new Group());
+    group->next = 0;
+    std::string_view rest = upstreams;
+    while (!rest.empty()) {
+        const std::size_t      space   = rest.find(' ');
+        const std::string_view address = rest.substr(0, space);
+        rest = space == std::string_view::npos ? std::string_view() : rest.substr(space + 1);
+        if (address.empty())
+            continue;
+        Peer peer;
+        if (!parseSocketAddress(address, peer.addr, peer.length))
+            return NULL;
+        peer.address = std::string(address);
+        peer.active  = 0;
+        peer.fails   = 0;
+        group->peers.push_back(std::move(peer));
+    }
+    if (group->peers.empty())
+        return NULL;
+    Group* raw = group.get();
+    _groups.emplace(upstreams, std::move(group));
+    return raw;
+}
+
+// Servers that failed recently are skipped, unless all of them did
+UpstreamPool::Peer* UpstreamPool::pick(Group& group, ProxyBalance balance,
+                                       CgiChannel::Clock::time_point now) {
+    const std::size_t count = group.peers.size();
+    bool              any_up = false;
+    for (const Peer& peer : group.peers)
+        any_up = any_up || peer.down_until <= now;
+
+    // Both start where the last pick ended, so least_conn ties rotate too
+    Peer*       best   = NULL;
+    std::size_t chosen = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t index = (group.next + i) % count;
+        Peer&             peer  = group.peers[index];
+        if (any_up && peer.down_until > now)
+            continue;
+        if (!best || (balance == ProxyBalance::LEAST_CONN && peer.active < best->active)) {
+            best   = &peer;
+            chosen = index;
+        }
+        if (balance == ProxyBalance::ROUND_ROBIN)
+            break;
+    }
+    group.next = (chosen + 1) % count;
+    return best;
+}
+
+// An idle link of the chosen server, else a new one; connect errors try another server
+void UpstreamPool::schedule(UpstreamStream& stream) {
+    Group& group = stream._group;
+    for (;;) {
+        Peer& peer = *pick(group, stream._balance, CgiChannel::Clock::now());
+        Link* link = idleLink(peer);
+        if (!link)
+            link = connectLink(peer);
+        if (link) {
+            attach(*link, stream);
+            return;
+        }
+        const int error = errno;
+        LOG_ERROR("Proxy: connect() to %s failed: %s", peer.address.c_str(), strerror(error));
+        recordFailure(peer);
+        if (++stream._attempts >= group.peers.size()) {
+            stream._error = error;
+            wake(stream);
+            return;
+        }
+    }
+}
+
+void UpstreamPool::attach(Link& link, UpstreamStream& stream) {
+    link.stream    = &stream;
+    stream._link   = &link;
+    stream._peer   = link.peer;
+    stream._sent   = 0;
+    ++link.peer->active;
+    wake(stream); // Body bytes can be written now
+    stream.flush();
+}
+
+// The most recently used idle link: the least likely to have been closed by the upstream
+UpstreamPool::Link* UpstreamPool::idleLink(Peer& peer) {
+    Link* found = NULL;
+    for (std::unique_ptr<Link>& link : peer.links) {
+        if (link->fd >= 0 && !link->stream && link->connected &&
+            (!found || link->idle_since >= found->idle_since))
+            found = link.get();
+    }
+    if (found)
+        found->reused = true;
+    return found;
+}
+
+UpstreamPool::Link* UpstreamPool::connectLink(Peer& peer) {
+    const int fd = socket(peer.addr.ss_family, SOCK_STREAM, 0);
+    if (fd < 0)
+        return NULL;
+    if (fcntl(fd, F_SETFL, O_NONBLOCK) < 0 || fcntl(fd, F_SETFD, FD_CLOEXEC) < 0 ||
+        (connect(fd, reinterpret_cast<const sockaddr*>(&peer.addr), peer.length) < 0 &&
+         errno != EINPROGRESS)) {
+        const int saved = errno;
+        close(fd);
+        errno = saved;
+        return NULL;
+    }
+
+    std::unique_ptr<Link> link(new Link());
+    link->peer       = &peer;
+    link->fd         = fd;
+    link->connected  = false; // Confirmed by the first write event, even for local sockets
+    link->reused     = false;
+    link->interest   = PollManager::EVENT_WRITE;
+    link->idle_since = CgiChannel::Clock::now();
+    link->stream     = NULL;
+    try {
+        _poller.add(fd, link->interest);
+    } catch (const PollManager::PollError& e) {
+        LOG_ERROR("%s", e.what());
+        close(fd);
+        errno = EIO;
+        return NULL;
+    }
+    const std::size_t slot = static_cast<std::size_t>(fd);
+    if (slot >= _by_fd.size())
+        _by_fd.resize(slot + 1, NULL);
+    _by_fd[slot] = link.get();
+    peer.links.push_back(std::move(link));
+    return peer.links.back().get();
+}
+
+// Kept for the next request while the server has room for it, closed otherwise
+void UpstreamPool::release(Link& link, bool reusable) {
+    Peer& peer  = *link.peer;
+    link.stream = NULL;
+    --peer.active;
+    std::size_t idle = 0;
+    for (const std::unique_ptr<Link>& other : peer.links)
+        idle += other->fd >= 0 && !other->stream;
+    if (!reusable || idle > MAX_IDLE) {
+        closeLink(link);
+        return;
+    }
+    link.idle_since = CgiChannel::Clock::now();
+    updateInterest(link);
+}
+
+void UpstreamPool::closeLink(Link& link) {
+    _poller.remove(link.fd);
+    close(link.fd);
+    _by_fd[static_cast<std::size_t>(link.fd)] = NULL;
+    link.fd = -1;
+}
+
+void UpstreamPool::prune(Peer& peer) {
+    peer.links.erase(std::remove_if(peer.links.begin(), peer.links.end(),
+                                    [](const std::unique_ptr<Link>& link) {
+                                        return link->fd < 0;
+                                    }),
+                     peer.links.end());
+}
+
+// Connecting: wait for writability; idle: watch for a close; busy: read unless the
+// output is full, write while request bytes wait
+void UpstreamPool::updateInterest(Link& link) {
+    if (link.fd < 0)
+        return;
+    std::uint32_t interest = PollManager::EVENT_WRITE;
+    if (link.connected && !link.stream) {
+        interest = PollManager::EVENT_READ;
+    } else if (link.connected) {
+        const UpstreamStream& stream = *link.stream;
+        interest = stream._output.size() - stream._output_read < OUTPUT_BUFFER
+                       ? PollManager::EVENT_READ
+                       : 0;
+        if (stream.queuedBytes() > 0)
+            interest |= PollManager::EVENT_WRITE;
+    }
+    if (interest != link.interest) {
+        _poller.modify(link.fd, interest); // Re-arming reports the bytes left in the socket
+        link.interest = interest;
+    }
+}
+
+void UpstreamPool::recordFailure(Peer& peer) {
+    if (++peer.fails < MAX_FAILS)
+        return;
+    LOG_WARN("Proxy: %s failed %zu times, skipped for %lds", peer.address.c_str(), peer.fails,
+             FAIL_TIMEOUT);
+    peer.fails      = 0;
+    peer.down_until = CgiChannel::Clock::now() + std::chrono::seconds(FAIL_TIMEOUT);
+}
+
+void UpstreamPool::wake(UpstreamStream& stream) {
+    _woken.push_back(stream._owner);
+}
+
+// --- UpstreamStream ---
+
+UpstreamStream::UpstreamStream(UpstreamPool& pool, UpstreamPool::Group& group,
+                               ProxyBalance balance, int owner, std::string head, bool chunked,
+                               bool head_only)
+    : _pool(pool), _group(group), _peer(NULL), _link(NULL), _balance(balance), _owner(owner),
+      _out(std::move(head)), _sent(0), _output_read(0), _body_left(0), _attempts(0),
+      _framing(Framing::NONE), _chunked(chunked), _head_only(head_only), _replayable(true),
+      _responded(false), _reusable(false), _input_open(true), _ended(false), _want_write(false),
+      _error(0), _started(Clock::now()) {
+}
+
+UpstreamStream::~UpstreamStream() {
+    if (_link)
+        _pool.release(*_link, false);
+}
+
+ssize_t UpstreamStream::writeInput(const char* data, std::size_t size) noexcept {
+    if (_error || _ended || !_input_open) {
+        errno = EPIPE; // The upstream answered without reading the whole body
+        return -1;
+    }
+    const std::size_t queued = _link ? queuedBytes() : UpstreamPool::SEND_BUFFER;
+    if (queued >= UpstreamPool::SEND_BUFFER) {
+        _want_write = true;
+        errno       = EAGAIN;
+        return -1;
+    }
+    const std::size_t accepted = std::min(size, UpstreamPool::SEND_BUFFER - queued);
+    if (_chunked)
+        _out.append(_encoder.chunkHead(accepted));
+    _out.append(data, accepted);
+    if (_chunked)
+        _out.append(ChunkedEncoder::CHUNK_END);
+    flush();
+    return static_cast<ssize_t>(accepted);
+}
+
+ssize_t UpstreamStream::readOutput(char* buf, std::size_t size) noexcept {
+    const std::size_t unread = _output.size() - _output_read;
+    if (unread > 0) {
+        const std::size_t n = std::min(size, unread);
+        std::memcpy(buf, _output.data() + _output_read, n);
+        _output_read += n;
+        if (_output_read == _output.size()) {
+            _output.clear();
+            _output_read = 0;
+        }
+        if (_link)
+            _pool.updateInterest(*_link); // Resumes reading once there is room again
+        return static_cast<ssize_t>(n);
+    }
+    if (_error) {
+        errno = _error;
+        return -1;
+    }
+    if (_ended)
+        return 0;
+    errno = EAGAIN;
+    return -1;
+}
+
+void UpstreamStream::closeInput() noexcept {
+    if (!_input_open)
+        return;
+    _input_open = false;
+    if (_chunked && !_error && !_ended) {
+        _out.append(_encoder.finish());
+        if (_link)
+            flush();
+    }
+}
+
+bool UpstreamStream::hasInput() const noexcept {
+    return _input_open && !_error && !_ended;
+}
+
+void UpstreamStream::terminate() noexcept {
+    if (_ended || _error)
+        return;
+    if (_link) {
+        _pool.release(*_link, false);
+        _link = NULL;
+        _peer = NULL;
+    }
+    _error = ECANCELED;
+}
+
+CgiChannel::Clock::time_point UpstreamStream::getStartTime() const noexcept {
+    return _started;
+}
+
+int UpstreamStream::getOwner() const noexcept {
+    return _owner;
+}
+
+void UpstreamStream::onEvent(std::uint32_t events) {
+    UpstreamPool::Link* link = _link;
+    if (link->connected &&
+        (events & (PollManager::EVENT_READ | PollManager::EVENT_HUP | PollManager::EVENT_ERROR)))
+        receive();
+    if (_link == link)
+        flush();
+}
+
+// Sent bytes are kept while the request may be replayed on another connection
+void UpstreamStream::flush() {
+    UpstreamPool::Link& link = *_link;
+    if (!link.connected) {
+        _pool.updateInterest(link);
+        return;
+    }
+    while (_sent < _out.size()) {
+        const ssize_t n = send(link.fd, _out.data() + _sent, _out.size() - _sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (n < 0) {
+            fail(errno);
+            return;
+        }
+        _sent += static_cast<std::size_t>(n);
+    }
+    if (_sent == _out.size() && !_replayable) {
+        _out.clear();
+        _sent = 0;
+    } else if (_sent >= UpstreamPool::SEND_BUFFER) {
+        _out.erase(0, _sent);
+        _sent       = 0;
+        _replayable = false;
+    }
+    if (_want_write && queuedBytes() < UpstreamPool::SEND_BUFFER) {
+        _want_write = false;
+        _pool.wake(*this);
+    }
+    _pool.updateInterest(link);
+}
+
+void UpstreamStream::receive() {
+    char buf[READ_CHUNK];
+    while (_link && _output.size() - _output_read < UpstreamPool::OUTPUT_BUFFER) {
+        const ssize_t n = recv(_link->fd, buf, sizeof(buf), 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (n < 0) {
+            fail(errno);
+            return;
+        }
+        if (n == 0) {
+            if (_responded && _framing == Framing::CLOSE)
+                finish();
+            else
+                fail(ECONNRESET); // Before the head, or short of the announced body
+            return;
+        }
+        if (_responded) {
+            if (!parseBody(buf, static_cast<std::size_t>(n)))
+                return;
+            continue;
+        }
+        _in.append(buf, static_cast<std::size_t>(n));
+        if (!parseHead()) {
+            LOG_WARN("Proxy: malformed response from %s", _peer->address.c_str());
+            fail(EPROTO);
+            return;
+        }
+        if (!_responded)
+            continue;
+        std::string body;
+        body.swap(_in);
+        if (!parseBody(&body[0], body.size()))
+            return;
+    }
+    if (_link)
+        _pool.updateInterest(*_link);
+}
+
+// Turns the status line and fields into a CGI header block; leaves the body in _in
+bool UpstreamStream::parseHead() {
+    for (;;) {
+        std::size_t end = _in.find("\r\n\r\n");
+        if (end == std::string::npos)
+            return _in.size() <= CgiOutputParser::MAX_HEAD_SIZE;
+        const std::string_view head(_in.data(), end);
+
+        // "HTTP/1.1 200 OK"
+        const std::size_t      eol   = head.find("\r\n");
+        const std::string_view line  = head.substr(0, eol);
+        std::size_t            status = 0;
+        if (line.size() < 12 || line.compare(0, 7, "HTTP/1.") != 0 || line[8] != ' ' ||
+            !parseSize(line.substr(9, 3), status) || status < 100 || status > 599 ||
+            (line.size() > 12 && line[12] != ' '))
+            return false;
+        const bool http11 = line[7] != '0';
+        if (status < 200) {
+            if (status == 101)
+                return false; // Upgrades are not relayed
+            _in.erase(0, end + 4); // Interim response: the final one follows
+            continue;
+        }
+
+        std::string_view fields = eol == std::string_view::npos ? std::string_view()
+                                                                : head.substr(eol + 2);
+        std::string_view connection;
+        std::string      block = "Status: " + std::string(line.substr(9)) + "\r\n";
+        bool             chunked    = false;
+        bool             has_length = false;
+        std::size_t      length     = 0;
+        while (!fields.empty()) {
+            const std::size_t      next  = fields.find("\r\n");
+            const std::string_view field = fields.substr(0, next);
+            fields = next == std::string_view::npos ? std::string_view() : fields.substr(next + 2);
+            const std::size_t colon = field.find(':');
+            if (colon == std::string_view::npos || colon == 0)
+                return false;
+            const std::string_view name  = field.substr(0, colon);
+            const std::string_view value = trim(field.substr(colon + 1));
+            if (iequals(name, "Connection"))
+                connection = value;
+            if (iequals(name, "Transfer-Encoding")) {
+                chunked = listsToken(value, "chunked");
+                if (!chunked)
+                    return false; // Only chunked framing can be undone here
+            } else if (iequals(name, "Content-Length")) {
+                std::size_t announced = 0;
+                if (!parseSize(value, announced) || (has_length && announced != length))
+                    return false;
+                length     = announced;
+                has_length = true;
+            }
+            // A Status field would be taken for the status line by the CGI parser
+            if (isHopByHop(name) || iequals(name, "Content-Length") || iequals(name, "Status"))
+                continue;
+            block.append(name).append(": ").append(value).append("\r\n");
+        }
+        if (!chunked && has_length)
+            block.append("Content-Length: ").append(std::to_string(length)).append("\r\n");
+        block.append("\r\n");
+
+        if (_head_only || status == 204 || status == 304)
+            _framing = Framing::NONE;
+        else if (chunked)
+            _framing = Framing::CHUNKED;
+        else if (has_length)
+            _framing = Framing::LENGTH;
+        else
+            _framing = Framing::CLOSE;
+        _body_left = length;
+        _reusable  = _framing != Framing::CLOSE && !listsToken(connection, "close") &&
+                    (http11 || listsToken(connection, "keep-alive"));
+        _in.erase(0, end + 4);
+        _output.append(block);
+        _responded  = true;
+        _replayable = false;
+        _peer->fails = 0;
+        _pool.wake(*this);
+        return true;
+    }
+}
+
+// Strips the upstream's framing; returns false once the stream ended or failed
+bool UpstreamStream::parseBody(char* data, std::size_t size) {
+    switch (_framing) {
+        case Framing::NONE:
+            _reusable = _reusable && size == 0;
+            finish();
+            return false;
+        case Framing::LENGTH: {
+            const std::size_t n = std::min(size, _body_left);
+            _output.append(data, n);
+            _body_left -= n;
+            _reusable = _reusable && n == size;
+            if (_body_left == 0) {
+                finish();
+                return false;
+            }
+            break;
+        }
+        case Framing::CHUNKED: {
+            std::size_t                  decoded  = size;
+            std::size_t                  consumed = 0;
+            const ChunkedDecoder::Result result   = _decoder.decode(data, decoded, consumed);
+            if (result == ChunkedDecoder::Result::ERROR) {
+                LOG_WARN("Proxy: malformed chunked body from %s", _peer->address.c_str());
+                fail(EPROTO);
+                return false;
+            }
+            _output.append(data, decoded);
+            if (result == ChunkedDecoder::Result::DONE) {
+                _reusable = _reusable && consumed == size;
+                finish();
+                return false;
+            }
+            break;
+        }
+        case Framing::CLOSE: _output.append(data, size); break;
+    }
+    if (size > 0)
+        _pool.wake(*this);
+    return true;
+}
+
+// A link is reused only if both messages ended cleanly on it
+void UpstreamStream::finish() {
+    _ended = true;
+    _pool.release(*_link, _reusable && !_input_open && queuedBytes() == 0);
+    _link = NULL;
+    _peer = NULL;
+    _pool.wake(*this);
+}
+
+// Replays the request elsewhere while that is still possible
+void UpstreamStream::fail(int error) {
+    UpstreamPool::Link& link  = *_link;
+    UpstreamPool::Peer& peer  = *_peer;
+    const bool          stale = link.reused && !_responded && _in.empty();
+    _pool.release(link, false);
+    _link = NULL;
+    _peer = NULL;
+    if (!stale) {
+        _pool.recordFailure(peer);
+        ++_attempts;
+    }
+    if (_replayable && (stale || _attempts < _group.peers.size())) {
+        if (!stale)
+            LOG_WARN("Proxy: %s failed: %s; trying again", peer.address.c_str(), strerror(error));
+        _pool.schedule(*this);
+        return;
+    }
+    LOG_ERROR("Proxy: %s failed: %s", peer.address.c_str(), strerror(error));
+    _error = error;
+    _pool.wake(*this);
+}
+
+std::size_t UpstreamStream::queuedBytes() const noexcept {
+    return _out.size() - _sent;
+}
@@ -0,0 +1,288 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UringManager.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 03:29:26 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 03:29:26 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    UringManager.cpp
+ * @brief   Implements the io_uring event backend.
+ *
+ * @ingroup network
+ */
+
+#include "network/UringManager.hpp"
+
+#if defined(__linux__) && defined(WEBSERV_HAVE_IO_URING)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr unsigned      SQ_ENTRIES = 256;  ///< Changes queued before an early submit.
+constexpr unsigned      CQ_ENTRIES = 4096; ///< Completions held between two waits.
+constexpr std::uint64_t CANCEL_TAG = ~std::uint64_t(0); ///< Completions of removals.
+
+// Completions name their descriptor and the request that watched it
+std::uint64_t tag(int fd, std::uint32_t generation) noexcept {
+    return std::uint64_t(generation) << 32 | static_cast<std::uint32_t>(fd);
+}
+
+std::uint32_t toPoll(std::uint32_t interest) noexcept {
+    std::uint32_t mask = POLLRDHUP; // Errors and hang-ups are always reported
+    if (interest & PollManager::EVENT_READ)
+        mask |= POLLIN;
+    if (interest & PollManager::EVENT_WRITE)
+        mask |= POLLOUT;
+    return mask;
+}
+
+std::uint32_t fromPoll(std::uint32_t mask) noexcept {
+    std::uint32_t events = 0;
+    if (mask & POLLIN)
+        events |= PollManager::EVENT_READ;
+    if (mask & POLLOUT)
+        events |= PollManager::EVENT_WRITE;
+    if (mask & POLLERR)
+        events |= PollManager::EVENT_ERROR;
+    if (mask & (POLLHUP | POLLRDHUP))
+        events |= PollManager::EVENT_HUP;
+    return events;
+}
+
+template <typename T> T* at(void* base, unsigned offset) noexcept {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+} // namespace
+
+UringManager::UringManager()
+    : _ring_fd(-1), _sq_ring(MAP_FAILED), _sq_size(0), _cq_ring(MAP_FAILED), _cq_size(0),
+      _sqes(NULL), _sqes_size(0), _sq_head(NULL), _sq_tail(NULL), _sq_array(NULL), _sq_mask(0),
+      _sq_entries(0), _cq_head(NULL), _cq_tail(NULL), _cq_mask(0), _cqes(NULL), _sq_local(0),
+      _watched(0) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    params.flags      = IORING_SETUP_CQSIZE;
+    params.cq_entries = CQ_ENTRIES;
+    _ring_fd          = static_cast<int>(syscall(__NR_io_uring_setup, SQ_ENTRIES, &params));
+    if (_ring_fd < 0)
+        throw PollError("io_uring_setup() failed: " + std::string(strerror(errno)));
+    // Resource tags came with 5.13, as did multishot poll, which has no feature bit
+    if (!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_RSRC_TAGS) ||
+        !(params.features & IORING_FEAT_NODROP)) {
+        close(_ring_fd);
+        throw PollError("io_uring backend needs Linux 5.13 or later");
+    }
+
+    _sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        _sq_size = _cq_size = std::max(_sq_size, _cq_size);
+    _sq_ring = mmap(NULL, _sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                    static_cast<off_t>(IORING_OFF_SQ_RING));
+    if (_sq_ring != MAP_FAILED && (params.features & IORING_FEAT_SINGLE_MMAP))
+        _cq_ring = _sq_ring;
+    else if (_sq_ring != MAP_FAILED)
+        _cq_ring = mmap(NULL, _cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        _ring_fd, static_cast<off_t>(IORING_OFF_CQ_RING));
+    _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(NULL, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      _ring_fd, static_cast<off_t>(IORING_OFF_SQES));
+    if (sqes != MAP_FAILED)
+        _sqes = static_cast<io_uring_sqe*>(sqes);
+    if (_sq_ring == MAP_FAILED || _cq_ring == MAP_FAILED || !_sqes) {
+        const int error = errno;
+        unmap();
+        close(_ring_fd);
+        throw PollError("io_uring mmap() failed: " + std::string(strerror(error)));
+    }
+
+    _sq_head    = at<unsigned>(_sq_ring, params.sq_off.head);
+    _sq_tail    = at<unsigned>(_sq_ring, params.sq_off.tail);
+    _sq_array   = at<unsigned>(_sq_ring, params.sq_off.array);
+    _sq_mask    = *at<unsigned>(_sq_ring, params.sq_off.ring_mask);
+    _sq_entries = params.sq_entries;
+    _cq_head    = at<unsigned>(_cq_ring, params.cq_off.head);
+    _cq_tail    = at<unsigned>(_cq_ring, params.cq_off.tail);
+    _cq_mask    = *at<unsigned>(_cq_ring, params.cq_off.ring_mask);
+    _cqes       = at<io_uring_cqe>(_cq_ring, params.cq_off.cqes);
+    _sq_local   = *_sq_tail;
+}
+
+UringManager::~UringManager() {
+    unmap();
+    close(_ring_fd);
+}
+
+void UringManager::unmap() noexcept {
+    if (_sqes)
+        munmap(_sqes, _sqes_size);
+    if (_cq_ring != MAP_FAILED && _cq_ring != _sq_ring)
+        munmap(_cq_ring, _cq_size);
+    if (_sq_ring != MAP_FAILED)
+        munmap(_sq_ring, _sq_size);
+}
+
+void UringManager::add(int fd, std::uint32_t interest) {
+    if (fd < 0)
+        throw PollError("io_uring: invalid fd " + std::to_string(fd));
+    const std::size_t slot = static_cast<std::size_t>(fd);
+    if (slot >= _watches.size()) {
+        _watches.resize(slot + 1);
+        _reported.resize(slot + 1, 0);
+    }
+    Watch& watch = _watches[slot];
+    if (watch.registered)
+        throw PollError("io_uring: fd " + std::to_string(fd) + " is already registered");
+    watch.registered = true;
+    watch.interest   = interest;
+    ++watch.generation; // Completions of an earlier owner of the number are stale
+    queuePoll(fd);
+    ++_watched;
+}
+
+// The new request reports the state at the time it is armed, as epoll_ctl() does
+void UringManager::modify(int fd, std::uint32_t interest) {
+    const std::size_t slot = static_cast<std::size_t>(fd);
+    if (fd < 0 || slot >= _watches.size() || !_watches[slot].registered)
+        throw PollError("io_uring: fd " + std::to_string(fd) + " is not registered");
+    queueCancel(fd);
+    Watch& watch = _watches[slot];
+    watch.interest = interest;
+    ++watch.generation;
+    queuePoll(fd);
+}
+
+// The ring holds a reference to the file until the removal is submitted with the next wait
+void UringManager::remove(int fd) noexcept {
+    const std::size_t slot = static_cast<std::size_t>(fd);
+    if (fd < 0 || slot >= _watches.size() || !_watches[slot].registered)
+        return;
+    queueCancel(fd);
+    Watch& watch     = _watches[slot];
+    watch.registered = false;
+    ++watch.generation;
+    --_watched;
+}
+
+int UringManager::wait(std::vector<IoEvent>& ready, int timeout_ms) {
+    ready.clear();
+    // Completions left over from a full ready list are returned without blocking
+    const unsigned pending = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE) - *_cq_head;
+    const bool     block   = !pending && timeout_ms != 0;
+    if (enter(block ? 1 : 0, timeout_ms) < 0 && errno != ETIME && errno != EINTR &&
+        errno != EBUSY)
+        throw PollError("io_uring_enter() failed: " + std::string(strerror(errno)));
+    reap(ready);
+    return static_cast<int>(ready.size());
+}
+
+const char* UringManager::name() const noexcept {
+    return "io_uring";
+}
+
+// An entry of the submission ring, published when enter() runs; a full ring is submitted
+io_uring_sqe* UringManager::nextEntry() noexcept {
+    if (_sq_local - __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE) >= _sq_entries)
+        enter(0, 0);
+    if (_sq_local - __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE) >= _sq_entries)
+        return NULL;
+    const unsigned index = _sq_local++ & _sq_mask;
+    io_uring_sqe*  entry = &_sqes[index];
+    std::memset(entry, 0, sizeof(*entry));
+    _sq_array[index] = index;
+    return entry;
+}
+
+void UringManager::queuePoll(int fd) {
+    io_uring_sqe* entry = nextEntry();
+    if (!entry)
+        throw PollError("io_uring: submission ring is full");
+    const Watch& watch   = _watches[static_cast<std::size_t>(fd)];
+    entry->opcode        = IORING_OP_POLL_ADD;
+    entry->fd            = fd;
+    entry->len           = IORING_POLL_ADD_MULTI;
+    entry->poll32_events = toPoll(watch.interest);
+    entry->user_data     = tag(fd, watch.generation);
+}
+
+void UringManager::queueCancel(int fd) noexcept {
+    io_uring_sqe* entry = nextEntry();
+    if (!entry)
+        return; // Later completions are stale by generation; only the file stays referenced
+    entry->opcode    = IORING_OP_POLL_REMOVE;
+    entry->addr      = tag(fd, _watches[static_cast<std::size_t>(fd)].generation);
+    entry->user_data = CANCEL_TAG;
+}
+
+// Submits the queued entries and waits for @p wait_for completions at most @p timeout_ms
+int UringManager::enter(unsigned wait_for, int timeout_ms) noexcept {
+    __atomic_store_n(_sq_tail, _sq_local, __ATOMIC_RELEASE);
+    const unsigned          queued = _sq_local - __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE);
+    __kernel_timespec       timeout{};
+    io_uring_getevents_arg  arg{};
+    unsigned                flags = IORING_ENTER_GETEVENTS; // Also flushes overflowed completions
+    const void*             extra = NULL;
+    std::size_t             size  = 0;
+    if (wait_for && timeout_ms >= 0) {
+        timeout.tv_sec  = timeout_ms / 1000;
+        timeout.tv_nsec = static_cast<long long>(timeout_ms % 1000) * 1000000;
+        arg.ts          = reinterpret_cast<std::uint64_t>(&timeout);
+        flags |= IORING_ENTER_EXT_ARG;
+        extra = &arg;
+        size  = sizeof(arg);
+    }
+    return static_cast<int>(
+        syscall(__NR_io_uring_enter, _ring_fd, queued, wait_for, flags, extra, size));
+}
+
+// Several completions for one descriptor are merged into one event
+void UringManager::reap(std::vector<IoEvent>& ready) {
+    unsigned       head = *_cq_head;
+    const unsigned tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+        const io_uring_cqe& cqe  = _cqes[head & _cq_mask];
+        const std::uint64_t key  = cqe.user_data;
+        const std::size_t   slot = static_cast<std::uint32_t>(key);
+        if (key == CANCEL_TAG || slot >= _watches.size())
+            continue;
+        Watch& watch = _watches[slot];
+        if (!watch.registered || watch.generation != static_cast<std::uint32_t>(key >> 32))
+            continue; // Removed or modified since
+        const int     fd     = static_cast<int>(slot);
+        std::uint32_t events = PollManager::EVENT_ERROR;
+        if (cqe.res >= 0) {
+            events = fromPoll(static_cast<std::uint32_t>(cqe.res));
+            if (!(cqe.flags & IORING_CQE_F_MORE))
+                queuePoll(fd); // The kernel ended the request, e.g. on completion overflow
+        }
+        if (!events)
+            continue;
+        int& index = _reported[slot];
+        if (index) {
+            ready[static_cast<std::size_t>(index - 1)].events |= events;
+        } else {
+            ready.push_back(IoEvent{fd, events});
+            index = static_cast<int>(ready.size());
+        }
+    }
+    __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+    for (const IoEvent& event : ready)
+        _reported[static_cast<std::size_t>(event.fd)] = 0;
+}
+
+#endif
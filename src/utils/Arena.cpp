@@ -0,0 +1,130 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Arena.cpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:35:47 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:39:56 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Arena.cpp
+ * @brief   Implements the Arena bump allocator.
+ *
+ * @ingroup utils
+ */
+
+#include "utils/Arena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+std::uintptr_t alignUp(std::uintptr_t value, std::size_t alignment) noexcept {
+    return (value + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+}
+
+} // namespace
+
+constexpr std::size_t Arena::DEFAULT_BLOCK_SIZE;
+
+Arena::Arena(std::size_t block_size, std::pmr::memory_resource* upstream) noexcept
+    : _block_size(block_size), _upstream(upstream), _first(NULL), _current(NULL), _cursor(0),
+      _used(0) {
+}
+
+Arena::~Arena() {
+    release();
+}
+
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    if (_current) {
+        const std::uintptr_t base  = reinterpret_cast<std::uintptr_t>(_current);
+        const std::uintptr_t start = alignUp(base + _cursor, alignment);
+        if (start + bytes <= base + _current->size) {
+            _cursor = static_cast<std::size_t>(start + bytes - base);
+            _used += bytes;
+            return reinterpret_cast<void*>(start);
+        }
+    }
+
+    // Worst-case padding is reserved so the allocation always fits the new block
+    const std::size_t size  = std::max(_block_size, sizeof(Block) + alignment + bytes);
+    Block*            block = static_cast<Block*>(_upstream->allocate(size, alignof(Block)));
+    block->next             = NULL;
+    block->size             = size;
+    if (_current)
+        _current->next = block;
+    else
+        _first = block;
+    _current = block;
+    _cursor  = sizeof(Block);
+    return do_allocate(bytes, alignment);
+}
+
+void Arena::do_deallocate(void*, std::size_t, std::size_t) {
+    // Monotonic: memory comes back all at once in reset()
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void Arena::freeAfter(Block* block) noexcept {
+    Block* next = block->next;
+    block->next = NULL;
+    while (next) {
+        Block* following = next->next;
+        freeBlock(next);
+        next = following;
+    }
+}
+
+void Arena::freeBlock(Block* block) noexcept {
+    _upstream->deallocate(block, block->size, alignof(Block));
+}
+
+void Arena::reset() noexcept {
+    if (!_first)
+        return;
+    if (_first->size > _block_size) {
+        release(); // An oversized first block is not worth keeping
+        return;
+    }
+    freeAfter(_first);
+    _current = _first;
+    _cursor  = sizeof(Block);
+    _used    = 0;
+}
+
+void Arena::release() noexcept {
+    if (_first) {
+        freeAfter(_first);
+        freeBlock(_first);
+    }
+    _first   = NULL;
+    _current = NULL;
+    _cursor  = 0;
+    _used    = 0;
+}
+
+std::size_t Arena::getUsed() const noexcept {
+    return _used;
+}
+
+std::size_t Arena::getReserved() const noexcept {
+    std::size_t total = 0;
+    for (const Block* block = _first; block; block = block->next)
+        total += block->size;
+    return total;
+}
+
+std::size_t Arena::getBlockCount() const noexcept {
+    std::size_t count = 0;
+    for (const Block* block = _first; block; block = block->next)
+        ++count;
+    return count;
+}
@@ -0,0 +1,118 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CpuAffinity.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 05:09:56 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:09:56 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    CpuAffinity.cpp
+ * @brief   Implements CPU pinning and NUMA-local allocation on Linux.
+ *
+ * @ingroup utils
+ */
+
+#include "utils/CpuAffinity.hpp"
+#include <cerrno>
+#include <climits>
+#include <unistd.h>
+
+#if defined(__linux__)
+# include <pthread.h>
+# include <sched.h>
+# include <sys/syscall.h>
+#endif
+
+std::vector<unsigned> allowedCpus() {
+    std::vector<unsigned> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set))
+                cpus.push_back(cpu);
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        for (long cpu = 0; cpu < (online > 0 ? online : 1); ++cpu)
+            cpus.push_back(static_cast<unsigned>(cpu));
+    }
+    return cpus;
+}
+
+#if defined(__linux__)
+
+bool pinThreadToCpu(unsigned cpu) noexcept {
+    if (cpu >= CPU_SETSIZE) {
+        errno = EINVAL;
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    const int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    errno           = error;
+    return error == 0;
+}
+
+int pinnedCpu() noexcept {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0 || CPU_COUNT(&set) != 1)
+        return -1;
+    for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set))
+            return static_cast<int>(cpu);
+    }
+    return -1;
+}
+
+int preferLocalNode() noexcept {
+# if defined(SYS_getcpu) && defined(SYS_set_mempolicy)
+    unsigned cpu  = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0)
+        return -1;
+    if (node >= CPU_SETSIZE) {
+        errno = EINVAL;
+        return -1;
+    }
+    // set_mempolicy(2) without <numaif.h>: MPOL_PREFERRED with a one-node mask
+    constexpr int      MPOL_PREFERRED_MODE = 1;
+    constexpr unsigned BITS                = sizeof(unsigned long) * CHAR_BIT;
+    unsigned long      mask[CPU_SETSIZE / BITS] = {};
+    mask[node / BITS] = 1UL << (node % BITS);
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED_MODE, mask, CPU_SETSIZE + 1) != 0)
+        return -1;
+    return static_cast<int>(node);
+# else
+    errno = ENOSYS;
+    return -1;
+# endif
+}
+
+#else
+
+bool pinThreadToCpu(unsigned) noexcept {
+    errno = ENOSYS;
+    return false;
+}
+
+int pinnedCpu() noexcept {
+    return -1;
+}
+
+int preferLocalNode() noexcept {
+    errno = ENOSYS;
+    return -1;
+}
+
+#endif
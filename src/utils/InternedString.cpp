@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   InternedString.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:00:07 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:00:07 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    InternedString.cpp
+ * @brief   Implements the process-wide string pool behind InternedString.
+ *
+ * @ingroup utils
+ */
+
+#include "utils/InternedString.hpp"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+/// Strings live in a deque, which never moves its elements; the map indexes them.
+class Pool {
+  public:
+    Pool() { _values.emplace_back(); }
+
+    const std::string* empty() const noexcept { return &_values.front(); }
+
+    template <typename String> const std::string* intern(String&& value) {
+        if (value.empty())
+            return empty();
+        std::lock_guard<std::mutex> lock(_mutex);
+        const Index::const_iterator it = _index.find(std::string_view(value));
+        if (it != _index.end())
+            return it->second;
+        _values.emplace_back(std::forward<String>(value));
+        const std::string* pooled = &_values.back();
+        _index.emplace(std::string_view(*pooled), pooled);
+        return pooled;
+    }
+
+    std::size_t size() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _index.size();
+    }
+
+  private:
+    using Index = std::unordered_map<std::string_view, const std::string*>;
+
+    std::mutex              _mutex;
+    std::deque<std::string> _values; ///< Front is the empty string.
+    Index                   _index;  ///< Keys view the characters of _values.
+};
+
+// Constructed on first use, so handles built during static initialization work
+Pool& pool() {
+    static Pool* instance = new Pool(); // Never destroyed: handles may outlive exit()
+    return *instance;
+}
+
+} // namespace
+
+InternedString::InternedString() : _value(pool().empty()) {
+}
+
+InternedString::InternedString(std::string_view value) : _value(pool().intern(value)) {
+}
+
+InternedString::InternedString(std::string&& value) : _value(pool().intern(std::move(value))) {
+}
+
+InternedString& InternedString::operator=(std::string_view value) {
+    _value = pool().intern(value);
+    return *this;
+}
+
+InternedString& InternedString::operator=(std::string&& value) {
+    _value = pool().intern(std::move(value));
+    return *this;
+}
+
+std::size_t InternedString::poolSize() {
+    return pool().size();
+}
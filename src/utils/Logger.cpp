@@ -0,0 +1,271 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Logger.cpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/04/26 16:00:00 by nlouis            #+#    #+#             */
+/*   Updated: 2025/05/28 11:32:47 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Logger.cpp
+ * @brief   Implements the asynchronous Logger and its writer thread.
+ *
+ * @ingroup utils
+ */
+
+#include "utils/Logger.hpp"
+#include <cerrno>
+#include <csignal>
+#include <cstdarg>
+#include <cstdio>
+#include <ctime>
+#include <new>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t RING_MASK     = Logger::RING_RECORDS - 1;
+constexpr std::size_t BATCH_BYTES   = 64 * 1024; ///< Output flushed once a batch reaches this.
+constexpr long        IDLE_SLEEP_NS = 2000000;   ///< Writer pause when every ring is empty.
+
+static_assert((Logger::RING_RECORDS & RING_MASK) == 0, "RING_RECORDS must be a power of 2");
+
+const char* levelName(LogLevel level) noexcept {
+    switch (level) {
+    case LogLevel::Debug:
+        return "DEBUG";
+    case LogLevel::Info:
+        return "INFO ";
+    case LogLevel::Warn:
+        return "WARN ";
+    case LogLevel::Error:
+        return "ERROR";
+    }
+    return "?    ";
+}
+
+thread_local void* t_ring = NULL; // This thread's Logger::Ring, once it has logged
+
+} // namespace
+
+constexpr std::size_t Logger::RECORD_SIZE;
+constexpr std::size_t Logger::RING_RECORDS;
+
+Logger::Logger()
+    : _stamp_second(-1), _stamp(), _dropped(0), _reported(0), _running(false), _stopping(false),
+      _writer() {
+    _out.reserve(BATCH_BYTES);
+    _err.reserve(BATCH_BYTES);
+    pthread_atfork(&Logger::beforeFork, &Logger::afterForkParent, &Logger::afterForkChild);
+}
+
+// Runs at exit: whatever is still queued is written before the process ends
+Logger::~Logger() {
+    if (_running.load()) {
+        _stopping.store(true);
+        pthread_join(_writer, NULL);
+        _running.store(false);
+    }
+    flush();
+}
+
+Logger& Logger::instance() noexcept {
+    static Logger logger;
+    return logger;
+}
+
+// --- Producers ---
+
+void Logger::log(LogLevel level, const char* format, ...) noexcept {
+    Logger& self = instance();
+    if (!self._running.load(std::memory_order_acquire))
+        self.startWriter();
+    Ring* ring = self.ring();
+    if (!ring)
+        return;
+
+    const std::size_t tail = ring->tail.load(std::memory_order_relaxed);
+    if (tail - ring->head.load(std::memory_order_acquire) >= RING_RECORDS) {
+        self._dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Record& record = ring->records[tail & RING_MASK];
+    timeval now;
+    gettimeofday(&now, NULL);
+    record.time_ms = static_cast<std::int64_t>(now.tv_sec) * 1000 + now.tv_usec / 1000;
+    record.level   = level;
+
+    va_list args;
+    va_start(args, format);
+    const int length = vsnprintf(record.text, sizeof(record.text), format, args);
+    va_end(args);
+    if (length < 0)
+        record.length = 0;
+    else if (static_cast<std::size_t>(length) >= sizeof(record.text))
+        record.length = sizeof(record.text) - 1; // Truncated, vsnprintf kept room for NUL
+    else
+        record.length = static_cast<std::uint16_t>(length);
+    ring->tail.store(tail + 1, std::memory_order_release);
+}
+
+// The first record of a thread allocates its ring; every later one is lock-free
+Logger::Ring* Logger::ring() noexcept {
+    if (t_ring)
+        return static_cast<Ring*>(t_ring);
+    try {
+        std::unique_ptr<Ring> ring(new Ring());
+        ring->owner = pthread_self();
+        std::lock_guard<std::mutex> lock(_rings_mutex);
+        _rings.push_back(std::move(ring));
+        t_ring = _rings.back().get();
+    } catch (const std::exception&) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return static_cast<Ring*>(t_ring);
+}
+
+// --- Writer ---
+
+// The writer blocks every signal, so sigwait() in the servers keeps receiving them
+void Logger::startWriter() noexcept {
+    std::lock_guard<std::mutex> lock(_rings_mutex);
+    if (_running.load())
+        return;
+    sigset_t all;
+    sigset_t original;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &original);
+    _stopping.store(false);
+    if (pthread_create(&_writer, NULL, &Logger::writerMain, this) == 0)
+        _running.store(true, std::memory_order_release);
+    pthread_sigmask(SIG_SETMASK, &original, NULL);
+}
+
+void* Logger::writerMain(void* self) {
+    Logger& logger = *static_cast<Logger*>(self);
+    while (true) {
+        bool wrote;
+        {
+            std::lock_guard<std::mutex> lock(logger._drain_mutex);
+            wrote = logger.drainLocked();
+        }
+        if (!wrote && logger._stopping.load())
+            break;
+        if (!wrote) {
+            timespec pause = {0, IDLE_SLEEP_NS};
+            nanosleep(&pause, NULL);
+        }
+    }
+    return NULL;
+}
+
+void Logger::flush() noexcept {
+    Logger&                     self = instance();
+    std::lock_guard<std::mutex> lock(self._drain_mutex);
+    while (self.drainLocked()) {
+    }
+}
+
+std::uint64_t Logger::getDropped() noexcept {
+    return instance()._dropped.load(std::memory_order_relaxed);
+}
+
+// One pass over every ring; returns whether anything was written
+bool Logger::drainLocked() noexcept {
+    bool wrote = false;
+    try {
+        {
+            std::lock_guard<std::mutex> lock(_rings_mutex); // Not held across write()
+            _draining.clear();
+            for (const std::unique_ptr<Ring>& ring : _rings)
+                _draining.push_back(ring.get());
+        }
+        for (Ring* ring : _draining) {
+            const std::size_t tail = ring->tail.load(std::memory_order_acquire);
+            std::size_t       head = ring->head.load(std::memory_order_relaxed);
+            for (; head != tail; ++head) {
+                append(ring->records[head & RING_MASK]);
+                if (_out.size() >= BATCH_BYTES)
+                    writeAll(STDOUT_FILENO, _out);
+                if (_err.size() >= BATCH_BYTES)
+                    writeAll(STDERR_FILENO, _err);
+                wrote = true;
+            }
+            ring->head.store(head, std::memory_order_release);
+        }
+        const std::uint64_t dropped = _dropped.load(std::memory_order_relaxed);
+        if (dropped != _reported) {
+            _err += "Logger: " + std::to_string(dropped - _reported) + " records dropped\n";
+            _reported = dropped;
+        }
+    } catch (const std::exception&) {
+        // Out of memory for the batch: write what fits, lose the rest
+    }
+    writeAll(STDOUT_FILENO, _out);
+    writeAll(STDERR_FILENO, _err);
+    return wrote;
+}
+
+// "YYYY-MM-DD HH:MM:SS.mmm LEVEL text\n"; the date part is formatted once per second
+void Logger::append(const Record& record) {
+    const std::int64_t second = record.time_ms / 1000;
+    if (second != _stamp_second) {
+        const time_t seconds = static_cast<time_t>(second);
+        tm           local;
+        localtime_r(&seconds, &local);
+        strftime(_stamp, sizeof(_stamp), "%Y-%m-%d %H:%M:%S", &local);
+        _stamp_second = second;
+    }
+    char prefix[48];
+    const int length = snprintf(prefix, sizeof(prefix), "%s.%03d %s ", _stamp,
+                                static_cast<int>(record.time_ms % 1000), levelName(record.level));
+    std::string& batch = record.level >= LogLevel::Warn ? _err : _out;
+    batch.append(prefix, static_cast<std::size_t>(length));
+    batch.append(record.text, record.length);
+    batch += '\n';
+}
+
+// A terminal or pipe that cannot take the batch loses it rather than stall the writer
+void Logger::writeAll(int fd, std::string& batch) noexcept {
+    std::size_t sent = 0;
+    while (sent < batch.size()) {
+        const ssize_t n = ::write(fd, batch.data() + sent, batch.size() - sent);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        sent += static_cast<std::size_t>(n);
+    }
+    batch.clear();
+}
+
+// --- fork() ---
+
+// Only the ring list is frozen: fork() runs on event loops, which must not wait for output
+void Logger::beforeFork() noexcept {
+    instance()._rings_mutex.lock();
+}
+
+void Logger::afterForkParent() noexcept {
+    instance()._rings_mutex.unlock();
+}
+
+// Every record queued so far is the parent's to write. The writer thread did not survive and
+// may have been mid-drain: its lock and batches are replaced, leaking at most one batch
+void Logger::afterForkChild() noexcept {
+    Logger& self = instance();
+    for (const std::unique_ptr<Ring>& ring : self._rings)
+        ring->head.store(ring->tail.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    new (&self._drain_mutex) std::mutex();
+    new (&self._draining) std::vector<Ring*>();
+    new (&self._out) std::string();
+    new (&self._err) std::string();
+    self._reported = self._dropped.load(std::memory_order_relaxed);
+    self._running.store(false);
+    self._rings_mutex.unlock();
+}
@@ -17,10 +17,26 @@ void print_usage( void )
 	std::cout << "\n=========USAGE=========" << std::endl;
 	std::cout << "  ./webserv            # Uses default.conf" << std::endl;
 	std::cout << "  ./webserv config.conf" << std::endl;
+	std::cout << "  ./webserv --check-config [config.conf]   # Validates and exits" << std::endl;
 }
 
 void print_config( Config& config )
 {
+	std::cout << "worker_processes: " << config.getWorkerProcesses() << std::endl;
+	std::cout << "worker_threads: " << config.getWorkerThreads() << std::endl;
+	std::cout << "asset_cache_size: " << config.getAssetCacheSize() << std::endl;
+	std::cout << "max_connections: " << config.getMaxConnections() << std::endl;
+	std::cout << "worker_cpu_affinity:";
+	if (config.getCpuAffinity() == CpuAffinity::OFF)
+		std::cout << " off";
+	else if (config.getCpuAffinity() == CpuAffinity::AUTO)
+		std::cout << " auto";
+	for (size_t i = 0; i < config.getWorkerCpus().size(); ++i)
+		std::cout << " " << config.getWorkerCpus()[i];
+	std::cout << (config.isNumaLocal() ? " (numa local)" : "") << std::endl;
+	std::cout << "slow_request_threshold: " << config.getSlowRequestThreshold() << "ms"
+			  << std::endl;
+
 	const std::vector<Server>& servers = config.getServers();
 	for (size_t i = 0; i < servers.size(); ++i) {
 		const Server& server = servers[i];
@@ -43,6 +59,14 @@ void print_config( Config& config )
 
 		// Client Body Size
 		std::cout << "  client_max_body_size: " << server.getClientMaxBodySize() << std::endl;
+		std::cout << "  keepalive_timeout: " << server.getKeepAliveTimeout() << "s" << std::endl;
+		std::cout << "  keepalive_requests: " << server.getKeepAliveRequests() << std::endl;
+		std::cout << "  client_header_timeout: " << server.getClientHeaderTimeout() << "s" << std::endl;
+		std::cout << "  client_body_timeout: " << server.getClientBodyTimeout() << "s" << std::endl;
+		std::cout << "  send_timeout: " << server.getSendTimeout() << "s" << std::endl;
+		std::cout << "  listen_backlog: " << server.getListenBacklog() << std::endl;
+		if (server.getBusyPoll() > 0)
+			std::cout << "  busy_poll: " << server.getBusyPoll() << "us" << std::endl;
 
 		// Locations
 		const std::vector<Location>& locations = server.getLocations();
@@ -56,11 +80,12 @@ void print_config( Config& config )
 
 			// Methods
 			std::cout << "    methods: ";
-			if (loc.getMethods().empty())
+			if (loc.getMethodMask() == 0)
 				std::cout << "(none)";
 			else {
-				for (std::set<std::string>::const_iterator it = loc.getMethods().begin(); it != loc.getMethods().end(); ++it)
-					std::cout << *it << " ";
+				for (unsigned m = 0; m < static_cast<unsigned>(HttpMethod::UNKNOWN); ++m)
+					if (loc.isMethodAllowed(static_cast<HttpMethod>(m)))
+						std::cout << httpMethodName(static_cast<HttpMethod>(m)) << " ";
 			}
 			std::cout << std::endl;
 
@@ -80,6 +105,14 @@ void print_config( Config& config )
 			// CGI
 			if (!loc.getCgiExtension().empty()) {
 				std::cout << "    cgi_pass: " << loc.getCgiExtension() << std::endl;
+				if (!loc.getCgiInterpreter().empty())
+					std::cout << "    cgi_interpreter: " << loc.getCgiInterpreter() << std::endl;
+				if (!loc.getFastcgiPass().empty())
+					std::cout << "    fastcgi_pass: " << loc.getFastcgiPass() << std::endl;
+				if (!loc.getProxyPass().empty())
+					std::cout << "    proxy_pass: " << loc.getProxyPass() << std::endl;
+				std::cout << "    cgi_max_processes: " << loc.getCgiMaxProcesses() << std::endl;
+				std::cout << "    cgi_timeout: " << loc.getCgiTimeout() << "s" << std::endl;
 			}
 		}
 	}
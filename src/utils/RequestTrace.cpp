@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RequestTrace.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 05:18:53 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:18:53 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    RequestTrace.cpp
+ * @brief   Implements RequestTrace.
+ *
+ * @ingroup utils
+ */
+
+#include "utils/RequestTrace.hpp"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr std::size_t index(TracePhase phase) noexcept {
+    return static_cast<std::size_t>(phase);
+}
+
+// Appends to a NUL-terminated buffer, keeping what fits
+void append(char* out, std::size_t size, std::size_t& used, const char* format, ...) {
+    if (used + 1 >= size)
+        return;
+    va_list args;
+    va_start(args, format);
+    const int written = std::vsnprintf(out + used, size - used, format, args);
+    va_end(args);
+    if (written > 0)
+        used = std::min(used + static_cast<std::size_t>(written), size - 1);
+}
+
+// Milliseconds with microsecond precision, without going through floating point
+void appendMillis(char* out, std::size_t size, std::size_t& used, const char* prefix,
+                  RequestTrace::Clock::duration duration) {
+    const long long micros =
+        std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    append(out, size, used, "%s%lld.%03lld", prefix, micros / 1000, micros % 1000);
+}
+
+} // namespace
+
+constexpr std::size_t RequestTrace::PHASES;
+constexpr std::size_t RequestTrace::METHOD_SIZE;
+constexpr std::size_t RequestTrace::TARGET_SIZE;
+
+RequestTrace::RequestTrace() noexcept
+    : _marks(), _marked(0), _status(0), _method_length(0), _target_length(0), _method(),
+      _target() {
+}
+
+void RequestTrace::reset() noexcept {
+    _marked        = 0;
+    _status        = 0;
+    _method_length = 0;
+    _target_length = 0;
+}
+
+void RequestTrace::mark(TracePhase phase, Clock::time_point when) noexcept {
+    _marks[index(phase)] = when;
+    _marked              = static_cast<std::uint16_t>(_marked | 1u << index(phase));
+}
+
+bool RequestTrace::has(TracePhase phase) const noexcept {
+    return _marked & 1u << index(phase);
+}
+
+bool RequestTrace::empty() const noexcept {
+    return _marked == 0;
+}
+
+void RequestTrace::describe(std::string_view method, std::string_view target) noexcept {
+    _method_length = static_cast<std::uint8_t>(std::min(method.size(), METHOD_SIZE));
+    _target_length = static_cast<std::uint8_t>(std::min(target.size(), TARGET_SIZE));
+    std::memcpy(_method, method.data(), _method_length);
+    std::memcpy(_target, target.data(), _target_length);
+}
+
+void RequestTrace::setStatus(int status) noexcept {
+    _status = static_cast<std::uint16_t>(status);
+}
+
+RequestTrace::Clock::duration RequestTrace::elapsed() const noexcept {
+    if (!has(TracePhase::HEAD_START) || !has(TracePhase::DONE))
+        return Clock::duration::zero();
+    return _marks[index(TracePhase::DONE)] - _marks[index(TracePhase::HEAD_START)];
+}
+
+std::size_t RequestTrace::format(char* out, std::size_t size) const noexcept {
+    if (size == 0)
+        return 0;
+    std::size_t used = 0;
+    out[0]           = '\0';
+    if (_method_length)
+        append(out, size, used, "%.*s %.*s ", static_cast<int>(_method_length), _method,
+               static_cast<int>(_target_length), _target);
+    if (_status)
+        append(out, size, used, "%u", static_cast<unsigned>(_status));
+    else
+        append(out, size, used, "-");
+    appendMillis(out, size, used, " in ", elapsed());
+    append(out, size, used, " ms:");
+
+    const Clock::time_point* previous = NULL;
+    for (std::size_t i = 0; i < PHASES; ++i) {
+        if (!has(static_cast<TracePhase>(i)))
+            continue;
+        append(out, size, used, " %s", phaseName(static_cast<TracePhase>(i)));
+        if (previous)
+            appendMillis(out, size, used, " +", _marks[i] - *previous);
+        previous = &_marks[i];
+    }
+    return used;
+}
+
+const char* RequestTrace::phaseName(TracePhase phase) noexcept {
+    switch (phase) {
+        case TracePhase::ACCEPTED: return "accepted";
+        case TracePhase::HEAD_START: return "read";
+        case TracePhase::HEAD_PARSED: return "parsed";
+        case TracePhase::SERVER: return "server";
+        case TracePhase::ROUTED: return "routed";
+        case TracePhase::RESPONDED: return "responded";
+        case TracePhase::FIRST_SENT: return "sent";
+        case TracePhase::DONE: return "done";
+    }
+    return "?";
+}
@@ -0,0 +1,285 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Stats.cpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 03:39:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 06:05:52 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    Stats.cpp
+ * @brief   Implements the latency histograms and the shared statistics registry.
+ *
+ * @ingroup utils
+ */
+
+#include "utils/Stats.hpp"
+#include <cstdio>
+#include <new>
+#include <sys/mman.h>
+#include <vector>
+
+namespace {
+
+constexpr unsigned    EXACT_BITS = 4;  ///< Values below 2^4 µs get a bucket each.
+constexpr unsigned    SUB_BITS   = 3;  ///< 2^3 buckets per power of two above that.
+constexpr unsigned    MAX_EXP    = 35; ///< Highest power of two with buckets.
+constexpr std::size_t EXACT      = std::size_t(1) << EXACT_BITS;
+constexpr std::size_t SUB        = std::size_t(1) << SUB_BITS;
+
+static_assert(LatencyHistogram::BUCKETS == EXACT + (MAX_EXP - EXACT_BITS + 1) * SUB,
+              "bucket layout and BUCKETS disagree");
+
+/// Sum of the same histogram over every worker.
+struct Merged {
+    std::vector<std::uint64_t> buckets;
+    std::uint64_t              count = 0;
+    std::uint64_t              sum   = 0;
+
+    Merged() : buckets(LatencyHistogram::BUCKETS, 0) {}
+
+    void add(const LatencyHistogram& histogram) {
+        for (std::size_t i = 0; i < buckets.size(); ++i)
+            buckets[i] += histogram.getBucket(i);
+        count += histogram.getCount();
+        sum += histogram.getSum();
+    }
+
+    // Upper bound of the bucket holding the sample of rank q * count
+    std::uint64_t quantile(double q) const {
+        const double  target = q * static_cast<double>(count);
+        std::uint64_t seen   = 0;
+        for (std::size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen && static_cast<double>(seen) >= target)
+                return LatencyHistogram::upperBound(i);
+        }
+        return 0;
+    }
+};
+
+void appendHeader(std::string& out, const char* name, const char* type, const char* help) {
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+void appendValue(std::string& out, const char* name, const char* labels, std::uint64_t value) {
+    out += name;
+    out += labels;
+    out += ' ';
+    out += std::to_string(value);
+    out += '\n';
+}
+
+// One sample per block, labelled with its slot
+void appendPerWorker(std::string& out, const char* name, const WorkerStats* workers,
+                     std::size_t count, StatGauge WorkerStats::*field) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::string labels = "{worker=\"" + std::to_string(i) + "\"}";
+        appendValue(out, name, labels.c_str(), (workers[i].*field).get());
+    }
+}
+
+void appendSeconds(std::string& out, const char* name, const char* labels, std::uint64_t micros) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.6f", static_cast<double>(micros) / 1e6);
+    out += name;
+    out += labels;
+    out += ' ';
+    out += text;
+    out += '\n';
+}
+
+void appendSummary(std::string& out, const std::string& name, const char* help,
+                   const Merged& merged) {
+    static const struct {
+        double      q;
+        const char* label;
+    } QUANTILES[] = {{0.5, "{quantile=\"0.5\"}"},
+                     {0.9, "{quantile=\"0.9\"}"},
+                     {0.99, "{quantile=\"0.99\"}"},
+                     {0.999, "{quantile=\"0.999\"}"}};
+
+    appendHeader(out, name.c_str(), "summary", help);
+    for (const auto& quantile : QUANTILES)
+        appendSeconds(out, name.c_str(), quantile.label, merged.quantile(quantile.q));
+    appendSeconds(out, (name + "_sum").c_str(), "", merged.sum);
+    appendValue(out, (name + "_count").c_str(), "", merged.count);
+}
+
+} // namespace
+
+// --- LatencyHistogram ---
+
+constexpr std::size_t LatencyHistogram::BUCKETS;
+
+std::size_t LatencyHistogram::bucketOf(std::uint64_t micros) noexcept {
+    if (micros < EXACT)
+        return static_cast<std::size_t>(micros);
+    const unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(micros));
+    if (exponent > MAX_EXP)
+        return BUCKETS - 1;
+    const std::size_t sub = static_cast<std::size_t>(micros >> (exponent - SUB_BITS)) & (SUB - 1);
+    return EXACT + (exponent - EXACT_BITS) * SUB + sub;
+}
+
+std::uint64_t LatencyHistogram::upperBound(std::size_t index) noexcept {
+    if (index < EXACT)
+        return index;
+    const std::size_t offset   = index - EXACT;
+    const unsigned    exponent = EXACT_BITS + static_cast<unsigned>(offset / SUB);
+    return ((SUB + offset % SUB + 1) << (exponent - SUB_BITS)) - 1;
+}
+
+void LatencyHistogram::record(std::uint64_t micros) noexcept {
+    _buckets[bucketOf(micros)].add();
+    _count.add();
+    _sum.add(micros);
+}
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration elapsed) noexcept {
+    const long long micros =
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    record(micros > 0 ? static_cast<std::uint64_t>(micros) : 0);
+}
+
+std::uint64_t LatencyHistogram::getCount() const noexcept {
+    return _count.get();
+}
+
+std::uint64_t LatencyHistogram::getSum() const noexcept {
+    return _sum.get();
+}
+
+std::uint64_t LatencyHistogram::getBucket(std::size_t index) const noexcept {
+    return index < BUCKETS ? _buckets[index].get() : 0;
+}
+
+// --- StatsRegistry ---
+
+StatsRegistry::StatsRegistry(WorkerStats* workers, std::size_t count, std::size_t size) noexcept
+    : _workers(workers), _count(count), _size(size) {
+}
+
+// MAP_SHARED: the blocks stay shared with every process forked afterwards
+std::shared_ptr<StatsRegistry> StatsRegistry::create(std::size_t workers) {
+    if (workers == 0)
+        workers = 1;
+    const std::size_t size = workers * sizeof(WorkerStats);
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        throw std::bad_alloc();
+    WorkerStats* blocks = static_cast<WorkerStats*>(memory);
+    for (std::size_t i = 0; i < workers; ++i)
+        new (&blocks[i]) WorkerStats();
+    return std::shared_ptr<StatsRegistry>(new StatsRegistry(blocks, workers, size));
+}
+
+// WorkerStats is a tree of atomics: there is nothing to destroy but the mapping
+StatsRegistry::~StatsRegistry() {
+    munmap(_workers, _size);
+}
+
+std::size_t StatsRegistry::getWorkerCount() const noexcept {
+    return _count;
+}
+
+WorkerStats& StatsRegistry::getWorker(std::size_t index) noexcept {
+    return _workers[index < _count ? index : _count - 1];
+}
+
+void StatsRegistry::renderPrometheus(std::string& out) const {
+    std::uint64_t accepted = 0;
+    std::uint64_t closed   = 0;
+    std::uint64_t responses[6] = {};
+    std::uint64_t bytes_in     = 0;
+    std::uint64_t bytes_out    = 0;
+    std::uint64_t errors       = 0;
+    std::uint64_t handshakes   = 0;
+    std::uint64_t resumed      = 0;
+    std::uint64_t kernel_send  = 0;
+    std::uint64_t slow         = 0;
+    Merged        first_byte;
+    Merged        total;
+    for (std::size_t i = 0; i < _count; ++i) {
+        const WorkerStats& worker = _workers[i];
+        accepted += worker.accepted.get();
+        closed += worker.closed.get();
+        for (std::size_t c = 0; c < 6; ++c)
+            responses[c] += worker.responses[c].get();
+        bytes_in += worker.bytes_in.get();
+        bytes_out += worker.bytes_out.get();
+        errors += worker.parse_errors.get();
+        handshakes += worker.tls_handshakes.get();
+        resumed += worker.tls_resumed.get();
+        kernel_send += worker.tls_kernel_send.get();
+        slow += worker.slow_requests.get();
+        first_byte.add(worker.first_byte);
+        total.add(worker.total);
+    }
+
+    appendHeader(out, "webserv_connections_accepted_total", "counter", "Connections accepted.");
+    appendValue(out, "webserv_connections_accepted_total", "", accepted);
+    appendHeader(out, "webserv_connections_closed_total", "counter", "Connections closed.");
+    appendValue(out, "webserv_connections_closed_total", "", closed);
+    appendHeader(out, "webserv_connections_active", "gauge", "Connections open now.");
+    appendValue(out, "webserv_connections_active", "", accepted >= closed ? accepted - closed : 0);
+
+    static const char* const CLASSES[6] = {"{code=\"other\"}", "{code=\"1xx\"}",
+                                           "{code=\"2xx\"}",   "{code=\"3xx\"}",
+                                           "{code=\"4xx\"}",   "{code=\"5xx\"}"};
+    appendHeader(out, "webserv_responses_total", "counter", "Responses by status class.");
+    for (std::size_t c = 0; c < 6; ++c)
+        appendValue(out, "webserv_responses_total", CLASSES[c], responses[c]);
+
+    appendHeader(out, "webserv_received_bytes_total", "counter", "Bytes read from clients.");
+    appendValue(out, "webserv_received_bytes_total", "", bytes_in);
+    appendHeader(out, "webserv_sent_bytes_total", "counter", "Bytes sent to clients.");
+    appendValue(out, "webserv_sent_bytes_total", "", bytes_out);
+    appendHeader(out, "webserv_parse_errors_total", "counter",
+                 "Requests rejected while being read.");
+    appendValue(out, "webserv_parse_errors_total", "", errors);
+    appendHeader(out, "webserv_tls_handshakes_total", "counter", "TLS handshakes completed.");
+    appendValue(out, "webserv_tls_handshakes_total", "", handshakes);
+    appendHeader(out, "webserv_tls_resumed_total", "counter",
+                 "TLS handshakes that resumed a session.");
+    appendValue(out, "webserv_tls_resumed_total", "", resumed);
+    appendHeader(out, "webserv_tls_kernel_send_total", "counter",
+                 "TLS connections whose sends the kernel encrypts.");
+    appendValue(out, "webserv_tls_kernel_send_total", "", kernel_send);
+    appendHeader(out, "webserv_slow_requests_total", "counter",
+                 "Requests slower than slow_request_threshold.");
+    appendValue(out, "webserv_slow_requests_total", "", slow);
+
+    appendHeader(out, "webserv_buffer_pool_in_use", "gauge", "Buffer chunks lent out now.");
+    appendPerWorker(out, "webserv_buffer_pool_in_use", _workers, _count,
+                    &WorkerStats::buffers_in_use);
+    appendHeader(out, "webserv_buffer_pool_high_water", "gauge",
+                 "Most buffer chunks lent out at once.");
+    appendPerWorker(out, "webserv_buffer_pool_high_water", _workers, _count,
+                    &WorkerStats::buffers_high_water);
+    appendHeader(out, "webserv_buffer_pool_hits_total", "counter",
+                 "Buffer chunks reused from the free list.");
+    appendPerWorker(out, "webserv_buffer_pool_hits_total", _workers, _count,
+                    &WorkerStats::buffer_hits);
+    appendHeader(out, "webserv_buffer_pool_misses_total", "counter",
+                 "Buffer chunks allocated from the heap.");
+    appendPerWorker(out, "webserv_buffer_pool_misses_total", _workers, _count,
+                    &WorkerStats::buffer_misses);
+
+    appendSummary(out, "webserv_time_to_first_byte_seconds",
+                  "From the first request byte to the first response byte.", first_byte);
+    appendSummary(out, "webserv_request_duration_seconds",
+                  "From the first request byte to the last response byte.", total);
+}
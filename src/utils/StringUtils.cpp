@@ -0,0 +1,213 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   StringUtils.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: nlouis <nlouis@student.hive.fi>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/05/02 13:45:05 by nlouis            #+#    #+#             */
+/*   Updated: 2025/05/12 16:03:44 by nlouis           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file    StringUtils.cpp
+ * @brief   Implements small string helpers shared across modules.
+ *
+ * @ingroup utils
+ */
+
+#include "utils/StringUtils.hpp"
+#include <cstdio>
+#include <limits>
+
+bool iequals(std::string_view a, std::string_view b) noexcept {
+    if (a.size() != b.size())
+        return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (toLowerAscii(a[i]) != toLowerAscii(b[i]))
+            return false;
+    }
+    return true;
+}
+
+std::string_view trim(std::string_view s) noexcept {
+    std::size_t begin = 0;
+    std::size_t end   = s.size();
+    while (begin < end && (s[begin] == ' ' || s[begin] == '\t'))
+        ++begin;
+    while (end > begin && (s[end - 1] == ' ' || s[end - 1] == '\t'))
+        --end;
+    return s.substr(begin, end - begin);
+}
+
+std::string toLower(std::string_view s) {
+    std::string out(s);
+    for (char& c : out)
+        c = toLowerAscii(c);
+    return out;
+}
+
+bool parseSize(std::string_view s, std::size_t& out) noexcept {
+    if (s.empty())
+        return false;
+    std::size_t value = 0;
+    for (char c : s) {
+        if (c < '0' || c > '9')
+            return false;
+        const std::size_t digit = static_cast<std::size_t>(c - '0');
+        if (value > (std::numeric_limits<std::size_t>::max() - digit) / 10)
+            return false;
+        value = value * 10 + digit;
+    }
+    out = value;
+    return true;
+}
+
+namespace {
+
+int hexValue(char c) noexcept {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+// Shared by the std::string and std::pmr::string overloads
+template <class String> bool normalizeInto(std::string_view path, String& out) {
+    if (path.empty() || path[0] != '/')
+        return false;
+
+    out.clear();
+    out.reserve(path.size());
+    String      segment(out.get_allocator());
+    bool        directory = false; // Last segment was empty, "." or ".."
+    std::size_t i         = 0;
+    while (i < path.size()) {
+        // Each iteration handles one "/segment"
+        ++i;
+        segment.clear();
+        while (i < path.size() && path[i] != '/') {
+            char c = path[i++];
+            if (c == '%') {
+                const int hi = i < path.size() ? hexValue(path[i]) : -1;
+                const int lo = i + 1 < path.size() ? hexValue(path[i + 1]) : -1;
+                if (hi < 0 || lo < 0)
+                    return false;
+                c = static_cast<char>(hi * 16 + lo);
+                if (c == '\0' || c == '/')
+                    return false;
+                i += 2;
+            }
+            segment += c;
+        }
+
+        directory = segment.empty() || segment == "." || segment == "..";
+        if (segment == "..") {
+            if (out.empty())
+                return false; // Would leave the document root
+            out.erase(out.rfind('/'));
+        } else if (!directory) {
+            out += '/';
+            out += segment;
+        }
+    }
+    if (out.empty() || directory)
+        out += '/';
+    return true;
+}
+
+} // namespace
+
+bool normalizeUriPath(std::string_view path, std::string& out) {
+    return normalizeInto(path, out);
+}
+
+bool normalizeUriPath(std::string_view path, std::pmr::string& out) {
+    return normalizeInto(path, out);
+}
+
+void appendPathSegment(std::string& out, std::string_view name) {
+    static const char HEX[] = "0123456789ABCDEF";
+    for (char c : name) {
+        const unsigned char byte = static_cast<unsigned char>(c);
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+            c == '-' || c == '.' || c == '_' || c == '~') {
+            out += c;
+        } else {
+            out += '%';
+            out += HEX[byte >> 4];
+            out += HEX[byte & 0x0F];
+        }
+    }
+}
+
+void appendEscapedHtml(std::string& out, std::string_view text) {
+    for (char c : text) {
+        switch (c) {
+            case '&': out += "&amp;"; break;
+            case '<': out += "&lt;"; break;
+            case '>': out += "&gt;"; break;
+            case '"': out += "&quot;"; break;
+            case '\'': out += "&#39;"; break;
+            default: out += c;
+        }
+    }
+}
+
+std::string formatHttpDate(std::time_t time) {
+    static const char DAYS[][4]   = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    static const char MONTHS[][4] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                     "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    struct tm         tm;
+    if (!gmtime_r(&time, &tm))
+        tm = {};
+
+    char buf[64]; // Room for out-of-range years; real dates use 29 bytes
+    std::snprintf(buf, sizeof(buf), "%.3s, %02d %.3s %04d %02d:%02d:%02d GMT", DAYS[tm.tm_wday % 7],
+                  tm.tm_mday, MONTHS[tm.tm_mon % 12], tm.tm_year + 1900, tm.tm_hour, tm.tm_min,
+                  tm.tm_sec);
+    return std::string(buf);
+}
+
+namespace {
+
+// Fixed-width decimal field; unlike strtol(), takes no sign or whitespace
+bool parseDigits(std::string_view s, int& out) noexcept {
+    out = 0;
+    for (char c : s) {
+        if (c < '0' || c > '9')
+            return false;
+        out = out * 10 + (c - '0');
+    }
+    return true;
+}
+
+} // namespace
+
+bool parseHttpDate(std::string_view s, std::time_t& out) noexcept {
+    static const char MONTHS[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+    // "Sun, 06 Nov 1994 08:49:37 GMT": every field is at a fixed offset
+    if (s.size() != 29 || s.substr(3, 2) != ", " || s[7] != ' ' || s[11] != ' ' ||
+        s[16] != ' ' || s[19] != ':' || s[22] != ':' || s.substr(25) != " GMT")
+        return false;
+    struct tm tm = {};
+    int       year;
+    if (!parseDigits(s.substr(5, 2), tm.tm_mday) || !parseDigits(s.substr(12, 4), year) ||
+        !parseDigits(s.substr(17, 2), tm.tm_hour) || !parseDigits(s.substr(20, 2), tm.tm_min) ||
+        !parseDigits(s.substr(23, 2), tm.tm_sec))
+        return false;
+    const std::string_view months(MONTHS, sizeof(MONTHS) - 1);
+    const std::size_t      month = months.find(s.substr(8, 3));
+    if (month == std::string_view::npos || month % 3 != 0 || tm.tm_mday < 1 || tm.tm_mday > 31 ||
+        tm.tm_hour > 23 || tm.tm_min > 59 || tm.tm_sec > 60)
+        return false;
+    tm.tm_mon  = static_cast<int>(month / 3);
+    tm.tm_year = year - 1900;
+    out        = timegm(&tm);
+    return true;
+}
@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_arena.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:35:47 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:35:47 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "utils/Arena.hpp"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void test_bump_allocation() {
+    Arena arena(256);
+    assert(arena.getBlockCount() == 0 && arena.getReserved() == 0); // Lazy
+
+    void* a = arena.allocate(10, 1);
+    void* b = arena.allocate(8, 8);
+    assert(arena.getBlockCount() == 1);
+    assert(reinterpret_cast<std::uintptr_t>(b) % 8 == 0);
+    assert(static_cast<char*>(b) >= static_cast<char*>(a) + 10);
+    assert(arena.getUsed() == 18);
+
+    arena.deallocate(a, 10, 1); // No-op, memory returns on reset()
+    assert(arena.getUsed() == 18);
+
+    void* aligned = arena.allocate(1, 64);
+    assert(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+    assert(arena.is_equal(arena));
+}
+
+void test_growth_and_reset() {
+    Arena arena(256);
+    void* start = arena.allocate(64, 8);
+    for (int i = 0; i < 20; ++i)
+        assert(arena.allocate(64, 8));
+    assert(arena.getBlockCount() > 1);
+
+    // reset() keeps the first block only, and hands it out again from the start
+    arena.reset();
+    assert(arena.getBlockCount() == 1 && arena.getReserved() == 256 && arena.getUsed() == 0);
+    assert(arena.allocate(64, 8) == start);
+    assert(arena.getBlockCount() == 1);
+
+    // Oversized requests get their own block, which an early reset() drops
+    Arena big(256);
+    assert(big.allocate(10000, 8));
+    assert(big.getReserved() > 10000);
+    big.reset();
+    assert(big.getBlockCount() == 0);
+
+    arena.release();
+    assert(arena.getBlockCount() == 0 && arena.getReserved() == 0);
+}
+
+void test_pmr_containers() {
+    Arena arena;
+    {
+        std::pmr::vector<std::pmr::string> fields(&arena);
+        fields.emplace_back("Content-Type: text/html with a value longer than SSO");
+        fields.emplace_back("short");
+        assert(fields[0].get_allocator().resource() == &arena);
+        assert(fields.size() == 2 && fields[1] == "short");
+    }
+    assert(arena.getUsed() > 0);
+    arena.reset();
+
+    // Steady state: the same work fits the retained block again
+    const std::size_t reserved = arena.getReserved();
+    std::pmr::string  text("another value that does not fit in small-string storage", &arena);
+    assert(arena.getReserved() == reserved);
+}
+
+int main() {
+    test_bump_allocation();
+    test_growth_and_reset();
+    test_pmr_containers();
+
+    std::cout << "✅ All Arena tests passed successfully.\n";
+    return 0;
+}
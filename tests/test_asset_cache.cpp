@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_asset_cache.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:31:21 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:12:25 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "http/AssetCache.hpp"
+#include "http/HttpResponse.hpp"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+
+static std::shared_ptr<const CachedFile> makeFile() {
+    struct stat st = {};
+    st.st_mode     = S_IFREG | 0644;
+    return std::make_shared<const CachedFile>(-1, st);
+}
+
+static HttpResponse makeResponse(int status, const std::string& body) {
+    HttpResponse response(status);
+    response.setBody(body, "text/plain");
+    return response;
+}
+
+void test_serialized_layout() {
+    const std::shared_ptr<const CachedFile> file = makeFile();
+    CachedResponse                          cached(makeResponse(200, "hello"), file);
+
+    assert(cached.getStatus() == 200);
+    assert(cached.getHead() == "HTTP/1.1 200 OK\r\n"
+                               "Content-Type: text/plain\r\n"
+                               "Content-Length: 5\r\n");
+    assert(cached.getBody() == "hello");
+    assert(cached.getData().size() == cached.getHeadLength() + 5);
+    assert(cached.isBuiltFrom(file));
+    assert(!cached.isBuiltFrom(makeFile()));
+    assert(!cached.isBuiltFrom(NULL));
+}
+
+void test_hits_and_invalidation() {
+    AssetCache                              cache;
+    const std::shared_ptr<const CachedFile> file = makeFile();
+
+    assert(!cache.find(200, "/a", file));
+    std::shared_ptr<const CachedResponse> stored =
+        cache.insert("/a", file, makeResponse(200, "aaa"));
+    assert(stored && cache.size() == 1);
+    assert(cache.find(200, "/a", file) == stored);
+    assert(!cache.find(404, "/a", file)); // Status is part of the key
+    assert(!cache.find(200, "/a", file, ContentCoding::GZIP)); // And so is the coding
+    assert(cache.getHits() == 1 && cache.getMisses() == 3);
+    std::shared_ptr<const CachedResponse> packed =
+        cache.insert("/a", file, makeResponse(200, "a"), ContentCoding::GZIP);
+    assert(packed && cache.size() == 2);
+    assert(cache.find(200, "/a", file, ContentCoding::GZIP) == packed);
+    assert(cache.find(200, "/a", file) == stored);
+
+    // A reopened file no longer matches, and the stale entry is dropped
+    assert(!cache.find(200, "/a", makeFile()));
+    assert(!cache.find(200, "/a", makeFile(), ContentCoding::GZIP));
+    assert(cache.size() == 0 && cache.getMemoryUsage() == 0);
+
+    // Generated bodies have no source file
+    stored = cache.insert("", NULL, makeResponse(500, "oops"));
+    assert(cache.find(500, "", NULL) == stored);
+    cache.clear();
+    assert(cache.size() == 0 && cache.getMemoryUsage() == 0);
+}
+
+void test_memory_cap() {
+    const std::shared_ptr<const CachedFile> file  = makeFile();
+    const HttpResponse                      small = makeResponse(200, std::string(100, 'x'));
+    const std::size_t entry = CachedResponse(small, file).getData().size();
+
+    AssetCache cache(entry * 2, 1000);
+    assert(cache.insert("/1", file, small));
+    assert(cache.insert("/2", file, small));
+    assert(cache.find(200, "/1", file)); // /2 becomes least recently used
+    assert(cache.insert("/3", file, small));
+    assert(cache.size() == 2 && cache.getMemoryUsage() == entry * 2);
+    assert(cache.find(200, "/1", file) && cache.find(200, "/3", file));
+    assert(!cache.find(200, "/2", file));
+
+    // Too large for one asset, or for the whole cache
+    assert(!cache.accepts(1001));
+    assert(!cache.insert("/big", file, makeResponse(200, std::string(1001, 'x'))));
+    AssetCache narrow(entry - 1, 1000);
+    assert(!narrow.insert("/1", file, small) && narrow.size() == 0);
+
+    AssetCache disabled(0);
+    assert(!disabled.accepts(0));
+    assert(!disabled.insert("/1", file, small));
+}
+
+int main() {
+    test_serialized_layout();
+    test_hits_and_invalidation();
+    test_memory_cap();
+
+    std::cout << "✅ All AssetCache tests passed successfully.\n";
+    return 0;
+}
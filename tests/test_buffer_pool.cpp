@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_buffer_pool.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:39:56 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:39:56 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "network/BufferPool.hpp"
+#include "network/ByteBuffer.hpp"
+#include "utils/Arena.hpp"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+void test_chunks_are_reused() {
+    BufferPool pool(1024, 2);
+    void*      a = pool.allocate(1024);
+    void*      b = pool.allocate(100); // Small requests still take a whole chunk
+    assert(pool.getInUse() == 2 && pool.getMisses() == 2 && pool.getHits() == 0);
+
+    pool.deallocate(a, 1024);
+    pool.deallocate(b, 100);
+    assert(pool.getInUse() == 0 && pool.getIdle() == 2 && pool.getHighWater() == 2);
+
+    void* c = pool.allocate(512);
+    assert(c == a || c == b);
+    assert(pool.getHits() == 1 && pool.getIdle() == 1);
+    pool.deallocate(c, 512);
+
+    pool.trim();
+    assert(pool.getIdle() == 0);
+}
+
+void test_idle_limit_and_oversize() {
+    BufferPool pool(256, 1);
+    void*      a = pool.allocate(256);
+    void*      b = pool.allocate(256);
+    pool.deallocate(a, 256);
+    pool.deallocate(b, 256); // Beyond max_idle: returned upstream
+    assert(pool.getIdle() == 1);
+
+    // Oversized requests bypass the pool and its statistics
+    void* big = pool.allocate(4096);
+    assert(pool.getInUse() == 0 && pool.getMisses() == 2);
+    pool.deallocate(big, 4096);
+}
+
+void test_buffers_borrow_from_pool() {
+    BufferPool pool(4096);
+    {
+        ByteBuffer buf(&pool);
+        std::memcpy(buf.prepare(10), "0123456789", 10);
+        buf.commit(10);
+        assert(pool.getInUse() == 1);
+        assert(!buf.release()); // Still holds data
+
+        // Growing past a chunk moves the data upstream and gives the chunk back
+        buf.prepare(10000);
+        assert(buf.view() == "0123456789" && pool.getInUse() == 0);
+        buf.consume(10);
+        assert(buf.release() && buf.capacity() == 0);
+
+        Arena arena(pool.getChunkSize(), &pool);
+        assert(arena.allocate(100, 8) && pool.getInUse() == 1);
+        arena.release();
+        assert(pool.getInUse() == 0);
+
+        std::memcpy(buf.prepare(4), "abcd", 4);
+        assert(pool.getInUse() == 1 && pool.getHits() == 2);
+    }
+    assert(pool.getInUse() == 0); // The destructor returned the chunk
+}
+
+int main() {
+    test_chunks_are_reused();
+    test_idle_limit_and_oversize();
+    test_buffers_borrow_from_pool();
+
+    std::cout << "✅ All BufferPool tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,291 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_cgi.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:00:25 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:40:18 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "cgi/CgiOutputParser.hpp"
+#include "cgi/CgiProcess.hpp"
+#include "network/SocketManager.hpp"
+#include <arpa/inet.h>
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+std::string g_dir; // Scratch directory holding the test scripts
+
+void writeScript(const std::string& name, const std::string& body) {
+    std::ofstream out((g_dir + "/" + name).c_str());
+    out << body;
+}
+
+// Drive a process to completion: feed input, collect all output
+std::string runToEnd(CgiProcess& process, const std::string& input) {
+    std::size_t sent = 0;
+    std::string output;
+    while (process.getOutputFd() >= 0) {
+        pollfd fds[2] = {{process.getOutputFd(), POLLIN, 0}, {process.getInputFd(), POLLOUT, 0}};
+        const nfds_t count = process.getInputFd() >= 0 ? 2 : 1;
+        assert(poll(fds, count, 5000) > 0);
+        if (count == 2 && fds[1].revents) {
+            const ssize_t written = process.writeInput(input.data() + sent, input.size() - sent);
+            if (written > 0)
+                sent += static_cast<std::size_t>(written);
+            if (written < 0 || sent == input.size())
+                process.closeInput();
+        }
+        if (fds[0].revents) {
+            char          buf[4096];
+            const ssize_t got = process.readOutput(buf, sizeof(buf));
+            if (got == 0)
+                process.closeOutput();
+            else if (got > 0)
+                output.append(buf, static_cast<std::size_t>(got));
+        }
+    }
+    return output;
+}
+
+HttpRequest parseRequest(const std::string& raw) {
+    HttpRequestParser parser;
+    HttpRequest       request;
+    assert(parser.parse(raw, request) == HttpRequestParser::Result::COMPLETE);
+    request.bind(raw.data());
+    return request;
+}
+
+} // namespace
+
+void test_parser_splits_head_and_body() {
+    CgiOutputParser parser;
+    assert(parser.feed("Content-Type: text/plain\nX-One: 1") ==
+           CgiOutputParser::Result::INCOMPLETE);
+    assert(parser.feed("\n") == CgiOutputParser::Result::INCOMPLETE);
+    assert(parser.feed("\nhello") == CgiOutputParser::Result::COMPLETE);
+    assert(parser.getStatus() == 200);
+    assert(parser.getFields().size() == 2);
+    assert(parser.getFields()[0].first == "Content-Type");
+    assert(parser.getFields()[1].second == "1");
+    assert(parser.takeBody() == "hello");
+}
+
+void test_parser_status_and_framing_fields() {
+    CgiOutputParser crlf;
+    assert(crlf.feed("Status: 404 Not Found\r\nContent-Length: 3\r\nConnection: close\r\n"
+                     "Set-Cookie: a=1\r\nSet-Cookie: b=2\r\n\r\nabc") ==
+           CgiOutputParser::Result::COMPLETE);
+    assert(crlf.getStatus() == 404);
+    assert(crlf.hasContentLength() && crlf.getContentLength() == 3);
+    assert(crlf.getFields().size() == 2); // Repeated fields kept, framing fields dropped
+    assert(crlf.takeBody() == "abc");
+
+    CgiOutputParser redirect;
+    assert(redirect.feed("Location: /elsewhere\n\n") == CgiOutputParser::Result::COMPLETE);
+    assert(redirect.getStatus() == 302);
+
+    CgiOutputParser bad_status;
+    assert(bad_status.feed("Status: 42\n\n") == CgiOutputParser::Result::ERROR);
+    CgiOutputParser no_colon;
+    assert(no_colon.feed("garbage\n\n") == CgiOutputParser::Result::ERROR);
+    CgiOutputParser bad_name;
+    assert(bad_name.feed("Bad Name: x\n\n") == CgiOutputParser::Result::ERROR);
+
+    CgiOutputParser endless;
+    assert(endless.feed(std::string(CgiOutputParser::MAX_HEAD_SIZE + 1, 'a')) ==
+           CgiOutputParser::Result::ERROR);
+}
+
+void test_command_environment() {
+    const std::string raw  = "POST /cgi/form.sh?x=1 HTTP/1.1\r\nHost: example.com\r\n"
+                             "Content-Type: text/plain\r\nContent-Length: 4\r\n"
+                             "X-Custom-Header: yes\r\nProxy: evil\r\n\r\n";
+    HttpRequest       request = parseRequest(raw);
+    Server            server;
+    server.setPort(8080);
+    Location location;
+    location.setRoot("/srv/");
+    location.setCgiInterpreter("/bin/sh");
+
+    const CgiProcess::Command command = CgiProcess::makeCommand(
+        request, server, location, "/cgi/form.sh", "/srv/cgi/form.sh", "/a/b", "192.0.2.7");
+    assert(command.argv.size() == 2);
+    assert(command.argv[0] == "/bin/sh" && command.argv[1] == "/srv/cgi/form.sh");
+    assert(command.directory == "/srv/cgi/");
+
+    const std::vector<std::string>& env = command.environment;
+    auto has = [&env](const std::string& entry) {
+        for (const std::string& e : env) {
+            if (e == entry)
+                return true;
+        }
+        return false;
+    };
+    assert(has("REQUEST_METHOD=POST"));
+    assert(has("QUERY_STRING=x=1"));
+    assert(has("SCRIPT_NAME=/cgi/form.sh"));
+    assert(has("SERVER_NAME=example.com"));
+    assert(has("SERVER_PORT=8080"));
+    assert(has("SERVER_PROTOCOL=HTTP/1.1"));
+    assert(has("CONTENT_LENGTH=4"));
+    assert(has("CONTENT_TYPE=text/plain"));
+    assert(has("HTTP_X_CUSTOM_HEADER=yes"));
+    assert(has("PATH_INFO=/a/b"));
+    assert(has("PATH_TRANSLATED=/srv/a/b"));
+    assert(has("REMOTE_ADDR=192.0.2.7"));
+    for (const std::string& e : env)
+        assert(e.compare(0, 11, "HTTP_PROXY=") != 0);
+}
+
+void test_process_round_trip() {
+    writeScript("echo.sh", "printf 'Content-Type: text/plain\\n\\n'\ncat\n");
+    CgiProcess::Command command;
+    command.argv      = {"/bin/sh", g_dir + "/echo.sh"};
+    command.directory = g_dir;
+
+    CgiProcess process;
+    assert(process.start(command));
+    assert(process.getPid() > 0);
+    const std::string body(200000, 'x'); // Larger than a pipe buffer: needs non-blocking writes
+    const std::string output = runToEnd(process, body);
+    assert(output == "Content-Type: text/plain\n\n" + body);
+
+    for (int i = 0; i < 500 && !process.reap(); ++i)
+        usleep(10000);
+    assert(process.getPid() == -1);
+}
+
+void test_process_terminate() {
+    CgiProcess::Command command;
+    command.argv = {"/bin/sh", "-c", "sleep 30"};
+
+    CgiProcess process;
+    assert(process.start(command));
+    char          buf[16];
+    const ssize_t got = process.readOutput(buf, sizeof(buf));
+    assert(got < 0 && errno == EAGAIN); // Nothing written yet, and the read did not block
+    process.terminate();
+    for (int i = 0; i < 500 && !process.reap(); ++i)
+        usleep(10000);
+    assert(process.getPid() == -1);
+}
+
+// --- Through the event loop ---
+
+namespace {
+
+int g_port = 0;
+
+std::string exchange(const std::string& request) {
+    const int   fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(static_cast<uint16_t>(g_port));
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    assert(connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    std::size_t sent = 0;
+    while (sent < request.size()) {
+        const ssize_t n = send(fd, request.data() + sent, request.size() - sent, 0);
+        assert(n > 0);
+        sent += static_cast<std::size_t>(n);
+    }
+    std::string response;
+    char        buf[4096];
+    ssize_t     got;
+    while ((got = recv(fd, buf, sizeof(buf), 0)) > 0)
+        response.append(buf, static_cast<std::size_t>(got));
+    close(fd);
+    return response;
+}
+
+} // namespace
+
+void test_event_loop_runs_scripts() {
+    writeScript("hello.sh", "printf 'Status: 201 Created\\r\\nX-Script: %s\\r\\n\\r\\n' "
+                            "\"$REQUEST_METHOD\"\nprintf 'body:'\ncat\n");
+    writeScript("sized.sh", "printf 'Content-Length: 2\\n\\nokEXTRA'\n");
+    writeScript("broken.sh", "echo 'not a header block'\n");
+    writeScript("slow.sh", "sleep 30\n");
+
+    Server server;
+    server.setHost("127.0.0.1");
+    g_port = 20000 + static_cast<int>((getpid() + 7) % 20000);
+    server.setPort(g_port);
+    server.setClientMaxBodySize(1 << 20);
+    Location cgi;
+    cgi.setPath("/cgi");
+    cgi.setRoot(g_dir);
+    cgi.setCgiExtension(".sh");
+    cgi.setCgiInterpreter("/bin/sh");
+    cgi.setCgiTimeout(1);
+    server.addLocation(cgi);
+    std::vector<Server> servers(1, server);
+    SocketManager manager(std::make_shared<const ConfigSnapshot>(servers));
+    std::thread   loop([&manager]() { manager.run(); });
+
+    // HTTP/1.1 without a length: chunked, the body streamed through stdin
+    const std::string body(100000, 'b');
+    std::string response = exchange("POST /cgi/hello.sh HTTP/1.1\r\nHost: x\r\nConnection: "
+                                    "close\r\nContent-Length: " +
+                                    std::to_string(body.size()) + "\r\n\r\n" + body);
+    assert(response.compare(0, 21, "HTTP/1.1 201 Created\r") == 0);
+    assert(response.find("X-Script: POST\r\n") != std::string::npos);
+    assert(response.find("Transfer-Encoding: chunked\r\n") != std::string::npos);
+    assert(response.find("Content-Length") == std::string::npos);
+    assert(response.size() > body.size() && response.find("0\r\n\r\n") == response.size() - 5);
+
+    // HTTP/1.0: close-delimited
+    response = exchange("GET /cgi/hello.sh HTTP/1.0\r\n\r\n");
+    assert(response.find("Transfer-Encoding") == std::string::npos);
+    assert(response.size() > 5 && response.compare(response.size() - 5, 5, "body:") == 0);
+
+    // Announced length: extra bytes are cut, the connection stays open for the next request
+    response = exchange("GET /cgi/sized.sh HTTP/1.1\r\nHost: x\r\n\r\n"
+                        "GET /cgi/sized.sh HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+    const std::size_t second = response.find("HTTP/1.1 200 OK", 1);
+    assert(second != std::string::npos);
+    assert(response.compare(second - 2, 2, "ok") == 0);
+    assert(response.compare(response.size() - 2, 2, "ok") == 0);
+
+    response = exchange("GET /cgi/broken.sh HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+    assert(response.compare(0, 12, "HTTP/1.1 502") == 0);
+    response = exchange("GET /cgi/missing.sh HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+    assert(response.compare(0, 12, "HTTP/1.1 404") == 0);
+    response = exchange("GET /cgi/slow.sh HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+    assert(response.compare(0, 12, "HTTP/1.1 504") == 0);
+
+    manager.stop();
+    loop.join();
+}
+
+int main() {
+    char dir[] = "/tmp/webserv_cgi_XXXXXX";
+    assert(mkdtemp(dir));
+    g_dir = dir;
+
+    test_parser_splits_head_and_body();
+    test_parser_status_and_framing_fields();
+    test_command_environment();
+    test_process_round_trip();
+    test_process_terminate();
+    test_event_loop_runs_scripts();
+
+    std::system(("rm -rf " + g_dir).c_str());
+    std::cout << "✅ All CGI tests passed successfully.\n";
+    return 0;
+}
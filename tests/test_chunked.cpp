@@ -0,0 +1,106 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_chunked.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:26:08 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:26:08 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "http/ChunkedDecoder.hpp"
+#include "http/ChunkedEncoder.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace {
+
+// Feed @p input to a decoder @p step bytes at a time, as reads would deliver it
+ChunkedDecoder::Result decodeAll(const std::string& input, std::size_t step, std::string& body,
+                                 std::size_t& leftover) {
+    ChunkedDecoder         decoder;
+    ChunkedDecoder::Result result = ChunkedDecoder::Result::INCOMPLETE;
+    leftover                      = 0;
+    for (std::size_t pos = 0; pos < input.size() && result == ChunkedDecoder::Result::INCOMPLETE;
+         pos += step) {
+        std::string piece    = input.substr(pos, step);
+        std::size_t size     = piece.size();
+        std::size_t consumed = 0;
+        result               = decoder.decode(&piece[0], size, consumed);
+        body.append(piece, 0, size);
+        if (result == ChunkedDecoder::Result::DONE)
+            leftover = input.size() - pos - consumed;
+    }
+    return result;
+}
+
+} // namespace
+
+void test_chunked_decoder() {
+    const std::string framed = "4;name=value\r\nWiki\r\n5\r\npedia\r\nE\r\n in\r\n\r\nchunks."
+                               "\r\n0\r\nExpires: never\r\n\r\nNEXT";
+    for (std::size_t step = 1; step <= framed.size(); ++step) {
+        std::string body;
+        std::size_t leftover = 0;
+        assert(decodeAll(framed, step, body, leftover) == ChunkedDecoder::Result::DONE);
+        assert(body == "Wikipedia in\r\n\r\nchunks.");
+        assert(leftover == 4); // "NEXT" belongs to the following request
+    }
+
+    std::string body;
+    std::size_t leftover = 0;
+    assert(decodeAll("x\r\n", 1, body, leftover) == ChunkedDecoder::Result::ERROR);
+    assert(decodeAll("3\nabc\r\n", 1, body, leftover) == ChunkedDecoder::Result::ERROR);
+    assert(decodeAll("3\r\nabcd\r\n", 3, body, leftover) == ChunkedDecoder::Result::ERROR);
+    assert(decodeAll("\r\n", 2, body, leftover) == ChunkedDecoder::Result::ERROR);
+    assert(decodeAll("fffffffffffffffff\r\n", 5, body, leftover) ==
+           ChunkedDecoder::Result::ERROR);
+    assert(decodeAll("1;" + std::string(ChunkedDecoder::MAX_LINE, 'x'), 512, body, leftover) ==
+           ChunkedDecoder::Result::ERROR);
+}
+
+void test_chunked_encoder() {
+    ChunkedEncoder encoder;
+    assert(encoder.chunkHead(5) == "5\r\n");
+    assert(encoder.chunkHead(0x1a2b) == "1a2b\r\n");
+    assert(encoder.chunkHead(static_cast<std::size_t>(-1)).size() ==
+           ChunkedEncoder::MAX_SIZE_LINE);
+    assert(encoder.chunkHead(0).empty()); // Would end the body
+    assert(!encoder.isFinished());
+    assert(encoder.finish() == "0\r\n\r\n");
+    assert(encoder.isFinished());
+    assert(encoder.finish().empty() && encoder.chunkHead(3).empty());
+}
+
+void test_encoded_body_decodes() {
+    const std::string pieces[] = {"a", "", std::string(70000, 'b'), "\r\n0\r\n\r\n"};
+    ChunkedEncoder    encoder;
+    std::string       framed;
+    std::string       expected;
+    for (const std::string& piece : pieces) {
+        if (piece.empty())
+            continue;
+        framed += encoder.chunkHead(piece.size());
+        framed += piece;
+        framed += ChunkedEncoder::CHUNK_END;
+        expected += piece;
+    }
+    framed += encoder.finish();
+
+    std::string body;
+    std::size_t leftover = 0;
+    assert(decodeAll(framed, 4096, body, leftover) == ChunkedDecoder::Result::DONE);
+    assert(body == expected && leftover == 0);
+}
+
+int main() {
+    test_chunked_decoder();
+    test_chunked_encoder();
+    test_encoded_body_decodes();
+
+    std::cout << "✅ All chunked coding tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,146 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_compression.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:12:25 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:12:25 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "http/Compression.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+#ifdef WEBSERV_HAVE_ZLIB
+# include <zlib.h>
+
+// Decodes a complete or flushed gzip stream
+static std::string gunzip(const std::string& data) {
+    z_stream stream = {};
+    assert(inflateInit2(&stream, 15 + 16) == Z_OK);
+    std::string out(1 << 16, '\0');
+    stream.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in  = static_cast<uInt>(data.size());
+    stream.next_out  = reinterpret_cast<Bytef*>(&out[0]);
+    stream.avail_out = static_cast<uInt>(out.size());
+    const int result = inflate(&stream, Z_SYNC_FLUSH);
+    assert(result == Z_OK || result == Z_STREAM_END);
+    out.resize(out.size() - stream.avail_out);
+    inflateEnd(&stream);
+    return out;
+}
+#endif
+
+void test_accept_encoding() {
+    const unsigned gzip = codingBit(ContentCoding::GZIP);
+    const unsigned br   = codingBit(ContentCoding::BROTLI);
+    assert(codingBit(ContentCoding::IDENTITY) == 0);
+
+    assert(parseAcceptEncoding("") == 0);
+    assert(parseAcceptEncoding("gzip, deflate, br") == (gzip | br));
+    assert(parseAcceptEncoding("GZIP") == gzip);
+    assert(parseAcceptEncoding("x-gzip") == gzip);
+    assert(parseAcceptEncoding("br;q=1.0, gzip;q=0.5") == (gzip | br));
+    assert(parseAcceptEncoding("br;q=0, gzip") == gzip);
+    assert(parseAcceptEncoding("gzip; Q=0.000") == 0);
+    assert(parseAcceptEncoding("gzip;q=0.001") == gzip);
+    assert(parseAcceptEncoding("*") == (gzip | br));
+    assert(parseAcceptEncoding("*, br;q=0") == gzip);
+    assert(parseAcceptEncoding("identity, *;q=0") == 0);
+    assert(parseAcceptEncoding("deflate, compress") == 0);
+
+    assert(preferredCoding(gzip | br) == ContentCoding::BROTLI);
+    assert(preferredCoding(gzip) == ContentCoding::GZIP);
+    assert(preferredCoding(0) == ContentCoding::IDENTITY);
+
+    assert(parseCodingName("gzip") == ContentCoding::GZIP);
+    assert(parseCodingName("br") == ContentCoding::BROTLI);
+    assert(parseCodingName("deflate") == ContentCoding::IDENTITY);
+    assert(contentEncodingField(ContentCoding::BROTLI) == "Content-Encoding: br\r\n");
+    assert(codingSuffix(ContentCoding::GZIP) == ".gz");
+}
+
+void test_compressible_types() {
+    assert(isCompressibleType("text/html"));
+    assert(isCompressibleType("text/plain; charset=utf-8"));
+    assert(isCompressibleType("Application/JSON"));
+    assert(isCompressibleType("image/svg+xml"));
+    assert(!isCompressibleType("image/png"));
+    assert(!isCompressibleType("application/gzip"));
+    assert(!isCompressibleType("text/"));
+    assert(!isCompressibleType(""));
+}
+
+void test_compressor() {
+    std::string text;
+    for (int i = 0; i < 200; ++i)
+        text += "<li>item " + std::to_string(i) + "</li>\n";
+
+#ifdef WEBSERV_HAVE_ZLIB
+    std::string whole;
+    assert(Compressor::compress(ContentCoding::GZIP, Compressor::CACHE_LEVEL, text, whole));
+    assert(whole.size() < text.size() / 2);
+    assert(static_cast<unsigned char>(whole[0]) == 0x1f);
+    assert(static_cast<unsigned char>(whole[1]) == 0x8b);
+    assert(gunzip(whole) == text);
+
+    // Every flushed piece is decodable before the stream ends
+    Compressor  stream(ContentCoding::GZIP, Compressor::STREAM_LEVEL);
+    std::string out;
+    assert(stream.isValid());
+    assert(stream.write(text.substr(0, 1000), out, true));
+    assert(gunzip(out) == text.substr(0, 1000));
+    assert(stream.write(text.substr(1000), out, true));
+    assert(stream.finish(out));
+    assert(gunzip(out) == text);
+#else
+    assert(!Compressor(ContentCoding::GZIP, 1).isValid());
+#endif
+
+#ifdef WEBSERV_HAVE_BROTLI
+    std::string packed;
+    assert(Compressor::compress(ContentCoding::BROTLI, Compressor::CACHE_LEVEL, text, packed));
+    assert(!packed.empty() && packed.size() < text.size() / 2);
+#else
+    std::string packed;
+    assert(!Compressor::compress(ContentCoding::BROTLI, 1, text, packed));
+#endif
+    assert(!Compressor(ContentCoding::IDENTITY, 1).isValid());
+}
+
+void test_budget() {
+    typedef CompressionBudget::Clock Clock;
+    const Clock::time_point          start = Clock::now();
+
+    CompressionBudget half(50);
+    assert(half.allows(start));
+    half.charge(start, start + std::chrono::milliseconds(60)); // 40 ms over the burst
+    assert(!half.allows(start + std::chrono::milliseconds(30)));
+    assert(half.getRefused() == 1);
+    // Repaid at half the wall-clock rate: 40 ms of debt takes 80 ms
+    assert(!half.allows(start + std::chrono::milliseconds(70)));
+    assert(half.allows(start + std::chrono::milliseconds(90)));
+
+    CompressionBudget off(0);
+    assert(!off.allows(start + std::chrono::seconds(10)));
+
+    CompressionBudget unlimited(150);
+    assert(unlimited.getPercent() == 100);
+    unlimited.charge(start, start + std::chrono::seconds(1));
+    assert(unlimited.allows(start));
+    assert(unlimited.getRefused() == 0);
+}
+
+int main() {
+    test_accept_encoding();
+    test_compressible_types();
+    test_compressor();
+    test_budget();
+
+    std::cout << "✅ All Compression tests passed successfully.\n";
+    return 0;
+}
@@ -11,6 +11,7 @@
 /* ************************************************************************** */
 
 #include "config/Config.hpp"
+#include "config/ConfigSnapshot.hpp"
 #include "core/Server.hpp"
 #include <cassert>
 #include <iostream>
@@ -18,6 +19,24 @@
 void test_default_is_empty() {
     Config config;
     assert(config.getServers().empty());
+    assert(config.getWorkerProcesses() == 1);
+    assert(config.getWorkerThreads() == 1);
+    assert(config.getMaxConnections() == Config::DEFAULT_MAX_CONNECTIONS);
+}
+
+void test_worker_settings() {
+    Config config;
+    config.setWorkerProcesses(4);
+    config.setWorkerThreads(0);
+    assert(config.getWorkerProcesses() == 4);
+    assert(config.getWorkerThreads() == 0); // 0 = one per CPU, resolved by Webserv
+
+    Config moved(std::move(config));
+    assert(moved.getWorkerProcesses() == 4);
+
+    assert(moved.getEventBackend() == PollBackend::AUTO);
+    moved.setEventBackend(PollBackend::IO_URING);
+    assert(moved.getEventBackend() == PollBackend::IO_URING);
 }
 
 void test_add_server() {
@@ -56,12 +75,55 @@ void test_move_assignment() {
     assert(config.getServers().empty());
 }
 
+void test_snapshot_is_stable() {
+    Config config;
+    Server s;
+    s.setPort(8080);
+    config.addServer(s);
+    config.setMaxConnections(10);
+
+    std::shared_ptr<const ConfigSnapshot> snapshot = ConfigSnapshot::create(config);
+    assert(snapshot->getMaxConnections() == 10);
+    const Server*                         first    = &snapshot->getServers()[0];
+
+    // Mutating the source config must not affect an already published snapshot
+    config.addServer(s);
+    assert(snapshot->getServers().size() == 1);
+    assert(&snapshot->getServers()[0] == first);
+    assert(first->getPort() == 8080);
+
+    // The host index points into the snapshot's own servers
+    assert(snapshot->getHosts().getDefault(8080) == first);
+    assert(snapshot->getHosts().find(8080, "anything") == first);
+}
+
+void test_servers_move_into_snapshot() {
+    Config config;
+    Server& server = config.emplaceServer();
+    server.setPort(8081);
+    server.emplaceLocation("/api").setRoot("/srv/api");
+    config.setMaxConnections(7);
+    const Location* location = &config.getServers()[0].getLocations()[0];
+
+    std::shared_ptr<const ConfigSnapshot> snapshot = ConfigSnapshot::create(std::move(config));
+    assert(snapshot->getServers().size() == 1);
+    assert(snapshot->getMaxConnections() == 7);
+    // The locations were moved along with their vector, not copied
+    assert(&snapshot->getServers()[0].getLocations()[0] == location);
+    assert(snapshot->getServers()[0].findLocation("/api/x") == location);
+    assert(config.getServers().empty());
+    assert(config.getMaxConnections() == 7);
+}
+
 int main() {
     test_default_is_empty();
+    test_worker_settings();
     test_add_server();
     test_get_servers_reference();
     test_move_constructor();
     test_move_assignment();
+    test_snapshot_is_stable();
+    test_servers_move_into_snapshot();
 
     std::cout << "All Config tests passed.\n";
     return 0;
@@ -0,0 +1,277 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_config_parser.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 03:56:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:44:24 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "config/ConfigParser.hpp"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+// Parses text that must be rejected and returns the error
+static ConfigParser::ParseError parseError(const std::string& text) {
+    try {
+        ConfigParser::parse(text, "test.conf");
+    } catch (const ConfigParser::ParseError& e) {
+        return e;
+    }
+    std::cerr << "accepted: " << text << "\n";
+    std::abort();
+}
+
+static bool rejects(const std::string& text, const std::string& message) {
+    const ConfigParser::ParseError error = parseError(text);
+    return std::string(error.what()).find(message) != std::string::npos;
+}
+
+void test_full_config() {
+    const Config config = ConfigParser::parse("# global settings\n"
+                                              "worker_processes auto;\n"
+                                              "worker_threads 4;\n"
+                                              "event_backend poll;\n"
+                                              "asset_cache_size 16m;\n"
+                                              "max_connections 2048;\n"
+                                              "compress_cpu_budget 25;\n"
+                                              "\n"
+                                              "server {\n"
+                                              "    listen *:8081 default_server backlog=64;\n"
+                                              "    server_name a.test 'b.test';\n"
+                                              "    error_page 404 500 502 /errors/x.html;\n"
+                                              "    client_max_body_size 2k;\n"
+                                              "    keepalive_timeout 2m;\n"
+                                              "    keepalive_requests 50;\n"
+                                              "    client_header_timeout 5s;\n"
+                                              "    client_body_timeout 7;\n"
+                                              "    send_timeout 1h;\n"
+                                              "    location / { root \"./my www\"; "
+                                              "index a.html; }\n"
+                                              "    location /api {\n"
+                                              "        methods GET DELETE; # inline comment\n"
+                                              "        autoindex on;\n"
+                                              "        autoindex_page_size 200;\n"
+                                              "        return 308 https://example.com/;\n"
+                                              "        upload_store /tmp;\n"
+                                              "        cgi_extension .py;\n"
+                                              "        cgi_interpreter /usr/bin/python3;\n"
+                                              "        cgi_max_processes 8;\n"
+                                              "        cgi_timeout 10;\n"
+                                              "        fastcgi_pass 127.0.0.1:9000;\n"
+                                              "        stats on;\n"
+                                              "        compress gzip br;\n"
+                                              "        compress_static on;\n"
+                                              "        compress_min_length 1k;\n"
+                                              "    }\n"
+                                              "    location /app {\n"
+                                              "        proxy_pass http://127.0.0.1:3000/ "
+                                              "unix:/run/app.sock;\n"
+                                              "        proxy_balance least_conn;\n"
+                                              "        proxy_timeout 2m;\n"
+                                              "    }\n"
+                                              "}\n"
+                                              "server{listen 9000;location /{return /moved;}}");
+    assert(config.getWorkerProcesses() == 0);
+    assert(config.getWorkerThreads() == 4);
+    assert(config.getEventBackend() == PollBackend::POLL);
+    assert(config.getAssetCacheSize() == 16u << 20);
+    assert(config.getMaxConnections() == 2048);
+    assert(config.getCompressCpuBudget() == 25);
+    assert(config.getServers().size() == 2);
+
+    const Server& server = config.getServers()[0];
+    assert(server.getHost() == "0.0.0.0" && server.getPort() == 8081);
+    assert(server.isDefaultServer() && server.getListenBacklog() == 64);
+    assert(server.getServerNames().size() == 2 && server.getServerNames()[1] == "b.test");
+    assert(server.getErrorPages().size() == 3);
+    assert(server.getErrorPages().at(502) == "/errors/x.html");
+    assert(server.getClientMaxBodySize() == 2048);
+    assert(server.getKeepAliveTimeout() == 120);
+    assert(server.getKeepAliveRequests() == 50);
+    assert(server.getClientHeaderTimeout() == 5);
+    assert(server.getClientBodyTimeout() == 7);
+    assert(server.getSendTimeout() == 3600);
+
+    assert(server.getLocations().size() == 3);
+    assert(server.getLocations()[0].getRoot() == "./my www");
+    assert(server.getLocations()[0].getIndex() == "a.html");
+    const Location& api = server.getLocations()[1];
+    assert(api.getPath() == "/api");
+    assert(api.isMethodAllowed(HttpMethod::DELETE) && !api.isMethodAllowed(HttpMethod::POST));
+    assert(api.isAutoindexEnabled() && api.getAutoindexPageSize() == 200);
+    assert(api.getRedirect() == "https://example.com/" && api.getReturnCode() == 308);
+    assert(api.getUploadStore() == "/tmp");
+    assert(api.getCgiExtension() == ".py");
+    assert(api.getCgiInterpreter() == "/usr/bin/python3");
+    assert(api.getCgiMaxProcesses() == 8 && api.getCgiTimeout() == 10);
+    assert(api.getFastcgiPass() == "127.0.0.1:9000");
+    assert(api.isStatsEnabled());
+    assert(api.getCompression() ==
+           (codingBit(ContentCoding::GZIP) | codingBit(ContentCoding::BROTLI)));
+    assert(api.isCompressStatic() && api.getCompressMinLength() == 1024);
+    assert(server.getLocations()[0].getCompression() == 0);
+    assert(api.getProxyPass().empty() && api.getProxyTimeout() == Location::DEFAULT_PROXY_TIMEOUT);
+    const Location& app = server.getLocations()[2];
+    assert(app.getProxyPass() == "127.0.0.1:3000 unix:/run/app.sock");
+    assert(app.getProxyBalance() == ProxyBalance::LEAST_CONN && app.getProxyTimeout() == 120);
+
+    const Server& second = config.getServers()[1];
+    assert(second.getHost() == "0.0.0.0" && second.getPort() == 9000);
+    assert(second.getLocations()[0].getReturnCode() == 302);
+}
+
+void test_errors_are_located() {
+    const ConfigParser::ParseError error = parseError("server {\n  listen 80;\n  bogus on;\n}\n");
+    assert(error.getLine() == 3 && error.getColumn() == 3);
+    assert(std::string(error.what()) == "test.conf:3:3: unknown directive \"bogus\"");
+
+    assert(rejects("server { listen 80 }", "not terminated by \";\""));
+    assert(rejects("server { listen 80;", "unexpected end of file"));
+    assert(rejects("server { listen 80; } }", "unexpected \"}\""));
+    assert(rejects("server;", "has no block"));
+    assert(rejects("worker_threads 2 { }", "takes no block"));
+    assert(rejects("server { root /; }", "not allowed in server"));
+    assert(rejects("server { location / { listen 80; } }", "not allowed in location"));
+    assert(rejects("listen 80;", "not allowed in the main context"));
+    assert(rejects("server { listen 80 81 82 83 84 85; }", "invalid number of arguments"));
+    assert(rejects("server { server_name 'open; }", "unterminated quoted string"));
+    assert(rejects("# nothing\n", "no \"server\" block"));
+}
+
+void test_values_are_validated() {
+    assert(rejects("server { listen 0; }", "between 1 and 65535"));
+    assert(rejects("server { listen 65536; }", "out of range"));
+    assert(rejects("server { listen 1.2.3:80; }", "invalid IPv4 address"));
+    assert(rejects("server { listen 80 fast; }", "invalid listen option"));
+    assert(rejects("server { listen 80; listen 81; }", "duplicate \"listen\""));
+    assert(rejects("server { error_page 200 /x; }", "between 300 and 599"));
+    assert(rejects("server { error_page 404 x.html; }", "must be a path"));
+    assert(rejects("server { client_max_body_size 10x; }", "invalid number"));
+    assert(rejects("server { client_max_body_size 99999999999999999999; }", "out of range"));
+    assert(rejects("server { location api { } }", "must start with \"/\""));
+    assert(rejects("server { location /a { } location /a { } }", "duplicate location"));
+    assert(rejects("server { location / { methods GET FETCH; } }", "unknown method \"FETCH\""));
+    assert(rejects("server { location / { autoindex yes; } }", "expected \"on\" or \"off\""));
+    assert(rejects("server { location / { autoindex_page_size 65536; } }", "out of range"));
+    assert(rejects("server { location / { return 200 /x; } }", "redirect code"));
+    assert(rejects("server { location / { cgi_extension py; } }", "must start with \".\""));
+    assert(rejects("server { location / { root ''; } }", "empty value"));
+    assert(rejects("event_backend select; server { }", "unknown event backend"));
+    assert(rejects("server { location / { compress zstd; } }", "unknown content coding"));
+    assert(rejects("compress_cpu_budget 101; server { }", "out of range"));
+    assert(rejects("server { location / { proxy_pass app.test:80; } }", "invalid upstream"));
+    assert(rejects("server { location / { proxy_pass https://1.2.3.4:443; } }", "https"));
+    assert(rejects("server { location / { proxy_balance random; } }", "round_robin or least"));
+
+    // Nested locations are told apart from prefixes
+    const Config config = ConfigParser::parse("server { location /a { } location /ab { } }");
+    assert(config.getServers()[0].getLocations().size() == 2);
+}
+
+void test_cpu_placement() {
+    Config config = ConfigParser::parse("worker_cpu_affinity 3 0-2 8;\n"
+                                        "worker_numa_local on;\n"
+                                        "server { listen 8080 busy_poll=50; }\n"
+                                        "server { listen 8081; }\n");
+    assert(config.getCpuAffinity() == CpuAffinity::LIST && config.isNumaLocal());
+    const std::vector<unsigned> cpus = {3, 0, 1, 2, 8};
+    assert(config.getWorkerCpus() == cpus);
+    assert(config.getServers()[0].getBusyPoll() == 50);
+    assert(config.getServers()[1].getBusyPoll() == 0);
+
+    config = ConfigParser::parse("worker_cpu_affinity auto; server { }");
+    assert(config.getCpuAffinity() == CpuAffinity::AUTO && config.getWorkerCpus().empty());
+    config = ConfigParser::parse("server { }");
+    assert(config.getCpuAffinity() == CpuAffinity::OFF && !config.isNumaLocal());
+
+    assert(rejects("worker_cpu_affinity 4-2; server { }", "invalid CPU range"));
+    assert(rejects("worker_cpu_affinity 1024; server { }", "out of range"));
+    assert(rejects("worker_cpu_affinity auto 1; server { }", "invalid number"));
+    assert(rejects("worker_numa_local on; server { }", "needs \"worker_cpu_affinity\""));
+    assert(rejects("server { listen 80 busy_poll=fast; }", "invalid number"));
+}
+
+void test_slow_request_threshold() {
+    Config config = ConfigParser::parse("slow_request_threshold 250ms; server { }");
+    assert(config.getSlowRequestThreshold() == 250);
+    config = ConfigParser::parse("slow_request_threshold 2; server { }");
+    assert(config.getSlowRequestThreshold() == 2000);
+    config = ConfigParser::parse("slow_request_threshold 1m; server { }");
+    assert(config.getSlowRequestThreshold() == 60000);
+    config = ConfigParser::parse("slow_request_threshold off; server { }");
+    assert(config.getSlowRequestThreshold() == 0);
+    config = ConfigParser::parse("server { }");
+    assert(config.getSlowRequestThreshold() == 0);
+
+    assert(rejects("slow_request_threshold 5us; server { }", "invalid number"));
+    assert(rejects("slow_request_threshold ms; server { }", "invalid number"));
+    assert(rejects("server { slow_request_threshold 1s; }", "is not allowed in"));
+}
+
+void test_ssl_server() {
+    const Config config = ConfigParser::parse("server {\n"
+                                              "    listen 8443 ssl default_server;\n"
+                                              "    ssl_certificate cert.pem;\n"
+                                              "    ssl_certificate_key key.pem;\n"
+                                              "    ssl_session_cache 1000;\n"
+                                              "    ssl_session_timeout 10m;\n"
+                                              "    ssl_session_tickets off;\n"
+                                              "}\n"
+                                              "server { listen 8080; }\n");
+    const Server& tls = config.getServers()[0];
+    assert(tls.isSsl() && tls.getPort() == 8443);
+    assert(tls.getSslCertificate() == "cert.pem" && tls.getSslCertificateKey() == "key.pem");
+    assert(tls.getSslSessionCache() == 1000 && tls.getSslSessionTimeout() == 600);
+    assert(!tls.isSslSessionTickets());
+
+    const Server& plain = config.getServers()[1];
+    assert(!plain.isSsl() && plain.isSslSessionTickets());
+    assert(plain.getSslSessionCache() == Server::DEFAULT_SSL_SESSION_CACHE);
+    assert(plain.getSslSessionTimeout() == Server::DEFAULT_SSL_SESSION_TIMEOUT);
+
+    assert(rejects("server { listen 443 ssl; }", "needs \"ssl_certificate\""));
+    assert(rejects("server { listen 443 ssl; ssl_certificate c.pem; }", "ssl_certificate_key"));
+    assert(rejects("server { ssl_session_tickets maybe; }", "expected \"on\" or \"off\""));
+}
+
+void test_parse_file() {
+    char path[] = "/tmp/webserv_conf_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    const std::string text = "server {\r\n\tlisten localhost:8080;\r\n\tlocation / { }\r\n}\r\n";
+    assert(write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+    close(fd);
+
+    const Config config = ConfigParser::parseFile(path);
+    assert(config.getServers().size() == 1);
+    assert(config.getServers()[0].getHost() == "localhost");
+    unlink(path);
+
+    try {
+        ConfigParser::parseFile(path);
+        assert(false);
+    } catch (const ConfigParser::ParseError& e) {
+        assert(e.getLine() == 0);
+        assert(std::string(e.what()).find(path) == 0);
+    }
+}
+
+int main() {
+    test_full_config();
+    test_errors_are_located();
+    test_values_are_validated();
+    test_cpu_placement();
+    test_slow_request_threshold();
+    test_ssl_server();
+    test_parse_file();
+
+    std::cout << "✅ All ConfigParser tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,456 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_connection.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:04:14 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 03:49:28 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "network/BufferPool.hpp"
+#include "network/ByteBuffer.hpp"
+#include "network/Connection.hpp"
+#include <cassert>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+static void makePair(int fds[2]) {
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    assert(fcntl(fds[0], F_SETFL, O_NONBLOCK) == 0);
+}
+
+static void sendAll(int fd, const std::string& data) {
+    assert(write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size()));
+}
+
+void test_byte_buffer_grows_and_compacts() {
+    ByteBuffer buf;
+    assert(buf.empty());
+
+    char* dst = buf.prepare(10);
+    std::memcpy(dst, "hello world", 11);
+    buf.commit(11);
+    assert(buf.view() == "hello world");
+
+    buf.consume(6);
+    assert(buf.view() == "world");
+
+    // Requesting more than the free tail forces compaction or growth, data survives
+    const std::size_t big = buf.capacity();
+    buf.prepare(big);
+    assert(buf.view() == "world");
+    assert(buf.writableSize() >= big);
+
+    buf.consume(5);
+    assert(buf.empty());
+}
+
+void test_idle_connection_returns_buffers() {
+    int fds[2];
+    makePair(fds);
+    Server     server;
+    BufferPool pool;
+    Connection conn(fds[0], &server, NULL, &pool);
+    assert(pool.getInUse() == 0); // Nothing is borrowed before the first byte
+
+    sendAll(fds[1], "GET / HTTP/1.1\r\nHost: a\r\n\r\nGET /next");
+    assert(conn.readFromSocket() == IoStatus::OK);
+    assert(pool.getInUse() == 1);
+    assert(conn.parseInput());
+    assert(conn.getArena().allocate(64, 8) && pool.getInUse() == 2);
+    assert(!conn.releaseIdleMemory()); // A request is in flight
+
+    conn.finishRequest();
+    assert(!conn.releaseIdleMemory()); // "GET /next" is still buffered
+
+    sendAll(fds[1], " HTTP/1.1\r\nHost: a\r\n\r\n");
+    assert(conn.readFromSocket() == IoStatus::OK);
+    assert(conn.parseInput());
+    conn.finishRequest();
+    assert(conn.releaseIdleMemory());
+    assert(pool.getInUse() == 0 && pool.getIdle() == 2 && pool.getHighWater() == 2);
+
+    // The next request borrows the same chunks back
+    sendAll(fds[1], "GET / HTTP/1.1\r\nHost: a\r\n\r\n");
+    assert(conn.readFromSocket() == IoStatus::OK && conn.parseInput());
+    assert(pool.getHits() == 1 && pool.getMisses() == 2);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_request_split_across_reads() {
+    int fds[2];
+    makePair(fds);
+    Server     server;
+    Connection conn(fds[0], &server);
+
+    sendAll(fds[1], "GET / HTTP/1.1\r\nHost: a\r");
+    assert(conn.readFromSocket() == IoStatus::OK);
+    assert(!conn.parseInput());
+    assert(conn.getState() == ConnectionState::READING_HEADERS);
+
+    sendAll(fds[1], "\n\r\n");
+    assert(conn.readFromSocket() == IoStatus::OK);
+    assert(conn.parseInput());
+    assert(conn.requestHead() == "GET / HTTP/1.1\r\nHost: a\r\n\r\n");
+    assert(conn.requestBody().empty());
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_body_by_content_length() {
+    int fds[2];
+    makePair(fds);
+    Server     server;
+    Connection conn(fds[0], &server);
+
+    sendAll(fds[1], "POST /up HTTP/1.1\r\nHost: a\r\ncontent-length: 5\r\n\r\nab");
+    conn.readFromSocket();
+    assert(!conn.parseInput());
+    assert(conn.getState() == ConnectionState::READING_BODY);
+
+    sendAll(fds[1], "cde");
+    conn.readFromSocket();
+    assert(conn.parseInput());
+    assert(conn.requestBody() == "abcde");
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_chunked_body() {
+    int fds[2];
+    makePair(fds);
+    Server server;
+    server.setClientMaxBodySize(8);
+    Connection conn(fds[0], &server);
+
+    // The framing is split mid-line; the body comes out decoded, the next request survives
+    sendAll(fds[1], "POST /up HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\n3;x=1\r");
+    conn.readFromSocket();
+    assert(!conn.parseInput());
+    sendAll(fds[1], "\nabc\r\n2\r\nde\r\n0\r\nX-Trailer: 1\r\n\r\n"
+                    "GET / HTTP/1.1\r\nHost: a\r\n\r\n");
+    conn.readFromSocket();
+    assert(conn.parseInput());
+    assert(conn.requestBody() == "abcde");
+    conn.finishRequest();
+    assert(conn.parseInput());
+    assert(conn.getRequest().getMethod() == HttpMethod::GET);
+    conn.finishRequest();
+
+    // The size limit is checked as the chunks arrive
+    sendAll(fds[1], "POST /up HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\n"
+                    "9\r\n123456789\r\n");
+    conn.readFromSocket();
+    assert(!conn.parseInput());
+    assert(conn.getErrorStatus() == 413);
+
+    close(fds[0]);
+    close(fds[1]);
+
+    makePair(fds);
+    Connection bad(fds[0], &server);
+    sendAll(fds[1], "POST /up HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n");
+    bad.readFromSocket();
+    assert(!bad.parseInput());
+    assert(bad.getErrorStatus() == 400);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_streamed_body_continues() {
+    int fds[2];
+    makePair(fds);
+    Server     server;
+    Connection conn(fds[0], &server);
+
+    sendAll(fds[1], "POST /up HTTP/1.1\r\nHost: a\r\nContent-Length: 4\r\n"
+                    "Expect: 100-continue\r\n\r\n");
+    conn.readFromSocket();
+    assert(!conn.parseInput());
+    assert(conn.claimHead());
+    conn.streamBody();
+    assert(conn.hasPendingOutput()); // 100 Continue
+    assert(conn.writeToSocket() == IoStatus::OK);
+    char          buf[64];
+    const ssize_t got = read(fds[1], buf, sizeof(buf));
+    assert(std::string(buf, static_cast<std::size_t>(got)) == "HTTP/1.1 100 Continue\r\n\r\n");
+
+    sendAll(fds[1], "data");
+    conn.readFromSocket();
+    assert(conn.bodyData() == "data" && !conn.isBodyComplete());
+    conn.consumeBody(4);
+    assert(conn.isBodyComplete());
+    conn.finishRequest();
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_limits() {
+    int fds[2];
+    makePair(fds);
+    Server server;
+    server.setClientMaxBodySize(4);
+    Connection conn(fds[0], &server);
+
+    sendAll(fds[1], "POST / HTTP/1.1\r\nHost: a\r\nContent-Length: 10\r\n\r\n");
+    conn.readFromSocket();
+    assert(!conn.parseInput());
+    assert(conn.getErrorStatus() == 413);
+    assert(conn.shouldClose());
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_virtual_host_limits() {
+    int fds[2];
+    makePair(fds);
+    std::vector<Server> servers(2);
+    servers[0].addServerName("small.test");
+    servers[0].setClientMaxBodySize(4);
+    servers[1].addServerName("large.test");
+    servers[1].setClientMaxBodySize(64);
+    const VirtualHostIndex hosts(servers);
+    Connection             conn(fds[0], &servers[0], &hosts);
+
+    // The Host header selects the server whose limits apply
+    sendAll(fds[1], "POST / HTTP/1.1\r\nHost: LARGE.test:80\r\nContent-Length: 10\r\n\r\n"
+                    "0123456789");
+    conn.readFromSocket();
+    assert(conn.parseInput());
+    assert(conn.getServer() == &servers[1]);
+    conn.finishRequest();
+
+    sendAll(fds[1], "POST / HTTP/1.1\r\nHost: small.test\r\nContent-Length: 10\r\n\r\n");
+    conn.readFromSocket();
+    assert(!conn.parseInput());
+    assert(conn.getServer() == &servers[0]);
+    assert(conn.getErrorStatus() == 413);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_rebind_waits_for_request_end() {
+    int fds[2];
+    makePair(fds);
+    std::vector<Server> before(1);
+    std::vector<Server> after(2);
+    after[1].addServerName("new.test");
+    const VirtualHostIndex hosts(after);
+    Connection             conn(fds[0], &before[0]);
+
+    // The request in flight keeps the server it was parsed with
+    sendAll(fds[1], "GET / HTTP/1.1\r\nHost: new.test\r\n\r\n");
+    conn.readFromSocket();
+    assert(conn.parseInput());
+    assert(!conn.rebind(&after[0], &hosts));
+    assert(conn.getServer() == &before[0]);
+    conn.finishRequest();
+
+    // The next one is resolved in the new configuration
+    assert(conn.rebind(&after[0], &hosts));
+    sendAll(fds[1], "GET / HTTP/1.1\r\nHost: new.test\r\n\r\n");
+    conn.readFromSocket();
+    assert(conn.parseInput());
+    assert(conn.getServer() == &after[1]);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_file_output_uses_sendfile() {
+    int fds[2];
+    makePair(fds);
+    Server     server;
+    Connection conn(fds[0], &server);
+
+    char path[] = "/tmp/webserv_conn_XXXXXX";
+    int  fd     = mkstemp(path);
+    assert(fd >= 0);
+    const std::string content(100000, 'z');
+    assert(write(fd, content.data(), content.size()) == static_cast<ssize_t>(content.size()));
+    close(fd);
+
+    FileCache                         files;
+    std::shared_ptr<const CachedFile> file = files.open(path).file;
+    unlink(path); // The cached descriptor keeps the data reachable
+    files.clear();
+
+    conn.queueOutput("HEAD\n");
+    conn.queueFile(file, 10, 99990);
+    file.reset(); // The queue owns the file now
+
+    // Drain the socket pair while the connection keeps sending
+    std::string received;
+    char        buf[65536];
+    while (conn.hasPendingOutput() || received.size() < 5 + 99990) {
+        IoStatus status = conn.writeToSocket();
+        assert(status != IoStatus::ERROR);
+        ssize_t n = read(fds[1], buf, sizeof(buf));
+        if (n > 0)
+            received.append(buf, static_cast<std::size_t>(n));
+    }
+    assert(received == "HEAD\n" + content.substr(10));
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_shared_output_is_gathered() {
+    int fds[2];
+    makePair(fds);
+    Server     server;
+    Connection conn(fds[0], &server);
+
+    std::shared_ptr<const std::string> cached =
+        std::make_shared<const std::string>("HTTP/1.1 200 OK\r\nContent-Length: 4\r\nbody");
+    conn.queueShared(cached, 0, cached->size() - 4);
+    conn.queueOutput("Connection: close\r\n\r\n");
+    conn.queueShared(cached, cached->size() - 4, 4);
+    conn.queueShared(cached, 0, 0); // Empty ranges are not queued
+    assert(cached.use_count() == 3);
+
+    assert(conn.writeToSocket() == IoStatus::OK);
+    assert(!conn.hasPendingOutput() && cached.use_count() == 1);
+
+    char    buf[256];
+    ssize_t n = read(fds[1], buf, sizeof(buf));
+    assert(std::string(buf, static_cast<std::size_t>(n)) ==
+           "HTTP/1.1 200 OK\r\nContent-Length: 4\r\nConnection: close\r\n\r\nbody");
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_response_segments_are_sent() {
+    int fds[2];
+    makePair(fds);
+    Server     server;
+    Connection conn(fds[0], &server);
+
+    HttpResponse response(404);
+    response.addField("Connection: close\r\n");
+    response.setBody("gone");
+    conn.queueResponse(response, false);
+    HttpResponse head(200);
+    head.setBody("skipped");
+    conn.queueResponse(head, true);
+    assert(conn.writeToSocket() == IoStatus::OK && !conn.hasPendingOutput());
+
+    char    buf[256];
+    ssize_t n = read(fds[1], buf, sizeof(buf));
+    assert(std::string(buf, static_cast<std::size_t>(n)) ==
+           "HTTP/1.1 404 Not Found\r\nConnection: close\r\nContent-Length: 4\r\n\r\ngone"
+           "HTTP/1.1 200 OK\r\nContent-Length: 7\r\n\r\n");
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_output_queue_flushes() {
+    int fds[2];
+    makePair(fds);
+    Server     server;
+    Connection conn(fds[0], &server);
+
+    conn.queueOutput("HTTP/1.1 200 OK\r\n");
+    conn.queueOutput("\r\n");
+    assert(conn.getState() == ConnectionState::WRITING);
+    assert(conn.writeToSocket() == IoStatus::OK);
+    assert(!conn.hasPendingOutput());
+
+    char    buf[64];
+    ssize_t n = read(fds[1], buf, sizeof(buf));
+    assert(std::string(buf, static_cast<std::size_t>(n)) == "HTTP/1.1 200 OK\r\n\r\n");
+
+    // Closing connections end in CLOSING once drained
+    conn.queueOutput("x");
+    conn.closeAfterWrite();
+    assert(conn.writeToSocket() == IoStatus::OK);
+    assert(conn.getState() == ConnectionState::CLOSING);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_pipelined_requests_in_order() {
+    int fds[2];
+    makePair(fds);
+    Server     server;
+    Connection conn(fds[0], &server);
+
+    sendAll(fds[1], "GET /a HTTP/1.1\r\nHost: a\r\n\r\n"
+                    "GET /b HTTP/1.1\r\nHost: a\r\nConnection: close\r\n\r\n");
+    conn.readFromSocket();
+
+    assert(conn.parseInput());
+    assert(conn.requestHead().substr(0, 6) == "GET /a");
+    assert(conn.wantsKeepAlive());
+    conn.finishRequest();
+    conn.queueOutput("first");
+
+    // The second request is parsed while the first response is still queued
+    assert(conn.parseInput());
+    assert(conn.requestHead().substr(0, 6) == "GET /b");
+    assert(!conn.wantsKeepAlive());
+    conn.finishRequest();
+    assert(conn.getRequestCount() == 2);
+    assert(!conn.parseInput());
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_http10_defaults_to_close() {
+    int fds[2];
+    makePair(fds);
+    Server     server;
+    Connection conn(fds[0], &server);
+
+    sendAll(fds[1], "GET / HTTP/1.0\r\n\r\nGET / HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n");
+    conn.readFromSocket();
+    assert(conn.parseInput());
+    assert(!conn.wantsKeepAlive());
+    conn.finishRequest();
+    assert(conn.parseInput());
+    assert(conn.wantsKeepAlive());
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+int main() {
+    test_byte_buffer_grows_and_compacts();
+    test_request_split_across_reads();
+    test_idle_connection_returns_buffers();
+    test_body_by_content_length();
+    test_limits();
+    test_virtual_host_limits();
+    test_rebind_waits_for_request_end();
+    test_chunked_body();
+    test_streamed_body_continues();
+    test_output_queue_flushes();
+    test_file_output_uses_sendfile();
+    test_shared_output_is_gathered();
+    test_response_segments_are_sent();
+    test_pipelined_requests_in_order();
+    test_http10_defaults_to_close();
+
+    std::cout << "✅ All Connection tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_cpu_affinity.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 05:09:56 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:09:56 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "utils/CpuAffinity.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <iostream>
+#include <thread>
+
+void test_allowed_cpus() {
+    const std::vector<unsigned> cpus = allowedCpus();
+    assert(!cpus.empty());
+    assert(std::is_sorted(cpus.begin(), cpus.end()));
+    assert(std::adjacent_find(cpus.begin(), cpus.end()) == cpus.end());
+}
+
+void test_pinning() {
+#if defined(__linux__)
+    const unsigned last = allowedCpus().back();
+    std::thread([last]() {
+        assert(pinThreadToCpu(last));
+        assert(pinnedCpu() == static_cast<int>(last));
+        // The policy call can be filtered in containers; it must then say why
+        const int node = preferLocalNode();
+        assert(node >= 0 || errno != 0);
+    }).join();
+
+    // Other threads, and CPUs outside the process mask, are left alone
+    assert(allowedCpus().size() == 1 || pinnedCpu() == -1);
+    std::thread([]() {
+        assert(!pinThreadToCpu(100000) && errno == EINVAL);
+    }).join();
+#else
+    assert(!pinThreadToCpu(0) && errno == ENOSYS);
+    assert(pinnedCpu() == -1);
+#endif
+}
+
+int main() {
+    test_allowed_cpus();
+    test_pinning();
+
+    std::cout << "✅ All CpuAffinity tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,49 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_date_cache.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:45:44 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:45:44 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "http/DateCache.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+void test_field_format() {
+    DateCache date;
+    assert(date.getField()->compare(0, 6, "Date: ") == 0);
+    assert(date.getField()->size() == 6 + 29 + 2); // IMF-fixdate and CRLF
+
+    assert(date.update(784111777));
+    assert(*date.getField() == "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n");
+    assert(date.getTime() == 784111777);
+}
+
+void test_refresh_once_per_second() {
+    DateCache date;
+    date.update(784111777);
+    const std::shared_ptr<const std::string> queued = date.getField();
+
+    assert(!date.update(784111777)); // Same second: nothing is formatted
+    assert(date.getField() == queued);
+
+    // A new second gets a new line; the one still queued is left intact
+    assert(date.update(784111778));
+    assert(date.getField() != queued);
+    assert(*queued == "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n");
+    assert(*date.getField() == "Date: Sun, 06 Nov 1994 08:49:38 GMT\r\n");
+}
+
+int main() {
+    test_field_format();
+    test_refresh_once_per_second();
+
+    std::cout << "✅ All DateCache tests passed successfully.\n";
+    return 0;
+}
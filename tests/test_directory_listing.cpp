@@ -0,0 +1,155 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_directory_listing.cpp                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:48:46 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:48:46 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "http/DirectoryListing.hpp"
+#include <cassert>
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static std::string g_root;
+
+static std::shared_ptr<const CachedFile> makeDirectory() {
+    struct stat st = {};
+    st.st_mode     = S_IFDIR | 0755;
+    return std::make_shared<const CachedFile>(-1, st);
+}
+
+static std::shared_ptr<const DirectoryListing> scanAll(DirectoryScan& scan, std::size_t& steps) {
+    steps = 1;
+    while (!scan.step())
+        ++steps;
+    return scan.getListing();
+}
+
+void test_small_directory() {
+    DirectoryScan                           scan(g_root, makeDirectory());
+    std::size_t                             steps;
+    std::shared_ptr<const DirectoryListing> listing = scanAll(scan, steps);
+    assert(listing && scan.getError() == 0);
+    assert(listing->size() == 3); // The hidden file is left out
+
+    // Subdirectories first, names escaped for the link and for the text
+    const std::string_view rows = listing->getRows(0, 3);
+    assert(rows.find("<a href=\"sub/\">sub/</a>") == 8);
+    assert(rows.find("<a href=\"a%20%26%20b.txt\">a &amp; b.txt</a>") != std::string::npos);
+    assert(rows.find("<td>5</td></tr>\r\n") != std::string::npos);
+    assert(rows.find("<td>-</td></tr>\r\n") != std::string::npos);
+    assert(rows.find(".hidden") == std::string::npos);
+
+    // Slices are whole rows, clamped to the listing
+    assert(listing->getRows(0, 1) == rows.substr(0, rows.find("\r\n") + 2));
+    assert(listing->getRows(1, 10).size() + listing->getRows(0, 1).size() == rows.size());
+    assert(listing->getRows(7, 2).empty());
+    assert(scan.step()); // Finished scans stay finished
+}
+
+void test_large_directory_in_steps() {
+    const std::string dir = g_root + "/sub";
+    const std::size_t count = DirectoryScan::STEP * 2 + 10;
+    for (std::size_t i = 0; i < count; ++i)
+        std::ofstream((dir + "/f" + std::to_string(i)).c_str());
+
+    DirectoryScan                           scan(dir, makeDirectory());
+    std::size_t                             steps;
+    std::shared_ptr<const DirectoryListing> listing = scanAll(scan, steps);
+    assert(listing && listing->size() == count);
+    assert(steps >= 6); // Three to read, three to render, none longer than STEP entries
+    assert(listing->getRows(0, 1).find("f0<") != std::string::npos);
+    assert(listing->getRows(1, 1).find("f1<") != std::string::npos);
+    assert(listing->getRows(2, 1).find("f10<") != std::string::npos); // Byte order
+
+    for (std::size_t i = 0; i < count; ++i)
+        unlink((dir + "/f" + std::to_string(i)).c_str());
+}
+
+void test_scan_errors() {
+    DirectoryScan missing(g_root + "/nope", makeDirectory());
+    assert(missing.step() && !missing.getListing() && missing.getError() == ENOENT);
+    DirectoryScan file(g_root + "/a & b.txt", makeDirectory());
+    assert(file.step() && !file.getListing() && file.getError() == ENOTDIR);
+}
+
+void test_page_frame() {
+    std::string head;
+    DirectoryListing::renderHead(head, "/a<b>/");
+    assert(head.find("<title>Index of /a&lt;b&gt;/</title>") != std::string::npos);
+    assert(head.find("href=\"../\"") != std::string::npos);
+    head.clear();
+    DirectoryListing::renderHead(head, "/");
+    assert(head.find("href=\"../\"") == std::string::npos); // The root has no parent
+
+    std::string tail;
+    DirectoryListing::renderTail(tail, 1, 1);
+    assert(tail == "</table>\r\n</body>\r\n</html>\r\n");
+    tail.clear();
+    DirectoryListing::renderTail(tail, 2, 3);
+    assert(tail.find("Page 2 of 3 <a href=\"?page=1\">previous</a> "
+                     "<a href=\"?page=3\">next</a>") != std::string::npos);
+}
+
+void test_listing_cache() {
+    const std::shared_ptr<const CachedFile> dir = makeDirectory();
+    DirectoryScan                           scan(g_root, dir);
+    std::size_t                             steps;
+    std::shared_ptr<const DirectoryListing> listing = scanAll(scan, steps);
+    assert(listing->isBuiltFrom(dir) && !listing->isBuiltFrom(makeDirectory()));
+
+    ListingCache cache;
+    assert(!cache.find(g_root, dir));
+    assert(cache.insert(g_root, listing) && cache.size() == 1);
+    assert(cache.find(g_root, dir) == listing);
+    assert(cache.getHits() == 1 && cache.getMisses() == 1);
+
+    // A reopened directory no longer matches, and the stale entry is dropped
+    assert(!cache.find(g_root, makeDirectory()));
+    assert(cache.size() == 0 && cache.getMemoryUsage() == 0);
+
+    // Bounded in bytes: the oldest listing goes first, one too large is refused
+    ListingCache small(listing->getMemoryUsage() + g_root.size() + 1);
+    assert(small.insert(g_root, listing));
+    assert(small.insert("/other", listing) && small.size() == 1);
+    assert(!small.find(g_root, dir) && small.find("/other", dir) == listing);
+    ListingCache tiny(8);
+    assert(!tiny.insert(g_root, listing) && tiny.size() == 0);
+    small.clear();
+    assert(small.size() == 0 && small.getMemoryUsage() == 0);
+}
+
+int main() {
+    char dir[] = "/tmp/webserv_listing_XXXXXX";
+    assert(mkdtemp(dir));
+    g_root = dir;
+    mkdir((g_root + "/sub").c_str(), 0755);
+    std::ofstream((g_root + "/a & b.txt").c_str()) << "hello";
+    std::ofstream((g_root + "/.hidden").c_str());
+    std::ofstream((g_root + "/z.txt").c_str());
+
+    test_small_directory();
+    test_large_directory_in_steps();
+    test_scan_errors();
+    test_page_frame();
+    test_listing_cache();
+
+    unlink((g_root + "/a & b.txt").c_str());
+    unlink((g_root + "/.hidden").c_str());
+    unlink((g_root + "/z.txt").c_str());
+    rmdir((g_root + "/sub").c_str());
+    rmdir(g_root.c_str());
+
+    std::cout << "✅ All DirectoryListing tests passed successfully.\n";
+    return 0;
+}
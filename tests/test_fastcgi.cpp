@@ -0,0 +1,287 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_fastcgi.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:11:35 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:11:35 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "cgi/FastCgiPool.hpp"
+#include "cgi/FastCgiProtocol.hpp"
+#include "network/SocketManager.hpp"
+#include <arpa/inet.h>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+std::string g_dir; // Scratch directory holding the backend socket
+
+std::vector<FastCgiReader::Record> readAll(FastCgiReader& reader) {
+    std::vector<FastCgiReader::Record> records;
+    FastCgiReader::Record              record;
+    while (reader.next(record) == FastCgiReader::Result::RECORD)
+        records.push_back(record);
+    return records;
+}
+
+} // namespace
+
+void test_stream_records_split_and_pad() {
+    std::string out;
+    appendFastCgiStream(out, FastCgiType::STDIN, 3, std::string(70000, 'x'));
+    appendFastCgiStream(out, FastCgiType::STDIN, 3, std::string_view());
+    assert(out.size() % 8 == 0); // Every record padded to 8 bytes
+
+    FastCgiReader reader;
+    reader.feed(std::string_view(out).substr(0, 100));
+    FastCgiReader::Record record;
+    assert(reader.next(record) == FastCgiReader::Result::INCOMPLETE);
+    reader.feed(std::string_view(out).substr(100));
+    const std::vector<FastCgiReader::Record> records = readAll(reader);
+    assert(records.size() == 3);
+    assert(records[0].type == FastCgiType::STDIN && records[0].id == 3);
+    assert(records[0].content.size() == FCGI_MAX_CONTENT);
+    assert(records[1].content.size() == 70000 - FCGI_MAX_CONTENT);
+    assert(records[2].content.empty());
+
+    FastCgiReader bad;
+    bad.feed(std::string(8, '\x02'));
+    assert(bad.next(record) == FastCgiReader::Result::ERROR);
+}
+
+void test_params_round_trip() {
+    const std::string        long_value(300, 'v'); // Needs the 4-byte length form
+    std::vector<std::string> environment;
+    environment.push_back("REQUEST_METHOD=GET");
+    environment.push_back("QUERY_STRING=");
+    environment.push_back("HTTP_X_LONG=" + long_value);
+    std::string out;
+    appendFastCgiBegin(out, 1);
+    appendFastCgiParams(out, 1, environment);
+
+    FastCgiReader reader;
+    reader.feed(out);
+    const std::vector<FastCgiReader::Record> records = readAll(reader);
+    assert(records.size() == 3);
+    assert(records[0].type == FastCgiType::BEGIN_REQUEST && records[0].content.size() == 8);
+    assert(records[0].content[1] == FCGI_RESPONDER && records[0].content[2] == FCGI_KEEP_CONN);
+    assert(records[1].type == FastCgiType::PARAMS && records[2].content.empty());
+
+    std::map<std::string, std::string> params;
+    std::string_view                   content = records[1].content;
+    std::string_view                   name;
+    std::string_view                   value;
+    while (nextFastCgiPair(content, name, value))
+        params[std::string(name)] = std::string(value);
+    assert(content.empty());
+    assert(params.size() == 3);
+    assert(params["REQUEST_METHOD"] == "GET");
+    assert(params["QUERY_STRING"].empty());
+    assert(params["HTTP_X_LONG"] == long_value);
+
+    std::string_view truncated = std::string_view(records[1].content).substr(0, 5);
+    assert(!nextFastCgiPair(truncated, name, value));
+}
+
+// --- Through the event loop, against a multiplexing responder ---
+
+namespace {
+
+int              g_port = 0;
+std::atomic<int> g_accepted(0);
+
+void sendAll(int fd, const std::string& data) {
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+            return;
+        sent += static_cast<std::size_t>(n);
+    }
+}
+
+// One backend connection: answers each request once its body ends, in any order
+void serveConnection(int fd) {
+    struct Request {
+        std::string                        params;
+        std::map<std::string, std::string> env;
+        std::size_t                        body = 0;
+    };
+    std::map<std::uint16_t, Request> requests;
+    FastCgiReader                    reader;
+    char                             buf[16384];
+    ssize_t                          got;
+    while ((got = recv(fd, buf, sizeof(buf), 0)) > 0) {
+        reader.feed(std::string_view(buf, static_cast<std::size_t>(got)));
+        FastCgiReader::Record record;
+        while (reader.next(record) == FastCgiReader::Result::RECORD) {
+            std::string out;
+            Request&    request = requests[record.id];
+            if (record.type == FastCgiType::GET_VALUES) {
+                std::string pairs;
+                pairs += static_cast<char>(15);
+                pairs += static_cast<char>(1);
+                pairs += "FCGI_MPXS_CONNS1";
+                appendFastCgiStream(out, FastCgiType::GET_VALUES_RESULT, 0, pairs);
+            } else if (record.type == FastCgiType::PARAMS && !record.content.empty()) {
+                request.params.append(record.content.data(), record.content.size());
+            } else if (record.type == FastCgiType::PARAMS) {
+                std::string_view content = request.params;
+                std::string_view name;
+                std::string_view value;
+                while (nextFastCgiPair(content, name, value))
+                    request.env[std::string(name)] = std::string(value);
+            } else if (record.type == FastCgiType::STDIN && !record.content.empty()) {
+                request.body += record.content.size();
+            } else if (record.type == FastCgiType::STDIN) {
+                std::string reply = "Content-Type: text/plain\r\n\r\n" +
+                                    request.env["REQUEST_METHOD"] + " " +
+                                    request.env["SCRIPT_NAME"] + " " +
+                                    std::to_string(request.body);
+                if (request.env["QUERY_STRING"] == "big")
+                    reply += std::string(300000, 'z');
+                appendFastCgiStream(out, FastCgiType::STDERR, record.id, "logged\n");
+                appendFastCgiStream(out, FastCgiType::STDOUT, record.id, reply);
+                appendFastCgiStream(out, FastCgiType::STDOUT, record.id, std::string_view());
+                const char end[8] = {};
+                appendFastCgiStream(out, FastCgiType::END_REQUEST, record.id,
+                                    std::string_view(end, sizeof(end)));
+                requests.erase(record.id);
+            }
+            sendAll(fd, out);
+        }
+    }
+    close(fd);
+}
+
+std::string exchange(const std::string& request) {
+    const int   fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(static_cast<uint16_t>(g_port));
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    assert(connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    sendAll(fd, request);
+    std::string response;
+    char        buf[4096];
+    ssize_t     got;
+    while ((got = recv(fd, buf, sizeof(buf), 0)) > 0)
+        response.append(buf, static_cast<std::size_t>(got));
+    close(fd);
+    return response;
+}
+
+std::string bodyOf(const std::string& response) {
+    const std::size_t end = response.find("\r\n\r\n");
+    assert(end != std::string::npos);
+    return response.substr(end + 4);
+}
+
+} // namespace
+
+void test_event_loop_passes_to_backend() {
+    const std::string socket_path = g_dir + "/fpm.sock";
+    const int         listen_fd   = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un       addr{};
+    addr.sun_family = AF_UNIX;
+    socket_path.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+    assert(bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    assert(listen(listen_fd, 16) == 0);
+    std::vector<std::thread> connections;
+    std::thread              acceptor([&]() {
+        int fd;
+        while ((fd = accept(listen_fd, NULL, NULL)) >= 0) {
+            ++g_accepted;
+            connections.emplace_back(serveConnection, fd);
+        }
+    });
+
+    Server server;
+    server.setHost("127.0.0.1");
+    g_port = 20000 + static_cast<int>((getpid() + 11) % 20000);
+    server.setPort(g_port);
+    server.setClientMaxBodySize(1 << 20);
+    Location php;
+    php.setPath("/php");
+    php.setRoot(g_dir);
+    php.addMethod("GET");
+    php.addMethod("POST");
+    php.setCgiExtension(".php");
+    php.setFastcgiPass("unix:" + socket_path);
+    server.addLocation(php);
+    Location down = php;
+    down.setPath("/down");
+    down.setFastcgiPass("unix:" + g_dir + "/missing.sock");
+    server.addLocation(down);
+    Location invalid = php;
+    invalid.setPath("/invalid");
+    invalid.setFastcgiPass("backend.example:9000");
+    server.addLocation(invalid);
+    std::vector<Server> servers(1, server);
+    {
+        SocketManager manager(std::make_shared<const ConfigSnapshot>(servers));
+        std::thread   loop([&manager]() { manager.run(); });
+
+        // The script need not exist locally; the body streams as STDIN records
+        const std::string body(100000, 'b');
+        std::string response = exchange("POST /php/index.php HTTP/1.1\r\nHost: x\r\nConnection: "
+                                        "close\r\nContent-Length: " +
+                                        std::to_string(body.size()) + "\r\n\r\n" + body);
+        assert(response.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+        assert(response.find("Transfer-Encoding: chunked\r\n") != std::string::npos);
+        assert(bodyOf(response).find("POST /php/index.php 100000") != std::string::npos);
+
+        // The connection is kept for the next requests, also for large outputs
+        response = exchange("GET /php/big.php?big HTTP/1.0\r\n\r\n");
+        assert(bodyOf(response).size() == 300000 + std::string("GET /php/big.php 0").size());
+        response = exchange("GET /php/a.php HTTP/1.1\r\nHost: x\r\n\r\n"
+                            "GET /php/b.php HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+        assert(response.find("GET /php/a.php 0") != std::string::npos);
+        assert(response.find("GET /php/b.php 0") != std::string::npos);
+        assert(g_accepted == 1);
+
+        response = exchange("GET /down/x.php HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+        assert(response.compare(0, 12, "HTTP/1.1 502") == 0);
+        response =
+            exchange("GET /invalid/x.php HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+        assert(response.compare(0, 12, "HTTP/1.1 500") == 0);
+
+        manager.stop();
+        loop.join();
+    } // Closes the pooled connection, which ends its thread
+
+    shutdown(listen_fd, SHUT_RDWR); // Wakes accept()
+    acceptor.join();
+    close(listen_fd);
+    for (std::thread& connection : connections)
+        connection.join();
+}
+
+int main() {
+    char dir[] = "/tmp/webserv_fastcgi_XXXXXX";
+    assert(mkdtemp(dir));
+    g_dir = dir;
+
+    test_stream_records_split_and_pad();
+    test_params_round_trip();
+    test_event_loop_passes_to_backend();
+
+    std::system(("rm -rf " + g_dir).c_str());
+    std::cout << "✅ All FastCGI tests passed successfully.\n";
+    return 0;
+}
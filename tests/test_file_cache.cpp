@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_file_cache.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:24:10 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:24:10 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "http/FileCache.hpp"
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+static std::string makeTempDir() {
+    char dir[] = "/tmp/webserv_file_cache_XXXXXX";
+    assert(mkdtemp(dir));
+    return dir;
+}
+
+static void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+void test_open_and_hit() {
+    const std::string dir  = makeTempDir();
+    const std::string path = dir + "/a.txt";
+    writeFile(path, "hello");
+
+    FileCache               cache;
+    const FileCache::Lookup first = cache.open(path);
+    assert(first.file && first.error == 0);
+    assert(first.file->isRegular() && !first.file->isDirectory());
+    assert(first.file->getSize() == 5);
+    assert(first.file->getFd() >= 0);
+    assert(cache.getMisses() == 1 && cache.getHits() == 0);
+
+    const FileCache::Lookup second = cache.open(path);
+    assert(second.file == first.file); // Same descriptor, no new open()
+    assert(cache.getHits() == 1);
+
+    char buf[8];
+    assert(pread(second.file->getFd(), buf, sizeof(buf), 0) == 5);
+
+    const FileCache::Lookup directory = cache.open(dir);
+    assert(directory.file && directory.file->isDirectory() && directory.file->getFd() == -1);
+
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
+
+void test_negative_results_are_cached() {
+    FileCache               cache;
+    const FileCache::Lookup missing = cache.open("/nonexistent/webserv/file");
+    assert(!missing.file && missing.error == ENOENT);
+    assert(!cache.open("/nonexistent/webserv/file").file);
+    assert(cache.getHits() == 1 && cache.size() == 1);
+}
+
+void test_lru_eviction_keeps_files_in_use() {
+    const std::string dir = makeTempDir();
+    FileCache         cache(2);
+    writeFile(dir + "/1", "1");
+    writeFile(dir + "/2", "22");
+    writeFile(dir + "/3", "333");
+
+    std::shared_ptr<const CachedFile> held = cache.open(dir + "/1").file;
+    cache.open(dir + "/2");
+    cache.open(dir + "/1"); // 1 becomes most recent, 2 is evicted next
+    cache.open(dir + "/3");
+    assert(cache.size() == 2);
+
+    const std::size_t misses = cache.getMisses();
+    cache.open(dir + "/1");
+    assert(cache.getMisses() == misses); // still cached
+    cache.open(dir + "/2");
+    assert(cache.getMisses() == misses + 1); // was evicted
+
+    // An evicted entry's descriptor stays open for whoever still holds it
+    cache.clear();
+    char c = 0;
+    assert(pread(held->getFd(), &c, 1, 0) == 1 && c == '1');
+
+    for (const char* name : {"/1", "/2", "/3"})
+        unlink((dir + name).c_str());
+    rmdir(dir.c_str());
+}
+
+void test_revalidation_after_ttl() {
+    const std::string dir  = makeTempDir();
+    const std::string path = dir + "/page.html";
+    writeFile(path, "old");
+
+    FileCache                         cache(16, std::chrono::milliseconds(0));
+    std::shared_ptr<const CachedFile> before = cache.open(path).file;
+    assert(cache.open(path).file == before); // Unchanged: one stat(), same entry
+    assert(cache.getHits() == 1);
+
+    // Replacing the file (new inode, new size) forces a reopen
+    const std::string tmp = path + ".tmp";
+    writeFile(tmp, "newer");
+    rename(tmp.c_str(), path.c_str());
+    std::shared_ptr<const CachedFile> after = cache.open(path).file;
+    assert(after && after != before && after->getSize() == 5);
+
+    unlink(path.c_str());
+    assert(!cache.open(path).file); // Deletion is noticed too
+    rmdir(dir.c_str());
+}
+
+void test_disabled_cache() {
+    FileCache cache(0);
+    assert(!cache.open("/nonexistent").file);
+    assert(cache.size() == 0 && cache.getMisses() == 1);
+}
+
+int main() {
+    test_open_and_hit();
+    test_negative_results_are_cached();
+    test_lru_eviction_keeps_files_in_use();
+    test_revalidation_after_ttl();
+    test_disabled_cache();
+
+    std::cout << "✅ All FileCache tests passed successfully.\n";
+    return 0;
+}
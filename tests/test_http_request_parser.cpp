@@ -0,0 +1,131 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_http_request_parser.cpp                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:08:37 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:42:03 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "http/HttpRequest.hpp"
+#include "http/HttpRequestParser.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+typedef HttpRequestParser::Result Result;
+
+static const std::string SAMPLE = "GET /search?q=web&lang=en HTTP/1.1\r\n"
+                                  "Host: example.com:8080\r\n"
+                                  "User-Agent: test\r\n"
+                                  "Accept:  */*  \r\n"
+                                  "\r\n";
+
+void test_complete_request() {
+    HttpRequestParser parser;
+    HttpRequest       req;
+
+    assert(parser.parse(SAMPLE, req) == Result::COMPLETE);
+    assert(parser.consumed() == SAMPLE.size());
+    assert(req.getMethod() == HttpMethod::GET);
+    assert(req.getMethodName() == "GET");
+    assert(req.getTarget() == "/search?q=web&lang=en");
+    assert(req.getPath() == "/search");
+    assert(req.getQuery() == "q=web&lang=en");
+    assert(req.getVersionMajor() == 1 && req.getVersionMinor() == 1);
+    assert(req.getHost() == "example.com");
+    assert(req.isKeepAlive());
+    assert(req.getHeaderCount() == 3);
+    assert(req.getHeader("user-agent") == "test");
+    assert(req.getHeader("Accept") == "*/*"); // surrounding whitespace removed
+    assert(req.getHeader("Missing").empty());
+
+    // Header views point into the caller's buffer, nothing is copied
+    assert(req.getHeader("User-Agent").data() >= SAMPLE.data());
+    assert(req.getHeader("User-Agent").data() < SAMPLE.data() + SAMPLE.size());
+}
+
+void test_byte_by_byte_resume() {
+    HttpRequestParser parser;
+    HttpRequest       req;
+
+    for (std::size_t n = 1; n < SAMPLE.size(); ++n) {
+        // A growing copy models a buffer that moves between reads
+        std::string partial = SAMPLE.substr(0, n);
+        assert(parser.parse(partial, req) == Result::INCOMPLETE);
+    }
+    std::string full = SAMPLE + "NEXT";
+    assert(parser.parse(full, req) == Result::COMPLETE);
+    assert(parser.consumed() == SAMPLE.size());
+    assert(req.getPath() == "/search");
+    assert(req.getHeader("Accept") == "*/*");
+}
+
+void test_body_framing() {
+    HttpRequestParser parser;
+    HttpRequest       req;
+    std::string       raw = "POST /upload HTTP/1.0\r\nContent-Length: 12\r\n\r\nhello";
+
+    assert(parser.parse(raw, req) == Result::COMPLETE);
+    assert(req.getMethod() == HttpMethod::POST);
+    assert(req.hasContentLength() && req.getContentLength() == 12);
+    assert(!req.isKeepAlive()); // HTTP/1.0 without keep-alive
+    assert(raw.substr(parser.consumed()) == "hello");
+
+    parser.reset();
+    req.reset();
+    raw = "POST / HTTP/1.1\r\nHost: a\r\nTransfer-Encoding:  Chunked \r\n\r\n";
+    assert(parser.parse(raw, req) == Result::COMPLETE);
+    assert(req.isChunked());
+}
+
+static int errorOf(const std::string& raw, std::size_t max_head = 8192) {
+    HttpRequestParser parser(max_head);
+    HttpRequest       req;
+    if (parser.parse(raw, req) != Result::ERROR)
+        return 0;
+    return parser.getErrorStatus();
+}
+
+void test_errors() {
+    assert(errorOf("GET  / HTTP/1.1\r\n\r\n") == 400);                     // empty target
+    assert(errorOf("G(T / HTTP/1.1\r\n\r\n") == 400);                      // bad method
+    assert(errorOf("GET / HTTQ/1.1\r\n\r\n") == 400);                      // bad version
+    assert(errorOf("GET / HTTP/2.0\r\nHost: a\r\n\r\n") == 505);           // unsupported
+    assert(errorOf("GET / HTTP/1.1\r\n\r\n") == 400);                      // missing Host
+    assert(errorOf("GET / HTTP/1.1\r\nHost: a\r\nBad Name: x\r\n\r\n") == 400);
+    assert(errorOf("GET / HTTP/1.1\r\nHost: a\r\n folded\r\n\r\n") == 400);
+    assert(errorOf("GET / HTTP/1.1\r\nHost: a\r\nHost: b\r\n\r\n") == 400);
+    assert(errorOf("POST / HTTP/1.1\r\nHost: a\r\nContent-Length: 1\r\n"
+                   "Transfer-Encoding: chunked\r\n\r\n") == 400);
+    assert(errorOf("POST / HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: gzip\r\n\r\n") == 501);
+    // Only a lone chunked is decoded; HTTP/1.0 has no transfer codings at all
+    assert(errorOf("POST / HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: gzip, chunked\r\n\r\n") ==
+           501);
+    assert(errorOf("POST / HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n"
+                   "Transfer-Encoding: chunked\r\n\r\n") == 501);
+    assert(errorOf("POST / HTTP/1.0\r\nTransfer-Encoding: chunked\r\n\r\n") == 400);
+    assert(errorOf("GET /" + std::string(100, 'a') + " HTTP/1.1\r\n", 64) == 431);
+}
+
+void test_leading_empty_lines_and_bare_lf() {
+    HttpRequestParser parser;
+    HttpRequest       req;
+    assert(parser.parse("\r\nGET / HTTP/1.1\nHost: a\n\n", req) == Result::COMPLETE);
+    assert(req.getMethod() == HttpMethod::GET);
+    assert(req.getHost() == "a");
+}
+
+int main() {
+    test_complete_request();
+    test_byte_by_byte_resume();
+    test_body_framing();
+    test_errors();
+    test_leading_empty_lines_and_bare_lf();
+
+    std::cout << "✅ All HttpRequestParser tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,576 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_http_response_builder.cpp                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:24:10 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 06:14:05 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "http/HeaderFields.hpp"
+#include "http/HttpRequestParser.hpp"
+#include "http/HttpResponseBuilder.hpp"
+#include "utils/Arena.hpp"
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static std::string g_root;
+
+static void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+static Server makeServer() {
+    Server server;
+
+    Location root;
+    root.setPath("/");
+    root.setRoot(g_root);
+    root.setIndex("index.html");
+    root.addMethod("GET");
+    server.addLocation(root);
+
+    Location old;
+    old.setPath("/old");
+    old.setRedirect("/new", 301);
+    server.addLocation(old);
+
+    Location upload;
+    upload.setPath("/upload");
+    upload.setRoot(g_root);
+    upload.addMethod("POST");
+    server.addLocation(upload);
+
+    server.setErrorPage(404, "/errors/404.html");
+    return server;
+}
+
+// Parses a raw request into a bound HttpRequest; the text must outlive the request
+static HttpRequest parse(const std::string& raw) {
+    HttpRequestParser parser;
+    HttpRequest       request;
+    assert(parser.parse(raw, request) == HttpRequestParser::Result::COMPLETE);
+    request.bind(raw.data());
+    return request;
+}
+
+static HttpResponse get(HttpResponseBuilder& builder, const Server& server,
+                        const std::string& target, const std::string& method = "GET") {
+    const std::string raw = method + " " + target + " HTTP/1.1\r\nHost: a\r\n\r\n";
+    return builder.build(parse(raw), server);
+}
+
+// Lists a directory the way the event loop does: resolve, scan, then build the page
+static HttpResponse listDirectory(HttpResponseBuilder& builder, FileCache& files,
+                                  const Server& server, const std::string& target,
+                                  const std::string& method = "GET",
+                                  const std::string& accept = "") {
+    const std::string raw =
+        method + " " + target + " HTTP/1.1\r\nHost: a\r\n" +
+        (accept.empty() ? std::string() : "Accept-Encoding: " + accept + "\r\n") + "\r\n";
+    const HttpRequest request = parse(raw);
+    RequestRoute      route;
+    std::pmr::string  directory;
+    HttpResponseBuilder::route(request, server, route);
+    const Location* location = builder.resolveAutoindex(request, route, directory);
+    assert(location);
+    DirectoryScan scan(std::string(directory), files.open(directory).file);
+    while (!scan.step()) {
+    }
+    assert(scan.getListing());
+    return builder.buildListing(request, *location, route.path, scan.getListing(), server);
+}
+
+static RequestRoute routeOf(const std::string& raw, const Server& server) {
+    RequestRoute route;
+    HttpResponseBuilder::route(parse(raw), server, route);
+    return route;
+}
+
+static HttpResponse getEncoded(HttpResponseBuilder& builder, const Server& server,
+                               const std::string& target, const std::string& accept) {
+    const std::string raw =
+        "GET " + target + " HTTP/1.1\r\nHost: a\r\nAccept-Encoding: " + accept + "\r\n\r\n";
+    return builder.build(parse(raw), server);
+}
+
+static bool hasField(const HttpResponse& response, const std::string& field) {
+    return response.serializeHead().find("\r\n" + field + "\r\n") != std::string::npos;
+}
+
+void test_response_serialization() {
+    HttpResponse response(404);
+    response.setHeader("Content-Type", "text/plain");
+    response.setHeader("content-type", "text/html"); // replaces, case-insensitive
+    response.setBody("gone");
+    assert(*response.getHeader("Content-Type") == "text/html");
+    assert(response.serializeHead() == "HTTP/1.1 404 Not Found\r\n"
+                                       "Content-Type: text/html\r\n"
+                                       "Content-Length: 4\r\n\r\n");
+
+    response.removeHeader("CONTENT-TYPE");
+    response.setStatus(304);
+    assert(response.serializeHead() == "HTTP/1.1 304 Not Modified\r\n\r\n");
+    assert(HttpResponse::reasonPhrase(799) == "Unknown");
+}
+
+void test_response_segments() {
+    HttpResponse response(200);
+    response.setHeader("Content-Type", "text/plain");
+    response.addField("Connection: close\r\n");
+    response.setBody("hello");
+    assert(response.serializeHead() == "HTTP/1.1 200 OK\r\nConnection: close\r\n"
+                                       "Content-Type: text/plain\r\nContent-Length: 5\r\n\r\n");
+
+    // Static status line and field, one formatted block, the body moved last
+    HttpResponse::Segments segments = response.takeSegments(false);
+    assert(segments.size() == 4);
+    assert(segments[0].bytes == "HTTP/1.1 200 OK\r\n" && !segments[0].owner);
+    assert(segments[0].bytes.data() == HttpResponse(200).takeSegments(true)[0].bytes.data());
+    assert(segments[1].bytes == "Connection: close\r\n");
+    assert(segments[2].text == "Content-Type: text/plain\r\nContent-Length: 5\r\n\r\n");
+    assert(segments[3].text == "hello" && response.getBody().empty());
+
+    // Unregistered statuses format their line; HEAD drops the body
+    HttpResponse odd(299);
+    odd.setBody("x");
+    HttpResponse::Segments head = odd.takeSegments(true);
+    assert(head.size() == 2 && head[0].text == "HTTP/1.1 299 Unknown\r\n");
+    assert(head[1].text == "Content-Length: 1\r\n\r\n");
+}
+
+void test_static_files() {
+    FileCache           files;
+    HttpResponseBuilder builder(files);
+    const Server        server = makeServer();
+
+    HttpResponse index = get(builder, server, "/");
+    assert(index.getStatus() == 200);
+    assert(index.hasFile() && index.getContentLength() == 11);
+    assert(index.getField("Content-Type") == "text/html");
+
+    HttpResponse style = get(builder, server, "/css/site%2Ecss?v=2");
+    assert(style.getStatus() == 200);
+    assert(style.getField("Content-Type") == "text/css");
+    assert(style.getFileOffset() == 0 && style.getContentLength() == 8);
+
+    HttpResponse head = get(builder, server, "/css/./site.css", "HEAD");
+    assert(head.getStatus() == 200 && head.getContentLength() == 8);
+
+    HttpResponse dir = get(builder, server, "/css?x=1");
+    assert(dir.getStatus() == 301 && *dir.getHeader("Location") == "/css/?x=1");
+    assert(get(builder, server, "/css/").getStatus() == 403); // no index, no listing
+    assert(files.getHits() > 0);
+}
+
+void test_errors_and_routing() {
+    FileCache           files;
+    HttpResponseBuilder builder(files);
+    const Server        server = makeServer();
+
+    HttpResponse missing = get(builder, server, "/nope.html");
+    assert(missing.getStatus() == 404);
+    assert(missing.hasFile()); // configured error page
+    assert(missing.getContentLength() == 9);
+
+    HttpResponse escape = get(builder, server, "/../etc/passwd");
+    assert(escape.getStatus() == 400);
+    assert(get(builder, server, "/a%2fb").getStatus() == 400);
+
+    HttpResponse moved = get(builder, server, "/old/page");
+    assert(moved.getStatus() == 301 && *moved.getHeader("Location") == "/new");
+
+    HttpResponse denied = get(builder, server, "/index.html", "DELETE");
+    assert(denied.getStatus() == 405);
+    assert(*denied.getHeader("Allow") == "GET, HEAD");
+    assert(get(builder, server, "/upload", "POST").getStatus() == 501);
+
+    HttpResponse generic = builder.buildError(500, server);
+    assert(!generic.hasFile());
+    assert(generic.getBody().find("500 Internal Server Error") != std::string::npos);
+}
+
+void test_asset_cache() {
+    FileCache           files(16, std::chrono::milliseconds(0)); // Revalidate every lookup
+    AssetCache          assets;
+    HttpResponseBuilder builder(files, &assets);
+    const Server        server = makeServer();
+
+    HttpResponse first = get(builder, server, "/");
+    assert(first.getStatus() == 200 && first.getCached() && !first.hasFile());
+    assert(first.getContentLength() == 11);
+    const std::string_view head = first.getCached()->getHead();
+    assert(head.find("HTTP/1.1 200 OK\r\nContent-Type: text/html\r\n") == 0);
+    assert(head.find("ETag: \"") != std::string_view::npos);
+    assert(head.find("Last-Modified: ") != std::string_view::npos);
+    assert(head.find("Content-Length: 11\r\n") != std::string_view::npos);
+    assert(first.getCached()->getBody() == "<h1>hi</h1>");
+    assert(first.serializeHead() == std::string(head) + "\r\n"); // Nothing repeated
+    assert(get(builder, server, "/").getCached() == first.getCached());
+    assert(assets.getHits() == 1);
+
+    // Error pages are cached under their own status, without validators
+    HttpResponse missing = get(builder, server, "/nope.html");
+    assert(missing.getStatus() == 404 && missing.getCached());
+    assert(missing.getCached()->getBody() == "not found");
+    assert(missing.getCached()->getHead().find("ETag") == std::string_view::npos);
+
+    // Built-in pages are generated once; extra fields follow the cached ones
+    HttpResponse generic = builder.buildError(500, server);
+    assert(generic.getCached());
+    assert(builder.buildError(500, server).getCached() == generic.getCached());
+    HttpResponse denied = get(builder, server, "/index.html", "DELETE");
+    assert(denied.getStatus() == 405 && denied.getCached());
+    assert(denied.serializeHead().find("\r\nAllow: GET, HEAD\r\n\r\n") != std::string::npos);
+
+    // Cached head and body are borrowed from the entry, not copied
+    HttpResponse::Segments segments = first.takeSegments(false);
+    assert(segments.size() == 3);
+    assert(segments[0].bytes.data() == head.data() && segments[0].owner);
+    assert(segments[1].text == "\r\n");
+    assert(segments[2].bytes.data() == first.getCached()->getBody().data());
+
+    // A modified file is reloaded by the FileCache, which invalidates the entry
+    writeFile(g_root + "/index.html", "<h1>changed</h1>");
+    HttpResponse changed = get(builder, server, "/");
+    assert(changed.getCached() && changed.getCached() != first.getCached());
+    assert(changed.getCached()->getBody() == "<h1>changed</h1>");
+    assert(changed.getContentLength() == 16);
+
+    // Files above the per-asset limit are still sent with sendfile()
+    AssetCache          tiny(1024, 4);
+    HttpResponseBuilder limited(files, &tiny);
+    assert(get(limited, server, "/").hasFile());
+    assert(tiny.size() == 0);
+}
+
+void test_arena_backed_responses() {
+    FileCache           files;
+    HttpResponseBuilder builder(files);
+    const Server        server = makeServer();
+    Arena               arena;
+
+    const std::string raw = "GET /css/site.css HTTP/1.1\r\nHost: a\r\n\r\n";
+    {
+        HttpResponse style = builder.build(parse(raw), server, &arena);
+        assert(style.getStatus() == 200 && style.getField("Content-Type") == "text/css");
+        assert(style.getHeader("Last-Modified")->get_allocator().resource() == &arena);
+    }
+    assert(arena.getUsed() > 0);
+
+    // Rewinding between requests reuses the same block
+    const std::size_t reserved = arena.getReserved();
+    for (int i = 0; i < 100; ++i) {
+        arena.reset();
+        HttpResponse again = builder.build(parse(raw), server, &arena);
+        assert(again.getStatus() == 200);
+    }
+    assert(arena.getReserved() == reserved);
+}
+
+void test_mime_types() {
+    assert(HttpResponseBuilder::mimeType("/a/b.PNG") == "image/png");
+    assert(HttpResponseBuilder::mimeType("/a.b/c") == "application/octet-stream");
+    assert(HttpResponseBuilder::mimeType("/archive.tar.gz") == "application/gzip");
+
+    // The same static line for every lookup, never formatted per response
+    assert(contentTypeField("/x.css") == "Content-Type: text/css\r\n");
+    assert(contentTypeField("/a.css").data() == contentTypeField("/b.CSS").data());
+    assert(fieldValue(FIELD_SERVER) == "webserv");
+
+    HttpResponse response(200);
+    response.addField(contentTypeField("/x.css"));
+    assert(response.getField("content-type") == "text/css" && !response.getHeader("Content-Type"));
+    assert(response.getField("Content").empty());
+}
+
+void test_compression() {
+    FileCache           files(16, std::chrono::milliseconds(0));
+    AssetCache          assets;
+    CompressionBudget   budget(100);
+    HttpResponseBuilder builder(files, &assets, &budget);
+
+    Server   server;
+    Location root;
+    root.setPath("/");
+    root.setRoot(g_root);
+    root.setCompression(codingBit(ContentCoding::GZIP));
+    root.setCompressStatic(true);
+    root.setCompressMinLength(64);
+    server.addLocation(std::move(root));
+    writeFile(g_root + "/app.js", "var a = 1;");
+    writeFile(g_root + "/app.js.br", "BR");
+    writeFile(g_root + "/page.txt", std::string(2000, 'a'));
+
+    // A precompressed sibling is served with the type of the original
+    HttpResponse sibling = getEncoded(builder, server, "/app.js", "gzip, br");
+    assert(sibling.getStatus() == 200 && sibling.getContentLength() == 2);
+    assert(hasField(sibling, "Content-Type: text/javascript"));
+    assert(hasField(sibling, "Content-Encoding: br"));
+    assert(hasField(sibling, "Vary: Accept-Encoding"));
+
+    // Too short to compress, and no sibling for gzip: identity, still varying
+    HttpResponse plain = getEncoded(builder, server, "/app.js", "gzip");
+    assert(plain.getContentLength() == 10);
+    assert(plain.serializeHead().find("Content-Encoding") == std::string::npos);
+    assert(hasField(plain, "Vary: Accept-Encoding"));
+    assert(hasField(get(builder, server, "/page.txt"), "Vary: Accept-Encoding"));
+
+#ifdef WEBSERV_HAVE_ZLIB
+    // Compressed once, then answered from the asset cache next to the identity entry
+    HttpResponse packed = getEncoded(builder, server, "/page.txt", "br;q=0, gzip");
+    assert(packed.getCached() && packed.getContentLength() < 100);
+    assert(hasField(packed, "Content-Encoding: gzip"));
+    assert(packed.getCached()->getHead().find("-gzip\"\r\n") != std::string_view::npos);
+    assert(getEncoded(builder, server, "/page.txt", "gzip").getCached() == packed.getCached());
+    HttpResponse identity = get(builder, server, "/page.txt");
+    assert(identity.getCached() != packed.getCached() && identity.getContentLength() == 2000);
+
+    // Without budget the file goes out as it is
+    AssetCache          other;
+    CompressionBudget   none(0);
+    HttpResponseBuilder stingy(files, &other, &none);
+    HttpResponse        refused = getEncoded(stingy, server, "/page.txt", "gzip");
+    assert(refused.getContentLength() == 2000 && none.getRefused() == 1);
+#endif
+    unlink((g_root + "/app.js").c_str());
+    unlink((g_root + "/app.js.br").c_str());
+    unlink((g_root + "/page.txt").c_str());
+}
+
+static HttpResponse getWith(HttpResponseBuilder& builder, const Server& server,
+                            const std::string& target, const std::string& fields) {
+    const std::string raw = "GET " + target + " HTTP/1.1\r\nHost: a\r\n" + fields + "\r\n";
+    return builder.build(parse(raw), server);
+}
+
+void test_conditional_get() {
+    FileCache           files;
+    AssetCache          assets;
+    HttpResponseBuilder builder(files, &assets);
+    const Server        server = makeServer();
+
+    // Validators come from the stat cache, also through a cached response
+    HttpResponse full = get(builder, server, "/index.html");
+    assert(full.getCached());
+    const std::string etag(full.getField("ETag"));
+    const std::string modified(full.getField("Last-Modified"));
+    assert(etag == files.open(g_root + "/index.html").file->getETag());
+    assert(hasField(full, "Accept-Ranges: bytes"));
+
+    HttpResponse same =
+        getWith(builder, server, "/index.html", "If-None-Match: \"x\", W/" + etag + "\r\n");
+    assert(same.getStatus() == 304 && same.getContentLength() == 0);
+    assert(same.getField("ETag") == etag && same.getField("Last-Modified") == modified);
+    assert(same.serializeHead().find("Content-Length") == std::string::npos);
+    assert(getWith(builder, server, "/index.html", "If-None-Match: *\r\n").getStatus() == 304);
+
+    // If-None-Match decides alone when present; dates compare as times
+    assert(getWith(builder, server, "/index.html",
+                   "If-None-Match: \"x\"\r\nIf-Modified-Since: " + modified + "\r\n")
+               .getStatus() == 200);
+    assert(getWith(builder, server, "/index.html", "If-Modified-Since: " + modified + "\r\n")
+               .getStatus() == 304);
+    assert(getWith(builder, server, "/index.html",
+                   "If-Modified-Since: Thu, 01 Jan 1970 00:00:00 GMT\r\n")
+               .getStatus() == 200);
+    assert(getWith(builder, server, "/index.html", "If-Modified-Since: yesterday\r\n")
+               .getStatus() == 200);
+    assert(getWith(builder, server, "/nope.html", "If-None-Match: *\r\n").getStatus() == 404);
+}
+
+void test_range_requests() {
+    std::pmr::vector<HttpResponseBuilder::ByteRange> ranges;
+    assert(HttpResponseBuilder::parseRange("bytes=0-0, -2,4-", 10, ranges) == 206);
+    assert(ranges.size() == 3 && ranges[0].first == 0 && ranges[0].length == 1);
+    assert(ranges[1].first == 8 && ranges[1].length == 2);
+    assert(ranges[2].first == 4 && ranges[2].length == 6);
+    assert(HttpResponseBuilder::parseRange("bytes=2-99", 10, ranges) == 206);
+    assert(ranges.size() == 1 && ranges[0].length == 8);
+    assert(HttpResponseBuilder::parseRange("bytes=-20", 10, ranges) == 206 &&
+           ranges[0].first == 0);
+    assert(HttpResponseBuilder::parseRange("bytes=10-, -0", 10, ranges) == 416);
+    assert(HttpResponseBuilder::parseRange("bytes=5-2", 10, ranges) == 200);
+    assert(HttpResponseBuilder::parseRange("items=0-1", 10, ranges) == 200);
+    assert(HttpResponseBuilder::parseRange("bytes=0-9,0-9", 10, ranges) == 200);
+    assert(HttpResponseBuilder::parseRange("bytes= , ", 10, ranges) == 200);
+
+    FileCache           files;
+    AssetCache          assets;
+    HttpResponseBuilder builder(files, &assets);
+    const Server        server = makeServer();
+    writeFile(g_root + "/movie.bin", "0123456789");
+
+    // One range: a file segment at its offset
+    HttpResponse part = getWith(builder, server, "/movie.bin", "Range: bytes=2-5\r\n");
+    assert(part.getStatus() == 206 && part.hasFile());
+    assert(part.getFileOffset() == 2 && part.getContentLength() == 4);
+    assert(part.getField("Content-Range") == "bytes 2-5/10");
+    assert(hasField(part, "Content-Type: application/octet-stream"));
+
+    // Several: each part head, then its file range, then the closing boundary
+    HttpResponse multi = getWith(builder, server, "/movie.bin", "Range: bytes=0-1,-3\r\n");
+    assert(multi.getStatus() == 206);
+    const std::string type(multi.getField("Content-Type"));
+    assert(type.compare(0, 31, "multipart/byteranges; boundary=") == 0);
+    const std::string      boundary = type.substr(31);
+    const std::size_t      length   = multi.getContentLength();
+    HttpResponse::Segments segments = multi.takeSegments(false);
+    std::string            body;
+    std::size_t            file_bytes = 0;
+    for (const HttpResponse::Segment& segment : segments) {
+        if (segment.file) {
+            file_bytes += segment.length;
+            body += std::string("0123456789").substr(static_cast<std::size_t>(segment.offset),
+                                                     segment.length);
+        } else if (!segment.text.empty() && segment.text.compare(0, 4, "HTTP") != 0 &&
+                   segment.text.find("Content-Length") == std::string::npos) {
+            body += segment.text;
+        }
+    }
+    assert(file_bytes == 5 && body.size() == length);
+    assert(body == "\r\n--" + boundary +
+                       "\r\nContent-Type: application/octet-stream\r\n"
+                       "Content-Range: bytes 0-1/10\r\n\r\n01\r\n--" +
+                       boundary +
+                       "\r\nContent-Type: application/octet-stream\r\n"
+                       "Content-Range: bytes 7-9/10\r\n\r\n789\r\n--" + boundary + "--\r\n");
+
+    // Unsatisfiable, stale If-Range, and HEAD
+    HttpResponse beyond = getWith(builder, server, "/movie.bin", "Range: bytes=10-\r\n");
+    assert(beyond.getStatus() == 416 && beyond.getField("Content-Range") == "bytes */10");
+    assert(getWith(builder, server, "/movie.bin", "Range: bytes=0-1\r\nIf-Range: \"old\"\r\n")
+               .getStatus() == 200);
+    const std::string etag(files.open(g_root + "/movie.bin").file->getETag());
+    assert(getWith(builder, server, "/movie.bin",
+                   "Range: bytes=0-1\r\nIf-Range: " + etag + "\r\n")
+               .getStatus() == 206);
+    assert(builder.build(parse("HEAD /movie.bin HTTP/1.1\r\nHost: a\r\nRange: bytes=0-1\r\n\r\n"),
+                         server)
+               .getStatus() == 200);
+    unlink((g_root + "/movie.bin").c_str());
+}
+
+void test_autoindex() {
+    FileCache           files;
+    HttpResponseBuilder builder(files);
+    Server              server = makeServer();
+    Location            list;
+    list.setPath("/list");
+    list.setRoot(g_root);
+    list.addMethod("GET");
+    list.setAutoindex(true);
+    list.setAutoindexPageSize(2);
+    server.addLocation(list);
+
+    // Only slash-terminated directories without an index are resolved for the loop
+    const std::string raw = "GET /list/ HTTP/1.1\r\nHost: a\r\n\r\n";
+    const HttpRequest  request = parse(raw);
+    const RequestRoute route   = routeOf(raw, server);
+    std::pmr::string   directory;
+    assert(route.location && route.location->getPath() == "/list" && route.path == "/list/");
+    assert(builder.resolveAutoindex(request, route, directory));
+    assert(std::string_view(directory) == g_root + "/");
+    const std::string bare = "GET /list HTTP/1.1\r\nHost: a\r\n\r\n";
+    assert(!builder.resolveAutoindex(parse(bare), routeOf(bare, server), directory));
+    const std::string root = "GET / HTTP/1.1\r\nHost: a\r\n\r\n";
+    assert(!builder.resolveAutoindex(parse(root), routeOf(root, server), directory));
+
+    // Directories first; the rows are borrowed from the listing, not copied
+    HttpResponse first = listDirectory(builder, files, server, "/list/");
+    assert(first.getStatus() == 200 && hasField(first, "Content-Type: text/html"));
+    const std::size_t      length   = first.getContentLength();
+    HttpResponse::Segments segments = first.takeSegments(false);
+    std::string            body;
+    bool                   borrowed = false;
+    for (std::size_t i = 1; i < segments.size(); ++i) {
+        if (segments[i].owner) {
+            borrowed = true;
+            body += std::string(segments[i].bytes);
+        } else if (segments[i].text.compare(0, 6, "<html>") == 0 ||
+                   segments[i].text.compare(0, 8, "</table>") == 0) {
+            body += segments[i].text;
+        }
+    }
+    assert(borrowed && body.size() == length);
+    assert(body.find("<a href=\"css/\">css/</a>") < body.find("errors/"));
+    assert(body.find("index.html") == std::string::npos);
+    assert(body.find("<a href=\"../\">") != std::string::npos);
+    assert(body.find("Page 1 of 2 <a href=\"?page=2\">next</a>") != std::string::npos);
+
+    HttpResponse last = listDirectory(builder, files, server, "/list/?page=2");
+    assert(last.getStatus() == 200);
+    assert(listDirectory(builder, files, server, "/list/?page=3").getStatus() == 404);
+    // Malformed: page 1
+    assert(listDirectory(builder, files, server, "/list/?page=x").getStatus() == 200);
+    assert(listDirectory(builder, files, server, "/list/", "HEAD").getStatus() == 200);
+    assert(!hasField(first, "Vary: Accept-Encoding"));
+
+    // Compressing locations vary, and compress the pages long enough within the budget
+    CompressionBudget   budget(100);
+    HttpResponseBuilder packing(files, NULL, &budget);
+    Location            packed(list);
+    packed.setPath("/packed");
+    packed.setAutoindexPageSize(0);
+    packed.setCompression(codingBit(ContentCoding::GZIP));
+    packed.setCompressMinLength(64);
+    server.addLocation(packed);
+    HttpResponse identity = listDirectory(packing, files, server, "/packed/");
+    assert(hasField(identity, "Vary: Accept-Encoding"));
+    assert(identity.serializeHead().find("Content-Encoding") == std::string::npos);
+#ifdef WEBSERV_HAVE_ZLIB
+    HttpResponse zipped = listDirectory(packing, files, server, "/packed/", "GET", "gzip");
+    assert(zipped.getStatus() == 200 && hasField(zipped, "Content-Encoding: gzip"));
+    assert(hasField(zipped, "Vary: Accept-Encoding"));
+    assert(zipped.getContentLength() < identity.getContentLength());
+
+    CompressionBudget   none(0);
+    HttpResponseBuilder stingy(files, NULL, &none);
+    HttpResponse        refused = listDirectory(stingy, files, server, "/packed/", "GET", "gzip");
+    assert(refused.getContentLength() == identity.getContentLength() && none.getRefused() == 1);
+#endif
+
+    // build() never lists: the request should have gone to the event loop
+    assert(get(builder, server, "/list/").getStatus() == 500);
+}
+
+int main() {
+    char dir[] = "/tmp/webserv_builder_XXXXXX";
+    assert(mkdtemp(dir));
+    g_root = dir;
+    mkdir((g_root + "/css").c_str(), 0755);
+    mkdir((g_root + "/errors").c_str(), 0755);
+    writeFile(g_root + "/index.html", "<h1>hi</h1>");
+    writeFile(g_root + "/css/site.css", "body{} \n");
+    writeFile(g_root + "/errors/404.html", "not found");
+
+    test_response_serialization();
+    test_response_segments();
+    test_static_files();
+    test_errors_and_routing();
+    test_arena_backed_responses();
+    test_mime_types();
+    test_asset_cache();
+    test_compression();
+    test_conditional_get();
+    test_range_requests();
+    test_autoindex();
+
+    unlink((g_root + "/index.html").c_str());
+    unlink((g_root + "/css/site.css").c_str());
+    unlink((g_root + "/errors/404.html").c_str());
+    rmdir((g_root + "/css").c_str());
+    rmdir((g_root + "/errors").c_str());
+    rmdir(g_root.c_str());
+
+    std::cout << "✅ All HttpResponseBuilder tests passed successfully.\n";
+    return 0;
+}
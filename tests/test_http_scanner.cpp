@@ -0,0 +1,116 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_http_scanner.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:11:48 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:11:48 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "http/HttpScanner.hpp"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static const ScanKernel ALL_KERNELS[] = {ScanKernel::SCALAR, ScanKernel::SSE42, ScanKernel::AVX2,
+                                         ScanKernel::NEON};
+
+static std::vector<const HttpScanKernels*> supportedKernels() {
+    std::vector<const HttpScanKernels*> kernels;
+    for (ScanKernel kind : ALL_KERNELS) {
+        if (const HttpScanKernels* k = findScanKernels(kind))
+            kernels.push_back(k);
+    }
+    return kernels;
+}
+
+// Every kernel must stop exactly where the scalar reference stops
+static void expectAgreement(const std::string& data) {
+    const HttpScanKernels* ref = findScanKernels(ScanKernel::SCALAR);
+    const char*            p   = data.data();
+    for (const HttpScanKernels* k : supportedKernels()) {
+        for (std::size_t start = 0; start <= data.size() && start < 40; ++start) {
+            assert(k->token(p, start, data.size()) == ref->token(p, start, data.size()));
+            assert(k->target(p, start, data.size()) == ref->target(p, start, data.size()));
+            assert(k->value(p, start, data.size()) == ref->value(p, start, data.size()));
+        }
+    }
+}
+
+void test_scalar_reference() {
+    const HttpScanKernels* k = findScanKernels(ScanKernel::SCALAR);
+    assert(k && isScanKernelSupported(ScanKernel::SCALAR));
+
+    const std::string line = "Content-Type: text/html; q=1\tx\r\n";
+    assert(k->token(line.data(), 0, line.size()) == 12);  // stops at ':'
+    assert(k->target(line.data(), 0, line.size()) == 13); // stops at ' '
+    assert(k->value(line.data(), 14, line.size()) == 30); // tab allowed, stops at '\r'
+    assert(k->token(line.data(), 3, 3) == 3);             // empty range
+}
+
+void test_every_stop_position() {
+    // A single delimiter at each offset across several vector widths
+    const char stops[] = {'\r', '\n', ':', ' ', '\t', '\0', '\x7f', '\x80', '\xff', '"', '/'};
+    for (char stop : stops) {
+        for (std::size_t len = 0; len <= 80; ++len) {
+            for (std::size_t at = 0; at < len; ++at) {
+                std::string data(len, 'a');
+                data[at] = stop;
+                expectAgreement(data);
+            }
+        }
+    }
+}
+
+void test_random_bytes() {
+    std::srand(42);
+    for (int round = 0; round < 2000; ++round) {
+        std::string data(static_cast<std::size_t>(std::rand() % 100), 'x');
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            // Mostly printable, sometimes any byte, so runs of varying length appear
+            const int r = std::rand();
+            data[i]     = static_cast<char>(r % 8 ? 0x21 + (r >> 3) % 0x5e : (r >> 3) & 0xff);
+        }
+        expectAgreement(data);
+    }
+}
+
+void test_all_byte_values() {
+    std::string data;
+    for (int c = 0; c < 256; ++c)
+        data += std::string(33, 'a') + static_cast<char>(c);
+    expectAgreement(data);
+}
+
+void test_selection() {
+    const ScanKernel original = activeScanKernels().kind;
+    for (const HttpScanKernels* k : supportedKernels()) {
+        assert(selectScanKernel(k->kind));
+        assert(activeScanKernels().kind == k->kind);
+        const std::string host = "Host: example.com\r\n";
+        assert(scanToken(host.data(), 0, host.size()) == 4);
+        assert(scanValue(host.data(), 6, host.size()) == 17);
+    }
+    for (ScanKernel kind : ALL_KERNELS) {
+        if (!isScanKernelSupported(kind))
+            assert(!selectScanKernel(kind));
+    }
+    assert(selectScanKernel(original));
+}
+
+int main() {
+    test_scalar_reference();
+    test_every_stop_position();
+    test_random_bytes();
+    test_all_byte_values();
+    test_selection();
+
+    std::cout << "✅ All HttpScanner tests passed (active kernel: " << activeScanKernels().name
+              << ").\n";
+    return 0;
+}
@@ -24,6 +24,25 @@ void test_is_method_allowed() {
     assert(!loc.isMethodAllowed("DELETE"));
 }
 
+void test_method_mask() {
+    Location loc;
+    assert(loc.getMethodMask() == 0);
+    assert(!loc.isMethodAllowed(HttpMethod::GET));
+
+    loc.addMethod("GET");
+    loc.addMethod("DELETE");
+    loc.addMethod("PROPFIND"); // unknown methods have no bit and are ignored
+
+    assert(loc.getMethodMask() ==
+           (httpMethodBit(HttpMethod::GET) | httpMethodBit(HttpMethod::DELETE)));
+    assert(loc.isMethodAllowed(HttpMethod::GET));
+    assert(loc.isMethodAllowed(HttpMethod::DELETE));
+    assert(!loc.isMethodAllowed(HttpMethod::POST));
+    assert(!loc.isMethodAllowed(HttpMethod::UNKNOWN));
+    assert(!loc.isMethodAllowed("PROPFIND"));
+    assert(!loc.isMethodAllowed("get")); // methods are case-sensitive
+}
+
 void test_matches_path() {
     Location loc;
     loc.setPath("/api");
@@ -41,6 +60,19 @@ void test_resolve_absolute_path() {
     assert(loc.resolveAbsolutePath("/static/logo.png") == "/var/www/logo.png");
     assert(loc.resolveAbsolutePath("/static") == "/var/www");
     assert(loc.resolveAbsolutePath("/unmatched") == "");
+
+    // The allocator-aware overload appends with the same rules
+    std::pmr::string out("prefix:");
+    assert(loc.resolveAbsolutePath(std::string_view("/static/logo.png"), out));
+    assert(out == "prefix:/var/www/logo.png");
+    assert(!loc.resolveAbsolutePath(std::string_view("/unmatched"), out));
+    assert(out == "prefix:/var/www/logo.png");
+
+    Location root;
+    root.setPath("/");
+    root.setRoot("./www");
+    assert(root.resolveAbsolutePath("/index.html") == "./www/index.html");
+    assert(root.resolveAbsolutePath("/") == "./www");
 }
 
 void test_upload_and_cgi_flags() {
@@ -54,6 +86,62 @@ void test_upload_and_cgi_flags() {
     assert(loc.isUploadEnabled());
     assert(loc.isCgiRequest("/form.php"));
     assert(!loc.isCgiRequest("/form.py"));
+    assert(!loc.isCgiRequest("php"));
+
+    // The script ends its segment; what follows is PATH_INFO
+    assert(loc.isCgiRequest("/form.php/a/b"));
+    assert(loc.cgiScriptLength("/form.php/a/b") == 9);
+    assert(loc.cgiScriptLength("/x.phpx/form.php") == 16);
+    assert(loc.cgiScriptLength("/form.phpx") == 0);
+
+    // Scripts run themselves unless an interpreter is set; limits have defaults
+    assert(loc.getCgiInterpreter().empty());
+    assert(loc.getCgiMaxProcesses() == Location::DEFAULT_CGI_MAX_PROCESSES);
+    assert(loc.getCgiTimeout() == Location::DEFAULT_CGI_TIMEOUT);
+    loc.setCgiInterpreter("/usr/bin/php-cgi");
+    loc.setCgiMaxProcesses(2);
+    loc.setCgiTimeout(5);
+    assert(loc.getCgiInterpreter() == "/usr/bin/php-cgi");
+    assert(loc.getCgiMaxProcesses() == 2 && loc.getCgiTimeout() == 5);
+
+    // Forked unless a FastCGI backend is set
+    assert(loc.getFastcgiPass().empty());
+    loc.setFastcgiPass("unix:/run/php-fpm.sock");
+    assert(loc.getFastcgiPass() == "unix:/run/php-fpm.sock");
+
+    // Served locally unless upstream servers are set
+    assert(loc.getProxyPass().empty());
+    assert(loc.getProxyBalance() == ProxyBalance::ROUND_ROBIN);
+    assert(loc.getProxyTimeout() == Location::DEFAULT_PROXY_TIMEOUT);
+    loc.setProxyPass("127.0.0.1:3000 127.0.0.1:3001");
+    loc.setProxyBalance(ProxyBalance::LEAST_CONN);
+    loc.setProxyTimeout(0);
+    assert(loc.getProxyPass() == "127.0.0.1:3000 127.0.0.1:3001");
+    assert(loc.getProxyBalance() == ProxyBalance::LEAST_CONN && loc.getProxyTimeout() == 0);
+}
+
+void test_values_are_interned() {
+    Location a;
+    Location b;
+    a.setRoot(std::string("/srv/shared"));
+    b.setRoot("/srv/shared");
+    a.setCgiExtension(".py");
+    b.setCgiExtension(std::string_view(".py"));
+    assert(&a.getRoot() == &b.getRoot());
+    assert(&a.getCgiExtension() == &b.getCgiExtension());
+
+    const std::size_t pooled = InternedString::poolSize();
+    Location          copy(a);
+    copy.setPath("/srv/shared");
+    assert(InternedString::poolSize() == pooled);
+    assert(&copy.getRoot() == &a.getRoot());
+    assert(&copy.getPath() == &a.getRoot()); // Same characters, whichever field holds them
+
+    // Unset strings are empty, not dangling
+    assert(a.getIndex().empty() && a.getRedirect().empty());
+    assert(a.getAutoindexPageSize() == 0);
+    a.setAutoindexPageSize(1000000);
+    assert(a.getAutoindexPageSize() == Location::MAX_AUTOINDEX_PAGE_SIZE);
 }
 
 void test_index_resolution() {
@@ -67,9 +155,11 @@ void test_index_resolution() {
 
 int main() {
     test_is_method_allowed();
+    test_method_mask();
     test_matches_path();
     test_resolve_absolute_path();
     test_upload_and_cgi_flags();
+    test_values_are_interned();
     test_index_resolution();
 
     std::cout << "✅ All Location tests passed successfully.\n";
@@ -0,0 +1,131 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_logger.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 03:32:33 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:29:26 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "utils/Logger.hpp"
+#include <cassert>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Runs @p body with @p target_fd pointed at a pipe and returns what was written to it
+template <typename Body> static std::string capture(int target_fd, Body body) {
+    int fds[2];
+    assert(pipe(fds) == 0);
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    const int saved = dup(target_fd);
+    dup2(fds[1], target_fd);
+    body();
+    Logger::flush();
+    dup2(saved, target_fd);
+    close(saved);
+    close(fds[1]);
+
+    std::string text;
+    char        buf[4096];
+    ssize_t     n;
+    while ((n = read(fds[0], buf, sizeof(buf))) > 0)
+        text.append(buf, static_cast<std::size_t>(n));
+    close(fds[0]);
+    return text;
+}
+
+static std::size_t count(const std::string& text, const std::string& needle) {
+    std::size_t found = 0;
+    for (std::size_t at = text.find(needle); at != std::string::npos;
+         at = text.find(needle, at + 1))
+        ++found;
+    return found;
+}
+
+void test_levels_and_streams() {
+    const std::string out = capture(STDOUT_FILENO, []() {
+        LOG_INFO("listening on %s:%d", "127.0.0.1", 8080);
+        LOG_WARN("not here");
+    });
+    assert(out.find(" INFO  listening on 127.0.0.1:8080\n") != std::string::npos);
+    assert(out.find("not here") == std::string::npos); // WARN goes to stderr
+
+    const std::string err = capture(STDERR_FILENO, []() { LOG_ERROR("failed: %d", 42); });
+    assert(err.find(" ERROR failed: 42\n") != std::string::npos);
+}
+
+void test_debug_is_compiled_out() {
+    int evaluated = 0;
+    const std::string out = capture(STDOUT_FILENO, [&evaluated]() {
+        LOG_DEBUG("value %d", ++evaluated);
+    });
+#if WEBSERV_LOG_LEVEL > 0
+    assert(evaluated == 0); // Arguments of disabled levels are never evaluated
+    assert(out.empty());
+#else
+    assert(evaluated == 1);
+    assert(out.find("value 1") != std::string::npos);
+#endif
+}
+
+void test_long_records_are_truncated() {
+    const std::string long_text(1000, 'x');
+    const std::string out = capture(STDOUT_FILENO, [&long_text]() {
+        LOG_INFO("%s", long_text.c_str());
+    });
+    assert(out.size() < Logger::RECORD_SIZE + 32);
+    assert(out.back() == '\n');
+}
+
+void test_threads_have_their_own_rings() {
+    const std::string out = capture(STDOUT_FILENO, []() {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.push_back(std::thread([t]() {
+                for (int i = 0; i < 100; ++i)
+                    LOG_INFO("thread %d record %d", t, i);
+            }));
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+    });
+    assert(count(out, " record ") + Logger::getDropped() == 400);
+    assert(count(out, "thread 3 record 99\n") <= 1);
+}
+
+void test_fork_leaves_records_to_parent() {
+    const std::string out = capture(STDOUT_FILENO, []() {
+        LOG_INFO("queued before fork");
+        const pid_t pid = fork();
+        assert(pid >= 0);
+        if (pid == 0) {
+            LOG_INFO("from the child");
+            Logger::flush();
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    });
+    assert(count(out, "queued before fork") == 1); // The child discards its copy
+    assert(count(out, "from the child") == 1);
+}
+
+int main() {
+    test_levels_and_streams();
+    test_debug_is_compiled_out();
+    test_long_records_are_truncated();
+    test_threads_have_their_own_rings();
+    test_fork_leaves_records_to_parent();
+
+    std::cout << "✅ All Logger tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_request_trace.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 05:18:53 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:18:53 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "utils/RequestTrace.hpp"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using std::chrono::microseconds;
+
+void test_marks_and_elapsed() {
+    RequestTrace trace;
+    assert(trace.empty() && trace.elapsed() == RequestTrace::Clock::duration::zero());
+
+    const RequestTrace::Clock::time_point start = RequestTrace::Clock::now();
+    trace.mark(TracePhase::ACCEPTED, start);
+    trace.mark(TracePhase::HEAD_START, start + microseconds(500));
+    assert(!trace.empty() && trace.has(TracePhase::HEAD_START) && !trace.has(TracePhase::DONE));
+    assert(trace.elapsed() == RequestTrace::Clock::duration::zero());
+
+    // The wait before the head is not part of the request
+    trace.mark(TracePhase::DONE, start + microseconds(3000));
+    assert(trace.elapsed() == microseconds(2500));
+    trace.mark(TracePhase::DONE, start + microseconds(4000));
+    assert(trace.elapsed() == microseconds(3500));
+
+    trace.reset();
+    assert(trace.empty() && !trace.has(TracePhase::ACCEPTED));
+}
+
+void test_format() {
+    RequestTrace                          trace;
+    const RequestTrace::Clock::time_point start = RequestTrace::Clock::now();
+    trace.describe("GET", "/slow?x=1");
+    trace.setStatus(200);
+    trace.mark(TracePhase::HEAD_START, start);
+    trace.mark(TracePhase::HEAD_PARSED, start + microseconds(11));
+    trace.mark(TracePhase::ROUTED, start + microseconds(20));
+    trace.mark(TracePhase::RESPONDED, start + microseconds(1250));
+    trace.mark(TracePhase::DONE, start + microseconds(12480));
+
+    char              line[256];
+    const std::size_t length = trace.format(line, sizeof(line));
+    assert(length == std::strlen(line));
+    assert(std::string(line) == "GET /slow?x=1 200 in 12.480 ms: read parsed +0.011 "
+                                "routed +0.009 responded +1.230 done +11.230");
+
+    // Truncated, never overflowed
+    char small[16];
+    assert(trace.format(small, sizeof(small)) == 15 && std::strlen(small) == 15);
+    assert(std::string(small) == "GET /slow?x=1 2");
+
+    // Long targets are cut; a response without a request has no request line
+    RequestTrace long_target;
+    long_target.describe("GET", std::string(500, 'a'));
+    long_target.format(line, sizeof(line));
+    assert(std::string(line).find(std::string(RequestTrace::TARGET_SIZE, 'a') + " - in") == 4);
+    RequestTrace anonymous;
+    anonymous.setStatus(400);
+    anonymous.format(line, sizeof(line));
+    assert(std::string(line) == "400 in 0.000 ms:");
+}
+
+int main() {
+    test_marks_and_elapsed();
+    test_format();
+
+    std::cout << "✅ All RequestTrace tests passed successfully.\n";
+    return 0;
+}
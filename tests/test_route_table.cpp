@@ -0,0 +1,124 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_route_table.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:13:32 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:13:32 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "core/Location.hpp"
+#include "core/RouteTable.hpp"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Reference: the linear longest-prefix scan the table replaces
+static std::int32_t linearFind(const std::vector<Location>& locations, const std::string& path) {
+    std::int32_t best     = RouteTable::NO_ROUTE;
+    std::size_t  best_len = 0;
+    for (std::size_t i = 0; i < locations.size(); ++i) {
+        const std::size_t len = locations[i].getPath().size();
+        if (locations[i].matchesPath(path) && (best == RouteTable::NO_ROUTE || len > best_len)) {
+            best     = static_cast<std::int32_t>(i);
+            best_len = len;
+        }
+    }
+    return best;
+}
+
+void test_longest_prefix() {
+    RouteTable table;
+    table.insert("/", 0);
+    table.insert("/api", 1);
+    table.insert("/api/v1", 2);
+    table.insert("/images", 3);
+
+    assert(table.find("/") == 0);
+    assert(table.find("/index.html") == 0);
+    assert(table.find("/api") == 1);
+    assert(table.find("/api/") == 1);
+    assert(table.find("/apiary") == 1); // byte prefix, as Location::matchesPath
+    assert(table.find("/api/v1/users") == 2);
+    assert(table.find("/api/v2") == 1);
+    assert(table.find("/images/logo.png") == 3);
+    assert(table.find("") == RouteTable::NO_ROUTE);
+    assert(table.find("relative") == RouteTable::NO_ROUTE);
+}
+
+void test_edge_split_and_duplicates() {
+    RouteTable table;
+    table.insert("/static/css", 0);
+    table.insert("/static/js", 1); // splits "/static/css" at "/static/"
+    table.insert("/static", 2);    // ends exactly on the split node
+    table.insert("/static/js", 3); // duplicate: the first one is kept
+
+    assert(table.find("/static/css/site.css") == 0);
+    assert(table.find("/static/js/app.js") == 1);
+    assert(table.find("/static/img/a.png") == 2);
+    assert(table.find("/static") == 2);
+    assert(table.find("/stat") == RouteTable::NO_ROUTE);
+    assert(table.nodeCount() == 5); // root, "/static", "/", "css", "js"
+
+    RouteTable copy = table;
+    table.clear();
+    assert(table.find("/static") == RouteTable::NO_ROUTE);
+    assert(copy.find("/static/js") == 1);
+}
+
+void test_empty_path_matches_everything() {
+    RouteTable table;
+    table.insert("", 7);
+    table.insert("/a", 8);
+    assert(table.find("") == 7);
+    assert(table.find("/b") == 7);
+    assert(table.find("/a/b") == 8);
+}
+
+void test_matches_linear_scan() {
+    const char* segments[] = {"/", "a", "b", "ab", "api", "v1", "img", "."};
+    std::srand(7);
+
+    for (int round = 0; round < 50; ++round) {
+        std::vector<Location> locations;
+        RouteTable            table;
+        for (int i = 0; i < 40; ++i) {
+            std::string path = "/";
+            for (int n = std::rand() % 5; n > 0; --n)
+                path += segments[std::rand() % 8];
+            Location loc;
+            loc.setPath(path);
+            table.insert(path, locations.size());
+            locations.push_back(loc);
+        }
+        for (int q = 0; q < 200; ++q) {
+            std::string path = "/";
+            for (int n = std::rand() % 7; n > 0; --n)
+                path += segments[std::rand() % 8];
+            const std::int32_t expected = linearFind(locations, path);
+            const std::int32_t found    = table.find(path);
+            // Same path length is enough: duplicate paths may keep a different index
+            if (expected == RouteTable::NO_ROUTE)
+                assert(found == RouteTable::NO_ROUTE);
+            else
+                assert(found != RouteTable::NO_ROUTE &&
+                       locations[static_cast<std::size_t>(found)].getPath() ==
+                           locations[static_cast<std::size_t>(expected)].getPath());
+        }
+    }
+}
+
+int main() {
+    test_longest_prefix();
+    test_edge_split_and_duplicates();
+    test_empty_path_matches_everything();
+    test_matches_linear_scan();
+
+    std::cout << "✅ All RouteTable tests passed successfully.\n";
+    return 0;
+}
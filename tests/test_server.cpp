@@ -23,6 +23,12 @@ void test_default_values() {
     assert(s.getServerNames().empty());
     assert(s.getErrorPages().empty());
     assert(s.getLocations().empty());
+    assert(s.getKeepAliveTimeout() == 60);
+    assert(s.getKeepAliveRequests() == 100);
+    assert(s.getClientHeaderTimeout() == 60);
+    assert(s.getClientBodyTimeout() == 60);
+    assert(s.getSendTimeout() == 60);
+    assert(s.getListenBacklog() == 511);
 }
 
 void test_setters_and_getters() {
@@ -35,6 +41,12 @@ void test_setters_and_getters() {
     s.addServerName("example.com");
     s.setErrorPage(404, "/errors/404.html");
     s.setErrorPage(500, "/errors/500.html");
+    s.setKeepAliveTimeout(5);
+    s.setKeepAliveRequests(10);
+    s.setClientHeaderTimeout(7);
+    s.setClientBodyTimeout(8);
+    s.setSendTimeout(9);
+    s.setListenBacklog(4096);
 
     Location loc;
     loc.setPath("/api");
@@ -43,6 +55,12 @@ void test_setters_and_getters() {
     assert(s.getPort() == 8080);
     assert(s.getHost() == "127.0.0.1");
     assert(s.getClientMaxBodySize() == 4096);
+    assert(s.getKeepAliveTimeout() == 5);
+    assert(s.getKeepAliveRequests() == 10);
+    assert(s.getClientHeaderTimeout() == 7);
+    assert(s.getClientBodyTimeout() == 8);
+    assert(s.getSendTimeout() == 9);
+    assert(s.getListenBacklog() == 4096);
 
     const std::vector<std::string>& names = s.getServerNames();
     assert(names.size() == 2);
@@ -69,6 +87,27 @@ void test_has_server_name() {
     assert(!s.hasServerName("unknown.com")); // should not match
 }
 
+void test_find_location() {
+    Server s;
+    assert(s.findLocation("/") == NULL);
+
+    const char* paths[] = {"/", "/api", "/api/v1", "/uploads"};
+    for (const char* path : paths) {
+        Location loc;
+        loc.setPath(path);
+        s.addLocation(loc);
+    }
+
+    assert(s.findLocation("/index.html")->getPath() == "/");
+    assert(s.findLocation("/api/users")->getPath() == "/api");
+    assert(s.findLocation("/api/v1/users")->getPath() == "/api/v1");
+    assert(s.findLocation("/uploads")->getPath() == "/uploads");
+
+    Server copy = s; // Indices stay valid in the copied location list
+    assert(copy.findLocation("/api/v1")->getPath() == "/api/v1");
+    assert(copy.findLocation("/api/v1") == &copy.getLocations()[2]);
+}
+
 void test_find_matching_server() {
     std::vector<Server> servers;
 
@@ -121,6 +160,7 @@ int main() {
     test_default_values();
     test_setters_and_getters();
     test_has_server_name();
+    test_find_location();
 
     std::cout << "✅ All Server tests passed successfully.\n";
     return 0;
@@ -0,0 +1,257 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_socket_manager.cpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:18:28 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 06:04:01 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "network/SocketManager.hpp"
+#include <arpa/inet.h>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+#include <netinet/in.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+static int port() {
+    return 20000 + static_cast<int>(getpid() % 20000); // Avoid clashes between runs
+}
+
+static std::shared_ptr<const ConfigSnapshot> makeConfig(std::size_t timeout         = 60,
+                                                        std::size_t max_connections = 0) {
+    Server server;
+    server.setHost("127.0.0.1");
+    server.setPort(port());
+    server.setClientHeaderTimeout(timeout);
+    server.setKeepAliveTimeout(timeout);
+    std::vector<Server> servers(1, server);
+    return std::make_shared<const ConfigSnapshot>(servers, Config::DEFAULT_ASSET_CACHE_SIZE,
+                                                  max_connections);
+}
+
+void test_reuse_port_allows_one_listener_per_worker() {
+    std::shared_ptr<const ConfigSnapshot> config = makeConfig();
+
+    SocketManager first(config, PollBackend::AUTO, true);
+    SocketManager second(config, PollBackend::AUTO, true); // Same address, own socket
+
+    bool refused = false;
+    try {
+        SocketManager exclusive(config, PollBackend::AUTO, false);
+    } catch (const SocketManager::SocketError&) {
+        refused = true;
+    }
+    assert(refused);
+}
+
+void test_stop_from_another_thread() {
+    SocketManager manager(makeConfig());
+
+    std::thread loop([&manager]() { manager.run(); });
+    usleep(20000); // Let the loop block in wait()
+    manager.stop();
+    loop.join();
+
+    manager.stop(); // Stopping twice is harmless
+    manager.run();  // Returns at once when already stopped
+}
+
+// Read until the server closes; the receive timeout guards against a hang
+static std::string readUntilClosed(int fd) {
+    timeval limit{5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &limit, sizeof(limit));
+    std::string response;
+    char        buf[4096];
+    ssize_t     got;
+    while ((got = recv(fd, buf, sizeof(buf), 0)) > 0)
+        response.append(buf, static_cast<std::size_t>(got));
+    assert(got == 0);
+    return response;
+}
+
+static int connectClient(const std::string& request) {
+    const int   fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(static_cast<uint16_t>(port()));
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    assert(connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    assert(send(fd, request.data(), request.size(), 0) == static_cast<ssize_t>(request.size()));
+    return fd;
+}
+
+void test_timeouts_end_waiting_clients() {
+    SocketManager manager(makeConfig(1));
+    std::thread   loop([&manager]() { manager.run(); });
+
+    // A head that never completes is answered once its time is up
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int         fd       = connectClient("GET / HTTP/1.1\r\nHost: x\r\n");
+    std::string response = readUntilClosed(fd);
+    close(fd);
+    assert(response.compare(0, 12, "HTTP/1.1 408") == 0);
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::seconds(1));
+
+    // An idle persistent connection is closed after its response
+    fd       = connectClient("GET / HTTP/1.1\r\nHost: x\r\n\r\n");
+    response = readUntilClosed(fd);
+    close(fd);
+    assert(response.compare(0, 9, "HTTP/1.1 ") == 0);
+    assert(response.find("Connection: keep-alive\r\n") != std::string::npos);
+    assert(response.find("HTTP/1.1 408") == std::string::npos);
+
+    manager.stop();
+    loop.join();
+}
+
+void test_max_connections_pauses_accepting() {
+    SocketManager manager(makeConfig(60, 1));
+    std::thread   loop([&manager]() { manager.run(); });
+
+    const std::string request = "GET / HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n";
+    const int         first   = connectClient("");
+    const int         second  = connectClient(request); // Queued by the kernel meanwhile
+    usleep(200000);
+    char buf[1];
+    assert(recv(second, buf, sizeof(buf), MSG_DONTWAIT) < 0 && errno == EAGAIN);
+
+    close(first); // Frees the only slot
+    assert(readUntilClosed(second).compare(0, 9, "HTTP/1.1 ") == 0);
+    close(second);
+
+    manager.stop();
+    loop.join();
+}
+
+static std::chrono::microseconds cpuTime() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+void test_descriptor_exhaustion_backs_off() {
+    SocketManager manager(makeConfig());
+    std::thread   loop([&manager]() { manager.run(); });
+    usleep(20000);
+
+    // The client gets the last descriptor, so the server's accept() fails with EMFILE
+    const int free_fd = dup(0);
+    close(free_fd);
+    rlimit saved;
+    getrlimit(RLIMIT_NOFILE, &saved);
+    rlimit low = saved;
+    low.rlim_cur = static_cast<rlim_t>(free_fd + 1);
+    assert(setrlimit(RLIMIT_NOFILE, &low) == 0);
+    const std::string request = "GET / HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n";
+    const int         fd      = connectClient(request);
+
+    // Paused listeners are not reported again, so the loop sleeps instead of spinning
+    const std::chrono::microseconds before = cpuTime();
+    usleep(300000);
+    assert(cpuTime() - before < std::chrono::milliseconds(100));
+
+    // Once descriptors are back, the backoff ends and the queued client is served
+    assert(setrlimit(RLIMIT_NOFILE, &saved) == 0);
+    assert(readUntilClosed(fd).compare(0, 9, "HTTP/1.1 ") == 0);
+    close(fd);
+
+    manager.stop();
+    loop.join();
+}
+
+// Read one response framed by its Content-Length
+static std::string readResponse(int fd) {
+    timeval limit{5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &limit, sizeof(limit));
+    std::string response;
+    char        buf[4096];
+    std::size_t head = std::string::npos;
+    while ((head = response.find("\r\n\r\n")) == std::string::npos) {
+        const ssize_t got = recv(fd, buf, sizeof(buf), 0);
+        assert(got > 0);
+        response.append(buf, static_cast<std::size_t>(got));
+    }
+    const std::size_t length = response.find("Content-Length: ");
+    assert(length != std::string::npos);
+    const std::size_t total = head + 4 + std::stoul(response.substr(length + 16));
+    while (response.size() < total) {
+        const ssize_t got = recv(fd, buf, sizeof(buf), 0);
+        assert(got > 0);
+        response.append(buf, static_cast<std::size_t>(got));
+    }
+    return response;
+}
+
+void test_reload_keeps_connections() {
+    std::shared_ptr<const ConfigSnapshot> before = makeConfig();
+    SocketManager                         manager(before);
+    std::thread                           loop([&manager]() { manager.run(); });
+
+    const std::string request = "GET /metrics HTTP/1.1\r\nHost: x\r\n\r\n";
+    const int         fd      = connectClient(request);
+    assert(readResponse(fd).compare(0, 12, "HTTP/1.1 404") == 0);
+
+    // The new configuration adds a stats location and a second port
+    Server server = before->getServers()[0];
+    Location metrics;
+    metrics.setPath("/metrics");
+    metrics.setStats(true);
+    server.addLocation(metrics);
+    Server other = server;
+    other.setPort(port() + 1);
+    std::vector<Server> servers;
+    servers.push_back(server);
+    servers.push_back(other);
+    manager.reload(std::make_shared<const ConfigSnapshot>(servers));
+    usleep(50000);
+
+    // Same connection, next request: answered with the new configuration
+    assert(send(fd, request.data(), request.size(), 0) == static_cast<ssize_t>(request.size()));
+    const std::string response = readResponse(fd);
+    assert(response.compare(0, 12, "HTTP/1.1 200") == 0);
+    assert(response.find("webserv_connections_active 1\n") != std::string::npos);
+
+    const int   added = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(static_cast<uint16_t>(port() + 1));
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    assert(connect(added, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    close(added);
+
+    // Going back closes the second listener; the first one never stopped accepting
+    manager.reload(before);
+    usleep(50000);
+    const int removed = socket(AF_INET, SOCK_STREAM, 0);
+    assert(connect(removed, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0);
+    close(removed);
+    assert(send(fd, request.data(), request.size(), 0) == static_cast<ssize_t>(request.size()));
+    assert(readResponse(fd).compare(0, 12, "HTTP/1.1 404") == 0);
+    close(fd);
+
+    manager.stop();
+    loop.join();
+}
+
+int main() {
+    test_reuse_port_allows_one_listener_per_worker();
+    test_stop_from_another_thread();
+    test_timeouts_end_waiting_clients();
+    test_max_connections_pauses_accepting();
+    test_descriptor_exhaustion_backs_off();
+    test_reload_keeps_connections();
+
+    std::cout << "✅ All SocketManager tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,209 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_stats.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 03:39:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 06:05:52 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "http/HttpResponse.hpp"
+#include "network/Connection.hpp"
+#include "utils/Stats.hpp"
+#include <cassert>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+void test_histogram_buckets() {
+    // Exact below 16 µs, then 8 buckets per power of two
+    for (std::uint64_t v = 0; v < 16; ++v)
+        assert(LatencyHistogram::bucketOf(v) == v);
+    assert(LatencyHistogram::bucketOf(16) == 16);
+    assert(LatencyHistogram::bucketOf(17) == 16);
+    assert(LatencyHistogram::bucketOf(18) == 17);
+    assert(LatencyHistogram::upperBound(16) == 17);
+
+    // Every value lies in its bucket, within 12.5% of the bound
+    for (std::uint64_t v = 1; v < (std::uint64_t(1) << 30); v = v * 3 / 2 + 1) {
+        const std::size_t   bucket = LatencyHistogram::bucketOf(v);
+        const std::uint64_t upper  = LatencyHistogram::upperBound(bucket);
+        assert(v <= upper);
+        assert(bucket == 0 || v > LatencyHistogram::upperBound(bucket - 1));
+        assert(upper - v <= v / 8);
+    }
+    assert(LatencyHistogram::bucketOf(~std::uint64_t(0)) == LatencyHistogram::BUCKETS - 1);
+
+    LatencyHistogram histogram;
+    histogram.record(100);
+    histogram.record(std::chrono::milliseconds(2));
+    assert(histogram.getCount() == 2);
+    assert(histogram.getSum() == 2100);
+    assert(histogram.getBucket(LatencyHistogram::bucketOf(2000)) == 1);
+}
+
+void test_registry_renders_sums() {
+    std::shared_ptr<StatsRegistry> registry = StatsRegistry::create(2);
+    registry->getWorker(0).accepted.add(3);
+    registry->getWorker(1).accepted.add(2);
+    registry->getWorker(1).closed.add(4);
+    registry->getWorker(0).countResponse(200);
+    registry->getWorker(1).countResponse(404);
+    registry->getWorker(1).countResponse(204);
+    registry->getWorker(0).tls_handshakes.add(3);
+    registry->getWorker(1).tls_resumed.add(1);
+    registry->getWorker(0).slow_requests.add(2);
+    registry->getWorker(1).buffers_in_use.set(3);
+    registry->getWorker(1).buffers_high_water.set(8);
+    registry->getWorker(0).buffer_hits.set(40);
+    registry->getWorker(0).buffer_misses.set(2);
+    for (std::size_t i = 0; i < 100; ++i)
+        registry->getWorker(i % 2).total.record(static_cast<std::uint64_t>(1000 + i));
+
+    std::string text;
+    registry->renderPrometheus(text);
+    assert(text.find("webserv_connections_accepted_total 5\n") != std::string::npos);
+    assert(text.find("webserv_connections_active 1\n") != std::string::npos);
+    assert(text.find("webserv_tls_handshakes_total 3\n") != std::string::npos);
+    assert(text.find("webserv_tls_resumed_total 1\n") != std::string::npos);
+    assert(text.find("webserv_slow_requests_total 2\n") != std::string::npos);
+    assert(text.find("webserv_responses_total{code=\"2xx\"} 2\n") != std::string::npos);
+    assert(text.find("webserv_responses_total{code=\"4xx\"} 1\n") != std::string::npos);
+    assert(text.find("# TYPE webserv_request_duration_seconds summary\n") != std::string::npos);
+    assert(text.find("webserv_request_duration_seconds{quantile=\"0.5\"} 0.001") !=
+           std::string::npos);
+    assert(text.find("webserv_request_duration_seconds_count 100\n") != std::string::npos);
+
+    // Buffer pools are reported per loop, not summed
+    assert(text.find("webserv_buffer_pool_in_use{worker=\"0\"} 0\n") != std::string::npos);
+    assert(text.find("webserv_buffer_pool_in_use{worker=\"1\"} 3\n") != std::string::npos);
+    assert(text.find("webserv_buffer_pool_high_water{worker=\"1\"} 8\n") != std::string::npos);
+    assert(text.find("webserv_buffer_pool_hits_total{worker=\"0\"} 40\n") != std::string::npos);
+    assert(text.find("webserv_buffer_pool_misses_total{worker=\"0\"} 2\n") !=
+           std::string::npos);
+}
+
+void test_registry_is_shared_with_children() {
+    std::shared_ptr<StatsRegistry> registry = StatsRegistry::create(2);
+    const pid_t                    pid      = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        registry->getWorker(1).bytes_in.add(42);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    assert(registry->getWorker(1).bytes_in.get() == 42);
+}
+
+void test_connection_times_responses() {
+    int fds[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    assert(fcntl(fds[0], F_SETFL, O_NONBLOCK) == 0);
+    Server      server;
+    WorkerStats stats;
+    Connection  conn(fds[0], &server, NULL, NULL, &stats);
+
+    const std::string request = "GET / HTTP/1.1\r\nHost: a\r\n\r\n";
+    assert(write(fds[1], request.data(), request.size()) == static_cast<ssize_t>(request.size()));
+    assert(conn.readFromSocket() == IoStatus::OK);
+    assert(conn.parseInput());
+    assert(stats.bytes_in.get() == request.size());
+
+    // Two pipelined responses flushed in one write are both timed
+    for (int i = 0; i < 2; ++i) {
+        HttpResponse response(i ? 404 : 200);
+        response.setBody("hello", "text/plain");
+        conn.queueResponse(response, false);
+    }
+    assert(stats.responses[2].get() == 1 && stats.responses[4].get() == 1);
+    assert(stats.first_byte.getCount() == 0);
+    assert(conn.writeToSocket() == IoStatus::OK);
+    assert(stats.first_byte.getCount() == 2);
+    assert(stats.total.getCount() == 2);
+    assert(stats.bytes_out.get() > 10);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_parse_errors_are_counted() {
+    int fds[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    assert(fcntl(fds[0], F_SETFL, O_NONBLOCK) == 0);
+    Server      server;
+    WorkerStats stats;
+    Connection  conn(fds[0], &server, NULL, NULL, &stats);
+
+    assert(write(fds[1], "BROKEN\r\n\r\n", 10) == 10);
+    assert(conn.readFromSocket() == IoStatus::OK);
+    assert(!conn.parseInput());
+    assert(stats.parse_errors.get() == 1);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_slow_requests_are_counted() {
+    int fds[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    assert(fcntl(fds[0], F_SETFL, O_NONBLOCK) == 0);
+    Server      server;
+    WorkerStats stats;
+    Connection  conn(fds[0], &server, NULL, NULL, &stats);
+    conn.traceSlowRequests(std::chrono::nanoseconds(1));
+
+    // Two pipelined requests, each slower than a nanosecond
+    const std::string request = "GET /a HTTP/1.1\r\nHost: a\r\n\r\n";
+    const std::string twice   = request + request;
+    assert(write(fds[1], twice.data(), twice.size()) == static_cast<ssize_t>(twice.size()));
+    assert(conn.readFromSocket() == IoStatus::OK);
+    for (int i = 0; i < 2; ++i) {
+        assert(conn.parseInput());
+        conn.markRouted();
+        conn.finishRequest();
+        HttpResponse response(200);
+        response.setBody("hello", "text/plain");
+        conn.queueResponse(response, false);
+    }
+    assert(stats.slow_requests.get() == 0);
+    assert(conn.writeToSocket() == IoStatus::OK);
+    assert(stats.slow_requests.get() == 2);
+
+    // Nothing reaches an hour; with tracing off nothing is counted either
+    conn.traceSlowRequests(std::chrono::hours(1));
+    for (int i = 0; i < 2; ++i) {
+        assert(write(fds[1], request.data(), request.size()) ==
+               static_cast<ssize_t>(request.size()));
+        assert(conn.readFromSocket() == IoStatus::OK);
+        assert(conn.parseInput());
+        conn.finishRequest();
+        HttpResponse response(404);
+        conn.queueResponse(response, false);
+        if (i == 0)
+            conn.traceSlowRequests(Connection::Clock::duration::zero());
+        assert(conn.writeToSocket() == IoStatus::OK);
+    }
+    assert(stats.slow_requests.get() == 2 && stats.total.getCount() == 4);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+int main() {
+    test_histogram_buckets();
+    test_registry_renders_sums();
+    test_registry_is_shared_with_children();
+    test_connection_times_responses();
+    test_parse_errors_are_counted();
+    test_slow_requests_are_counted();
+
+    std::cout << "✅ All Stats tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_string_utils.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:24:10 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 04:36:08 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "utils/StringUtils.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+static std::string normalized(const std::string& path) {
+    std::string out;
+    assert(normalizeUriPath(path, out));
+    return out;
+}
+
+static bool rejected(const std::string& path) {
+    std::string out;
+    return !normalizeUriPath(path, out);
+}
+
+void test_basic_helpers() {
+    assert(iequals("Content-Length", "content-length"));
+    assert(!iequals("abc", "abd"));
+    assert(trim(" \tvalue\t ") == "value");
+    assert(toLower("MiXeD") == "mixed");
+
+    std::size_t value = 0;
+    assert(parseSize("1234", value) && value == 1234);
+    assert(!parseSize("", value) && !parseSize("12a", value));
+    assert(!parseSize("99999999999999999999999", value));
+}
+
+void test_normalize_uri_path() {
+    assert(normalized("/") == "/");
+    assert(normalized("/index.html") == "/index.html");
+    assert(normalized("//a///b") == "/a/b");
+    assert(normalized("/a/./b/../c") == "/a/c");
+    assert(normalized("/a/") == "/a/");
+    assert(normalized("/a/.") == "/a/");
+    assert(normalized("/a/b/..") == "/a/");
+    assert(normalized("/a/..") == "/");
+    assert(normalized("/my%20file.txt") == "/my file.txt");
+    assert(normalized("/a/%2e%2E/b") == "/b"); // encoded dots are dot segments too
+}
+
+void test_normalize_rejects() {
+    assert(rejected(""));
+    assert(rejected("relative"));
+    assert(rejected("/.."));
+    assert(rejected("/a/../.."));
+    assert(rejected("/%2e%2e/etc/passwd"));
+    assert(rejected("/%zz"));
+    assert(rejected("/%4"));
+    assert(rejected("/a%00b"));
+    assert(rejected("/a%2Fb"));
+}
+
+void test_format_http_date() {
+    assert(formatHttpDate(0) == "Thu, 01 Jan 1970 00:00:00 GMT");
+    assert(formatHttpDate(784111777) == "Sun, 06 Nov 1994 08:49:37 GMT"); // RFC 9110 example
+
+    std::time_t parsed = 0;
+    assert(parseHttpDate("Sun, 06 Nov 1994 08:49:37 GMT", parsed) && parsed == 784111777);
+    assert(parseHttpDate(formatHttpDate(1700000000), parsed) && parsed == 1700000000);
+    assert(!parseHttpDate("Sunday, 06-Nov-94 08:49:37 GMT", parsed)); // RFC 850
+    assert(!parseHttpDate("Sun Nov  6 08:49:37 1994", parsed));       // asctime
+    assert(!parseHttpDate("Sun, 06 Nox 1994 08:49:37 GMT", parsed));
+    assert(!parseHttpDate("Sun, 06 Nov 1994 08:49:37 UTC", parsed));
+    assert(!parseHttpDate("Sun, +6 Nov 1994 08:49:37 GMT", parsed));
+}
+
+int main() {
+    test_basic_helpers();
+    test_normalize_uri_path();
+    test_normalize_rejects();
+    test_format_http_date();
+
+    std::cout << "✅ All StringUtils tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,121 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_timer_wheel.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:33:51 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:33:51 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "network/TimerWheel.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+
+using Clock = TimerWheel::Clock;
+using std::chrono::milliseconds;
+
+void test_fires_after_deadline() {
+    const Clock::time_point  start = Clock::now();
+    TimerWheel               wheel(milliseconds(10), start);
+    std::vector<std::size_t> expired;
+    assert(wheel.nextTimeout(start) == -1);
+
+    wheel.schedule(3, start + milliseconds(25));
+    wheel.schedule(7, start + milliseconds(5));
+    assert(wheel.size() == 2 && wheel.isScheduled(3));
+    assert(wheel.nextTimeout(start) == 10); // Rounded up to the tick boundary
+
+    wheel.expire(start + milliseconds(9), expired);
+    assert(expired.empty());
+    wheel.expire(start + milliseconds(10), expired);
+    assert(expired.size() == 1 && expired[0] == 7);
+    wheel.expire(start + milliseconds(30), expired);
+    assert(expired.size() == 2 && expired[1] == 3);
+    assert(wheel.size() == 0 && !wheel.isScheduled(3));
+}
+
+void test_cancel_and_reschedule() {
+    const Clock::time_point  start = Clock::now();
+    TimerWheel               wheel(milliseconds(10), start);
+    std::vector<std::size_t> expired;
+
+    wheel.schedule(1, start + milliseconds(50));
+    wheel.schedule(2, start + milliseconds(50));
+    wheel.cancel(1);
+    wheel.cancel(1);
+    wheel.cancel(99); // Never scheduled
+    wheel.schedule(2, start + milliseconds(5000)); // Pushed back, as on client activity
+    wheel.expire(start + milliseconds(100), expired);
+    assert(expired.empty() && wheel.size() == 1);
+    wheel.expire(start + milliseconds(5000), expired);
+    assert(expired.size() == 1 && expired[0] == 2);
+
+    // Past deadlines fire right away; deadlines beyond the range fire at its end
+    wheel.schedule(4, start);
+    assert(wheel.nextTimeout(start + milliseconds(6000)) == 0);
+    wheel.expire(start + milliseconds(6000), expired);
+    assert(expired.size() == 2 && expired[1] == 4);
+    wheel.schedule(5, start + std::chrono::hours(24 * 365));
+    assert(wheel.isScheduled(5));
+}
+
+// Random operations against a plain map of deadlines
+void test_matches_model() {
+    const Clock::time_point                  start = Clock::now();
+    TimerWheel                               wheel(milliseconds(1), start);
+    std::map<std::size_t, Clock::time_point> model;
+    std::vector<std::size_t>                 expired;
+    Clock::time_point                        now = start;
+    std::srand(42);
+
+    for (int step = 0; step < 20000; ++step) {
+        const std::size_t key = static_cast<std::size_t>(std::rand() % 64);
+        const int         op  = std::rand() % 4;
+        if (op == 0) {
+            wheel.cancel(key);
+            model.erase(key);
+        } else if (op == 1) {
+            // Spread over every level: up to about 4.6 hours of 1 ms ticks
+            const long delay = std::rand() % 2 ? std::rand() % 300 : std::rand() % 16000000;
+            wheel.schedule(key, now + milliseconds(delay));
+            model[key] = now + milliseconds(delay);
+        }
+
+        // Jump straight to the next wake-up, as an idle event loop would
+        const int timeout = wheel.nextTimeout(now);
+        assert((timeout < 0) == model.empty());
+        Clock::time_point earliest = Clock::time_point::max();
+        for (const auto& entry : model)
+            earliest = std::min(earliest, entry.second);
+        if (timeout >= 0) {
+            assert(now + milliseconds(timeout) <= std::max(earliest, now) + milliseconds(1));
+            now += milliseconds(std::rand() % 3 ? timeout : 1);
+        }
+
+        expired.clear();
+        wheel.expire(now, expired);
+        for (std::size_t done : expired) {
+            assert(model.count(done) && model[done] <= now);
+            model.erase(done);
+        }
+        for (const auto& entry : model)
+            assert(entry.second > now);
+        assert(wheel.size() == model.size());
+    }
+}
+
+int main() {
+    test_fires_after_deadline();
+    test_cancel_and_reschedule();
+    test_matches_model();
+
+    std::cout << "✅ All TimerWheel tests passed successfully.\n";
+    return 0;
+}
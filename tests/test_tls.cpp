@@ -0,0 +1,227 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_tls.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 05:02:58 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:02:58 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "network/TlsContext.hpp"
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifdef WEBSERV_HAVE_OPENSSL
+# include <openssl/pem.h>
+# include <openssl/ssl.h>
+# include <openssl/x509.h>
+#endif
+
+static std::string g_root;
+
+static Server makeServer() {
+    Server server;
+    server.setSsl(true);
+    server.setSslCertificate(g_root + "/cert.pem");
+    server.setSslCertificateKey(g_root + "/key.pem");
+    return server;
+}
+
+void test_bad_certificate() {
+    Server server = makeServer();
+    server.setSslCertificate(g_root + "/missing.pem");
+    try {
+        TlsContext context(server);
+        assert(false);
+    } catch (const TlsContext::TlsError& e) {
+        assert(std::string(e.what()).find("TLS:") == 0);
+    }
+}
+
+#ifdef WEBSERV_HAVE_OPENSSL
+
+// A throwaway P-256 key and a self-signed certificate for it
+static void writeCertificate() {
+    EVP_PKEY* key  = EVP_EC_gen("P-256");
+    X509*     cert = X509_new();
+    assert(key && cert);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    assert(X509_sign(cert, key, EVP_sha256()) > 0);
+
+    FILE* out = fopen((g_root + "/cert.pem").c_str(), "w");
+    assert(out && PEM_write_X509(out, cert));
+    fclose(out);
+    out = fopen((g_root + "/key.pem").c_str(), "w");
+    assert(out && PEM_write_PrivateKey(out, key, NULL, NULL, 0, NULL, NULL));
+    fclose(out);
+    X509_free(cert);
+    EVP_PKEY_free(key);
+}
+
+// A client talking to a TlsSession over a non-blocking socket pair
+struct Peer {
+    int         fds[2];
+    SSL*        client;
+    TlsSession* server;
+
+    Peer(SSL_CTX* client_ctx, const TlsContext& context, SSL_SESSION* resume = NULL) {
+        assert(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        fcntl(fds[0], F_SETFL, O_NONBLOCK);
+        fcntl(fds[1], F_SETFL, O_NONBLOCK);
+        client = SSL_new(client_ctx);
+        SSL_set_fd(client, fds[0]);
+        SSL_set_connect_state(client);
+        if (resume)
+            SSL_set_session(client, resume);
+        server = new TlsSession(context, fds[1]);
+    }
+    ~Peer() {
+        // Both send close_notify: OpenSSL drops the sessions of connections cut short
+        server->shutdown();
+        SSL_shutdown(client);
+        delete server;
+        SSL_free(client);
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    void handshake() {
+        bool client_done = false;
+        for (int round = 0; round < 16 && !(client_done && server->isEstablished()); ++round) {
+            if (!client_done)
+                client_done = SSL_do_handshake(client) == 1;
+            if (server->handshake() != 1)
+                assert(errno == EAGAIN);
+        }
+        assert(client_done && server->isEstablished());
+    }
+
+    // The client reads what the server sent, along with any session tickets
+    std::string clientRead() {
+        char buf[256];
+        int  got = SSL_read(client, buf, sizeof(buf));
+        return got > 0 ? std::string(buf, static_cast<std::size_t>(got)) : std::string();
+    }
+};
+
+void test_handshake_and_data() {
+    const Server     server = makeServer();
+    const TlsContext context(server);
+    SSL_CTX*         client_ctx = SSL_CTX_new(TLS_client_method());
+    Peer             peer(client_ctx, context);
+
+    // Nothing arrived yet: the server waits to read the ClientHello
+    assert(peer.server->handshake() == -1 && errno == EAGAIN && !peer.server->wantsWrite());
+    peer.handshake();
+    assert(!peer.server->isResumed() && peer.server->handshake() == 1);
+
+    // Client to server, then back; an empty socket reads as EAGAIN
+    assert(SSL_write(peer.client, "GET / HTTP/1.1\r\n\r\n", 18) == 18);
+    char buf[64];
+    assert(peer.server->read(buf, sizeof(buf)) == 18);
+    assert(std::memcmp(buf, "GET / ", 6) == 0);
+    assert(peer.server->read(buf, sizeof(buf)) == -1 && errno == EAGAIN);
+    assert(peer.server->write("HTTP/1.1 200 OK\r\n", 17) == 17);
+    assert(peer.clientRead() == "HTTP/1.1 200 OK\r\n");
+
+    // Bytes still buffered inside OpenSSL are reported, since no event will
+    assert(SSL_write(peer.client, "0123456789", 10) == 10);
+    assert(peer.server->read(buf, 4) == 4 && peer.server->hasPending());
+    assert(peer.server->read(buf, sizeof(buf)) == 6 && !peer.server->hasPending());
+
+    // close_notify reads as end of stream
+    SSL_shutdown(peer.client);
+    assert(peer.server->read(buf, sizeof(buf)) == 0);
+    SSL_CTX_free(client_ctx);
+}
+
+void test_session_resumption() {
+    const Server     server = makeServer();
+    const TlsContext context(server);
+    SSL_CTX*         client_ctx = SSL_CTX_new(TLS_client_method());
+
+    SSL_SESSION* session;
+    {
+        Peer first(client_ctx, context);
+        first.handshake();
+        assert(first.server->write("x", 1) == 1);
+        assert(first.clientRead() == "x"); // TLS 1.3 tickets follow the handshake
+        session = SSL_get1_session(first.client);
+        assert(session && SSL_SESSION_is_resumable(session));
+    }
+    {
+        Peer again(client_ctx, context, session);
+        again.handshake();
+        assert(again.server->isResumed() && SSL_session_reused(again.client));
+    }
+    // A second context shares no keys: full handshake
+    const TlsContext other(server);
+    {
+        Peer elsewhere(client_ctx, other, session);
+        elsewhere.handshake();
+        assert(!elsewhere.server->isResumed());
+    }
+    SSL_SESSION_free(session);
+
+    // Neither tickets nor cache: nothing to resume
+    Server stateless = makeServer();
+    stateless.setSslSessionTickets(false);
+    stateless.setSslSessionCache(0);
+    const TlsContext none(stateless);
+    {
+        Peer first(client_ctx, none);
+        first.handshake();
+        assert(first.server->write("x", 1) == 1);
+        assert(first.clientRead() == "x");
+        session = SSL_get1_session(first.client);
+    }
+    {
+        Peer again(client_ctx, none, session);
+        again.handshake();
+        assert(!again.server->isResumed());
+    }
+    SSL_SESSION_free(session);
+    SSL_CTX_free(client_ctx);
+}
+
+#endif
+
+int main() {
+    char dir[] = "/tmp/webserv_tls_XXXXXX";
+    assert(mkdtemp(dir));
+    g_root = dir;
+
+#ifdef WEBSERV_HAVE_OPENSSL
+    assert(TlsContext::isAvailable());
+    writeCertificate();
+    test_handshake_and_data();
+    test_session_resumption();
+#else
+    assert(!TlsContext::isAvailable());
+#endif
+    test_bad_certificate();
+
+    unlink((g_root + "/cert.pem").c_str());
+    unlink((g_root + "/key.pem").c_str());
+    rmdir(g_root.c_str());
+
+    std::cout << "✅ All TlsContext tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,245 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_upload.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 19:24:13 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 19:26:08 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "http/MultipartParser.hpp"
+#include "http/UploadWriter.hpp"
+#include "network/SocketManager.hpp"
+#include <arpa/inet.h>
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <netinet/in.h>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+std::string g_dir; // Scratch upload store
+
+std::string readFile(const std::string& name) {
+    std::ifstream      in((g_dir + "/" + name).c_str());
+    std::ostringstream out;
+    out << in.rdbuf();
+    return out.str();
+}
+
+bool exists(const std::string& name) {
+    return access((g_dir + "/" + name).c_str(), F_OK) == 0;
+}
+
+// Run a whole multipart body through a parser, split every @p step bytes
+std::string splitParts(const std::string& boundary, const std::string& body, std::size_t step) {
+    MultipartParser parser(boundary);
+    std::string     events;
+    std::string     pending;
+    for (std::size_t pos = 0; pos <= body.size(); pos += step) {
+        pending += body.substr(pos, step);
+        while (true) {
+            std::size_t                   used = 0;
+            std::string_view              data;
+            const MultipartParser::Result result = parser.next(pending, used, data);
+            if (result == MultipartParser::Result::DATA)
+                events += std::string(data); // A slice of the pending bytes
+            pending.erase(0, used);
+            if (result == MultipartParser::Result::NEED_MORE)
+                break;
+            if (result == MultipartParser::Result::PART)
+                events += "[" + parser.getFilename() + "]";
+            else if (result == MultipartParser::Result::PART_END)
+                events += "|";
+            else if (result != MultipartParser::Result::DATA)
+                return events + (result == MultipartParser::Result::DONE ? "$" : "!");
+        }
+    }
+    return events;
+}
+
+} // namespace
+
+void test_multipart_parser() {
+    std::string boundary;
+    assert(MultipartParser::findBoundary("multipart/form-data; boundary=\"a b\"", boundary));
+    assert(boundary == "a b");
+    assert(MultipartParser::findBoundary("Multipart/Form-Data;charset=x;boundary=XyZ", boundary));
+    assert(boundary == "XyZ");
+    assert(!MultipartParser::findBoundary("multipart/form-data", boundary));
+    assert(!MultipartParser::findBoundary("text/plain; boundary=x", boundary));
+
+    // Part data containing a near-delimiter is kept whole whatever the split
+    const std::string body = "preamble\r\n--XyZ\r\nContent-Disposition: form-data; "
+                             "name=\"f\"; filename=\"a\\\"b.txt\"\r\n"
+                             "Content-Type: text/plain\r\n\r\n"
+                             "one\r\n--XyQ two\r\n--XyZ  \r\n"
+                             "Content-Disposition: form-data; name=\"field\"\r\n\r\n"
+                             "value\r\n--XyZ--\r\nepilogue";
+    for (std::size_t step = 1; step <= body.size(); ++step)
+        assert(splitParts("XyZ", body, step) == "[a\"b.txt]one\r\n--XyQ two|[]value|$");
+
+    assert(splitParts("XyZ", "--XyZ\r\n\r\nraw\r\n--XyZ--", 64) == "[]raw|$");
+    assert(splitParts("XyZ", "--XyZ junk", 64) == "!");
+}
+
+void test_upload_writer() {
+    UploadWriter raw(g_dir);
+    assert(raw.start("application/octet-stream", "raw.bin"));
+    assert(raw.write("abc") == 3 && raw.write("def") == 3);
+    assert(!exists("raw.bin")); // Published only once complete
+    assert(raw.finish());
+    assert(readFile("raw.bin") == "abcdef");
+
+    {
+        UploadWriter cut(g_dir);
+        assert(cut.start("", "cut.bin"));
+        assert(cut.write("partial") == 7);
+    } // Destroyed before finish(): the client went away
+    assert(!exists("cut.bin"));
+
+    UploadWriter form(g_dir);
+    assert(form.start("multipart/form-data; boundary=B", ""));
+    const std::string body = "--B\r\nContent-Disposition: form-data; name=\"a\"; "
+                             "filename=\"C:\\\\docs\\\\one.txt\"\r\n\r\n1\r\n"
+                             "--B\r\nContent-Disposition: form-data; name=\"b\"; "
+                             "filename=\"two.txt\"\r\n\r\n22\r\n--B--\r\n";
+    std::size_t pos = form.write(body.substr(0, 40));
+    pos += form.write(body.substr(pos));
+    assert(pos == body.size());
+    assert(form.finish());
+    assert(form.getFiles().size() == 2 && form.getFiles()[0] == "one.txt");
+    assert(readFile("one.txt") == "1" && readFile("two.txt") == "22");
+
+    UploadWriter no_boundary(g_dir);
+    assert(!no_boundary.start("multipart/form-data", "") && no_boundary.getStatus() == 400);
+    UploadWriter bad_name(g_dir);
+    assert(!bad_name.start("", "..") && bad_name.getStatus() == 400);
+    UploadWriter truncated(g_dir);
+    assert(truncated.start("multipart/form-data; boundary=B", ""));
+    truncated.write("--B\r\nContent-Disposition: form-data; filename=\"t\"\r\n\r\nxx");
+    assert(!truncated.finish() && truncated.getStatus() == 400);
+    UploadWriter missing("/nonexistent/store");
+    assert(!missing.start("", "x") && missing.getStatus() == 500);
+}
+
+// --- Through the event loop ---
+
+namespace {
+
+int g_port = 0;
+
+std::string exchange(const std::string& request) {
+    const int   fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(static_cast<uint16_t>(g_port));
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    assert(connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    std::size_t sent = 0;
+    while (sent < request.size()) {
+        const ssize_t n = send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+            break; // Refused early: the response is still readable
+        sent += static_cast<std::size_t>(n);
+    }
+    std::string response;
+    char        buf[4096];
+    ssize_t     got;
+    while ((got = recv(fd, buf, sizeof(buf), 0)) > 0)
+        response.append(buf, static_cast<std::size_t>(got));
+    close(fd);
+    return response;
+}
+
+std::string chunk(const std::string& data) {
+    char size[16];
+    std::snprintf(size, sizeof(size), "%zx\r\n", data.size());
+    return size + data + "\r\n";
+}
+
+} // namespace
+
+void test_event_loop_stores_uploads() {
+    Server server;
+    server.setHost("127.0.0.1");
+    g_port = 20000 + static_cast<int>((getpid() + 11) % 20000);
+    server.setPort(g_port);
+    server.setClientMaxBodySize(4 << 20);
+    Location store;
+    store.setPath("/store");
+    store.setRoot(g_dir);
+    store.addMethod("POST");
+    store.setUploadStore(g_dir);
+    server.addLocation(store);
+    std::vector<Server> servers(1, server);
+    SocketManager manager(std::make_shared<const ConfigSnapshot>(servers));
+    std::thread   loop([&manager]() { manager.run(); });
+
+    // Much larger than the stream buffer: it goes to disk as it arrives
+    std::string big(3 << 20, '\0');
+    for (std::size_t i = 0; i < big.size(); ++i)
+        big[i] = static_cast<char>('a' + i % 26);
+    std::string response = exchange("POST /store/big.txt HTTP/1.1\r\nHost: x\r\nContent-Length: " +
+                                    std::to_string(big.size()) + "\r\n\r\n" + big +
+                                    "POST /store/next.txt HTTP/1.1\r\nHost: x\r\n"
+                                    "Connection: close\r\nContent-Length: 2\r\n\r\nok");
+    assert(response.compare(0, 21, "HTTP/1.1 201 Created\r") == 0);
+    assert(response.find("Location: /store/big.txt\r\n") != std::string::npos);
+    assert(response.find("HTTP/1.1 201 Created", 1) != std::string::npos);
+    assert(readFile("big.txt") == big && readFile("next.txt") == "ok");
+
+    std::string chunked;
+    for (std::size_t pos = 0; pos < big.size(); pos += 100000)
+        chunked += chunk(big.substr(pos, 100000));
+    response = exchange("POST /store/chunked.txt HTTP/1.1\r\nHost: x\r\nConnection: close\r\n"
+                        "Transfer-Encoding: chunked\r\nExpect: 100-continue\r\n\r\n" +
+                        chunked + "0\r\n\r\n");
+    assert(response.compare(0, 25, "HTTP/1.1 100 Continue\r\n\r\n") == 0);
+    assert(response.find("HTTP/1.1 201 Created") == 25);
+    assert(readFile("chunked.txt") == big);
+
+    const std::string form = "--sep\r\nContent-Disposition: form-data; name=\"up\"; "
+                             "filename=\"my file.txt\"\r\n\r\nhello\r\n--sep--\r\n";
+    response = exchange("POST /store HTTP/1.1\r\nHost: x\r\nConnection: close\r\n"
+                        "Content-Type: multipart/form-data; boundary=sep\r\n"
+                        "Content-Length: " + std::to_string(form.size()) + "\r\n\r\n" + form);
+    assert(response.find("Location: /store/my%20file.txt\r\n") != std::string::npos);
+    assert(readFile("my file.txt") == "hello");
+
+    // Refused before any body byte is stored
+    response = exchange("POST /store/huge HTTP/1.1\r\nHost: x\r\nContent-Length: 99999999\r\n\r\n");
+    assert(response.compare(0, 12, "HTTP/1.1 413") == 0);
+    response = exchange("POST /store/a/b HTTP/1.1\r\nHost: x\r\nContent-Length: 1\r\n\r\nx");
+    assert(response.compare(0, 12, "HTTP/1.1 409") == 0);
+    response = exchange("POST /store/bad HTTP/1.1\r\nHost: x\r\nTransfer-Encoding: chunked\r\n"
+                        "\r\n5\r\nabcdefg\r\n");
+    assert(response.compare(0, 12, "HTTP/1.1 400") == 0);
+    assert(!exists("huge") && !exists("bad"));
+
+    manager.stop();
+    loop.join();
+}
+
+int main() {
+    char dir[] = "/tmp/webserv_upload_XXXXXX";
+    assert(mkdtemp(dir));
+    g_dir = dir;
+
+    test_multipart_parser();
+    test_upload_writer();
+    test_event_loop_stores_uploads();
+
+    std::system(("rm -rf " + g_dir).c_str());
+    std::cout << "✅ All upload tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,369 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_upstream_pool.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/15 04:25:50 by agent             #+#    #+#             */
+/*   Updated: 2026/10/15 05:42:03 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "http/HttpRequestParser.hpp"
+#include "network/SocketManager.hpp"
+#include "network/UpstreamPool.hpp"
+#include <arpa/inet.h>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+std::string      g_dir;  // Scratch directory holding the upstream sockets
+int              g_port; // Port of the server under test
+std::atomic<int> g_accepted[2];
+
+void sendAll(int fd, const std::string& data) {
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+            return;
+        sent += static_cast<std::size_t>(n);
+    }
+}
+
+// Reads until @p buffer holds @p size bytes; false if the peer closed first
+bool fill(int fd, std::string& buffer, std::size_t size) {
+    char buf[4096];
+    while (buffer.size() < size) {
+        const ssize_t got = recv(fd, buf, sizeof(buf), 0);
+        if (got <= 0)
+            return false;
+        buffer.append(buf, static_cast<std::size_t>(got));
+    }
+    return true;
+}
+
+// Reads one request; returns its decoded body length, or -1 once the peer closed
+long readRequest(int fd, std::string& buffer, std::string& head) {
+    std::size_t end;
+    while ((end = buffer.find("\r\n\r\n")) == std::string::npos) {
+        if (!fill(fd, buffer, buffer.size() + 1))
+            return -1;
+    }
+    head = buffer.substr(0, end + 2);
+    buffer.erase(0, end + 4);
+    std::size_t length = 0;
+    const std::size_t field = head.find("Content-Length: ");
+    if (field != std::string::npos) {
+        length = std::strtoul(head.c_str() + field + 16, NULL, 10);
+        if (!fill(fd, buffer, length))
+            return -1;
+        buffer.erase(0, length);
+        return static_cast<long>(length);
+    }
+    if (head.find("Transfer-Encoding: chunked") == std::string::npos)
+        return 0;
+    for (;;) {
+        std::size_t eol;
+        while ((eol = buffer.find("\r\n")) == std::string::npos) {
+            if (!fill(fd, buffer, buffer.size() + 1))
+                return -1;
+        }
+        const std::size_t chunk = std::strtoul(buffer.c_str(), NULL, 16);
+        if (!fill(fd, buffer, eol + 2 + chunk + 2))
+            return -1;
+        buffer.erase(0, eol + 2 + chunk + 2);
+        if (chunk == 0)
+            return static_cast<long>(length);
+        length += chunk;
+    }
+}
+
+// Upstream `name`: answers with who it is and what it got, framed as the path asks
+void serveConnection(int fd, std::string name) {
+    std::string buffer;
+    std::string head;
+    long        body;
+    while ((body = readRequest(fd, buffer, head)) >= 0) {
+        const std::size_t space  = head.find(' ');
+        const std::string method = head.substr(0, space);
+        const std::string target = head.substr(space + 1, head.find(' ', space + 1) - space - 1);
+        const std::size_t xff    = head.find("X-Forwarded-For: ");
+        std::string       reply  = name + " " + method + " " + target + " " + std::to_string(body);
+        if (xff != std::string::npos)
+            reply += " xff=" + head.substr(xff + 17, head.find("\r\n", xff) - xff - 17);
+        if (head.find("\r\nConnection:") != std::string::npos ||
+            head.find("\r\nX-Hop: ") != std::string::npos)
+            reply += " hop-by-hop";
+
+        if (target.find("/slow") != std::string::npos)
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        if (target.find("/chunked") != std::string::npos) {
+            sendAll(fd, "HTTP/1.1 100 Continue\r\n\r\n"
+                        "HTTP/1.1 201 Created\r\nTransfer-Encoding: chunked\r\n"
+                        "Keep-Alive: timeout=5\r\nX-Upstream: " + name + "\r\n\r\n"
+                        "5\r\nhello\r\n6\r\n world\r\n0\r\n\r\n");
+        } else if (target.find("/close") != std::string::npos) {
+            sendAll(fd, "HTTP/1.1 200 OK\r\nConnection: close\r\n\r\n" + reply);
+            break;
+        } else if (target.find("/garbage") != std::string::npos) {
+            sendAll(fd, "NOT HTTP\r\n\r\n");
+            break;
+        } else {
+            sendAll(fd, "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: " +
+                            std::to_string(reply.size()) + "\r\n\r\n" + reply);
+        }
+    }
+    close(fd);
+}
+
+struct Upstream {
+    int                      listen_fd;
+    std::thread              acceptor;
+    std::vector<std::thread> connections;
+    std::mutex               lock;
+};
+
+void startUpstream(Upstream& upstream, int index) {
+    const std::string path = g_dir + "/" + static_cast<char>('a' + index) + ".sock";
+    upstream.listen_fd     = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    path.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+    assert(bind(upstream.listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    assert(listen(upstream.listen_fd, 16) == 0);
+    upstream.acceptor = std::thread([&upstream, index]() {
+        int fd;
+        while ((fd = accept(upstream.listen_fd, NULL, NULL)) >= 0) {
+            ++g_accepted[index];
+            std::lock_guard<std::mutex> guard(upstream.lock);
+            upstream.connections.emplace_back(serveConnection, fd,
+                                              std::string(1, static_cast<char>('a' + index)));
+        }
+    });
+}
+
+void stopUpstream(Upstream& upstream) {
+    shutdown(upstream.listen_fd, SHUT_RDWR); // Wakes accept()
+    upstream.acceptor.join();
+    close(upstream.listen_fd);
+    for (std::thread& connection : upstream.connections)
+        connection.join();
+}
+
+std::string exchange(const std::string& request) {
+    const int   fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(static_cast<uint16_t>(g_port));
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    assert(connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    sendAll(fd, request);
+    std::string response;
+    char        buf[4096];
+    ssize_t     got;
+    while ((got = recv(fd, buf, sizeof(buf), 0)) > 0)
+        response.append(buf, static_cast<std::size_t>(got));
+    close(fd);
+    return response;
+}
+
+std::string get(const std::string& target) {
+    return exchange("GET " + target + " HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+}
+
+std::string bodyOf(const std::string& response) {
+    const std::size_t end = response.find("\r\n\r\n");
+    assert(end != std::string::npos);
+    return response.substr(end + 4);
+}
+
+} // namespace
+
+void test_request_head() {
+    const std::string raw = "POST /app/x?y=1 HTTP/1.1\r\n"
+                            "Host: example.com\r\n"
+                            "Connection: keep-alive, X-Hop\r\n"
+                            "X-Hop: 1\r\n"
+                            "Keep-Alive: timeout=5\r\n"
+                            "X-Forwarded-For: 10.0.0.1\r\n"
+                            "Expect: 100-continue\r\n"
+                            "Cookie: a=b\r\n"
+                            "Content-Length: 5\r\n"
+                            "\r\n";
+    HttpRequestParser parser;
+    HttpRequest       request;
+    assert(parser.parse(raw, request) == HttpRequestParser::Result::COMPLETE);
+    bool              chunked = true;
+    const std::string head =
+        UpstreamPool::makeRequestHead(request, "127.0.0.1", "default", chunked);
+    assert(!chunked);
+    assert(head == "POST /app/x?y=1 HTTP/1.1\r\n"
+                   "Host: example.com\r\n"
+                   "Cookie: a=b\r\n"
+                   "X-Forwarded-For: 10.0.0.1, 127.0.0.1\r\n"
+                   "X-Forwarded-Proto: http\r\n"
+                   "Content-Length: 5\r\n"
+                   "\r\n");
+
+    // HTTP/1.0 without Host
+    const std::string old = "PUT /up HTTP/1.0\r\nContent-Length: 3\r\n\r\n";
+    parser.reset();
+    request.reset();
+    assert(parser.parse(old, request) == HttpRequestParser::Result::COMPLETE);
+    assert(UpstreamPool::makeRequestHead(request, "", "default", chunked) ==
+           "PUT /up HTTP/1.1\r\n"
+           "Host: default\r\n"
+           "X-Forwarded-Proto: http\r\n"
+           "Content-Length: 3\r\n"
+           "\r\n");
+    assert(!chunked);
+
+    // A chunked body stays chunked
+    const std::string streamed =
+        "PUT /up HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\n";
+    parser.reset();
+    request.reset();
+    assert(parser.parse(streamed, request) == HttpRequestParser::Result::COMPLETE);
+    assert(UpstreamPool::makeRequestHead(request, "", "default", chunked) ==
+           "PUT /up HTTP/1.1\r\n"
+           "Host: a\r\n"
+           "X-Forwarded-Proto: http\r\n"
+           "Transfer-Encoding: chunked\r\n"
+           "\r\n");
+    assert(chunked);
+}
+
+void test_invalid_upstreams() {
+    std::unique_ptr<PollManager> poller = PollManager::create(PollBackend::AUTO);
+    UpstreamPool                 pool(*poller);
+    assert(!pool.open("backend.example:80", ProxyBalance::ROUND_ROBIN, 3, "", false, false));
+    assert(!pool.open("", ProxyBalance::ROUND_ROBIN, 3, "", false, false));
+    assert(pool.getConnectionCount() == 0);
+}
+
+void test_event_loop_proxies() {
+    Upstream upstreams[2];
+    startUpstream(upstreams[0], 0);
+    startUpstream(upstreams[1], 1);
+    const std::string a = "unix:" + g_dir + "/a.sock";
+    const std::string b = "unix:" + g_dir + "/b.sock";
+
+    Server server;
+    server.setHost("127.0.0.1");
+    g_port = 20000 + static_cast<int>((getpid() + 17) % 20000);
+    server.setPort(g_port);
+    server.setClientMaxBodySize(1 << 20);
+    Location app;
+    app.setPath("/app");
+    app.addMethod("GET");
+    app.addMethod("POST");
+    app.setProxyPass(a + " " + b);
+    server.addLocation(app);
+    Location least = app;
+    least.setPath("/least");
+    least.setProxyPass(b + " " + a); // A group of its own
+    least.setProxyBalance(ProxyBalance::LEAST_CONN);
+    server.addLocation(least);
+    Location failing = app;
+    failing.setPath("/failing");
+    failing.setProxyPass("unix:" + g_dir + "/missing.sock " + a);
+    server.addLocation(failing);
+    Location down = app;
+    down.setPath("/down");
+    down.setProxyPass("unix:" + g_dir + "/missing.sock");
+    server.addLocation(down);
+    std::vector<Server> servers(1, server);
+    {
+        SocketManager manager(std::make_shared<const ConfigSnapshot>(servers));
+        std::thread   loop([&manager]() { manager.run(); });
+
+        // Round robin, with the connections kept between requests
+        std::string response = get("/app/one");
+        assert(response.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+        assert(response.find("Content-Length: ") != std::string::npos);
+        assert(bodyOf(response) == "a GET /app/one 0 xff=127.0.0.1");
+        assert(bodyOf(get("/app/two")) == "b GET /app/two 0 xff=127.0.0.1");
+        assert(bodyOf(get("/app/three")).compare(0, 2, "a ") == 0);
+        assert(bodyOf(get("/app/four")).compare(0, 2, "b ") == 0);
+        assert(g_accepted[0] == 1 && g_accepted[1] == 1);
+
+        // Bodies of either framing reach the upstream; hop-by-hop fields do not
+        const std::string body(100000, 'p');
+        response = exchange("POST /app/post HTTP/1.1\r\nHost: x\r\nConnection: close, X-Hop\r\n"
+                            "X-Hop: 1\r\nContent-Length: " + std::to_string(body.size()) +
+                            "\r\n\r\n" + body);
+        assert(bodyOf(response) == "a POST /app/post 100000 xff=127.0.0.1");
+        response = exchange("POST /app/post HTTP/1.1\r\nHost: x\r\nConnection: close\r\n"
+                            "Transfer-Encoding: chunked\r\n\r\n3\r\nabc\r\n4\r\ndefg\r\n0\r\n\r\n");
+        assert(bodyOf(response) == "b POST /app/post 7 xff=127.0.0.1");
+
+        // Interim responses are skipped; a chunked body is re-framed for the client
+        response = get("/app/chunked");
+        assert(response.compare(0, 20, "HTTP/1.1 201 Created") == 0);
+        assert(response.find("X-Upstream: a\r\n") != std::string::npos);
+        assert(response.find("Keep-Alive: timeout=5") == std::string::npos);
+        assert(response.find("Transfer-Encoding: chunked\r\n") != std::string::npos);
+        const std::string chunks = bodyOf(response); // Split as the upstream was read
+        assert(chunks.find("hello") != std::string::npos);
+        assert(chunks.compare(chunks.size() - 7, 7, "\r\n0\r\n\r\n") == 0);
+        response = exchange("GET /app/chunked HTTP/1.0\r\n\r\n");
+        assert(bodyOf(response) == "hello world");
+
+        // A close-delimited response ends the connection it came on
+        response = exchange("GET /app/close HTTP/1.0\r\n\r\n");
+        assert(bodyOf(response) == "a GET /app/close 0 xff=127.0.0.1");
+        assert(bodyOf(get("/app/after")).compare(0, 2, "b ") == 0);
+        assert(bodyOf(get("/app/after")).compare(0, 2, "a ") == 0);
+        assert(g_accepted[0] == 2 && g_accepted[1] == 1);
+
+        // Least connections: while one upstream is busy, the other takes the requests
+        std::string slow;
+        std::thread busy([&slow]() { slow = get("/least/slow"); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const std::string first  = bodyOf(get("/least/x"));
+        const std::string second = bodyOf(get("/least/y"));
+        busy.join();
+        assert(bodyOf(slow).compare(0, 2, "b ") == 0);
+        assert(first.compare(0, 2, "a ") == 0 && second.compare(0, 2, "a ") == 0);
+
+        // A server that cannot be reached is skipped, and the request retried
+        for (int i = 0; i < 4; ++i)
+            assert(bodyOf(get("/failing/x")).compare(0, 2, "a ") == 0);
+        assert(get("/down/x").compare(0, 12, "HTTP/1.1 502") == 0);
+        assert(get("/app/garbage").compare(0, 12, "HTTP/1.1 502") == 0);
+
+        manager.stop();
+        loop.join();
+    } // Closes the pooled connections, which ends their threads
+
+    stopUpstream(upstreams[0]);
+    stopUpstream(upstreams[1]);
+}
+
+int main() {
+    char dir[] = "/tmp/webserv_upstream_XXXXXX";
+    assert(mkdtemp(dir));
+    g_dir = dir;
+
+    test_request_head();
+    test_invalid_upstreams();
+    test_event_loop_proxies();
+
+    std::system(("rm -rf " + g_dir).c_str());
+    std::cout << "✅ All UpstreamPool tests passed successfully.\n";
+    return 0;
+}
@@ -0,0 +1,118 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_virtual_host_index.cpp                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: agent <agent@local>                        +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/14 18:15:39 by agent             #+#    #+#             */
+/*   Updated: 2026/10/14 18:15:39 by agent            ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "core/VirtualHostIndex.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static Server makeServer(int port, const std::vector<std::string>& names) {
+    Server server;
+    server.setPort(port);
+    for (const std::string& name : names)
+        server.addServerName(name);
+    return server;
+}
+
+void test_exact_and_default() {
+    std::vector<Server> servers;
+    servers.push_back(makeServer(80, {"localhost"}));
+    servers.push_back(makeServer(80, {"example.com", "www.example.com"}));
+    servers.push_back(makeServer(8080, {"alternate.dev"}));
+    const VirtualHostIndex index(servers);
+
+    assert(index.size() == 4);
+    assert(index.find(80, "example.com") == &servers[1]);
+    assert(index.find(80, "WWW.Example.COM") == &servers[1]); // case-insensitive
+    assert(index.find(80, "example.com.") == &servers[1]);    // absolute name
+    assert(index.find(80, "unknown.com") == &servers[0]);     // first server is default
+    assert(index.find(80, "") == &servers[0]);
+    assert(index.find(80, "alternate.dev") == &servers[0]);   // other port's name
+    assert(index.find(8080, "alternate.dev") == &servers[2]);
+    assert(index.find(9999, "example.com") == NULL);          // nothing listens there
+    assert(index.getDefault(8080) == &servers[2]);
+    assert(index.find(80, std::string(300, 'a')) == &servers[0]);
+}
+
+void test_wildcards() {
+    std::vector<Server> servers;
+    servers.push_back(makeServer(80, {"*.example.com"}));
+    servers.push_back(makeServer(80, {"*.api.example.com"}));
+    servers.push_back(makeServer(80, {".example.org"}));
+    servers.push_back(makeServer(80, {"exact.example.com"}));
+    const VirtualHostIndex index(servers);
+
+    assert(index.find(80, "www.example.com") == &servers[0]);
+    assert(index.find(80, "a.b.example.com") == &servers[0]);
+    assert(index.find(80, "v1.api.example.com") == &servers[1]); // longest suffix wins
+    assert(index.find(80, "exact.example.com") == &servers[3]);  // exact beats wildcard
+    assert(index.find(80, "example.com") == &servers[0]);        // default, not a match
+    assert(index.find(80, "example.org") == &servers[2]);        // ".name" covers both
+    assert(index.find(80, "www.example.org") == &servers[2]);
+    assert(index.find(80, "notexample.com") == &servers[0]);     // default again
+}
+
+void test_designated_default_and_duplicates() {
+    std::vector<Server> servers;
+    servers.push_back(makeServer(80, {"a.test"}));
+    servers.push_back(makeServer(80, {"b.test", "a.test"})); // duplicate keeps servers[0]
+    servers.back().setDefaultServer(true);
+    servers.push_back(makeServer(80, {"c.test"}));
+    servers.back().setDefaultServer(true); // only the first flagged one counts
+    const VirtualHostIndex index(servers);
+
+    assert(index.find(80, "a.test") == &servers[0]);
+    assert(index.find(80, "b.test") == &servers[1]);
+    assert(index.find(80, "c.test") == &servers[2]);
+    assert(index.find(80, "other.test") == &servers[1]);
+    assert(index.size() == 3);
+}
+
+void test_many_names() {
+    std::vector<Server> servers;
+    for (int port = 8000; port < 8004; ++port) {
+        std::vector<std::string> names;
+        for (int i = 0; i < 500; ++i)
+            names.push_back("host" + std::to_string(i) + ".port" + std::to_string(port));
+        servers.push_back(makeServer(port, names));
+        servers.push_back(makeServer(port, {"fallback"}));
+    }
+    const VirtualHostIndex index(servers);
+
+    assert(index.size() == 4 * 501);
+    for (int port = 8000; port < 8004; ++port) {
+        const Server* expected = &servers[static_cast<size_t>(port - 8000) * 2];
+        for (int i = 0; i < 500; ++i)
+            assert(index.find(port, "host" + std::to_string(i) + ".port" + std::to_string(port)) ==
+                   expected);
+        assert(index.find(port, "fallback") == expected + 1);
+    }
+}
+
+void test_empty_index() {
+    const VirtualHostIndex index;
+    assert(index.find(80, "example.com") == NULL);
+    assert(index.getDefault(80) == NULL);
+    assert(index.size() == 0);
+}
+
+int main() {
+    test_exact_and_default();
+    test_wildcards();
+    test_designated_default_and_duplicates();
+    test_many_names();
+    test_empty_index();
+
+    std::cout << "✅ All VirtualHostIndex tests passed successfully.\n";
+    return 0;
+}
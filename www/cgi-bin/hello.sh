@@ -0,0 +1,9 @@
+# Minimal CGI script: echoes the request back as plain text
+printf 'Content-Type: text/plain\r\n\r\n'
+printf 'Hello from %s %s\n' "$REQUEST_METHOD" "$SCRIPT_NAME"
+printf 'Query: %s\n' "$QUERY_STRING"
+if [ -n "$CONTENT_LENGTH" ]; then
+    printf 'Body: '
+    cat
+    printf '\n'
+fi